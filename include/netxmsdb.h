@@ -25,7 +25,7 @@
 
 #define DB_LEGACY_SCHEMA_VERSION       700
 #define DB_SCHEMA_VERSION_MAJOR        40
-#define DB_SCHEMA_VERSION_MINOR        11
+#define DB_SCHEMA_VERSION_MINOR        12
 
 #define DB_SCHEMA_VERSION_V40_MINOR    DB_SCHEMA_VERSION_MINOR
 
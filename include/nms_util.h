@@ -360,6 +360,9 @@ size_t LIBNETXMS_EXPORTABLE ISO8859_1_to_utf8(const char *src, ssize_t srcLen, c
 size_t LIBNETXMS_EXPORTABLE ISO8859_1_to_ucs2(const char *src, ssize_t srcLen, UCS2CHAR *dst, size_t dstLen);
 size_t LIBNETXMS_EXPORTABLE ISO8859_1_to_ucs4(const char *src, ssize_t srcLen, UCS4CHAR *dst, size_t dstLen);
 
+// Select instruction set for vectorized conversion fast paths (0 = scalar, 1 = SSE2, 2 = AVX2, -1 = best available)
+int LIBNETXMS_EXPORTABLE SetUnicodeConversionSIMDLevel(int level);
+
 #ifdef UNICODE_UCS4
 #define utf8_to_wchar   utf8_to_ucs4
 #define utf8_wcharlen   utf8_ucs4len
@@ -122,6 +122,14 @@ inline void *InterlockedExchangePointer(void *volatile *target, void *value)
    return atomic_swap_ptr(target, value);
 }
 
+/**
+ * Atomically compare and exchange pointer (returns initial value of target)
+ */
+inline void *InterlockedCompareExchangePointer(void *volatile *target, void *exchange, void *comparand)
+{
+   return atomic_cas_ptr(target, comparand, exchange);
+}
+
 /**
  * Atomic bitwise OR
  */
@@ -223,6 +231,30 @@ inline void *InterlockedExchangePointer(void *volatile *target, void *value)
 #endif
 }
 
+/**
+ * Atomically compare and exchange pointer (returns initial value of target)
+ */
+inline void *InterlockedCompareExchangePointer(void *volatile *target, void *exchange, void *comparand)
+{
+#ifdef __64BIT__
+#if HAVE_ATOMIC_H
+   return (void*)atomic_cas_64((volatile uint64_t*)target, (uint64_t)comparand, (uint64_t)exchange);
+#else
+   _Asm_mf(_DFLT_FENCE);
+   _Asm_mov_to_ar(_AREG_CCV, (uint64_t)comparand);
+   return (void*)_Asm_cmpxchg(_SZ_D, _SEM_ACQ, (void *)target, (uint64_t)exchange, _LDHINT_NONE);
+#endif
+#else /* __64BIT__ */
+#if HAVE_ATOMIC_H
+   return (void*)atomic_cas_32((volatile uint32_t*)target, (uint32_t)comparand, (uint32_t)exchange);
+#else
+   _Asm_mf(_DFLT_FENCE);
+   _Asm_mov_to_ar(_AREG_CCV, (uint64_t)comparand);
+   return (void*)_Asm_cmpxchg(_SZ_W, _SEM_ACQ, (void *)target, (uint64_t)exchange, _LDHINT_NONE);
+#endif
+#endif
+}
+
 /**
  * Atomic bitwise OR
  */
@@ -343,6 +375,25 @@ inline void *InterlockedExchangePointer(void *volatile *target, void *value)
    return oldval;
 }
 
+/**
+ * Atomically compare and exchange pointer (returns initial value of target)
+ */
+inline void *InterlockedCompareExchangePointer(void *volatile *target, void *exchange, void *comparand)
+{
+#if !HAVE_DECL___SYNC_VAL_COMPARE_AND_SWAP
+#ifdef __64BIT__
+   long oldval = (long)comparand;
+   __compare_and_swaplp((long *)target, &oldval, (long)exchange);
+#else
+   int oldval = (int)comparand;
+   __compare_and_swap((int *)target, &oldval, (int)exchange);
+#endif
+   return (void *)oldval;
+#else
+   return __sync_val_compare_and_swap(target, comparand, exchange);
+#endif
+}
+
 /**
  * Atomic bitwise OR
  */
@@ -464,6 +515,19 @@ inline void *InterlockedExchangePointer(void* volatile *target, void *value)
 #endif
 }
 
+/**
+ * Atomically compare and exchange pointer (returns initial value of target)
+ */
+inline void *InterlockedCompareExchangePointer(void* volatile *target, void *exchange, void *comparand)
+{
+#if HAVE_ATOMIC_BUILTINS
+   void *expected = comparand;
+   return __atomic_compare_exchange_n(target, &expected, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? comparand : expected;
+#else
+   return __sync_val_compare_and_swap(target, comparand, exchange);
+#endif
+}
+
 /**
  * Atomic bitwise OR
  */
@@ -494,6 +558,14 @@ template<typename T> T *InterlockedExchangeObjectPointer(T* volatile *target, T
    return static_cast<T*>(InterlockedExchangePointer(reinterpret_cast<void* volatile *>(target), value));
 }
 
+/**
+ * Atomically compare and exchange pointer - helper template
+ */
+template<typename T> T *InterlockedCompareExchangeObjectPointer(T* volatile *target, T *exchange, T *comparand)
+{
+   return static_cast<T*>(InterlockedCompareExchangePointer(reinterpret_cast<void* volatile *>(target), exchange, comparand));
+}
+
 #endif   /* __cplusplus */
 
 #endif
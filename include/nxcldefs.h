@@ -964,6 +964,17 @@ enum AggregationFunction
    DCI_AGG_SUM = 4
 };
 
+/**
+ * Downsampling methods for DCI history requests
+ */
+enum DownsamplingMethod
+{
+   DCI_DOWNSAMPLE_AVG = 0,
+   DCI_DOWNSAMPLE_MIN = 1,
+   DCI_DOWNSAMPLE_MAX = 2,
+   DCI_DOWNSAMPLE_LTTB = 3
+};
+
 /**
  * Threshold operations
  */
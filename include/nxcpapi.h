@@ -70,14 +70,22 @@ class LIBNETXMS_EXPORTABLE NXCPMessage
    uint16_t m_code;
    uint16_t m_flags;
    uint32_t m_id;
-   MessageField *m_fields; // Message fields
-   int m_version;          // Protocol version
-   BYTE *m_data;           // binary data
-   size_t m_dataSize;      // binary data size
+   MessageField *m_fields;    // Message fields (in insertion order)
+   MessageField *m_lastField;
+   MessageField **m_index;    // Open addressing index of message fields
+   uint32_t m_indexMask;
+   uint32_t m_fieldCount;
+   size_t m_fieldsSize;       // Size of all fields in serialized form (including alignment)
+   int m_version;             // Protocol version
+   BYTE *m_data;              // binary data
+   size_t m_dataSize;         // binary data size
    MemoryPool m_pool;
 
    NXCPMessage(const NXCP_MESSAGE *msg, int version);
 
+   void initFields();
+   void addField(MessageField *entry);
+   void resizeIndex(uint32_t size);
    void *set(UINT32 fieldId, BYTE type, const void *value, bool isSigned = false, size_t size = 0, bool isUtf8 = false);
    void *get(UINT32 fieldId, BYTE requiredType, BYTE *fieldType = NULL) const;
    NXCP_MESSAGE_FIELD *find(UINT32 fieldId) const;
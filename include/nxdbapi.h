@@ -94,6 +94,8 @@ struct PoolConnectionInfo
    UINT32 usageCount;
    char srcFile[128];
    int srcLine;
+   uint32_t statementCacheHits;
+   uint32_t statementCacheMisses;
 };
 
 /**
@@ -108,6 +110,17 @@ struct LIBNXDB_PERF_COUNTERS
    UINT64 failedQueries;
 };
 
+/**
+ * Table definition for DBCacheTables
+ */
+struct DBCachedTableDefinition
+{
+   const TCHAR *table;
+   const TCHAR *indexColumn;
+   const TCHAR *columns;
+   const TCHAR * const *intColumns;
+};
+
 /**
  * Functions
  */
@@ -125,10 +138,13 @@ void LIBNXDB_EXPORTABLE DBDisconnect(DB_HANDLE hConn);
 void LIBNXDB_EXPORTABLE DBEnableReconnect(DB_HANDLE hConn, bool enabled);
 bool LIBNXDB_EXPORTABLE DBSetPrefetchLimit(DB_HANDLE hConn, int limit);
 void LIBNXDB_EXPORTABLE DBSetSessionInitCallback(void (*cb)(DB_HANDLE));
+void LIBNXDB_EXPORTABLE DBSetStatementCacheSize(int size);
 DB_DRIVER LIBNXDB_EXPORTABLE DBGetDriver(DB_HANDLE hConn);
 
 DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepare(DB_HANDLE hConn, const TCHAR *szQuery, bool optimizeForReuse = false);
 DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareEx(DB_HANDLE hConn, const TCHAR *szQuery, bool optimizeForReuse, TCHAR *errorText);
+DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareCached(DB_HANDLE hConn, const TCHAR *szQuery);
+void LIBNXDB_EXPORTABLE DBGetStatementCacheStats(DB_HANDLE hConn, uint32_t *hits, uint32_t *misses, int *size);
 void LIBNXDB_EXPORTABLE DBFreeStatement(DB_STATEMENT hStmt);
 const TCHAR LIBNXDB_EXPORTABLE *DBGetStatementSource(DB_STATEMENT hStmt);
 bool LIBNXDB_EXPORTABLE DBOpenBatch(DB_STATEMENT hStmt);
@@ -257,5 +273,6 @@ bool LIBNXDB_EXPORTABLE DBDropIndex(DB_HANDLE hdb, const TCHAR *table, const TCH
 DB_HANDLE LIBNXDB_EXPORTABLE DBOpenInMemoryDatabase();
 void LIBNXDB_EXPORTABLE DBCloseInMemoryDatabase(DB_HANDLE hdb);
 bool LIBNXDB_EXPORTABLE DBCacheTable(DB_HANDLE cacheDB, DB_HANDLE sourceDB, const TCHAR *table, const TCHAR *indexColumn, const TCHAR *columns, const TCHAR * const *intColumns = NULL);
+bool LIBNXDB_EXPORTABLE DBCacheTables(DB_HANDLE cacheDB, DB_HANDLE sourceDB, const DBCachedTableDefinition *tables, int parallelism);
 
 #endif   /* _nxsrvapi_h_ */
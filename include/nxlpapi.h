@@ -238,6 +238,7 @@ class LIBNXLP_EXPORTABLE LogParser
 	bool (*m_eventResolver)(const TCHAR *, uint32_t *);
 	THREAD m_thread;	// Associated thread
    CONDITION m_stopCondition;
+   CONDITION m_fileChangeCondition;
    int m_recordsProcessed;
 	int m_recordsMatched;
 	bool m_preallocatedFile;
@@ -115,7 +115,7 @@ struct NXSL_FileHeader
 /**
  * Binary format version
  */
-#define NXSL_BIN_FORMAT_VERSION     2
+#define NXSL_BIN_FORMAT_VERSION     4
 
 /**
  * Exportable classes
@@ -136,6 +136,7 @@ extern "C" {
 NXSL_Program LIBNXSL_EXPORTABLE *NXSLCompile(const TCHAR *source, TCHAR *errorMessage, size_t errorMessageLen, int *errorLineNumber);
 NXSL_VM LIBNXSL_EXPORTABLE *NXSLCompileAndCreateVM(const TCHAR *source, TCHAR *errorMessage, size_t errorMessageLen, NXSL_Environment *env);
 TCHAR LIBNXSL_EXPORTABLE *NXSLLoadFile(const TCHAR *fileName);
+void LIBNXSL_EXPORTABLE NXSLGetRegexpCacheStats(uint32_t *hits, uint32_t *misses, int *size);
 
 #ifdef __cplusplus
 }
@@ -155,6 +155,7 @@ class NXSL_Value;
 class NXSL_Object;
 class NXSL_VM;
 class NXSL_ValueManager;
+class NXSL_Regexp;
 
 /**
  * Runtime object
@@ -189,6 +190,29 @@ struct NXSL_ExtMethod
       m_methods->set(#name, m); \
    }
 
+/**
+ * External attribute structure
+ */
+struct NXSL_ExtAttribute
+{
+   NXSL_Value *(* handler)(NXSL_Object *object, NXSL_VM *vm);
+};
+
+#define NXSL_ATTRIBUTE_DEFINITION(clazz, name) \
+   static NXSL_Value *A_##clazz##_##name (NXSL_Object *object, NXSL_VM *vm)
+
+#define NXSL_REGISTER_ATTRIBUTE(clazz, name) { \
+      NXSL_ExtAttribute *a = new NXSL_ExtAttribute; \
+      a->handler = A_##clazz##_##name; \
+      m_attributeHandlers->set(#name, a); \
+   }
+
+#define NXSL_REGISTER_ATTRIBUTE_ALIAS(clazz, name, alias) { \
+      NXSL_ExtAttribute *a = new NXSL_ExtAttribute; \
+      a->handler = A_##clazz##_##name; \
+      m_attributeHandlers->set(#alias, a); \
+   }
+
 /**
  * Class representing NXSL class
  */
@@ -204,6 +228,7 @@ class LIBNXSL_EXPORTABLE NXSL_Class
 
 protected:
    HashMap<NXSL_Identifier, NXSL_ExtMethod> *m_methods;
+   HashMap<NXSL_Identifier, NXSL_ExtAttribute> *m_attributeHandlers;
 
    void setName(const TCHAR *name);
    const StringList& getClassHierarchy() const { return m_classHierarchy; }
@@ -237,6 +262,7 @@ class LIBNXSL_EXPORTABLE NXSL_Class
 
    const TCHAR *getName() const { return m_name; }
    bool instanceOf(const TCHAR *name) const { return !_tcscmp(name, m_name) || m_classHierarchy.contains(name); }
+   const NXSL_ExtAttribute *getAttributeHandler(const NXSL_Identifier& name) const { return m_attributeHandlers->get(name); }
 
    void scanAttributes();
 };
@@ -800,7 +826,8 @@ enum OperandType
    OP_TYPE_IDENTIFIER = 2,
    OP_TYPE_CONST = 3,
    OP_TYPE_VARIABLE = 4,
-   OP_TYPE_EXT_FUNCTION = 5
+   OP_TYPE_EXT_FUNCTION = 5,
+   OP_TYPE_REGEXP = 6
 };
 
 /**
@@ -821,10 +848,13 @@ class LIBNXSL_EXPORTABLE NXSL_Instruction
       NXSL_Identifier *m_identifier;
       NXSL_Variable *m_variable;
       const NXSL_ExtFunction *m_function;
+      NXSL_Regexp *m_regexp;
       UINT32 m_addr;
    } m_operand;
    UINT32 m_addr2;   // Second address
    INT32 m_sourceLine;
+   NXSL_Class *m_cachedClass;   // Object class seen by last execution of attribute access instruction
+   const NXSL_ExtAttribute *m_cachedAttribute;   // Attribute handler resolved for cached class
 
 public:
    NXSL_Instruction(NXSL_ValueManager *vm, int line, INT16 opCode);
@@ -939,8 +969,12 @@ class LIBNXSL_EXPORTABLE NXSL_Program : public NXSL_ValueManager
    NXSL_ValueHashMap<NXSL_Identifier> *m_constants;
    ObjectArray<NXSL_Function> *m_functions;
    ObjectArray<NXSL_IdentifierLocation> *m_expressionVariables;
+   BYTE *m_jumpTargets;    // Map of jump destinations (only valid during optimization)
 
    uint32_t getFinalJumpDestination(uint32_t addr, int srcJump);
+   void buildJumpTargetMap();
+   void updateJumpTargetMap();
+   NXSL_Value *foldBinaryOperation(int opcode, const NXSL_Value *value1, const NXSL_Value *value2);
    uint32_t getExpressionVariableCodeBlock(const NXSL_Identifier& identifier);
 
 public:
@@ -956,6 +990,7 @@ class LIBNXSL_EXPORTABLE NXSL_Program : public NXSL_ValueManager
    void addRequiredModule(const char *name, int lineNumber, bool removeLastElement);
 	void optimize();
 	void removeInstructions(uint32_t start, int count);
+	bool isJumpDestination(uint32_t addr);
    bool addConstant(const NXSL_Identifier& name, NXSL_Value *value);
    void enableExpressionVariables();
    void disableExpressionVariables(int line);
@@ -1142,6 +1177,7 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    void getHashMapAttribute(NXSL_HashMap *m, const char *attribute, bool safe);
    void error(int errorCode, int sourceLine = -1);
    NXSL_Value *matchRegexp(NXSL_Value *pValue, NXSL_Value *pRegexp, BOOL bIgnoreCase);
+   NXSL_Value *matchRegexp(NXSL_Value *value, NXSL_Regexp *regexp);
 
    NXSL_Variable *findVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs = NULL);
    NXSL_Variable *findOrCreateVariable(const NXSL_Identifier& name, NXSL_VariableSystem **vs = NULL);
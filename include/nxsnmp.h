@@ -305,6 +305,7 @@ enum SNMP_EncryptionMethod
  */
 #define SMT_COMPRESS_DATA        0x01
 #define SMT_SKIP_DESCRIPTIONS    0x02
+#define SMT_INDEXED_FORMAT       0x04
 
 /**
  * Flags for SnmpGet
@@ -322,9 +323,11 @@ enum SNMP_EncryptionMethod
 #ifdef __cplusplus
 
 class ZFile;
+class SNMP_MIBIndex;
 
 /**
- * MIB tree node
+ * MIB tree node. Tree loaded from indexed MIB file is backed by memory mapped index:
+ * child nodes are created on first access and descriptions are read only when requested.
  */
 class LIBNXSNMP_EXPORTABLE SNMP_MIBObject
 {
@@ -343,8 +346,19 @@ class LIBNXSNMP_EXPORTABLE SNMP_MIBObject
    int m_iStatus;
    int m_iAccess;
 
+   SNMP_MIBIndex *m_index;       // Backing index (owned by root object)
+   uint32_t m_indexNode;
+   SNMP_MIBObject **m_children;  // Children in OID order (only for index backed objects)
+   bool m_childrenLoaded;
+   bool m_descriptionLoaded;
+
    void Initialize();
 
+   SNMP_MIBObject(SNMP_MIBIndex *index, uint32_t node);
+
+   void loadChildren();
+   void loadDescription();
+
 public:
    SNMP_MIBObject();
    SNMP_MIBObject(UINT32 dwOID, const TCHAR *pszName);
@@ -361,25 +375,97 @@ class LIBNXSNMP_EXPORTABLE SNMP_MIBObject
    SNMP_MIBObject *getParent() { return m_pParent; }
    SNMP_MIBObject *getNext() { return m_pNext; }
    SNMP_MIBObject *getPrev() { return m_pPrev; }
-   SNMP_MIBObject *getFirstChild() { return m_pFirst; }
-   SNMP_MIBObject *getLastChild() { return m_pLast; }
+   SNMP_MIBObject *getFirstChild() { if (m_index != nullptr) loadChildren(); return m_pFirst; }
+   SNMP_MIBObject *getLastChild() { if (m_index != nullptr) loadChildren(); return m_pLast; }
 
    UINT32 getObjectId() { return m_dwOID; }
    const TCHAR *getName() { return m_pszName; }
-   const TCHAR *getDescription() { return m_pszDescription; }
+   const TCHAR *getDescription() { if (m_index != nullptr) loadDescription(); return m_pszDescription; }
+   const TCHAR *getTextualConvention() { if (m_index != nullptr) loadDescription(); return m_pszTextualConvention; }
    int getType() { return m_iType; }
    int getStatus() { return m_iStatus; }
    int getAccess() { return m_iAccess; }
 
    SNMP_MIBObject *findChildByID(UINT32 dwOID);
+   SNMP_MIBObject *findByOID(const uint32_t *oid, size_t length, bool exactMatch = true);
+   SNMP_MIBObject *findByName(const TCHAR *name);
 
    void print(int nIndent);
 
    // File I/O, supposed to be callsed only from libnxsnmp functions
    void writeToFile(ZFile *pFile, UINT32 dwFlags);
    BOOL readFromFile(ZFile *pFile);
+
+   static SNMP_MIBObject *createFromIndex(SNMP_MIBIndex *index);
 };
 
+/**
+ * Invalid node index in indexed MIB file
+ */
+#define MIB_INVALID_NODE   0xFFFFFFFF
+
+struct SNMP_MIB_INDEX_NODE;
+
+/**
+ * Read-only view of compiled MIB file in indexed format. File is memory mapped, so
+ * nodes and descriptions are only read from disk when accessed and pages are shared
+ * between processes using same file. Nodes are identified by their index in node array,
+ * root node always has index 0.
+ */
+class LIBNXSNMP_EXPORTABLE SNMP_MIBIndex
+{
+   DISABLE_COPY_CTOR(SNMP_MIBIndex)
+
+private:
+   void *m_data;
+   size_t m_size;
+#ifdef _WIN32
+   HANDLE m_hFile;
+   HANDLE m_hMapping;
+#endif
+   const SNMP_MIB_INDEX_NODE *m_nodes;
+   uint32_t m_nodeCount;
+   const uint32_t *m_nameIndex;
+   const char *m_strings;
+   const char *m_descriptions;
+   uint32_t m_timestamp;
+
+   SNMP_MIBIndex();
+
+   uint32_t validate();
+
+public:
+   ~SNMP_MIBIndex();
+
+   static SNMP_MIBIndex *open(const TCHAR *fileName, uint32_t *error = nullptr);
+
+   uint32_t size() const { return m_nodeCount; }
+   uint32_t getTimestamp() const { return m_timestamp; }
+
+   uint32_t getParent(uint32_t node) const;
+   uint32_t getChildCount(uint32_t node) const;
+   uint32_t getChild(uint32_t node, uint32_t index) const;
+   uint32_t getObjectId(uint32_t node) const;
+   const char *getNameUTF8(uint32_t node) const;
+   String getName(uint32_t node) const;
+   String getDescription(uint32_t node) const;
+   String getTextualConvention(uint32_t node) const;
+   int getType(uint32_t node) const;
+   int getStatus(uint32_t node) const;
+   int getAccess(uint32_t node) const;
+
+   uint32_t findChildByID(uint32_t node, uint32_t oid) const;
+   uint32_t findByName(const TCHAR *name) const;
+   uint32_t findByOID(const uint32_t *oid, size_t length, size_t *matchedLength = nullptr) const;
+
+   SNMP_MIBObject *createTree(bool withDescriptions = true) const;
+};
+
+/**
+ * Number of OID elements stored within SNMP_ObjectId object without heap allocation
+ */
+#define SNMP_OID_INTERNAL_BUFFER_SIZE  16
+
 /**
  * Object identifier (OID)
  */
@@ -388,6 +474,11 @@ class LIBNXSNMP_EXPORTABLE SNMP_ObjectId
 private:
    size_t m_length;
    uint32_t *m_value;
+   uint32_t m_internalBuffer[SNMP_OID_INTERNAL_BUFFER_SIZE];
+
+   bool isInternalBuffer() const { return m_value == m_internalBuffer; }
+   void copyValue(const uint32_t *value, size_t length);
+   void resize(size_t length);
 
 public:
    SNMP_ObjectId();
@@ -419,6 +510,11 @@ class LIBNXSNMP_EXPORTABLE SNMP_ObjectId
    static SNMP_ObjectId parse(const TCHAR *oid);
 };
 
+/**
+ * Size of value buffer within SNMP_Variable object (larger values are allocated on heap)
+ */
+#define SNMP_VARIABLE_INTERNAL_BUFFER_SIZE   32
+
 /**
  * SNMP variable (varbind)
  */
@@ -429,6 +525,10 @@ class LIBNXSNMP_EXPORTABLE SNMP_Variable
    UINT32 m_type;
    size_t m_valueLength;
    BYTE *m_value;
+   uint64_t m_valueBuffer[SNMP_VARIABLE_INTERNAL_BUFFER_SIZE / sizeof(uint64_t)]; // 64 bit elements for proper alignment of integer values
+
+   bool isInternalBuffer() const { return m_value == reinterpret_cast<const BYTE*>(m_valueBuffer); }
+   BYTE *reallocValueBuffer(size_t length);
 
 public:
    SNMP_Variable();
@@ -439,7 +539,7 @@ class LIBNXSNMP_EXPORTABLE SNMP_Variable
    ~SNMP_Variable();
 
    bool parse(const BYTE *data, size_t varLength);
-   size_t encode(BYTE *buffer, size_t bufferSize);
+   size_t encode(BYTE *buffer, size_t bufferSize) const;
 
    const SNMP_ObjectId& getName() const { return m_name; }
    UINT32 getType() const { return m_type; }
@@ -583,6 +683,8 @@ class LIBNXSNMP_EXPORTABLE SNMP_PDU
    SNMP_Version m_version;
    uint32_t m_command;
    ObjectArray<SNMP_Variable> *m_variables;
+   SNMP_Variable *m_variableArena;   // Variables decoded from received packet are allocated as single block
+   int m_arenaSize;
    SNMP_ObjectId *m_pEnterprise;
    int m_trapType;
    int m_specificTrap;
@@ -608,7 +710,6 @@ class LIBNXSNMP_EXPORTABLE SNMP_PDU
 	BYTE m_signature[48];
 	size_t m_signatureOffset;
 
-   bool parseVariable(const BYTE *pData, size_t varLength);
    bool parseVarBinds(const BYTE *pData, size_t pduLength);
    bool parsePdu(const BYTE *pdu, size_t pduLength);
    bool parseTrapPDU(const BYTE *pData, size_t pduLength);
@@ -620,7 +721,9 @@ class LIBNXSNMP_EXPORTABLE SNMP_PDU
 	bool validateSignedMessage(const BYTE *msg, size_t msgLen, SNMP_SecurityContext *securityContext);
 	size_t encodeV3Header(BYTE *buffer, size_t bufferSize, SNMP_SecurityContext *securityContext);
 	size_t encodeV3SecurityParameters(BYTE *buffer, size_t bufferSize, SNMP_SecurityContext *securityContext);
-	size_t encodeV3ScopedPDU(uint32_t pduType, BYTE *pdu, size_t pduSize, BYTE *buffer, size_t bufferSize);
+	size_t encodeV3ScopedPDU(uint32_t pduType, bool withVarBinds, BYTE *buffer, size_t bufferSize);
+   size_t encodePduContent(uint32_t pduType, bool withVarBinds, BYTE *buffer, size_t bufferSize);
+   bool isArenaVariable(const SNMP_Variable *var) const { return (var >= m_variableArena) && (var < m_variableArena + m_arenaSize); }
 	void signMessage(BYTE *msg, size_t msgLen, SNMP_SecurityContext *securityContext);
 	bool decryptData(const BYTE *data, size_t length, BYTE *decryptedData, SNMP_SecurityContext *securityContext);
 
@@ -664,7 +767,7 @@ class LIBNXSNMP_EXPORTABLE SNMP_PDU
 	size_t getContextEngineIdLength() const { return m_contextEngineIdLen; }
 	const BYTE *getContextEngineId() const { return m_contextEngineId; }
 
-   void unlinkVariables() { m_variables->setOwner(Ownership::False); m_variables->clear(); m_variables->setOwner(Ownership::True); }
+   SNMP_Variable *detachVariable(int index);
    void bindVariable(SNMP_Variable *var);
 };
 
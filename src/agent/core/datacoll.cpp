@@ -29,6 +29,11 @@
  */
 #define STALLED_DATA_CHECK_INTERVAL    3600000
 
+/**
+ * Offline data log directory (relative to data directory)
+ */
+#define OFFLINE_DATA_FOLDER   _T("offline_data")
+
 /**
  * Externals
  */
@@ -48,10 +53,14 @@ extern Mutex g_proxyListMutex;
 
 extern UINT32 g_dcReconciliationBlockSize;
 extern UINT32 g_dcReconciliationTimeout;
+extern UINT32 g_dcSenderBatchSize;
+extern UINT32 g_dcSenderWindowSize;
 extern UINT32 g_dcWriterFlushInterval;
 extern UINT32 g_dcWriterMaxTransactionSize;
 extern UINT32 g_dcMaxCollectorPoolSize;
 extern UINT32 g_dcOfflineExpirationTime;
+extern TCHAR g_dcOfflineDataStorage[];
+extern UINT64 g_dcOfflineDataSegmentSize;
 
 /**
  * Data collector start indicator
@@ -164,11 +173,15 @@ enum class ScheduleType
    SECONDS = 2
 };
 
+class DataCollectionSchedule;
+
 /**
  * Data collection item
  */
 class DataCollectionItem : public RefCountObject
 {
+   friend class DataCollectionSchedule;
+
 private:
    uint64_t m_serverId;
    uint32_t m_id;
@@ -187,6 +200,10 @@ class DataCollectionItem : public RefCountObject
    StringList m_schedules;
    ScheduleType m_scheduleType;
    time_t m_tLastCheck;
+   time_t m_nextCheckTime;  // Next check time within scheduler wheel
+   int m_scheduleSlot;      // Scheduler wheel slot or -1 if not scheduled
+   DataCollectionItem *m_schedulePrev;
+   DataCollectionItem *m_scheduleNext;
 
 public:
    DataCollectionItem(uint64_t serverId, NXCPMessage *msg, uint32_t baseId, uint32_t extBaseId, bool hasExtraData);
@@ -208,6 +225,7 @@ class DataCollectionItem : public RefCountObject
    time_t getLastPollTime() { return m_lastPollTime; }
    uint32_t getBackupProxyId() const { return m_backupProxyId; }
    const ObjectArray<SNMPTableColumnDefinition> *getColumns() const { return m_tableColumns; }
+   ScheduleType getScheduleType() const { return m_scheduleType; }
 
    bool updateAndSave(const DataCollectionItem *item, bool txnOpen, DB_HANDLE hdb, DataCollectionStatementSet *statements);
    void saveToDatabase(bool newObject, DB_HANDLE hdb, DataCollectionStatementSet *statements);
@@ -217,10 +235,20 @@ class DataCollectionItem : public RefCountObject
    void startDataCollection() { m_busy = 1; incRefCount(); }
    void finishDataCollection() { m_busy = 0; decRefCount(); }
 
+   /**
+    * Get time to next check after poll was started (or while it is running)
+    */
+   uint32_t getRecheckInterval(time_t now) const
+   {
+      if (m_scheduleType == ScheduleType::NONE)
+         return m_pollingInterval;
+      return (m_scheduleType == ScheduleType::SECONDS) ? 1 : 60 - static_cast<uint32_t>(now % 60);
+   }
+
    uint32_t getTimeToNextPoll(time_t now)
    {
       if (m_busy) // being polled now - time to next poll should not be less than full polling interval
-         return m_pollingInterval;
+         return getRecheckInterval(now);
 
       if(m_scheduleType == ScheduleType::NONE)
       {
@@ -300,6 +328,10 @@ DataCollectionItem::DataCollectionItem(uint64_t serverId, NXCPMessage *msg, UINT
    m_backupProxyId = msg->getFieldAsInt32(baseId + 9);
    m_busy = 0;
    m_tLastCheck = 0;
+   m_nextCheckTime = 0;
+   m_scheduleSlot = -1;
+   m_schedulePrev = nullptr;
+   m_scheduleNext = nullptr;
 
    if (hasExtraData && (m_origin == DS_SNMP_AGENT))
    {
@@ -366,6 +398,10 @@ DataCollectionItem::DataCollectionItem(DB_RESULT hResult, int row)
    m_scheduleType = static_cast<ScheduleType>(DBGetFieldLong(hResult, row, 12));
    m_busy = 0;
    m_tLastCheck = 0;
+   m_nextCheckTime = 0;
+   m_scheduleSlot = -1;
+   m_schedulePrev = nullptr;
+   m_scheduleNext = nullptr;
 
    if ((m_origin == DS_SNMP_AGENT) && (m_type == DCO_TYPE_TABLE))
    {
@@ -452,6 +488,10 @@ DataCollectionItem::DataCollectionItem(DB_RESULT hResult, int row)
    }
    m_busy = 0;
    m_tLastCheck = 0;
+   m_nextCheckTime = 0;
+   m_scheduleSlot = -1;
+   m_schedulePrev = nullptr;
+   m_scheduleNext = nullptr;
    m_scheduleType = item->m_scheduleType;
  }
 
@@ -705,6 +745,8 @@ class DataElement
       Table *table;
    } m_value;
 
+   void setValue(TCHAR *text, char *xml);
+
 public:
    DataElement(DataCollectionItem *dci, const TCHAR *value, UINT32 status)
    {
@@ -755,41 +797,50 @@ class DataElement
       m_type = DBGetFieldLong(hResult, row, 2);
       m_statusCode = DBGetFieldLong(hResult, row, 4);
       m_snmpNode = DBGetFieldGUID(hResult, row, 5);
-      switch(m_type)
-      {
-         case DCO_TYPE_ITEM:
-            m_value.item = DBGetField(hResult, row, 7, NULL, 0);
-            break;
-         case DCO_TYPE_LIST:
-            {
-               m_value.list = new StringList();
-               TCHAR *text = DBGetField(hResult, row, 7, NULL, 0);
-               if (text != nullptr)
-               {
-                  m_value.list->splitAndAdd(text, _T("\n"));
-                  MemFree(text);
-               }
-            }
-            break;
-         case DCO_TYPE_TABLE:
-            {
-               char *xml = DBGetFieldUTF8(hResult, row, 7, NULL, 0);
-               if (xml != nullptr)
-               {
-                  m_value.table = Table::createFromXML(xml);
-                  MemFree(xml);
-               }
-               else
-               {
-                  m_value.table = nullptr;
-               }
-            }
-            break;
-         default:
-            m_type = DCO_TYPE_ITEM;
-            m_value.item = MemCopyString(_T(""));
-            break;
-      }
+      if (m_type == DCO_TYPE_TABLE)
+         setValue(nullptr, DBGetFieldUTF8(hResult, row, 7, NULL, 0));
+      else
+         setValue(DBGetField(hResult, row, 7, NULL, 0), nullptr);
+   }
+
+   /**
+    * Create data element from unbuffered database query result
+    * Expected field order: server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value
+    */
+   DataElement(DB_UNBUFFERED_RESULT hResult)
+   {
+      m_serverId = DBGetFieldUInt64(hResult, 0);
+      m_dciId = DBGetFieldULong(hResult, 1);
+      m_timestamp = (time_t)DBGetFieldInt64(hResult, 6);
+      m_origin = DBGetFieldLong(hResult, 3);
+      m_type = DBGetFieldLong(hResult, 2);
+      m_statusCode = DBGetFieldLong(hResult, 4);
+      m_snmpNode = DBGetFieldGUID(hResult, 5);
+      if (m_type == DCO_TYPE_TABLE)
+         setValue(nullptr, DBGetFieldUTF8(hResult, 7, NULL, 0));
+      else
+         setValue(DBGetField(hResult, 7, NULL, 0), nullptr);
+   }
+
+   /**
+    * Create data element from offline data log record
+    */
+   DataElement(UINT64 serverId, ByteStream *record)
+   {
+      m_serverId = serverId;
+      m_dciId = record->readUInt32();
+      m_timestamp = (time_t)record->readInt64();
+      m_origin = record->readInt16();
+      m_type = record->readInt16();
+      m_statusCode = record->readUInt32();
+      uuid_t guid;
+      memset(guid, 0, UUID_LENGTH);
+      record->read(guid, UUID_LENGTH);
+      m_snmpNode = uuid(guid);
+      if (m_type == DCO_TYPE_TABLE)
+         setValue(nullptr, record->readStringUtf8());
+      else
+         setValue(record->readString(), nullptr);
    }
 
    ~DataElement()
@@ -815,10 +866,39 @@ class DataElement
    UINT32 getStatusCode() { return m_statusCode; }
 
    void saveToDatabase(DB_STATEMENT hStmt);
+   void serialize(ByteStream *record);
    bool sendToServer(bool reconcillation);
    void fillReconciliationMessage(NXCPMessage *msg, UINT32 baseId);
 };
 
+/**
+ * Set value from textual representation (table values are expected in XML format). Takes ownership of provided strings.
+ */
+void DataElement::setValue(TCHAR *text, char *xml)
+{
+   switch(m_type)
+   {
+      case DCO_TYPE_ITEM:
+         m_value.item = (text != nullptr) ? text : MemCopyString(_T(""));
+         text = nullptr;
+         break;
+      case DCO_TYPE_LIST:
+         m_value.list = new StringList();
+         if (text != nullptr)
+            m_value.list->splitAndAdd(text, _T("\n"));
+         break;
+      case DCO_TYPE_TABLE:
+         m_value.table = (xml != nullptr) ? Table::createFromXML(xml) : nullptr;
+         break;
+      default:
+         m_type = DCO_TYPE_ITEM;
+         m_value.item = MemCopyString(_T(""));
+         break;
+   }
+   MemFree(text);
+   MemFree(xml);
+}
+
 /**
  * Save data element to database
  */
@@ -846,6 +926,39 @@ void DataElement::saveToDatabase(DB_STATEMENT hStmt)
    DBExecute(hStmt);
 }
 
+/**
+ * Serialize data element into offline data log record (server ID is not included)
+ */
+void DataElement::serialize(ByteStream *record)
+{
+   record->write(m_dciId);
+   record->write(static_cast<INT64>(m_timestamp));
+   record->write(static_cast<INT16>(m_origin));
+   record->write(static_cast<INT16>(m_type));
+   record->write(m_statusCode);
+   record->write(m_snmpNode.getValue(), UUID_LENGTH);
+   switch(m_type)
+   {
+      case DCO_TYPE_ITEM:
+         record->writeString(CHECK_NULL_EX(m_value.item));
+         break;
+      case DCO_TYPE_LIST:
+         {
+            TCHAR *text = m_value.list->join(_T("\n"));
+            record->writeString(text);
+            MemFree(text);
+         }
+         break;
+      case DCO_TYPE_TABLE:
+         {
+            TCHAR *xml = (m_value.table != nullptr) ? m_value.table->createXML() : nullptr;
+            record->writeString(CHECK_NULL_EX(xml));
+            MemFree(xml);
+         }
+         break;
+   }
+}
+
 /**
  * Session comparator
  */
@@ -911,6 +1024,63 @@ void DataElement::fillReconciliationMessage(NXCPMessage *msg, UINT32 baseId)
    msg->setField(baseId + 6, m_statusCode);
 }
 
+/**
+ * Send data elements to server in bulk mode. Returns ID of sent message or 0 on communication failure.
+ */
+static uint32_t SendBulkData(CommSession *session, ObjectArray<DataElement> *elements)
+{
+   NXCPMessage msg(CMD_DCI_DATA, session->generateRequestId(), session->getProtocolVersion());
+   msg.setField(VID_BULK_RECONCILIATION, (INT16)1);
+   msg.setField(VID_NUM_ELEMENTS, (INT16)elements->size());
+   msg.setField(VID_TIMEOUT, g_dcReconciliationTimeout);
+
+   UINT32 fieldId = VID_ELEMENT_LIST_BASE;
+   for(int i = 0; i < elements->size(); i++)
+   {
+      elements->get(i)->fillReconciliationMessage(&msg, fieldId);
+      fieldId += 10;
+   }
+
+   return session->sendMessage(&msg) ? msg.getId() : 0;
+}
+
+/**
+ * Wait for server acknowledgement of bulk data message. On success processing status
+ * of each data element is stored into provided status array. Returns request completion code.
+ */
+static uint32_t WaitForBulkDataAck(CommSession *session, uint32_t requestId, BYTE *status, int count, const TCHAR *caller)
+{
+   uint32_t rcc;
+   do
+   {
+      NXCPMessage *response = session->waitForMessage(CMD_REQUEST_COMPLETED, requestId, g_dcReconciliationTimeout);
+      if (response != nullptr)
+      {
+         rcc = response->getFieldAsUInt32(VID_RCC);
+         if (rcc == ERR_SUCCESS)
+         {
+            memset(status, 0, count);
+            response->getFieldAsBinary(VID_STATUS, status, count);
+         }
+         else if (rcc == ERR_PROCESSING)
+         {
+            nxlog_debug_tag(DEBUG_TAG, 4, _T("%s: server is processing data (%d%% completed)"), caller, response->getFieldAsInt32(VID_PROGRESS));
+         }
+         else
+         {
+            nxlog_debug_tag(DEBUG_TAG, 4, _T("%s: bulk send failed (%d)"), caller, rcc);
+         }
+         delete response;
+      }
+      else
+      {
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("%s: timeout on bulk send"), caller);
+         rcc = ERR_REQUEST_TIMEOUT;
+      }
+   } while(rcc == ERR_PROCESSING);
+   return rcc;
+}
+
 /**
  * Server data sync status object
  */
@@ -953,7 +1123,7 @@ static THREAD_RESULT THREAD_CALL DatabaseWriter(void *arg)
       if (e == INVALID_POINTER_VALUE)
          break;
 
-      DB_STATEMENT hStmt = DBPrepare(hdb, _T("INSERT INTO dc_queue (server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value) VALUES (?,?,?,?,?,?,?,?)"));
+      DB_STATEMENT hStmt = DBPrepareCached(hdb, _T("INSERT INTO dc_queue (server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value) VALUES (?,?,?,?,?,?,?,?)"));
       if (hStmt == NULL)
       {
          delete e;
@@ -989,275 +1159,798 @@ static THREAD_RESULT THREAD_CALL DatabaseWriter(void *arg)
 }
 
 /**
- * List of all data collection items
+ * Use offline data log instead of local database for offline data
  */
-static HashMap<ServerObjectKey, DataCollectionItem> s_items(Ownership::True);
-static Mutex s_itemLock;
+static bool s_useOfflineDataLog = false;
 
 /**
- * Session comparator
+ * Offline data logs (one per server)
  */
-static bool SessionComparator_Reconciliation(AbstractCommSession *session, void *data)
+static HashMap<UINT64, OfflineDataLog> s_offlineDataLogs(Ownership::False);
+static Mutex s_offlineDataLogLock;
+
+/**
+ * Build offline data log directory name for given server
+ */
+static void GetOfflineDataLogPath(UINT64 serverId, TCHAR *path)
 {
-   if ((session->getServerId() == 0) || !session->canAcceptData())
-      return false;
-   ServerSyncStatus *s = s_serverSyncStatus.get(session->getServerId());
-   if ((s != NULL) && (s->queueSize > 0))
-   {
-      return true;
-   }
-   return false;
+   TCHAR tail = g_szDataDirectory[_tcslen(g_szDataDirectory) - 1];
+   _sntprintf(path, MAX_PATH, _T("%s%s") OFFLINE_DATA_FOLDER FS_PATH_SEPARATOR UINT64X_FMT(_T("016")), g_szDataDirectory,
+              ((tail != '\\') && (tail != '/')) ? FS_PATH_SEPARATOR : _T(""), serverId);
 }
 
 /**
- * Data reconciliation thread
+ * Get offline data log for given server. Returned object should be released by caller with decRefCount().
  */
-static THREAD_RESULT THREAD_CALL ReconciliationThread(void *arg)
+static OfflineDataLog *GetOfflineDataLog(UINT64 serverId, bool create)
 {
-   DB_HANDLE hdb = GetLocalDatabaseHandle();
-   UINT32 sleepTime = 30000;
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data reconciliation thread started (block size %d, timeout %d ms)"), g_dcReconciliationBlockSize, g_dcReconciliationTimeout);
-
-   bool vacuumNeeded = false;
-   while(!AgentSleepAndCheckForShutdown(sleepTime))
-   {
-      // Check if there is something to sync
-      s_serverSyncStatusLock.lock();
-      CommSession *session = static_cast<CommSession*>(FindServerSession(SessionComparator_Reconciliation, NULL));
-      s_serverSyncStatusLock.unlock();
-      if (session == NULL)
+   s_offlineDataLogLock.lock();
+   OfflineDataLog *log = s_offlineDataLogs.get(serverId);
+   if ((log == nullptr) && create)
+   {
+      TCHAR path[MAX_PATH];
+      GetOfflineDataLogPath(serverId, path);
+      log = new OfflineDataLog(path, static_cast<size_t>(g_dcOfflineDataSegmentSize), (g_dwFlags & AF_COMPRESS_OFFLINE_DATA) != 0);
+      if (log->open())
       {
-         // Save last poll times when reconciliation thread is idle
-         s_itemLock.lock();
-         if (s_pollTimeChanged)
-         {
-            DBBegin(hdb);
-            TCHAR query[256];
-            Iterator<DataCollectionItem> *it = s_items.iterator();
-            while(it->hasNext())
-            {
-               DataCollectionItem *dci = it->next();
-               _sntprintf(query, 256, _T("UPDATE dc_config SET last_poll=") UINT64_FMT _T(" WHERE server_id=") UINT64_FMT _T(" AND dci_id=%d"),
-                          (UINT64)dci->getLastPollTime(), (UINT64)dci->getServerId(), dci->getId());
-               DBQuery(hdb, query);
-            }
-            DBCommit(hdb);
-            delete it;
-            s_pollTimeChanged = false;
-         }
-         s_itemLock.unlock();
-
-         if (vacuumNeeded)
-         {
-            nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: vacuum local database"));
-            DBQuery(hdb, _T("VACUUM"));
-            vacuumNeeded = false;
-         }
-         sleepTime = 30000;
-         continue;
+         s_offlineDataLogs.set(serverId, log);
       }
-
-      TCHAR query[1024];
-      _sntprintf(query, 1024, _T("SELECT server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value FROM dc_queue INDEXED BY idx_dc_queue_timestamp WHERE server_id=") UINT64_FMT _T(" ORDER BY timestamp LIMIT %d"), session->getServerId(), g_dcReconciliationBlockSize);
-
-      TCHAR sqlError[DBDRV_MAX_ERROR_TEXT];
-      DB_RESULT hResult = DBSelectEx(hdb, query, sqlError);
-      if (hResult == NULL)
+      else
       {
-         nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: database query failed: %s"), sqlError);
-         sleepTime = 30000;
-         session->decRefCount();
-         continue;
+         log->decRefCount();
+         log = nullptr;
       }
+   }
+   if (log != nullptr)
+      log->incRefCount();
+   s_offlineDataLogLock.unlock();
+   return log;
+}
 
-      int count = DBGetNumRows(hResult);
-      if (count > 0)
-      {
-         ObjectArray<DataElement> bulkSendList(count, 10, Ownership::True);
-         ObjectArray<DataElement> deleteList(count, 10, Ownership::True);
-         for(int i = 0; i < count; i++)
-         {
-            DataElement *e = new DataElement(hResult, i);
-            if ((e->getType() == DCO_TYPE_ITEM) && session->isBulkReconciliationSupported())
-            {
-               bulkSendList.add(e);
-            }
-            else
-            {
-               s_serverSyncStatusLock.lock();
-               ServerSyncStatus *status = s_serverSyncStatus.get(e->getServerId());
-               if (status != NULL)
-               {
-                  if (e->sendToServer(true))
-                  {
-                     status->queueSize--;
-                     status->lastSync = time(NULL);
-                     deleteList.add(e);
-                  }
-                  else
-                  {
-                     delete e;
-                  }
-               }
-               else
-               {
-                  nxlog_debug_tag(DEBUG_TAG, 5, _T("INTERNAL ERROR: cached DCI value without server sync status object"));
-                  deleteList.add(e);  // record should be deleted
-               }
-               s_serverSyncStatusLock.unlock();
-            }
-         }
-
-         if (bulkSendList.size() > 0)
-         {
-            nxlog_debug_tag(DEBUG_TAG, 6, _T("ReconciliationThread: %d records to be sent in bulk mode"), bulkSendList.size());
-
-            NXCPMessage msg(CMD_DCI_DATA, session->generateRequestId(), session->getProtocolVersion());
-            msg.setField(VID_BULK_RECONCILIATION, (INT16)1);
-            msg.setField(VID_NUM_ELEMENTS, (INT16)bulkSendList.size());
-            msg.setField(VID_TIMEOUT, g_dcReconciliationTimeout);
-
-            UINT32 fieldId = VID_ELEMENT_LIST_BASE;
-            for(int i = 0; i < bulkSendList.size(); i++)
-            {
-               bulkSendList.get(i)->fillReconciliationMessage(&msg, fieldId);
-               fieldId += 10;
-            }
+/**
+ * Delete offline data log for given server
+ */
+static void DeleteOfflineDataLog(UINT64 serverId)
+{
+   s_offlineDataLogLock.lock();
+   OfflineDataLog *log = s_offlineDataLogs.get(serverId);
+   if (log != nullptr)
+   {
+      s_offlineDataLogs.remove(serverId);
+   }
+   else
+   {
+      TCHAR path[MAX_PATH];
+      GetOfflineDataLogPath(serverId, path);
+      log = new OfflineDataLog(path, static_cast<size_t>(g_dcOfflineDataSegmentSize), false);
+      log->open();
+   }
+   log->destroy();
+   log->decRefCount();
+   s_offlineDataLogLock.unlock();
+}
 
-            if (session->sendMessage(&msg))
-            {
-               UINT32 rcc;
-               do
-               {
-                  NXCPMessage *response = session->waitForMessage(CMD_REQUEST_COMPLETED, msg.getId(), g_dcReconciliationTimeout);
-                  if (response != NULL)
-                  {
-                     rcc = response->getFieldAsUInt32(VID_RCC);
-                     if (rcc == ERR_SUCCESS)
-                     {
-                        s_serverSyncStatusLock.lock();
-                        ServerSyncStatus *serverSyncStatus = s_serverSyncStatus.get(session->getServerId());
-
-                        // Check status for each data element
-                        BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
-                        memset(status, 0, MAX_BULK_DATA_BLOCK_SIZE);
-                        response->getFieldAsBinary(VID_STATUS, status, MAX_BULK_DATA_BLOCK_SIZE);
-                        bulkSendList.setOwner(Ownership::False);
-                        for(int i = 0; i < bulkSendList.size(); i++)
-                        {
-                           DataElement *e = bulkSendList.get(i);
-                           if (status[i] != BULK_DATA_REC_RETRY)
-                           {
-                              deleteList.add(e);
-                              serverSyncStatus->queueSize--;
-                           }
-                           else
-                           {
-                              delete e;
-                           }
-                        }
-                        serverSyncStatus->lastSync = time(NULL);
-
-                        s_serverSyncStatusLock.unlock();
-                     }
-                     else if (rcc == ERR_PROCESSING)
-                     {
-                        nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: server is processing data (%d%% completed)"), response->getFieldAsInt32(VID_PROGRESS));
-                     }
-                     else
-                     {
-                        nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: bulk send failed (%d)"), rcc);
-                     }
-                     delete response;
-                  }
-                  else
-                  {
-                     nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: timeout on bulk send"));
-                     rcc = ERR_REQUEST_TIMEOUT;
-                  }
-               } while(rcc == ERR_PROCESSING);
-            }
-            else
-            {
-               nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: communication error"));
-            }
-         }
+/**
+ * Get list of servers with offline data log present on disk
+ */
+static void GetOfflineDataLogServers(IntegerArray<UINT64> *servers)
+{
+   TCHAR path[MAX_PATH];
+   TCHAR tail = g_szDataDirectory[_tcslen(g_szDataDirectory) - 1];
+   _sntprintf(path, MAX_PATH, _T("%s%s") OFFLINE_DATA_FOLDER, g_szDataDirectory, ((tail != '\\') && (tail != '/')) ? FS_PATH_SEPARATOR : _T(""));
 
-         if (deleteList.size() > 0)
-         {
-            DB_STATEMENT hStmt = DBPrepare(hdb, _T("DELETE FROM dc_queue WHERE server_id=? AND dci_id=? AND timestamp=?"), true);
-            if (hStmt != NULL)
-            {
-               DBBegin(hdb);
-               for(int i = 0; i < deleteList.size(); i++)
-               {
-                  DataElement *e = deleteList.get(i);
-                  DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, e->getServerId());
-                  DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, e->getDciId());
-                  DBBind(hStmt, 3, DB_SQLTYPE_BIGINT, static_cast<INT64>(e->getTimestamp()));
-                  DBExecute(hStmt);
-               }
-               DBCommit(hdb);
-               DBFreeStatement(hStmt);
-               vacuumNeeded = true;
-            }
-            nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: %d records sent"), deleteList.size());
-         }
-      }
-      DBFreeResult(hResult);
+   _TDIR *dir = _topendir(path);
+   if (dir == nullptr)
+      return;
 
-      session->decRefCount();
-      sleepTime = (count > 0) ? 50 : 30000;
+   struct _tdirent *d;
+   while((d = _treaddir(dir)) != nullptr)
+   {
+      if (_tcslen(d->d_name) != 16)
+         continue;
+      TCHAR *eptr;
+      UINT64 serverId = _tcstoull(d->d_name, &eptr, 16);
+      if (*eptr == 0)
+         servers->add(serverId);
    }
-
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data reconciliation thread stopped"));
-   return THREAD_OK;
+   _tclosedir(dir);
 }
 
 /**
- * Data sender queue
+ * Append data element to offline data log
  */
-static Queue s_dataSenderQueue;
+static void AppendToOfflineDataLog(OfflineDataLog *log, DataElement *e)
+{
+   ByteStream record(1024);
+   e->serialize(&record);
+   if (!log->append(record.buffer(), record.size(), e->getTimestamp()))
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("Cannot write offline data record for DCI [%u]"), e->getDciId());
+}
 
 /**
- * Data sender
+ * Callback for flushing offline data logs
  */
-static THREAD_RESULT THREAD_CALL DataSender(void *arg)
+static EnumerationCallbackResult FlushOfflineDataLog(const UINT64& serverId, OfflineDataLog *log)
 {
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread started"));
-   while(true)
-   {
-      DataElement *e = static_cast<DataElement*>(s_dataSenderQueue.getOrBlock());
-      if (e == INVALID_POINTER_VALUE)
-         break;
+   log->flush();
+   return _CONTINUE;
+}
 
+/**
+ * Callback for releasing offline data logs
+ */
+static EnumerationCallbackResult ReleaseOfflineDataLog(const UINT64& serverId, OfflineDataLog *log)
+{
+   log->decRefCount();
+   return _CONTINUE;
+}
+
+/**
+ * Offline data log writer
+ */
+static THREAD_RESULT THREAD_CALL OfflineDataLogWriter(void *arg)
+{
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Offline data log writer thread started"));
+
+   while(true)
+   {
+      DataElement *e = s_databaseWriterQueue.getOrBlock();
+      if (e == INVALID_POINTER_VALUE)
+         break;
+
+      UINT32 count = 0;
+      OfflineDataLog *log = nullptr;
+      UINT64 logServerId = 0;
+      while((e != NULL) && (e != INVALID_POINTER_VALUE))
+      {
+         if ((log == nullptr) || (logServerId != e->getServerId()))
+         {
+            if (log != nullptr)
+               log->decRefCount();
+            log = GetOfflineDataLog(e->getServerId(), true);
+            logServerId = e->getServerId();
+         }
+         if (log != nullptr)
+            AppendToOfflineDataLog(log, e);
+         delete e;
+
+         count++;
+         if (count == g_dcWriterMaxTransactionSize)
+            break;
+
+         e = s_databaseWriterQueue.get();
+      }
+      if (log != nullptr)
+         log->decRefCount();
+
+      s_offlineDataLogLock.lock();
+      s_offlineDataLogs.forEach(FlushOfflineDataLog);
+      s_offlineDataLogLock.unlock();
+
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("Offline data log writer: %u records written"), count);
+      if (e == INVALID_POINTER_VALUE)
+         break;
+
+      // Sleep only if queue was emptied
+      if (count < g_dcWriterMaxTransactionSize)
+         ThreadSleepMs(g_dcWriterFlushInterval);
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Offline data log writer thread stopped"));
+   return THREAD_OK;
+}
+
+/**
+ * List of all data collection items
+ */
+static HashMap<ServerObjectKey, DataCollectionItem> s_items(Ownership::True);
+static Mutex s_itemLock;
+
+/**
+ * Number of slots in data collection scheduler wheel (one slot per second)
+ */
+#define SCHEDULE_WHEEL_SIZE   3600
+
+/**
+ * Data collection schedule - hashed timing wheel keyed by item's next check time.
+ * Items are kept in intrusive doubly linked lists, so insertion and removal are O(1)
+ * and scheduler run only touches items that are actually due. Items with check time
+ * beyond wheel size stay in their slot until wheel reaches them again.
+ * Should be accessed only while holding s_itemLock.
+ */
+class DataCollectionSchedule
+{
+private:
+   DataCollectionItem *m_slots[SCHEDULE_WHEEL_SIZE];
+   time_t m_currentTime;   // Last processed time
+   int m_size;
+
+   void link(DataCollectionItem *dci, int slot)
+   {
+      dci->m_scheduleSlot = slot;
+      dci->m_schedulePrev = nullptr;
+      dci->m_scheduleNext = m_slots[slot];
+      if (m_slots[slot] != nullptr)
+         m_slots[slot]->m_schedulePrev = dci;
+      m_slots[slot] = dci;
+      m_size++;
+   }
+
+public:
+   DataCollectionSchedule()
+   {
+      memset(m_slots, 0, sizeof(m_slots));
+      m_currentTime = 0;
+      m_size = 0;
+   }
+
+   /**
+    * Get number of scheduled items
+    */
+   int size() const { return m_size; }
+
+   /**
+    * Add item to schedule (item should not be already scheduled). Check times in the past are moved to next scheduler run.
+    */
+   void add(DataCollectionItem *dci, time_t checkTime)
+   {
+      if (checkTime <= m_currentTime)
+         checkTime = m_currentTime + 1;
+      dci->m_nextCheckTime = checkTime;
+      link(dci, static_cast<int>(checkTime % SCHEDULE_WHEEL_SIZE));
+   }
+
+   /**
+    * Remove item from schedule (does nothing if item is not scheduled)
+    */
+   void remove(DataCollectionItem *dci)
+   {
+      if (dci->m_scheduleSlot == -1)
+         return;
+      if (dci->m_schedulePrev != nullptr)
+         dci->m_schedulePrev->m_scheduleNext = dci->m_scheduleNext;
+      else
+         m_slots[dci->m_scheduleSlot] = dci->m_scheduleNext;
+      if (dci->m_scheduleNext != nullptr)
+         dci->m_scheduleNext->m_schedulePrev = dci->m_schedulePrev;
+      dci->m_scheduleSlot = -1;
+      dci->m_schedulePrev = nullptr;
+      dci->m_scheduleNext = nullptr;
+      m_size--;
+   }
+
+   /**
+    * Move item to new check time
+    */
+   void reschedule(DataCollectionItem *dci, time_t checkTime)
+   {
+      remove(dci);
+      add(dci, checkTime);
+   }
+
+   /**
+    * Remove all items from schedule
+    */
+   void clear()
+   {
+      for(int i = 0; i < SCHEDULE_WHEEL_SIZE; i++)
+      {
+         for(DataCollectionItem *dci = m_slots[i]; dci != nullptr;)
+         {
+            DataCollectionItem *next = dci->m_scheduleNext;
+            dci->m_scheduleSlot = -1;
+            dci->m_schedulePrev = nullptr;
+            dci->m_scheduleNext = nullptr;
+            dci = next;
+         }
+         m_slots[i] = nullptr;
+      }
+      m_size = 0;
+   }
+
+   /**
+    * Advance wheel to given time and remove all items due at or before that time from schedule
+    */
+   void advance(time_t now, ObjectArray<DataCollectionItem> *dueItems)
+   {
+      if (now < m_currentTime)
+      {
+         // System clock moved backwards - check all items on this run
+         nxlog_debug_tag(DEBUG_TAG, 3, _T("DataCollector: system time moved backwards, rescheduling all items"));
+         for(int i = 0; i < SCHEDULE_WHEEL_SIZE; i++)
+         {
+            for(DataCollectionItem *dci = m_slots[i]; dci != nullptr; dci = dci->m_scheduleNext)
+               dueItems->add(dci);
+         }
+         clear();
+         m_currentTime = now;
+         return;
+      }
+
+      time_t start = (now - m_currentTime >= SCHEDULE_WHEEL_SIZE) ? now - SCHEDULE_WHEEL_SIZE + 1 : m_currentTime + 1;
+      for(time_t t = start; t <= now; t++)
+      {
+         DataCollectionItem *dci = m_slots[t % SCHEDULE_WHEEL_SIZE];
+         while(dci != nullptr)
+         {
+            DataCollectionItem *next = dci->m_scheduleNext;
+            if (dci->m_nextCheckTime <= now)
+            {
+               remove(dci);
+               dueItems->add(dci);
+            }
+            dci = next;
+         }
+      }
+      m_currentTime = now;
+   }
+
+   /**
+    * Get time (in seconds) until next scheduled check, but not more than given limit
+    */
+   uint32_t getTimeToNextCheck(uint32_t limit) const
+   {
+      for(uint32_t i = 1; i < limit; i++)
+      {
+         time_t t = m_currentTime + i;
+         for(DataCollectionItem *dci = m_slots[t % SCHEDULE_WHEEL_SIZE]; dci != nullptr; dci = dci->m_scheduleNext)
+         {
+            if (dci->m_nextCheckTime <= t)
+               return i;
+         }
+      }
+      return limit;
+   }
+};
+
+/**
+ * Data collection schedule
+ */
+static DataCollectionSchedule s_schedule;
+
+/**
+ * Session comparator
+ */
+static bool SessionComparator_Reconciliation(AbstractCommSession *session, void *data)
+{
+   if ((session->getServerId() == 0) || !session->canAcceptData())
+      return false;
+   ServerSyncStatus *s = s_serverSyncStatus.get(session->getServerId());
+   if ((s != NULL) && (s->queueSize > 0))
+   {
+      return true;
+   }
+   return false;
+}
+
+/**
+ * Read block of offline data for given server from local database
+ */
+static bool ReadOfflineDataFromDatabase(DB_HANDLE hdb, UINT64 serverId, ObjectArray<DataElement> *elements)
+{
+   TCHAR query[1024];
+   _sntprintf(query, 1024, _T("SELECT server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value FROM dc_queue INDEXED BY idx_dc_queue_timestamp WHERE server_id=") UINT64_FMT _T(" ORDER BY timestamp LIMIT %d"), serverId, g_dcReconciliationBlockSize);
+
+   TCHAR sqlError[DBDRV_MAX_ERROR_TEXT];
+   DB_RESULT hResult = DBSelectEx(hdb, query, sqlError);
+   if (hResult == NULL)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: database query failed: %s"), sqlError);
+      return false;
+   }
+
+   int count = DBGetNumRows(hResult);
+   for(int i = 0; i < count; i++)
+      elements->add(new DataElement(hResult, i));
+   DBFreeResult(hResult);
+   return true;
+}
+
+/**
+ * Delete elements marked as accepted from local database. Returns number of deleted elements.
+ */
+static int DeleteOfflineDataFromDatabase(DB_HANDLE hdb, ObjectArray<DataElement> *elements, const BYTE *accepted)
+{
+   DB_STATEMENT hStmt = DBPrepare(hdb, _T("DELETE FROM dc_queue WHERE server_id=? AND dci_id=? AND timestamp=?"), true);
+   if (hStmt == NULL)
+      return 0;
+
+   int count = 0;
+   DBBegin(hdb);
+   for(int i = 0; i < elements->size(); i++)
+   {
+      if (!accepted[i])
+         continue;
+
+      DataElement *e = elements->get(i);
+      DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, e->getServerId());
+      DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, e->getDciId());
+      DBBind(hStmt, 3, DB_SQLTYPE_BIGINT, static_cast<INT64>(e->getTimestamp()));
+      DBExecute(hStmt);
+      count++;
+   }
+   DBCommit(hdb);
+   DBFreeStatement(hStmt);
+   return count;
+}
+
+/**
+ * Read block of offline data from offline data log. Records that cannot be decoded are added as NULL elements.
+ */
+static void ReadOfflineDataFromLog(OfflineDataLog *log, UINT64 serverId, ObjectArray<DataElement> *elements)
+{
+   ObjectArray<ByteStream> records(g_dcReconciliationBlockSize, 64, Ownership::True);
+   log->read(&records, g_dcReconciliationBlockSize);
+   for(int i = 0; i < records.size(); i++)
+   {
+      ByteStream *record = records.get(i);
+      elements->add((record->size() > 0) ? new DataElement(serverId, record) : nullptr);
+   }
+}
+
+/**
+ * Data reconciliation thread
+ */
+static THREAD_RESULT THREAD_CALL ReconciliationThread(void *arg)
+{
+   DB_HANDLE hdb = GetLocalDatabaseHandle();
+   UINT32 sleepTime = 30000;
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data reconciliation thread started (block size %d, timeout %d ms)"), g_dcReconciliationBlockSize, g_dcReconciliationTimeout);
+
+   bool vacuumNeeded = false;
+   while(!AgentSleepAndCheckForShutdown(sleepTime))
+   {
+      // Check if there is something to sync
       s_serverSyncStatusLock.lock();
-      ServerSyncStatus *status = s_serverSyncStatus.get(e->getServerId());
-      if (status == NULL)
+      CommSession *session = static_cast<CommSession*>(FindServerSession(SessionComparator_Reconciliation, NULL));
+      s_serverSyncStatusLock.unlock();
+      if (session == NULL)
+      {
+         // Save last poll times when reconciliation thread is idle
+         s_itemLock.lock();
+         if (s_pollTimeChanged)
+         {
+            DBBegin(hdb);
+            TCHAR query[256];
+            Iterator<DataCollectionItem> *it = s_items.iterator();
+            while(it->hasNext())
+            {
+               DataCollectionItem *dci = it->next();
+               _sntprintf(query, 256, _T("UPDATE dc_config SET last_poll=") UINT64_FMT _T(" WHERE server_id=") UINT64_FMT _T(" AND dci_id=%d"),
+                          (UINT64)dci->getLastPollTime(), (UINT64)dci->getServerId(), dci->getId());
+               DBQuery(hdb, query);
+            }
+            DBCommit(hdb);
+            delete it;
+            s_pollTimeChanged = false;
+         }
+         s_itemLock.unlock();
+
+         if (vacuumNeeded)
+         {
+            nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: vacuum local database"));
+            DBQuery(hdb, _T("VACUUM"));
+            vacuumNeeded = false;
+         }
+         sleepTime = 30000;
+         continue;
+      }
+
+      UINT64 serverId = session->getServerId();
+      ObjectArray<DataElement> elements(g_dcReconciliationBlockSize, 64, Ownership::True);
+      OfflineDataLog *log = nullptr;
+      if (s_useOfflineDataLog)
+      {
+         log = GetOfflineDataLog(serverId, false);
+         if (log != nullptr)
+            ReadOfflineDataFromLog(log, serverId, &elements);
+      }
+      else if (!ReadOfflineDataFromDatabase(hdb, serverId, &elements))
       {
-         status = new ServerSyncStatus(e->getServerId());
-         s_serverSyncStatus.set(e->getServerId(), status);
+         sleepTime = 30000;
+         session->decRefCount();
+         continue;
+      }
+
+      int count = elements.size();
+      if (count > 0)
+      {
+         // Elements accepted by server or to be dropped
+         BYTE accepted[MAX_BULK_DATA_BLOCK_SIZE];
+         memset(accepted, 0, count);
+
+         ObjectArray<DataElement> bulkSendList(count, 10, Ownership::False);
+         int *bulkIndex = MemAllocArrayNoInit<int>(count);
+         for(int i = 0; i < count; i++)
+         {
+            DataElement *e = elements.get(i);
+            if (e == nullptr)
+            {
+               accepted[i] = 1;  // record cannot be decoded and should be dropped
+            }
+            else if ((e->getType() == DCO_TYPE_ITEM) && session->isBulkReconciliationSupported())
+            {
+               bulkIndex[bulkSendList.size()] = i;
+               bulkSendList.add(e);
+            }
+            else if (e->sendToServer(true))
+            {
+               accepted[i] = 1;
+            }
+            else if (log != nullptr)
+            {
+               // Offline data log is confirmed sequentially, so records after failed one will be read again anyway
+               break;
+            }
+         }
+
+         if (bulkSendList.size() > 0)
+         {
+            nxlog_debug_tag(DEBUG_TAG, 6, _T("ReconciliationThread: %d records to be sent in bulk mode"), bulkSendList.size());
+
+            uint32_t requestId = SendBulkData(session, &bulkSendList);
+            if (requestId != 0)
+            {
+               BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
+               if (WaitForBulkDataAck(session, requestId, status, bulkSendList.size(), _T("ReconciliationThread")) == ERR_SUCCESS)
+               {
+                  for(int i = 0; i < bulkSendList.size(); i++)
+                  {
+                     if (status[i] != BULK_DATA_REC_RETRY)
+                        accepted[bulkIndex[i]] = 1;
+                  }
+               }
+            }
+            else
+            {
+               nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: communication error"));
+            }
+         }
+         MemFree(bulkIndex);
+
+         int processed = 0;
+         if (log != nullptr)
+         {
+            // Read cursor can only be moved up to first record not accepted by server
+            while((processed < count) && accepted[processed])
+               processed++;
+            log->commit(processed);
+         }
+         else
+         {
+            processed = DeleteOfflineDataFromDatabase(hdb, &elements, accepted);
+            if (processed > 0)
+               vacuumNeeded = true;
+         }
+
+         if (processed > 0)
+         {
+            s_serverSyncStatusLock.lock();
+            ServerSyncStatus *serverSyncStatus = s_serverSyncStatus.get(serverId);
+            if (serverSyncStatus != nullptr)
+            {
+               serverSyncStatus->queueSize -= processed;
+               serverSyncStatus->lastSync = time(NULL);
+            }
+            s_serverSyncStatusLock.unlock();
+            nxlog_debug_tag(DEBUG_TAG, 4, _T("ReconciliationThread: %d records sent"), processed);
+         }
       }
 
-      if (status->queueSize == 0)
+      if (log != nullptr)
+         log->decRefCount();
+      session->decRefCount();
+      sleepTime = (count > 0) ? 50 : 30000;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data reconciliation thread stopped"));
+   return THREAD_OK;
+}
+
+/**
+ * Data sender queue
+ */
+static Queue s_dataSenderQueue;
+
+/**
+ * Bulk data message sent to server and waiting for acknowledgement
+ */
+struct PendingBulkData
+{
+   CommSession *session;
+   uint64_t serverId;
+   uint32_t requestId;
+   ObjectArray<DataElement> elements;
+
+   PendingBulkData(CommSession *_session) : elements(64, 64, Ownership::True)
+   {
+      session = _session;
+      session->incRefCount();
+      serverId = session->getServerId();
+      requestId = 0;
+   }
+
+   ~PendingBulkData()
+   {
+      session->decRefCount();
+   }
+};
+
+/**
+ * Get server sync status object, create new one if needed. Caller must hold server sync status lock.
+ */
+static ServerSyncStatus *GetServerSyncStatus(uint64_t serverId)
+{
+   ServerSyncStatus *status = s_serverSyncStatus.get(serverId);
+   if (status == NULL)
+   {
+      status = new ServerSyncStatus(serverId);
+      s_serverSyncStatus.set(serverId, status);
+   }
+   return status;
+}
+
+/**
+ * Route data element to server - either add it to bulk message for that server, send it immediately,
+ * or store in local database for later reconciliation.
+ */
+static void RouteDataElement(DataElement *e, ObjectArray<PendingBulkData> *batches)
+{
+   s_serverSyncStatusLock.lock();
+   ServerSyncStatus *status = GetServerSyncStatus(e->getServerId());
+   if (status->queueSize == 0)
+   {
+      if (e->getType() == DCO_TYPE_ITEM)
       {
-         if (!e->sendToServer(false))
+         PendingBulkData *batch = NULL;
+         for(int i = 0; i < batches->size(); i++)
          {
-            status->queueSize++;
-            s_databaseWriterQueue.put(e);
+            if (batches->get(i)->serverId == e->getServerId())
+            {
+               batch = batches->get(i);
+               break;
+            }
+         }
+         if (batch == NULL)
+         {
+            uint64_t serverId = e->getServerId();
+            CommSession *session = static_cast<CommSession*>(FindServerSession(SessionComparator_Sender, &serverId));
+            if (session != NULL)
+            {
+               if (session->isBulkDataPushSupported())
+               {
+                  batch = new PendingBulkData(session);
+                  batches->add(batch);
+               }
+               session->decRefCount();
+            }
+         }
+         if (batch != NULL)
+         {
+            batch->elements.add(e);
             e = NULL;
          }
       }
-      else
+
+      if ((e != NULL) && !e->sendToServer(false))
       {
          status->queueSize++;
          s_databaseWriterQueue.put(e);
          e = NULL;
       }
-      s_serverSyncStatusLock.unlock();
+   }
+   else
+   {
+      status->queueSize++;
+      s_databaseWriterQueue.put(e);
+      e = NULL;
+   }
+   s_serverSyncStatusLock.unlock();
+
+   delete e;
+}
+
+/**
+ * Store all elements of bulk data message that were not accepted by server in local database
+ */
+static void CompleteBulkData(PendingBulkData *batch, uint32_t rcc, const BYTE *status)
+{
+   s_serverSyncStatusLock.lock();
+   ServerSyncStatus *syncStatus = GetServerSyncStatus(batch->serverId);
+   int sent = 0;
+   batch->elements.setOwner(Ownership::False);
+   for(int i = 0; i < batch->elements.size(); i++)
+   {
+      DataElement *e = batch->elements.get(i);
+      if ((rcc == ERR_SUCCESS) && (status[i] != BULK_DATA_REC_RETRY))
+      {
+         delete e;
+         sent++;
+      }
+      else
+      {
+         syncStatus->queueSize++;
+         s_databaseWriterQueue.put(e);
+      }
+   }
+   s_serverSyncStatusLock.unlock();
+   nxlog_debug_tag(DEBUG_TAG, 7, _T("DataSender: bulk message %u: %d of %d records accepted by server"), batch->requestId, sent, batch->elements.size());
+}
+
+/**
+ * Wait for acknowledgement of oldest in-flight bulk data message
+ */
+static void WaitForOldestBulkData(ObjectArray<PendingBulkData> *inFlight)
+{
+   PendingBulkData *batch = inFlight->get(0);
+   BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
+   uint32_t rcc = WaitForBulkDataAck(batch->session, batch->requestId, status, batch->elements.size(), _T("DataSender"));
+   CompleteBulkData(batch, rcc, status);
+   inFlight->remove(0);
+}
+
+/**
+ * Data sender. Collected values are sent to server in batches using pipelined bulk data messages -
+ * up to configured number of messages can be sent before waiting for acknowledgement of the first one.
+ */
+static THREAD_RESULT THREAD_CALL DataSender(void *arg)
+{
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread started (batch size %u, window size %u)"), g_dcSenderBatchSize, g_dcSenderWindowSize);
+   ObjectArray<PendingBulkData> inFlight(16, 16, Ownership::True);
+   bool shutdown = false;
+   while(!shutdown)
+   {
+      DataElement *e = static_cast<DataElement*>(s_dataSenderQueue.getOrBlock());
+      if (e == INVALID_POINTER_VALUE)
+         break;
 
-      delete e;
+      // Read all available elements up to batch size
+      ObjectArray<PendingBulkData> batches(4, 4, Ownership::False);
+      UINT32 count = 0;
+      while(true)
+      {
+         RouteDataElement(e, &batches);
+         if (++count >= g_dcSenderBatchSize)
+            break;
+         e = static_cast<DataElement*>(s_dataSenderQueue.get());
+         if (e == NULL)
+            break;
+         if (e == INVALID_POINTER_VALUE)
+         {
+            shutdown = true;
+            break;
+         }
+      }
+
+      for(int i = 0; i < batches.size(); i++)
+      {
+         PendingBulkData *batch = batches.get(i);
+         batch->requestId = SendBulkData(batch->session, &batch->elements);
+         if (batch->requestId != 0)
+         {
+            inFlight.add(batch);
+            while(inFlight.size() >= static_cast<int>(g_dcSenderWindowSize))
+               WaitForOldestBulkData(&inFlight);
+         }
+         else
+         {
+            nxlog_debug_tag(DEBUG_TAG, 4, _T("DataSender: communication error"));
+            CompleteBulkData(batch, ERR_CONNECTION_BROKEN, NULL);
+            delete batch;
+         }
+      }
+
+      // Collect outstanding acknowledgements if there is no more data to send
+      if (shutdown || (s_dataSenderQueue.size() == 0))
+      {
+         while(!inFlight.isEmpty())
+            WaitForOldestBulkData(&inFlight);
+      }
    }
+
+   while(!inFlight.isEmpty())
+      WaitForOldestBulkData(&inFlight);
+
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Data sender thread stopped"));
    return THREAD_OK;
 }
@@ -1373,14 +2066,17 @@ ThreadPool *g_dataCollectorPool = nullptr;
  */
 static UINT32 DataCollectionSchedulerRun()
 {
-   UINT32 sleepTime = 60;
+   ObjectArray<DataCollectionItem> dueItems(256, 256, Ownership::False);
 
    s_itemLock.lock();
    time_t now = time(nullptr);
-   Iterator<DataCollectionItem> *it = s_items.iterator();
-   while(it->hasNext())
+   s_schedule.advance(now, &dueItems);
+
+   // Proxy list is locked once for all due items with backup proxy
+   bool proxyListLocked = false;
+   for(int i = 0; i < dueItems.size(); i++)
    {
-      DataCollectionItem *dci = it->next();
+      DataCollectionItem *dci = dueItems.get(i);
       UINT32 timeToPoll = dci->getTimeToNextPoll(now);
       if (timeToPoll == 0)
       {
@@ -1391,10 +2087,13 @@ static UINT32 DataCollectionSchedulerRun()
          }
          else
          {
-            g_proxyListMutex.lock();
+            if (!proxyListLocked)
+            {
+               g_proxyListMutex.lock();
+               proxyListLocked = true;
+            }
             DataCollectionProxy *proxy = g_proxyList.get(ServerObjectKey(dci->getServerId(), dci->getBackupProxyId()));
             schedule = ((proxy != NULL) && !proxy->isConnected());
-            g_proxyListMutex.unlock();
          }
 
          if (schedule)
@@ -1419,13 +2118,18 @@ static UINT32 DataCollectionSchedulerRun()
             }
          }
 
-         timeToPoll = dci->getPollingInterval();
+         timeToPoll = dci->getRecheckInterval(now);
       }
-      if (sleepTime > timeToPoll)
-         sleepTime = timeToPoll;
+      s_schedule.add(dci, now + MAX(timeToPoll, 1));
    }
-   delete it;
+   if (proxyListLocked)
+      g_proxyListMutex.unlock();
+
+   UINT32 sleepTime = s_schedule.getTimeToNextCheck(60);
    s_itemLock.unlock();
+
+   if (!dueItems.isEmpty())
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("DataCollector: %d items checked, %d items scheduled"), dueItems.size(), s_schedule.size());
    return sleepTime;
 }
 
@@ -1526,12 +2230,21 @@ void ConfigureDataCollection(uint64_t serverId, NXCPMessage *msg)
       DataCollectionItem *existingItem = s_items.get(item->getKey());
       if (existingItem != nullptr)
       {
+         uint32_t pollingInterval = existingItem->getPollingInterval();
+         ScheduleType scheduleType = existingItem->getScheduleType();
+         time_t lastPollTime = existingItem->getLastPollTime();
          txnOpen = existingItem->updateAndSave(item, txnOpen, hdb, &statements);
+         if ((pollingInterval != existingItem->getPollingInterval()) || (scheduleType != existingItem->getScheduleType()) ||
+             (lastPollTime != existingItem->getLastPollTime()))
+         {
+            s_schedule.reschedule(existingItem, time(nullptr));
+         }
       }
       else
       {
          DataCollectionItem *newItem = new DataCollectionItem(item);
          s_items.set(newItem->getKey(), newItem);
+         s_schedule.add(newItem, time(nullptr));
          if (!txnOpen)
          {
             DBBegin(hdb);
@@ -1572,6 +2285,7 @@ void ConfigureDataCollection(uint64_t serverId, NXCPMessage *msg)
             txnOpen = true;
          }
          item->deleteFromDatabase(hdb, &statements);
+         s_schedule.remove(item);
          it->unlink();
          item->decRefCount();
       }
@@ -1611,12 +2325,129 @@ void ConfigureDataCollection(uint64_t serverId, NXCPMessage *msg)
    nxlog_debug_tag(DEBUG_TAG, 4, _T("Data collection for server ") UINT64X_FMT(_T("016")) _T(" reconfigured"), serverId);
 }
 
+/**
+ * Move offline data from local database to offline data log (used when switching from database to log storage)
+ */
+static void MoveOfflineDataToLog(DB_HANDLE hdb)
+{
+   DB_UNBUFFERED_RESULT hResult = DBSelectUnbuffered(hdb, _T("SELECT server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value FROM dc_queue ORDER BY timestamp"));
+   if (hResult == NULL)
+      return;
+
+   int count = 0;
+   OfflineDataLog *log = nullptr;
+   UINT64 logServerId = 0;
+   while(DBFetch(hResult))
+   {
+      DataElement e(hResult);
+      if ((log == nullptr) || (logServerId != e.getServerId()))
+      {
+         if (log != nullptr)
+            log->decRefCount();
+         log = GetOfflineDataLog(e.getServerId(), true);
+         logServerId = e.getServerId();
+      }
+      if (log != nullptr)
+         AppendToOfflineDataLog(log, &e);
+      count++;
+   }
+   DBFreeResult(hResult);
+   if (log != nullptr)
+      log->decRefCount();
+
+   if (count > 0)
+   {
+      s_offlineDataLogLock.lock();
+      s_offlineDataLogs.forEach(FlushOfflineDataLog);
+      s_offlineDataLogLock.unlock();
+
+      DBQuery(hdb, _T("DELETE FROM dc_queue"));
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("%d offline data records moved from local database to offline data log"), count);
+   }
+}
+
+/**
+ * Move offline data from offline data log to local database (used when switching from log to database storage)
+ */
+static void MoveOfflineDataFromLog(DB_HANDLE hdb)
+{
+   IntegerArray<UINT64> servers;
+   GetOfflineDataLogServers(&servers);
+   for(int i = 0; i < servers.size(); i++)
+   {
+      UINT64 serverId = servers.get(i);
+      OfflineDataLog *log = GetOfflineDataLog(serverId, true);
+      if (log == nullptr)
+         continue;
+
+      DB_STATEMENT hStmt = DBPrepare(hdb, _T("INSERT INTO dc_queue (server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value) VALUES (?,?,?,?,?,?,?,?)"), true);
+      if (hStmt != NULL)
+      {
+         int count = 0;
+         ObjectArray<ByteStream> records(1024, 1024, Ownership::True);
+         while(log->read(&records, 1024) > 0)
+         {
+            DBBegin(hdb);
+            for(int j = 0; j < records.size(); j++)
+            {
+               ByteStream *record = records.get(j);
+               if (record->size() > 0)
+               {
+                  DataElement e(serverId, record);
+                  e.saveToDatabase(hStmt);
+                  count++;
+               }
+            }
+            DBCommit(hdb);
+            log->commit(records.size());
+            records.clear();
+         }
+         DBFreeStatement(hStmt);
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("%d offline data records for server ID ") UINT64X_FMT(_T("016")) _T(" moved from offline data log to local database"), count, serverId);
+      }
+      log->decRefCount();
+
+      if (hStmt != NULL)
+         DeleteOfflineDataLog(serverId);
+   }
+}
+
+/**
+ * Load offline data logs and create sync status objects for servers with unsent data
+ */
+static void LoadOfflineDataLogs()
+{
+   IntegerArray<UINT64> servers;
+   GetOfflineDataLogServers(&servers);
+   for(int i = 0; i < servers.size(); i++)
+   {
+      UINT64 serverId = servers.get(i);
+      OfflineDataLog *log = GetOfflineDataLog(serverId, true);
+      if (log == nullptr)
+         continue;
+
+      if (log->getRecordCount() > 0)
+      {
+         ServerSyncStatus *s = new ServerSyncStatus(serverId);
+         s->queueSize = log->getRecordCount();
+         s->lastSync = log->getOldestTimestamp();
+         s_serverSyncStatus.set(serverId, s);
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("%d elements in queue for server ID ") UINT64X_FMT(_T("016")), s->queueSize, serverId);
+
+         TCHAR ts[64];
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("Oldest timestamp is %s for server ID ") UINT64X_FMT(_T("016")), FormatTimestamp(s->lastSync, ts), serverId);
+      }
+      log->decRefCount();
+   }
+}
+
 /**
  * Load saved state of local data collection
  */
 static void LoadState()
 {
    DB_HANDLE hdb = GetLocalDatabaseHandle();
+   time_t now = time(nullptr);
    DB_RESULT hResult = DBSelect(hdb, _T("SELECT server_id,dci_id,type,origin,name,polling_interval,last_poll,snmp_port,snmp_target_guid,snmp_raw_type,backup_proxy_id,snmp_version,schedule_type FROM dc_config"));
    if (hResult != NULL)
    {
@@ -1625,6 +2456,7 @@ static void LoadState()
       {
          DataCollectionItem *dci = new DataCollectionItem(hResult, i);
          s_items.set(dci->getKey(), dci);
+         s_schedule.add(dci, now);
       }
       DBFreeResult(hResult);
    }
@@ -1640,6 +2472,16 @@ static void LoadState()
       DBFreeResult(hResult);
    }
 
+   if (s_useOfflineDataLog)
+   {
+      MoveOfflineDataToLog(hdb);
+      LoadOfflineDataLogs();
+      LoadProxyConfiguration();
+      return;
+   }
+
+   MoveOfflineDataFromLog(hdb);
+
    hResult = DBSelect(hdb, _T("SELECT server_id,count(*),coalesce(min(timestamp),0) FROM dc_queue GROUP BY server_id"));
    if (hResult != NULL)
    {
@@ -1710,6 +2552,9 @@ static void ClearStalledOfflineData(void *arg)
 
          DBCommit(hdb);
 
+         if (s_useOfflineDataLog)
+            DeleteOfflineDataLog(serverId);
+
          s_itemLock.lock();
          Iterator<DataCollectionItem> *it = s_items.iterator();
          while(it->hasNext())
@@ -1717,6 +2562,7 @@ static void ClearStalledOfflineData(void *arg)
             DataCollectionItem *item = it->next();
             if (item->getServerId() == serverId)
             {
+               s_schedule.remove(item);
                it->unlink();
                item->decRefCount();
             }
@@ -1763,6 +2609,28 @@ void StartLocalDataCollector()
       g_dcReconciliationBlockSize = MAX_BULK_DATA_BLOCK_SIZE;
    }
 
+   if (g_dcSenderBatchSize < 1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender batch size %d, resetting to 1"), g_dcSenderBatchSize);
+      g_dcSenderBatchSize = 1;
+   }
+   else if (g_dcSenderBatchSize > MAX_BULK_DATA_BLOCK_SIZE)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender batch size %d, resetting to %d"), g_dcSenderBatchSize, MAX_BULK_DATA_BLOCK_SIZE);
+      g_dcSenderBatchSize = MAX_BULK_DATA_BLOCK_SIZE;
+   }
+
+   if (g_dcSenderWindowSize < 1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender window size %d, resetting to 1"), g_dcSenderWindowSize);
+      g_dcSenderWindowSize = 1;
+   }
+   else if (g_dcSenderWindowSize > 64)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data sender window size %d, resetting to 64"), g_dcSenderWindowSize);
+      g_dcSenderWindowSize = 64;
+   }
+
    if (g_dcReconciliationTimeout < 1000)
    {
       nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid data reconciliation timeout %d, resetting to 1000"), g_dcReconciliationTimeout);
@@ -1774,12 +2642,38 @@ void StartLocalDataCollector()
       g_dcReconciliationTimeout = 900000;
    }
 
+   if (!_tcsicmp(g_dcOfflineDataStorage, _T("log")))
+   {
+#if defined(_WIN32) || HAVE_MMAP
+      s_useOfflineDataLog = true;
+#else
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Offline data log is not supported on this platform, local database will be used for offline data"));
+#endif
+   }
+   else if (_tcsicmp(g_dcOfflineDataStorage, _T("database")))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid offline data storage type \"%s\", local database will be used for offline data"), g_dcOfflineDataStorage);
+   }
+
+   if (g_dcOfflineDataSegmentSize < 1048576)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid offline data log segment size ") UINT64_FMT _T(", resetting to 1048576"), g_dcOfflineDataSegmentSize);
+      g_dcOfflineDataSegmentSize = 1048576;
+   }
+   else if (g_dcOfflineDataSegmentSize > 1073741824)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("Invalid offline data log segment size ") UINT64_FMT _T(", resetting to 1073741824"), g_dcOfflineDataSegmentSize);
+      g_dcOfflineDataSegmentSize = 1073741824;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("Offline data storage: %s"), s_useOfflineDataLog ? _T("log") : _T("database"));
+
    LoadState();
 
    g_dataCollectorPool = ThreadPoolCreate(_T("DATACOLL"), 1, g_dcMaxCollectorPoolSize);
    s_dataCollectionSchedulerThread = ThreadCreateEx(DataCollectionScheduler, 0, NULL);
    s_dataSenderThread = ThreadCreateEx(DataSender, 0, NULL);
-   s_databaseWriterThread = ThreadCreateEx(DatabaseWriter, 0, NULL);
+   s_databaseWriterThread = ThreadCreateEx(s_useOfflineDataLog ? OfflineDataLogWriter : DatabaseWriter, 0, NULL);
    s_reconciliationThread = ThreadCreateEx(ReconciliationThread, 0, NULL);
    s_proxyListennerThread = ThreadCreateEx(ProxyListenerThread, 0 ,NULL);
    ThreadPoolScheduleRelative(g_dataCollectorPool, STALLED_DATA_CHECK_INTERVAL, ClearStalledOfflineData, NULL);
@@ -1820,6 +2714,11 @@ void ShutdownLocalDataCollector()
 
    nxlog_debug_tag(DEBUG_TAG, 5, _T("Waiting for proxy heartbeat listening thread"));
    ThreadJoin(s_proxyListennerThread);
+
+   s_offlineDataLogLock.lock();
+   s_offlineDataLogs.forEach(ReleaseOfflineDataLog);
+   s_offlineDataLogs.clear();
+   s_offlineDataLogLock.unlock();
 }
 
 /**
@@ -1834,12 +2733,18 @@ void ClearDataCollectionConfiguration()
    DBQuery(db, _T("DELETE FROM dc_queue"));
    DBQuery(db, _T("DELETE FROM dc_config"));
    DBQuery(db, _T("DELETE FROM dc_snmp_targets"));
+   s_schedule.clear();
    s_items.clear();
    s_itemLock.unlock();
 
    s_serverSyncStatusLock.lock();
    s_serverSyncStatus.clear();
    s_serverSyncStatusLock.unlock();
+
+   IntegerArray<UINT64> servers;
+   GetOfflineDataLogServers(&servers);
+   for(int i = 0; i < servers.size(); i++)
+      DeleteOfflineDataLog(servers.get(i));
 }
 
 /**
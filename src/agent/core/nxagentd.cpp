@@ -197,10 +197,14 @@ UINT32 g_maxCommSessions = 0;
 UINT32 g_longRunningQueryThreshold = 250;
 UINT32 g_dcReconciliationBlockSize = 1024;
 UINT32 g_dcReconciliationTimeout = 60000;
+UINT32 g_dcSenderBatchSize = 256;
+UINT32 g_dcSenderWindowSize = 4;
 UINT32 g_dcWriterFlushInterval = 5000;
 UINT32 g_dcWriterMaxTransactionSize = 10000;
 UINT32 g_dcMaxCollectorPoolSize = 64;
 UINT32 g_dcOfflineExpirationTime = 10; // 10 days
+TCHAR g_dcOfflineDataStorage[16] = _T("database");
+UINT64 g_dcOfflineDataSegmentSize = 16 * 1024 * 1024;
 int32_t g_zoneUIN = 0;
 uint32_t g_tunnelKeepaliveInterval = 30;
 uint16_t g_syslogListenPort = 514;
@@ -272,6 +276,8 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("DataCollectionThreadPoolSize"), CT_LONG, 0, 0, 0, 0, &g_dcMaxCollectorPoolSize, nullptr },
    { _T("DataReconciliationBlockSize"), CT_LONG, 0, 0, 0, 0, &g_dcReconciliationBlockSize, nullptr },
    { _T("DataReconciliationTimeout"), CT_LONG, 0, 0, 0, 0, &g_dcReconciliationTimeout, nullptr },
+   { _T("DataSenderBatchSize"), CT_LONG, 0, 0, 0, 0, &g_dcSenderBatchSize, nullptr },
+   { _T("DataSenderWindowSize"), CT_LONG, 0, 0, 0, 0, &g_dcSenderWindowSize, nullptr },
    { _T("DataWriterFlushInterval"), CT_LONG, 0, 0, 0, 0, &g_dcWriterFlushInterval, nullptr },
    { _T("DataWriterMaxTransactionSize"), CT_LONG, 0, 0, 0, 0, &g_dcWriterMaxTransactionSize, nullptr },
    { _T("DailyLogFileSuffix"), CT_STRING, 0, 0, 64, 0, s_dailyLogFileSuffix, nullptr },
@@ -314,7 +320,10 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("MasterServers"), CT_STRING_LIST, ',', 0, 0, 0, &m_pszMasterServerList, nullptr },
    { _T("MaxLogSize"), CT_SIZE_BYTES, 0, 0, 0, 0, &s_maxLogSize, nullptr },
    { _T("MaxSessions"), CT_LONG, 0, 0, 0, 0, &g_maxCommSessions, nullptr },
+   { _T("OfflineDataCompression"), CT_BOOLEAN, 0, 0, AF_COMPRESS_OFFLINE_DATA, 0, &g_dwFlags, nullptr },
    { _T("OfflineDataExpirationTime"), CT_LONG, 0, 0, 0, 0, &g_dcOfflineExpirationTime, nullptr },
+   { _T("OfflineDataSegmentSize"), CT_SIZE_BYTES, 0, 0, 0, 0, &g_dcOfflineDataSegmentSize, nullptr },
+   { _T("OfflineDataStorage"), CT_STRING, 0, 0, 16, 0, g_dcOfflineDataStorage, nullptr },
    { _T("PlatformSuffix"), CT_STRING, 0, 0, MAX_PSUFFIX_LENGTH, 0, g_szPlatformSuffix, nullptr },
    { _T("RequireAuthentication"), CT_BOOLEAN, 0, 0, AF_REQUIRE_AUTH, 0, &g_dwFlags, nullptr },
    { _T("RequireEncryption"), CT_BOOLEAN, 0, 0, AF_REQUIRE_ENCRYPTION, 0, &g_dwFlags, nullptr },
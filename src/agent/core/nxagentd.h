@@ -107,6 +107,7 @@
 #define AF_JSON_LOG                 0x10000000
 #define AF_LOG_TO_STDOUT            0x20000000
 #define AF_ENABLE_SSL_TRACE         0x40000000
+#define AF_COMPRESS_OFFLINE_DATA    0x80000000
 
 // Flags for component failures
 #define FAIL_OPEN_LOG               0x00000001
@@ -315,6 +316,7 @@ class CommSession : public AbstractCommSession
    bool m_acceptFileUpdates;
    bool m_ipv6Aware;
    bool m_bulkReconciliationSupported;
+   bool m_bulkDataPushSupported;
    HashMap<uint32_t, DownloadFileInfo> m_downloadFileMap;
    bool m_allowCompression;   // allow compression for structured messages
 	NXCPEncryptionContext *m_pCtx;
@@ -385,6 +387,7 @@ class CommSession : public AbstractCommSession
    virtual bool canAcceptFileUpdates() override { return m_acceptFileUpdates; }
    virtual bool isBulkReconciliationSupported() override { return m_bulkReconciliationSupported; }
    virtual bool isIPv6Aware() override { return m_ipv6Aware; }
+   bool isBulkDataPushSupported() const { return m_bulkDataPushSupported; }
 
    virtual UINT32 openFile(TCHAR *nameOfFile, UINT32 requestId, time_t fileModTime = 0) override;
 
@@ -706,6 +709,67 @@ class SNMPTableColumnDefinition
    bool isConvertSnmpStringToHex() const { return (m_flags & TCF_SNMP_HEX_STRING) != 0; }
 };
 
+/**
+ * Memory mapped offline data log segment
+ */
+struct OfflineDataLogSegment;
+
+/**
+ * Record position in offline data log
+ */
+struct OfflineDataLogPosition
+{
+   uint64_t segment;
+   size_t offset;
+};
+
+/**
+ * Append-only offline data log. Records are stored sequentially in memory mapped segment files;
+ * consumed records are tracked by checkpointed read cursor and segments are deleted as a whole
+ * once read cursor moves past them.
+ */
+class OfflineDataLog : public RefCountObject
+{
+private:
+   TCHAR m_path[MAX_PATH];
+   size_t m_segmentSize;
+   bool m_compress;
+   Mutex m_mutex;
+   IntegerArray<uint64_t> m_segments;
+   OfflineDataLogSegment *m_writer;
+   OfflineDataLogSegment *m_reader;
+   StreamCompressor *m_encoder;
+   StreamCompressor *m_decoder;
+   OfflineDataLogPosition m_cursor;
+   OfflineDataLogPosition m_readPosition;
+   StructArray<OfflineDataLogPosition> m_pendingPositions;
+   int32_t m_recordCount;
+   time_t m_oldestTimestamp;
+   bool m_destroyed;
+
+   void getSegmentFileName(uint64_t id, TCHAR *fileName);
+   void releaseSegment(OfflineDataLogSegment *segment);
+   bool openReader();
+   bool createWriter(size_t minSize);
+   void saveCursor();
+   void deleteConsumedSegments();
+
+public:
+   OfflineDataLog(const TCHAR *path, size_t segmentSize, bool compress);
+   virtual ~OfflineDataLog();
+
+   bool open();
+   void destroy();
+
+   bool append(const BYTE *data, size_t size, time_t timestamp);
+   void flush();
+   int read(ObjectArray<ByteStream> *records, int maxRecords);
+   void commit(int count);
+
+   int32_t getRecordCount() const { return m_recordCount; }
+   time_t getOldestTimestamp() const { return m_oldestTimestamp; }
+};
+
 /**
  * Functions
  */
@@ -0,0 +1,770 @@
+/*
+** NetXMS multiplatform core agent
+** Copyright (C) 2003-2020 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: offlinelog.cpp
+**
+**/
+
+#include "nxagentd.h"
+
+#if !defined(_WIN32) && HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+#define DEBUG_TAG _T("dc.offline")
+
+/**
+ * Segment file signature and version
+ */
+#define SEGMENT_SIGNATURE  0x514F584E
+#define SEGMENT_VERSION    1
+
+/**
+ * Segment flags
+ */
+#define SEGMENT_FLAG_COMPRESSED  0x0001
+
+/**
+ * Record flags
+ */
+#define RECORD_FLAG_COMPRESSED   0x0001
+#define RECORD_FLAG_STREAM_RESET 0x0002   /* compression stream was restarted at this record */
+
+/**
+ * Cursor file signature
+ */
+#define CURSOR_SIGNATURE   0x52534355
+
+/**
+ * Maximum size of record that can be compressed (bigger records are stored as is)
+ */
+#define MAX_COMPRESSED_RECORD_SIZE  65536
+
+/**
+ * Segment file header
+ */
+struct SegmentHeader
+{
+   uint32_t signature;
+   uint16_t version;
+   uint16_t flags;
+   uint64_t id;
+   BYTE reserved[16];
+};
+
+/**
+ * Record header. CRC covers all header fields after it and record payload.
+ */
+struct RecordHeader
+{
+   uint32_t size;
+   uint32_t crc;
+   int64_t timestamp;
+   uint32_t rawSize;
+   uint32_t flags;
+};
+
+/**
+ * Read cursor checkpoint
+ */
+struct CursorCheckpoint
+{
+   uint32_t signature;
+   uint32_t crc;
+   uint64_t segment;
+   uint64_t offset;
+};
+
+/**
+ * Memory mapped segment
+ */
+struct OfflineDataLogSegment
+{
+   uint64_t id;
+   BYTE *data;
+   size_t size;
+   size_t writePos;
+   bool compressed;
+#ifdef _WIN32
+   HANDLE hFile;
+   HANDLE hMapping;
+#else
+   int fd;
+#endif
+};
+
+/**
+ * Map segment file into memory. If createSize is non-zero new file of given size will be created.
+ */
+static OfflineDataLogSegment *MapSegment(const TCHAR *fileName, uint64_t id, size_t createSize)
+{
+#if defined(_WIN32)
+   HANDLE hFile = CreateFile(fileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+            (createSize > 0) ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (hFile == INVALID_HANDLE_VALUE)
+      return nullptr;
+
+   size_t size;
+   if (createSize > 0)
+   {
+      size = createSize;
+   }
+   else
+   {
+      LARGE_INTEGER fsize;
+      if (!GetFileSizeEx(hFile, &fsize))
+      {
+         CloseHandle(hFile);
+         return nullptr;
+      }
+      size = static_cast<size_t>(fsize.QuadPart);
+   }
+   if (size < sizeof(SegmentHeader))
+   {
+      CloseHandle(hFile);
+      return nullptr;
+   }
+
+   HANDLE hMapping = CreateFileMapping(hFile, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+   if (hMapping == nullptr)
+   {
+      CloseHandle(hFile);
+      return nullptr;
+   }
+
+   BYTE *data = static_cast<BYTE*>(MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+   if (data == nullptr)
+   {
+      CloseHandle(hMapping);
+      CloseHandle(hFile);
+      return nullptr;
+   }
+
+   OfflineDataLogSegment *segment = new OfflineDataLogSegment;
+   segment->hFile = hFile;
+   segment->hMapping = hMapping;
+#elif HAVE_MMAP
+   int fd = _topen(fileName, (createSize > 0) ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, S_IRUSR | S_IWUSR);
+   if (fd == -1)
+      return nullptr;
+
+   size_t size;
+   if (createSize > 0)
+   {
+      if (ftruncate(fd, createSize) != 0)
+      {
+         _close(fd);
+         return nullptr;
+      }
+      size = createSize;
+   }
+   else
+   {
+      struct stat st;
+      if (fstat(fd, &st) != 0)
+      {
+         _close(fd);
+         return nullptr;
+      }
+      size = static_cast<size_t>(st.st_size);
+   }
+   if (size < sizeof(SegmentHeader))
+   {
+      _close(fd);
+      return nullptr;
+   }
+
+   void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (data == MAP_FAILED)
+   {
+      _close(fd);
+      return nullptr;
+   }
+
+   OfflineDataLogSegment *segment = new OfflineDataLogSegment;
+   segment->fd = fd;
+#else
+   return nullptr;
+#endif
+
+   segment->id = id;
+   segment->data = static_cast<BYTE*>(data);
+   segment->size = size;
+   segment->writePos = 0;
+   segment->compressed = false;
+   return segment;
+}
+
+/**
+ * Schedule write of segment's dirty pages to disk
+ */
+static void FlushSegment(OfflineDataLogSegment *segment)
+{
+#if defined(_WIN32)
+   FlushViewOfFile(segment->data, segment->writePos);
+#elif HAVE_MMAP
+   msync(segment->data, segment->size, MS_ASYNC);
+#endif
+}
+
+/**
+ * Unmap segment and close underlying file
+ */
+static void UnmapSegment(OfflineDataLogSegment *segment)
+{
+#if defined(_WIN32)
+   UnmapViewOfFile(segment->data);
+   CloseHandle(segment->hMapping);
+   CloseHandle(segment->hFile);
+#elif HAVE_MMAP
+   munmap(segment->data, segment->size);
+   _close(segment->fd);
+#endif
+   delete segment;
+}
+
+/**
+ * Calculate record CRC
+ */
+static inline uint32_t RecordCRC(const RecordHeader *header, const BYTE *payload)
+{
+   return CalculateCRC32(payload, header->size, CalculateCRC32(reinterpret_cast<const BYTE*>(&header->timestamp), sizeof(RecordHeader) - 8, 0));
+}
+
+/**
+ * Read and validate record header at given offset. Returns false if there is no valid record at that offset.
+ */
+static bool ReadRecordHeader(OfflineDataLogSegment *segment, size_t offset, RecordHeader *header)
+{
+   if (offset + sizeof(RecordHeader) > segment->size)
+      return false;
+   memcpy(header, segment->data + offset, sizeof(RecordHeader));
+   if ((header->size == 0) || (header->size > segment->size - offset - sizeof(RecordHeader)))
+      return false;
+   return RecordCRC(header, segment->data + offset + sizeof(RecordHeader)) == header->crc;
+}
+
+/**
+ * Compare segment IDs
+ */
+static int CompareSegmentId(const void *e1, const void *e2)
+{
+   uint64_t id1 = *static_cast<const uint64_t*>(e1);
+   uint64_t id2 = *static_cast<const uint64_t*>(e2);
+   return (id1 < id2) ? -1 : ((id1 > id2) ? 1 : 0);
+}
+
+/**
+ * Offline data log constructor
+ */
+OfflineDataLog::OfflineDataLog(const TCHAR *path, size_t segmentSize, bool compress) : m_segments(64, 64), m_pendingPositions(0, 256)
+{
+   _tcslcpy(m_path, path, MAX_PATH);
+   m_segmentSize = segmentSize;
+   m_compress = compress;
+   m_writer = nullptr;
+   m_reader = nullptr;
+   m_encoder = nullptr;
+   m_decoder = nullptr;
+   m_cursor.segment = 0;
+   m_cursor.offset = sizeof(SegmentHeader);
+   m_readPosition = m_cursor;
+   m_recordCount = 0;
+   m_oldestTimestamp = 0;
+   m_destroyed = false;
+}
+
+/**
+ * Offline data log destructor
+ */
+OfflineDataLog::~OfflineDataLog()
+{
+   if (m_reader != nullptr)
+   {
+      if (m_reader != m_writer)
+         UnmapSegment(m_reader);
+   }
+   if (m_writer != nullptr)
+   {
+      FlushSegment(m_writer);
+      UnmapSegment(m_writer);
+   }
+   delete m_encoder;
+   delete m_decoder;
+}
+
+/**
+ * Build segment file name
+ */
+void OfflineDataLog::getSegmentFileName(uint64_t id, TCHAR *fileName)
+{
+   _sntprintf(fileName, MAX_PATH, _T("%s") FS_PATH_SEPARATOR UINT64X_FMT(_T("016")) _T(".seg"), m_path, id);
+}
+
+/**
+ * Unmap segment if it is not used by either reader or writer
+ */
+void OfflineDataLog::releaseSegment(OfflineDataLogSegment *segment)
+{
+   if ((segment != nullptr) && (segment != m_writer) && (segment != m_reader))
+      UnmapSegment(segment);
+}
+
+/**
+ * Open existing log. Loads read cursor and counts records not yet consumed.
+ */
+bool OfflineDataLog::open()
+{
+   if ((_taccess(m_path, 0) != 0) && !CreateFolder(m_path))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("Cannot create offline data log directory %s"), m_path);
+      return false;
+   }
+
+   _TDIR *dir = _topendir(m_path);
+   if (dir == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("Cannot open offline data log directory %s"), m_path);
+      return false;
+   }
+   struct _tdirent *d;
+   while((d = _treaddir(dir)) != nullptr)
+   {
+      if (_tcslen(d->d_name) != 20)
+         continue;
+      TCHAR *eptr;
+      uint64_t id = _tcstoull(d->d_name, &eptr, 16);
+      if (!_tcscmp(eptr, _T(".seg")))
+         m_segments.add(id);
+   }
+   _tclosedir(dir);
+   m_segments.sort(CompareSegmentId);
+
+   TCHAR fileName[MAX_PATH];
+   _sntprintf(fileName, MAX_PATH, _T("%s") FS_PATH_SEPARATOR _T("cursor"), m_path);
+   int fd = _topen(fileName, O_RDONLY | O_BINARY);
+   if (fd != -1)
+   {
+      CursorCheckpoint checkpoint;
+      if ((_read(fd, &checkpoint, sizeof(checkpoint)) == sizeof(checkpoint)) && (checkpoint.signature == CURSOR_SIGNATURE) &&
+          (checkpoint.crc == CalculateCRC32(reinterpret_cast<BYTE*>(&checkpoint.segment), 16, 0)))
+      {
+         m_cursor.segment = checkpoint.segment;
+         m_cursor.offset = static_cast<size_t>(checkpoint.offset);
+      }
+      else
+      {
+         nxlog_debug_tag(DEBUG_TAG, 3, _T("Invalid read cursor checkpoint in %s"), m_path);
+      }
+      _close(fd);
+   }
+
+   // Segments before read cursor could be left from previous run if agent was stopped before cleanup
+   deleteConsumedSegments();
+   if (!m_segments.isEmpty() && (m_segments.get(0) > m_cursor.segment))
+   {
+      m_cursor.segment = m_segments.get(0);
+      m_cursor.offset = sizeof(SegmentHeader);
+   }
+   m_readPosition = m_cursor;
+
+   for(int i = 0; i < m_segments.size(); i++)
+   {
+      uint64_t id = m_segments.get(i);
+      getSegmentFileName(id, fileName);
+      OfflineDataLogSegment *segment = MapSegment(fileName, id, 0);
+      if ((segment == nullptr) || (reinterpret_cast<SegmentHeader*>(segment->data)->signature != SEGMENT_SIGNATURE))
+      {
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("Offline data log segment %s is not valid and will be deleted"), fileName);
+         if (segment != nullptr)
+            UnmapSegment(segment);
+         _tremove(fileName);
+         m_segments.remove(i);
+         i--;
+         continue;
+      }
+
+      size_t offset = (id == m_cursor.segment) ? m_cursor.offset : sizeof(SegmentHeader);
+      RecordHeader header;
+      while(ReadRecordHeader(segment, offset, &header))
+      {
+         if (m_recordCount == 0)
+            m_oldestTimestamp = static_cast<time_t>(header.timestamp);
+         m_recordCount++;
+         offset += sizeof(RecordHeader) + header.size;
+      }
+      UnmapSegment(segment);
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("Offline data log %s opened (%d segments, %d records)"), m_path, m_segments.size(), m_recordCount);
+   return true;
+}
+
+/**
+ * Delete log files. Log object cannot be used after this call.
+ */
+void OfflineDataLog::destroy()
+{
+   m_mutex.lock();
+   m_destroyed = true;
+
+   OfflineDataLogSegment *reader = m_reader, *writer = m_writer;
+   m_reader = nullptr;
+   m_writer = nullptr;
+   if (reader != writer)
+      releaseSegment(reader);
+   releaseSegment(writer);
+
+   TCHAR fileName[MAX_PATH];
+   for(int i = 0; i < m_segments.size(); i++)
+   {
+      getSegmentFileName(m_segments.get(i), fileName);
+      _tremove(fileName);
+   }
+   m_segments.clear();
+   _sntprintf(fileName, MAX_PATH, _T("%s") FS_PATH_SEPARATOR _T("cursor"), m_path);
+   _tremove(fileName);
+   _trmdir(m_path);
+
+   m_pendingPositions.clear();
+   m_recordCount = 0;
+   m_mutex.unlock();
+}
+
+/**
+ * Create new segment for writing
+ */
+bool OfflineDataLog::createWriter(size_t minSize)
+{
+   uint64_t id = m_segments.isEmpty() ? m_cursor.segment : std::max(m_segments.get(m_segments.size() - 1), m_cursor.segment);
+   id++;
+
+   TCHAR fileName[MAX_PATH];
+   getSegmentFileName(id, fileName);
+   OfflineDataLogSegment *segment = MapSegment(fileName, id, std::max(m_segmentSize, minSize));
+   if (segment == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("Cannot create offline data log segment %s"), fileName);
+      return false;
+   }
+
+   SegmentHeader *header = reinterpret_cast<SegmentHeader*>(segment->data);
+   header->signature = SEGMENT_SIGNATURE;
+   header->version = SEGMENT_VERSION;
+   header->flags = m_compress ? SEGMENT_FLAG_COMPRESSED : 0;
+   header->id = id;
+   segment->compressed = m_compress;
+   segment->writePos = sizeof(SegmentHeader);
+
+   OfflineDataLogSegment *prev = m_writer;
+   m_writer = segment;
+   if (prev != nullptr)
+   {
+      FlushSegment(prev);
+      releaseSegment(prev);
+   }
+   m_segments.add(id);
+
+   // Compression state is per segment so each segment can be decoded independently
+   delete m_encoder;
+   m_encoder = m_compress ? StreamCompressor::create(NXCP_STREAM_COMPRESSION_LZ4, true, MAX_COMPRESSED_RECORD_SIZE) : nullptr;
+
+   nxlog_debug_tag(DEBUG_TAG, 6, _T("New offline data log segment %s created"), fileName);
+   return true;
+}
+
+/**
+ * Append record to the log. Empty records are not allowed (zero size marks end of data in segment).
+ */
+bool OfflineDataLog::append(const BYTE *data, size_t size, time_t timestamp)
+{
+   if (size == 0)
+      return false;
+
+   m_mutex.lock();
+   if (m_destroyed || ((m_writer == nullptr) && !createWriter(0)))
+   {
+      m_mutex.unlock();
+      return false;
+   }
+
+   bool compress = m_writer->compressed && (size <= MAX_COMPRESSED_RECORD_SIZE);
+   size_t required = sizeof(RecordHeader) + (compress ? m_encoder->compressBufferSize(size) : size);
+   if (m_writer->writePos + required > m_writer->size)
+   {
+      if (!createWriter(sizeof(SegmentHeader) + required))
+      {
+         m_mutex.unlock();
+         return false;
+      }
+      compress = m_writer->compressed && (size <= MAX_COMPRESSED_RECORD_SIZE);
+   }
+
+   RecordHeader header;
+   header.timestamp = static_cast<int64_t>(timestamp);
+   header.rawSize = static_cast<uint32_t>(size);
+   header.flags = 0;
+   header.size = 0;
+
+   BYTE *payload = m_writer->data + m_writer->writePos + sizeof(RecordHeader);
+   if (compress)
+   {
+      // Output space is not less than compressBufferSize(size), so compression should not fail
+      header.size = static_cast<uint32_t>(m_encoder->compress(data, size, payload, m_writer->size - m_writer->writePos - sizeof(RecordHeader)));
+      if (header.size > 0)
+      {
+         header.flags |= RECORD_FLAG_COMPRESSED;
+      }
+      else
+      {
+         // Encoder state is undefined after failure, so restart compression stream. Record is
+         // stored uncompressed and marked so that reader will restart decoder at the same point.
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("Record compression failed, restarting compression stream"));
+         delete m_encoder;
+         m_encoder = StreamCompressor::create(NXCP_STREAM_COMPRESSION_LZ4, true, MAX_COMPRESSED_RECORD_SIZE);
+         header.flags |= RECORD_FLAG_STREAM_RESET;
+      }
+   }
+   if (header.size == 0)
+   {
+      memcpy(payload, data, size);
+      header.size = static_cast<uint32_t>(size);
+   }
+   header.crc = RecordCRC(&header, payload);
+   memcpy(m_writer->data + m_writer->writePos, &header, sizeof(RecordHeader));
+   m_writer->writePos += sizeof(RecordHeader) + header.size;
+
+   if (m_recordCount == 0)
+      m_oldestTimestamp = timestamp;
+   m_recordCount++;
+   m_mutex.unlock();
+   return true;
+}
+
+/**
+ * Schedule write of appended records to disk
+ */
+void OfflineDataLog::flush()
+{
+   m_mutex.lock();
+   if (m_writer != nullptr)
+      FlushSegment(m_writer);
+   m_mutex.unlock();
+}
+
+/**
+ * Open segment at current read position. For compressed segments decoder state is restored
+ * by decoding all records from segment start up to read position.
+ */
+bool OfflineDataLog::openReader()
+{
+   int i;
+   for(i = 0; i < m_segments.size(); i++)
+      if (m_segments.get(i) >= m_readPosition.segment)
+         break;
+   if (i == m_segments.size())
+      return false;
+
+   uint64_t id = m_segments.get(i);
+   if (id != m_readPosition.segment)
+   {
+      m_readPosition.segment = id;
+      m_readPosition.offset = sizeof(SegmentHeader);
+   }
+
+   if ((m_writer != nullptr) && (m_writer->id == id))
+   {
+      m_reader = m_writer;
+   }
+   else
+   {
+      TCHAR fileName[MAX_PATH];
+      getSegmentFileName(id, fileName);
+      m_reader = MapSegment(fileName, id, 0);
+      if (m_reader == nullptr)
+      {
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("Cannot open offline data log segment %s"), fileName);
+         return false;
+      }
+      m_reader->compressed = (reinterpret_cast<SegmentHeader*>(m_reader->data)->flags & SEGMENT_FLAG_COMPRESSED) != 0;
+   }
+
+   delete_and_null(m_decoder);
+   if (m_reader->compressed)
+   {
+      m_decoder = StreamCompressor::create(NXCP_STREAM_COMPRESSION_LZ4, false, MAX_COMPRESSED_RECORD_SIZE);
+
+      size_t offset = sizeof(SegmentHeader);
+      RecordHeader header;
+      while((offset < m_readPosition.offset) && ReadRecordHeader(m_reader, offset, &header))
+      {
+         if (header.flags & RECORD_FLAG_STREAM_RESET)
+         {
+            delete m_decoder;
+            m_decoder = StreamCompressor::create(NXCP_STREAM_COMPRESSION_LZ4, false, MAX_COMPRESSED_RECORD_SIZE);
+         }
+         if (header.flags & RECORD_FLAG_COMPRESSED)
+         {
+            const BYTE *out;
+            m_decoder->decompress(m_reader->data + offset + sizeof(RecordHeader), header.size, &out);
+         }
+         offset += sizeof(RecordHeader) + header.size;
+      }
+   }
+   return true;
+}
+
+/**
+ * Read up to maxRecords records starting at current read position. Records should be confirmed
+ * by call to commit() before next read. Records that cannot be decoded are returned as empty streams.
+ */
+int OfflineDataLog::read(ObjectArray<ByteStream> *records, int maxRecords)
+{
+   m_mutex.lock();
+   m_pendingPositions.clear();
+
+   int count = 0;
+   while(!m_destroyed && (count < maxRecords))
+   {
+      if ((m_reader == nullptr) && !openReader())
+         break;
+
+      RecordHeader header;
+      if (!ReadRecordHeader(m_reader, m_readPosition.offset, &header))
+      {
+         if (m_reader == m_writer)
+            break;   // no more data
+
+         // End of segment reached, switch to next one
+         OfflineDataLogSegment *segment = m_reader;
+         m_reader = nullptr;
+         releaseSegment(segment);
+         m_readPosition.segment++;
+         m_readPosition.offset = sizeof(SegmentHeader);
+         continue;
+      }
+
+      if ((header.flags & RECORD_FLAG_STREAM_RESET) && m_reader->compressed)
+      {
+         delete m_decoder;
+         m_decoder = StreamCompressor::create(NXCP_STREAM_COMPRESSION_LZ4, false, MAX_COMPRESSED_RECORD_SIZE);
+      }
+
+      const BYTE *payload = m_reader->data + m_readPosition.offset + sizeof(RecordHeader);
+      ByteStream *record;
+      if (header.flags & RECORD_FLAG_COMPRESSED)
+      {
+         const BYTE *out;
+         size_t bytes = (m_decoder != nullptr) ? m_decoder->decompress(payload, header.size, &out) : 0;
+         if (bytes == header.rawSize)
+         {
+            record = new ByteStream(out, bytes);
+         }
+         else
+         {
+            nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot decompress record in segment ") UINT64X_FMT(_T("016")) _T(" at offset ") UINT64_FMT,
+                     m_readPosition.segment, static_cast<uint64_t>(m_readPosition.offset));
+            record = new ByteStream(0);
+         }
+      }
+      else
+      {
+         record = new ByteStream(payload, header.size);
+      }
+      records->add(record);
+
+      m_readPosition.offset += sizeof(RecordHeader) + header.size;
+      m_pendingPositions.add(&m_readPosition);
+      count++;
+   }
+
+   m_mutex.unlock();
+   return count;
+}
+
+/**
+ * Confirm processing of given number of leading records returned by last read() call.
+ * Remaining records will be returned again by next read() call.
+ */
+void OfflineDataLog::commit(int count)
+{
+   m_mutex.lock();
+   if (!m_destroyed)
+   {
+      if (count > m_pendingPositions.size())
+         count = m_pendingPositions.size();
+
+      if (count > 0)
+      {
+         m_cursor = *m_pendingPositions.get(count - 1);
+         m_recordCount -= count;
+         saveCursor();
+         deleteConsumedSegments();
+      }
+
+      if (count < m_pendingPositions.size())
+      {
+         // Rewind to read cursor
+         m_readPosition = m_cursor;
+         OfflineDataLogSegment *segment = m_reader;
+         m_reader = nullptr;
+         releaseSegment(segment);
+      }
+   }
+   m_pendingPositions.clear();
+   m_mutex.unlock();
+}
+
+/**
+ * Save read cursor checkpoint
+ */
+void OfflineDataLog::saveCursor()
+{
+   CursorCheckpoint checkpoint;
+   checkpoint.signature = CURSOR_SIGNATURE;
+   checkpoint.segment = m_cursor.segment;
+   checkpoint.offset = static_cast<uint64_t>(m_cursor.offset);
+   checkpoint.crc = CalculateCRC32(reinterpret_cast<BYTE*>(&checkpoint.segment), 16, 0);
+
+   TCHAR fileName[MAX_PATH];
+   _sntprintf(fileName, MAX_PATH, _T("%s") FS_PATH_SEPARATOR _T("cursor"), m_path);
+   int fd = _topen(fileName, O_WRONLY | O_CREAT | O_BINARY, S_IRUSR | S_IWUSR);
+   if (fd == -1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot save read cursor checkpoint in %s"), m_path);
+      return;
+   }
+   if (_write(fd, &checkpoint, sizeof(checkpoint)) != sizeof(checkpoint))
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot save read cursor checkpoint in %s"), m_path);
+   _close(fd);
+}
+
+/**
+ * Delete segments located before read cursor
+ */
+void OfflineDataLog::deleteConsumedSegments()
+{
+   TCHAR fileName[MAX_PATH];
+   while(!m_segments.isEmpty() && (m_segments.get(0) < m_cursor.segment))
+   {
+      getSegmentFileName(m_segments.get(0), fileName);
+      _tremove(fileName);
+      m_segments.remove(0);
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("Offline data log segment %s deleted"), fileName);
+   }
+}
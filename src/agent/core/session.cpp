@@ -142,6 +142,7 @@ CommSession::CommSession(AbstractCommChannel *channel, const InetAddress &server
    m_acceptFileUpdates = false;
    m_ipv6Aware = false;
    m_bulkReconciliationSupported = false;
+   m_bulkDataPushSupported = false;
    m_disconnected = false;
    m_allowCompression = false;
    m_pCtx = nullptr;
@@ -697,12 +698,14 @@ void CommSession::processingThread()
                // Servers before 2.0 use VID_ENABLED
                m_ipv6Aware = request->isFieldExist(VID_IPV6_SUPPORT) ? request->getFieldAsBoolean(VID_IPV6_SUPPORT) : request->getFieldAsBoolean(VID_ENABLED);
                m_bulkReconciliationSupported = request->getFieldAsBoolean(VID_BULK_RECONCILIATION);
+               m_bulkDataPushSupported = m_bulkReconciliationSupported && request->getFieldAsBoolean(VID_BULK_DATA_PUSH);
                m_allowCompression = request->getFieldAsBoolean(VID_ENABLE_COMPRESSION);
                response.setField(VID_RCC, ERR_SUCCESS);
                response.setField(VID_FLAGS, static_cast<UINT16>((m_controlServer ? 0x01 : 0x00) | (m_masterServer ? 0x02 : 0x00)));
-               debugPrintf(1, _T("Server capabilities: IPv6: %s; bulk reconciliation: %s; compression: %s"),
+               debugPrintf(1, _T("Server capabilities: IPv6: %s; bulk reconciliation: %s; bulk data push: %s; compression: %s"),
                            m_ipv6Aware ? _T("yes") : _T("no"),
                            m_bulkReconciliationSupported ? _T("yes") : _T("no"),
+                           m_bulkDataPushSupported ? _T("yes") : _T("no"),
                            m_allowCompression ? _T("yes") : _T("no"));
                break;
             case CMD_SET_SERVER_ID:
@@ -105,6 +105,7 @@ static bool SubAgentInit(Config *config)
 	StartCpuUsageCollector();
 	StartIoStatCollector();
 	InitDrbdCollector();
+   InitProcessSnapshot(config);
 	return true;
 }
 
@@ -116,6 +117,7 @@ static void SubAgentShutdown()
 	ShutdownCpuUsageCollector();
 	ShutdownIoStatCollector();
 	StopDrbdCollector();
+   ShutdownProcessSnapshot();
 }
 
 /**
@@ -271,6 +271,9 @@ void ShutdownCpuUsageCollector();
 void StartIoStatCollector();
 void ShutdownIoStatCollector();
 
+void InitProcessSnapshot(Config *config);
+void ShutdownProcessSnapshot();
+
 void InitDrbdCollector();
 void StopDrbdCollector();
 
@@ -19,6 +19,8 @@
 **/
 
 #include "linux_subagent.h"
+#include <netxms-regex.h>
+#include <sys/syscall.h>
 
 /**
  * Maximum possible length of process name
@@ -78,6 +80,10 @@ class Process
 	long rss;               // Process's resident set size in pages
 	unsigned long minflt;   // Number of minor page faults
 	unsigned long majflt;   // Number of major page faults
+	unsigned long long startTime; // Process start time in ticks since boot
+	uid_t uid;              // Owner's user ID (valid only if uidLoaded is true)
+	bool uidLoaded;
+	char *cmdLine;          // Command line (loaded on demand)
    ObjectArray<FileDescriptor> *fd;
    
    Process(UINT32 _pid, const char *_name)
@@ -94,11 +100,40 @@ class Process
       rss = 0;
       minflt = 0;
       majflt = 0;
+      startTime = 0;
+      uid = static_cast<uid_t>(-1);
+      uidLoaded = false;
+      cmdLine = NULL;
+      fd = NULL;
+   }
+
+   /**
+    * Create copy of snapshot entry (without command line and handles)
+    */
+   Process(const Process& src)
+   {
+      pid = src.pid;
+      memcpy(name, src.name, MAX_PROCESS_NAME_LEN);
+      parent = src.parent;
+      group = src.group;
+      state = src.state;
+      threads = src.threads;
+      ktime = src.ktime;
+      utime = src.utime;
+      vmsize = src.vmsize;
+      rss = src.rss;
+      minflt = src.minflt;
+      majflt = src.majflt;
+      startTime = src.startTime;
+      uid = src.uid;
+      uidLoaded = src.uidLoaded;
+      cmdLine = NULL;
       fd = NULL;
    }
    
    ~Process()
    {
+      MemFree(cmdLine);
       delete fd;
    }
 };
@@ -152,7 +187,355 @@ static ObjectArray<FileDescriptor> *ReadProcessHandles(UINT32 pid)
 }
 
 /**
- * Read process information from /proc system
+ * Minimal age of process (in seconds) after which its command line and owner are considered stable
+ * and can be carried over from one snapshot to another
+ */
+#define PROCESS_SETTLE_TIME   10
+
+/**
+ * Directory entry as returned by getdents64 system call
+ */
+struct ProcDirEntry
+{
+   uint64_t d_ino;
+   int64_t d_off;
+   unsigned short d_reclen;
+   unsigned char d_type;
+   char d_name[1];
+};
+
+/**
+ * Compare processes by PID
+ */
+static int ComparePID(const Process **p1, const Process **p2)
+{
+   return ((*p1)->pid < (*p2)->pid) ? -1 : (((*p1)->pid > (*p2)->pid) ? 1 : 0);
+}
+
+/**
+ * Process table snapshot
+ */
+class ProcessSnapshot
+{
+private:
+   ObjectArray<Process> m_processes;   // Sorted by PID
+   Mutex m_lock;                       // Protects data loaded on demand
+   INT64 m_timestamp;
+   unsigned long long m_uptime;        // System uptime in ticks at snapshot creation
+
+   Process *readProcess(int procfd, const char *pidText, UINT32 pid);
+   void carryOverStaticData(ProcessSnapshot *prev);
+
+public:
+   ProcessSnapshot() : m_processes(1024, 1024, Ownership::True)
+   {
+      m_timestamp = 0;
+      m_uptime = 0;
+   }
+
+   bool create(ProcessSnapshot *prev);
+
+   INT64 getTimestamp() const { return m_timestamp; }
+   int size() const { return m_processes.size(); }
+   Process *get(int index) const { return m_processes.get(index); }
+
+   const char *getCommandLine(Process *p);
+   uid_t getOwner(Process *p);
+};
+
+/**
+ * Read process entry from /proc/<pid>/stat
+ */
+Process *ProcessSnapshot::readProcess(int procfd, const char *pidText, UINT32 pid)
+{
+   char fileName[64];
+   snprintf(fileName, 64, "%s/stat", pidText);
+   int hFile = openat(procfd, fileName, O_RDONLY);
+   if (hFile == -1)
+      return NULL;   // process already gone
+
+   char procStat[1024];
+   ssize_t bytes = _read(hFile, procStat, sizeof(procStat) - 1);
+   _close(hFile);
+   if (bytes <= 0)
+      return NULL;
+   procStat[bytes] = 0;
+
+   // Process name is enclosed in parenthesis and may contain spaces and parenthesis itself
+   char *procName = strchr(procStat, '(');
+   if (procName == NULL)
+      return NULL;
+   char *rest = strrchr(procName, ')');
+   if (rest == NULL)
+      return NULL;
+   procName++;
+   *rest++ = 0;
+
+   Process *p = new Process(pid, procName);
+   if (sscanf(rest, " %c %d %d %*d %*d %*d %*u %lu %*u %lu %*u %lu %lu %*u %*u %*d %*d %ld %*d %llu %lu %ld ",
+              &p->state, &p->parent, &p->group, &p->minflt, &p->majflt,
+              &p->utime, &p->ktime, &p->threads, &p->startTime, &p->vmsize, &p->rss) != 11)
+   {
+      AgentWriteDebugLog(2, _T("Error parsing /proc/%u/stat"), pid);
+   }
+   return p;
+}
+
+/**
+ * Carry over command line and owner from previous snapshot for processes that did not change. Process is
+ * considered the same if it has same PID, start time, and name (the latter catches exec() in same process).
+ * Data of processes younger than PROCESS_SETTLE_TIME is not reused because many daemons change their
+ * title or drop privileges shortly after start.
+ */
+void ProcessSnapshot::carryOverStaticData(ProcessSnapshot *prev)
+{
+   unsigned long long settleTicks = PROCESS_SETTLE_TIME * sysconf(_SC_CLK_TCK);
+   prev->m_lock.lock();
+   int i = 0, j = 0;
+   while((i < m_processes.size()) && (j < prev->m_processes.size()))
+   {
+      Process *p = m_processes.get(i);
+      Process *old = prev->m_processes.get(j);
+      if (p->pid < old->pid)
+      {
+         i++;
+         continue;
+      }
+      if (p->pid > old->pid)
+      {
+         j++;
+         continue;
+      }
+
+      if ((p->startTime == old->startTime) && !strcmp(p->name, old->name) && (prev->m_uptime >= old->startTime + settleTicks))
+      {
+         if (old->cmdLine != NULL)
+            p->cmdLine = MemCopyStringA(old->cmdLine);
+         p->uid = old->uid;
+         p->uidLoaded = old->uidLoaded;
+      }
+      i++;
+      j++;
+   }
+   prev->m_lock.unlock();
+}
+
+/**
+ * Create snapshot by enumerating /proc. Static data (command line and owner) is taken from previous
+ * snapshot where possible. Returns false on failure.
+ */
+bool ProcessSnapshot::create(ProcessSnapshot *prev)
+{
+   m_timestamp = GetCurrentTimeMs();
+   struct timespec ts;
+#ifdef CLOCK_BOOTTIME
+   if (clock_gettime(CLOCK_BOOTTIME, &ts) == 0)
+#else
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+#endif
+   {
+      long ticksPerSecond = sysconf(_SC_CLK_TCK);
+      m_uptime = static_cast<unsigned long long>(ts.tv_sec) * ticksPerSecond + static_cast<unsigned long long>(ts.tv_nsec) * ticksPerSecond / 1000000000;
+   }
+
+   int procfd = _open("/proc", O_RDONLY | O_DIRECTORY);
+   if (procfd == -1)
+   {
+      AgentWriteDebugLog(4, _T("ProcessSnapshot::create: cannot open /proc (%s)"), _tcserror(errno));
+      return false;
+   }
+
+   // Use getdents64 directly to avoid per-entry allocations and sorting done by scandir
+   char buffer[32768];
+   while(true)
+   {
+      long bytes = syscall(SYS_getdents64, procfd, buffer, sizeof(buffer));
+      if (bytes == 0)
+         break;
+      if (bytes < 0)
+      {
+         AgentWriteDebugLog(4, _T("ProcessSnapshot::create: getdents64 failed (%s)"), _tcserror(errno));
+         _close(procfd);
+         return false;
+      }
+
+      for(long offset = 0; offset < bytes;)
+      {
+         ProcDirEntry *e = reinterpret_cast<ProcDirEntry*>(&buffer[offset]);
+         offset += e->d_reclen;
+         if (((e->d_type != DT_DIR) && (e->d_type != DT_UNKNOWN)) || (e->d_name[0] < '1') || (e->d_name[0] > '9'))
+            continue;
+
+         char *eptr;
+         UINT32 pid = strtoul(e->d_name, &eptr, 10);
+         if (*eptr != 0)
+            continue;
+
+         Process *p = readProcess(procfd, e->d_name, pid);
+         if (p != NULL)
+            m_processes.add(p);
+      }
+   }
+   _close(procfd);
+
+   if (m_processes.isEmpty())
+      return false;  // consider 0 as error as there should not be 0 processes
+
+   m_processes.sort(ComparePID);
+   if (prev != NULL)
+      carryOverStaticData(prev);
+   return true;
+}
+
+/**
+ * Get command line of given process (loaded on first request). Arguments are separated by spaces.
+ * Empty string is returned if command line is not available.
+ */
+const char *ProcessSnapshot::getCommandLine(Process *p)
+{
+   m_lock.lock();
+   if (p->cmdLine == NULL)
+   {
+      char fileName[MAX_PATH];
+      snprintf(fileName, MAX_PATH, "/proc/%u/cmdline", p->pid);
+      size_t len = 0;
+      char *cmdLine = MemAllocStringA(4096);
+      int hFile = _open(fileName, O_RDONLY);
+      if (hFile != -1)
+      {
+         size_t allocated = 4096;
+         while(true)
+         {
+            ssize_t bytes = _read(hFile, &cmdLine[len], allocated - len - 1);
+            if (bytes <= 0)
+               break;
+            len += bytes;
+            if (len == allocated - 1)
+            {
+               allocated += 4096;
+               cmdLine = MemRealloc(cmdLine, allocated);
+            }
+         }
+         _close(hFile);
+      }
+
+      // got a valid record in format: argv[0]\x00argv[1]\x00...
+      // Note: to behave identicaly on different platforms,
+      // full command line including argv[0] should be matched
+      // replace 0x00 with spaces
+      if (len > 0)
+      {
+         for(size_t i = 0; i < len - 1; i++)
+         {
+            if (cmdLine[i] == 0)
+               cmdLine[i] = ' ';
+         }
+      }
+      cmdLine[len] = 0;
+      p->cmdLine = cmdLine;
+   }
+   m_lock.unlock();
+   return p->cmdLine;
+}
+
+/**
+ * Get owner of given process (loaded on first request). Returns -1 if owner cannot be determined.
+ */
+uid_t ProcessSnapshot::getOwner(Process *p)
+{
+   m_lock.lock();
+   if (!p->uidLoaded)
+   {
+      char fileName[MAX_PATH];
+      snprintf(fileName, MAX_PATH, "/proc/%u/", p->pid);
+      struct stat fileInfo;
+      p->uid = (stat(fileName, &fileInfo) == 0) ? fileInfo.st_uid : static_cast<uid_t>(-1);
+      p->uidLoaded = true;
+   }
+   m_lock.unlock();
+   return p->uid;
+}
+
+/**
+ * Current process snapshot
+ */
+static shared_ptr<ProcessSnapshot> s_snapshot;
+static Mutex s_snapshotLock;
+
+/**
+ * Snapshot validity interval in milliseconds (0 to create new snapshot on each request)
+ */
+static UINT32 s_snapshotInterval = 1000;
+
+/**
+ * Get current process snapshot, creating new one if existing is too old. Only one thread creates new
+ * snapshot at a time, other threads wait and use result.
+ */
+static shared_ptr<ProcessSnapshot> GetProcessSnapshot()
+{
+   s_snapshotLock.lock();
+   INT64 now = GetCurrentTimeMs();
+   if ((s_snapshot == nullptr) || (now - s_snapshot->getTimestamp() >= s_snapshotInterval) || (now < s_snapshot->getTimestamp()))
+   {
+      auto snapshot = make_shared<ProcessSnapshot>();
+      if (snapshot->create(s_snapshot.get()))
+      {
+         s_snapshot = snapshot;
+      }
+      else
+      {
+         s_snapshotLock.unlock();
+         return shared_ptr<ProcessSnapshot>();
+      }
+   }
+   shared_ptr<ProcessSnapshot> result = s_snapshot;
+   s_snapshotLock.unlock();
+   return result;
+}
+
+/**
+ * Configure process snapshot
+ */
+void InitProcessSnapshot(Config *config)
+{
+   s_snapshotInterval = config->getValueAsUInt(_T("/Linux/ProcessSnapshotInterval"), s_snapshotInterval);
+   AgentWriteDebugLog(3, _T("Process snapshot validity interval set to %u milliseconds"), s_snapshotInterval);
+}
+
+/**
+ * Release process snapshot
+ */
+void ShutdownProcessSnapshot()
+{
+   s_snapshotLock.lock();
+   s_snapshot.reset();
+   s_snapshotLock.unlock();
+}
+
+/**
+ * Compile process filter. Returns NULL if expression is invalid.
+ */
+static pcre *CompileFilter(const char *expr, bool matchCase)
+{
+   const char *errptr;
+   int erroffset;
+   pcre *preg = pcre_compile(expr, matchCase ? PCRE_COMMON_FLAGS_A : PCRE_COMMON_FLAGS_A | PCRE_CASELESS, &errptr, &erroffset, NULL);
+   if (preg == NULL)
+      AgentWriteDebugLog(4, _T("Invalid process filter \"%hs\" (%hs at offset %d)"), expr, errptr, erroffset);
+   return preg;
+}
+
+/**
+ * Match string against compiled filter
+ */
+static inline bool MatchFilter(pcre *preg, const char *str)
+{
+   int ovector[60];
+   return pcre_exec(preg, NULL, str, static_cast<int>(strlen(str)), 0, 0, ovector, 60) >= 0;
+}
+
+/**
+ * Read process information from process snapshot
  * Parameters:
  *    plist    - array to fill, can be NULL
  *    procNameFilter - If not NULL, only processes with matched name will
@@ -178,172 +561,73 @@ static int ProcRead(ObjectArray<Process> *plist, const char *procNameFilter, con
       getpwnam_r(procUser, &pwd, buf, 16384, &result);
       if (result == NULL)
       {
+         free(buf);
          return -2; //If user is set, but it's not found return unsupported
       }
       procUid = pwd.pw_uid;
       free(buf);
    }
 
-	struct dirent **nameList;
-	int count = scandir("/proc", &nameList, ProcFilter, alphasort);
-   if (count < 0)
+   shared_ptr<ProcessSnapshot> snapshot = GetProcessSnapshot();
+   if (snapshot == nullptr)
       return -1;
-   if (count == 0)
-   {
-      free(nameList);
-      return -1;  // consider 0 as error as there should not be 0 processes
-   }
-   
+
    // get process count without filtering, we can skip long loop
 	if ((plist == NULL) && (procNameFilter == NULL) && (cmdLineFilter == NULL) && (procUser == NULL))
-	{
-      for(int i = 0; i < count; i++)
-         free(nameList[i]);
-      free(nameList);
-		return count;
-	}
+		return snapshot->size();
 
-   int found = 0;
-   while(count-- > 0)
+   // Compile filters once instead of once per process
+   bool nameFilterEnabled = (procNameFilter != NULL) && (*procNameFilter != 0);
+   pcre *nameRegexp = NULL;
+   if (nameFilterEnabled && (cmdLineFilter != NULL))
    {
-      bool procFound = false;
-      bool cmdFound = false;
-      bool uidFound = true;
-      char *pProcName = NULL;
-      char *pProcStat = NULL;
-      unsigned int nPid = 0;
-
-      char fileName[MAX_PATH], procNameBuffer[MAX_PROCESS_NAME_LEN + 1];
-
-      snprintf(fileName, MAX_PATH, "/proc/%s/stat", nameList[count]->d_name);
-      int hFile = _open(fileName, O_RDONLY);
-      char szProcStat[1024];
-      if (hFile != -1)
-      {
-         ssize_t bytes = _read(hFile, szProcStat, sizeof(szProcStat) - 1);
-         if (bytes > 0)
-         {
-            szProcStat[bytes] = 0;
-            if (sscanf(szProcStat, "%u ", &nPid) == 1)
-            {
-               char *procNamePos = strchr(szProcStat, '(');
-               if (procNamePos != NULL)
-               {
-                  pProcStat = strrchr(procNamePos, ')');
-                  if (pProcStat != NULL)
-                  {
-                     pProcName = procNamePos + 1;
-                     *pProcStat = 0;
-                     pProcStat++;
-                  }
-                  if (pProcName != NULL)
-                  {
-                     if ((procNameFilter != NULL) && (*procNameFilter != 0))
-                     {
-                        if (cmdLineFilter == NULL) // use old style compare
-                           procFound = (strcmp(pProcName, procNameFilter) == 0);
-                        else
-                           procFound = RegexpMatchA(pProcName, procNameFilter, FALSE);
-                     }
-                     else
-                     {
-                        procFound = true;
-                     }
-                  }
-               } // pProcName != NULL
-            }
-         } // _read
-         _close(hFile);
-      } // hFile
+      nameRegexp = CompileFilter(procNameFilter, false);
+      if (nameRegexp == NULL)
+         return 0;   // invalid expression does not match any process
+   }
 
-      if (procUid != -1)
+   pcre *cmdLineRegexp = NULL;
+   if ((cmdLineFilter != NULL) && (*cmdLineFilter != 0))
+   {
+      cmdLineRegexp = CompileFilter(cmdLineFilter, true);
+      if (cmdLineRegexp == NULL)
       {
-         snprintf(fileName, MAX_PATH, "/proc/%s/", nameList[count]->d_name);
-         struct stat fileInfo;
-         if (stat(fileName, &fileInfo) == 0)
-            uidFound = fileInfo.st_uid == procUid;
-         else
-            uidFound = false;
+         if (nameRegexp != NULL)
+            pcre_free(nameRegexp);
+         return 0;
       }
+   }
 
-      if ((cmdLineFilter != NULL) && (*cmdLineFilter != 0))
-      {
-         snprintf(fileName, MAX_PATH, "/proc/%s/cmdline", nameList[count]->d_name);
-         hFile = _open(fileName, O_RDONLY);
-         if (hFile != -1)
-         {
-            size_t len = 0, pos = 0;
-            char *processCmdLine = (char *)malloc(4096);
-            while(true)
-            {
-               ssize_t bytes = _read(hFile, &processCmdLine[pos], 4096);
-               if (bytes < 0)
-                  bytes = 0;
-               len += bytes;
-               if (bytes < 1024)
-               {
-                  processCmdLine[len] = 0;
-                  break;
-               }
-               pos += bytes;
-               processCmdLine = (char *)realloc(processCmdLine, pos + 4096);
-            }
-            if (len > 0)
-            {
-               // got a valid record in format: argv[0]\x00argv[1]\x00...
-               // Note: to behave identicaly on different platforms,
-               // full command line including argv[0] should be matched
-               // replace 0x00 with spaces
-               for(int j = 0; j < len - 1; j++)
-               {
-                  if (processCmdLine[j] == 0)
-                  {
-                     processCmdLine[j] = ' ';
-                  }
-               }
-               cmdFound = RegexpMatchA(processCmdLine, cmdLineFilter, TRUE);
-            }
-            else
-            {
-               cmdFound = RegexpMatchA("", cmdLineFilter, TRUE);
-            }
-            _close(hFile);
-            free(processCmdLine);
-         } // hFile != -1
-         else
-         {
-            cmdFound = RegexpMatchA("", cmdLineFilter, TRUE);
-         }
-      } // cmdLineFilter
-      else
+   int found = 0;
+   for(int i = 0; i < snapshot->size(); i++)
+   {
+      Process *p = snapshot->get(i);
+
+      if (nameFilterEnabled)
       {
-         cmdFound = true;
+         if ((nameRegexp != NULL) ? !MatchFilter(nameRegexp, p->name) : (strcmp(p->name, procNameFilter) != 0))
+            continue;
       }
 
-      if (procFound && cmdFound && uidFound)
+      if ((procUid != -1) && (snapshot->getOwner(p) != procUid))
+         continue;
+
+      if ((cmdLineRegexp != NULL) && !MatchFilter(cmdLineRegexp, snapshot->getCommandLine(p)))
+         continue;
+
+      if (plist != NULL)
       {
-         if ((plist != NULL) && (pProcName != NULL))
-         {
-            Process *p = new Process(nPid, pProcName);
-            // Parse rest of /proc/pid/stat file
-            if (pProcStat != NULL)
-            {
-               if (sscanf(pProcStat, " %c %d %d %*d %*d %*d %*u %lu %*u %lu %*u %lu %lu %*u %*u %*d %*d %ld %*d %*u %lu %ld ",
-                          &p->state, &p->parent, &p->group, &p->minflt, &p->majflt,
-                          &p->utime, &p->ktime, &p->threads, &p->vmsize, &p->rss) != 10)
-               {
-                  AgentWriteDebugLog(2, _T("Error parsing /proc/%u/stat"), nPid);
-               }
-            }
-            p->fd = readHandles ? ReadProcessHandles(nPid) : NULL;
-            plist->add(p);
-         }
-         found++;
+         Process *copy = new Process(*p);
+         copy->fd = readHandles ? ReadProcessHandles(p->pid) : NULL;
+         plist->add(copy);
       }
-
-      free(nameList[count]);
+      found++;
    }
-   free(nameList);
+
+   if (nameRegexp != NULL)
+      pcre_free(nameRegexp);
+   if (cmdLineRegexp != NULL)
+      pcre_free(cmdLineRegexp);
 	return found;
 }
 
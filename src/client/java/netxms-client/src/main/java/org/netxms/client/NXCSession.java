@@ -74,6 +74,7 @@
 import org.netxms.client.constants.AuthenticationType;
 import org.netxms.client.constants.DataOrigin;
 import org.netxms.client.constants.DataType;
+import org.netxms.client.constants.DownsamplingMethod;
 import org.netxms.client.constants.HistoricalDataType;
 import org.netxms.client.constants.NodePollType;
 import org.netxms.client.constants.ObjectStatus;
@@ -5017,6 +5018,50 @@ public DciData getCollectedData(long nodeId, long dciId, Date from, Date to, int
       return getCollectedDataInternal(nodeId, dciId, null, null, from, to, maxRows, valueType);
    }
 
+   /**
+    * Get downsampled DCI data from server. Requested time range is divided by server into intervals of equal
+    * length and each interval is represented by single value calculated using given method, or points are
+    * selected using LTTB (Largest Triangle Three Buckets) algorithm. Values are always returned as
+    * floating point numbers.
+    *
+    * @param nodeId       Node ID
+    * @param dciId        DCI ID
+    * @param from         Start of time range
+    * @param to           End of time range or null for current time
+    * @param targetPoints Maximum number of data points to retrieve
+    * @param method       Downsampling method
+    * @return DCI data set
+    * @throws IOException  if socket I/O error occurs
+    * @throws NXCException if NetXMS server returns an error or operation was timed out
+    */
+   public DciData getCollectedDataDownsampled(long nodeId, long dciId, Date from, Date to, int targetPoints, DownsamplingMethod method)
+         throws IOException, NXCException
+   {
+      if ((from == null) || (targetPoints <= 0))
+         throw new NXCException(RCC.INVALID_ARGUMENT);
+
+      NXCPMessage msg = newMessage(NXCPCodes.CMD_GET_DCI_DATA);
+      msg.setFieldInt32(NXCPCodes.VID_OBJECT_ID, (int)nodeId);
+      msg.setFieldInt32(NXCPCodes.VID_DCI_ID, (int)dciId);
+      msg.setFieldInt16(NXCPCodes.VID_HISTORICAL_DATA_TYPE, HistoricalDataType.PROCESSED.getValue());
+      msg.setFieldInt32(NXCPCodes.VID_MAX_ROWS, targetPoints);
+      msg.setFieldInt32(NXCPCodes.VID_TIME_FROM, (int)(from.getTime() / 1000));
+      msg.setFieldInt32(NXCPCodes.VID_TIME_TO, (to != null) ? (int)(to.getTime() / 1000) : 0);
+      msg.setFieldInt32(NXCPCodes.VID_TARGET_POINT_COUNT, targetPoints);
+      msg.setFieldInt16(NXCPCodes.VID_DOWNSAMPLING_METHOD, method.getValue());
+      sendMessage(msg);
+
+      waitForRCC(msg.getMessageId());
+
+      NXCPMessage response = waitForMessage(NXCPCodes.CMD_DCI_DATA, msg.getMessageId());
+      if (!response.isBinaryMessage())
+         throw new NXCException(RCC.INTERNAL_ERROR);
+
+      DciData data = new DciData(nodeId, dciId);
+      parseDataRows(response.getBinaryData(), data);
+      return data;
+   }
+
    /**
     * Get collected table DCI data from server. Please note that you should specify
     * either row count limit or time from/to limit.
@@ -598,6 +598,7 @@ extern "C" DBDRV_UNBUFFERED_RESULT __EXPORT DrvSelectUnbuffered(SQLITE_CONN *hCo
       result->connection = hConn;
       result->stmt = stmt;
       result->prepared = false;
+      result->numColumns = sqlite3_column_count(stmt);
 		*pdwError = DBERR_SUCCESS;
    }
    else if ((rc == SQLITE_LOCKED) || (rc == SQLITE_LOCKED_SHAREDCACHE))
@@ -629,6 +630,7 @@ extern "C" DBDRV_UNBUFFERED_RESULT __EXPORT DrvSelectPreparedUnbuffered(SQLITE_C
    result->connection = hConn;
    result->stmt = stmt;
    result->prepared = true;
+   result->numColumns = sqlite3_column_count(stmt);
    *pdwError = DBERR_SUCCESS;
    return result;
 }
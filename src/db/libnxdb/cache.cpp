@@ -57,22 +57,10 @@ void LIBNXDB_EXPORTABLE DBCloseInMemoryDatabase(DB_HANDLE hdb)
 }
 
 /**
- * Cache table
+ * Create table in cache database with same columns as in given result set and prepare insert statement for it
  */
-bool LIBNXDB_EXPORTABLE DBCacheTable(DB_HANDLE cacheDB, DB_HANDLE sourceDB, const TCHAR *table, const TCHAR *indexColumn,
-         const TCHAR *columns, const TCHAR * const *intColumns)
+template<typename R> static DB_STATEMENT CreateCacheTable(DB_HANDLE cacheDB, R hResult, const TCHAR *table, const TCHAR *indexColumn, const TCHAR * const *intColumns)
 {
-   TCHAR query[1024];
-   _sntprintf(query, 1024, _T("SELECT %s FROM %s"), columns, table);
-
-   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
-   DB_UNBUFFERED_RESULT hResult = DBSelectUnbufferedEx(sourceDB, query, errorText);
-   if (hResult == NULL)
-   {
-      nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot read table %s for caching: %s"), table, errorText);
-      return false;
-   }
-
    StringBuffer createStatement = _T("CREATE TABLE ");
    createStatement.append(table);
    createStatement.append(_T(" ("));
@@ -87,9 +75,8 @@ bool LIBNXDB_EXPORTABLE DBCacheTable(DB_HANDLE cacheDB, DB_HANDLE sourceDB, cons
       TCHAR name[256];
       if (!DBGetColumnName(hResult, i, name, 256))
       {
-         DBFreeResult(hResult);
          nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot get name of column %d of table %s"), i, table);
-         return false;
+         return NULL;
       }
       if (i > 0)
       {
@@ -123,11 +110,11 @@ bool LIBNXDB_EXPORTABLE DBCacheTable(DB_HANDLE cacheDB, DB_HANDLE sourceDB, cons
       createStatement.append(_T(')'));
    }
 
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
    if (!DBQueryEx(cacheDB, createStatement, errorText))
    {
-      DBFreeResult(hResult);
       nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot create table %s in cache database: %s"), table, errorText);
-      return false;
+      return NULL;
    }
 
    insertStatement.append(_T(") VALUES ("));
@@ -137,15 +124,38 @@ bool LIBNXDB_EXPORTABLE DBCacheTable(DB_HANDLE cacheDB, DB_HANDLE sourceDB, cons
    insertStatement.append(_T(')'));
 
    DB_STATEMENT hInsertStmt = DBPrepareEx(cacheDB, insertStatement, true, errorText);
+   if (hInsertStmt == NULL)
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot prepare insert statement for table %s in cache database: %s"), table, errorText);
+   return hInsertStmt;
+}
+
+/**
+ * Cache table
+ */
+bool LIBNXDB_EXPORTABLE DBCacheTable(DB_HANDLE cacheDB, DB_HANDLE sourceDB, const TCHAR *table, const TCHAR *indexColumn,
+         const TCHAR *columns, const TCHAR * const *intColumns)
+{
+   TCHAR query[1024];
+   _sntprintf(query, 1024, _T("SELECT %s FROM %s"), columns, table);
+
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   DB_UNBUFFERED_RESULT hResult = DBSelectUnbufferedEx(sourceDB, query, errorText);
+   if (hResult == NULL)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot read table %s for caching: %s"), table, errorText);
+      return false;
+   }
+
+   DB_STATEMENT hInsertStmt = CreateCacheTable(cacheDB, hResult, table, indexColumn, intColumns);
    if (hInsertStmt == NULL)
    {
       DBFreeResult(hResult);
-      nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot prepare insert statement for table %s in cache database: %s"), table, errorText);
       return false;
    }
 
    DBBegin(cacheDB);
 
+   int numColumns = DBGetColumnCount(hResult);
    while(DBFetch(hResult))
    {
       for(int i = 0; i < numColumns; i++)
@@ -165,3 +175,139 @@ bool LIBNXDB_EXPORTABLE DBCacheTable(DB_HANDLE cacheDB, DB_HANDLE sourceDB, cons
    DBFreeResult(hResult);
    return true;
 }
+
+/**
+ * Copy rows from buffered result set into cache database
+ */
+static bool InsertIntoCacheTable(DB_HANDLE cacheDB, DB_RESULT hResult, const DBCachedTableDefinition *table)
+{
+   DB_STATEMENT hInsertStmt = CreateCacheTable(cacheDB, hResult, table->table, table->indexColumn, table->intColumns);
+   if (hInsertStmt == NULL)
+      return false;
+
+   DBBegin(cacheDB);
+
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   int numColumns = DBGetColumnCount(hResult);
+   int numRows = DBGetNumRows(hResult);
+   for(int row = 0; row < numRows; row++)
+   {
+      for(int i = 0; i < numColumns; i++)
+         DBBind(hInsertStmt, i + 1, DB_SQLTYPE_VARCHAR, DBGetField(hResult, row, i, NULL, 0), DB_BIND_DYNAMIC);
+      if (!DBExecuteEx(hInsertStmt, errorText))
+      {
+         DBRollback(cacheDB);
+         DBFreeStatement(hInsertStmt);
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot execute insert statement for table %s in cache database: %s"), table->table, errorText);
+         return false;
+      }
+   }
+
+   DBCommit(cacheDB);
+   DBFreeStatement(hInsertStmt);
+   return true;
+}
+
+/**
+ * Shared state for parallel table caching
+ */
+struct CacheTablesContext
+{
+   DB_HANDLE cacheDB;
+   DB_HANDLE sourceDB;
+   const DBCachedTableDefinition *tables;
+   int count;
+   VolatileCounter nextTable;
+   volatile bool success;
+   Mutex cacheLock;
+};
+
+/**
+ * Table caching worker. Each worker reads tables from source database using its own connection,
+ * so network round trips and data transfer for different tables overlap. Access to cache database is serialized.
+ */
+static void CacheTablesWorker(CacheTablesContext *context, DB_HANDLE hdb)
+{
+   while(context->success)
+   {
+      int index = InterlockedIncrement(&context->nextTable) - 1;
+      if (index >= context->count)
+         break;
+
+      const DBCachedTableDefinition *table = &context->tables[index];
+      TCHAR query[1024];
+      _sntprintf(query, 1024, _T("SELECT %s FROM %s"), table->columns, table->table);
+
+      INT64 startTime = GetCurrentTimeMs();
+      TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+      DB_RESULT hResult = DBSelectEx(hdb, query, errorText);
+      if (hResult == NULL)
+      {
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("Cannot read table %s for caching: %s"), table->table, errorText);
+         context->success = false;
+         break;
+      }
+      INT64 readTime = GetCurrentTimeMs() - startTime;
+
+      context->cacheLock.lock();
+      bool success = InsertIntoCacheTable(context->cacheDB, hResult, table);
+      context->cacheLock.unlock();
+
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("Table %s cached (%d rows, read in ") INT64_FMT _T(" ms, total ") INT64_FMT _T(" ms)"),
+               table->table, DBGetNumRows(hResult), readTime, GetCurrentTimeMs() - startTime);
+      DBFreeResult(hResult);
+
+      if (!success)
+      {
+         context->success = false;
+         break;
+      }
+   }
+}
+
+/**
+ * Table caching worker running on pooled connection
+ */
+static void PooledCacheTablesWorker(CacheTablesContext *context)
+{
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+   CacheTablesWorker(context, hdb);
+   DBConnectionPoolReleaseConnection(hdb);
+}
+
+/**
+ * Cache multiple tables using given number of source database connections. Calling thread uses
+ * provided source database connection, additional connections are taken from connection pool.
+ * Table list should be terminated by element with table name set to NULL.
+ */
+bool LIBNXDB_EXPORTABLE DBCacheTables(DB_HANDLE cacheDB, DB_HANDLE sourceDB, const DBCachedTableDefinition *tables, int parallelism)
+{
+   CacheTablesContext context;
+   context.cacheDB = cacheDB;
+   context.sourceDB = sourceDB;
+   context.tables = tables;
+   context.count = 0;
+   while(tables[context.count].table != NULL)
+      context.count++;
+   context.nextTable = 0;
+   context.success = true;
+
+   if (parallelism > context.count)
+      parallelism = context.count;
+   if (parallelism <= 1)
+   {
+      CacheTablesWorker(&context, sourceDB);
+      return context.success;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("Caching %d tables using %d connections"), context.count, parallelism);
+   int numWorkers = parallelism - 1;
+   THREAD *workers = MemAllocArrayNoInit<THREAD>(numWorkers);
+   for(int i = 0; i < numWorkers; i++)
+      workers[i] = ThreadCreateEx(PooledCacheTablesWorker, &context);
+   CacheTablesWorker(&context, sourceDB);
+   for(int i = 0; i < numWorkers; i++)
+      ThreadJoin(workers[i]);
+   MemFree(workers);
+   return context.success;
+}
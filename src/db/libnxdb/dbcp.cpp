@@ -472,6 +472,8 @@ ObjectArray<PoolConnectionInfo> LIBNXDB_EXPORTABLE *DBConnectionPoolGetConnectio
       {
          PoolConnectionInfo *ci = new PoolConnectionInfo;
          memcpy(ci, curr, sizeof(PoolConnectionInfo));
+         ci->statementCacheHits = curr->handle->m_statementCacheHits;
+         ci->statementCacheMisses = curr->handle->m_statementCacheMisses;
          list->add(ci);
       }
    }
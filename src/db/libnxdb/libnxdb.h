@@ -97,6 +97,9 @@ struct db_statement_t
 	DB_HANDLE m_connection;
 	DBDRV_STATEMENT m_statement;
 	TCHAR *m_query;
+	bool m_cached;      // Statement is owned by connection's statement cache
+	bool m_inUse;       // Cached statement is currently given out to caller
+	uint64_t m_lastUse; // Statement cache clock value at last use
 };
 
 /**
@@ -117,6 +120,10 @@ struct db_handle_t
    char *m_schema;
    ObjectArray<db_statement_t> *m_preparedStatements;
    MUTEX m_preparedStatementsLock;
+   StringObjectMap<db_statement_t> *m_statementCache;  // Reusable statements keyed by query text
+   uint64_t m_statementCacheClock;
+   uint32_t m_statementCacheHits;
+   uint32_t m_statementCacheMisses;
 };
 
 /**
@@ -42,6 +42,30 @@ static uint64_t s_perfFailedQueries = 0;
  */
 static void (*s_sessionInitCb)(DB_HANDLE session) = nullptr;
 
+/**
+ * Max number of cached prepared statements per connection (0 to disable cache)
+ */
+static int s_statementCacheSize = 32;
+
+/**
+ * Release cached statement after invalidation. Statements currently given out
+ * to callers are detached from cache and will be destroyed by DBFreeStatement.
+ */
+static EnumerationCallbackResult ReleaseCachedStatement(const TCHAR *query, const db_statement_t *stmt, db_handle_t *hConn)
+{
+   db_statement_t *s = const_cast<db_statement_t*>(stmt);
+   if (s->m_inUse)
+   {
+      s->m_cached = false;
+   }
+   else
+   {
+      MemFree(s->m_query);
+      MemFree(s);
+   }
+   return _CONTINUE;
+}
+
 /**
  * Invalidate all prepared statements on connection
  */
@@ -56,9 +80,51 @@ static void InvalidatePreparedStatements(DB_HANDLE hConn)
       stmt->m_connection = nullptr;
    }
    hConn->m_preparedStatements->clear();
+   hConn->m_statementCache->forEach(ReleaseCachedStatement, hConn);
+   hConn->m_statementCache->clear();
    MutexUnlock(hConn->m_preparedStatementsLock);
 }
 
+/**
+ * Callback for finding least recently used idle statement in cache
+ */
+static EnumerationCallbackResult FindEvictionCandidate(const TCHAR *query, const db_statement_t *stmt, db_statement_t **candidate)
+{
+   if (!stmt->m_inUse && ((*candidate == nullptr) || (stmt->m_lastUse < (*candidate)->m_lastUse)))
+      *candidate = const_cast<db_statement_t*>(stmt);
+   return _CONTINUE;
+}
+
+/**
+ * Add newly prepared statement to connection's statement cache. Least recently used
+ * idle statement is destroyed if cache is full. Statement will not be cached if there is
+ * already cached statement with same query or all cached statements are in use.
+ * Must be called with connection's prepared statement lock held.
+ */
+static void AddStatementToCache(DB_HANDLE hConn, db_statement_t *stmt)
+{
+   if (hConn->m_statementCache->get(stmt->m_query) != nullptr)
+      return;
+
+   if (hConn->m_statementCache->size() >= s_statementCacheSize)
+   {
+      db_statement_t *victim = nullptr;
+      hConn->m_statementCache->forEach(FindEvictionCandidate, &victim);
+      if (victim == nullptr)
+         return;
+      hConn->m_statementCache->remove(victim->m_query);
+      hConn->m_preparedStatements->remove(victim);
+      hConn->m_driver->m_fpDrvFreeStatement(victim->m_statement);
+      MemFree(victim->m_query);
+      MemFree(victim);
+   }
+
+   stmt->m_cached = true;
+   stmt->m_inUse = true;
+   stmt->m_lastUse = ++hConn->m_statementCacheClock;
+   hConn->m_statementCache->set(stmt->m_query, stmt);
+}
+
 /**
  * Connect to database
  */
@@ -95,6 +161,8 @@ DB_HANDLE LIBNXDB_EXPORTABLE DBConnect(DB_DRIVER driver, const TCHAR *server, co
          hConn->m_transactionLevel = 0;
          hConn->m_preparedStatements = new ObjectArray<db_statement_t>(4, 4, Ownership::False);
          hConn->m_preparedStatementsLock = MutexCreateFast();
+         hConn->m_statementCache = new StringObjectMap<db_statement_t>(Ownership::False);
+         hConn->m_statementCache->setIgnoreCase(false);
          hConn->m_dbName = utfDatabase;
          hConn->m_login = utfLogin;
          hConn->m_password = utfPassword;
@@ -142,6 +210,7 @@ void LIBNXDB_EXPORTABLE DBDisconnect(DB_HANDLE hConn)
    MemFree(hConn->m_server);
    MemFree(hConn->m_schema);
    delete hConn->m_preparedStatements;
+   delete hConn->m_statementCache;
    MutexDestroy(hConn->m_preparedStatementsLock);
    MemFree(hConn);
 }
@@ -233,6 +302,16 @@ void LIBNXDB_EXPORTABLE DBSetSessionInitCallback(void (*cb)(DB_HANDLE))
    s_sessionInitCb = cb;
 }
 
+/**
+ * Set max number of cached prepared statements per connection (0 to disable statement cache).
+ * Only statements prepared with DBPrepareCached are cached.
+ */
+void LIBNXDB_EXPORTABLE DBSetStatementCacheSize(int size)
+{
+   s_statementCacheSize = std::max(size, 0);
+   nxlog_debug_tag(DEBUG_TAG_QUERY, 3, _T("DB Library: prepared statement cache size set to %d"), s_statementCacheSize);
+}
+
 /**
  * Perform a non-SELECT SQL query
  */
@@ -1132,9 +1211,9 @@ void LIBNXDB_EXPORTABLE DBFreeResult(DB_UNBUFFERED_RESULT hResult)
 }
 
 /**
- * Prepare statement
+ * Prepare statement (optionally using connection's statement cache)
  */
-DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareEx(DB_HANDLE hConn, const TCHAR *query, bool optimizeForReuse, TCHAR *errorText)
+static DB_STATEMENT PrepareStatement(DB_HANDLE hConn, const TCHAR *query, bool optimizeForReuse, bool useCache, TCHAR *errorText)
 {
 	DB_STATEMENT result = NULL;
 	INT64 ms;
@@ -1147,6 +1226,29 @@ DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareEx(DB_HANDLE hConn, const TCHAR *query,
 	WCHAR wcErrorText[DBDRV_MAX_ERROR_TEXT] = L"";
 #endif
 
+   useCache = useCache && (s_statementCacheSize > 0);
+   if (useCache)
+   {
+      MutexLock(hConn->m_preparedStatementsLock);
+      result = hConn->m_statementCache->get(query);
+      if ((result != NULL) && !result->m_inUse)
+      {
+         result->m_inUse = true;
+         result->m_lastUse = ++hConn->m_statementCacheClock;
+         hConn->m_statementCacheHits++;
+         MutexUnlock(hConn->m_preparedStatementsLock);
+         if (hConn->m_driver->m_dumpSql)
+            nxlog_debug_tag(DEBUG_TAG_QUERY, 9, _T("{%p} Cached statement reused: \"%s\""), result, query);
+#ifndef UNICODE
+         MemFree(pwszQuery);
+#endif
+         return result;
+      }
+      result = NULL;
+      hConn->m_statementCacheMisses++;
+      MutexUnlock(hConn->m_preparedStatementsLock);
+   }
+
 	MutexLock(hConn->m_mutexTransLock);
 
 	if (hConn->m_driver->m_dumpSql)
@@ -1168,6 +1270,9 @@ DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareEx(DB_HANDLE hConn, const TCHAR *query,
 		result->m_connection = hConn;
 		result->m_statement = stmt;
 		result->m_query = _tcsdup(query);
+		result->m_cached = false;
+		result->m_inUse = false;
+		result->m_lastUse = 0;
 	}
 	else
 	{
@@ -1198,6 +1303,8 @@ DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareEx(DB_HANDLE hConn, const TCHAR *query,
    {
       MutexLock(hConn->m_preparedStatementsLock);
       hConn->m_preparedStatements->add(result);
+      if (useCache)
+         AddStatementToCache(hConn, result);
       MutexUnlock(hConn->m_preparedStatementsLock);
    }
 
@@ -1206,13 +1313,47 @@ DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareEx(DB_HANDLE hConn, const TCHAR *query,
 #undef wcErrorText
 }
 
+/**
+ * Prepare statement
+ */
+DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareEx(DB_HANDLE hConn, const TCHAR *query, bool optimizeForReuse, TCHAR *errorText)
+{
+   return PrepareStatement(hConn, query, optimizeForReuse, false, errorText);
+}
+
 /**
  * Prepare statement
  */
 DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepare(DB_HANDLE hConn, const TCHAR *query, bool optimizeForReuse)
 {
 	TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
-	return DBPrepareEx(hConn, query, optimizeForReuse, errorText);
+	return PrepareStatement(hConn, query, optimizeForReuse, false, errorText);
+}
+
+/**
+ * Prepare statement using connection's statement cache. If idle statement with same query
+ * is cached it is returned instead of preparing new one. DBFreeStatement returns such statement
+ * back to the cache. Intended for frequently executed queries with fixed text.
+ */
+DB_STATEMENT LIBNXDB_EXPORTABLE DBPrepareCached(DB_HANDLE hConn, const TCHAR *query)
+{
+	TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+	return PrepareStatement(hConn, query, true, true, errorText);
+}
+
+/**
+ * Get statement cache statistics for given connection. Any of output parameters can be NULL.
+ */
+void LIBNXDB_EXPORTABLE DBGetStatementCacheStats(DB_HANDLE hConn, uint32_t *hits, uint32_t *misses, int *size)
+{
+   MutexLock(hConn->m_preparedStatementsLock);
+   if (hits != NULL)
+      *hits = hConn->m_statementCacheHits;
+   if (misses != NULL)
+      *misses = hConn->m_statementCacheMisses;
+   if (size != NULL)
+      *size = hConn->m_statementCache->size();
+   MutexUnlock(hConn->m_preparedStatementsLock);
 }
 
 /**
@@ -1226,6 +1367,13 @@ void LIBNXDB_EXPORTABLE DBFreeStatement(DB_STATEMENT hStmt)
    if (hStmt->m_connection != NULL)
    {
       MutexLock(hStmt->m_connection->m_preparedStatementsLock);
+      if (hStmt->m_cached)
+      {
+         // Return statement to connection's statement cache
+         hStmt->m_inUse = false;
+         MutexUnlock(hStmt->m_connection->m_preparedStatementsLock);
+         return;
+      }
       hStmt->m_connection->m_preparedStatements->remove(hStmt);
       MutexUnlock(hStmt->m_connection->m_preparedStatementsLock);
    }
@@ -0,0 +1,600 @@
+/*
+** nxflowd - NetXMS Flow Collector Daemon
+** Copyright (c) 2009-2020 Raden Solutions
+*/
+
+#include "nxflowd.h"
+
+/**
+ * Maximum number of rows in single multi-row INSERT statement
+ */
+#define MAX_ROWS_PER_STATEMENT   1000
+
+/**
+ * Interval between statistics reports (seconds)
+ */
+#define STATISTICS_REPORT_INTERVAL  60
+
+/**
+ * Aggregation key. All unused fields must be zeroed so key can be compared as binary block.
+ */
+struct FlowKey
+{
+   INT64 bucket;
+   UINT32 exporter;
+   UINT32 exporterAddr;
+   UINT32 sourceAddr;
+   UINT32 destAddr;
+   UINT32 ingressInterface;
+   UINT32 egressInterface;
+   UINT16 sourcePort;
+   UINT16 destPort;
+   BYTE sourceMac[6];
+   BYTE destMac[6];
+   BYTE protocol;
+   BYTE padding[3];
+   UINT32 fields;
+};
+
+/**
+ * Per-exporter statistics
+ */
+struct ExporterStatistics
+{
+   UINT64 flowsReceived;
+   UINT64 recordsWritten;
+   UINT64 recordsDropped;
+};
+
+/**
+ * Names of fields which can be used in aggregation key
+ */
+static struct
+{
+   const TCHAR *name;
+   UINT32 field;
+} s_keyFields[] =
+{
+   { _T("exporter_ip_addr"), FLOW_FIELD_EXPORTER_ADDR },
+   { _T("source_mac_addr"), FLOW_FIELD_SOURCE_MAC },
+   { _T("dest_mac_addr"), FLOW_FIELD_DEST_MAC },
+   { _T("source_ip_addr"), FLOW_FIELD_SOURCE_ADDR },
+   { _T("dest_ip_addr"), FLOW_FIELD_DEST_ADDR },
+   { _T("ip_proto"), FLOW_FIELD_PROTOCOL },
+   { _T("source_ip_port"), FLOW_FIELD_SOURCE_PORT },
+   { _T("dest_ip_port"), FLOW_FIELD_DEST_PORT },
+   { _T("ingress_interface"), FLOW_FIELD_INGRESS_IF },
+   { _T("egress_interface"), FLOW_FIELD_EGRESS_IF },
+   { NULL, 0 }
+};
+
+/**
+ * Static data
+ */
+static UINT32 s_keyFieldMask = 0;
+static HashMap<FlowKey, FlowRecord> *s_aggregates = NULL;
+static Mutex s_aggregatorLock;
+static HashMap<UINT32, ExporterStatistics> s_exporterStats(Ownership::True);
+static Mutex s_statsLock;
+static ObjectQueue<FlowRecord> s_writerQueue(4096, Ownership::True);
+static UINT64 s_totalDropped = 0;
+static time_t s_lastDropReport = 0;
+static INT64 s_flowId = 1;
+static THREAD s_aggregatorThread = INVALID_THREAD_HANDLE;
+static THREAD s_writerThread = INVALID_THREAD_HANDLE;
+static CONDITION s_stopCondition = INVALID_CONDITION_HANDLE;
+
+/**
+ * Get statistics entry for given exporter. Must be called with statistics lock held.
+ */
+static ExporterStatistics *GetExporterStatistics(UINT32 exporter)
+{
+   ExporterStatistics *s = s_exporterStats.get(exporter);
+   if (s == NULL)
+   {
+      s = new ExporterStatistics;
+      memset(s, 0, sizeof(ExporterStatistics));
+      s_exporterStats.set(exporter, s);
+   }
+   return s;
+}
+
+/**
+ * Update received flows counter for exporter
+ */
+static void UpdateReceivedFlowsCounter(UINT32 exporter)
+{
+   s_statsLock.lock();
+   GetExporterStatistics(exporter)->flowsReceived++;
+   s_statsLock.unlock();
+}
+
+/**
+ * Put record into writer queue. Record is dropped if queue is full.
+ */
+static void EnqueueRecord(FlowRecord *record)
+{
+   if (s_writerQueue.size() < g_writerQueueSize)
+   {
+      s_writerQueue.put(record);
+      return;
+   }
+
+   s_statsLock.lock();
+   GetExporterStatistics(record->exporter)->recordsDropped++;
+   s_totalDropped++;
+   time_t now = time(NULL);
+   bool report = (now - s_lastDropReport >= STATISTICS_REPORT_INTERVAL);
+   if (report)
+      s_lastDropReport = now;
+   UINT64 totalDropped = s_totalDropped;
+   s_statsLock.unlock();
+
+   delete record;
+
+   if (report)
+      nxlog_write(NXLOG_WARNING, _T("Flow writer queue is full, records are dropped (") UINT64_FMT _T(" records dropped so far)"), totalDropped);
+}
+
+/**
+ * Build aggregation key for given flow record
+ */
+static inline void BuildFlowKey(const FlowRecord *flow, FlowKey *key)
+{
+   memset(key, 0, sizeof(FlowKey));
+   key->bucket = flow->endTime / (static_cast<INT64>(g_aggregationInterval) * 1000);
+   key->exporter = flow->exporter;
+   key->fields = flow->fields & s_keyFieldMask;
+   if (key->fields & FLOW_FIELD_EXPORTER_ADDR)
+      key->exporterAddr = flow->exporterAddr;
+   if (key->fields & FLOW_FIELD_SOURCE_MAC)
+      memcpy(key->sourceMac, flow->sourceMac, 6);
+   if (key->fields & FLOW_FIELD_DEST_MAC)
+      memcpy(key->destMac, flow->destMac, 6);
+   if (key->fields & FLOW_FIELD_SOURCE_ADDR)
+      key->sourceAddr = flow->sourceAddr;
+   if (key->fields & FLOW_FIELD_DEST_ADDR)
+      key->destAddr = flow->destAddr;
+   if (key->fields & FLOW_FIELD_PROTOCOL)
+      key->protocol = flow->protocol;
+   if (key->fields & FLOW_FIELD_SOURCE_PORT)
+      key->sourcePort = flow->sourcePort;
+   if (key->fields & FLOW_FIELD_DEST_PORT)
+      key->destPort = flow->destPort;
+   if (key->fields & FLOW_FIELD_INGRESS_IF)
+      key->ingressInterface = flow->ingressInterface;
+   if (key->fields & FLOW_FIELD_EGRESS_IF)
+      key->egressInterface = flow->egressInterface;
+}
+
+/**
+ * Create aggregated record from key and first flow
+ */
+static FlowRecord *CreateAggregatedRecord(const FlowKey& key, const FlowRecord *flow)
+{
+   FlowRecord *record = new FlowRecord;
+   memset(record, 0, sizeof(FlowRecord));
+   record->startTime = flow->startTime;
+   record->endTime = flow->endTime;
+   record->octetCount = flow->octetCount;
+   record->packetCount = flow->packetCount;
+   record->exporter = key.exporter;
+   record->exporterAddr = key.exporterAddr;
+   record->sourceAddr = key.sourceAddr;
+   record->destAddr = key.destAddr;
+   record->ingressInterface = key.ingressInterface;
+   record->egressInterface = key.egressInterface;
+   record->sourcePort = key.sourcePort;
+   record->destPort = key.destPort;
+   memcpy(record->sourceMac, key.sourceMac, 6);
+   memcpy(record->destMac, key.destMac, 6);
+   record->protocol = key.protocol;
+   record->fields = key.fields | (flow->fields & FLOW_COUNTER_FIELDS);
+   return record;
+}
+
+/**
+ * Move all aggregated records to writer queue
+ */
+static EnumerationCallbackResult EnqueueAggregatedRecord(const FlowKey& key, FlowRecord *record)
+{
+   EnqueueRecord(record);
+   return _CONTINUE;
+}
+
+/**
+ * Flush aggregated records
+ */
+static void FlushAggregates()
+{
+   s_aggregatorLock.lock();
+   HashMap<FlowKey, FlowRecord> *aggregates = s_aggregates;
+   s_aggregates = new HashMap<FlowKey, FlowRecord>(Ownership::False);
+   s_aggregatorLock.unlock();
+
+   int count = aggregates->size();
+   if (count > 0)
+   {
+      aggregates->forEach(EnqueueAggregatedRecord);
+      nxlog_debug(6, _T("%d aggregated flow records sent to writer"), count);
+   }
+   delete aggregates;
+}
+
+/**
+ * Process flow record received from exporter
+ */
+void ProcessFlowRecord(const FlowRecord *flow)
+{
+   UpdateReceivedFlowsCounter(flow->exporter);
+
+   if (g_aggregationInterval == 0)
+   {
+      FlowRecord *record = new FlowRecord;
+      memcpy(record, flow, sizeof(FlowRecord));
+      EnqueueRecord(record);
+      return;
+   }
+
+   FlowKey key;
+   BuildFlowKey(flow, &key);
+
+   bool flush = false;
+   s_aggregatorLock.lock();
+   FlowRecord *record = s_aggregates->get(key);
+   if (record != NULL)
+   {
+      if (flow->startTime < record->startTime)
+         record->startTime = flow->startTime;
+      if (flow->endTime > record->endTime)
+         record->endTime = flow->endTime;
+      record->octetCount += flow->octetCount;
+      record->packetCount += flow->packetCount;
+      record->fields |= flow->fields & FLOW_COUNTER_FIELDS;
+   }
+   else
+   {
+      s_aggregates->set(key, CreateAggregatedRecord(key, flow));
+      flush = (static_cast<UINT32>(s_aggregates->size()) >= g_aggregationMaxRecords);
+   }
+   s_aggregatorLock.unlock();
+
+   if (flush)
+   {
+      nxlog_debug(4, _T("Number of aggregated flow records reached limit, flushing before end of time bucket"));
+      FlushAggregates();
+   }
+}
+
+/**
+ * Report statistics for single exporter
+ */
+static EnumerationCallbackResult ReportExporterStatistics(const UINT32& exporter, ExporterStatistics *s)
+{
+   TCHAR addrText[64];
+   nxlog_debug(3, _T("Exporter %s: ") UINT64_FMT _T(" flows received, ") UINT64_FMT _T(" records written, ") UINT64_FMT _T(" records dropped"),
+            InetAddress(exporter).toString(addrText), s->flowsReceived, s->recordsWritten, s->recordsDropped);
+   return _CONTINUE;
+}
+
+/**
+ * Report statistics for all exporters
+ */
+static void ReportStatistics()
+{
+   nxlog_debug(3, _T("Flow writer queue size: %u"), static_cast<UINT32>(s_writerQueue.size()));
+   s_statsLock.lock();
+   s_exporterStats.forEach(ReportExporterStatistics);
+   s_statsLock.unlock();
+}
+
+/**
+ * Aggregator thread - flushes aggregated records at the end of each time bucket and reports statistics
+ */
+static THREAD_RESULT THREAD_CALL AggregatorThread(void *arg)
+{
+   nxlog_debug(1, _T("Flow aggregator thread started"));
+
+   INT64 currentBucket = (g_aggregationInterval > 0) ? time(NULL) / g_aggregationInterval : 0;
+   time_t lastReport = time(NULL);
+   while(!ConditionWait(s_stopCondition, 1000))
+   {
+      time_t now = time(NULL);
+      if (g_aggregationInterval > 0)
+      {
+         INT64 bucket = now / g_aggregationInterval;
+         if (bucket != currentBucket)
+         {
+            FlushAggregates();
+            currentBucket = bucket;
+         }
+      }
+
+      if (now - lastReport >= STATISTICS_REPORT_INTERVAL)
+      {
+         ReportStatistics();
+         lastReport = now;
+      }
+   }
+
+   if (g_aggregationInterval > 0)
+      FlushAggregates();
+
+   nxlog_debug(1, _T("Flow aggregator thread stopped"));
+   return THREAD_OK;
+}
+
+/**
+ * Append value for IPv4 address field
+ */
+static inline void AppendAddress(StringBuffer& query, const FlowRecord *r, UINT32 field, UINT32 addr)
+{
+   if (r->fields & field)
+      query.appendFormattedString(_T(",'%u.%u.%u.%u'"), addr >> 24, (addr >> 16) & 0xFF, (addr >> 8) & 0xFF, addr & 0xFF);
+   else
+      query.append(_T(",NULL"));
+}
+
+/**
+ * Append value for MAC address field (same format as used by IPFIX library for binary fields)
+ */
+static inline void AppendMacAddress(StringBuffer& query, const FlowRecord *r, UINT32 field, const BYTE *mac)
+{
+   if (r->fields & field)
+      query.appendFormattedString(_T(",'0x%02x%02x%02x%02x%02x%02x'"), mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+   else
+      query.append(_T(",NULL"));
+}
+
+/**
+ * Append value for integer field
+ */
+static inline void AppendInteger(StringBuffer& query, const FlowRecord *r, UINT32 field, UINT64 value)
+{
+   if (r->fields & field)
+      query.appendFormattedString(_T(",'") UINT64_FMT _T("'"), value);
+   else
+      query.append(_T(",NULL"));
+}
+
+/**
+ * Append row values for given record
+ */
+static void AppendRecordValues(StringBuffer& query, const FlowRecord *r)
+{
+   query.appendFormattedString(_T("(") INT64_FMT _T(",") INT64_FMT _T(",") INT64_FMT, s_flowId++, r->startTime, r->endTime);
+   AppendAddress(query, r, FLOW_FIELD_EXPORTER_ADDR, r->exporterAddr);
+   AppendMacAddress(query, r, FLOW_FIELD_SOURCE_MAC, r->sourceMac);
+   AppendMacAddress(query, r, FLOW_FIELD_DEST_MAC, r->destMac);
+   AppendAddress(query, r, FLOW_FIELD_SOURCE_ADDR, r->sourceAddr);
+   AppendAddress(query, r, FLOW_FIELD_DEST_ADDR, r->destAddr);
+   AppendInteger(query, r, FLOW_FIELD_PROTOCOL, r->protocol);
+   AppendInteger(query, r, FLOW_FIELD_SOURCE_PORT, r->sourcePort);
+   AppendInteger(query, r, FLOW_FIELD_DEST_PORT, r->destPort);
+   AppendInteger(query, r, FLOW_FIELD_OCTET_COUNT, r->octetCount);
+   AppendInteger(query, r, FLOW_FIELD_PACKET_COUNT, r->packetCount);
+   AppendInteger(query, r, FLOW_FIELD_INGRESS_IF, r->ingressInterface);
+   AppendInteger(query, r, FLOW_FIELD_EGRESS_IF, r->egressInterface);
+   query.append(_T(")"));
+}
+
+/**
+ * INSERT statement prefix
+ */
+static const TCHAR *s_insertPrefix = _T("INSERT INTO flows (flow_id,start_time,end_time,exporter_ip_addr,source_mac_addr,dest_mac_addr,")
+         _T("source_ip_addr,dest_ip_addr,ip_proto,source_ip_port,dest_ip_port,octet_count,packet_count,ingress_interface,egress_interface) VALUES ");
+
+/**
+ * Update writer statistics for single record
+ */
+static inline void UpdateWriterStatistics(const FlowRecord *record, bool written)
+{
+   ExporterStatistics *s = GetExporterStatistics(record->exporter);
+   if (written)
+   {
+      s->recordsWritten++;
+   }
+   else
+   {
+      s->recordsDropped++;
+      s_totalDropped++;
+   }
+}
+
+/**
+ * Write batch of records to database. Returns number of records successfully written.
+ */
+static int WriteBatch(ObjectArray<FlowRecord> *batch, bool multiRow)
+{
+   bool success = false;
+   if (DBBegin(g_dbConnection))
+   {
+      success = true;
+      StringBuffer query;
+      for(int i = 0; (i < batch->size()) && success; )
+      {
+         query = s_insertPrefix;
+         int rows = multiRow ? std::min(batch->size() - i, MAX_ROWS_PER_STATEMENT) : 1;
+         for(int j = 0; j < rows; j++, i++)
+         {
+            if (j > 0)
+               query.append(_T(","));
+            AppendRecordValues(query, batch->get(i));
+         }
+         success = DBQuery(g_dbConnection, query);
+      }
+
+      if (success)
+         success = DBCommit(g_dbConnection);
+      else
+         DBRollback(g_dbConnection);
+   }
+
+   if (success)
+   {
+      s_statsLock.lock();
+      for(int i = 0; i < batch->size(); i++)
+         UpdateWriterStatistics(batch->get(i), true);
+      s_statsLock.unlock();
+      return batch->size();
+   }
+
+   // Transaction failed, try to save records one by one so single bad record will not cause loss of entire batch
+   int written = 0;
+   StringBuffer query;
+   for(int i = 0; i < batch->size(); i++)
+   {
+      FlowRecord *record = batch->get(i);
+      query = s_insertPrefix;
+      AppendRecordValues(query, record);
+      bool recordWritten = DBQuery(g_dbConnection, query);
+      if (recordWritten)
+         written++;
+
+      s_statsLock.lock();
+      UpdateWriterStatistics(record, recordWritten);
+      s_statsLock.unlock();
+   }
+   return written;
+}
+
+/**
+ * Writer thread
+ */
+static THREAD_RESULT THREAD_CALL WriterThread(void *arg)
+{
+   nxlog_debug(1, _T("Flow writer thread started"));
+
+   int syntax = DBGetSyntax(g_dbConnection);
+   bool multiRow = (syntax == DB_SYNTAX_PGSQL) || (syntax == DB_SYNTAX_TSDB) || (syntax == DB_SYNTAX_MYSQL) ||
+            (syntax == DB_SYNTAX_SQLITE) || (syntax == DB_SYNTAX_MSSQL);
+
+   ObjectArray<FlowRecord> batch(g_writerBatchSize, 256, Ownership::True);
+   bool running = true;
+   while(running)
+   {
+      FlowRecord *record = s_writerQueue.getOrBlock();
+      if (record == INVALID_POINTER_VALUE)
+         break;
+
+      batch.add(record);
+      while(batch.size() < static_cast<int>(g_writerBatchSize))
+      {
+         record = s_writerQueue.get();
+         if (record == NULL)
+            break;
+         if (record == INVALID_POINTER_VALUE)
+         {
+            running = false;
+            break;
+         }
+         batch.add(record);
+      }
+
+      INT64 startTime = GetCurrentTimeMs();
+      int written = WriteBatch(&batch, multiRow);
+      nxlog_debug(7, _T("%d of %d flow records written in ") INT64_FMT _T(" ms"), written, batch.size(), GetCurrentTimeMs() - startTime);
+      batch.clear();
+   }
+
+   nxlog_debug(1, _T("Flow writer thread stopped"));
+   return THREAD_OK;
+}
+
+/**
+ * Parse aggregation key definition
+ */
+static void ParseAggregationKey()
+{
+   s_keyFieldMask = 0;
+
+   TCHAR *key = MemCopyString(g_aggregationKey);
+   TCHAR *curr = key;
+   while(curr != NULL)
+   {
+      TCHAR *next = _tcschr(curr, _T(','));
+      if (next != NULL)
+         *next++ = 0;
+      Trim(curr);
+      if (*curr != 0)
+      {
+         int i;
+         for(i = 0; s_keyFields[i].name != NULL; i++)
+         {
+            if (!_tcsicmp(curr, s_keyFields[i].name))
+            {
+               s_keyFieldMask |= s_keyFields[i].field;
+               break;
+            }
+         }
+         if (s_keyFields[i].name == NULL)
+            nxlog_write(NXLOG_WARNING, _T("Invalid field name \"%s\" in aggregation key"), curr);
+      }
+      curr = next;
+   }
+   MemFree(key);
+}
+
+/**
+ * Start flow writer
+ */
+bool StartFlowWriter()
+{
+   // Initialize flow ID
+   DB_RESULT hResult = DBSelect(g_dbConnection, _T("SELECT max(flow_id) FROM flows"));
+   if (hResult != NULL)
+   {
+      s_flowId = DBGetFieldInt64(hResult, 0, 0) + 1;
+      DBFreeResult(hResult);
+   }
+
+   if (g_writerBatchSize == 0)
+      g_writerBatchSize = 1;
+
+   if (g_aggregationInterval > 0)
+   {
+      ParseAggregationKey();
+      s_aggregates = new HashMap<FlowKey, FlowRecord>(Ownership::False);
+      nxlog_debug(1, _T("Flow aggregation enabled (interval %u seconds, key %s)"), g_aggregationInterval, g_aggregationKey);
+   }
+   else
+   {
+      nxlog_debug(1, _T("Flow aggregation disabled"));
+   }
+
+   s_stopCondition = ConditionCreate(true);
+   s_aggregatorThread = ThreadCreateEx(AggregatorThread, 0, NULL);
+   s_writerThread = ThreadCreateEx(WriterThread, 0, NULL);
+   return true;
+}
+
+/**
+ * Report final statistics for single exporter
+ */
+static EnumerationCallbackResult ReportFinalExporterStatistics(const UINT32& exporter, ExporterStatistics *s)
+{
+   TCHAR addrText[64];
+   nxlog_write(NXLOG_INFO, _T("Exporter %s: ") UINT64_FMT _T(" flows received, ") UINT64_FMT _T(" records written, ") UINT64_FMT _T(" records dropped"),
+            InetAddress(exporter).toString(addrText), s->flowsReceived, s->recordsWritten, s->recordsDropped);
+   return _CONTINUE;
+}
+
+/**
+ * Stop flow writer. Should be called after collector thread is stopped.
+ * All aggregated and queued records are written to database before return.
+ */
+void StopFlowWriter()
+{
+   ConditionSet(s_stopCondition);
+   ThreadJoin(s_aggregatorThread);
+
+   s_writerQueue.put(INVALID_POINTER_VALUE);
+   ThreadJoin(s_writerThread);
+
+   ConditionDestroy(s_stopCondition);
+   delete_and_null(s_aggregates);
+
+   s_statsLock.lock();
+   s_exporterStats.forEach(ReportFinalExporterStatistics);
+   s_statsLock.unlock();
+}
@@ -16,7 +16,6 @@ static int s_numTcpSockets = 0;
 static SOCKET *s_tcpSockets = NULL;
 static int s_numUdpSockets = 0;
 static SOCKET *s_udpSockets = NULL;
-static INT64 s_flowId = 1;
 
 
 //
@@ -69,36 +68,65 @@ static INT64 Int64FromData(void *data, int len)
 }
 
 
-//
-// Handler for data record
-//
+/**
+ * Get unsigned 64bit integer value from data field
+ */
+static UINT64 UInt64FromData(void *data, int len)
+{
+	UINT64 value;
 
-static struct
+	switch(len)
+	{
+		case 1:
+			value = *((BYTE *)data);
+			break;
+		case 2:
+			value = *((UINT16 *)data);
+			break;
+		case 4:
+			value = *((UINT32 *)data);
+			break;
+		case 8:
+			value = *((UINT64 *)data);
+			break;
+		default:
+			value = 0;
+			break;
+	}
+	return value;
+}
+
+/**
+ * Get IPv4 address (in host byte order) from data field
+ */
+static bool IPv4AddressFromData(void *data, int len, UINT32 *addr)
 {
-	int ipfixField;
-	const TCHAR *dbField;
-} s_fieldMapping[] =
+   if (len != 4)
+      return false;
+   UINT32 value;
+   memcpy(&value, data, 4);
+   *addr = ntohl(value);
+   return true;
+}
+
+/**
+ * Get address of exporter node
+ */
+static UINT32 GetExporterAddress(ipfixs_node_t *node)
 {
-	{ IPFIX_FT_EXPORTERIPV4ADDRESS, _T("exporter_ip_addr") },
-	{ IPFIX_FT_SOURCEMACADDRESS, _T("source_mac_addr") },
-	{ IPFIX_FT_DESTINATIONMACADDRESS, _T("dest_mac_addr") },
-	{ IPFIX_FT_SOURCEIPV4ADDRESS, _T("source_ip_addr") },
-	{ IPFIX_FT_DESTINATIONIPV4ADDRESS, _T("dest_ip_addr") },
-	{ IPFIX_FT_PROTOCOLIDENTIFIER, _T("ip_proto") },
-	{ IPFIX_FT_SOURCETRANSPORTPORT, _T("source_ip_port") },
-	{ IPFIX_FT_DESTINATIONTRANSPORTPORT, _T("dest_ip_port") },
-	{ IPFIX_FT_OCTETDELTACOUNT, _T("octet_count") },
-	{ IPFIX_FT_PACKETDELTACOUNT, _T("packet_count") },
-	{ IPFIX_FT_INGRESSINTERFACE, _T("ingress_interface") },
-	{ IPFIX_FT_EGRESSINTERFACE, _T("egress_interface") },
-	{ 0, NULL }
-};
+   if ((node->input == NULL) || (node->input->type != IPFIX_INPUT_IPCON) ||
+       (node->input->u.ipcon.addr == NULL) || (node->input->u.ipcon.addr->sa_family != AF_INET))
+      return 0;
+   return ntohl(reinterpret_cast<struct sockaddr_in*>(node->input->u.ipcon.addr)->sin_addr.s_addr);
+}
 
+/**
+ * Handler for data record. Record is decoded into binary form and passed to aggregator.
+ */
 static int H_DataRecord(ipfixs_node_t *node, ipfixt_node_t *trec, ipfix_datarecord_t *data, void *arg) 
 {
-	StringBuffer fields, values;
-	char buffer[256];
-	INT64 flowStartTime = 0, flowEndTime = 0;
+	FlowRecord flow;
+	memset(&flow, 0, sizeof(FlowRecord));
 
 	for(int i = 0; i < trec->ipfixt->nfields; i++)
 	{
@@ -107,74 +135,109 @@ static int H_DataRecord(ipfixs_node_t *node, ipfixt_node_t *trec, ipfix_datareco
 		{
 			case IPFIX_FT_FLOWSTARTSYSUPTIME:
 				if (node->boot_time != 0)
-					flowStartTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+					flow.startTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWENDSYSUPTIME:
 				if (node->boot_time != 0)
-					flowEndTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+					flow.endTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWSTARTSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
+				flow.startTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
 				break;
 			case IPFIX_FT_FLOWENDSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
+				flow.endTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
 				break;
 			case IPFIX_FT_FLOWSTARTMILLISECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]);
+				flow.startTime = Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWENDMILLISECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]);
+				flow.endTime = Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWSTARTMICROSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
+				flow.startTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
 				break;
 			case IPFIX_FT_FLOWENDMICROSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
+				flow.endTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
 				break;
 			case IPFIX_FT_FLOWSTARTNANOSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
+				flow.startTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
 				break;
 			case IPFIX_FT_FLOWENDNANOSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
+				flow.endTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
 				break;
 			case IPFIX_FT_FLOWSTARTDELTAMICROSECONDS:
 				if (node->export_time != 0)
-					flowStartTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+					flow.startTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
 				break;
 			case IPFIX_FT_FLOWENDDELTAMICROSECONDS:
 				if (node->export_time != 0)
-					flowEndTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+					flow.endTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
+				break;
+			case IPFIX_FT_EXPORTERIPV4ADDRESS:
+				if (IPv4AddressFromData(data->addrs[i], data->lens[i], &flow.exporterAddr))
+					flow.fields |= FLOW_FIELD_EXPORTER_ADDR;
+				break;
+			case IPFIX_FT_SOURCEIPV4ADDRESS:
+				if (IPv4AddressFromData(data->addrs[i], data->lens[i], &flow.sourceAddr))
+					flow.fields |= FLOW_FIELD_SOURCE_ADDR;
+				break;
+			case IPFIX_FT_DESTINATIONIPV4ADDRESS:
+				if (IPv4AddressFromData(data->addrs[i], data->lens[i], &flow.destAddr))
+					flow.fields |= FLOW_FIELD_DEST_ADDR;
+				break;
+			case IPFIX_FT_SOURCEMACADDRESS:
+				if (data->lens[i] == 6)
+				{
+					memcpy(flow.sourceMac, data->addrs[i], 6);
+					flow.fields |= FLOW_FIELD_SOURCE_MAC;
+				}
 				break;
-			default:
-				for(int j = 0; s_fieldMapping[j].dbField != NULL; j++)
+			case IPFIX_FT_DESTINATIONMACADDRESS:
+				if (data->lens[i] == 6)
 				{
-					if (ftype == s_fieldMapping[j].ipfixField)
-					{
-						fields += _T(",");
-						fields += s_fieldMapping[j].dbField;
-						trec->ipfixt->fields[i].elem->snprint(buffer, sizeof(buffer), data->addrs[i], data->lens[i]);
-						values.appendFormattedString(_T(",'%hs'"), buffer);
-						break;
-					}
+					memcpy(flow.destMac, data->addrs[i], 6);
+					flow.fields |= FLOW_FIELD_DEST_MAC;
 				}
 				break;
+			case IPFIX_FT_PROTOCOLIDENTIFIER:
+				flow.protocol = static_cast<BYTE>(UInt64FromData(data->addrs[i], data->lens[i]));
+				flow.fields |= FLOW_FIELD_PROTOCOL;
+				break;
+			case IPFIX_FT_SOURCETRANSPORTPORT:
+				flow.sourcePort = static_cast<UINT16>(UInt64FromData(data->addrs[i], data->lens[i]));
+				flow.fields |= FLOW_FIELD_SOURCE_PORT;
+				break;
+			case IPFIX_FT_DESTINATIONTRANSPORTPORT:
+				flow.destPort = static_cast<UINT16>(UInt64FromData(data->addrs[i], data->lens[i]));
+				flow.fields |= FLOW_FIELD_DEST_PORT;
+				break;
+			case IPFIX_FT_OCTETDELTACOUNT:
+				flow.octetCount = UInt64FromData(data->addrs[i], data->lens[i]);
+				flow.fields |= FLOW_FIELD_OCTET_COUNT;
+				break;
+			case IPFIX_FT_PACKETDELTACOUNT:
+				flow.packetCount = UInt64FromData(data->addrs[i], data->lens[i]);
+				flow.fields |= FLOW_FIELD_PACKET_COUNT;
+				break;
+			case IPFIX_FT_INGRESSINTERFACE:
+				flow.ingressInterface = static_cast<UINT32>(UInt64FromData(data->addrs[i], data->lens[i]));
+				flow.fields |= FLOW_FIELD_INGRESS_IF;
+				break;
+			case IPFIX_FT_EGRESSINTERFACE:
+				flow.egressInterface = static_cast<UINT32>(UInt64FromData(data->addrs[i], data->lens[i]));
+				flow.fields |= FLOW_FIELD_EGRESS_IF;
+				break;
 		}
 	}
 
-	if (!fields.isEmpty() && (flowStartTime != 0) && (flowEndTime != 0))
+	if ((flow.fields != 0) && (flow.startTime != 0) && (flow.endTime != 0))
 	{
-		StringBuffer query = _T("INSERT INTO flows (flow_id,start_time,end_time");
-		query += (const TCHAR *)fields;
-		query.appendFormattedString(_T(") VALUES (") INT64_FMT _T(",") INT64_FMT _T(",") INT64_FMT, s_flowId++, flowStartTime, flowEndTime);
-		query += (const TCHAR *)values;
-		query += _T(")");
-
-		DBQuery(g_dbConnection, query);
+		flow.exporter = GetExporterAddress(node);
+		ProcessFlowRecord(&flow);
 	}
 	return 0;
 }
 
-
 //
 // Close collectors
 //
@@ -215,14 +278,6 @@ static THREAD_RESULT THREAD_CALL CollectorThread(void *arg)
  */
 bool StartCollector()
 {
-	// Initialize flow ID
-	DB_RESULT hResult = DBSelect(g_dbConnection, _T("SELECT max(flow_id) FROM flows"));
-	if (hResult != NULL)
-	{
-		s_flowId = DBGetFieldInt64(hResult, 0, 0) + 1;
-		DBFreeResult(hResult);
-	}
-
 	s_collectorInfo = (ipfix_col_info_t *)malloc(sizeof(ipfix_col_info_t));
 	s_collectorInfo->export_newsource = NULL;
 	s_collectorInfo->export_newmsg = H_NewMessage;
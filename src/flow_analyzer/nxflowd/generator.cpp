@@ -0,0 +1,174 @@
+/*
+** nxflowd - NetXMS Flow Collector Daemon
+** Copyright (c) 2009-2020 Raden Solutions
+*/
+
+#include "nxflowd.h"
+
+/**
+ * Number of fields in generated records
+ */
+#define GENERATOR_FIELD_COUNT    12
+
+/**
+ * Fields of generated records
+ */
+static struct
+{
+   UINT16 type;
+   UINT16 length;
+} s_generatorFields[GENERATOR_FIELD_COUNT] =
+{
+   { IPFIX_FT_EXPORTERIPV4ADDRESS, 4 },
+   { IPFIX_FT_SOURCEIPV4ADDRESS, 4 },
+   { IPFIX_FT_DESTINATIONIPV4ADDRESS, 4 },
+   { IPFIX_FT_PROTOCOLIDENTIFIER, 1 },
+   { IPFIX_FT_SOURCETRANSPORTPORT, 2 },
+   { IPFIX_FT_DESTINATIONTRANSPORTPORT, 2 },
+   { IPFIX_FT_OCTETDELTACOUNT, 8 },
+   { IPFIX_FT_PACKETDELTACOUNT, 8 },
+   { IPFIX_FT_INGRESSINTERFACE, 4 },
+   { IPFIX_FT_EGRESSINTERFACE, 4 },
+   { IPFIX_FT_FLOWSTARTMILLISECONDS, 8 },
+   { IPFIX_FT_FLOWENDMILLISECONDS, 8 }
+};
+
+/**
+ * Destination ports used in generated flows
+ */
+static UINT16 s_destPorts[] = { 22, 25, 53, 80, 123, 443, 3306, 8080 };
+
+/**
+ * Synthetic exporter
+ */
+struct SyntheticExporter
+{
+   ipfix_t *handle;
+   ipfix_template_t *templ;
+   UINT32 address;
+};
+
+/**
+ * Send synthetic IPFIX flow records to given collector (host[:port]). Flows are distributed between
+ * given number of exporters (observation domains). Source and destination addresses and ports are
+ * selected from limited sets so generated traffic is suitable for aggregation tests.
+ * Returns 0 on success or non-zero exit code on failure.
+ */
+int RunFlowGenerator(const char *collector, int count, int exporters)
+{
+   char host[256];
+   strlcpy(host, collector, 256);
+   int port = IPFIX_DEFAULT_PORT;
+   char *p = strchr(host, ':');
+   if (p != NULL)
+   {
+      *p++ = 0;
+      port = strtol(p, NULL, 10);
+   }
+
+#ifdef _WIN32
+   WSADATA wsaData;
+   WSAStartup(2, &wsaData);
+#endif
+
+   if (ipfix_init() < 0)
+   {
+      _tprintf(_T("IPFIX library initialization failed\n"));
+      return 3;
+   }
+
+   if (exporters < 1)
+      exporters = 1;
+   SyntheticExporter *exporterList = MemAllocArray<SyntheticExporter>(exporters);
+   for(int i = 0; i < exporters; i++)
+   {
+      SyntheticExporter *e = &exporterList[i];
+      e->address = 0x0AFF0001 + i;  // 10.255.0.1 and up
+      if (ipfix_open(&e->handle, i + 1, IPFIX_VERSION) < 0)
+      {
+         _tprintf(_T("Cannot open IPFIX exporter\n"));
+         exporters = i;
+         goto failure;
+      }
+      if (ipfix_add_collector(e->handle, host, port, IPFIX_PROTO_TCP) < 0)
+      {
+         _tprintf(_T("Cannot connect to collector %hs:%d\n"), host, port);
+         ipfix_close(e->handle);
+         exporters = i;
+         goto failure;
+      }
+      if (ipfix_new_data_template(e->handle, &e->templ, GENERATOR_FIELD_COUNT) < 0)
+      {
+         _tprintf(_T("Cannot create IPFIX template\n"));
+         ipfix_close(e->handle);
+         exporters = i;
+         goto failure;
+      }
+      for(int j = 0; j < GENERATOR_FIELD_COUNT; j++)
+         ipfix_add_field(e->handle, e->templ, 0, s_generatorFields[j].type, s_generatorFields[j].length);
+   }
+
+   {
+      INT64 startTime = GetCurrentTimeMs();
+      srand(static_cast<unsigned int>(startTime));
+
+      UINT32 exporterAddr, sourceAddr, destAddr, ingressInterface, egressInterface;
+      UINT16 sourcePort, destPort;
+      UINT64 octets, packets, flowStart, flowEnd;
+      BYTE protocol;
+      void *fields[GENERATOR_FIELD_COUNT] = { &exporterAddr, &sourceAddr, &destAddr, &protocol, &sourcePort, &destPort,
+               &octets, &packets, &ingressInterface, &egressInterface, &flowStart, &flowEnd };
+      UINT16 lengths[GENERATOR_FIELD_COUNT];
+      for(int j = 0; j < GENERATOR_FIELD_COUNT; j++)
+         lengths[j] = s_generatorFields[j].length;
+
+      for(int i = 0; i < count; i++)
+      {
+         SyntheticExporter *e = &exporterList[i % exporters];
+         exporterAddr = htonl(e->address);
+         sourceAddr = htonl(0x0A000000 | (rand() % 256));        // 10.0.0.0/24
+         destAddr = htonl(0xC0A80000 | (rand() % 64));           // 192.168.0.0/26
+         destPort = s_destPorts[rand() % (sizeof(s_destPorts) / sizeof(UINT16))];
+         protocol = (destPort == 53 || destPort == 123) ? 17 : 6;
+         sourcePort = 1024 + rand() % 64512;
+         packets = 1 + rand() % 100;
+         octets = packets * (64 + rand() % 1400);
+         ingressInterface = 1 + rand() % 4;
+         egressInterface = 5 + rand() % 4;
+         flowEnd = GetCurrentTimeMs();
+         flowStart = flowEnd - rand() % 60000;
+
+         if (ipfix_export_array(e->handle, e->templ, GENERATOR_FIELD_COUNT, fields, lengths) < 0)
+         {
+            _tprintf(_T("IPFIX export failed\n"));
+            break;
+         }
+      }
+
+      for(int i = 0; i < exporters; i++)
+         ipfix_export_flush(exporterList[i].handle);
+
+      INT64 elapsed = GetCurrentTimeMs() - startTime;
+      _tprintf(_T("%d flow records sent by %d exporters in ") INT64_FMT _T(" ms (%d flows/sec)\n"),
+               count, exporters, elapsed, (elapsed > 0) ? static_cast<int>(static_cast<INT64>(count) * 1000 / elapsed) : count);
+   }
+
+   for(int i = 0; i < exporters; i++)
+   {
+      ipfix_delete_template(exporterList[i].handle, exporterList[i].templ);
+      ipfix_close(exporterList[i].handle);
+   }
+   MemFree(exporterList);
+   ipfix_cleanup();
+   return 0;
+
+failure:
+   for(int i = 0; i < exporters; i++)
+   {
+      ipfix_delete_template(exporterList[i].handle, exporterList[i].templ);
+      ipfix_close(exporterList[i].handle);
+   }
+   MemFree(exporterList);
+   ipfix_cleanup();
+   return 3;
+}
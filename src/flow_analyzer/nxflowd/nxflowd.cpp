@@ -36,6 +36,11 @@ DWORD g_tcpPort = IPFIX_DEFAULT_PORT;
 DWORD g_udpPort = IPFIX_DEFAULT_PORT;
 DB_DRIVER g_dbDriverHandle = NULL;
 DB_HANDLE g_dbConnection = NULL;
+UINT32 g_aggregationInterval = 0;
+TCHAR g_aggregationKey[MAX_CONFIG_VALUE] = DEFAULT_AGGREGATION_KEY;
+UINT32 g_aggregationMaxRecords = 1000000;
+UINT32 g_writerBatchSize = 1000;
+UINT32 g_writerQueueSize = 100000;
 #ifdef _WIN32
 TCHAR g_configFile[MAX_PATH] = _T("C:\\nxflowd.conf");
 TCHAR g_logFile[MAX_PATH] = _T("C:\\nxflowd.log");
@@ -63,6 +68,9 @@ static TCHAR s_dbLogin[MAX_DB_LOGIN] = _T("netxms");
 static TCHAR s_dbPassword[MAX_PASSWORD] = _T("");
 static NX_CFG_TEMPLATE m_cfgTemplate[] =
 {
+   { _T("AggregationInterval"), CT_LONG, 0, 0, 0, 0, &g_aggregationInterval },
+   { _T("AggregationKey"), CT_STRING, 0, 0, MAX_CONFIG_VALUE, 0, g_aggregationKey },
+   { _T("AggregationMaxRecords"), CT_LONG, 0, 0, 0, 0, &g_aggregationMaxRecords },
    { _T("DBDriver"), CT_STRING, 0, 0, MAX_PATH, 0, s_dbDriver },
    { _T("DBDrvParams"), CT_STRING, 0, 0, MAX_PATH, 0, s_dbDrvParams },
    { _T("DBLogin"), CT_STRING, 0, 0, MAX_DB_LOGIN, 0, s_dbLogin },
@@ -77,6 +85,8 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("LogFile"), CT_STRING, 0, 0, MAX_PATH, 0, g_logFile },
    { _T("LogFailedSQLQueries"), CT_BOOLEAN, 0, 0, AF_LOG_SQL_ERRORS, 0, &g_flags },
    { _T("LogFile"), CT_STRING, 0, 0, MAX_PATH, 0, g_logFile },
+   { _T("WriterBatchSize"), CT_LONG, 0, 0, 0, 0, &g_writerBatchSize },
+   { _T("WriterQueueSize"), CT_LONG, 0, 0, 0, 0, &g_writerQueueSize },
    { _T(""), CT_END_OF_LIST, 0, 0, 0, 0, NULL }
 };
 
@@ -161,6 +171,9 @@ bool Initialize()
 	}
 	nxlog_debug(1, _T("Successfully connected to database %s@%s"), s_dbName, s_dbServer);
 
+	if (!StartFlowWriter())
+		return false;
+
 	if (!StartCollector())
 		return false;
 
@@ -176,6 +189,7 @@ void Shutdown()
    g_flags |= AF_SHUTDOWN;
 
 	WaitForCollectorThread();
+	StopFlowWriter();
 
 	ipfix_cleanup();
    nxlog_close();
@@ -235,7 +249,10 @@ static TCHAR s_helpText[] =
    _T("   -c <file>  : Read configuration from given file\n")
    _T("   -d         : Start as daemon (service)\n")
 	_T("   -D <level> : Set debug level (0..9)\n")
+   _T("   -e <count> : Number of synthetic exporters for generator (default 4)\n")
+   _T("   -G <addr>  : Send synthetic IPFIX flows to collector at given address (host[:port]) and exit\n")
    _T("   -h         : Show this help\n")
+   _T("   -n <count> : Number of flows to be sent by generator (default 100000)\n")
 #ifdef _WIN32
    _T("   -I         : Install service\n")
    _T("   -R         : Remove service\n")
@@ -252,9 +269,9 @@ static TCHAR s_helpText[] =
 //
 
 #ifdef _WIN32
-#define VALID_OPTIONS    "c:dD:hIRsS"
+#define VALID_OPTIONS    "c:dD:e:G:hIn:RsS"
 #else
-#define VALID_OPTIONS    "c:dD:hp:"
+#define VALID_OPTIONS    "c:dD:e:G:hn:p:"
 #endif
 
 
@@ -265,6 +282,8 @@ static TCHAR s_helpText[] =
 int main(int argc, char *argv[])
 {
 	int ch, action = 0;
+	const char *generatorTarget = NULL;
+	int generatorFlows = 100000, generatorExporters = 4;
 #ifdef _WIN32
 	TCHAR moduleName[MAX_PATH];
 #endif
@@ -286,6 +305,16 @@ int main(int argc, char *argv[])
 			case 'D':   // Debug
 				g_debugLevel = strtol(optarg, NULL, 0);
 				break;
+			case 'e':   // Number of synthetic exporters
+				generatorExporters = strtol(optarg, NULL, 0);
+				break;
+			case 'G':   // Run flow generator
+				generatorTarget = optarg;
+				action = 5;
+				break;
+			case 'n':   // Number of synthetic flows
+				generatorFlows = strtol(optarg, NULL, 0);
+				break;
 			case 'c':
 #ifdef UNICODE
 				MultiByteToWideChar(CP_ACP, MB_PRECOMPOSED, optarg, -1, g_configFile, MAX_PATH);
@@ -399,6 +428,8 @@ int main(int argc, char *argv[])
 			StopFlowCollectorService();
 			break;
 #endif
+		case 5:
+			return RunFlowGenerator(generatorTarget, generatorFlows, generatorExporters);
 		default:
 			break;
 	}
@@ -9,6 +9,7 @@
 #include <nms_common.h>
 #include <nms_util.h>
 #include <nms_threads.h>
+#include <nxqueue.h>
 #include <nxdbapi.h>
 #include <ipfix.h>
 #include <ipfix_col.h>
@@ -28,6 +29,8 @@
 
 #define IPFIX_DEFAULT_PORT       4739
 
+#define DEFAULT_AGGREGATION_KEY  _T("exporter_ip_addr,source_ip_addr,dest_ip_addr,ip_proto,source_ip_port,dest_ip_port,ingress_interface,egress_interface")
+
 
 //
 // Application flags
@@ -40,6 +43,47 @@
 #define AF_SHUTDOWN        0x01000000
 
 
+/**
+ * Flow record fields
+ */
+#define FLOW_FIELD_EXPORTER_ADDR    0x0001
+#define FLOW_FIELD_SOURCE_MAC       0x0002
+#define FLOW_FIELD_DEST_MAC         0x0004
+#define FLOW_FIELD_SOURCE_ADDR      0x0008
+#define FLOW_FIELD_DEST_ADDR        0x0010
+#define FLOW_FIELD_PROTOCOL         0x0020
+#define FLOW_FIELD_SOURCE_PORT      0x0040
+#define FLOW_FIELD_DEST_PORT        0x0080
+#define FLOW_FIELD_OCTET_COUNT      0x0100
+#define FLOW_FIELD_PACKET_COUNT     0x0200
+#define FLOW_FIELD_INGRESS_IF       0x0400
+#define FLOW_FIELD_EGRESS_IF        0x0800
+
+#define FLOW_COUNTER_FIELDS         (FLOW_FIELD_OCTET_COUNT | FLOW_FIELD_PACKET_COUNT)
+
+/**
+ * Decoded flow record
+ */
+struct FlowRecord
+{
+   INT64 startTime;        // Flow start time in milliseconds since epoch
+   INT64 endTime;          // Flow end time in milliseconds since epoch
+   UINT64 octetCount;
+   UINT64 packetCount;
+   UINT32 exporter;        // Address flow was received from (used for statistics only)
+   UINT32 exporterAddr;
+   UINT32 sourceAddr;
+   UINT32 destAddr;
+   UINT32 ingressInterface;
+   UINT32 egressInterface;
+   UINT16 sourcePort;
+   UINT16 destPort;
+   BYTE sourceMac[6];
+   BYTE destMac[6];
+   BYTE protocol;
+   UINT32 fields;          // Set of FLOW_FIELD_xxx flags for fields present in record
+};
+
 //
 // Functions
 //
@@ -51,6 +95,12 @@ void Main();
 bool StartCollector();
 void WaitForCollectorThread();
 
+bool StartFlowWriter();
+void StopFlowWriter();
+void ProcessFlowRecord(const FlowRecord *flow);
+
+int RunFlowGenerator(const char *collector, int count, int exporters);
+
 #ifdef _WIN32
 void InitService();
 void InstallFlowCollectorService(const TCHAR *pszExecName);
@@ -75,5 +125,10 @@ extern TCHAR g_configFile[];
 extern TCHAR g_logFile[];
 extern int g_debugLevel;
 extern DB_HANDLE g_dbConnection;
+extern UINT32 g_aggregationInterval;
+extern TCHAR g_aggregationKey[];
+extern UINT32 g_aggregationMaxRecords;
+extern UINT32 g_writerBatchSize;
+extern UINT32 g_writerQueueSize;
 
 #endif
@@ -1151,6 +1151,9 @@
    public static final long VID_USE_TEXT_PARSING = 709;
    public static final long VID_SYSLOG_PROXY = 710;
    public static final long VID_CIP_VENDOR_CODE = 711;   
+   public static final long VID_BULK_DATA_PUSH = 712;
+   public static final long VID_TARGET_POINT_COUNT = 713;
+   public static final long VID_DOWNSAMPLING_METHOD = 714;
 
 	public static final long VID_ACL_USER_BASE = 0x00001000L;
 	public static final long VID_ACL_USER_LAST = 0x00001FFFL;
@@ -61,6 +61,8 @@ public boolean isWordStart(char c)
       "DataDirectory",  //$NON-NLS-1$
       "DataReconciliationBlockSize",  //$NON-NLS-1$
       "DataReconciliationTimeout",  //$NON-NLS-1$
+      "DataSenderBatchSize",  //$NON-NLS-1$
+      "DataSenderWindowSize",  //$NON-NLS-1$
       "DailyLogFileSuffix",  //$NON-NLS-1$
       "DebugLevel",  //$NON-NLS-1$
       "DisableIPv4",  //$NON-NLS-1$
@@ -90,6 +92,10 @@ public boolean isWordStart(char c)
 		"MasterServers", //$NON-NLS-1$
 		"MaxLogSize", //$NON-NLS-1$
 		"MaxSessions", //$NON-NLS-1$
+      "OfflineDataCompression", //$NON-NLS-1$
+      "OfflineDataExpirationTime", //$NON-NLS-1$
+      "OfflineDataSegmentSize", //$NON-NLS-1$
+      "OfflineDataStorage", //$NON-NLS-1$
 		"PlatformSuffix", //$NON-NLS-1$
 		"RequireAuthentication", //$NON-NLS-1$
 		"RequireEncryption", //$NON-NLS-1$
@@ -157,8 +157,14 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.DBWriter.Requests.IData", "DB writer requests (DCI data)", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DBWriter.Requests.Other", "DB writer requests (other queries)", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DBWriter.Requests.RawData", "DB writer requests (raw DCI data)", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.EventLogWriter.AverageWriteTime", "Event log writer: average batch write time", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.EventLogWriter.EventsWritten", "Event log writer: total number of written events", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.EventLogWriter.MaxQueueSize", "Event log writer: maximum queue size", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.EventLogWriter.Transactions", "Event log writer: total number of transactions", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.EventProcessor.AverageWaitTime(*)", "Event processor {instance}: average event wait time", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.EventProcessor.BindingAssignments(*)", "Event processor {instance}: total number of binding assignments", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.EventProcessor.Bindings(*)", "Event processor {instance}: active bindings", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.EventProcessor.DispatchedEvents(*)", "Event processor {instance}: total number of dispatched events", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.EventProcessor.ProcessedEvents(*)", "Event processor {instance}: total number of processed events", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.EventProcessor.QueueSize(*)", "Event processor {instance}: queue size", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.Heap.Active", "Active server heap memory", DataType.UINT64)); //$NON-NLS-1$
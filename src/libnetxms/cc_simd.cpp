@@ -0,0 +1,480 @@
+/*
+ ** NetXMS - Network Management System
+ ** Copyright (C) 2003-2020 Raden Solutions
+ **
+ ** This program is free software; you can redistribute it and/or modify
+ ** it under the terms of the GNU Lesser General Public License as published
+ ** by the Free Software Foundation; either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU Lesser General Public License
+ ** along with this program; if not, write to the Free Software
+ ** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ **
+ ** File: cc_simd.cpp
+ **
+ **/
+
+#include "libnetxms.h"
+#include "unicode_cc.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define HAVE_SSE2_INTRINSICS 1
+#include <emmintrin.h>
+#endif
+
+#if HAVE_SSE2_INTRINSICS && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define HAVE_AVX2_INTRINSICS 1
+#include <immintrin.h>
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+
+/**
+ * Instruction set levels
+ */
+#define SIMD_LEVEL_NONE    0
+#define SIMD_LEVEL_SSE2    1
+#define SIMD_LEVEL_AVX2    2
+
+/**
+ * Detected instruction set level (-1 if detection was not done yet)
+ */
+static int s_simdLevel = -1;
+
+/**
+ * Detect best instruction set supported by CPU
+ */
+static int DetectSIMDLevel()
+{
+#if HAVE_AVX2_INTRINSICS
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+      return SIMD_LEVEL_AVX2;
+#endif
+#if HAVE_SSE2_INTRINSICS
+   return SIMD_LEVEL_SSE2;
+#else
+   return SIMD_LEVEL_NONE;
+#endif
+}
+
+/**
+ * Get instruction set level to use
+ */
+static inline int GetSIMDLevel()
+{
+   int level = s_simdLevel;
+   if (level < 0)
+   {
+      level = DetectSIMDLevel();
+      s_simdLevel = level;
+   }
+   return level;
+}
+
+/**
+ * Override instruction set level (for testing). Negative value will restore
+ * automatic detection. Returns level actually set.
+ */
+int LIBNETXMS_EXPORTABLE SetUnicodeConversionSIMDLevel(int level)
+{
+   int maxLevel = DetectSIMDLevel();
+   s_simdLevel = ((level < 0) || (level > maxLevel)) ? maxLevel : level;
+   return s_simdLevel;
+}
+
+/**
+ * Scalar implementations
+ */
+static inline size_t CopyASCIIToUCS4_Scalar(const BYTE *src, size_t len, UCS4CHAR *dst)
+{
+   size_t i = 0;
+   for(; (i < len) && (src[i] < 0x80); i++)
+      dst[i] = src[i];
+   return i;
+}
+
+static inline size_t CopyASCIIToUCS2_Scalar(const BYTE *src, size_t len, UCS2CHAR *dst)
+{
+   size_t i = 0;
+   for(; (i < len) && (src[i] < 0x80); i++)
+      dst[i] = src[i];
+   return i;
+}
+
+static inline size_t CopyUCS4ToASCII_Scalar(const UCS4CHAR *src, size_t len, char *dst)
+{
+   size_t i = 0;
+   for(; (i < len) && (src[i] < 0x80); i++)
+      dst[i] = static_cast<char>(src[i]);
+   return i;
+}
+
+static inline size_t CopyUCS2ToUCS4_Scalar(const UCS2CHAR *src, size_t len, UCS4CHAR *dst)
+{
+   size_t i = 0;
+   for(; (i < len) && ((src[i] & 0xF800) != 0xD800); i++)
+      dst[i] = src[i];
+   return i;
+}
+
+static inline size_t CountASCII_Scalar(const BYTE *src, size_t len)
+{
+   size_t i = 0;
+   while((i < len) && (src[i] < 0x80))
+      i++;
+   return i;
+}
+
+static inline size_t CountUCS4ASCII_Scalar(const UCS4CHAR *src, size_t len)
+{
+   size_t i = 0;
+   while((i < len) && (src[i] < 0x80))
+      i++;
+   return i;
+}
+
+static inline size_t CountUCS4BMP_Scalar(const UCS4CHAR *src, size_t len)
+{
+   size_t i = 0;
+   while((i < len) && (src[i] <= 0xFFFF))
+      i++;
+   return i;
+}
+
+static inline void SwapBytes16_Scalar(UINT16 *v, size_t len)
+{
+   for(size_t i = 0; i < len; i++)
+      v[i] = bswap_16(v[i]);
+}
+
+#if HAVE_SSE2_INTRINSICS
+
+/**
+ * SSE2 implementations (16 bytes per iteration)
+ */
+static size_t CopyASCIIToUCS4_SSE2(const BYTE *src, size_t len, UCS4CHAR *dst)
+{
+   const __m128i zero = _mm_setzero_si128();
+   size_t i = 0;
+   for(; i + 16 <= len; i += 16)
+   {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      if (_mm_movemask_epi8(v) != 0)
+         break;
+      __m128i lo = _mm_unpacklo_epi8(v, zero);
+      __m128i hi = _mm_unpackhi_epi8(v, zero);
+      __m128i *d = reinterpret_cast<__m128i*>(dst + i);
+      _mm_storeu_si128(d, _mm_unpacklo_epi16(lo, zero));
+      _mm_storeu_si128(d + 1, _mm_unpackhi_epi16(lo, zero));
+      _mm_storeu_si128(d + 2, _mm_unpacklo_epi16(hi, zero));
+      _mm_storeu_si128(d + 3, _mm_unpackhi_epi16(hi, zero));
+   }
+   return i + CopyASCIIToUCS4_Scalar(src + i, len - i, dst + i);
+}
+
+static size_t CopyASCIIToUCS2_SSE2(const BYTE *src, size_t len, UCS2CHAR *dst)
+{
+   const __m128i zero = _mm_setzero_si128();
+   size_t i = 0;
+   for(; i + 16 <= len; i += 16)
+   {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      if (_mm_movemask_epi8(v) != 0)
+         break;
+      __m128i *d = reinterpret_cast<__m128i*>(dst + i);
+      _mm_storeu_si128(d, _mm_unpacklo_epi8(v, zero));
+      _mm_storeu_si128(d + 1, _mm_unpackhi_epi8(v, zero));
+   }
+   return i + CopyASCIIToUCS2_Scalar(src + i, len - i, dst + i);
+}
+
+static size_t CopyUCS4ToASCII_SSE2(const UCS4CHAR *src, size_t len, char *dst)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i mask = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+   size_t i = 0;
+   for(; i + 16 <= len; i += 16)
+   {
+      const __m128i *s = reinterpret_cast<const __m128i*>(src + i);
+      __m128i a = _mm_loadu_si128(s);
+      __m128i b = _mm_loadu_si128(s + 1);
+      __m128i c = _mm_loadu_si128(s + 2);
+      __m128i d = _mm_loadu_si128(s + 3);
+      __m128i all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, mask), zero)) != 0xFFFF)
+         break;
+      __m128i v = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+   }
+   return i + CopyUCS4ToASCII_Scalar(src + i, len - i, dst + i);
+}
+
+static size_t CopyUCS2ToUCS4_SSE2(const UCS2CHAR *src, size_t len, UCS4CHAR *dst)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i mask = _mm_set1_epi16(static_cast<short>(0xF800));
+   const __m128i surrogate = _mm_set1_epi16(static_cast<short>(0xD800));
+   size_t i = 0;
+   for(; i + 8 <= len; i += 8)
+   {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, mask), surrogate)) != 0)
+         break;
+      __m128i *d = reinterpret_cast<__m128i*>(dst + i);
+      _mm_storeu_si128(d, _mm_unpacklo_epi16(v, zero));
+      _mm_storeu_si128(d + 1, _mm_unpackhi_epi16(v, zero));
+   }
+   return i + CopyUCS2ToUCS4_Scalar(src + i, len - i, dst + i);
+}
+
+static size_t CountASCII_SSE2(const BYTE *src, size_t len)
+{
+   size_t i = 0;
+   for(; i + 16 <= len; i += 16)
+   {
+      if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))) != 0)
+         break;
+   }
+   return i + CountASCII_Scalar(src + i, len - i);
+}
+
+static size_t CountUCS4ASCII_SSE2(const UCS4CHAR *src, size_t len)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i mask = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+   size_t i = 0;
+   for(; i + 8 <= len; i += 8)
+   {
+      const __m128i *s = reinterpret_cast<const __m128i*>(src + i);
+      __m128i all = _mm_or_si128(_mm_loadu_si128(s), _mm_loadu_si128(s + 1));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, mask), zero)) != 0xFFFF)
+         break;
+   }
+   return i + CountUCS4ASCII_Scalar(src + i, len - i);
+}
+
+static size_t CountUCS4BMP_SSE2(const UCS4CHAR *src, size_t len)
+{
+   const __m128i zero = _mm_setzero_si128();
+   size_t i = 0;
+   for(; i + 8 <= len; i += 8)
+   {
+      const __m128i *s = reinterpret_cast<const __m128i*>(src + i);
+      __m128i all = _mm_or_si128(_mm_loadu_si128(s), _mm_loadu_si128(s + 1));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(all, 16), zero)) != 0xFFFF)
+         break;
+   }
+   return i + CountUCS4BMP_Scalar(src + i, len - i);
+}
+
+static void SwapBytes16_SSE2(UINT16 *v, size_t len)
+{
+   size_t i = 0;
+   for(; i + 8 <= len; i += 8)
+   {
+      __m128i *p = reinterpret_cast<__m128i*>(v + i);
+      __m128i x = _mm_loadu_si128(p);
+      _mm_storeu_si128(p, _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8)));
+   }
+   SwapBytes16_Scalar(v + i, len - i);
+}
+
+#endif   /* HAVE_SSE2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+
+/**
+ * AVX2 implementations (32 bytes per iteration)
+ */
+static AVX2_FUNCTION size_t CopyASCIIToUCS4_AVX2(const BYTE *src, size_t len, UCS4CHAR *dst)
+{
+   size_t i = 0;
+   for(; i + 32 <= len; i += 32)
+   {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+      if (_mm256_movemask_epi8(v) != 0)
+         break;
+      __m256i *d = reinterpret_cast<__m256i*>(dst + i);
+      _mm256_storeu_si256(d, _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i))));
+      _mm256_storeu_si256(d + 1, _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + 8))));
+      _mm256_storeu_si256(d + 2, _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + 16))));
+      _mm256_storeu_si256(d + 3, _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + 24))));
+   }
+   return i + CopyASCIIToUCS4_SSE2(src + i, len - i, dst + i);
+}
+
+static AVX2_FUNCTION size_t CopyASCIIToUCS2_AVX2(const BYTE *src, size_t len, UCS2CHAR *dst)
+{
+   size_t i = 0;
+   for(; i + 32 <= len; i += 32)
+   {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+      if (_mm256_movemask_epi8(v) != 0)
+         break;
+      __m256i *d = reinterpret_cast<__m256i*>(dst + i);
+      _mm256_storeu_si256(d, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)));
+      _mm256_storeu_si256(d + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)));
+   }
+   return i + CopyASCIIToUCS2_SSE2(src + i, len - i, dst + i);
+}
+
+static AVX2_FUNCTION size_t CopyUCS4ToASCII_AVX2(const UCS4CHAR *src, size_t len, char *dst)
+{
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i mask = _mm256_set1_epi32(static_cast<int>(0xFFFFFF80));
+   const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+   size_t i = 0;
+   for(; i + 32 <= len; i += 32)
+   {
+      const __m256i *s = reinterpret_cast<const __m256i*>(src + i);
+      __m256i a = _mm256_loadu_si256(s);
+      __m256i b = _mm256_loadu_si256(s + 1);
+      __m256i c = _mm256_loadu_si256(s + 2);
+      __m256i d = _mm256_loadu_si256(s + 3);
+      __m256i all = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+      if (!_mm256_testz_si256(all, mask))
+         break;
+      // Pack operations work within 128 bit lanes, so result should be reordered
+      __m256i v = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permutevar8x32_epi32(v, order));
+   }
+   return i + CopyUCS4ToASCII_SSE2(src + i, len - i, dst + i);
+}
+
+static AVX2_FUNCTION size_t CopyUCS2ToUCS4_AVX2(const UCS2CHAR *src, size_t len, UCS4CHAR *dst)
+{
+   const __m256i mask = _mm256_set1_epi16(static_cast<short>(0xF800));
+   const __m256i surrogate = _mm256_set1_epi16(static_cast<short>(0xD800));
+   size_t i = 0;
+   for(; i + 16 <= len; i += 16)
+   {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+      if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(v, mask), surrogate)) != 0)
+         break;
+      __m256i *d = reinterpret_cast<__m256i*>(dst + i);
+      _mm256_storeu_si256(d, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)));
+      _mm256_storeu_si256(d + 1, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)));
+   }
+   return i + CopyUCS2ToUCS4_SSE2(src + i, len - i, dst + i);
+}
+
+static AVX2_FUNCTION size_t CountASCII_AVX2(const BYTE *src, size_t len)
+{
+   size_t i = 0;
+   for(; i + 32 <= len; i += 32)
+   {
+      if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))) != 0)
+         break;
+   }
+   return i + CountASCII_SSE2(src + i, len - i);
+}
+
+static AVX2_FUNCTION void SwapBytes16_AVX2(UINT16 *v, size_t len)
+{
+   size_t i = 0;
+   for(; i + 16 <= len; i += 16)
+   {
+      __m256i *p = reinterpret_cast<__m256i*>(v + i);
+      __m256i x = _mm256_loadu_si256(p);
+      _mm256_storeu_si256(p, _mm256_or_si256(_mm256_slli_epi16(x, 8), _mm256_srli_epi16(x, 8)));
+   }
+   SwapBytes16_SSE2(v + i, len - i);
+}
+
+#endif   /* HAVE_AVX2_INTRINSICS */
+
+#if HAVE_AVX2_INTRINSICS
+#define DISPATCH(func, ...) \
+   switch(GetSIMDLevel()) \
+   { \
+      case SIMD_LEVEL_AVX2: return func##_AVX2(__VA_ARGS__); \
+      case SIMD_LEVEL_SSE2: return func##_SSE2(__VA_ARGS__); \
+      default: return func##_Scalar(__VA_ARGS__); \
+   }
+#define DISPATCH_SSE2(func, ...) \
+   if (GetSIMDLevel() >= SIMD_LEVEL_SSE2) return func##_SSE2(__VA_ARGS__); \
+   return func##_Scalar(__VA_ARGS__);
+#elif HAVE_SSE2_INTRINSICS
+#define DISPATCH(func, ...) \
+   if (GetSIMDLevel() >= SIMD_LEVEL_SSE2) return func##_SSE2(__VA_ARGS__); \
+   return func##_Scalar(__VA_ARGS__);
+#define DISPATCH_SSE2 DISPATCH
+#else
+#define DISPATCH(func, ...) return func##_Scalar(__VA_ARGS__);
+#define DISPATCH_SSE2 DISPATCH
+#endif
+
+/**
+ * Copy leading ASCII characters from UTF-8 string to UCS-4 string.
+ * Returns number of copied characters.
+ */
+size_t CopyASCIIToUCS4(const BYTE *src, size_t len, UCS4CHAR *dst)
+{
+   DISPATCH(CopyASCIIToUCS4, src, len, dst)
+}
+
+/**
+ * Copy leading ASCII characters from UTF-8 string to UCS-2 string.
+ * Returns number of copied characters.
+ */
+size_t CopyASCIIToUCS2(const BYTE *src, size_t len, UCS2CHAR *dst)
+{
+   DISPATCH(CopyASCIIToUCS2, src, len, dst)
+}
+
+/**
+ * Copy leading ASCII characters from UCS-4 string to UTF-8 string.
+ * Returns number of copied characters.
+ */
+size_t CopyUCS4ToASCII(const UCS4CHAR *src, size_t len, char *dst)
+{
+   DISPATCH(CopyUCS4ToASCII, src, len, dst)
+}
+
+/**
+ * Copy leading characters which are not surrogates from UCS-2 string to UCS-4 string.
+ * Returns number of copied characters.
+ */
+size_t CopyUCS2ToUCS4(const UCS2CHAR *src, size_t len, UCS4CHAR *dst)
+{
+   DISPATCH(CopyUCS2ToUCS4, src, len, dst)
+}
+
+/**
+ * Count leading ASCII characters in UTF-8 string
+ */
+size_t CountASCII(const BYTE *src, size_t len)
+{
+   DISPATCH(CountASCII, src, len)
+}
+
+/**
+ * Count leading ASCII characters in UCS-4 string
+ */
+size_t CountUCS4ASCII(const UCS4CHAR *src, size_t len)
+{
+   DISPATCH_SSE2(CountUCS4ASCII, src, len)
+}
+
+/**
+ * Count leading characters from basic multilingual plane in UCS-4 string
+ */
+size_t CountUCS4BMP(const UCS4CHAR *src, size_t len)
+{
+   DISPATCH_SSE2(CountUCS4BMP, src, len)
+}
+
+/**
+ * Swap bytes in array of 16 bit values
+ */
+void SwapBytes16(UINT16 *v, size_t len)
+{
+   DISPATCH(SwapBytes16, v, len)
+}
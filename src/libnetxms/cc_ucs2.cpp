@@ -34,6 +34,16 @@ size_t LIBNETXMS_EXPORTABLE ucs2_to_ucs4(const UCS2CHAR *src, ssize_t srcLen, UC
    UCS4CHAR *d = dst;
    while((scount < len) && (dcount < dstLen))
    {
+      if ((*s & 0xF800) != 0xD800)
+      {
+         size_t n = CopyUCS2ToUCS4(s, std::min(len - scount, dstLen - dcount), d);
+         s += n;
+         scount += n;
+         d += n;
+         dcount += n;
+         continue;
+      }
+
       UCS2CHAR ch2 = *s++;
       scount++;
       if ((ch2 & 0xFC00) == 0xD800)  // high surrogate
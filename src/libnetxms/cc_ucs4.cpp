@@ -65,11 +65,18 @@ size_t LIBNETXMS_EXPORTABLE ucs4_ucs2len(const UCS4CHAR *src, ssize_t srcLen)
    size_t len = (srcLen == -1) ? ucs4_strlen(src) + 1 : srcLen;
    size_t dcount = len;
    const UCS4CHAR *s = src;
-   while(len-- > 0)
+   while(len > 0)
    {
-      UCS4CHAR ch = *s++;
-      if (ch > 0xFFFF)
+      size_t n = CountUCS4BMP(s, len);
+      s += n;
+      len -= n;
+      if (len > 0)
+      {
+         // Character outside basic multilingual plane
+         s++;
+         len--;
          dcount++;
+      }
    }
    return dcount;
 }
@@ -85,14 +92,19 @@ size_t LIBNETXMS_EXPORTABLE ucs4_to_utf8(const UCS4CHAR *src, ssize_t srcLen, ch
    char *d = dst;
    while((scount < len) && (dcount < dstLen))
    {
-      UCS4CHAR ch = *s++;
-      scount++;
-      if (ch <= 0x7F)
+      if (*s <= 0x7F)
       {
-         *d++ = static_cast<char>(ch);
-         dcount++;
+         size_t n = CopyUCS4ToASCII(s, std::min(len - scount, dstLen - dcount), d);
+         s += n;
+         scount += n;
+         d += n;
+         dcount += n;
+         continue;
       }
-      else if (ch <= 0x7FF)
+
+      UCS4CHAR ch = *s++;
+      scount++;
+      if (ch <= 0x7FF)
       {
          if (dcount > dstLen - 2)
             break;   // no enough space in destination buffer
@@ -132,16 +144,22 @@ size_t LIBNETXMS_EXPORTABLE ucs4_to_utf8(const UCS4CHAR *src, ssize_t srcLen, ch
 size_t LIBNETXMS_EXPORTABLE ucs4_utf8len(const UCS4CHAR *src, ssize_t srcLen)
 {
    size_t len = (srcLen == -1) ? ucs4_strlen(src) + 1 : srcLen;
-   int dcount = 0;
+   size_t dcount = 0;
    const UCS4CHAR *s = src;
-   while(len-- > 0)
+   while(len > 0)
    {
-      UCS4CHAR ch = *s++;
-      if (ch <= 0x7F)
+      if (*s <= 0x7F)
       {
-         dcount++;
+         size_t n = CountUCS4ASCII(s, len);
+         s += n;
+         len -= n;
+         dcount += n;
+         continue;
       }
-      else if (ch <= 0x7FF)
+
+      UCS4CHAR ch = *s++;
+      len--;
+      if (ch <= 0x7FF)
       {
          dcount += 2;
       }
@@ -70,8 +70,19 @@ size_t LIBNETXMS_EXPORTABLE utf8_to_ucs4(const char *src, ssize_t srcLen, UCS4CH
    size_t dcount = 0;
    while((len > 0) && (dcount < dstLen))
    {
-      *d++ = CodePointFromUTF8(s, len);
-      dcount++;
+      if (*s < 0x80)
+      {
+         size_t n = CopyASCIIToUCS4(s, std::min(len, dstLen - dcount), d);
+         s += n;
+         d += n;
+         len -= n;
+         dcount += n;
+      }
+      else
+      {
+         *d++ = CodePointFromUTF8(s, len);
+         dcount++;
+      }
    }
 
    if ((srcLen == -1) && (dcount == dstLen) && (dstLen > 0))
@@ -89,8 +100,18 @@ size_t LIBNETXMS_EXPORTABLE utf8_ucs4len(const char *src, ssize_t srcLen)
    size_t dcount = 0;
    while(len > 0)
    {
-      CodePointFromUTF8(s, len);
-      dcount++;
+      if (*s < 0x80)
+      {
+         size_t n = CountASCII(s, len);
+         s += n;
+         len -= n;
+         dcount += n;
+      }
+      else
+      {
+         CodePointFromUTF8(s, len);
+         dcount++;
+      }
    }
    return dcount;
 }
@@ -106,6 +127,16 @@ size_t LIBNETXMS_EXPORTABLE utf8_to_ucs2(const char *src, ssize_t srcLen, UCS2CH
    size_t dcount = 0;
    while((len > 0) && (dcount < dstLen))
    {
+      if (*s < 0x80)
+      {
+         size_t n = CopyASCIIToUCS2(s, std::min(len, dstLen - dcount), d);
+         s += n;
+         d += n;
+         len -= n;
+         dcount += n;
+         continue;
+      }
+
       UCS4CHAR ch = CodePointFromUTF8(s, len);
       if (ch <= 0xFFFF)
       {
@@ -138,6 +169,15 @@ size_t LIBNETXMS_EXPORTABLE utf8_ucs2len(const char *src, ssize_t srcLen)
    size_t dcount = 0;
    while(len > 0)
    {
+      if (*s < 0x80)
+      {
+         size_t n = CountASCII(s, len);
+         s += n;
+         len -= n;
+         dcount += n;
+         continue;
+      }
+
       UCS4CHAR ch = CodePointFromUTF8(s, len);
       dcount++;
       if (ch > 0xFFFF)
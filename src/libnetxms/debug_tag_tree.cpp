@@ -146,6 +146,28 @@ bool DebugTagTreeNode::remove(const TCHAR *tag)
    return (m_children->size() == 0) && !m_wildcard;
 }
 
+/**
+ * Get highest debug level set on this node or any of its children (recursive)
+ */
+int DebugTagTreeNode::getMaxDebugLevel() const
+{
+   int result = 0;
+   if (m_direct)
+      result = m_directLevel;
+   if (m_wildcard && (m_wildcardLevel > result))
+      result = m_wildcardLevel;
+
+   StructArray<KeyValuePair<DebugTagTreeNode>> *c = m_children->toArray();
+   for(int i = 0; i < c->size(); i++)
+   {
+      int level = c->get(i)->value->getMaxDebugLevel();
+      if (level > result)
+         result = level;
+   }
+   delete c;
+   return result;
+}
+
 /**
  * Get all tags under this node
  */
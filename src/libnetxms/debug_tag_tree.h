@@ -48,6 +48,7 @@ class DebugTagTreeNode
    int getDebugLevel(const TCHAR *tag) const;
    int getWildcardDebugLevel() const { return m_wildcardLevel; }
    const TCHAR *getValue() const { return m_value; }
+   int getMaxDebugLevel() const;
    void getAllTags(const TCHAR *prefix, ObjectArray<DebugTagInfo> *tags) const;
 
    void add(const TCHAR *tag, int level);
@@ -72,6 +73,7 @@ class DebugTagTree
 
    int getDebugLevel(const TCHAR *tags);
    int getRootDebugLevel() { return m_root->getWildcardDebugLevel(); }
+   int getMaxDebugLevel() { return m_root->getMaxDebugLevel(); }
    ObjectArray<DebugTagInfo> *getAllTags();
 
    void add(const TCHAR *tag, int level) { m_root->add(tag, level); }
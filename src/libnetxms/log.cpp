@@ -29,10 +29,16 @@
 #include <syslog.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
 #define MAX_LOG_HISTORY_SIZE	   128
 
 #define LOCAL_MSG_BUFFER_SIZE    1024
 
+#define WRITER_IOVEC_COUNT       64
+
 typedef TCHAR msg_buffer_t[LOCAL_MSG_BUFFER_SIZE];
 
 #ifdef _WIN32
@@ -60,6 +66,16 @@ struct DebugTagManager
    }
 };
 
+/**
+ * Log record waiting for background writer
+ */
+struct LogRecord
+{
+   LogRecord *next;
+   size_t size;
+   char data[1];  // UTF-8 encoded record text, not null terminated
+};
+
 /**
  * Static data
  */
@@ -83,12 +99,38 @@ static NxLogConsoleWriter m_consoleWriter = DefaultConsoleWriter;
 #else
 static NxLogConsoleWriter m_consoleWriter = (NxLogConsoleWriter)_tprintf;
 #endif
-static StringBuffer s_logBuffer;
+static LogRecord* volatile s_logQueue = NULL;  // Records waiting for background writer, newest first
 static THREAD s_writerThread = INVALID_THREAD_HANDLE;
 static CONDITION s_writerStopCondition = INVALID_CONDITION_HANDLE;
 static NxLogDebugWriter s_debugWriter = NULL;
 static volatile DebugTagManager s_tagTree;
 static Mutex s_mutexDebugTagTreeWrite;
+static VolatileCounter s_debugLevelGeneration = 1;
+static volatile int s_maxDebugLevel = 0;
+
+#if HAVE_THREAD_LOCAL_STORAGE
+
+#define DEBUG_LEVEL_CACHE_SIZE      16
+#define DEBUG_LEVEL_CACHE_TAG_LEN   32
+
+/**
+ * Per-thread debug level cache entry. Entry is valid only while its generation
+ * matches global debug level generation, which is changed on every debug level update.
+ */
+struct DebugLevelCacheEntry
+{
+   const TCHAR *tagPtr;
+   int32_t generation;
+   int level;
+   TCHAR tag[DEBUG_LEVEL_CACHE_TAG_LEN];
+};
+
+/**
+ * Per-thread debug level cache
+ */
+static thread_local DebugLevelCacheEntry s_debugLevelCache[DEBUG_LEVEL_CACHE_SIZE];
+
+#endif
 
 /**
  * Swaps tag tree pointers and waits till reader count drops to 0
@@ -101,6 +143,16 @@ static inline void SwapAndWait()
       ThreadSleepMs(10);
 }
 
+/**
+ * Update cached maximum debug level and invalidate per-thread debug level caches.
+ * Should be called with debug tag tree write lock held.
+ */
+static void UpdateDebugLevelCache()
+{
+   s_maxDebugLevel = s_tagTree.secondary->getMaxDebugLevel();
+   InterlockedIncrement(&s_debugLevelGeneration);
+}
+
 /**
  * Allocate string buffer on heap if requested size is bigger than local buffer size
  */
@@ -217,6 +269,7 @@ void LIBNETXMS_EXPORTABLE nxlog_set_debug_level(int level)
       s_tagTree.secondary->setRootDebugLevel(level); // Update the secondary tree
       SwapAndWait();
       s_tagTree.secondary->setRootDebugLevel(level); // Update the previously active tree
+      UpdateDebugLevelCache();
       InterlockedDecrement(&s_tagTree.secondary->m_writers);
       s_mutexDebugTagTreeWrite.unlock();
    }
@@ -246,6 +299,12 @@ void LIBNETXMS_EXPORTABLE nxlog_set_debug_level_tag(const TCHAR *tag, int level)
          SwapAndWait();
          s_tagTree.secondary->remove(tag);
       }
+      else
+      {
+         s_mutexDebugTagTreeWrite.unlock();
+         return;
+      }
+      UpdateDebugLevelCache();
       InterlockedDecrement(&s_tagTree.secondary->m_writers);
       s_mutexDebugTagTreeWrite.unlock();
    }
@@ -260,6 +319,7 @@ void LIBNETXMS_EXPORTABLE nxlog_reset_debug_level_tags()
    s_tagTree.secondary->clear();
    SwapAndWait();
    s_tagTree.secondary->clear();
+   UpdateDebugLevelCache();
    InterlockedDecrement(&s_tagTree.secondary->m_writers);
    s_mutexDebugTagTreeWrite.unlock();
 }
@@ -301,9 +361,9 @@ int LIBNETXMS_EXPORTABLE nxlog_get_debug_level()
 }
 
 /**
- * Get current debug level for tag
+ * Get current debug level for tag directly from tag tree
  */
-int LIBNETXMS_EXPORTABLE nxlog_get_debug_level_tag(const TCHAR *tag)
+static inline int GetDebugLevelFromTree(const TCHAR *tag)
 {
    DebugTagTree *tagTree = AcquireTagTree();
    int level = tagTree->getDebugLevel(tag);
@@ -311,6 +371,36 @@ int LIBNETXMS_EXPORTABLE nxlog_get_debug_level_tag(const TCHAR *tag)
    return level;
 }
 
+/**
+ * Get current debug level for tag
+ */
+int LIBNETXMS_EXPORTABLE nxlog_get_debug_level_tag(const TCHAR *tag)
+{
+#if HAVE_THREAD_LOCAL_STORAGE
+   if (tag == NULL)
+      return GetDebugLevelFromTree(NULL);
+
+   // Tag pointer is only a hint (tag can be in reused local buffer), so tag itself is compared as well
+   uintptr_t p = reinterpret_cast<uintptr_t>(tag);
+   DebugLevelCacheEntry *entry = &s_debugLevelCache[(p ^ (p >> 5)) % DEBUG_LEVEL_CACHE_SIZE];
+   int32_t generation = s_debugLevelGeneration;
+   if ((entry->tagPtr == tag) && (entry->generation == generation) && !_tcscmp(entry->tag, tag))
+      return entry->level;
+
+   int level = GetDebugLevelFromTree(tag);
+   if (_tcslen(tag) < DEBUG_LEVEL_CACHE_TAG_LEN)
+   {
+      entry->tagPtr = tag;
+      entry->generation = generation;
+      entry->level = level;
+      _tcscpy(entry->tag, tag);
+   }
+   return level;
+#else
+   return GetDebugLevelFromTree(tag);
+#endif
+}
+
 /**
  * Get current debug level for tag/object combination
  */
@@ -318,10 +408,7 @@ int LIBNETXMS_EXPORTABLE nxlog_get_debug_level_tag_object(const TCHAR *tag, UINT
 {
    TCHAR fullTag[256];
    _sntprintf(fullTag, 256, _T("%s.%u"), tag, objectId);
-   DebugTagTree *tagTree = AcquireTagTree();
-   int level = tagTree->getDebugLevel(fullTag);
-   ReleaseTagTree(tagTree);
-   return level;
+   return GetDebugLevelFromTree(fullTag);
 }
 
 /**
@@ -720,6 +807,94 @@ bool LIBNETXMS_EXPORTABLE nxlog_rotate()
    return (s_logFileHandle != -1) ? RotateLog(true) : false;
 }
 
+/**
+ * Add record to background writer queue. Conversion to UTF-8 is done by calling thread
+ * and record is linked into queue without locking.
+ */
+static void QueueLogRecord(const TCHAR *text, size_t len)
+{
+#ifdef UNICODE
+   size_t size = wchar_utf8len(text, len);
+#else
+   size_t size = len * 4;
+#endif
+   LogRecord *record = static_cast<LogRecord*>(MemAlloc(sizeof(LogRecord) + size));
+   record->size = tchar_to_utf8(text, len, record->data, size);
+
+   LogRecord *head;
+   do
+   {
+      head = s_logQueue;
+      record->next = head;
+   } while(InterlockedCompareExchangeObjectPointer(&s_logQueue, record, head) != head);
+}
+
+/**
+ * Take all queued records. Returns records in the same order as they were added.
+ */
+static LogRecord *TakeQueuedLogRecords()
+{
+   LogRecord *curr = InterlockedExchangeObjectPointer(&s_logQueue, static_cast<LogRecord*>(NULL));
+   LogRecord *prev = NULL;
+   while(curr != NULL)
+   {
+      LogRecord *next = curr->next;
+      curr->next = prev;
+      prev = curr;
+      curr = next;
+   }
+   return prev;
+}
+
+/**
+ * Free list of log records
+ */
+static void FreeLogRecords(LogRecord *records)
+{
+   while(records != NULL)
+   {
+      LogRecord *next = records->next;
+      MemFree(records);
+      records = next;
+   }
+}
+
+/**
+ * Write list of log records to given file handle
+ */
+static void WriteLogRecords(int fh, LogRecord *records)
+{
+#ifdef _WIN32
+   size_t total = 0;
+   for(LogRecord *r = records; r != NULL; r = r->next)
+      total += r->size;
+   char *data = static_cast<char*>(MemAlloc(total));
+   char *curr = data;
+   for(LogRecord *r = records; r != NULL; r = r->next)
+   {
+      memcpy(curr, r->data, r->size);
+      curr += r->size;
+   }
+   _write(fh, data, static_cast<unsigned int>(total));
+   MemFree(data);
+#else
+   struct iovec iov[WRITER_IOVEC_COUNT];
+   int count = 0;
+   for(LogRecord *r = records; r != NULL; r = r->next)
+   {
+      iov[count].iov_base = r->data;
+      iov[count].iov_len = r->size;
+      if (++count == WRITER_IOVEC_COUNT)
+      {
+         writev(fh, iov, count);
+         count = 0;
+      }
+   }
+   if (count > 0)
+      writev(fh, iov, count);
+#endif
+}
+
 /**
  * Background writer thread - file
  */
@@ -737,41 +912,38 @@ static void BackgroundWriterThread()
 		   RotateLog(false);
 	   }
 
-      MutexLock(s_mutexLogAccess);
-      if (!s_logBuffer.isEmpty())
-      {
-         size_t buflen = s_logBuffer.length();
-         char *data = s_logBuffer.getUTF8String();
-         s_logBuffer.clear();
-         MutexUnlock(s_mutexLogAccess);
+      LogRecord *records = TakeQueuedLogRecords();
+      if (records == NULL)
+         continue;
 
-         if (s_logFileHandle != -1)
+      if (s_logFileHandle != -1)
+      {
+         if (s_flags & NXLOG_DEBUG_MODE)
          {
-            if (s_flags & NXLOG_DEBUG_MODE)
+            int64_t count = 0, size = 0;
+            for(LogRecord *r = records; r != NULL; r = r->next)
             {
-               char buffer[256];
-               snprintf(buffer, 256, "##(" INT64_FMTA ")" INT64_FMTA " @" INT64_FMTA "\n", (int64_t)buflen, (int64_t)strlen(data), GetCurrentTimeMs());
-               _write(s_logFileHandle, buffer, strlen(buffer));
+               count++;
+               size += r->size;
             }
+            char buffer[256];
+            snprintf(buffer, 256, "##(" INT64_FMTA ")" INT64_FMTA " @" INT64_FMTA "\n", count, size, GetCurrentTimeMs());
+            _write(s_logFileHandle, buffer, strlen(buffer));
+         }
 
-            _write(s_logFileHandle, data, strlen(data));
+         WriteLogRecords(s_logFileHandle, records);
 
-            // Check log size
-            if ((s_rotationMode == NXLOG_ROTATION_BY_SIZE) && (s_maxLogSize != 0))
-            {
-               NX_STAT_STRUCT st;
-               NX_FSTAT(s_logFileHandle, &st);
-               if ((UINT64)st.st_size >= s_maxLogSize)
-                  RotateLog(false);
-            }
+         // Check log size
+         if ((s_rotationMode == NXLOG_ROTATION_BY_SIZE) && (s_maxLogSize != 0))
+         {
+            NX_STAT_STRUCT st;
+            NX_FSTAT(s_logFileHandle, &st);
+            if ((UINT64)st.st_size >= s_maxLogSize)
+               RotateLog(false);
          }
-
-	      MemFree(data);
-      }
-      else
-      {
-         MutexUnlock(s_mutexLogAccess);
       }
+
+      FreeLogRecords(records);
    }
 }
 
@@ -785,19 +957,11 @@ static void BackgroundWriterThreadStdOut()
    {
       stop = ConditionWait(s_writerStopCondition, 1000);
 
-      MutexLock(s_mutexLogAccess);
-      if (!s_logBuffer.isEmpty())
+      LogRecord *records = TakeQueuedLogRecords();
+      if (records != NULL)
       {
-         char *data = s_logBuffer.getUTF8String();
-         s_logBuffer.clear();
-         MutexUnlock(s_mutexLogAccess);
-
-         _write(STDOUT_FILENO, data, strlen(data));
-         MemFree(data);
-      }
-      else
-      {
-         MutexUnlock(s_mutexLogAccess);
+         WriteLogRecords(STDOUT_FILENO, records);
+         FreeLogRecords(records);
       }
    }
 }
@@ -839,7 +1003,6 @@ bool LIBNETXMS_EXPORTABLE nxlog_open(const TCHAR *logName, UINT32 flags)
       s_flags &= ~NXLOG_PRINT_TO_STDOUT;
       if (s_flags & NXLOG_BACKGROUND_WRITER)
       {
-         s_logBuffer.setAllocationStep(8192);
          s_writerStopCondition = ConditionCreate(TRUE);
          s_writerThread = ThreadCreateEx(BackgroundWriterThreadStdOut);
       }
@@ -880,7 +1043,6 @@ bool LIBNETXMS_EXPORTABLE nxlog_open(const TCHAR *logName, UINT32 flags)
 
          if (s_flags & NXLOG_BACKGROUND_WRITER)
          {
-            s_logBuffer.setAllocationStep(8192);
             s_writerStopCondition = ConditionCreate(TRUE);
             s_writerThread = ThreadCreateEx(BackgroundWriterThread);
          }
@@ -941,6 +1103,8 @@ void LIBNETXMS_EXPORTABLE nxlog_close()
 	   s_flags &= ~NXLOG_IS_OPEN;
    }
 
+   FreeLogRecords(TakeQueuedLogRecords());
+
    if (s_mutexLogAccess != INVALID_MUTEX_HANDLE)
    {
       MutexDestroy(s_mutexLogAccess);
@@ -977,6 +1141,16 @@ static void WriteLogToConsole(INT16 severity, const TCHAR *timestamp, const TCHA
    m_consoleWriter(_T("%s %s%s] %s\n"), timestamp, loglevel, FormatTag(tag, tagf), message);
 }
 
+/**
+ * Copy string to given position and return pointer to the end of copied string
+ */
+static inline TCHAR *AppendString(TCHAR *dst, const TCHAR *src)
+{
+   size_t len = _tcslen(src);
+   memcpy(dst, src, len * sizeof(TCHAR));
+   return dst + len;
+}
+
 /**
  * Write record to log file (text format)
  */
@@ -1005,21 +1179,38 @@ static void WriteLogToFileAsText(INT16 severity, const TCHAR *tag, const TCHAR *
    TCHAR tagf[20];
    FormatTag(tag, tagf);
 
-   MutexLock(s_mutexLogAccess);
-
    TCHAR timestamp[64];
-   FormatLogTimestamp(timestamp);
    if (s_flags & NXLOG_BACKGROUND_WRITER)
    {
-      s_logBuffer.append(timestamp);
-      s_logBuffer.append(_T(" "));
-      s_logBuffer.append(loglevel);
-      s_logBuffer.append(tagf);
-      s_logBuffer.append(_T("] "));
-      s_logBuffer.append(message);
-      s_logBuffer.append(_T("\n"));
+      FormatLogTimestamp(timestamp);
+      size_t messageLen = _tcslen(message);
+      TCHAR localBuffer[LOCAL_MSG_BUFFER_SIZE];
+      TCHAR *line = AllocateStringBuffer(messageLen + 64, localBuffer);
+      TCHAR *curr = AppendString(line, timestamp);
+      *curr++ = _T(' ');
+      curr = AppendString(curr, loglevel);
+      curr = AppendString(curr, tagf);
+      *curr++ = _T(']');
+      *curr++ = _T(' ');
+      memcpy(curr, message, messageLen * sizeof(TCHAR));
+      curr += messageLen;
+      *curr++ = _T('\n');
+      QueueLogRecord(line, curr - line);
+      FreeStringBuffer(line, localBuffer);
+
+      if (s_flags & NXLOG_PRINT_TO_STDOUT)
+      {
+         MutexLock(s_mutexLogAccess);
+         WriteLogToConsole(severity, timestamp, tag, message);
+         MutexUnlock(s_mutexLogAccess);
+      }
+      return;
    }
-   else if (s_flags & NXLOG_USE_STDOUT)
+
+   MutexLock(s_mutexLogAccess);
+
+   FormatLogTimestamp(timestamp);
+   if (s_flags & NXLOG_USE_STDOUT)
    {
       FileFormattedWrite(STDOUT_FILENO, _T("%s %s%s] %s\n"), timestamp, loglevel, tagf, message);
    }
@@ -1092,13 +1283,24 @@ static void WriteLogToFileAsJSON(INT16 severity, const TCHAR *tag, const TCHAR *
    _tcscat(json, escapedMessage);
    _tcscat(json, _T("\"}\n"));
 
-   MutexLock(s_mutexLogAccess);
-
    if (s_flags & NXLOG_BACKGROUND_WRITER)
    {
-      s_logBuffer.append(json);
+      QueueLogRecord(json, _tcslen(json));
+      if (s_flags & NXLOG_PRINT_TO_STDOUT)
+      {
+         MutexLock(s_mutexLogAccess);
+         WriteLogToConsole(severity, timestamp, tag, message);
+         MutexUnlock(s_mutexLogAccess);
+      }
+      FreeStringBuffer(json, jsonBuffer);
+      FreeStringBuffer(escapedMessage, escapedMessageBuffer);
+      FreeStringBuffer(escapedTag, escapedTagBuffer);
+      return;
    }
-   else if (s_flags & NXLOG_USE_STDOUT)
+
+   MutexLock(s_mutexLogAccess);
+
+   if (s_flags & NXLOG_USE_STDOUT)
    {
       FileWrite(STDOUT_FILENO, json);
    }
@@ -1308,7 +1510,7 @@ void LIBNETXMS_EXPORTABLE nxlog_write_tag2(INT16 severity, const TCHAR *tag, con
  */
 void LIBNETXMS_EXPORTABLE nxlog_debug(int level, const TCHAR *format, ...)
 {
-   if (level > nxlog_get_debug_level_tag(_T("*")))
+   if ((level > s_maxDebugLevel) || (level > nxlog_get_debug_level_tag(_T("*"))))
       return;
 
    va_list args;
@@ -1322,7 +1524,7 @@ void LIBNETXMS_EXPORTABLE nxlog_debug(int level, const TCHAR *format, ...)
  */
 void LIBNETXMS_EXPORTABLE nxlog_debug2(int level, const TCHAR *format, va_list args)
 {
-   if (level > nxlog_get_debug_level_tag(_T("*")))
+   if ((level > s_maxDebugLevel) || (level > nxlog_get_debug_level_tag(_T("*"))))
       return;
 
    WriteLog(NXLOG_DEBUG, NULL, format, args);
@@ -1333,7 +1535,7 @@ void LIBNETXMS_EXPORTABLE nxlog_debug2(int level, const TCHAR *format, va_list a
  */
 void LIBNETXMS_EXPORTABLE nxlog_debug_tag(const TCHAR *tag, int level, const TCHAR *format, ...)
 {
-   if (level > nxlog_get_debug_level_tag(tag))
+   if ((level > s_maxDebugLevel) || (level > nxlog_get_debug_level_tag(tag)))
       return;
 
    va_list args;
@@ -1347,7 +1549,7 @@ void LIBNETXMS_EXPORTABLE nxlog_debug_tag(const TCHAR *tag, int level, const TCH
  */
 void LIBNETXMS_EXPORTABLE nxlog_debug_tag2(const TCHAR *tag, int level, const TCHAR *format, va_list args)
 {
-   if (level > nxlog_get_debug_level_tag(tag))
+   if ((level > s_maxDebugLevel) || (level > nxlog_get_debug_level_tag(tag)))
       return;
 
    WriteLog(NXLOG_DEBUG, tag, format, args);
@@ -1358,9 +1560,12 @@ void LIBNETXMS_EXPORTABLE nxlog_debug_tag2(const TCHAR *tag, int level, const TC
  */
 void LIBNETXMS_EXPORTABLE nxlog_debug_tag_object(const TCHAR *tag, UINT32 objectId, int level, const TCHAR *format, ...)
 {
+   if (level > s_maxDebugLevel)
+      return;
+
    TCHAR fullTag[256];
    _sntprintf(fullTag, 256, _T("%s.%u"), tag, objectId);
-   if (level > nxlog_get_debug_level_tag(fullTag))
+   if (level > GetDebugLevelFromTree(fullTag))
       return;
 
    va_list args;
@@ -1374,9 +1579,12 @@ void LIBNETXMS_EXPORTABLE nxlog_debug_tag_object(const TCHAR *tag, UINT32 object
  */
 void LIBNETXMS_EXPORTABLE nxlog_debug_tag_object2(const TCHAR *tag, UINT32 objectId, int level, const TCHAR *format, va_list args)
 {
+   if (level > s_maxDebugLevel)
+      return;
+
    TCHAR fullTag[256];
    _sntprintf(fullTag, 256, _T("%s.%u"), tag, objectId);
-   if (level > nxlog_get_debug_level_tag(fullTag))
+   if (level > GetDebugLevelFromTree(fullTag))
       return;
 
    WriteLog(NXLOG_DEBUG, fullTag, format, args);
@@ -22,6 +22,7 @@
 **/
 
 #include "libnetxms.h"
+#include "unicode_cc.h"
 
 #if HAVE_LIBCURL
 #include <curl/curl.h>
@@ -138,14 +139,14 @@ void LIBNETXMS_EXPORTABLE bswap_array_16(UINT16 *v, int len)
 {
    if (len < 0)
    {
-      for(UINT16 *p = v; *p != 0; p++)
-         *p = bswap_16(*p);
+      size_t count = 0;
+      while(v[count] != 0)
+         count++;
+      SwapBytes16(v, count);
    }
    else
    {
-      int count = 0;
-      for(UINT16 *p = v; count < len; p++, count++)
-         *p = bswap_16(*p);
+      SwapBytes16(v, len);
    }
 }
 
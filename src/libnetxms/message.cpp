@@ -24,13 +24,6 @@
 #include <nxcpapi.h>
 #include <zlib.h>
 
-#undef uthash_malloc
-#define uthash_malloc(sz) m_pool.allocate(sz)
-#undef uthash_free
-#define uthash_free(ptr,sz) do { } while(0)
-
-#include <uthash.h>
-
 /**
  * ZLib custom alloc
  */
@@ -87,28 +80,72 @@ static size_t CalculateFieldSize(const NXCP_MESSAGE_FIELD *field, bool networkBy
 }
 
 /**
- * Field hash map entry
+ * Calculate field size including padding to 8 bytes boundary
+ */
+static inline size_t AlignedFieldSize(size_t fieldSize)
+{
+   return fieldSize + ((8 - (fieldSize % 8)) & 7);
+}
+
+/**
+ * Message field entry. Field data is either stored inline (for fields set locally)
+ * or points to field within received message data block.
  */
 struct MessageField
 {
-   UT_hash_handle hh;
+   MessageField *next;
+   MessageField *prev;
+   NXCP_MESSAGE_FIELD *data;
    uint32_t id;
-   size_t size;
-   NXCP_MESSAGE_FIELD data;
+   uint32_t size;    // Field data size (without alignment)
+   NXCP_MESSAGE_FIELD inlineData;
 };
 
 /**
- * Create new hash entry with given field size
+ * Size of message field entry header
+ */
+#define MESSAGE_FIELD_HEADER_SIZE   (sizeof(MessageField) - sizeof(NXCP_MESSAGE_FIELD))
+
+/**
+ * Create new field entry with given field size
  */
-inline MessageField *CreateMessageField(MemoryPool& pool, size_t fieldSize)
+static inline MessageField *CreateMessageField(MemoryPool& pool, size_t fieldSize)
 {
-   size_t entrySize = sizeof(MessageField) - sizeof(NXCP_MESSAGE_FIELD) + fieldSize;
+   size_t entrySize = MESSAGE_FIELD_HEADER_SIZE + fieldSize;
    MessageField *entry = static_cast<MessageField*>(pool.allocate(entrySize));
    memset(entry, 0, entrySize);
-   entry->size = entrySize;
+   entry->data = &entry->inlineData;
+   entry->size = static_cast<uint32_t>(fieldSize);
    return entry;
 }
 
+/**
+ * Create new field entry referencing external field data
+ */
+static inline MessageField *CreateMessageFieldReference(MemoryPool& pool, NXCP_MESSAGE_FIELD *data, size_t fieldSize)
+{
+   MessageField *entry = static_cast<MessageField*>(pool.allocate(MESSAGE_FIELD_HEADER_SIZE));
+   entry->next = nullptr;
+   entry->prev = nullptr;
+   entry->data = data;
+   entry->id = data->fieldId;
+   entry->size = static_cast<uint32_t>(fieldSize);
+   return entry;
+}
+
+/**
+ * Hash function for field index
+ */
+static inline uint32_t FieldIndexHash(uint32_t fieldId)
+{
+   return fieldId * 2654435761U;
+}
+
+/**
+ * Initial field index size (must be power of 2)
+ */
+#define INITIAL_INDEX_SIZE    32
+
 /**
  * Default constructor for NXCPMessage class
  */
@@ -116,7 +153,7 @@ NXCPMessage::NXCPMessage(int version) : m_pool(NXCP_DEFAULT_SIZE_HINT)
 {
    m_code = 0;
    m_id = 0;
-   m_fields = NULL;
+   initFields();
    m_flags = 0;
    m_version = version;
    m_data = NULL;
@@ -130,13 +167,93 @@ NXCPMessage::NXCPMessage(UINT16 code, UINT32 id, int version) : m_pool(NXCP_DEFA
 {
    m_code = code;
    m_id = id;
-   m_fields = NULL;
+   initFields();
    m_flags = 0;
    m_version = version;
    m_data = NULL;
    m_dataSize = 0;
 }
 
+/**
+ * Initialize empty field list
+ */
+void NXCPMessage::initFields()
+{
+   m_fields = nullptr;
+   m_lastField = nullptr;
+   m_index = nullptr;
+   m_indexMask = 0;
+   m_fieldCount = 0;
+   m_fieldsSize = 0;
+}
+
+/**
+ * Rebuild field index with given size (must be power of 2). Old index memory
+ * is not reclaimed until pool is cleared, but because index grows geometrically
+ * total overhead is bounded by size of final index.
+ */
+void NXCPMessage::resizeIndex(uint32_t size)
+{
+   m_index = m_pool.allocateArray<MessageField*>(size);
+   memset(m_index, 0, sizeof(MessageField*) * size);
+   m_indexMask = size - 1;
+   for(MessageField *f = m_fields; f != nullptr; f = f->next)
+   {
+      uint32_t i = FieldIndexHash(f->id) & m_indexMask;
+      while(m_index[i] != nullptr)
+         i = (i + 1) & m_indexMask;
+      m_index[i] = f;
+   }
+}
+
+/**
+ * Add field entry to message, replacing existing field with same ID
+ */
+void NXCPMessage::addField(MessageField *entry)
+{
+   // Keep load factor below 0.5
+   if (m_index == nullptr)
+      resizeIndex(INITIAL_INDEX_SIZE);
+   else if ((m_fieldCount + 1) * 2 > m_indexMask + 1)
+      resizeIndex((m_indexMask + 1) * 2);
+
+   uint32_t i = FieldIndexHash(entry->id) & m_indexMask;
+   while(m_index[i] != nullptr)
+   {
+      MessageField *curr = m_index[i];
+      if (curr->id == entry->id)
+      {
+         // Replace existing field keeping its position in field list
+         entry->prev = curr->prev;
+         entry->next = curr->next;
+         if (curr->prev != nullptr)
+            curr->prev->next = entry;
+         else
+            m_fields = entry;
+         if (curr->next != nullptr)
+            curr->next->prev = entry;
+         else
+            m_lastField = entry;
+         m_fieldsSize -= AlignedFieldSize(curr->size);
+         m_fieldsSize += AlignedFieldSize(entry->size);
+         m_index[i] = entry;
+         return;
+      }
+      i = (i + 1) & m_indexMask;
+   }
+
+   m_index[i] = entry;
+   entry->next = nullptr;
+   entry->prev = m_lastField;
+   if (m_lastField != nullptr)
+      m_lastField->next = entry;
+   else
+      m_fields = entry;
+   m_lastField = entry;
+   m_fieldCount++;
+   m_fieldsSize += AlignedFieldSize(entry->size);
+}
+
 /**
  * Create a copy of prepared CSCP message
  */
@@ -146,7 +263,7 @@ NXCPMessage::NXCPMessage(NXCPMessage *msg) : m_pool(msg->m_pool.regionSize())
    m_id = msg->m_id;
    m_flags = msg->m_flags;
    m_version = msg->m_version;
-   m_fields = NULL;
+   initFields();
 
    if (m_flags & MF_BINARY)
    {
@@ -158,11 +275,19 @@ NXCPMessage::NXCPMessage(NXCPMessage *msg) : m_pool(msg->m_pool.regionSize())
       m_data = NULL;
       m_dataSize = 0;
 
-      MessageField *entry, *tmp;
-      HASH_ITER(hh, msg->m_fields, entry, tmp)
+      if (msg->m_fieldCount > 0)
+      {
+         uint32_t indexSize = INITIAL_INDEX_SIZE;
+         while(indexSize < msg->m_fieldCount * 2)
+            indexSize *= 2;
+         resizeIndex(indexSize);
+      }
+      for(MessageField *entry = msg->m_fields; entry != nullptr; entry = entry->next)
       {
-         MessageField *f = m_pool.copyMemoryBlock(entry, entry->size);
-         HASH_ADD_INT(m_fields, id, f);
+         MessageField *f = CreateMessageField(m_pool, entry->size);
+         f->id = entry->id;
+         memcpy(f->data, entry->data, entry->size);
+         addField(f);
       }
    }
 }
@@ -201,7 +326,7 @@ NXCPMessage::NXCPMessage(const NXCP_MESSAGE *msg, int version) : m_pool(SizeHint
    m_flags = ntohs(msg->flags);
    m_code = ntohs(msg->code);
    m_id = ntohl(msg->id);
-   m_fields = NULL;
+   initFields();
 
    int v = getEncodedProtocolVersion();
    m_version = (v != 0) ? v : version; // Use encoded version if present
@@ -295,11 +420,29 @@ NXCPMessage::NXCPMessage(const NXCP_MESSAGE *msg, int version) : m_pool(SizeHint
       }
       else
       {
-         msgData = (BYTE *)msg + NXCP_HEADER_SIZE;
          msgDataSize = (size_t)ntohl(msg->size) - NXCP_HEADER_SIZE;
+         if (m_version >= 2)
+         {
+            // Fields will be decoded in place within single copy of message data
+            msgData = m_pool.copyMemoryBlock(reinterpret_cast<const BYTE*>(msg) + NXCP_HEADER_SIZE, msgDataSize);
+         }
+         else
+         {
+            msgData = (BYTE *)msg + NXCP_HEADER_SIZE;
+         }
       }
 
       int fieldCount = (int)ntohl(msg->numFields);
+      if (fieldCount > 0)
+      {
+         // Pre-size index for declared number of fields (each field takes at least 8 bytes)
+         size_t expectedFields = std::min(static_cast<size_t>(fieldCount), msgDataSize / 8);
+         uint32_t indexSize = INITIAL_INDEX_SIZE;
+         while(indexSize < expectedFields * 2)
+            indexSize *= 2;
+         resizeIndex(indexSize);
+      }
+
       size_t pos = 0;
       for(int f = 0; f < fieldCount; f++)
       {
@@ -326,48 +469,61 @@ NXCPMessage::NXCPMessage(const NXCP_MESSAGE *msg, int version) : m_pool(SizeHint
             break;
          }
 
-         // Create new entry
-         MessageField *entry = CreateMessageField(m_pool, fieldSize);
-         entry->id = ntohl(field->fieldId);
-         memcpy(&entry->data, field, fieldSize);
+         // Create new entry. Starting from version 2 all fields are 8-byte aligned and
+         // can be converted in place, otherwise field is copied to separate aligned block.
+         NXCP_MESSAGE_FIELD *data;
+         MessageField *entry;
+         if (m_version >= 2)
+         {
+            data = field;
+            data->fieldId = ntohl(data->fieldId);
+            entry = CreateMessageFieldReference(m_pool, data, fieldSize);
+         }
+         else
+         {
+            entry = CreateMessageField(m_pool, fieldSize);
+            data = entry->data;
+            memcpy(data, field, fieldSize);
+            data->fieldId = ntohl(data->fieldId);
+            entry->id = data->fieldId;
+         }
 
          // Convert values to host format
-         entry->data.fieldId = ntohl(entry->data.fieldId);
-         switch(field->type)
+         switch(data->type)
          {
             case NXCP_DT_INT32:
-               entry->data.df_int32 = ntohl(entry->data.df_int32);
+               data->df_int32 = ntohl(data->df_int32);
                break;
             case NXCP_DT_INT64:
-               entry->data.df_int64 = ntohq(entry->data.df_int64);
+               data->df_int64 = ntohq(data->df_int64);
                break;
             case NXCP_DT_INT16:
-               entry->data.df_int16 = ntohs(entry->data.df_int16);
+               data->df_int16 = ntohs(data->df_int16);
                break;
             case NXCP_DT_FLOAT:
-               entry->data.df_real = ntohd(entry->data.df_real);
+               data->df_real = ntohd(data->df_real);
                break;
             case NXCP_DT_STRING:
 #if !(WORDS_BIGENDIAN)
-               entry->data.df_string.length = ntohl(entry->data.df_string.length);
-               bswap_array_16(entry->data.df_string.value, entry->data.df_string.length / 2);
+               data->df_string.length = ntohl(data->df_string.length);
+               bswap_array_16(data->df_string.value, data->df_string.length / 2);
 #endif
                break;
             case NXCP_DT_BINARY:
-               entry->data.df_binary.length = ntohl(entry->data.df_binary.length);
+               data->df_binary.length = ntohl(data->df_binary.length);
                break;
             case NXCP_DT_UTF8_STRING:
-               entry->data.df_utf8string.length = ntohl(entry->data.df_utf8string.length);
+               data->df_utf8string.length = ntohl(data->df_utf8string.length);
                break;
             case NXCP_DT_INETADDR:
-               if (entry->data.df_inetaddr.family == NXCP_AF_INET)
+               if (data->df_inetaddr.family == NXCP_AF_INET)
                {
-                  entry->data.df_inetaddr.addr.v4 = ntohl(entry->data.df_inetaddr.addr.v4);
+                  data->df_inetaddr.addr.v4 = ntohl(data->df_inetaddr.addr.v4);
                }
                break;
          }
 
-         HASH_ADD_INT(m_fields, id, entry);
+         addField(entry);
 
          // Starting from version 2, all variables should be 8-byte aligned
          if (m_version >= 2)
@@ -390,9 +546,17 @@ NXCPMessage::~NXCPMessage()
  */
 NXCP_MESSAGE_FIELD *NXCPMessage::find(UINT32 fieldId) const
 {
-   MessageField *entry;
-   HASH_FIND_INT(m_fields, &fieldId, entry);
-   return (entry != NULL) ? &entry->data : NULL;
+   if (m_index == nullptr)
+      return nullptr;
+
+   uint32_t i = FieldIndexHash(fieldId) & m_indexMask;
+   while(m_index[i] != nullptr)
+   {
+      if (m_index[i]->id == fieldId)
+         return m_index[i]->data;
+      i = (i + 1) & m_indexMask;
+   }
+   return nullptr;
 }
 
 /**
@@ -411,19 +575,19 @@ void *NXCPMessage::set(UINT32 fieldId, BYTE type, const void *value, bool isSign
    {
       case NXCP_DT_INT32:
          entry = CreateMessageField(m_pool, 12);
-         entry->data.df_int32 = *((const UINT32 *)value);
+         entry->data->df_int32 = *((const UINT32 *)value);
          break;
       case NXCP_DT_INT16:
          entry = CreateMessageField(m_pool, 8);
-         entry->data.df_int16 = *((const WORD *)value);
+         entry->data->df_int16 = *((const WORD *)value);
          break;
       case NXCP_DT_INT64:
          entry = CreateMessageField(m_pool, 16);
-         entry->data.df_int64 = *((const UINT64 *)value);
+         entry->data->df_int64 = *((const UINT64 *)value);
          break;
       case NXCP_DT_FLOAT:
          entry = CreateMessageField(m_pool, 16);
-         entry->data.df_real = *((const double *)value);
+         entry->data->df_real = *((const double *)value);
          break;
       case NXCP_DT_STRING:
          if (isUtf8)
@@ -436,8 +600,8 @@ void *NXCPMessage::set(UINT32 fieldId, BYTE type, const void *value, bool isSign
             size_t ucs2length = utf8_to_ucs2(static_cast<const char*>(value), -1, buffer, length + 1);
             ucs2length--;  // Do not count terminating 0
             entry = CreateMessageField(m_pool, 12 + ucs2length * 2);
-            entry->data.df_string.length = (UINT32)(ucs2length * 2);
-            memcpy(entry->data.df_string.value, buffer, entry->data.df_string.length);
+            entry->data->df_string.length = (UINT32)(ucs2length * 2);
+            memcpy(entry->data->df_string.value, buffer, entry->data->df_string.length);
          }
          else
          {
@@ -459,8 +623,8 @@ void *NXCPMessage::set(UINT32 fieldId, BYTE type, const void *value, bool isSign
             size_t ucs2length = mb_to_ucs2(static_cast<const char*>(value), length, ucs2buffer, length + 1);
 #endif
             entry = CreateMessageField(m_pool, 12 + ucs2length * 2);
-            entry->data.df_string.length = static_cast<uint32_t>(ucs2length * 2);
-            memcpy(entry->data.df_string.value, ucs2buffer, entry->data.df_string.length);
+            entry->data->df_string.length = static_cast<uint32_t>(ucs2length * 2);
+            memcpy(entry->data->df_string.value, ucs2buffer, entry->data->df_string.length);
 #undef ucs2buffer
 #undef ucs2length
          }
@@ -472,8 +636,8 @@ void *NXCPMessage::set(UINT32 fieldId, BYTE type, const void *value, bool isSign
             if ((size > 0) && (length > size))
                length = size;
             entry = CreateMessageField(m_pool, 12 + length);
-            entry->data.df_utf8string.length = static_cast<uint32_t>(length);
-            memcpy(entry->data.df_utf8string.value, value, length);
+            entry->data->df_utf8string.length = static_cast<uint32_t>(length);
+            memcpy(entry->data->df_utf8string.value, value, length);
          }
          else
          {
@@ -492,55 +656,49 @@ void *NXCPMessage::set(UINT32 fieldId, BYTE type, const void *value, bool isSign
             entry = CreateMessageField(m_pool, 12 + bufferLength);
 #ifdef UNICODE
 #ifdef UNICODE_UCS4
-            entry->data.df_utf8string.length = (UINT32)ucs4_to_utf8(static_cast<const WCHAR*>(value), length, entry->data.df_utf8string.value, bufferLength);
+            entry->data->df_utf8string.length = (UINT32)ucs4_to_utf8(static_cast<const WCHAR*>(value), length, entry->data->df_utf8string.value, bufferLength);
 #else
-            entry->data.df_utf8string.length = (UINT32)ucs2_to_utf8(static_cast<const WCHAR*>(value), length, entry->data.df_utf8string.value, bufferLength);
+            entry->data->df_utf8string.length = (UINT32)ucs2_to_utf8(static_cast<const WCHAR*>(value), length, entry->data->df_utf8string.value, bufferLength);
 #endif
 #else    /* not UNICODE */
-            entry->data.df_utf8string.length = (UINT32)mb_to_utf8(static_cast<const TCHAR*>(value), length, entry->data.df_utf8string.value, bufferLength);
+            entry->data->df_utf8string.length = (UINT32)mb_to_utf8(static_cast<const TCHAR*>(value), length, entry->data->df_utf8string.value, bufferLength);
 #endif
          }
          break;
       case NXCP_DT_BINARY:
          entry = CreateMessageField(m_pool, 12 + size);
-         entry->data.df_binary.length = (UINT32)size;
-         if ((entry->data.df_binary.length > 0) && (value != NULL))
-            memcpy(entry->data.df_binary.value, value, entry->data.df_binary.length);
+         entry->data->df_binary.length = (UINT32)size;
+         if ((entry->data->df_binary.length > 0) && (value != NULL))
+            memcpy(entry->data->df_binary.value, value, entry->data->df_binary.length);
          break;
       case NXCP_DT_INETADDR:
          entry = CreateMessageField(m_pool, 32);
-         entry->data.df_inetaddr.family =
+         entry->data->df_inetaddr.family =
                   (((InetAddress *)value)->getFamily() == AF_INET) ? NXCP_AF_INET :
                            ((((InetAddress *)value)->getFamily() == AF_INET6) ? NXCP_AF_INET6 : NXCP_AF_UNSPEC);
-         entry->data.df_inetaddr.maskBits = (BYTE)((InetAddress *)value)->getMaskBits();
+         entry->data->df_inetaddr.maskBits = (BYTE)((InetAddress *)value)->getMaskBits();
          if (((InetAddress *)value)->getFamily() == AF_INET)
          {
-            entry->data.df_inetaddr.addr.v4 = ((InetAddress *)value)->getAddressV4();
+            entry->data->df_inetaddr.addr.v4 = ((InetAddress *)value)->getAddressV4();
          }
          else if (((InetAddress *)value)->getFamily() == AF_INET6)
          {
-            memcpy(entry->data.df_inetaddr.addr.v6, ((InetAddress *)value)->getAddressV6(), 16);
+            memcpy(entry->data->df_inetaddr.addr.v6, ((InetAddress *)value)->getAddressV6(), 16);
          }
          break;
       default:
          return NULL;  // Invalid data type, unable to handle
    }
    entry->id = fieldId;
-   entry->data.fieldId = fieldId;
-   entry->data.type = type;
+   entry->data->fieldId = fieldId;
+   entry->data->type = type;
    if (isSigned)
-      entry->data.flags |= NXCP_MFF_SIGNED;
+      entry->data->flags |= NXCP_MFF_SIGNED;
+   entry->size = static_cast<uint32_t>(CalculateFieldSize(entry->data, false));
 
-   // add or replace field
-   MessageField *curr;
-   HASH_FIND_INT(m_fields, &fieldId, curr);
-   if (curr != NULL)
-   {
-      HASH_DEL(m_fields, curr);
-   }
-   HASH_ADD_INT(m_fields, id, entry);
+   addField(entry);
 
-   return (type == NXCP_DT_INT16) ? ((void *)((BYTE *)&entry->data + 6)) : ((void *)((BYTE *)&entry->data + 8));
+   return (type == NXCP_DT_INT16) ? ((void *)((BYTE *)entry->data + 6)) : ((void *)((BYTE *)entry->data + 8));
 }
 
 /**
@@ -1128,27 +1286,28 @@ NXCP_MESSAGE *NXCPMessage::serialize(bool allowCompression) const
    }
    else
    {
-      MessageField *entry, *tmp;
-      HASH_ITER(hh, m_fields, entry, tmp)
+      fieldCount = m_fieldCount;
+      if (m_version >= 2)
       {
-         size_t fieldSize = CalculateFieldSize(&entry->data, false);
-         if (m_version >= 2)
-            size += fieldSize + ((8 - (fieldSize % 8)) & 7);
-         else
-            size += fieldSize;
-         fieldCount++;
+         // Size of aligned fields is maintained when fields are added
+         size += m_fieldsSize;
       }
+      else
+      {
+         for(MessageField *entry = m_fields; entry != nullptr; entry = entry->next)
+            size += entry->size;
 
-      // Message should be aligned to 8 bytes boundary
-      // This is always the case starting from version 2 because
-      // all fields are padded to 8 bytes boundary
-      if (m_version < 2)
+         // Message should be aligned to 8 bytes boundary
+         // This is always the case starting from version 2 because
+         // all fields are padded to 8 bytes boundary
          size += (8 - (size % 8)) & 7;
+      }
    }
 
-   // Create message
+   // Create message (only header and padding bytes need to be cleared,
+   // everything else will be overwritten with field data)
    NXCP_MESSAGE *msg = static_cast<NXCP_MESSAGE*>(MemAlloc(size));
-   memset(msg, 0, size);
+   memset(msg, 0, NXCP_HEADER_SIZE);
    msg->code = htons(m_code);
    msg->flags = htons(m_flags | MF_NXCP_VERSION(m_version));
    msg->size = htonl(static_cast<UINT32>(size));
@@ -1159,15 +1318,15 @@ NXCP_MESSAGE *NXCPMessage::serialize(bool allowCompression) const
    if (m_flags & MF_BINARY)
    {
       memcpy(msg->fields, m_data, m_dataSize);
+      memset(reinterpret_cast<BYTE*>(msg) + NXCP_HEADER_SIZE + m_dataSize, 0, size - NXCP_HEADER_SIZE - m_dataSize);
    }
    else
    {
       NXCP_MESSAGE_FIELD *field = (NXCP_MESSAGE_FIELD *)((char *)msg + NXCP_HEADER_SIZE);
-      MessageField *entry, *tmp;
-      HASH_ITER(hh, m_fields, entry, tmp)
+      for(MessageField *entry = m_fields; entry != nullptr; entry = entry->next)
       {
-         size_t fieldSize = CalculateFieldSize(&entry->data, false);
-         memcpy(field, &entry->data, fieldSize);
+         size_t fieldSize = entry->size;
+         memcpy(field, entry->data, fieldSize);
 
          // Convert numeric values to network format
          field->fieldId = htonl(field->fieldId);
@@ -1206,10 +1365,19 @@ NXCP_MESSAGE *NXCPMessage::serialize(bool allowCompression) const
          }
 
          if (m_version >= 2)
-            field = (NXCP_MESSAGE_FIELD *)((char *)field + fieldSize + ((8 - (fieldSize % 8)) & 7));
+         {
+            size_t padding = (8 - (fieldSize % 8)) & 7;
+            memset((char *)field + fieldSize, 0, padding);
+            field = (NXCP_MESSAGE_FIELD *)((char *)field + fieldSize + padding);
+         }
          else
+         {
             field = (NXCP_MESSAGE_FIELD *)((char *)field + fieldSize);
+         }
       }
+
+      // Clear trailing padding
+      memset(field, 0, reinterpret_cast<char*>(msg) + size - reinterpret_cast<char*>(field));
    }
 
    // Compress message payload if requested. Compression supported starting with NXCP version 4.
@@ -1263,7 +1431,7 @@ NXCP_MESSAGE *NXCPMessage::serialize(bool allowCompression) const
  */
 void NXCPMessage::deleteAllFields()
 {
-   m_fields = nullptr;
+   initFields();
    m_data = nullptr;
    m_dataSize = 0;
    m_pool.clear();
@@ -1622,10 +1790,9 @@ void NXCPMessage::setProtocolVersion(int version)
    {
       // Convert all UTF8-STRING fields to STRING
       IntegerArray<uint32_t> stringFields(256, 256);
-      MessageField *entry, *tmp;
-      HASH_ITER(hh, m_fields, entry, tmp)
+      for(MessageField *entry = m_fields; entry != nullptr; entry = entry->next)
       {
-         if (entry->data.type == NXCP_DT_UTF8_STRING)
+         if (entry->data->type == NXCP_DT_UTF8_STRING)
             stringFields.add(entry->id);
       }
 
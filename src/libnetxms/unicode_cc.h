@@ -88,4 +88,17 @@ enum class CodePageType
 extern char g_cpDefault[];
 extern CodePageType g_defaultCodePageType;
 
+/**
+ * Vectorized fast paths for character conversion functions. Each function
+ * processes leading part of the input and returns number of processed characters.
+ */
+size_t CopyASCIIToUCS4(const BYTE *src, size_t len, UCS4CHAR *dst);
+size_t CopyASCIIToUCS2(const BYTE *src, size_t len, UCS2CHAR *dst);
+size_t CopyUCS4ToASCII(const UCS4CHAR *src, size_t len, char *dst);
+size_t CopyUCS2ToUCS4(const UCS2CHAR *src, size_t len, UCS4CHAR *dst);
+size_t CountASCII(const BYTE *src, size_t len);
+size_t CountUCS4ASCII(const UCS4CHAR *src, size_t len);
+size_t CountUCS4BMP(const UCS4CHAR *src, size_t len);
+void SwapBytes16(UINT16 *v, size_t len);
+
 #endif
@@ -29,10 +29,20 @@
 #include <comdef.h>
 #endif
 
+#if HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#include <poll.h>
+#endif
+
+#if HAVE_SYS_VFS_H
+#include <sys/vfs.h>
+#endif
+
 /**
  * Constants
  */
 #define READ_BUFFER_SIZE      4096
+#define READ_BLOCK_SIZE       65536
 
 /**
  * File encoding names
@@ -169,12 +179,12 @@ static off_t ParseNewRecords(LogParser *parser, int fh)
          break;
    }
 
-   char buffer[READ_BUFFER_SIZE];
+   char *buffer = MemAllocArrayNoInit<char>(READ_BLOCK_SIZE);
    int bytes, bufPos = 0;
    off_t resetPos = _lseek(fh, 0, SEEK_CUR);
    do
    {
-      if ((bytes = _read(fh, &buffer[bufPos], READ_BUFFER_SIZE - bufPos)) > 0)
+      if ((bytes = _read(fh, &buffer[bufPos], READ_BLOCK_SIZE - bufPos)) > 0)
       {
          nxlog_debug_tag(DEBUG_TAG, 7, _T("Read %d bytes into buffer at offset %d"), bytes, bufPos);
          bytes += bufPos;
@@ -195,6 +205,7 @@ static off_t ParseNewRecords(LogParser *parser, int fh)
                   if (parser->isFilePreallocated() && !memcmp(buffer, "\x00\x00\x00\x00", std::min(remaining, 4)))
                   {
                      // Found zeroes in preallocated file, next read should be after last known EOL
+                     MemFree(buffer);
                      return resetPos;
                   }
 					}
@@ -384,6 +395,7 @@ static off_t ParseNewRecords(LogParser *parser, int fh)
          bytes = 0;
       }
    } while(bytes > 0);
+   MemFree(buffer);
    return resetPos;
 }
 
@@ -514,6 +526,291 @@ static void SeekToZero(int fh, int chsize, bool detectBrokenPrealloc)
    }
 }
 
+#if HAVE_SYS_INOTIFY_H
+
+/**
+ * Subscriber for file change notifications
+ */
+struct FileChangeSubscriber
+{
+   char *name;          // File name within watched directory
+   CONDITION condition;
+};
+
+/**
+ * Directory watched by inotify
+ */
+struct WatchedDirectory
+{
+   int wd;
+   StructArray<FileChangeSubscriber> subscribers;
+
+   WatchedDirectory(int _wd) : subscribers(0, 16)
+   {
+      wd = _wd;
+   }
+};
+
+/**
+ * Shared inotify instance for all log parsers
+ */
+static Mutex s_notifierLock;
+static int s_inotifyFd = -1;
+static THREAD s_notifierThread = INVALID_THREAD_HANDLE;
+static bool s_notifierShutdown = false;
+static ObjectArray<WatchedDirectory> s_watchedDirectories(16, 16, Ownership::True);
+
+/**
+ * Events watched on directories with monitored files. Directory (not file) is watched so file
+ * re-creation after rotation is reported as well.
+ */
+#define WATCHED_EVENTS (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF)
+
+/**
+ * File change notifier thread
+ */
+static void FileChangeNotifierThread()
+{
+   ThreadSetName("LogWatchNotify");
+
+   alignas(struct inotify_event) char buffer[16384];
+   while(!s_notifierShutdown)
+   {
+      struct pollfd pfd;
+      pfd.fd = s_inotifyFd;
+      pfd.events = POLLIN;
+      if (poll(&pfd, 1, 1000) <= 0)
+         continue;
+
+      ssize_t bytes = read(s_inotifyFd, buffer, sizeof(buffer));
+      if (bytes <= 0)
+         continue;
+
+      s_notifierLock.lock();
+      for(char *curr = buffer; curr < buffer + bytes;)
+      {
+         struct inotify_event *e = reinterpret_cast<struct inotify_event*>(curr);
+         for(int i = 0; i < s_watchedDirectories.size(); i++)
+         {
+            WatchedDirectory *d = s_watchedDirectories.get(i);
+            if ((d->wd != e->wd) && !(e->mask & IN_Q_OVERFLOW))
+               continue;
+            for(int j = 0; j < d->subscribers.size(); j++)
+            {
+               FileChangeSubscriber *s = d->subscribers.get(j);
+               if ((e->len == 0) || !strcmp(e->name, s->name))
+                  ConditionSet(s->condition);
+            }
+         }
+         curr += sizeof(struct inotify_event) + e->len;
+      }
+      s_notifierLock.unlock();
+   }
+}
+
+/**
+ * Check if given path is located on network or cluster file system where inotify does not report
+ * changes made by other hosts.
+ */
+static bool IsNetworkFileSystem(const char *path)
+{
+#if HAVE_SYS_VFS_H
+   struct statfs fs;
+   if (statfs(path, &fs) != 0)
+      return true;   // Cannot determine, use polling
+   switch(static_cast<uint32_t>(fs.f_type))
+   {
+      case 0x00006969:  // NFS
+      case 0x0000517B:  // SMB
+      case 0xFF534D42:  // CIFS
+      case 0xFE534D42:  // SMB2
+      case 0x65735546:  // FUSE
+      case 0x00C36400:  // Ceph
+      case 0x01021997:  // 9P
+      case 0x5346414F:  // AFS
+      case 0x01161970:  // GFS2
+      case 0x7461636F:  // OCFS2
+      case 0x47504653:  // GPFS
+         return true;
+   }
+#endif
+   return false;
+}
+
+/**
+ * Subscribe to change notifications for given file. Given condition will be set on any change
+ * of the file or its name. Returns false if notifications are not available for this file.
+ */
+static bool SubscribeToFileChanges(const TCHAR *fileName, CONDITION condition)
+{
+#ifdef UNICODE
+   char *path = MBStringFromWideString(fileName);
+#else
+   char *path = MemCopyStringA(fileName);
+#endif
+
+   // Writes to symlink target do not generate events in directory containing the link
+   struct stat st;
+   if ((lstat(path, &st) == 0) && S_ISLNK(st.st_mode))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("File \"%s\" is a symbolic link, change notifications will not be used"), fileName);
+      MemFree(path);
+      return false;
+   }
+
+   const char *dir, *name;
+   char *s = strrchr(path, '/');
+   if (s != nullptr)
+   {
+      *s = 0;
+      dir = (s == path) ? "/" : path;
+      name = s + 1;
+   }
+   else
+   {
+      dir = ".";
+      name = path;
+   }
+
+   if (IsNetworkFileSystem(dir))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("File \"%s\" is located on network file system, change notifications will not be used"), fileName);
+      MemFree(path);
+      return false;
+   }
+
+   bool success = false;
+   s_notifierLock.lock();
+   if (s_inotifyFd == -1)
+   {
+      s_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (s_inotifyFd != -1)
+      {
+         s_notifierShutdown = false;
+         s_notifierThread = ThreadCreateEx(FileChangeNotifierThread);
+      }
+      else
+      {
+         nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot initialize inotify (%s)"), _tcserror(errno));
+      }
+   }
+   if (s_inotifyFd != -1)
+   {
+      int wd = inotify_add_watch(s_inotifyFd, dir, WATCHED_EVENTS);
+      if (wd != -1)
+      {
+         WatchedDirectory *d = nullptr;
+         for(int i = 0; i < s_watchedDirectories.size(); i++)
+         {
+            if (s_watchedDirectories.get(i)->wd == wd)
+            {
+               d = s_watchedDirectories.get(i);
+               break;
+            }
+         }
+         if (d == nullptr)
+         {
+            d = new WatchedDirectory(wd);
+            s_watchedDirectories.add(d);
+         }
+
+         FileChangeSubscriber subscriber;
+         subscriber.name = MemCopyStringA(name);
+         subscriber.condition = condition;
+         d->subscribers.add(subscriber);
+         success = true;
+      }
+      else
+      {
+         nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot add inotify watch for file \"%s\" (%s)"), fileName, _tcserror(errno));
+      }
+   }
+   s_notifierLock.unlock();
+
+   MemFree(path);
+   return success;
+}
+
+/**
+ * Cancel change notifications associated with given condition
+ */
+static void UnsubscribeFromFileChanges(CONDITION condition)
+{
+   s_notifierLock.lock();
+   for(int i = 0; i < s_watchedDirectories.size(); i++)
+   {
+      WatchedDirectory *d = s_watchedDirectories.get(i);
+      for(int j = 0; j < d->subscribers.size(); j++)
+      {
+         FileChangeSubscriber *s = d->subscribers.get(j);
+         if (s->condition == condition)
+         {
+            MemFree(s->name);
+            d->subscribers.remove(j);
+            j--;
+         }
+      }
+      if (d->subscribers.isEmpty())
+      {
+         if (s_inotifyFd != -1)
+            inotify_rm_watch(s_inotifyFd, d->wd);
+         s_watchedDirectories.remove(i);
+         i--;
+      }
+   }
+   s_notifierLock.unlock();
+}
+
+/**
+ * Stop file change notifier
+ */
+void ShutdownFileChangeNotifier()
+{
+   s_notifierLock.lock();
+   THREAD thread = s_notifierThread;
+   s_notifierThread = INVALID_THREAD_HANDLE;
+   s_notifierShutdown = true;
+   s_notifierLock.unlock();
+
+   ThreadJoin(thread);
+
+   s_notifierLock.lock();
+   if (s_inotifyFd != -1)
+   {
+      close(s_inotifyFd);
+      s_inotifyFd = -1;
+   }
+   for(int i = 0; i < s_watchedDirectories.size(); i++)
+   {
+      WatchedDirectory *d = s_watchedDirectories.get(i);
+      for(int j = 0; j < d->subscribers.size(); j++)
+         MemFree(d->subscribers.get(j)->name);
+   }
+   s_watchedDirectories.clear();
+   s_notifierLock.unlock();
+}
+
+#endif   /* HAVE_SYS_INOTIFY_H */
+
+/**
+ * Wait for creation of given file (or for 10 seconds if change notifications are not available).
+ * Returns true if stop condition was set while waiting.
+ */
+static bool WaitForFileCreation(const TCHAR *fileName, CONDITION changeCondition, CONDITION stopCondition)
+{
+#if HAVE_SYS_INOTIFY_H
+   if (SubscribeToFileChanges(fileName, changeCondition))
+   {
+      NX_STAT_STRUCT st;
+      if (CALL_STAT(fileName, &st) != 0)   // File could be created before subscription
+         ConditionWait(changeCondition, 10000);
+      UnsubscribeFromFileChanges(changeCondition);
+      return ConditionWait(stopCondition, 0);
+   }
+#endif
+   return ConditionWait(stopCondition, 10000);
+}
+
 /**
  * File parser thread
  */
@@ -568,12 +865,12 @@ bool LogParser::monitorFile()
 	   }
 
       ExpandFileName(getFileName(), fname, MAX_PATH, true);
-		if (CALL_STAT(fname, &st) != 0)
+		if (CALL_STAT_FOLLOW_SYMLINK(fname, &st) != 0)
       {
          if (errno == ENOENT)
             readFromStart = true;
          setStatus(LPS_NO_FILE);
-         if (ConditionWait(m_stopCondition, 10000))
+         if (WaitForFileCreation(fname, m_fileChangeCondition, m_stopCondition))
             break;
          continue;
       }
@@ -618,10 +915,35 @@ bool LogParser::monitorFile()
 			_lseek(fh, 0, SEEK_END);
 		}
 
+#if HAVE_SYS_INOTIFY_H
+		// Use change notifications if possible and check file state at least once per minute as safety net
+		bool notifications = SubscribeToFileChanges(fname, m_fileChangeCondition);
+		nxlog_debug_tag(DEBUG_TAG, 5, _T("Changes in file \"%s\" will be detected by %s"), fname, notifications ? _T("inotify") : _T("polling"));
+#endif
+
 		while(true)
 		{
+#if HAVE_SYS_INOTIFY_H
+		   bool stop;
+		   if (notifications)
+		   {
+		      ConditionWait(m_fileChangeCondition, 60000);
+		      stop = ConditionWait(m_stopCondition, 0);
+		   }
+		   else
+		   {
+		      stop = ConditionWait(m_stopCondition, 5000);
+		   }
+		   if (stop)
+		   {
+		      if (notifications)
+		         UnsubscribeFromFileChanges(m_fileChangeCondition);
+		      goto stop_parser;
+		   }
+#else
 			if (ConditionWait(m_stopCondition, 5000))
 				goto stop_parser;
+#endif
 
 			// Check if file name was changed
 			ExpandFileName(getFileName(), temp, MAX_PATH, true);
@@ -639,9 +961,10 @@ bool LogParser::monitorFile()
 				break;
 			}
 
-			if (CALL_STAT(fname, &stn) < 0)
+			if (CALL_STAT_FOLLOW_SYMLINK(fname, &stn) < 0)
 			{
 				nxlog_debug_tag(DEBUG_TAG, 1, _T("stat(%s) failed, errno=%d"), fname, errno);
+				ParseNewRecords(this, fh);   // File could be renamed or deleted, read records written before that
 				readFromStart = true;
 				break;
 			}
@@ -657,6 +980,7 @@ bool LogParser::monitorFile()
 			if ((st.st_ino != stn.st_ino) || (st.st_dev != stn.st_dev))
 			{
 				nxlog_debug_tag(DEBUG_TAG, 3, _T("File device or inode differs for stat(%d) and fstat(%s), assume file rename"), fh, fname);
+				ParseNewRecords(this, fh);   // Read records written to renamed file before switching to new one
 				readFromStart = true;
 				break;
 			}
@@ -716,6 +1040,10 @@ bool LogParser::monitorFile()
 				break;
 			}
 		}
+#if HAVE_SYS_INOTIFY_H
+		if (notifications)
+		   UnsubscribeFromFileChanges(m_fileChangeCondition);
+#endif
 		_close(fh);
 	}
 
@@ -30,6 +30,10 @@
 
 #define DEBUG_TAG _T("logwatch")
 
+#if HAVE_SYS_INOTIFY_H
+void ShutdownFileChangeNotifier();
+#endif
+
 #ifdef _WIN32
 
 THREAD_RESULT THREAD_CALL ParserThreadEventLog(void *);
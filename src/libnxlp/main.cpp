@@ -65,6 +65,10 @@ void LIBNXLP_EXPORTABLE CleanupLogParserLibrary()
    if (InterlockedDecrement(&s_referenceCount) > 0)
       return;  // still referenced
 
+#if HAVE_SYS_INOTIFY_H
+   ShutdownFileChangeNotifier();
+#endif
+
 #ifdef _WIN32
    if (!s_eventLogV6)
    {
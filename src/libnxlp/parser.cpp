@@ -127,6 +127,7 @@ LogParser::LogParser()
 	m_eventResolver = NULL;
 	m_thread = INVALID_THREAD_HANDLE;
    m_stopCondition = ConditionCreate(true);
+   m_fileChangeCondition = ConditionCreate(false);
 	m_recordsProcessed = 0;
 	m_recordsMatched = 0;
 	m_processAllRules = false;
@@ -177,6 +178,7 @@ LogParser::LogParser(const LogParser *src)
 	m_eventResolver = src->m_eventResolver;
 	m_thread = INVALID_THREAD_HANDLE;
    m_stopCondition = ConditionCreate(true);
+   m_fileChangeCondition = ConditionCreate(false);
    m_recordsProcessed = 0;
 	m_recordsMatched = 0;
 	m_processAllRules = src->m_processAllRules;
@@ -203,6 +205,7 @@ LogParser::~LogParser()
    MemFree(m_marker);
 #endif
    ConditionDestroy(m_stopCondition);
+   ConditionDestroy(m_fileChangeCondition);
 }
 
 /**
@@ -993,6 +996,7 @@ bool LogParser::isExclusionPeriod()
 void LogParser::stop()
 {
    ConditionSet(m_stopCondition);
+   ConditionSet(m_fileChangeCondition);
    ThreadJoin(m_thread);
    m_thread = INVALID_THREAD_HANDLE;
 }
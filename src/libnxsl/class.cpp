@@ -73,6 +73,7 @@ NXSL_Class::NXSL_Class()
 {
    setName(_T("Object"));
    m_methods = new HashMap<NXSL_Identifier, NXSL_ExtMethod>(Ownership::True);
+   m_attributeHandlers = new HashMap<NXSL_Identifier, NXSL_ExtAttribute>(Ownership::True);
    m_metadataLock = MutexCreateFast();
 
    NXSL_REGISTER_METHOD(Object, __get, 1);
@@ -92,6 +93,7 @@ NXSL_Class::NXSL_Class()
 NXSL_Class::~NXSL_Class()
 {
    delete m_methods;
+   delete m_attributeHandlers;
    MutexDestroy(m_metadataLock);
 }
 
@@ -104,12 +106,36 @@ void NXSL_Class::setName(const TCHAR *name)
    m_classHierarchy.add(name);
 }
 
+/**
+ * Callback for adding registered attribute names to attribute list
+ */
+static EnumerationCallbackResult AddAttributeName(const NXSL_Identifier& name, NXSL_ExtAttribute *attribute, StringSet *attributes)
+{
+#ifdef UNICODE
+   attributes->addPreallocated(WideStringFromUTF8String(name.value));
+#else
+   attributes->add(name.value);
+#endif
+   return _CONTINUE;
+}
+
 /**
  * Get attribute
- * Default implementation always returns error
+ * Default implementation calls attributes registered with NXSL_REGISTER_ATTRIBUTE macro.
  */
 NXSL_Value *NXSL_Class::getAttr(NXSL_Object *object, const char *attr)
 {
+   if (*attr == '?')
+   {
+      m_attributeHandlers->forEach(AddAttributeName, &m_attributes);
+   }
+   else
+   {
+      NXSL_ExtAttribute *a = m_attributeHandlers->get(attr);
+      if (a != nullptr)
+         return a->handler(object, object->vm());
+   }
+
    if (compareAttributeName(attr, "__class"))
       return object->vm()->createValue(new NXSL_Object(object->vm(), &g_nxslMetaClass, object->getClass()));
    return nullptr;
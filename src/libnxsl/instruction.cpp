@@ -33,6 +33,8 @@ NXSL_Instruction::NXSL_Instruction(NXSL_ValueManager *vm, int line, INT16 opCode
    m_sourceLine = line;
    m_stackItems = 0;
    m_addr2 = INVALID_ADDRESS;
+   m_cachedClass = nullptr;
+   m_cachedAttribute = nullptr;
 }
 
 /**
@@ -46,6 +48,8 @@ NXSL_Instruction::NXSL_Instruction(NXSL_ValueManager *vm, int line, INT16 opCode
    m_operand.m_constant = value;
    m_stackItems = 0;
    m_addr2 = INVALID_ADDRESS;
+   m_cachedClass = nullptr;
+   m_cachedAttribute = nullptr;
 }
 
 /**
@@ -59,6 +63,8 @@ NXSL_Instruction::NXSL_Instruction(NXSL_ValueManager *vm, int line, INT16 opCode
    m_operand.m_identifier = new NXSL_Identifier(identifier);
    m_stackItems = 0;
    m_addr2 = INVALID_ADDRESS;
+   m_cachedClass = nullptr;
+   m_cachedAttribute = nullptr;
 }
 
 /**
@@ -72,6 +78,8 @@ NXSL_Instruction::NXSL_Instruction(NXSL_ValueManager *vm, int line, INT16 opCode
    m_operand.m_identifier = new NXSL_Identifier(identifier);
    m_stackItems = stackItems;
    m_addr2 = addr2;
+   m_cachedClass = nullptr;
+   m_cachedAttribute = nullptr;
 }
 
 /**
@@ -85,6 +93,8 @@ NXSL_Instruction::NXSL_Instruction(NXSL_ValueManager *vm, int line, INT16 opCode
    m_operand.m_addr = addr;
    m_stackItems = 0;
    m_addr2 = INVALID_ADDRESS;
+   m_cachedClass = nullptr;
+   m_cachedAttribute = nullptr;
 }
 
 /**
@@ -97,6 +107,8 @@ NXSL_Instruction::NXSL_Instruction(NXSL_ValueManager *vm, int line, INT16 opCode
    m_sourceLine = line;
    m_stackItems = stackItems;
    m_addr2 = INVALID_ADDRESS;
+   m_cachedClass = nullptr;
+   m_cachedAttribute = nullptr;
 }
 
 /**
@@ -116,11 +128,17 @@ NXSL_Instruction::NXSL_Instruction(NXSL_ValueManager *vm, NXSL_Instruction *src)
       case OP_TYPE_IDENTIFIER:
          m_operand.m_identifier = new NXSL_Identifier(*src->m_operand.m_identifier);
          break;
+      case OP_TYPE_REGEXP:
+         m_operand.m_regexp = src->m_operand.m_regexp;
+         m_operand.m_regexp->incRefCount();
+         break;
       default:
          m_operand.m_addr = src->m_operand.m_addr;
          break;
    }
    m_addr2 = src->m_addr2;
+   m_cachedClass = nullptr;
+   m_cachedAttribute = nullptr;
 }
 
 /**
@@ -136,6 +154,9 @@ NXSL_Instruction::~NXSL_Instruction()
       case OP_TYPE_CONST:
          m_vm->destroyValue(m_operand.m_constant);
          break;
+      case OP_TYPE_REGEXP:
+         m_operand.m_regexp->decRefCount();
+         break;
       default:
          break;
    }
@@ -177,6 +198,7 @@ OperandType NXSL_Instruction::getOperandType()
 		case OPCODE_CASE:
       case OPCODE_CASE_LT:
       case OPCODE_CASE_GT:
+      case OPCODE_JZ_CMP_CONST:
       case OPCODE_PUSH_CONSTANT:
          return OP_TYPE_CONST;
       case OPCODE_PUSH_VARPTR:
@@ -196,6 +218,9 @@ OperandType NXSL_Instruction::getOperandType()
          return OP_TYPE_ADDR;
       case OPCODE_CALL_EXTPTR:
          return OP_TYPE_EXT_FUNCTION;
+      case OPCODE_MATCH_CONST:
+      case OPCODE_IMATCH_CONST:
+         return OP_TYPE_REGEXP;
       default:
          return OP_TYPE_NONE;
    }
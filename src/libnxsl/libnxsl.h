@@ -29,6 +29,7 @@
 #include <nxcpapi.h>
 #include <nxsl.h>
 #include <nxqueue.h>
+#include <netxms-regex.h>
 
 union YYSTYPE;
 typedef void *yyscan_t;
@@ -143,6 +144,9 @@ typedef void *yyscan_t;
 #define OPCODE_CASE_GT        98
 #define OPCODE_CASE_CONST_GT  99
 #define OPCODE_PUSH_PROPERTY  100
+#define OPCODE_MATCH_CONST    101
+#define OPCODE_IMATCH_CONST   102
+#define OPCODE_JZ_CMP_CONST   103
 
 class NXSL_Compiler;
 
@@ -221,6 +225,46 @@ class NXSL_Compiler
 	int getIdentifierOperation() { return m_idOpCode; }
 };
 
+/**
+ * Compiled regular expression. Compiled pattern is immutable and can be
+ * shared between VM instances and threads.
+ */
+class NXSL_Regexp : public RefCountObject
+{
+   friend NXSL_Regexp *AcquireCachedRegexp(const TCHAR *pattern, bool ignoreCase);
+
+private:
+   PCRE *m_preg;
+   PCRE_EXTRA_T *m_extra;
+   TCHAR *m_pattern;
+   bool m_ignoreCase;
+   NXSL_Regexp *m_prev;   // LRU list links (used only by regexp cache)
+   NXSL_Regexp *m_next;
+
+   NXSL_Regexp(PCRE *preg, const TCHAR *pattern, bool ignoreCase);
+
+   void unlinkFromLRU();
+   void linkToLRUHead();
+
+protected:
+   virtual ~NXSL_Regexp();
+
+public:
+   static NXSL_Regexp *compile(const TCHAR *pattern, bool ignoreCase);
+
+   int exec(const TCHAR *subject, int length, int *pmatch, int size) const;
+
+   const TCHAR *getPattern() const { return m_pattern; }
+   bool isIgnoreCase() const { return m_ignoreCase; }
+};
+
+NXSL_Regexp *AcquireCachedRegexp(const TCHAR *pattern, bool ignoreCase);
+
+/**
+ * Select data type for binary operation result
+ */
+int SelectResultType(int type1, int type2, int op);
+
 /**
  * Class registry
  */
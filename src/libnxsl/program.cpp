@@ -56,7 +56,8 @@ static const char *s_nxslCommandMnemonic[] =
    "PUSH", "SET", "CALL", "INC", "DEC",
    "INCP", "DECP", "IN", "PUSH", "SET",
    "UPDATE", "CLREXPR", "RANGE", "CASELT",
-   "CASELT", "CASEGT", "CASEGT", "PUSH"
+   "CASELT", "CASEGT", "CASEGT", "PUSH",
+   "MATCH", "IMATCH", "JZCMP"
 };
 
 /**
@@ -69,6 +70,7 @@ NXSL_Program::NXSL_Program() : NXSL_ValueManager()
    m_functions = new ObjectArray<NXSL_Function>(16, 16, Ownership::True);
    m_requiredModules = new ObjectArray<NXSL_ModuleImport>(4, 4, Ownership::True);
    m_expressionVariables = NULL;
+   m_jumpTargets = nullptr;
 }
 
 /**
@@ -81,6 +83,7 @@ NXSL_Program::~NXSL_Program()
    delete m_functions;
    delete m_requiredModules;
    delete m_expressionVariables;
+   MemFree(m_jumpTargets);
 }
 
 /**
@@ -361,6 +364,17 @@ void NXSL_Program::dump(FILE *fp, const ObjectArray<NXSL_Instruction> *instructi
             else
                _ftprintf(fp, _T("\"%s\"\n"), instr->m_operand.m_constant->getValueAsCString());
             break;
+         case OPCODE_MATCH_CONST:
+         case OPCODE_IMATCH_CONST:
+            _ftprintf(fp, _T("\"%s\"\n"), instr->m_operand.m_regexp->getPattern());
+            break;
+         case OPCODE_JZ_CMP_CONST:
+            if (instr->m_operand.m_constant->isNull())
+               _ftprintf(fp, _T("%hs <null>, %04X\n"), s_nxslCommandMnemonic[instr->m_stackItems], instr->m_addr2);
+            else
+               _ftprintf(fp, _T("%hs \"%s\", %04X\n"), s_nxslCommandMnemonic[instr->m_stackItems],
+                        instr->m_operand.m_constant->getValueAsCString(), instr->m_addr2);
+            break;
          case OPCODE_POP:
          case OPCODE_PUSHCP:
          case OPCODE_STORAGE_READ:
@@ -387,6 +401,189 @@ uint32_t NXSL_Program::getFinalJumpDestination(uint32_t addr, int srcJump)
 	return addr;
 }
 
+/**
+ * Build map of jump destinations, so optimizer can check instructions without scanning whole program.
+ * Map is kept up to date by removeInstructions() and should be rebuilt if jump addresses are changed otherwise.
+ */
+void NXSL_Program::buildJumpTargetMap()
+{
+   MemFree(m_jumpTargets);
+   m_jumpTargets = MemAllocArray<BYTE>(m_instructionSet->size() + 1);
+   updateJumpTargetMap();
+}
+
+/**
+ * Update map of jump destinations after instructions were removed
+ */
+void NXSL_Program::updateJumpTargetMap()
+{
+   uint32_t size = static_cast<uint32_t>(m_instructionSet->size()) + 1;
+   memset(m_jumpTargets, 0, size);
+   for(int i = 0; i < m_instructionSet->size(); i++)
+   {
+      NXSL_Instruction *instr = m_instructionSet->get(i);
+      if ((instr->getOperandType() == OP_TYPE_ADDR) && (instr->m_operand.m_addr < size))
+         m_jumpTargets[instr->m_operand.m_addr] = 1;
+      if (instr->m_addr2 < size)
+         m_jumpTargets[instr->m_addr2] = 1;
+   }
+   for(int i = 0; i < m_functions->size(); i++)
+   {
+      uint32_t addr = m_functions->get(i)->m_addr;
+      if (addr < size)
+         m_jumpTargets[addr] = 1;
+   }
+}
+
+/**
+ * Check if given address is a destination of any jump or call or function entry point
+ */
+bool NXSL_Program::isJumpDestination(uint32_t addr)
+{
+   if (m_jumpTargets != nullptr)
+      return (addr <= static_cast<uint32_t>(m_instructionSet->size())) && (m_jumpTargets[addr] != 0);
+
+   for(int i = 0; i < m_instructionSet->size(); i++)
+   {
+      NXSL_Instruction *instr = m_instructionSet->get(i);
+      if ((instr->getOperandType() == OP_TYPE_ADDR) && (instr->m_operand.m_addr == addr))
+         return true;
+      if (instr->m_addr2 == addr)
+         return true;
+   }
+   for(int i = 0; i < m_functions->size(); i++)
+   {
+      if (m_functions->get(i)->m_addr == addr)
+         return true;
+   }
+   return false;
+}
+
+/**
+ * Calculate result of binary operation on two constant values at compile time.
+ * Only operations which cannot fail or depend on run time state are folded.
+ * Returns NULL if operation cannot be folded.
+ */
+NXSL_Value *NXSL_Program::foldBinaryOperation(int opcode, const NXSL_Value *value1, const NXSL_Value *value2)
+{
+   if (value1->isNull() || value2->isNull())
+      return nullptr;
+
+   NXSL_Value *result = nullptr;
+   if (value1->isNumeric() && value2->isNumeric() && (opcode != OPCODE_CONCAT))
+   {
+      int type = SelectResultType(value1->getDataType(), value2->getDataType(), opcode);
+      if (type == NXSL_DT_NULL)
+         return nullptr;
+
+      NXSL_Value *v1 = createValue(value1);
+      NXSL_Value *v2 = createValue(value2);
+      if (v1->convert(type) && v2->convert(type))
+      {
+         switch(opcode)
+         {
+            case OPCODE_ADD:
+               v1->add(v2);
+               result = v1;
+               break;
+            case OPCODE_SUB:
+               v1->sub(v2);
+               result = v1;
+               break;
+            case OPCODE_MUL:
+               v1->mul(v2);
+               result = v1;
+               break;
+            case OPCODE_DIV:
+               v1->div(v2);
+               result = v1;
+               break;
+            case OPCODE_REM:
+               // Leave division by zero (and overflow on division by -1) to run time
+               if ((v2->getValueAsInt64() != 0) && (v2->getValueAsInt64() != -1))
+               {
+                  v1->rem(v2);
+                  result = v1;
+               }
+               break;
+            case OPCODE_LSHIFT:
+               v1->lshift(v2->getValueAsInt32());
+               result = v1;
+               break;
+            case OPCODE_RSHIFT:
+               v1->rshift(v2->getValueAsInt32());
+               result = v1;
+               break;
+            case OPCODE_BIT_AND:
+               v1->bitAnd(v2);
+               result = v1;
+               break;
+            case OPCODE_BIT_OR:
+               v1->bitOr(v2);
+               result = v1;
+               break;
+            case OPCODE_BIT_XOR:
+               v1->bitXor(v2);
+               result = v1;
+               break;
+            case OPCODE_EQ:
+               result = createValue(static_cast<INT32>(v1->EQ(v2)));
+               break;
+            case OPCODE_NE:
+               result = createValue(static_cast<INT32>(!v1->EQ(v2)));
+               break;
+            case OPCODE_LT:
+               result = createValue(static_cast<INT32>(v1->LT(v2)));
+               break;
+            case OPCODE_LE:
+               result = createValue(static_cast<INT32>(v1->LE(v2)));
+               break;
+            case OPCODE_GT:
+               result = createValue(static_cast<INT32>(v1->GT(v2)));
+               break;
+            case OPCODE_GE:
+               result = createValue(static_cast<INT32>(v1->GE(v2)));
+               break;
+            default:
+               break;
+         }
+      }
+      if (result != v1)
+         destroyValue(v1);
+      destroyValue(v2);
+   }
+   else if (value1->isString() && value2->isString())
+   {
+      NXSL_Value *v2 = createValue(value2);
+      UINT32 len2;
+      const TCHAR *text2 = v2->getValueAsString(&len2);
+      switch(opcode)
+      {
+         case OPCODE_CONCAT:
+            result = createValue(value1);
+            result->convert(NXSL_DT_STRING);
+            result->concatenate(text2, len2);
+            break;
+         case OPCODE_EQ:
+         case OPCODE_NE:
+            if (!value1->isNumeric() && !value2->isNumeric())
+            {
+               NXSL_Value *v1 = createValue(value1);
+               UINT32 len1;
+               const TCHAR *text1 = v1->getValueAsString(&len1);
+               bool equals = (len1 == len2) && !memcmp(text1, text2, len1 * sizeof(TCHAR));
+               result = createValue(static_cast<INT32>((opcode == OPCODE_EQ) ? equals : !equals));
+               destroyValue(v1);
+            }
+            break;
+         default:
+            break;
+      }
+      destroyValue(v2);
+   }
+   return result;
+}
+
 /**
  * Optimize compiled program
  */
@@ -394,6 +591,38 @@ void NXSL_Program::optimize()
 {
 	int i;
 
+	// Replace references to constants defined in this program with constant values.
+	// Program constants are added to VM first and cannot be redefined by environment or modules.
+	for(i = 0; i < m_instructionSet->size(); i++)
+	{
+      NXSL_Instruction *instr = m_instructionSet->get(i);
+      int opcode;
+      switch(instr->m_opCode)
+      {
+         case OPCODE_PUSH_VARIABLE:
+            opcode = OPCODE_PUSH_CONSTANT;
+            break;
+         case OPCODE_CASE_CONST:
+            opcode = OPCODE_CASE;
+            break;
+         case OPCODE_CASE_CONST_LT:
+            opcode = OPCODE_CASE_LT;
+            break;
+         case OPCODE_CASE_CONST_GT:
+            opcode = OPCODE_CASE_GT;
+            break;
+         default:
+            continue;
+      }
+      NXSL_Value *value = m_constants->get(*instr->m_operand.m_identifier);
+      if (value != nullptr)
+      {
+         delete instr->m_operand.m_identifier;
+         instr->m_operand.m_constant = createValue(value);
+         instr->m_opCode = opcode;
+      }
+	}
+
 	// Convert push constant followed by NEG to single push constant
 	for(i = 0; (m_instructionSet->size() > 1) && (i < m_instructionSet->size() - 1); i++)
 	{
@@ -408,6 +637,52 @@ void NXSL_Program::optimize()
 		}
 	}
 
+	// Fold binary operations on two constants into single push constant
+	buildJumpTargetMap();
+	for(i = 0; (m_instructionSet->size() > 3) && (i < m_instructionSet->size() - 3); i++)
+	{
+      NXSL_Instruction *instr = m_instructionSet->get(i);
+      NXSL_Instruction *next = m_instructionSet->get(i + 1);
+		if ((instr->m_opCode == OPCODE_PUSH_CONSTANT) &&
+		    (next->m_opCode == OPCODE_PUSH_CONSTANT) &&
+			 !isJumpDestination(i + 1) && !isJumpDestination(i + 2))
+		{
+		   NXSL_Value *result = foldBinaryOperation(m_instructionSet->get(i + 2)->m_opCode,
+		            instr->m_operand.m_constant, next->m_operand.m_constant);
+		   if (result != nullptr)
+		   {
+		      destroyValue(instr->m_operand.m_constant);
+		      instr->m_operand.m_constant = result;
+		      removeInstructions(i + 1, 2);
+		      i = std::max(i - 2, -1);   // Result can be an operand for preceding constant
+		   }
+		}
+	}
+
+	// Convert push constant followed by MATCH/IMATCH to single match with precompiled regular expression
+	for(i = 0; (m_instructionSet->size() > 1) && (i < m_instructionSet->size() - 1); i++)
+	{
+      NXSL_Instruction *instr = m_instructionSet->get(i);
+      NXSL_Instruction *next = m_instructionSet->get(i + 1);
+		if ((instr->m_opCode == OPCODE_PUSH_CONSTANT) &&
+		    ((next->m_opCode == OPCODE_MATCH) || (next->m_opCode == OPCODE_IMATCH)) &&
+			 instr->m_operand.m_constant->isString() &&
+			 !isJumpDestination(i + 1))
+		{
+		   // Invalid patterns are left as is so error will be reported at run time
+         bool ignoreCase = (next->m_opCode == OPCODE_IMATCH);
+		   NXSL_Regexp *regexp = NXSL_Regexp::compile(instr->m_operand.m_constant->getValueAsCString(), ignoreCase);
+		   if (regexp != nullptr)
+		   {
+		      destroyValue(instr->m_operand.m_constant);
+		      instr->m_operand.m_regexp = regexp;
+		      instr->m_opCode = ignoreCase ? OPCODE_IMATCH_CONST : OPCODE_MATCH_CONST;
+		      instr->m_sourceLine = next->m_sourceLine;
+		      removeInstructions(i + 1, 1);
+		   }
+		}
+	}
+
 	// Convert jumps to address beyond code end to NRETs
 	for(i = 0; i < m_instructionSet->size(); i++)
 	{
@@ -461,6 +736,31 @@ void NXSL_Program::optimize()
 			i--;
 		}
 	}
+
+	// Convert comparison with constant followed by conditional jump to single instruction
+	buildJumpTargetMap();   // jump addresses were changed by previous steps
+	for(i = 0; (m_instructionSet->size() > 3) && (i < m_instructionSet->size() - 3); i++)
+	{
+      NXSL_Instruction *instr = m_instructionSet->get(i);
+      NXSL_Instruction *cmp = m_instructionSet->get(i + 1);
+      NXSL_Instruction *jump = m_instructionSet->get(i + 2);
+		if ((instr->m_opCode == OPCODE_PUSH_CONSTANT) &&
+		    ((cmp->m_opCode == OPCODE_EQ) || (cmp->m_opCode == OPCODE_NE) ||
+		     (cmp->m_opCode == OPCODE_LT) || (cmp->m_opCode == OPCODE_LE) ||
+		     (cmp->m_opCode == OPCODE_GT) || (cmp->m_opCode == OPCODE_GE)) &&
+		    (jump->m_opCode == OPCODE_JZ) &&
+			 !isJumpDestination(i + 1) && !isJumpDestination(i + 2))
+		{
+		   instr->m_opCode = OPCODE_JZ_CMP_CONST;
+		   instr->m_stackItems = cmp->m_opCode;
+		   instr->m_addr2 = jump->m_operand.m_addr;
+		   instr->m_sourceLine = cmp->m_sourceLine;
+		   removeInstructions(i + 1, 2);
+		}
+	}
+
+	MemFree(m_jumpTargets);
+	m_jumpTargets = nullptr;
 }
 
 /**
@@ -508,6 +808,23 @@ void NXSL_Program::removeInstructions(uint32_t start, int count)
          f->m_addr -= count;
       }
    }
+
+   if (m_jumpTargets != nullptr)
+      updateJumpTargetMap();
+}
+
+/**
+ * Find constant in serialization constant list and add it if not found. Returns constant index.
+ */
+static INT32 FindOrAddConstant(ObjectRefArray<NXSL_Value> *constants, NXSL_Value *value)
+{
+   for(int i = 0; i < constants->size(); i++)
+   {
+      if (constants->get(i)->equals(value))
+         return i;
+   }
+   constants->add(value);
+   return constants->size() - 1;
 }
 
 /**
@@ -517,6 +834,7 @@ void NXSL_Program::serialize(ByteStream& s)
 {
    StringList strings;
    ObjectRefArray<NXSL_Value> constants(64, 64);
+   ObjectRefArray<NXSL_Value> patterns(16, 16);
 
    NXSL_FileHeader header;
    memset(&header, 0, sizeof(header));
@@ -554,24 +872,16 @@ void NXSL_Program::serialize(ByteStream& s)
             */
             break;
          case OP_TYPE_CONST:
+            s.write(FindOrAddConstant(&constants, instr->m_operand.m_constant));
+            if (instr->m_opCode == OPCODE_JZ_CMP_CONST)
+               s.write(instr->m_addr2);
+            break;
+         case OP_TYPE_REGEXP:
             {
-               INT32 idx = -1;
-               for(int i = 0; i < constants.size(); i++)
-               {
-                  if (constants.get(i)->equals(instr->m_operand.m_constant))
-                  {
-                     idx = i;
-                     break;
-                  }
-               }
-
-               if (idx == -1)
-               {
-                  idx = constants.size();
-                  constants.add(instr->m_operand.m_constant);
-               }
-
-               s.write(idx);
+               // Precompiled regular expression is stored as pattern and compiled again on load
+               NXSL_Value *pattern = createValue(instr->m_operand.m_regexp->getPattern());
+               patterns.add(pattern);
+               s.write(FindOrAddConstant(&constants, pattern));
             }
             break;
          default:
@@ -614,6 +924,9 @@ void NXSL_Program::serialize(ByteStream& s)
    // update header
    s.seek(0);
    s.write(&header, sizeof(header));
+
+   for(i = 0; i < patterns.size(); i++)
+      destroyValue(patterns.get(i));
 }
 
 /**
@@ -708,6 +1021,23 @@ NXSL_Program *NXSL_Program::load(ByteStream& s, TCHAR *errMsg, size_t errMsgSize
                   goto failure;
                }
                instr->m_operand.m_constant = p->createValue(v);
+               if (opcode == OPCODE_JZ_CMP_CONST)
+                  instr->m_addr2 = s.readUInt32();
+            }
+            break;
+         case OP_TYPE_REGEXP:
+            {
+               INT32 idx = s.readInt32();
+               NXSL_Value *v = constants.get(idx);
+               NXSL_Regexp *regexp = (v != NULL) ? NXSL_Regexp::compile(v->getValueAsCString(), opcode == OPCODE_IMATCH_CONST) : NULL;
+               if (regexp == NULL)
+               {
+                  _sntprintf(errMsg, errMsgSize, _T("Binary file read error (instruction %04X)"), p->m_instructionSet->size());
+                  instr->m_opCode = OPCODE_NOP;
+                  delete instr;
+                  goto failure;
+               }
+               instr->m_operand.m_regexp = regexp;
             }
             break;
          default:
@@ -0,0 +1,208 @@
+/*
+** NetXMS - Network Management System
+** NetXMS Scripting Language Interpreter
+** Copyright (C) 2003-2020 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: regexp.cpp
+**
+**/
+
+#include "libnxsl.h"
+
+/**
+ * Maximum number of compiled regular expressions kept in cache
+ */
+#define REGEXP_CACHE_SIZE     256
+
+/**
+ * Regexp cache (separate maps for case sensitive and case insensitive patterns)
+ */
+static StringObjectMap<NXSL_Regexp> *s_regexpCache[2] = { nullptr, nullptr };
+static NXSL_Regexp *s_lruHead = nullptr;  // Most recently used
+static NXSL_Regexp *s_lruTail = nullptr;  // Least recently used
+static int s_regexpCacheEntries = 0;
+static uint32_t s_regexpCacheHits = 0;
+static uint32_t s_regexpCacheMisses = 0;
+static Mutex s_regexpCacheLock(true);
+
+/**
+ * Compiled regexp constructor
+ */
+NXSL_Regexp::NXSL_Regexp(PCRE *preg, const TCHAR *pattern, bool ignoreCase)
+{
+   m_preg = preg;
+#ifdef PCRE_STUDY_JIT_COMPILE
+   const char *errptr;
+   m_extra = _pcre_study_t(preg, PCRE_STUDY_JIT_COMPILE, &errptr);
+#else
+   m_extra = nullptr;
+#endif
+   m_pattern = MemCopyString(pattern);
+   m_ignoreCase = ignoreCase;
+   m_prev = nullptr;
+   m_next = nullptr;
+}
+
+/**
+ * Compiled regexp destructor
+ */
+NXSL_Regexp::~NXSL_Regexp()
+{
+#ifdef PCRE_STUDY_JIT_COMPILE
+   if (m_extra != nullptr)
+      _pcre_free_study_t(m_extra);
+#endif
+   _pcre_free_t(m_preg);
+   MemFree(m_pattern);
+}
+
+/**
+ * Compile regular expression. Returns NULL if pattern is invalid.
+ */
+NXSL_Regexp *NXSL_Regexp::compile(const TCHAR *pattern, bool ignoreCase)
+{
+   const char *eptr;
+   int eoffset;
+   PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(pattern),
+            ignoreCase ? PCRE_COMMON_FLAGS | PCRE_CASELESS : PCRE_COMMON_FLAGS, &eptr, &eoffset, nullptr);
+   return (preg != nullptr) ? new NXSL_Regexp(preg, pattern, ignoreCase) : nullptr;
+}
+
+/**
+ * Execute regular expression on given subject
+ */
+int NXSL_Regexp::exec(const TCHAR *subject, int length, int *pmatch, int size) const
+{
+   int rc = _pcre_exec_t(m_preg, m_extra, reinterpret_cast<const PCRE_TCHAR*>(subject), length, 0, 0, pmatch, size);
+#ifdef PCRE_ERROR_JITSTACKLIMIT
+   // JIT compiled code uses small default stack, retry with interpreter if it is not enough
+   if ((rc == PCRE_ERROR_JITSTACKLIMIT) && (m_extra != nullptr))
+      rc = _pcre_exec_t(m_preg, nullptr, reinterpret_cast<const PCRE_TCHAR*>(subject), length, 0, 0, pmatch, size);
+#endif
+   return rc;
+}
+
+/**
+ * Unlink regexp from cache LRU list
+ */
+void NXSL_Regexp::unlinkFromLRU()
+{
+   if (m_prev != nullptr)
+      m_prev->m_next = m_next;
+   else
+      s_lruHead = m_next;
+   if (m_next != nullptr)
+      m_next->m_prev = m_prev;
+   else
+      s_lruTail = m_prev;
+   m_prev = nullptr;
+   m_next = nullptr;
+}
+
+/**
+ * Link regexp to the head of cache LRU list
+ */
+void NXSL_Regexp::linkToLRUHead()
+{
+   m_next = s_lruHead;
+   if (s_lruHead != nullptr)
+      s_lruHead->m_prev = this;
+   else
+      s_lruTail = this;
+   s_lruHead = this;
+}
+
+/**
+ * Get compiled regular expression from cache, compiling and caching it if needed.
+ * Returned object has its reference count incremented and should be released by
+ * caller with decRefCount(). Returns NULL if pattern is invalid.
+ */
+NXSL_Regexp *AcquireCachedRegexp(const TCHAR *pattern, bool ignoreCase)
+{
+   s_regexpCacheLock.lock();
+   StringObjectMap<NXSL_Regexp> *cache = s_regexpCache[ignoreCase ? 1 : 0];
+   if (cache == nullptr)
+   {
+      cache = new StringObjectMap<NXSL_Regexp>(Ownership::False, nullptr);
+      cache->setIgnoreCase(false);
+      s_regexpCache[ignoreCase ? 1 : 0] = cache;
+   }
+   NXSL_Regexp *r = cache->get(pattern);
+   if (r != nullptr)
+   {
+      // Move to the head of LRU list
+      if (r != s_lruHead)
+      {
+         r->unlinkFromLRU();
+         r->linkToLRUHead();
+      }
+      r->incRefCount();
+      s_regexpCacheHits++;
+      s_regexpCacheLock.unlock();
+      return r;
+   }
+   s_regexpCacheMisses++;
+   s_regexpCacheLock.unlock();
+
+   // Compile outside the lock - concurrent compilation of same pattern is harmless
+   r = NXSL_Regexp::compile(pattern, ignoreCase);
+   if (r == nullptr)
+      return nullptr;
+
+   s_regexpCacheLock.lock();
+   NXSL_Regexp *existing = cache->get(pattern);
+   if (existing != nullptr)
+   {
+      existing->incRefCount();
+      s_regexpCacheLock.unlock();
+      r->decRefCount();
+      return existing;
+   }
+
+   cache->set(pattern, r);
+   r->linkToLRUHead();
+   s_regexpCacheEntries++;
+
+   // Evict least recently used entries (objects still in use by callers will be destroyed on release)
+   while(s_regexpCacheEntries > REGEXP_CACHE_SIZE)
+   {
+      NXSL_Regexp *victim = s_lruTail;
+      victim->unlinkFromLRU();
+      s_regexpCache[victim->m_ignoreCase ? 1 : 0]->remove(victim->m_pattern);
+      s_regexpCacheEntries--;
+      victim->decRefCount();
+   }
+
+   r->incRefCount();
+   s_regexpCacheLock.unlock();
+   return r;
+}
+
+/**
+ * Get regular expression cache statistics
+ */
+void LIBNXSL_EXPORTABLE NXSLGetRegexpCacheStats(uint32_t *hits, uint32_t *misses, int *size)
+{
+   s_regexpCacheLock.lock();
+   if (hits != nullptr)
+      *hits = s_regexpCacheHits;
+   if (misses != nullptr)
+      *misses = s_regexpCacheMisses;
+   if (size != nullptr)
+      *size = s_regexpCacheEntries;
+   s_regexpCacheLock.unlock();
+}
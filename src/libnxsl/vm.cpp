@@ -92,7 +92,7 @@ static const TCHAR *GetErrorMessage(int error)
 /**
  * Determine operation data type
  */
-static int SelectResultType(int nType1, int nType2, int nOp)
+int SelectResultType(int nType1, int nType2, int nOp)
 {
    int nType;
 
@@ -1137,6 +1137,60 @@ void NXSL_VM::execute()
       case OPCODE_JMP:
          dwNext = cp->m_operand.m_addr;
          break;
+      case OPCODE_JZ_CMP_CONST:  // compare stack top with constant operand and jump to m_addr2 if result is false
+         pValue = m_dataStack->pop();
+         if (pValue != nullptr)
+         {
+            NXSL_Value *constant = cp->m_operand.m_constant;
+            if ((pValue->getDataType() == NXSL_DT_INT32) && (constant->getDataType() == NXSL_DT_INT32))
+            {
+               INT32 v1 = pValue->getValueAsInt32();
+               INT32 v2 = constant->getValueAsInt32();
+               bool result;
+               switch(cp->m_stackItems)
+               {
+                  case OPCODE_EQ:
+                     result = (v1 == v2);
+                     break;
+                  case OPCODE_NE:
+                     result = (v1 != v2);
+                     break;
+                  case OPCODE_LT:
+                     result = (v1 < v2);
+                     break;
+                  case OPCODE_LE:
+                     result = (v1 <= v2);
+                     break;
+                  case OPCODE_GT:
+                     result = (v1 > v2);
+                     break;
+                  default:
+                     result = (v1 >= v2);
+                     break;
+               }
+               if (!result)
+                  dwNext = cp->m_addr2;
+               destroyValue(pValue);
+            }
+            else
+            {
+               m_dataStack->push(pValue);
+               m_dataStack->push(createValue(constant));
+               doBinaryOperation(cp->m_stackItems);
+               if (m_cp != INVALID_ADDRESS)
+               {
+                  pValue = m_dataStack->pop();
+                  if (pValue->isFalse())
+                     dwNext = cp->m_addr2;
+                  destroyValue(pValue);
+               }
+            }
+         }
+         else
+         {
+            error(NXSL_ERR_DATA_STACK_UNDERFLOW);
+         }
+         break;
       case OPCODE_JZ:
       case OPCODE_JNZ:
          pValue = m_dataStack->pop();
@@ -1413,6 +1467,32 @@ void NXSL_VM::execute()
       case OPCODE_CASE_CONST_GT:
          doBinaryOperation(cp->m_opCode);
          break;
+      case OPCODE_MATCH_CONST:
+      case OPCODE_IMATCH_CONST:
+         pValue = m_dataStack->pop();
+         if (pValue != NULL)
+         {
+            if (pValue->isNull())
+            {
+               error(NXSL_ERR_NULL_VALUE);
+            }
+            else if (pValue->isString())
+            {
+               NXSL_Value *result = matchRegexp(pValue, cp->m_operand.m_regexp);
+               if (result != NULL)
+                  m_dataStack->push(result);
+            }
+            else
+            {
+               error(NXSL_ERR_NOT_STRING);
+            }
+            destroyValue(pValue);
+         }
+         else
+         {
+            error(NXSL_ERR_DATA_STACK_UNDERFLOW);
+         }
+         break;
       case OPCODE_NEG:
       case OPCODE_NOT:
       case OPCODE_BIT_NOT:
@@ -1511,7 +1591,14 @@ void NXSL_VM::execute()
                pObj = pValue->getValueAsObject();
                if (pObj != NULL)
                {
-                  pAttr = pObj->getClass()->getAttr(pObj, cp->m_operand.m_identifier->value);
+                  // Attribute handler lookup result is cached in instruction for last seen class
+                  NXSL_Class *c = pObj->getClass();
+                  if (cp->m_cachedClass != c)
+                  {
+                     cp->m_cachedClass = c;
+                     cp->m_cachedAttribute = c->getAttributeHandler(*cp->m_operand.m_identifier);
+                  }
+                  pAttr = (cp->m_cachedAttribute != NULL) ? cp->m_cachedAttribute->handler(pObj, pObj->vm()) : c->getAttr(pObj, cp->m_operand.m_identifier->value);
                   if (pAttr != NULL)
                   {
                      m_dataStack->push(pAttr);
@@ -2308,6 +2395,8 @@ void NXSL_VM::relocateCode(uint32_t start, uint32_t len, uint32_t shift)
       {
          instr->m_operand.m_addr += shift;
       }
+      if (instr->m_addr2 != INVALID_ADDRESS)
+         instr->m_addr2 += shift;
 	}
 }
 
@@ -2566,63 +2655,58 @@ UINT32 NXSL_VM::callSelector(const NXSL_Identifier& name, int numElements)
  */
 NXSL_Value *NXSL_VM::matchRegexp(NXSL_Value *pValue, NXSL_Value *pRegexp, BOOL bIgnoreCase)
 {
-   NXSL_Value *result;
-
-   const TCHAR *re = pRegexp->getValueAsCString();
-   const char *eptr;
-   int eoffset;
-	PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(re), bIgnoreCase ? PCRE_COMMON_FLAGS | PCRE_CASELESS : PCRE_COMMON_FLAGS, &eptr, &eoffset, NULL);
-   if (preg != NULL)
+   NXSL_Regexp *regexp = AcquireCachedRegexp(pRegexp->getValueAsCString(), bIgnoreCase ? true : false);
+   if (regexp == NULL)
    {
-      int pmatch[MAX_REGEXP_CGROUPS * 3];
-      UINT32 valueLen;
-		const TCHAR *value = pValue->getValueAsString(&valueLen);
-		int cgcount = _pcre_exec_t(preg, NULL, reinterpret_cast<const PCRE_TCHAR*>(value), valueLen, 0, 0, pmatch, MAX_REGEXP_CGROUPS * 3);
-      if (cgcount >= 0)
-      {
-         if (cgcount == 0)
-            cgcount = MAX_REGEXP_CGROUPS;
-
-         NXSL_Array *cgroups = new NXSL_Array(this);
-         int i;
-         for(i = 0; i < cgcount; i++)
-         {
-            char varName[16];
-            snprintf(varName, 16, "$%d", i);
-            NXSL_Variable *var = m_localVariables->find(varName);
+      error(NXSL_ERR_REGEXP_ERROR);
+      return NULL;
+   }
+   NXSL_Value *result = matchRegexp(pValue, regexp);
+   regexp->decRefCount();
+   return result;
+}
 
-            int start = pmatch[i * 2];
-            if (start != -1)
-            {
-               int end = pmatch[i * 2 + 1];
-               if (var == NULL)
-                  m_localVariables->create(varName, createValue(pValue->getValueAsCString() + start, end - start));
-               else
-                  var->setValue(createValue(pValue->getValueAsCString() + start, end - start));
-               cgroups->append(createValue(pValue->getValueAsCString() + start, end - start));
-            }
-            else
-            {
-               if (var != NULL)
-                  var->setValue(createValue());
-               cgroups->append(createValue());
-            }
-         }
+/**
+ * Match compiled regular expression
+ */
+NXSL_Value *NXSL_VM::matchRegexp(NXSL_Value *value, NXSL_Regexp *regexp)
+{
+   int pmatch[MAX_REGEXP_CGROUPS * 3];
+   UINT32 valueLen;
+   const TCHAR *text = value->getValueAsString(&valueLen);
+   int cgcount = regexp->exec(text, valueLen, pmatch, MAX_REGEXP_CGROUPS * 3);
+   if (cgcount < 0)
+      return createValue();
+
+   if (cgcount == 0)
+      cgcount = MAX_REGEXP_CGROUPS;
+
+   NXSL_Array *cgroups = new NXSL_Array(this);
+   for(int i = 0; i < cgcount; i++)
+   {
+      char varName[16];
+      snprintf(varName, 16, "$%d", i);
+      NXSL_Variable *var = m_localVariables->find(varName);
 
-         result = createValue(cgroups);
+      int start = pmatch[i * 2];
+      if (start != -1)
+      {
+         int end = pmatch[i * 2 + 1];
+         if (var == NULL)
+            m_localVariables->create(varName, createValue(text + start, end - start));
+         else
+            var->setValue(createValue(text + start, end - start));
+         cgroups->append(createValue(text + start, end - start));
       }
       else
       {
-         result = createValue();
+         if (var != NULL)
+            var->setValue(createValue());
+         cgroups->append(createValue());
       }
-      _pcre_free_t(preg);
-   }
-   else
-   {
-      error(NXSL_ERR_REGEXP_ERROR);
-      result = NULL;
    }
-   return result;
+
+   return createValue(cgroups);
 }
 
 /**
@@ -94,10 +94,8 @@ bool AccessPoint::loadFromDatabase(DB_HANDLE hdb, UINT32 dwId)
 
    // Load DCI and access list
    loadACLFromDB(hdb);
-   loadItemsFromDB(hdb);
-   for(int i = 0; i < m_dcObjects->size(); i++)
-      if (!m_dcObjects->get(i)->loadThresholdsFromDB(hdb))
-         return false;
+   if (!loadItemsFromDB(hdb))
+      return false;
    loadDCIListForCleanup(hdb);
 
    // Link access point to node
@@ -762,6 +762,11 @@ UINT32 AgentConnectionEx::processBulkCollectedData(NXCPMessage *request, NXCPMes
 
    BYTE status[MAX_BULK_DATA_BLOCK_SIZE];
    memset(status, 0, MAX_BULK_DATA_BLOCK_SIZE);
+
+   // Most elements in one message usually belong to same target, so keep last resolved one
+   uuid lastTargetId;
+   shared_ptr<DataCollectionTarget> lastTarget;
+
    UINT32 fieldId = VID_ELEMENT_LIST_BASE;
    INT64 startTime = GetCurrentTimeMs();
    for(int i = 0; i < count; i++, fieldId += 10)
@@ -792,7 +797,11 @@ UINT32 AgentConnectionEx::processBulkCollectedData(NXCPMessage *request, NXCPMes
 
       shared_ptr<DataCollectionTarget> target;
       uuid targetId = request->getFieldAsGUID(fieldId + 3);
-      if (!targetId.isNull())
+      if (!targetId.isNull() && (lastTarget != nullptr) && targetId.equals(lastTargetId))
+      {
+         target = lastTarget;
+      }
+      else if (!targetId.isNull())
       {
          shared_ptr<NetObj> object = FindObjectByGUID(targetId, -1);
          if (object == nullptr)
@@ -812,6 +821,8 @@ UINT32 AgentConnectionEx::processBulkCollectedData(NXCPMessage *request, NXCPMes
             continue;
          }
          target = static_pointer_cast<DataCollectionTarget>(object);
+         lastTarget = target;
+         lastTargetId = targetId;
       }
       else
       {
@@ -298,10 +298,8 @@ bool Chassis::loadFromDatabase(DB_HANDLE hdb, UINT32 id)
    DBFreeStatement(hStmt);
 
    loadACLFromDB(hdb);
-   loadItemsFromDB(hdb);
-   for(int i = 0; i < m_dcObjects->size(); i++)
-      if (!m_dcObjects->get(i)->loadThresholdsFromDB(hdb))
-         return false;
+   if (!loadItemsFromDB(hdb))
+      return false;
    loadDCIListForCleanup(hdb);
 
    updateRackBinding();
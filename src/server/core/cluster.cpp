@@ -87,10 +87,8 @@ bool Cluster::loadFromDatabase(DB_HANDLE hdb, UINT32 dwId)
 
    // Load DCI and access list
    loadACLFromDB(hdb);
-   loadItemsFromDB(hdb);
-   for(i = 0; i < m_dcObjects->size(); i++)
-      if (!m_dcObjects->get(i)->loadThresholdsFromDB(hdb))
-         return false;
+   if (!loadItemsFromDB(hdb))
+      return false;
    loadDCIListForCleanup(hdb);
 
    if (!m_isDeleted)
@@ -22,6 +22,80 @@
 
 #include "nxcore.h"
 
+/**
+ * Reverse index of DCIs referenced by conditions (DCI ID -> IDs of conditions using it)
+ */
+static HashMap<uint32_t, IntegerArray<uint32_t>> s_dciConditionIndex(Ownership::True);
+static Mutex s_dciConditionIndexLock;
+
+/**
+ * Add condition DCIs to reverse index
+ */
+static void RegisterConditionDCIs(uint32_t conditionId, const INPUT_DCI *dciList, int dciCount)
+{
+   s_dciConditionIndexLock.lock();
+   for(int i = 0; i < dciCount; i++)
+   {
+      IntegerArray<uint32_t> *conditions = s_dciConditionIndex.get(dciList[i].id);
+      if (conditions == nullptr)
+      {
+         conditions = new IntegerArray<uint32_t>(4, 4);
+         s_dciConditionIndex.set(dciList[i].id, conditions);
+      }
+      if (!conditions->contains(conditionId))
+         conditions->add(conditionId);
+   }
+   s_dciConditionIndexLock.unlock();
+}
+
+/**
+ * Remove condition DCIs from reverse index
+ */
+static void UnregisterConditionDCIs(uint32_t conditionId, const INPUT_DCI *dciList, int dciCount)
+{
+   s_dciConditionIndexLock.lock();
+   for(int i = 0; i < dciCount; i++)
+   {
+      IntegerArray<uint32_t> *conditions = s_dciConditionIndex.get(dciList[i].id);
+      if (conditions == nullptr)
+         continue;
+      int index = conditions->indexOf(conditionId);
+      if (index != -1)
+         conditions->remove(index);
+      if (conditions->isEmpty())
+         s_dciConditionIndex.remove(dciList[i].id);
+   }
+   s_dciConditionIndexLock.unlock();
+}
+
+/**
+ * Get DCI cache size required by all conditions referencing given DCI. Condition
+ * with ID conditionId is expected to be already locked by caller.
+ */
+uint32_t GetConditionCacheSizeForDCI(uint32_t dciId, uint32_t conditionId)
+{
+   // Copy condition list to avoid locking conditions while holding index lock
+   IntegerArray<uint32_t> conditions;
+   s_dciConditionIndexLock.lock();
+   IntegerArray<uint32_t> *indexEntry = s_dciConditionIndex.get(dciId);
+   if (indexEntry != nullptr)
+      conditions.addAll(indexEntry);
+   s_dciConditionIndexLock.unlock();
+
+   uint32_t requiredSize = 0;
+   for(int i = 0; i < conditions.size(); i++)
+   {
+      uint32_t id = conditions.get(i);
+      shared_ptr<NetObj> condition = g_idxConditionById.get(id);
+      if (condition == nullptr)
+         continue;
+      uint32_t size = static_cast<ConditionObject*>(condition.get())->getCacheSizeForDCI(dciId, id == conditionId);
+      if (size > requiredSize)
+         requiredSize = size;
+   }
+   return requiredSize;
+}
+
 /**
  * Default constructor
  */
@@ -132,6 +206,7 @@ bool ConditionObject::loadFromDatabase(DB_HANDLE hdb, UINT32 dwId)
          m_dciList[i].function = DBGetFieldLong(hResult, i, 2);
          m_dciList[i].polls = DBGetFieldLong(hResult, i, 3);
       }
+      RegisterConditionDCIs(m_id, m_dciList, m_dciCount);
    }
    DBFreeResult(hResult);
 
@@ -284,6 +359,7 @@ UINT32 ConditionObject::modifyFromMessageInternal(NXCPMessage *pRequest)
    // Change DCI list
    if (pRequest->isFieldExist(VID_NUM_ITEMS))
    {
+      UnregisterConditionDCIs(m_id, m_dciList, m_dciCount);
       free(m_dciList);
       m_dciCount = pRequest->getFieldAsUInt32(VID_NUM_ITEMS);
       if (m_dciCount > 0)
@@ -298,6 +374,7 @@ UINT32 ConditionObject::modifyFromMessageInternal(NXCPMessage *pRequest)
             m_dciList[i].polls = pRequest->getFieldAsUInt16(dwId++);
             dwId += 6;
          }
+         RegisterConditionDCIs(m_id, m_dciList, m_dciCount);
 
          // Update cache size of DCIs
          for(int i = 0; i < m_dciCount; i++)
@@ -481,6 +558,17 @@ void ConditionObject::check()
    }
 }
 
+/**
+ * Prepare condition object for deletion
+ */
+void ConditionObject::prepareForDeletion()
+{
+   lockProperties();
+   UnregisterConditionDCIs(m_id, m_dciList, m_dciCount);
+   unlockProperties();
+   super::prepareForDeletion();
+}
+
 /**
  * Determine DCI cache size required by condition object
  */
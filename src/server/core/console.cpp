@@ -775,7 +775,8 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
          {
             PoolConnectionInfo *c = list->get(i);
             TCHAR accessTime[64];
-            ConsolePrintf(pCtx, _T("%p %s %hs:%d\n"), c->handle, FormatTimestamp(c->lastAccessTime, accessTime), c->srcFile, c->srcLine);
+            ConsolePrintf(pCtx, _T("%p %s %hs:%d (statement cache hits/misses: %u/%u)\n"), c->handle, FormatTimestamp(c->lastAccessTime, accessTime),
+                  c->srcFile, c->srcLine, c->statementCacheHits, c->statementCacheMisses);
          }
          ConsolePrintf(pCtx, _T("%d database connections in use\n\n"), list->size());
          delete list;
@@ -795,6 +796,16 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
          ConsolePrintf(pCtx, _T("   DCI data ....... ") INT64_FMT _T("\n"), g_idataWriteRequests);
          ConsolePrintf(pCtx, _T("   DCI raw data ... ") INT64_FMT _T("\n"), g_rawDataWriteRequests);
          ConsolePrintf(pCtx, _T("   Others ......... ") INT64_FMT _T("\n"), g_otherWriteRequests);
+
+         EventLogWriterStats eventLogStats;
+         GetEventLogWriterStats(&eventLogStats);
+         ConsolePrintf(pCtx, _T("Event log writer:\n"));
+         ConsolePrintf(pCtx, _T("   Events ......... ") UINT64_FMT _T("\n"), eventLogStats.eventsWritten);
+         ConsolePrintf(pCtx, _T("   Transactions ... ") UINT64_FMT _T("\n"), eventLogStats.transactions);
+         ConsolePrintf(pCtx, _T("   Avg. batch ..... %u\n"), (eventLogStats.transactions > 0) ? static_cast<uint32_t>(eventLogStats.eventsWritten / eventLogStats.transactions) : 0);
+         ConsolePrintf(pCtx, _T("   Avg. time ...... %u ms\n"), eventLogStats.averageWriteTime);
+         ConsolePrintf(pCtx, _T("   Queue size ..... %u\n"), eventLogStats.queueSize);
+         ConsolePrintf(pCtx, _T("   Max queue ...... %u\n"), eventLogStats.maxQueueSize);
       }
       else if (IsCommand(_T("DISCOVERY"), szBuffer, 2))
       {
@@ -814,13 +825,14 @@ int ProcessConsoleCommand(const TCHAR *pszCmdLine, CONSOLE_CTX pCtx)
          if (stats->size() > 0)
          {
             ConsoleWrite(pCtx,
-                     _T(" \x1b[1mID\x1b[0m  | \x1b[1mQueue\x1b[0m | \x1b[1mBindings\x1b[0m | \x1b[1mWait time\x1b[0m | \x1b[1mProcessed\x1b[0m\n")
-                     _T("-----+-------+----------+-----------+-----------\n"));
+                     _T(" \x1b[1mID\x1b[0m  | \x1b[1mQueue\x1b[0m | \x1b[1mBindings\x1b[0m | \x1b[1mAssigned\x1b[0m | \x1b[1mWait time\x1b[0m | \x1b[1mDispatched\x1b[0m | \x1b[1mProcessed\x1b[0m\n")
+                     _T("-----+-------+----------+----------+-----------+------------+-----------\n"));
             for(int i = 0; i < stats->size(); i++)
             {
                EventProcessingThreadStats *s = stats->get(i);
-               ConsolePrintf(pCtx, _T(" %-3d | %-5u | %-8u | %-9u | ") UINT64_FMT _T("\n"),
-                        i + 1, s->queueSize, s->bindings, s->averageWaitTime, s->processedEvents);
+               ConsolePrintf(pCtx, _T(" %-3d | %-5u | %-8u | ") UINT64_FMT _T(" | %-9u | ") UINT64_FMT _T(" | ") UINT64_FMT _T("\n"),
+                        i + 1, s->queueSize, s->bindings, s->bindingAssignments, s->averageWaitTime,
+                        s->dispatchedEvents, s->processedEvents);
             }
          }
          else
@@ -420,11 +420,32 @@ THREAD_RESULT THREAD_CALL CacheLoader(void *arg)
    return THREAD_OK;
 }
 
+/**
+ * Interval between DCI cache snapshots (in seconds)
+ */
+#define DCI_CACHE_SNAPSHOT_INTERVAL    900
+
+/**
+ * DCI cache snapshot writer
+ */
+static THREAD_RESULT THREAD_CALL CacheSnapshotWriter(void *arg)
+{
+   ThreadSetName("CacheSnapshot");
+   nxlog_debug_tag(_T("obj.dc.cache"), 2, _T("DCI cache snapshot writer thread started"));
+   while(!SleepAndCheckForShutdown(DCI_CACHE_SNAPSHOT_INTERVAL))
+   {
+      SaveDCICacheSnapshot();
+   }
+   nxlog_debug_tag(_T("obj.dc.cache"), 2, _T("DCI cache snapshot writer thread stopped"));
+   return THREAD_OK;
+}
+
 /**
  * Threads
  */
 static THREAD s_itemPollerThread = INVALID_THREAD_HANDLE;
 static THREAD s_cacheLoaderThread = INVALID_THREAD_HANDLE;
+static THREAD s_cacheSnapshotWriterThread = INVALID_THREAD_HANDLE;
 
 /**
  * Initialize data collection subsystem
@@ -438,6 +459,7 @@ void InitDataCollector()
 
    s_itemPollerThread = ThreadCreateEx(ItemPoller, 0, nullptr);
    s_cacheLoaderThread = ThreadCreateEx(CacheLoader, 0, nullptr);
+   s_cacheSnapshotWriterThread = ThreadCreateEx(CacheSnapshotWriter, 0, nullptr);
 }
 
 /**
@@ -447,7 +469,11 @@ void StopDataCollection()
 {
    ThreadJoin(s_itemPollerThread);
    ThreadJoin(s_cacheLoaderThread);
+   ThreadJoin(s_cacheSnapshotWriterThread);
    ThreadPoolDestroy(g_dataCollectorThreadPool);
+
+   // Save DCI caches so they can be restored on next startup without reading collected data
+   SaveDCICacheSnapshot();
 }
 
 /**
@@ -311,7 +311,7 @@ static void DBWriteThread()
 		}
 		else
 		{
-			DB_STATEMENT hStmt = DBPrepare(hdb, rq->query);
+			DB_STATEMENT hStmt = DBPrepareCached(hdb, rq->query);
 			if (hStmt != nullptr)
 			{
 				for(int i = 0; i < rq->bindCount; i++)
@@ -367,7 +367,7 @@ static THREAD_RESULT THREAD_CALL IDataWriteThread(void *arg)
 				{
 	            TCHAR query[256];
                _sntprintf(query, 256, _T("INSERT INTO idata_%d (item_id,idata_timestamp,idata_value,raw_value) VALUES (?,?,?,?)"), (int)rq->nodeId);
-               DB_STATEMENT hStmt = DBPrepare(hdb, query);
+               DB_STATEMENT hStmt = DBPrepareCached(hdb, query);
                if (hStmt != NULL)
                {
                   DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, rq->dciId);
@@ -0,0 +1,323 @@
+/*
+** NetXMS - Network Management System
+** Copyright (C) 2003-2020 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: dcisnapshot.cpp
+**
+**/
+
+#include "nxcore.h"
+
+#define DEBUG_TAG _T("obj.dc.cache")
+
+/**
+ * Snapshot file format:
+ *    header:
+ *       char[4]  magic ("NXDC")
+ *       UINT32   format version
+ *       UINT64   server ID
+ *       INT64    snapshot creation time
+ *    followed by entries:
+ *       UINT32   DCI ID
+ *       UINT32   owner ID
+ *       UINT32   number of values
+ *       for each value (newest first):
+ *          INT64    timestamp
+ *          UINT16   value length
+ *          char[]   value in UTF-8
+ * All numbers are in network byte order.
+ */
+#define SNAPSHOT_MAGIC     "NXDC"
+#define SNAPSHOT_VERSION   1
+
+/**
+ * Snapshot index entry
+ */
+struct SnapshotIndexEntry
+{
+   uint32_t dciId;
+   uint32_t ownerId;
+   uint32_t count;
+   size_t offset;
+};
+
+/**
+ * Loaded snapshot
+ */
+static ByteStream *s_snapshot = nullptr;
+static StructArray<SnapshotIndexEntry> *s_snapshotIndex = nullptr;
+static Mutex s_snapshotLock;
+
+/**
+ * Build snapshot file name
+ */
+static void GetSnapshotFileName(TCHAR *fileName)
+{
+   _tcslcpy(fileName, g_netxmsdDataDir, MAX_PATH);
+   _tcslcat(fileName, DFILE_DCI_CACHE_SNAPSHOT, MAX_PATH);
+}
+
+/**
+ * Compare snapshot index entries
+ */
+static int CompareIndexEntries(const void *e1, const void *e2)
+{
+   uint32_t id1 = static_cast<const SnapshotIndexEntry*>(e1)->dciId;
+   uint32_t id2 = static_cast<const SnapshotIndexEntry*>(e2)->dciId;
+   return (id1 < id2) ? -1 : ((id1 > id2) ? 1 : 0);
+}
+
+/**
+ * Skip values of single snapshot entry. Returns false if snapshot is truncated.
+ */
+static bool SkipSnapshotValues(ByteStream *s, uint32_t count)
+{
+   for(uint32_t i = 0; i < count; i++)
+   {
+      if (s->size() - s->pos() < 10)
+         return false;
+      s->readInt64();
+      size_t len = s->readUInt16();
+      if (s->size() - s->pos() < len)
+         return false;
+      s->seek(s->pos() + len);
+   }
+   return true;
+}
+
+/**
+ * Load DCI cache snapshot created on previous server run
+ */
+void LoadDCICacheSnapshot()
+{
+   TCHAR fileName[MAX_PATH];
+   GetSnapshotFileName(fileName);
+
+   ByteStream *s = ByteStream::load(fileName);
+   if (s == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("DCI cache snapshot file %s not found"), fileName);
+      return;
+   }
+
+   char magic[4];
+   if ((s->read(magic, 4) != 4) || memcmp(magic, SNAPSHOT_MAGIC, 4) || (s->readUInt32() != SNAPSHOT_VERSION))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("DCI cache snapshot file %s has invalid format"), fileName);
+      delete s;
+      return;
+   }
+
+   if (s->readUInt64() != g_serverId)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("DCI cache snapshot file %s was created by different server instance"), fileName);
+      delete s;
+      return;
+   }
+   time_t snapshotTime = static_cast<time_t>(s->readInt64());
+
+   StructArray<SnapshotIndexEntry> *index = new StructArray<SnapshotIndexEntry>(0, 4096);
+   while(s->size() - s->pos() >= 12)
+   {
+      SnapshotIndexEntry e;
+      e.dciId = s->readUInt32();
+      e.ownerId = s->readUInt32();
+      e.count = s->readUInt32();
+      e.offset = s->pos();
+      if (!SkipSnapshotValues(s, e.count))
+      {
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("DCI cache snapshot file %s is truncated"), fileName);
+         break;
+      }
+      index->add(&e);
+   }
+   index->sort(CompareIndexEntries);
+
+   s_snapshotLock.lock();
+   delete s_snapshot;
+   delete s_snapshotIndex;
+   s_snapshot = s;
+   s_snapshotIndex = index;
+   s_snapshotLock.unlock();
+
+   TCHAR timeText[64];
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("DCI cache snapshot loaded (%d entries, created at %s)"),
+            index->size(), FormatTimestamp(snapshotTime, timeText));
+}
+
+/**
+ * Release loaded DCI cache snapshot
+ */
+void ReleaseDCICacheSnapshot()
+{
+   s_snapshotLock.lock();
+   delete_and_null(s_snapshot);
+   delete_and_null(s_snapshotIndex);
+   s_snapshotLock.unlock();
+}
+
+/**
+ * Read cached values for given DCI from loaded snapshot. Snapshot entry is accepted only if
+ * it belongs to same owner, has at least requested number of values, and newest value is not
+ * older than last value known from database. Each entry can be used only once.
+ * Returns array of requested number of values (to be owned by caller) or nullptr.
+ */
+ItemValue **ReadDCICacheSnapshot(uint32_t dciId, uint32_t ownerId, uint32_t count, time_t lastValueTimestamp)
+{
+   ItemValue **values = nullptr;
+
+   s_snapshotLock.lock();
+   if (s_snapshotIndex != nullptr)
+   {
+      SnapshotIndexEntry key;
+      key.dciId = dciId;
+      auto e = static_cast<SnapshotIndexEntry*>(bsearch(&key, s_snapshotIndex->getBuffer(), s_snapshotIndex->size(), sizeof(SnapshotIndexEntry), CompareIndexEntries));
+      if ((e != nullptr) && (e->ownerId == ownerId) && (e->count >= count) && (count > 0))
+      {
+         s_snapshot->seek(e->offset);
+         values = MemAllocArrayNoInit<ItemValue*>(count);
+         char utf8value[MAX_DB_STRING * 4];
+         TCHAR value[MAX_DB_STRING];
+         for(uint32_t i = 0; i < count; i++)
+         {
+            time_t timestamp = static_cast<time_t>(s_snapshot->readInt64());
+            size_t len = s_snapshot->readUInt16();
+            if (len >= sizeof(utf8value))
+            {
+               s_snapshot->seek(s_snapshot->pos() + len);
+               len = 0;
+            }
+            else
+            {
+               s_snapshot->read(utf8value, len);
+            }
+            utf8value[len] = 0;
+            utf8_to_tchar(utf8value, -1, value, MAX_DB_STRING);
+            value[MAX_DB_STRING - 1] = 0;
+            values[i] = new ItemValue(value, timestamp);
+         }
+
+         if (values[0]->getTimeStamp() < lastValueTimestamp)
+         {
+            nxlog_debug_tag(DEBUG_TAG, 7, _T("DCI cache snapshot entry for DCI [%u] is outdated"), dciId);
+            for(uint32_t i = 0; i < count; i++)
+               delete values[i];
+            MemFree(values);
+            values = nullptr;
+         }
+         e->count = 0;  // Mark as used
+      }
+   }
+   s_snapshotLock.unlock();
+
+   return values;
+}
+
+/**
+ * Write snapshot entry for single DCI
+ */
+void WriteDCICacheSnapshotEntry(ByteStream *s, uint32_t dciId, uint32_t ownerId, ItemValue * const *values, uint32_t count)
+{
+   s->write(dciId);
+   s->write(ownerId);
+   s->write(count);
+   char utf8value[MAX_DB_STRING * 4];
+   for(uint32_t i = 0; i < count; i++)
+   {
+      s->write(static_cast<INT64>(values[i]->getTimeStamp()));
+      tchar_to_utf8(values[i]->getString(), -1, utf8value, sizeof(utf8value));
+      utf8value[sizeof(utf8value) - 1] = 0;
+      size_t len = strlen(utf8value);
+      s->write(static_cast<UINT16>(len));
+      s->write(utf8value, len);
+   }
+}
+
+/**
+ * Save DCI caches of all objects in given index
+ */
+static int SaveObjectCaches(ObjectIndex *idx, ByteStream *s)
+{
+   int count = 0;
+   SharedObjectArray<NetObj> *objects = idx->getObjects();
+   for(int i = 0; i < objects->size(); i++)
+      count += static_cast<DataCollectionTarget*>(objects->get(i))->saveDciCacheSnapshot(s);
+   delete objects;
+   return count;
+}
+
+/**
+ * Save snapshot of DCI value caches to file. New snapshot is written to temporary file
+ * which then replaces previous snapshot, so incomplete snapshot will never be loaded.
+ */
+void SaveDCICacheSnapshot()
+{
+   INT64 startTime = GetCurrentTimeMs();
+
+   ByteStream s(1024 * 1024);
+   s.setAllocationStep(1024 * 1024);
+   s.write(SNAPSHOT_MAGIC, 4);
+   s.write(static_cast<UINT32>(SNAPSHOT_VERSION));
+   s.write(static_cast<UINT64>(g_serverId));
+   s.write(static_cast<INT64>(time(nullptr)));
+
+   int count = SaveObjectCaches(&g_idxNodeById, &s);
+   count += SaveObjectCaches(&g_idxClusterById, &s);
+   count += SaveObjectCaches(&g_idxMobileDeviceById, &s);
+   count += SaveObjectCaches(&g_idxAccessPointById, &s);
+   count += SaveObjectCaches(&g_idxChassisById, &s);
+   count += SaveObjectCaches(&g_idxSensorById, &s);
+
+   TCHAR fileName[MAX_PATH], tempFileName[MAX_PATH];
+   GetSnapshotFileName(fileName);
+   _tcslcpy(tempFileName, fileName, MAX_PATH);
+   _tcslcat(tempFileName, _T(".new"), MAX_PATH);
+
+   int fd = _topen(tempFileName, O_WRONLY | O_BINARY | O_CREAT | O_TRUNC, 0600);
+   if (fd == -1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("Cannot create DCI cache snapshot file %s (%s)"), tempFileName, _tcserror(errno));
+      return;
+   }
+   bool success = s.save(fd);
+#ifdef _WIN32
+   if (success)
+      success = (_commit(fd) == 0);
+#else
+   if (success)
+      success = (fsync(fd) == 0);   // make sure data is on disk before rename replaces old snapshot
+#endif
+   _close(fd);
+
+   if (success)
+   {
+#ifdef _WIN32
+      _tremove(fileName);  // rename() cannot replace existing file on Windows
+#endif
+      success = (_trename(tempFileName, fileName) == 0);
+   }
+   if (success)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("DCI cache snapshot saved (%d entries, %u bytes, ") INT64_FMT _T(" ms)"),
+               count, static_cast<uint32_t>(s.size()), GetCurrentTimeMs() - startTime);
+   }
+   else
+   {
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("Cannot save DCI cache snapshot file %s (%s)"), fileName, _tcserror(errno));
+      _tremove(tempFileName);
+   }
+}
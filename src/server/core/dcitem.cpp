@@ -88,7 +88,7 @@ DCItem::DCItem(const DCItem *src, bool shadowCopy) : DCObject(src, shadowCopy)
  *    instance_retention_time,grace_period_start,related_object,polling_schedule_type,
  *    retention_type,polling_interval_src,retention_time_src,snmp_version
  */
-DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay) : DCObject(owner)
+DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay, const DCObjectBulkData *bulkData) : DCObject(owner)
 {
    TCHAR readBuffer[4096];
 
@@ -147,23 +147,39 @@ DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataC
    m_startTime = (useStartupDelay && (effectivePollingInterval > 0)) ? time(nullptr) + rand() % (effectivePollingInterval / 2) : 0;
 
    // Load last raw value from database
-	TCHAR szQuery[256];
-   _sntprintf(szQuery, 256, _T("SELECT raw_value,last_poll_time FROM raw_dci_values WHERE item_id=%d"), m_id);
-   DB_RESULT hTempResult = DBSelect(hdb, szQuery);
-   if (hTempResult != nullptr)
+   if ((bulkData != nullptr) && bulkData->rawValues.isValid())
    {
-      if (DBGetNumRows(hTempResult) > 0)
+      int count;
+      int rawValueRow = bulkData->rawValues.find(m_id, &count);
+      if (rawValueRow != -1)
       {
-		   TCHAR szBuffer[MAX_DB_STRING];
-         m_prevRawValue = DBGetField(hTempResult, 0, 0, szBuffer, MAX_DB_STRING);
-         m_tPrevValueTimeStamp = DBGetFieldULong(hTempResult, 0, 1);
+         DB_RESULT hRawValues = bulkData->rawValues.getResult();
+         TCHAR szBuffer[MAX_DB_STRING];
+         m_prevRawValue = DBGetField(hRawValues, rawValueRow, 0, szBuffer, MAX_DB_STRING);
+         m_tPrevValueTimeStamp = DBGetFieldULong(hRawValues, rawValueRow, 1);
          m_lastPoll = m_tPrevValueTimeStamp;
       }
-      DBFreeResult(hTempResult);
+   }
+   else
+   {
+      TCHAR szQuery[256];
+      _sntprintf(szQuery, 256, _T("SELECT raw_value,last_poll_time FROM raw_dci_values WHERE item_id=%d"), m_id);
+      DB_RESULT hTempResult = DBSelect(hdb, szQuery);
+      if (hTempResult != nullptr)
+      {
+         if (DBGetNumRows(hTempResult) > 0)
+         {
+            TCHAR szBuffer[MAX_DB_STRING];
+            m_prevRawValue = DBGetField(hTempResult, 0, 0, szBuffer, MAX_DB_STRING);
+            m_tPrevValueTimeStamp = DBGetFieldULong(hTempResult, 0, 1);
+            m_lastPoll = m_tPrevValueTimeStamp;
+         }
+         DBFreeResult(hTempResult);
+      }
    }
 
-   loadAccessList(hdb);
-	loadCustomSchedules(hdb);
+   loadAccessList(hdb, bulkData);
+	loadCustomSchedules(hdb, bulkData);
 
 	updateTimeIntervalsInternal();
 }
@@ -273,8 +289,22 @@ void DCItem::clearCache()
 /**
  * Load data collection items thresholds from database
  */
-bool DCItem::loadThresholdsFromDB(DB_HANDLE hdb)
+bool DCItem::loadThresholdsFromDB(DB_HANDLE hdb, const DCObjectBulkData *bulkData)
 {
+   if ((bulkData != nullptr) && bulkData->thresholds.isValid())
+   {
+      int count;
+      int row = bulkData->thresholds.find(m_id, &count);
+      if (count > 0)
+      {
+         DB_RESULT hResult = bulkData->thresholds.getResult();
+         m_thresholds = new ObjectArray<Threshold>(count, 8, Ownership::True);
+         for(int i = 0; i < count; i++, row++)
+            m_thresholds->add(new Threshold(hResult, row, this));
+      }
+      return true;
+   }
+
    bool result = false;
 
 	DB_STATEMENT hStmt = DBPrepare(hdb,
@@ -1133,15 +1163,9 @@ void DCItem::updateCacheSizeInternal(bool allowLoad, UINT32 conditionId)
          if (requiredSize < m_thresholds->get(i)->getRequiredCacheSize())
             requiredSize = m_thresholds->get(i)->getRequiredCacheSize();
 
-		SharedObjectArray<NetObj> *conditions = g_idxConditionById.getObjects();
-		for(int i = 0; i < conditions->size(); i++)
-      {
-		   ConditionObject *c = static_cast<ConditionObject*>(conditions->get(i));
-			uint32_t size = c->getCacheSizeForDCI(m_id, conditionId == c->getId());
-         if (size > requiredSize)
-            requiredSize = size;
-      }
-		delete conditions;
+      uint32_t conditionCacheSize = GetConditionCacheSizeForDCI(m_id, conditionId);
+      if (conditionCacheSize > requiredSize)
+         requiredSize = conditionCacheSize;
 
 		m_requiredCacheSize = requiredSize;
    }
@@ -1179,7 +1203,20 @@ void DCItem::updateCacheSizeInternal(bool allowLoad, UINT32 conditionId)
       // Load missing values from database
       // Skip caching for DCIs where estimated time to fill the cache is less then 5 minutes
       // to reduce load on database at server startup
-      if (allowLoad &&
+      ItemValue **snapshotValues;
+      if (allowLoad && (m_ownerId != 0) &&
+          ((snapshotValues = ReadDCICacheSnapshot(m_id, m_ownerId, m_requiredCacheSize, m_tPrevValueTimeStamp)) != nullptr))
+      {
+         // Use values saved on previous server shutdown
+         for(UINT32 i = 0; i < m_cacheSize; i++)
+            delete m_ppValueCache[i];
+         MemFree(m_ppValueCache);
+         m_ppValueCache = snapshotValues;
+         m_cacheSize = m_requiredCacheSize;
+         m_bCacheLoaded = true;
+         nxlog_debug_tag(_T("obj.dc.cache"), 7, _T("Cache for DCI %s [%u] restored from snapshot"), m_name.cstr(), m_id);
+      }
+      else if (allowLoad &&
           (m_ownerId != 0) &&
           (((m_requiredCacheSize - m_cacheSize) * getEffectivePollingInterval() > 300) ||
            (m_source == DS_PUSH_AGENT) ||
@@ -1369,6 +1406,19 @@ void DCItem::reloadCache(bool forceReload)
    DBConnectionPoolReleaseConnection(hdb);
 }
 
+/**
+ * Save value cache to snapshot. Returns true if cache was saved.
+ */
+bool DCItem::saveCacheSnapshot(ByteStream *s)
+{
+   lock();
+   bool saved = m_bCacheLoaded && (m_cacheSize > 0);
+   if (saved)
+      WriteDCICacheSnapshotEntry(s, m_id, m_ownerId, m_ppValueCache, m_cacheSize);
+   unlock();
+   return saved;
+}
+
 /**
  * Get cache memory usage
  */
@@ -1681,6 +1731,44 @@ TCHAR *DCItem::getAggregateValue(AggregationFunction func, time_t periodStart, t
    return result;
 }
 
+/**
+ * Get values for given period from value cache. Values are returned newest first; non-numeric values are skipped.
+ * Returns false if cache does not contain all values for requested period. Cache is considered as not covering
+ * requested period if oldest cache entry is a placeholder (cache was not loaded from database or database
+ * does not have enough values).
+ */
+bool DCItem::getCachedValues(time_t periodStart, time_t periodEnd, StructArray<DataPoint> *values)
+{
+   bool success = false;
+   lock();
+   if (m_bCacheLoaded && (m_cacheSize > 0) && (m_ppValueCache[m_cacheSize - 1]->getTimeStamp() != 1) &&
+       (m_ppValueCache[m_cacheSize - 1]->getTimeStamp() <= periodStart))
+   {
+      for(UINT32 i = 0; i < m_cacheSize; i++)
+      {
+         time_t t = m_ppValueCache[i]->getTimeStamp();
+         if (t < periodStart)
+            break;
+         if (t > periodEnd)
+            continue;
+
+         const TCHAR *s = m_ppValueCache[i]->getString();
+         TCHAR *eptr;
+         double value = _tcstod(s, &eptr);
+         if ((*eptr != 0) || (eptr == s))
+            continue;   // Not a number
+
+         DataPoint p;
+         p.timestamp = t;
+         p.value = value;
+         values->add(p);
+      }
+      success = true;
+   }
+   unlock();
+   return success;
+}
+
 /**
  * Delete all collected data
  */
@@ -46,6 +46,7 @@ Threshold::Threshold(DCItem *pRelatedItem)
 	m_repeatInterval = -1;
 	m_lastEventTimestamp = 0;
 	m_numMatches = 0;
+   m_window = nullptr;
 }
 
 /**
@@ -72,6 +73,7 @@ Threshold::Threshold()
 	m_repeatInterval = -1;
 	m_lastEventTimestamp = 0;
 	m_numMatches = 0;
+   m_window = nullptr;
 }
 
 /**
@@ -100,6 +102,7 @@ Threshold::Threshold(Threshold *src, bool shadowCopy)
 	m_repeatInterval = src->m_repeatInterval;
 	m_lastEventTimestamp = shadowCopy ? src->m_lastEventTimestamp : 0;
 	m_numMatches = shadowCopy ? src->m_numMatches : 0;
+   m_window = (shadowCopy && (src->m_window != nullptr)) ? new ThresholdWindow(src->m_window) : nullptr;
 }
 
 /**
@@ -140,6 +143,7 @@ Threshold::Threshold(DB_RESULT hResult, int iRow, DCItem *pRelatedItem)
 	m_numMatches = DBGetFieldLong(hResult, iRow, 13);
    DBGetField(hResult, iRow, 14, szBuffer, MAX_DB_STRING);
    m_lastCheckValue = szBuffer;
+   m_window = nullptr;
 }
 
 /**
@@ -169,6 +173,7 @@ Threshold::Threshold(ConfigEntry *config, DCItem *parentItem)
 	m_repeatInterval = config->getSubEntryValueAsInt(_T("repeatInterval"), 0, -1);
 	m_lastEventTimestamp = 0;
 	m_numMatches = 0;
+   m_window = nullptr;
 }
 
 /**
@@ -178,6 +183,7 @@ Threshold::~Threshold()
 {
    MemFree(m_scriptSource);
    delete m_script;
+   delete m_window;
 }
 
 /**
@@ -278,13 +284,13 @@ ThresholdCheckResult Threshold::check(ItemValue &value, ItemValue **ppPrevValues
          fvalue = value;
          break;
       case F_AVERAGE:      // Check average value for last n polls
-         calculateAverageValue(&fvalue, value, ppPrevValues);
+         updateWindow(value, ppPrevValues)->average(&fvalue);
          break;
 		case F_SUM:
-         calculateSumValue(&fvalue, value, ppPrevValues);
+         updateWindow(value, ppPrevValues)->sum(&fvalue);
 			break;
       case F_DEVIATION:    // Check mean absolute deviation
-         calculateMDValue(&fvalue, value, ppPrevValues);
+         updateWindow(value, ppPrevValues)->meanDeviation(&fvalue);
          break;
       case F_DIFF:
          calculateDiff(&fvalue, value, ppPrevValues);
@@ -639,153 +645,20 @@ void Threshold::updateFromMessage(const NXCPMessage& msg, uint32_t baseId)
 }
 
 /**
- * Calculate average value for parameter
+ * Update sample window with new value and return it. Window is (re)created if function parameters were changed.
  */
-#define CALC_AVG_VALUE(vtype) \
-{ \
-   vtype var; \
-   var = (vtype)lastValue; \
-   for(int i = 1; i < m_sampleCount; i++) \
-   { \
-      var += (vtype)(*ppPrevValues[i - 1]); \
-   } \
-   *pResult = var / (vtype)m_sampleCount; \
-}
-
-void Threshold::calculateAverageValue(ItemValue *pResult, ItemValue &lastValue, ItemValue **ppPrevValues)
+ThresholdWindow *Threshold::updateWindow(ItemValue &lastValue, ItemValue **ppPrevValues)
 {
-   switch(m_dataType)
+   int size = std::max(m_sampleCount, 1);
+   if ((m_window == nullptr) || (m_window->getSize() != size) || (m_window->getDataType() != m_dataType))
    {
-      case DCI_DT_INT:
-         CALC_AVG_VALUE(INT32);
-         break;
-      case DCI_DT_UINT:
-      case DCI_DT_COUNTER32:
-         CALC_AVG_VALUE(UINT32);
-         break;
-      case DCI_DT_INT64:
-         CALC_AVG_VALUE(INT64);
-         break;
-      case DCI_DT_UINT64:
-      case DCI_DT_COUNTER64:
-         CALC_AVG_VALUE(UINT64);
-         break;
-      case DCI_DT_FLOAT:
-         CALC_AVG_VALUE(double);
-         break;
-      case DCI_DT_STRING:
-         *pResult = _T("");   // Average value for string is meaningless
-         break;
-      default:
-         break;
+      delete m_window;
+      m_window = new ThresholdWindow(size, m_dataType);
    }
+   m_window->update(lastValue, ppPrevValues);
+   return m_window;
 }
 
-/**
- * Calculate sum value for values of given type
- */
-#define CALC_SUM_VALUE(vtype) \
-{ \
-   vtype var; \
-   var = (vtype)lastValue; \
-   for(int i = 1; i < m_sampleCount; i++) \
-   { \
-      var += (vtype)(*ppPrevValues[i - 1]); \
-   } \
-   *pResult = var; \
-}
-
-/**
- * Calculate sum value for parameter
- */
-void Threshold::calculateSumValue(ItemValue *pResult, ItemValue &lastValue, ItemValue **ppPrevValues)
-{
-   switch(m_dataType)
-   {
-      case DCI_DT_INT:
-         CALC_SUM_VALUE(INT32);
-         break;
-      case DCI_DT_UINT:
-      case DCI_DT_COUNTER32:
-         CALC_SUM_VALUE(UINT32);
-         break;
-      case DCI_DT_INT64:
-         CALC_SUM_VALUE(INT64);
-         break;
-      case DCI_DT_UINT64:
-      case DCI_DT_COUNTER64:
-         CALC_SUM_VALUE(UINT64);
-         break;
-      case DCI_DT_FLOAT:
-         CALC_SUM_VALUE(double);
-         break;
-      case DCI_DT_STRING:
-         *pResult = _T("");   // Sum value for string is meaningless
-         break;
-      default:
-         break;
-   }
-}
-
-/**
- * Calculate mean absolute deviation for values of given type
- */
-#define CALC_MD_VALUE(vtype) \
-{ \
-   vtype mean, dev; \
-   mean = (vtype)lastValue; \
-   for(i = 1; i < m_sampleCount; i++) \
-   { \
-      mean += (vtype)(*ppPrevValues[i - 1]); \
-   } \
-   mean /= (vtype)m_sampleCount; \
-   dev = ABS((vtype)lastValue - mean); \
-   for(i = 1; i < m_sampleCount; i++) \
-   { \
-      dev += ABS((vtype)(*ppPrevValues[i - 1]) - mean); \
-   } \
-   *pResult = dev / (vtype)m_sampleCount; \
-}
-
-/**
- * Calculate mean absolute deviation for parameter
- */
-void Threshold::calculateMDValue(ItemValue *pResult, ItemValue &lastValue, ItemValue **ppPrevValues)
-{
-   int i;
-
-   switch(m_dataType)
-   {
-      case DCI_DT_INT:
-#define ABS(x) ((x) < 0 ? -(x) : (x))
-         CALC_MD_VALUE(INT32);
-         break;
-      case DCI_DT_INT64:
-         CALC_MD_VALUE(INT64);
-         break;
-      case DCI_DT_FLOAT:
-         CALC_MD_VALUE(double);
-         break;
-      case DCI_DT_UINT:
-      case DCI_DT_COUNTER32:
-#undef ABS
-#define ABS(x) (x)
-         CALC_MD_VALUE(UINT32);
-         break;
-      case DCI_DT_UINT64:
-      case DCI_DT_COUNTER64:
-         CALC_MD_VALUE(UINT64);
-         break;
-      case DCI_DT_STRING:
-         *pResult = _T("");   // Mean deviation for string is meaningless
-         break;
-      default:
-         break;
-   }
-}
-
-#undef ABS
-
 /**
  * Calculate difference between last and previous value
  */
@@ -960,4 +833,286 @@ void Threshold::reconcile(const Threshold *src)
    m_lastEventTimestamp = src->m_lastEventTimestamp;
    m_currentSeverity = src->m_currentSeverity;
    m_lastScriptErrorReport = src->m_lastScriptErrorReport;
+
+   delete m_window;
+   m_window = (src->m_window != nullptr) ? new ThresholdWindow(src->m_window) : nullptr;
+}
+
+/**
+ * Create empty sample window
+ */
+ThresholdWindow::ThresholdWindow(int size, BYTE dataType)
+{
+   m_size = size;
+   m_values = MemAllocArray<ThresholdWindowValue>(size);
+   m_head = 0;
+   m_dataType = dataType;
+   m_valid = false;
+   m_sum.u64 = 0;
+   m_newest = nullptr;
+   m_newestTimestamp = 0;
+   m_tail = nullptr;
+   m_tailTimestamp = 0;
+}
+
+/**
+ * Create copy of sample window
+ */
+ThresholdWindow::ThresholdWindow(const ThresholdWindow *src)
+{
+   m_size = src->m_size;
+   m_values = MemCopyArray(src->m_values, src->m_size);
+   m_head = src->m_head;
+   m_dataType = src->m_dataType;
+   m_valid = src->m_valid;
+   m_sum = src->m_sum;
+   m_newest = src->m_newest;
+   m_newestTimestamp = src->m_newestTimestamp;
+   m_tail = src->m_tail;
+   m_tailTimestamp = src->m_tailTimestamp;
 }
+
+/**
+ * Sample window destructor
+ */
+ThresholdWindow::~ThresholdWindow()
+{
+   MemFree(m_values);
+}
+
+/**
+ * Set value at given position (0 is the newest) and update running sum. Integer sums
+ * are calculated with unsigned arithmetic, which gives same result as direct summation
+ * in case of overflow.
+ */
+void ThresholdWindow::set(int index, const ItemValue& value)
+{
+   ThresholdWindowValue *v = &m_values[(m_head + index) % m_size];
+   switch(m_dataType)
+   {
+      case DCI_DT_INT:
+         m_sum.u32 -= static_cast<UINT32>(v->i32);
+         v->i32 = (INT32)value;
+         m_sum.u32 += static_cast<UINT32>(v->i32);
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         m_sum.u32 -= v->u32;
+         v->u32 = (UINT32)value;
+         m_sum.u32 += v->u32;
+         break;
+      case DCI_DT_INT64:
+         m_sum.u64 -= static_cast<UINT64>(v->i64);
+         v->i64 = (INT64)value;
+         m_sum.u64 += static_cast<UINT64>(v->i64);
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         m_sum.u64 -= v->u64;
+         v->u64 = (UINT64)value;
+         m_sum.u64 += v->u64;
+         break;
+      case DCI_DT_FLOAT:
+         v->d = (double)value;
+         break;
+      default:
+         break;
+   }
+}
+
+/**
+ * Add new value to window replacing the oldest one
+ */
+void ThresholdWindow::push(const ItemValue& value)
+{
+   m_head = (m_head + m_size - 1) % m_size;
+   set(0, value);
+}
+
+/**
+ * Rebuild window from last value and DCI value cache
+ */
+void ThresholdWindow::rebuild(const ItemValue& value, ItemValue **prevValues)
+{
+   memset(m_values, 0, sizeof(ThresholdWindowValue) * m_size);
+   m_sum.u64 = 0;
+   m_head = 0;
+   set(0, value);
+   for(int i = 1; i < m_size; i++)
+      set(i, *prevValues[i - 1]);
+}
+
+/**
+ * Update window with new value. Previous values should be taken from DCI value cache (not yet containing new value).
+ * If cache still contains values added on previous update at expected positions new value is added in O(1),
+ * otherwise window is rebuilt from cache.
+ */
+void ThresholdWindow::update(const ItemValue& value, ItemValue **prevValues)
+{
+   if (m_valid && (m_size > 1) &&
+       (prevValues[0] == m_newest) && (prevValues[0]->getTimeStamp() == m_newestTimestamp) &&
+       (prevValues[m_size - 2] == m_tail) && (prevValues[m_size - 2]->getTimeStamp() == m_tailTimestamp))
+   {
+      push(value);
+   }
+   else
+   {
+      rebuild(value, prevValues);
+   }
+
+   m_newest = &value;
+   m_newestTimestamp = value.getTimeStamp();
+   m_tail = (m_size > 2) ? prevValues[m_size - 3] : &value;
+   m_tailTimestamp = m_tail->getTimeStamp();
+   m_valid = true;
+}
+
+/**
+ * Calculate sum of floating point values in window. Values are added in the same
+ * order as direct summation over DCI cache to get exactly the same result.
+ */
+#define WINDOW_DOUBLE_SUM(var) \
+{ \
+   var = at(0).d; \
+   for(int i = 1; i < m_size; i++) \
+      var += at(i).d; \
+}
+
+/**
+ * Get sum of values in window
+ */
+void ThresholdWindow::sum(ItemValue *result) const
+{
+   switch(m_dataType)
+   {
+      case DCI_DT_INT:
+         *result = static_cast<INT32>(m_sum.u32);
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         *result = m_sum.u32;
+         break;
+      case DCI_DT_INT64:
+         *result = static_cast<INT64>(m_sum.u64);
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         *result = m_sum.u64;
+         break;
+      case DCI_DT_FLOAT:
+         {
+            double var;
+            WINDOW_DOUBLE_SUM(var);
+            *result = var;
+         }
+         break;
+      case DCI_DT_STRING:
+         *result = _T("");   // Sum value for string is meaningless
+         break;
+      default:
+         break;
+   }
+}
+
+/**
+ * Get average value in window
+ */
+void ThresholdWindow::average(ItemValue *result) const
+{
+   switch(m_dataType)
+   {
+      case DCI_DT_INT:
+         *result = static_cast<INT32>(m_sum.u32) / static_cast<INT32>(m_size);
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+         *result = m_sum.u32 / static_cast<UINT32>(m_size);
+         break;
+      case DCI_DT_INT64:
+         *result = static_cast<INT64>(m_sum.u64) / static_cast<INT64>(m_size);
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         *result = m_sum.u64 / static_cast<UINT64>(m_size);
+         break;
+      case DCI_DT_FLOAT:
+         {
+            double var;
+            WINDOW_DOUBLE_SUM(var);
+            *result = var / static_cast<double>(m_size);
+         }
+         break;
+      case DCI_DT_STRING:
+         *result = _T("");   // Average value for string is meaningless
+         break;
+      default:
+         break;
+   }
+}
+
+/**
+ * Calculate mean absolute deviation for values of given type
+ */
+#define WINDOW_MD_VALUE(vtype, field, mean) \
+{ \
+   mean /= (vtype)m_size; \
+   vtype dev = ABS(at(0).field - mean); \
+   for(int i = 1; i < m_size; i++) \
+   { \
+      dev += ABS(at(i).field - mean); \
+   } \
+   *result = dev / (vtype)m_size; \
+}
+
+/**
+ * Get mean absolute deviation of values in window
+ */
+void ThresholdWindow::meanDeviation(ItemValue *result) const
+{
+   switch(m_dataType)
+   {
+      case DCI_DT_INT:
+#define ABS(x) ((x) < 0 ? -(x) : (x))
+         {
+            INT32 mean = static_cast<INT32>(m_sum.u32);
+            WINDOW_MD_VALUE(INT32, i32, mean);
+         }
+         break;
+      case DCI_DT_INT64:
+         {
+            INT64 mean = static_cast<INT64>(m_sum.u64);
+            WINDOW_MD_VALUE(INT64, i64, mean);
+         }
+         break;
+      case DCI_DT_FLOAT:
+         {
+            double mean;
+            WINDOW_DOUBLE_SUM(mean);
+            WINDOW_MD_VALUE(double, d, mean);
+         }
+         break;
+      case DCI_DT_UINT:
+      case DCI_DT_COUNTER32:
+#undef ABS
+#define ABS(x) (x)
+         {
+            UINT32 mean = m_sum.u32;
+            WINDOW_MD_VALUE(UINT32, u32, mean);
+         }
+         break;
+      case DCI_DT_UINT64:
+      case DCI_DT_COUNTER64:
+         {
+            UINT64 mean = m_sum.u64;
+            WINDOW_MD_VALUE(UINT64, u64, mean);
+         }
+         break;
+      case DCI_DT_STRING:
+         *result = _T("");   // Mean deviation for string is meaningless
+         break;
+      default:
+         break;
+   }
+}
+
+#undef ABS
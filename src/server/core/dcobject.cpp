@@ -326,13 +326,122 @@ DCObject::~DCObject()
    delete m_accessList;
 }
 
+/**
+ * Row set constructor. Takes ownership of given result.
+ */
+DCObjectRowSet::DCObjectRowSet(DB_RESULT hResult, int idColumn)
+{
+   m_hResult = hResult;
+   m_idColumn = idColumn;
+   m_rowCount = (hResult != nullptr) ? DBGetNumRows(hResult) : 0;
+
+   // Binary search in find() relies on numeric ordering by ID. If database returned rows in different
+   // order (for example, ID column is textual in cache database) discard result so that DCIs will load
+   // their data individually.
+   for(int i = 1; i < m_rowCount; i++)
+   {
+      if (DBGetFieldULong(m_hResult, i - 1, m_idColumn) > DBGetFieldULong(m_hResult, i, m_idColumn))
+      {
+         nxlog_debug_tag(_T("obj.init"), 3, _T("DCObjectRowSet: rows are not ordered by ID, bulk data discarded"));
+         DBFreeResult(m_hResult);
+         m_hResult = nullptr;
+         m_rowCount = 0;
+         break;
+      }
+   }
+}
+
+/**
+ * Row set destructor
+ */
+DCObjectRowSet::~DCObjectRowSet()
+{
+   if (m_hResult != nullptr)
+      DBFreeResult(m_hResult);
+}
+
+/**
+ * Find rows for given DCI ID. Returns index of first row or -1 if there are no rows for given ID.
+ */
+int DCObjectRowSet::find(uint32_t id, int *count) const
+{
+   *count = 0;
+
+   // Find first row with ID not less than requested one
+   int low = 0, high = m_rowCount;
+   while(low < high)
+   {
+      int mid = (low + high) / 2;
+      if (DBGetFieldULong(m_hResult, mid, m_idColumn) < id)
+         low = mid + 1;
+      else
+         high = mid;
+   }
+
+   int row = low;
+   while((row < m_rowCount) && (DBGetFieldULong(m_hResult, row, m_idColumn) == id))
+      row++;
+   *count = row - low;
+   return (*count > 0) ? low : -1;
+}
+
+/**
+ * Execute bulk load query for given owner (all parameters are bound to owner ID)
+ */
+static DB_RESULT ExecuteBulkLoadQuery(DB_HANDLE hdb, const TCHAR *query, uint32_t ownerId, int paramCount)
+{
+   DB_STATEMENT hStmt = DBPrepare(hdb, query);
+   if (hStmt == nullptr)
+      return nullptr;
+
+   for(int i = 1; i <= paramCount; i++)
+      DBBind(hStmt, i, DB_SQLTYPE_INTEGER, ownerId);
+   DB_RESULT hResult = DBSelectPrepared(hStmt);
+   DBFreeStatement(hStmt);
+   return hResult;
+}
+
+/**
+ * Load data for all DCIs of given owner. If any of the queries fails, corresponding
+ * row set will be invalid and DCIs will fall back to loading that data individually.
+ */
+DCObjectBulkData::DCObjectBulkData(DB_HANDLE hdb, uint32_t ownerId) :
+   rawValues(ExecuteBulkLoadQuery(hdb,
+            _T("SELECT raw_value,last_poll_time,item_id FROM raw_dci_values ")
+            _T("WHERE item_id IN (SELECT item_id FROM items WHERE node_id=?) ORDER BY item_id"), ownerId, 1), 2),
+   thresholds(ExecuteBulkLoadQuery(hdb,
+            _T("SELECT threshold_id,fire_value,rearm_value,check_function,")
+            _T("check_operation,sample_count,script,event_code,current_state,")
+            _T("rearm_event_code,repeat_interval,current_severity,")
+            _T("last_event_timestamp,match_count,state_before_maint,")
+            _T("last_checked_value,item_id FROM thresholds ")
+            _T("WHERE item_id IN (SELECT item_id FROM items WHERE node_id=?) ORDER BY item_id,sequence_number"), ownerId, 1), 16),
+   accessLists(ExecuteBulkLoadQuery(hdb,
+            _T("SELECT user_id,dci_id FROM dci_access ")
+            _T("WHERE dci_id IN (SELECT item_id FROM items WHERE node_id=? UNION SELECT item_id FROM dc_tables WHERE node_id=?) ORDER BY dci_id"), ownerId, 2), 1),
+   schedules(ExecuteBulkLoadQuery(hdb,
+            _T("SELECT schedule,item_id FROM dci_schedules ")
+            _T("WHERE item_id IN (SELECT item_id FROM items WHERE node_id=? UNION SELECT item_id FROM dc_tables WHERE node_id=?) ORDER BY item_id"), ownerId, 2), 1)
+{
+}
+
 /**
  * Load access list
  */
-bool DCObject::loadAccessList(DB_HANDLE hdb)
+bool DCObject::loadAccessList(DB_HANDLE hdb, const DCObjectBulkData *bulkData)
 {
    m_accessList->clear();
 
+   if ((bulkData != nullptr) && bulkData->accessLists.isValid())
+   {
+      int count;
+      int row = bulkData->accessLists.find(m_id, &count);
+      DB_RESULT hResult = bulkData->accessLists.getResult();
+      for(int i = 0; i < count; i++, row++)
+         m_accessList->add(DBGetFieldULong(hResult, row, 0));
+      return true;
+   }
+
    DB_STATEMENT hStmt = DBPrepare(hdb, _T("SELECT user_id FROM dci_access WHERE dci_id=?"));
    if (hStmt == nullptr)
       return false;
@@ -356,11 +465,25 @@ bool DCObject::loadAccessList(DB_HANDLE hdb)
  * Load custom schedules from database
  * (assumes that no schedules was created before this call)
  */
-bool DCObject::loadCustomSchedules(DB_HANDLE hdb)
+bool DCObject::loadCustomSchedules(DB_HANDLE hdb, const DCObjectBulkData *bulkData)
 {
    if (m_pollingScheduleType != DC_POLLING_SCHEDULE_ADVANCED)
 		return true;
 
+   if ((bulkData != nullptr) && bulkData->schedules.isValid())
+   {
+      int count;
+      int row = bulkData->schedules.find(m_id, &count);
+      if (count > 0)
+      {
+         DB_RESULT hResult = bulkData->schedules.getResult();
+         m_schedules = new StringList();
+         for(int i = 0; i < count; i++, row++)
+            m_schedules->addPreallocated(DBGetField(hResult, row, 0, nullptr, 0));
+      }
+      return true;
+   }
+
    DB_STATEMENT hStmt = DBPrepare(hdb, _T("SELECT schedule FROM dci_schedules WHERE item_id=?"));
    if (hStmt == nullptr)
       return false;
@@ -941,7 +1064,7 @@ void DCObject::deleteFromDatabase()
 /**
  * Load data collection object thresholds from database
  */
-bool DCObject::loadThresholdsFromDB(DB_HANDLE hdb)
+bool DCObject::loadThresholdsFromDB(DB_HANDLE hdb, const DCObjectBulkData *bulkData)
 {
 	return true;
 }
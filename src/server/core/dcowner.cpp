@@ -84,10 +84,8 @@ bool DataCollectionOwner::loadFromDatabase(DB_HANDLE hdb, UINT32 id)
 
    // Load DCI and access list
    loadACLFromDB(hdb);
-   loadItemsFromDB(hdb);
-   for(int i = 0; i < m_dcObjects->size(); i++)
-      if (!m_dcObjects->get(i)->loadThresholdsFromDB(hdb))
-         success = false;
+   if (!loadItemsFromDB(hdb))
+      success = false;
 
 	m_status = STATUS_NORMAL;
 
@@ -285,11 +283,13 @@ bool DataCollectionOwner::deleteFromDatabase(DB_HANDLE hdb)
 }
 
 /**
- * Load data collection items from database
+ * Load data collection items and their thresholds from database. Data from DCI related
+ * tables is loaded in bulk for all DCIs of this owner.
  */
-void DataCollectionOwner::loadItemsFromDB(DB_HANDLE hdb)
+bool DataCollectionOwner::loadItemsFromDB(DB_HANDLE hdb)
 {
    bool useStartupDelay = ConfigReadBoolean(_T("DataCollection.StartupDelay"), false);
+   DCObjectBulkData bulkData(hdb, m_id);
 
 	DB_STATEMENT hStmt = DBPrepare(hdb,
 	           _T("SELECT item_id,name,source,datatype,polling_interval,retention_time,")
@@ -309,7 +309,7 @@ void DataCollectionOwner::loadItemsFromDB(DB_HANDLE hdb)
 		{
 			int count = DBGetNumRows(hResult);
 			for(int i = 0; i < count; i++)
-				m_dcObjects->add(make_shared<DCItem>(hdb, hResult, i, self(), useStartupDelay));
+				m_dcObjects->add(make_shared<DCItem>(hdb, hResult, i, self(), useStartupDelay, &bulkData));
 			DBFreeResult(hResult);
 		}
 		DBFreeStatement(hStmt);
@@ -331,13 +331,25 @@ void DataCollectionOwner::loadItemsFromDB(DB_HANDLE hdb)
 		{
 			int count = DBGetNumRows(hResult);
 			for(int i = 0; i < count; i++)
-				m_dcObjects->add(new DCTable(hdb, hResult, i, self(), useStartupDelay));
+				m_dcObjects->add(new DCTable(hdb, hResult, i, self(), useStartupDelay, &bulkData));
 			DBFreeResult(hResult);
 		}
 		DBFreeStatement(hStmt);
 	}
 
+   bool success = true;
+   for(int i = 0; i < m_dcObjects->size(); i++)
+   {
+      DCObject *object = m_dcObjects->get(i);
+      if (!object->loadThresholdsFromDB(hdb, &bulkData))
+      {
+         nxlog_debug(3, _T("Cannot load thresholds for DCI %u of object %s [%u]"), object->getId(), m_name, m_id);
+         success = false;
+      }
+   }
+
    onDataCollectionLoad();
+   return success;
 }
 
 /**
@@ -155,7 +155,7 @@ DCTable::DCTable(UINT32 id, const TCHAR *name, int source, const TCHAR *pollingI
  *    related_object,polling_schedule_type,retention_type,polling_interval_src,
  *    retention_time_src,snmp_version
  */
-DCTable::DCTable(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay) : DCObject(owner)
+DCTable::DCTable(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay, const DCObjectBulkData *bulkData) : DCObject(owner)
 {
    TCHAR readBuffer[4096];
 
@@ -217,8 +217,8 @@ DCTable::DCTable(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<Dat
 		DBFreeStatement(hStmt);
 	}
 
-   loadAccessList(hdb);
-   loadCustomSchedules(hdb);
+   loadAccessList(hdb, bulkData);
+   loadCustomSchedules(hdb, bulkData);
 
    m_thresholds = new ObjectArray<DCTableThreshold>(0, 4, Ownership::True);
    loadThresholds(hdb);
@@ -408,18 +408,18 @@ bool DCTable::processNewValue(time_t timestamp, void *value, bool *updateStatus)
 	         TCHAR query[256];
 	         _sntprintf(query, 256, _T("INSERT INTO tdata_sc_%s (item_id,tdata_timestamp,tdata_value) VALUES (?,to_timestamp(?),?)"),
 	                  getStorageClassName(getStorageClass()));
-            hStmt = DBPrepare(hdb, query);
+            hStmt = DBPrepareCached(hdb, query);
 	      }
 	      else
 	      {
-	         hStmt = DBPrepare(hdb, _T("INSERT INTO tdata (item_id,tdata_timestamp,tdata_value) VALUES (?,?,?)"));
+	         hStmt = DBPrepareCached(hdb, _T("INSERT INTO tdata (item_id,tdata_timestamp,tdata_value) VALUES (?,?,?)"));
 	      }
 	   }
 	   else
 	   {
 	      TCHAR query[256];
 	      _sntprintf(query, 256, _T("INSERT INTO tdata_%u (item_id,tdata_timestamp,tdata_value) VALUES (?,?,?)"), nodeId);
-	      hStmt = DBPrepare(hdb, query);
+	      hStmt = DBPrepareCached(hdb, query);
 	   }
 	   if (hStmt != nullptr)
 	   {
@@ -188,6 +188,23 @@ void DataCollectionTarget::updateDciCache()
 	unlockDciAccess();
 }
 
+/**
+ * Save cache of all DCIs to snapshot. Returns number of saved DCI caches.
+ */
+int DataCollectionTarget::saveDciCacheSnapshot(ByteStream *s)
+{
+   int count = 0;
+   readLockDciAccess();
+   for(int i = 0; i < m_dcObjects->size(); i++)
+   {
+      DCObject *object = m_dcObjects->get(i);
+      if ((object->getType() == DCO_TYPE_ITEM) && static_cast<DCItem*>(object)->saveCacheSnapshot(s))
+         count++;
+   }
+   unlockDciAccess();
+   return count;
+}
+
 /**
  * Clean expired DCI data using TSDB drop_chunks() function
  */
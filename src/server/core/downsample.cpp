@@ -0,0 +1,285 @@
+/*
+** NetXMS - Network Management System
+** Copyright (C) 2003-2020 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: downsample.cpp
+**
+**/
+
+#include "nxcore.h"
+
+#define DEBUG_TAG _T("dc.downsample")
+
+/**
+ * Regular expression for numeric values (for databases supporting regular expressions)
+ */
+#define NUMERIC_VALUE_REGEXP  _T("'^-?[0-9]+([.][0-9]+)?$'")
+
+/**
+ * Reverse order of points in array
+ */
+static void ReversePoints(StructArray<DataPoint> *points)
+{
+   DataPoint *data = points->getBuffer();
+   for(int i = 0, j = points->size() - 1; i < j; i++, j--)
+   {
+      DataPoint tmp = data[i];
+      data[i] = data[j];
+      data[j] = tmp;
+   }
+}
+
+/**
+ * Downsample points already loaded into memory (newest first)
+ */
+static void DownsamplePoints(StructArray<DataPoint> *input, time_t periodStart, time_t bucketSize, uint32_t targetPoints, DownsamplingMethod method, StructArray<DataPoint> *points)
+{
+   if (method == DCI_DOWNSAMPLE_LTTB)
+   {
+      ReversePoints(input);
+      SelectPointsLTTB(*input, targetPoints, points);
+      ReversePoints(points);
+   }
+   else
+   {
+      BucketAggregator aggregator(periodStart, bucketSize, method, points);
+      for(int i = 0; i < input->size(); i++)
+      {
+         DataPoint *p = input->get(i);
+         aggregator.add(p->timestamp, p->value);
+      }
+      aggregator.finish();
+   }
+}
+
+/**
+ * Build query which calculates aggregated value for each bucket on database side. Buckets are aligned
+ * to start of requested period. Returns false if database does not support such query.
+ */
+static bool BuildAggregationQuery(TCHAR *query, size_t size, DCItem *dci, time_t periodStart, time_t bucketSize, DownsamplingMethod method)
+{
+   static const TCHAR *functions[] = { _T("avg"), _T("min"), _T("max") };
+   const TCHAR *func = functions[method];
+
+   TCHAR table[64];
+   if (g_flags & AF_SINGLE_TABLE_PERF_DATA)
+   {
+      if (g_dbSyntax == DB_SYNTAX_TSDB)
+         _sntprintf(table, 64, _T("idata_sc_%s"), DCObject::getStorageClassName(dci->getStorageClass()));
+      else
+         _tcscpy(table, _T("idata"));
+   }
+   else
+   {
+      _sntprintf(table, 64, _T("idata_%u"), dci->getOwnerId());
+   }
+
+   // Non-numeric values are filtered out (same as when values are read and aggregated by server)
+   uint32_t origin = static_cast<uint32_t>(periodStart);
+   uint32_t step = static_cast<uint32_t>(bucketSize);
+   switch(g_dbSyntax)
+   {
+      case DB_SYNTAX_ORACLE:
+         _sntprintf(query, size, _T("SELECT trunc((idata_timestamp-%u)/%u),%s(to_number(idata_value)) FROM %s WHERE item_id=? AND idata_timestamp BETWEEN ? AND ? AND regexp_like(idata_value,%s) GROUP BY trunc((idata_timestamp-%u)/%u) ORDER BY 1 DESC"),
+                  origin, step, func, table, NUMERIC_VALUE_REGEXP, origin, step);
+         break;
+      case DB_SYNTAX_MSSQL:
+         _sntprintf(query, size, _T("SELECT (idata_timestamp-%u)/%u,%s(cast(idata_value as float)) FROM %s WHERE item_id=? AND (idata_timestamp BETWEEN ? AND ?) AND isnumeric(idata_value)=1 GROUP BY (idata_timestamp-%u)/%u ORDER BY 1 DESC"),
+                  origin, step, func, table, origin, step);
+         break;
+      case DB_SYNTAX_PGSQL:
+         _sntprintf(query, size, _T("SELECT (idata_timestamp-%u)/%u,%s(idata_value::double precision) FROM %s WHERE item_id=? AND idata_timestamp BETWEEN ? AND ? AND idata_value~%s GROUP BY 1 ORDER BY 1 DESC"),
+                  origin, step, func, table, NUMERIC_VALUE_REGEXP);
+         break;
+      case DB_SYNTAX_TSDB:
+         if (g_flags & AF_SINGLE_TABLE_PERF_DATA)
+         {
+            _sntprintf(query, size, _T("SELECT (date_part('epoch',idata_timestamp)::bigint-%u)/%u,%s(idata_value::double precision) FROM %s WHERE item_id=? AND idata_timestamp BETWEEN to_timestamp(?) AND to_timestamp(?) AND idata_value~%s GROUP BY 1 ORDER BY 1 DESC"),
+                     origin, step, func, table, NUMERIC_VALUE_REGEXP);
+         }
+         else
+         {
+            _sntprintf(query, size, _T("SELECT (idata_timestamp-%u)/%u,%s(idata_value::double precision) FROM %s WHERE item_id=? AND idata_timestamp BETWEEN ? AND ? AND idata_value~%s GROUP BY 1 ORDER BY 1 DESC"),
+                     origin, step, func, table, NUMERIC_VALUE_REGEXP);
+         }
+         break;
+      case DB_SYNTAX_MYSQL:
+         _sntprintf(query, size, _T("SELECT (idata_timestamp-%u) DIV %u,%s(cast(idata_value as decimal(30,10))) FROM %s WHERE item_id=? AND idata_timestamp BETWEEN ? AND ? AND idata_value REGEXP %s GROUP BY (idata_timestamp-%u) DIV %u ORDER BY 1 DESC"),
+                  origin, step, func, table, NUMERIC_VALUE_REGEXP, origin, step);
+         break;
+      case DB_SYNTAX_SQLITE:
+         // SQLite has no built-in regular expressions, same check is done with GLOB patterns
+         _sntprintf(query, size, _T("SELECT (idata_timestamp-%u)/%u,%s(cast(idata_value as double)) FROM %s WHERE item_id=? AND idata_timestamp BETWEEN ? AND ?")
+                  _T(" AND (idata_value GLOB '[0-9]*' OR idata_value GLOB '-[0-9]*') AND substr(idata_value,2) NOT GLOB '*[^0-9.]*' AND idata_value NOT GLOB '*.*.*' AND idata_value NOT GLOB '*.'")
+                  _T(" GROUP BY (idata_timestamp-%u)/%u ORDER BY 1 DESC"),
+                  origin, step, func, table, origin, step);
+         break;
+      default:
+         return false;
+   }
+   return true;
+}
+
+/**
+ * Read aggregated data calculated on database side
+ */
+static bool ReadAggregatedData(DB_HANDLE hdb, const TCHAR *query, DCItem *dci, time_t periodStart, time_t periodEnd, time_t bucketSize, StructArray<DataPoint> *points)
+{
+   DB_STATEMENT hStmt = DBPrepare(hdb, query);
+   if (hStmt == nullptr)
+      return false;
+
+   bool success = false;
+   DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, dci->getId());
+   DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<INT32>(periodStart));
+   DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<INT32>(periodEnd));
+   DB_RESULT hResult = DBSelectPrepared(hStmt);
+   if (hResult != nullptr)
+   {
+      int count = DBGetNumRows(hResult);
+      for(int i = 0; i < count; i++)
+      {
+         DataPoint p;
+         p.timestamp = periodStart + static_cast<time_t>(DBGetFieldInt64(hResult, i, 0) * bucketSize);
+         p.value = DBGetFieldDouble(hResult, i, 1);
+         points->add(p);
+      }
+      DBFreeResult(hResult);
+      success = true;
+   }
+   DBFreeStatement(hStmt);
+   return success;
+}
+
+/**
+ * Read raw data points from database and downsample them while reading
+ */
+static bool ReadAndDownsampleData(DB_HANDLE hdb, DCItem *dci, time_t periodStart, time_t periodEnd, time_t bucketSize,
+         uint32_t targetPoints, DownsamplingMethod method, StructArray<DataPoint> *points)
+{
+   TCHAR query[512];
+   if (g_flags & AF_SINGLE_TABLE_PERF_DATA)
+   {
+      if (g_dbSyntax == DB_SYNTAX_TSDB)
+      {
+         _sntprintf(query, 512, _T("SELECT date_part('epoch',idata_timestamp)::int,idata_value FROM idata_sc_%s WHERE item_id=? AND idata_timestamp BETWEEN to_timestamp(?) AND to_timestamp(?) ORDER BY idata_timestamp DESC"),
+                  DCObject::getStorageClassName(dci->getStorageClass()));
+      }
+      else
+      {
+         _tcscpy(query, _T("SELECT idata_timestamp,idata_value FROM idata WHERE item_id=? AND idata_timestamp BETWEEN ? AND ? ORDER BY idata_timestamp DESC"));
+      }
+   }
+   else
+   {
+      _sntprintf(query, 512, _T("SELECT idata_timestamp,idata_value FROM idata_%u WHERE item_id=? AND idata_timestamp BETWEEN ? AND ? ORDER BY idata_timestamp DESC"), dci->getOwnerId());
+   }
+
+   DB_STATEMENT hStmt = DBPrepare(hdb, query);
+   if (hStmt == nullptr)
+      return false;
+
+   bool success = false;
+   DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, dci->getId());
+   DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, static_cast<INT32>(periodStart));
+   DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<INT32>(periodEnd));
+   DB_UNBUFFERED_RESULT hResult = DBSelectPreparedUnbuffered(hStmt);
+   if (hResult != nullptr)
+   {
+      // LTTB needs all points, other methods are calculated while reading
+      StructArray<DataPoint> *input = (method == DCI_DOWNSAMPLE_LTTB) ? new StructArray<DataPoint>(0, 65536) : nullptr;
+      BucketAggregator aggregator(periodStart, bucketSize, method, points);
+      TCHAR buffer[MAX_DB_STRING];
+      while(DBFetch(hResult))
+      {
+         DBGetField(hResult, 1, buffer, MAX_DB_STRING);
+         TCHAR *eptr;
+         double value = _tcstod(buffer, &eptr);
+         if ((*eptr != 0) || (eptr == buffer))
+            continue;   // Not a number
+
+         time_t timestamp = static_cast<time_t>(DBGetFieldULong(hResult, 0));
+         if (input != nullptr)
+         {
+            DataPoint p;
+            p.timestamp = timestamp;
+            p.value = value;
+            input->add(p);
+         }
+         else
+         {
+            aggregator.add(timestamp, value);
+         }
+      }
+      DBFreeResult(hResult);
+
+      if (input != nullptr)
+      {
+         DownsamplePoints(input, periodStart, bucketSize, targetPoints, method, points);
+         delete input;
+      }
+      else
+      {
+         aggregator.finish();
+      }
+      success = true;
+   }
+   DBFreeStatement(hStmt);
+   return success;
+}
+
+/**
+ * Get downsampled history of given DCI for given period. Period is divided into buckets of equal size and
+ * each bucket is represented by single point (minimum, maximum, or average value within bucket), or
+ * points are selected by LTTB algorithm. Number of returned points does not exceed target point count.
+ * Points are returned newest first. Short periods fully covered by DCI value cache are served without
+ * database access. Minimum, maximum, and average are calculated on database side when possible.
+ */
+bool GetDownsampledDCIData(DCItem *dci, time_t periodStart, time_t periodEnd, uint32_t targetPoints, DownsamplingMethod method, StructArray<DataPoint> *points)
+{
+   if ((targetPoints == 0) || (periodEnd < periodStart))
+      return false;
+
+   time_t bucketSize = GetDownsampleBucketSize(periodStart, periodEnd, targetPoints);
+   INT64 startTime = GetCurrentTimeMs();
+
+   StructArray<DataPoint> cachedValues(0, 256);
+   if (dci->getCachedValues(periodStart, periodEnd, &cachedValues))
+   {
+      DownsamplePoints(&cachedValues, periodStart, bucketSize, targetPoints, method, points);
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("GetDownsampledDCIData(%s [%u]): %d points from cache, %d points after downsampling"),
+               dci->getName().cstr(), dci->getId(), cachedValues.size(), points->size());
+      return true;
+   }
+
+   bool success;
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+   TCHAR query[1024];
+   if ((method != DCI_DOWNSAMPLE_LTTB) && BuildAggregationQuery(query, 1024, dci, periodStart, bucketSize, method))
+   {
+      success = ReadAggregatedData(hdb, query, dci, periodStart, periodEnd, bucketSize, points);
+   }
+   else
+   {
+      success = ReadAndDownsampleData(hdb, dci, periodStart, periodEnd, bucketSize, targetPoints, method, points);
+   }
+   DBConnectionPoolReleaseConnection(hdb);
+
+   nxlog_debug_tag(DEBUG_TAG, 7, _T("GetDownsampledDCIData(%s [%u]): %d points, bucket size %u seconds, completed in ") INT64_FMT _T(" ms"),
+            dci->getName().cstr(), dci->getId(), points->size(), static_cast<uint32_t>(bucketSize), GetCurrentTimeMs() - startTime);
+   return success;
+}
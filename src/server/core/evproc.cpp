@@ -96,103 +96,212 @@ static void EventStormDetector()
 }
 
 /**
- * Event logger
+ * Events taken from logger queue but not yet committed to database
+ */
+static ObjectArray<Event> s_loggerBatch(1024, 1024, Ownership::True);
+static Mutex s_loggerBatchLock(true);
+
+/**
+ * Event log writer statistics
+ */
+static uint64_t s_loggerEventsWritten = 0;
+static uint64_t s_loggerTransactions = 0;
+static uint32_t s_loggerMaxQueueSize = 0;
+static int64_t s_loggerAverageWriteTime = 0;
+
+/**
+ * Append values for single event_log record to multi-row INSERT query
+ */
+static void AppendEventLogRecord(StringBuffer& query, DB_HANDLE hdb, Event *event, bool convertTimestamps)
+{
+   query.append(_T('('));
+   query.append(event->getId());
+   query.append(_T(','));
+   query.append(event->getCode());
+   query.append(convertTimestamps ? _T(",to_timestamp(") : _T(","));
+   query.append(static_cast<uint32_t>(event->getTimestamp()));
+   query.append(convertTimestamps ? _T("),") : _T(","));
+   query.append(static_cast<int32_t>(event->getOrigin()));
+   query.append(_T(','));
+   query.append(static_cast<uint32_t>(event->getOriginTimestamp()));
+   query.append(_T(','));
+   query.append(event->getSourceId());
+   query.append(_T(','));
+   query.append(event->getZoneUIN());
+   query.append(_T(','));
+   query.append(event->getDciId());
+   query.append(_T(','));
+   query.append(event->getSeverity());
+   query.append(_T(','));
+   query.append(DBPrepareString(hdb, event->getMessage(), MAX_EVENT_MSG_LENGTH));
+   query.append(_T(','));
+   query.append(event->getRootId());
+   query.append(_T(','));
+   query.append(DBPrepareString(hdb, event->getTagsAsList(), 2000));
+   query.append(_T(','));
+   json_t *json = event->toJson();
+   char *jsonText = json_dumps(json, JSON_COMPACT);
+   query.append(DBPrepareStringUTF8(hdb, jsonText));
+   MemFree(jsonText);
+   json_decref(json);
+   query.append(_T(')'));
+}
+
+/**
+ * Write events using multi-row INSERT statements
+ */
+static bool WriteEventLogRecordsMultiRow(DB_HANDLE hdb, ObjectArray<Event> *events, int maxRecordsPerStmt, bool stopOnError)
+{
+   bool convertTimestamps = (g_dbSyntax == DB_SYNTAX_TSDB);
+   bool success = true;
+   StringBuffer query;
+   query.setAllocationStep(65536);
+   for(int i = 0; i < events->size();)
+   {
+      query = _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,")
+              _T("origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) VALUES ");
+      for(int count = 0; (count < maxRecordsPerStmt) && (i < events->size()); count++, i++)
+      {
+         if (count > 0)
+            query.append(_T(','));
+         AppendEventLogRecord(query, hdb, events->get(i), convertTimestamps);
+      }
+      if (!DBQuery(hdb, query))
+      {
+         success = false;
+         if (stopOnError)
+            break;
+      }
+   }
+   return success;
+}
+
+/**
+ * Write events using prepared statement
+ */
+static bool WriteEventLogRecordsPrepared(DB_HANDLE hdb, ObjectArray<Event> *events, bool stopOnError)
+{
+   DB_STATEMENT hStmt = DBPrepareCached(hdb,
+            _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,")
+            _T("origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
+            _T("VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"));
+   if (hStmt == nullptr)
+      return false;
+
+   bool success = true;
+   for(int i = 0; i < events->size(); i++)
+   {
+      Event *event = events->get(i);
+      DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, event->getId());
+      DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, event->getCode());
+      DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(event->getTimestamp()));
+      DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int32_t>(event->getOrigin()));
+      DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(event->getOriginTimestamp()));
+      DBBind(hStmt, 6, DB_SQLTYPE_INTEGER, event->getSourceId());
+      DBBind(hStmt, 7, DB_SQLTYPE_INTEGER, event->getZoneUIN());
+      DBBind(hStmt, 8, DB_SQLTYPE_INTEGER, event->getDciId());
+      DBBind(hStmt, 9, DB_SQLTYPE_INTEGER, event->getSeverity());
+      DBBind(hStmt, 10, DB_SQLTYPE_VARCHAR, event->getMessage(), DB_BIND_STATIC, MAX_EVENT_MSG_LENGTH);
+      DBBind(hStmt, 11, DB_SQLTYPE_BIGINT, event->getRootId());
+      DBBind(hStmt, 12, DB_SQLTYPE_VARCHAR, event->getTagsAsList(), DB_BIND_TRANSIENT, 2000);
+      json_t *json = event->toJson();
+      DBBind(hStmt, 13, DB_SQLTYPE_TEXT, DB_CTYPE_UTF8_STRING, json_dumps(json, JSON_COMPACT), DB_BIND_DYNAMIC);
+      json_decref(json);
+      if (!DBExecute(hStmt))
+      {
+         success = false;
+         if (stopOnError)
+            break;
+      }
+   }
+   DBFreeStatement(hStmt);
+   return success;
+}
+
+/**
+ * Write batch of events to database. Events are written in single transaction, and if
+ * that fails, each event is written separately so that one bad record will not cause loss of entire batch.
+ */
+static void WriteEventLogBatch(ObjectArray<Event> *events, int maxRecordsPerStmt)
+{
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+
+   // Databases where multi-row VALUES clause is supported
+   bool multiRow = (g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB) ||
+            (g_dbSyntax == DB_SYNTAX_MYSQL) || (g_dbSyntax == DB_SYNTAX_SQLITE);
+
+   bool success = false;
+   if (DBBegin(hdb))
+   {
+      success = multiRow ?
+               WriteEventLogRecordsMultiRow(hdb, events, maxRecordsPerStmt, true) :
+               WriteEventLogRecordsPrepared(hdb, events, true);
+      if (success)
+         success = DBCommit(hdb);
+      else
+         DBRollback(hdb);
+   }
+
+   if (!success)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("EventLogger: batch write failed, writing %d events one by one"), events->size());
+      if (multiRow)
+         WriteEventLogRecordsMultiRow(hdb, events, 1, false);
+      else
+         WriteEventLogRecordsPrepared(hdb, events, false);
+   }
+
+   DBConnectionPoolReleaseConnection(hdb);
+}
+
+/**
+ * Event logger. Collects all events available in queue (up to configured transaction size)
+ * and writes them as single batch, so under load batch size grows naturally without adding
+ * extra delay for single events.
  */
 static void EventLogger()
 {
    ThreadSetName("EventLogger");
 
-   while(true)
+   int maxRecordsPerTxn = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
+   int maxRecordsPerStmt = ConfigReadInt(_T("DBWriter.MaxRecordsPerStatement"), 100);
+
+   bool shutdown = false;
+   while(!shutdown)
    {
-      Event *pEvent = s_loggerQueue.getOrBlock();
-      if (pEvent == INVALID_POINTER_VALUE)
+      Event *event = s_loggerQueue.getOrBlock();
+      if (event == INVALID_POINTER_VALUE)
          break;   // Shutdown indicator
 
-		DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
-		int syntaxId = DBGetSyntax(hdb);
-		if (syntaxId == DB_SYNTAX_SQLITE)
-		{ 
-			StringBuffer query = _T("INSERT INTO event_log (event_id,event_code,event_timestamp,event_source,zone_uin,origin,")
-			               _T("origin_timestamp,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) VALUES (");
-			query.append(pEvent->getId());
-         query.append(_T(','));
-			query.append(pEvent->getCode());
-         query.append(_T(','));
-         query.append((UINT32)pEvent->getTimestamp());
-         query.append(_T(','));
-         query.append(pEvent->getSourceId());
-         query.append(_T(','));
-         query.append(pEvent->getZoneUIN());
-         query.append(_T(','));
-         query.append(static_cast<INT32>(pEvent->getOrigin()));
-         query.append(_T(','));
-         query.append(static_cast<UINT32>(pEvent->getOriginTimestamp()));
-         query.append(_T(','));
-         query.append(pEvent->getDciId());
-         query.append(_T(','));
-         query.append(pEvent->getSeverity());
-         query.append(_T(','));
-         query.append(DBPrepareString(hdb, pEvent->getMessage(), MAX_EVENT_MSG_LENGTH));
-         query.append(_T(','));
-         query.append(pEvent->getRootId());
-         query.append(_T(','));
-         query.append(DBPrepareString(hdb, pEvent->getTagsAsList(), 2000));
-         query.append(_T(','));
-         json_t *json = pEvent->toJson();
-         char *jsonText = json_dumps(json, JSON_INDENT(3) | JSON_EMBED);
-         query.append(DBPrepareStringUTF8(hdb, jsonText));
-         MemFree(jsonText);
-         json_decref(json);
-         query.append(_T(')'));
-
-			DBQuery(hdb, query);
-			nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBQuery: id=%d,code=%d"), (int)pEvent->getId(), (int)pEvent->getCode());
-			delete pEvent;
-		}
-		else
-		{
-			DB_STATEMENT hStmt = DBPrepare(hdb,
-			         (g_dbSyntax == DB_SYNTAX_TSDB) ?
-                        _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,")
-                        _T("origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
-                        _T("VALUES (?,?,to_timestamp(?),?,?,?,?,?,?,?,?,?,?)") :
-                        _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,")
-                        _T("origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
-                        _T("VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"), true);
-			if (hStmt != nullptr)
-			{
-				do
-				{
-					DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, pEvent->getId());
-					DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, pEvent->getCode());
-					DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<UINT32>(pEvent->getTimestamp()));
-               DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<INT32>(pEvent->getOrigin()));
-               DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, static_cast<UINT32>(pEvent->getOriginTimestamp()));
-					DBBind(hStmt, 6, DB_SQLTYPE_INTEGER, pEvent->getSourceId());
-               DBBind(hStmt, 7, DB_SQLTYPE_INTEGER, pEvent->getZoneUIN());
-               DBBind(hStmt, 8, DB_SQLTYPE_INTEGER, pEvent->getDciId());
-					DBBind(hStmt, 9, DB_SQLTYPE_INTEGER, pEvent->getSeverity());
-               DBBind(hStmt, 10, DB_SQLTYPE_VARCHAR, pEvent->getMessage(), DB_BIND_STATIC, MAX_EVENT_MSG_LENGTH);
-					DBBind(hStmt, 11, DB_SQLTYPE_BIGINT, pEvent->getRootId());
-               DBBind(hStmt, 12, DB_SQLTYPE_VARCHAR, pEvent->getTagsAsList(), DB_BIND_TRANSIENT, 2000);
-               DBBind(hStmt, 13, DB_SQLTYPE_TEXT, pEvent->toJson(), DB_BIND_DYNAMIC);
-					DBExecute(hStmt);
-					nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBExecute: id=%d,code=%d"), (int)pEvent->getId(), (int)pEvent->getCode());
-					delete pEvent;
-					pEvent = s_loggerQueue.getOrBlock(500);
-				} while((pEvent != nullptr) && (pEvent != INVALID_POINTER_VALUE));
-				DBFreeStatement(hStmt);
-			}
-			else
-			{
-				delete pEvent;
-			}
-		}
+      uint32_t queueSize = static_cast<uint32_t>(s_loggerQueue.size()) + 1;
+      if (queueSize > s_loggerMaxQueueSize)
+         s_loggerMaxQueueSize = queueSize;
 
-		DBConnectionPoolReleaseConnection(hdb);
-		if (pEvent == INVALID_POINTER_VALUE)
-         break;   // Shutdown indicator (need second check if got it in inner loop)
-	}
+      // Batch is kept accessible for FindEventInLoggerQueue until written
+      s_loggerBatchLock.lock();
+      do
+      {
+         s_loggerBatch.add(event);
+         if (s_loggerBatch.size() >= maxRecordsPerTxn)
+            break;
+         event = s_loggerQueue.get();
+         if (event == INVALID_POINTER_VALUE)
+            shutdown = true;
+      } while((event != nullptr) && !shutdown);
+      s_loggerBatchLock.unlock();
+
+      int64_t startTime = GetCurrentTimeMs();
+      WriteEventLogBatch(&s_loggerBatch, maxRecordsPerStmt);
+      UpdateExpMovingAverage(s_loggerAverageWriteTime, EMA_EXP_180, GetCurrentTimeMs() - startTime);
+      nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: %d events written in ") INT64_FMT _T(" ms"), s_loggerBatch.size(), GetCurrentTimeMs() - startTime);
+
+      s_loggerEventsWritten += s_loggerBatch.size();
+      s_loggerTransactions++;
+
+      s_loggerBatchLock.lock();
+      s_loggerBatch.clear();
+      s_loggerBatchLock.unlock();
+   }
 }
 
 /**
@@ -307,14 +416,386 @@ static void SerialEventProcessor()
    nxlog_debug_tag(DEBUG_TAG, 1, _T("Event processing thread stopped"));
 }
 
+/**
+ * Type of compiled queue selector element
+ */
+enum class QueueSelectorElementType
+{
+   LITERAL,
+   EVENT_CODE,
+   EVENT_NAME,
+   SEVERITY,
+   TIMESTAMP,
+   MESSAGE,
+   CUSTOM_MESSAGE,
+   OBJECT_ID,
+   OBJECT_NAME,
+   OBJECT_GUID,
+   OBJECT_IP_ADDRESS,
+   ZONE_UIN,
+   PARAMETER,
+   NAMED_PARAMETER
+};
+
+/**
+ * Compiled queue selector element
+ */
+struct QueueSelectorElement
+{
+   QueueSelectorElementType type;
+   int index;              // Parameter index
+   TCHAR *text;            // Literal text or parameter name
+   TCHAR *defaultValue;    // Default value for named parameter
+};
+
+/**
+ * Update FNV-1a hash with given data
+ */
+static inline uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+{
+   const BYTE *p = static_cast<const BYTE*>(data);
+   for(size_t i = 0; i < size; i++)
+   {
+      hash ^= p[i];
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+/**
+ * Update FNV-1a hash with given string
+ */
+static inline uint64_t HashString(uint64_t hash, const TCHAR *s)
+{
+   return (s != nullptr) ? HashBytes(hash, s, _tcslen(s) * sizeof(TCHAR)) : hash;
+}
+
+/**
+ * Update FNV-1a hash with given integer value
+ */
+template<typename T> static inline uint64_t HashValue(uint64_t hash, T value)
+{
+   return HashBytes(hash, &value, sizeof(T));
+}
+
+/**
+ * Event queue selector compiled from macro string. Selector is parsed once into sequence of literals and
+ * macro references, and key for each event is calculated as hash of referenced values without building
+ * expanded text. Macros which cannot be evaluated this way (scripts and custom attributes) cause
+ * fallback to full text expansion.
+ */
+class EventQueueSelector
+{
+private:
+   TCHAR *m_source;
+   StructArray<QueueSelectorElement> m_elements;
+   bool m_fallback;
+   bool m_needObject;
+
+   void addLiteral(TCHAR ch);
+   void addElement(QueueSelectorElementType type, int index = 0, TCHAR *text = nullptr, TCHAR *defaultValue = nullptr);
+
+public:
+   EventQueueSelector(const TCHAR *source);
+   ~EventQueueSelector();
+
+   uint64_t getKey(const Event *event) const;
+
+   bool isCompiled() const { return !m_fallback; }
+   int getElementCount() const { return m_elements.size(); }
+};
+
+/**
+ * Compile queue selector. Macro handling follows NetObj::expandText.
+ */
+EventQueueSelector::EventQueueSelector(const TCHAR *source) : m_elements(0, 16)
+{
+   m_source = MemCopyString(source);
+   m_fallback = false;
+   m_needObject = false;
+
+   TCHAR buffer[256];
+   for(const TCHAR *curr = source; (*curr != 0) && !m_fallback; curr++)
+   {
+      if (*curr == _T('\\'))
+      {
+         curr++;
+         if (*curr == 0)
+            break;
+         if (*curr == _T('t'))
+         {
+            addLiteral(_T('\t'));
+         }
+         else if (*curr == _T('n'))
+         {
+            addLiteral(_T('\r'));
+            addLiteral(_T('\n'));
+         }
+         else
+         {
+            addLiteral(*curr);
+         }
+         continue;
+      }
+
+      if (*curr != _T('%'))
+      {
+         addLiteral(*curr);
+         continue;
+      }
+
+      curr++;
+      if (*curr == 0)
+         break;
+
+      switch(*curr)
+      {
+         case '%':
+            addLiteral(_T('%'));
+            break;
+         case 'a':
+            addElement(QueueSelectorElementType::OBJECT_IP_ADDRESS);
+            m_needObject = true;
+            break;
+         case 'c':
+            addElement(QueueSelectorElementType::EVENT_CODE);
+            break;
+         case 'g':
+            addElement(QueueSelectorElementType::OBJECT_GUID);
+            m_needObject = true;
+            break;
+         case 'i':
+         case 'I':
+            addElement(QueueSelectorElementType::OBJECT_ID);
+            m_needObject = true;
+            break;
+         case 'm':
+            addElement(QueueSelectorElementType::MESSAGE);
+            break;
+         case 'M':
+            addElement(QueueSelectorElementType::CUSTOM_MESSAGE);
+            break;
+         case 'n':
+            addElement(QueueSelectorElementType::OBJECT_NAME);
+            m_needObject = true;
+            break;
+         case 'N':
+            addElement(QueueSelectorElementType::EVENT_NAME);
+            break;
+         case 's':
+         case 'S':
+            addElement(QueueSelectorElementType::SEVERITY);
+            break;
+         case 't':
+         case 'T':
+            addElement(QueueSelectorElementType::TIMESTAMP);
+            break;
+         case 'v':
+            for(const TCHAR *p = NETXMS_VERSION_STRING; *p != 0; p++)
+               addLiteral(*p);
+            break;
+         case 'z':
+         case 'Z':
+            addElement(QueueSelectorElementType::ZONE_UIN);
+            m_needObject = true;
+            break;
+         case '0':
+         case '1':
+         case '2':
+         case '3':
+         case '4':
+         case '5':
+         case '6':
+         case '7':
+         case '8':
+         case '9':
+            buffer[0] = *curr;
+            if (_istdigit(*(curr + 1)))
+            {
+               curr++;
+               buffer[1] = *curr;
+               buffer[2] = 0;
+            }
+            else
+            {
+               buffer[1] = 0;
+            }
+            addElement(QueueSelectorElementType::PARAMETER, _tcstol(buffer, nullptr, 10) - 1);
+            break;
+         case '<':   // Named parameter
+            {
+               int i;
+               for(i = 0, curr++; (*curr != '>') && (*curr != 0) && (i < 255); curr++)
+                  buffer[i++] = *curr;
+               if (*curr == 0)
+               {
+                  curr--;
+                  break;
+               }
+               buffer[i] = 0;
+               TCHAR *defaultValue = _tcschr(buffer, _T(':'));
+               if (defaultValue != nullptr)
+               {
+                  *defaultValue = 0;
+                  defaultValue++;
+               }
+               StrStrip(buffer);
+               addElement(QueueSelectorElementType::NAMED_PARAMETER, 0, MemCopyString(buffer), MemCopyString(defaultValue));
+            }
+            break;
+         case '(':   // Input fields are not available in event processor
+            while((*curr != ')') && (*curr != 0))
+               curr++;
+            if (*curr == 0)
+               curr--;
+            break;
+         case '[':   // Script
+         case '{':   // Custom attribute
+            m_fallback = true;
+            break;
+         default:    // Alarm and user related macros are always empty in event processor, other characters are invalid
+            break;
+      }
+   }
+}
+
+/**
+ * Queue selector destructor
+ */
+EventQueueSelector::~EventQueueSelector()
+{
+   for(int i = 0; i < m_elements.size(); i++)
+   {
+      QueueSelectorElement *e = m_elements.get(i);
+      MemFree(e->text);
+      MemFree(e->defaultValue);
+   }
+   MemFree(m_source);
+}
+
+/**
+ * Add literal character (merged with previous literal element if possible)
+ */
+void EventQueueSelector::addLiteral(TCHAR ch)
+{
+   QueueSelectorElement *last = m_elements.get(m_elements.size() - 1);
+   if ((last != nullptr) && (last->type == QueueSelectorElementType::LITERAL))
+   {
+      last->text = MemRealloc(last->text, (last->index + 2) * sizeof(TCHAR));
+      last->text[last->index++] = ch;
+      last->text[last->index] = 0;
+   }
+   else
+   {
+      TCHAR *text = MemAllocString(2);
+      text[0] = ch;
+      text[1] = 0;
+      addElement(QueueSelectorElementType::LITERAL, 1, text);
+   }
+}
+
+/**
+ * Add element
+ */
+void EventQueueSelector::addElement(QueueSelectorElementType type, int index, TCHAR *text, TCHAR *defaultValue)
+{
+   QueueSelectorElement e;
+   e.type = type;
+   e.index = index;
+   e.text = text;
+   e.defaultValue = defaultValue;
+   m_elements.add(e);
+}
+
+/**
+ * Calculate queue key for given event
+ */
+uint64_t EventQueueSelector::getKey(const Event *event) const
+{
+   uint64_t hash = 14695981039346656037ULL;   // FNV-1a offset basis
+   if (m_fallback)
+   {
+      StringBuffer key = event->expandText(m_source, nullptr);
+      return HashString(hash, key.cstr());
+   }
+
+   // Object resolution is the same as in Event::expandText
+   shared_ptr<NetObj> object;
+   if (m_needObject)
+   {
+      object = FindObjectById(event->getSourceId());
+      if (object == nullptr)
+      {
+         object = FindObjectById(g_dwMgmtNode);
+         if (object == nullptr)
+            object = g_entireNetwork;
+      }
+   }
+
+   TCHAR buffer[64];
+   for(int i = 0; i < m_elements.size(); i++)
+   {
+      const QueueSelectorElement *e = m_elements.get(i);
+      hash = HashValue(hash, static_cast<BYTE>(e->type));
+      switch(e->type)
+      {
+         case QueueSelectorElementType::LITERAL:
+            hash = HashBytes(hash, e->text, e->index * sizeof(TCHAR));
+            break;
+         case QueueSelectorElementType::EVENT_CODE:
+            hash = HashValue(hash, event->getCode());
+            break;
+         case QueueSelectorElementType::EVENT_NAME:
+            hash = HashString(hash, event->getName());
+            break;
+         case QueueSelectorElementType::SEVERITY:
+            hash = HashValue(hash, event->getSeverity());
+            break;
+         case QueueSelectorElementType::TIMESTAMP:
+            hash = HashValue(hash, static_cast<int64_t>(event->getTimestamp()));
+            break;
+         case QueueSelectorElementType::MESSAGE:
+            hash = HashString(hash, event->getMessage());
+            break;
+         case QueueSelectorElementType::CUSTOM_MESSAGE:
+            hash = HashString(hash, event->getCustomMessage());
+            break;
+         case QueueSelectorElementType::OBJECT_ID:
+            hash = HashValue(hash, object->getId());
+            break;
+         case QueueSelectorElementType::OBJECT_NAME:
+            hash = HashString(hash, object->getName());
+            break;
+         case QueueSelectorElementType::OBJECT_GUID:
+            hash = HashBytes(hash, object->getGuid().getValue(), sizeof(uuid_t));
+            break;
+         case QueueSelectorElementType::OBJECT_IP_ADDRESS:
+            hash = HashString(hash, object->getPrimaryIpAddress().toString(buffer));
+            break;
+         case QueueSelectorElementType::ZONE_UIN:
+            hash = HashValue(hash, object->getZoneUIN());
+            break;
+         case QueueSelectorElementType::PARAMETER:
+            hash = HashString(hash, event->getParameter(e->index));
+            break;
+         case QueueSelectorElementType::NAMED_PARAMETER:
+            {
+               int index = event->getParameterNames()->indexOfIgnoreCase(e->text);
+               hash = HashString(hash, (index != -1) ? event->getParameter(index) : e->defaultValue);
+            }
+            break;
+      }
+   }
+   return hash;
+}
+
 /**
  * Event queue binding
  */
 struct EventQueueBinding
 {
    UT_hash_handle hh;
-   size_t keyLength;
-   char key[128];
+   uint64_t key;
    ObjectQueue<Event> *queue;
    VolatileCounter usage;
    int processingThread;
@@ -329,6 +810,8 @@ struct EventProcessingThread
    THREAD thread;
    int64_t averageWaitTime;
    uint64_t processedEvents;
+   uint64_t dispatchedEvents;
+   uint64_t bindingAssignments;
    uint32_t bindings;
 
    EventProcessingThread() : queue(4096, Ownership::True)
@@ -336,6 +819,8 @@ struct EventProcessingThread
       thread = INVALID_THREAD_HANDLE;
       averageWaitTime = 0;
       processedEvents = 0;
+      dispatchedEvents = 0;
+      bindingAssignments = 0;
       bindings = 0;
    }
 
@@ -384,6 +869,11 @@ static void ParallelEventProcessor()
    TCHAR queueSelector[256];
    ConfigReadStr(_T("Events.Processor.QueueSelector"), queueSelector, 256, _T("%z"));
    nxlog_write_tag(NXLOG_INFO, DEBUG_TAG, _T("Parallel event processing enabled (queue selector \"%s\")"), queueSelector);
+   EventQueueSelector selector(queueSelector);
+   if (selector.isCompiled())
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Queue selector compiled into %d elements"), selector.getElementCount());
+   else
+      nxlog_debug_tag(DEBUG_TAG, 3, _T("Queue selector requires full macro expansion for each event"));
 
    EventQueueBinding *queueBindings = nullptr;
    ObjectMemoryPool<EventQueueBinding> memoryPool(1024);
@@ -414,19 +904,10 @@ static void ParallelEventProcessor()
 
          time_t now = event->getTimestamp(); // Get current time from event, it should be (almost) current
 
-         StringBuffer key = event->expandText(queueSelector, nullptr);
-#ifdef UNICODE
-         char keyBytes[128];
-         size_t keyLen = wchar_to_utf8(key.cstr(), key.length(), keyBytes, 128);
-#else
-         char *keyBytes = key.getBuffer();
-         size_t keyLen = key.length();
-         if (keyLen > 128)
-            keyLen = 128;
-#endif
+         uint64_t key = selector.getKey(event);
 
          EventQueueBinding *qb;
-         HASH_FIND(hh, queueBindings, keyBytes, keyLen, qb);
+         HASH_FIND(hh, queueBindings, &key, sizeof(uint64_t), qb);
          if ((qb == nullptr) || ((qb->usage == 0) && (qb->queue->size() > 0)))
          {
             // Select less loaded queue
@@ -465,9 +946,8 @@ static void ParallelEventProcessor()
             {
                qb = memoryPool.allocate();
                memset(qb, 0, sizeof(EventQueueBinding));
-               qb->keyLength = keyLen;
-               memcpy(qb->key, keyBytes, keyLen);
-               HASH_ADD_KEYPTR(hh, queueBindings, qb->key, keyLen, qb);
+               qb->key = key;
+               HASH_ADD(hh, queueBindings, key, sizeof(uint64_t), qb);
             }
             else
             {
@@ -481,6 +961,7 @@ static void ParallelEventProcessor()
             qb->processingThread = selectedThread;
             qb->usage = 1;
             s_processingThreads[selectedThread].bindings++;
+            s_processingThreads[selectedThread].bindingAssignments++;
          }
          else
          {
@@ -488,6 +969,7 @@ static void ParallelEventProcessor()
          }
          event->setQueueTime(GetCurrentTimeMs());
          event->setQueueBinding(qb);
+         s_processingThreads[qb->processingThread].dispatchedEvents++;
          qb->queue->put(event);
       }
       else
@@ -566,6 +1048,8 @@ StructArray<EventProcessingThreadStats> *GetEventProcessingThreadStats()
    {
       EventProcessingThreadStats s;
       s.processedEvents = s_processingThreads[i].processedEvents;
+      s.dispatchedEvents = s_processingThreads[i].dispatchedEvents;
+      s.bindingAssignments = s_processingThreads[i].bindingAssignments;
       s.averageWaitTime = s_processingThreads[i].getAverageWaitTime();
       s.queueSize = s_processingThreads[i].queue.size();
       s.bindings = s_processingThreads[i].bindings;
@@ -596,7 +1080,23 @@ static Event *CopyEvent(Event *event)
  */
 Event *FindEventInLoggerQueue(uint64_t eventId)
 {
-   return s_loggerQueue.find(&eventId, CompareEvent, CopyEvent);
+   Event *event = s_loggerQueue.find(&eventId, CompareEvent, CopyEvent);
+   if (event != nullptr)
+      return event;
+
+   // Check events being written by logger
+   s_loggerBatchLock.lock();
+   for(int i = 0; i < s_loggerBatch.size(); i++)
+   {
+      Event *e = s_loggerBatch.get(i);
+      if (e->getId() == eventId)
+      {
+         event = new Event(e);
+         break;
+      }
+   }
+   s_loggerBatchLock.unlock();
+   return event;
 }
 
 /**
@@ -606,3 +1106,15 @@ int64_t GetEventLogWriterQueueSize()
 {
    return s_loggerQueue.size();
 }
+
+/**
+ * Get event log writer statistics
+ */
+void GetEventLogWriterStats(EventLogWriterStats *stats)
+{
+   stats->eventsWritten = s_loggerEventsWritten;
+   stats->transactions = s_loggerTransactions;
+   stats->averageWriteTime = static_cast<uint32_t>(s_loggerAverageWriteTime / EMA_FP_1);
+   stats->queueSize = static_cast<uint32_t>(s_loggerQueue.size());
+   stats->maxQueueSize = s_loggerMaxQueueSize;
+}
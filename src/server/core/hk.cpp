@@ -242,6 +242,482 @@ static void CleanTimescaleData(DB_HANDLE hdb)
    }
 }
 
+/**
+ * Log table descriptor
+ */
+struct LogTable
+{
+   const TCHAR *name;
+   const TCHAR *description;
+   const TCHAR *idColumn;
+   const TCHAR *timestampColumn;
+   const TCHAR *retentionParameter;
+   bool hypertable;   // true if table is converted to hypertable in TimescaleDB
+};
+
+/**
+ * Log tables with time based retention
+ */
+static const LogTable s_logTables[] =
+{
+   { _T("event_log"), _T("event log"), _T("event_id"), _T("event_timestamp"), _T("EventLogRetentionTime"), true },
+   { _T("syslog"), _T("syslog"), _T("msg_id"), _T("msg_timestamp"), _T("SyslogRetentionTime"), true },
+   { _T("audit_log"), _T("audit log"), _T("record_id"), _T("timestamp"), _T("AuditLogRetentionTime"), false },
+   { _T("snmp_trap_log"), _T("SNMP trap log"), _T("trap_id"), _T("trap_timestamp"), _T("SNMPTrapLogRetentionTime"), true },
+   { nullptr, nullptr, nullptr, nullptr, nullptr, false }
+};
+
+/**
+ * Log cleanup parameters
+ */
+static int s_logPartitionPrecreateDays = 7;
+static int s_logCleanupBatchSize = 10000;
+static int s_logCleanupBatchDelay = 100;
+
+/**
+ * Read log cleanup configuration
+ */
+static void ReadLogCleanupConfiguration()
+{
+   s_logPartitionPrecreateDays = std::max(ConfigReadInt(_T("Housekeeper.LogPartitions.PrecreateDays"), 7), 1);
+   s_logCleanupBatchSize = std::max(ConfigReadInt(_T("Housekeeper.LogCleanup.BatchSize"), 10000), 0);
+   s_logCleanupBatchDelay = std::max(ConfigReadInt(_T("Housekeeper.LogCleanup.BatchDelay"), 100), 0);
+   nxlog_debug_tag(DEBUG_TAG, 5, _T("Log partitions pre-created for %d days, cleanup batch size = %d, batch delay = %d ms"),
+            s_logPartitionPrecreateDays, s_logCleanupBatchSize, s_logCleanupBatchDelay);
+}
+
+/**
+ * Convert day number (days since 1970-01-01) to calendar date
+ */
+static void CivilFromDays(int32_t day, int *year, int *month, int *mday)
+{
+   int32_t z = day + 719468;
+   int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+   int32_t doe = z - era * 146097;
+   int32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+   int32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+   int32_t mp = (5 * doy + 2) / 153;
+   *mday = doy - (153 * mp + 2) / 5 + 1;
+   *month = mp < 10 ? mp + 3 : mp - 9;
+   *year = yoe + era * 400 + (*month <= 2 ? 1 : 0);
+}
+
+/**
+ * Convert calendar date to day number (days since 1970-01-01)
+ */
+static int32_t DaysFromCivil(int year, int month, int mday)
+{
+   year -= (month <= 2) ? 1 : 0;
+   int32_t era = (year >= 0 ? year : year - 399) / 400;
+   int32_t yoe = year - era * 400;
+   int32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + mday - 1;
+   int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+   return era * 146097 + doe - 719468;
+}
+
+/**
+ * Check if log table partitioning is supported by current database
+ */
+static inline bool IsLogPartitioningSupported()
+{
+   return (g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB) || (g_dbSyntax == DB_SYNTAX_MYSQL) || (g_dbSyntax == DB_SYNTAX_ORACLE);
+}
+
+/**
+ * Get name of log table partition for given day. Partitions are named <table>_pYYYYMMDD on PostgreSQL
+ * (where each partition is separate table) and pYYYYMMDD on other databases.
+ */
+static void GetLogPartitionName(const LogTable *table, int32_t day, TCHAR *name, size_t size)
+{
+   int year, month, mday;
+   CivilFromDays(day, &year, &month, &mday);
+   if ((g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB))
+      _sntprintf(name, size, _T("%s_p%04d%02d%02d"), table->name, year, month, mday);
+   else
+      _sntprintf(name, size, _T("p%04d%02d%02d"), year, month, mday);
+}
+
+/**
+ * Parse name of log table partition. Returns day number or -1 if name does not follow naming convention.
+ */
+static int32_t ParseLogPartitionName(const LogTable *table, const TCHAR *name)
+{
+   const TCHAR *p = name;
+   if ((g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB))
+   {
+      size_t len = _tcslen(table->name);
+      if (_tcsnicmp(p, table->name, len) || (p[len] != _T('_')))
+         return -1;
+      p += len + 1;
+   }
+   if ((*p != _T('p')) && (*p != _T('P')))
+      return -1;
+   p++;
+
+   if (_tcslen(p) != 8)
+      return -1;
+   for(int i = 0; i < 8; i++)
+      if (!_istdigit(p[i]))
+         return -1;
+
+   TCHAR buffer[5];
+   memcpy(buffer, p, 4 * sizeof(TCHAR));
+   buffer[4] = 0;
+   int year = _tcstol(buffer, nullptr, 10);
+   memcpy(buffer, &p[4], 2 * sizeof(TCHAR));
+   buffer[2] = 0;
+   int month = _tcstol(buffer, nullptr, 10);
+   memcpy(buffer, &p[6], 2 * sizeof(TCHAR));
+   int mday = _tcstol(buffer, nullptr, 10);
+   if ((month < 1) || (month > 12) || (mday < 1) || (mday > 31))
+      return -1;
+   return DaysFromCivil(year, month, mday);
+}
+
+/**
+ * Get partitions of given log table. Returns false if table is not partitioned by range.
+ * Partitions that do not follow naming convention are not returned, flag unmanagedPartitions is set
+ * if there are any. Flag maxValuePartition is set if table has catch-all partition named "pmax"
+ * (MySQL and Oracle only).
+ */
+static bool GetLogTablePartitions(DB_HANDLE hdb, const LogTable *table, IntegerArray<int32_t> *days, bool *maxValuePartition, bool *unmanagedPartitions)
+{
+   *maxValuePartition = false;
+   *unmanagedPartitions = false;
+
+   TCHAR query[512];
+   bool partitioned = false;
+   switch(g_dbSyntax)
+   {
+      case DB_SYNTAX_PGSQL:
+      case DB_SYNTAX_TSDB:
+         _sntprintf(query, 512, _T("SELECT relkind FROM pg_class WHERE relname='%s' AND pg_table_is_visible(oid)"), table->name);
+         break;
+      case DB_SYNTAX_MYSQL:
+         _sntprintf(query, 512, _T("SELECT partition_method FROM information_schema.partitions WHERE table_schema=database() AND table_name='%s' AND partition_name IS NOT NULL"), table->name);
+         break;
+      case DB_SYNTAX_ORACLE:
+         _sntprintf(query, 512, _T("SELECT partitioning_type FROM user_part_tables WHERE table_name=upper('%s')"), table->name);
+         break;
+      default:
+         return false;
+   }
+
+   DB_RESULT hResult = DBSelect(hdb, query);
+   if (hResult == nullptr)
+      return false;
+   if (DBGetNumRows(hResult) > 0)
+   {
+      TCHAR type[32];
+      DBGetField(hResult, 0, 0, type, 32);
+      if ((g_dbSyntax == DB_SYNTAX_PGSQL) || (g_dbSyntax == DB_SYNTAX_TSDB))
+         partitioned = !_tcscmp(type, _T("p"));
+      else
+         partitioned = !_tcsnicmp(type, _T("RANGE"), 5);
+   }
+   DBFreeResult(hResult);
+   if (!partitioned)
+      return false;
+
+   switch(g_dbSyntax)
+   {
+      case DB_SYNTAX_PGSQL:
+      case DB_SYNTAX_TSDB:
+         _sntprintf(query, 512, _T("SELECT c.relname FROM pg_inherits i INNER JOIN pg_class c ON c.oid=i.inhrelid INNER JOIN pg_class p ON p.oid=i.inhparent WHERE p.relname='%s' AND pg_table_is_visible(p.oid)"), table->name);
+         break;
+      case DB_SYNTAX_MYSQL:
+         _sntprintf(query, 512, _T("SELECT partition_name FROM information_schema.partitions WHERE table_schema=database() AND table_name='%s' AND partition_name IS NOT NULL"), table->name);
+         break;
+      case DB_SYNTAX_ORACLE:
+         _sntprintf(query, 512, _T("SELECT partition_name FROM user_tab_partitions WHERE table_name=upper('%s')"), table->name);
+         break;
+   }
+
+   hResult = DBSelect(hdb, query);
+   if (hResult == nullptr)
+      return false;
+
+   int count = DBGetNumRows(hResult);
+   for(int i = 0; i < count; i++)
+   {
+      TCHAR name[128];
+      DBGetField(hResult, i, 0, name, 128);
+      int32_t day = ParseLogPartitionName(table, name);
+      if (day != -1)
+         days->add(day);
+      else if (!_tcsicmp(name, _T("pmax")))
+         *maxValuePartition = true;
+      else
+      {
+         nxlog_debug_tag(DEBUG_TAG, 6, _T("Partition %s of table %s does not follow naming convention and will not be managed by housekeeper"), name, table->name);
+         *unmanagedPartitions = true;
+      }
+   }
+   DBFreeResult(hResult);
+   return true;
+}
+
+/**
+ * Create partition for given day in log table
+ */
+static bool CreateLogTablePartition(DB_HANDLE hdb, const LogTable *table, int32_t day, bool maxValuePartition)
+{
+   TCHAR name[128];
+   GetLogPartitionName(table, day, name, 128);
+
+   int64_t start = static_cast<int64_t>(day) * 86400;
+   int64_t end = start + 86400;
+
+   TCHAR query[512];
+   switch(g_dbSyntax)
+   {
+      case DB_SYNTAX_PGSQL:
+      case DB_SYNTAX_TSDB:
+         _sntprintf(query, 512, _T("CREATE TABLE %s PARTITION OF %s FOR VALUES FROM (") INT64_FMT _T(") TO (") INT64_FMT _T(")"), name, table->name, start, end);
+         break;
+      case DB_SYNTAX_MYSQL:
+         if (maxValuePartition)
+            _sntprintf(query, 512, _T("ALTER TABLE %s REORGANIZE PARTITION pmax INTO (PARTITION %s VALUES LESS THAN (") INT64_FMT _T("), PARTITION pmax VALUES LESS THAN MAXVALUE)"), table->name, name, end);
+         else
+            _sntprintf(query, 512, _T("ALTER TABLE %s ADD PARTITION (PARTITION %s VALUES LESS THAN (") INT64_FMT _T("))"), table->name, name, end);
+         break;
+      case DB_SYNTAX_ORACLE:
+         if (maxValuePartition)
+            _sntprintf(query, 512, _T("ALTER TABLE %s SPLIT PARTITION pmax AT (") INT64_FMT _T(") INTO (PARTITION %s, PARTITION pmax) UPDATE GLOBAL INDEXES"), table->name, end, name);
+         else
+            _sntprintf(query, 512, _T("ALTER TABLE %s ADD PARTITION %s VALUES LESS THAN (") INT64_FMT _T(")"), table->name, name, end);
+         break;
+      default:
+         return false;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 5, _T("Executing query \"%s\""), query);
+   return DBQuery(hdb, query);
+}
+
+/**
+ * Drop partition for given day in log table
+ */
+static bool DropLogTablePartition(DB_HANDLE hdb, const LogTable *table, int32_t day)
+{
+   TCHAR name[128];
+   GetLogPartitionName(table, day, name, 128);
+
+   TCHAR query[512];
+   switch(g_dbSyntax)
+   {
+      case DB_SYNTAX_PGSQL:
+      case DB_SYNTAX_TSDB:
+         _sntprintf(query, 512, _T("DROP TABLE %s"), name);
+         break;
+      case DB_SYNTAX_MYSQL:
+         _sntprintf(query, 512, _T("ALTER TABLE %s DROP PARTITION %s"), table->name, name);
+         break;
+      case DB_SYNTAX_ORACLE:
+         _sntprintf(query, 512, _T("ALTER TABLE %s DROP PARTITION %s UPDATE GLOBAL INDEXES"), table->name, name);
+         break;
+      default:
+         return false;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 5, _T("Executing query \"%s\""), query);
+   return DBQuery(hdb, query);
+}
+
+/**
+ * Maintain partitions of log table partitioned by day. Creates partitions for upcoming days and drops
+ * partitions which are completely outside retention period (if cutoff time is not 0). Returns false
+ * if table is not partitioned or has no partitions following naming convention, and expired records
+ * should be deleted by other means. Flag unmanagedPartitions is set if table has other partitions
+ * which may contain expired records.
+ */
+static bool MaintainLogTablePartitions(DB_HANDLE hdb, const LogTable *table, time_t now, time_t cutoffTime, bool *unmanagedPartitions)
+{
+   IntegerArray<int32_t> days(64, 64);
+   bool maxValuePartition;
+   if (!GetLogTablePartitions(hdb, table, &days, &maxValuePartition, unmanagedPartitions))
+      return false;
+
+   if (days.isEmpty())
+   {
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("Table %s is partitioned but none of its partitions follow naming convention"), table->name);
+      return false;
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("Table %s is partitioned (%d daily partitions)"), table->name, days.size());
+
+   // Create missing partitions ahead of time, starting after last existing daily partition
+   // (but not for past days if housekeeper was not running for a while)
+   int32_t today = static_cast<int32_t>(now / 86400);
+   int32_t lastDay = days.get(0);
+   for(int i = 1; i < days.size(); i++)
+   {
+      if (days.get(i) > lastDay)
+         lastDay = days.get(i);
+   }
+   for(int32_t day = std::max(lastDay + 1, today); day <= today + s_logPartitionPrecreateDays; day++)
+   {
+      if (!CreateLogTablePartition(hdb, table, day, maxValuePartition))
+      {
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("Cannot create partition for day %d in table %s"), day, table->name);
+         break;
+      }
+   }
+
+   // Drop partitions with expired data
+   if (cutoffTime != 0)
+   {
+      int32_t cutoffDay = static_cast<int32_t>(cutoffTime / 86400);
+      for(int i = 0; (i < days.size()) && !s_shutdown; i++)
+      {
+         int32_t day = days.get(i);
+         if (day >= cutoffDay)
+            continue;
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("Dropping partition for day %d in table %s"), day, table->name);
+         DropLogTablePartition(hdb, table, day);
+      }
+   }
+   return true;
+}
+
+/**
+ * Delete expired records from log table. If batch size is set, records are deleted in batches
+ * of given size with throttling between batches to avoid long running transactions.
+ * Returns false if housekeeper should be stopped.
+ */
+static bool DeleteExpiredLogRecords(DB_HANDLE hdb, const LogTable *table, time_t cutoffTime)
+{
+   TCHAR query[512];
+   int batchSize = s_logCleanupBatchSize;
+   switch(g_dbSyntax)
+   {
+      case DB_SYNTAX_MSSQL:
+         _sntprintf(query, 512, _T("DELETE TOP (%d) FROM %s WHERE %s<") INT64_FMT,
+                  batchSize, table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime));
+         break;
+      case DB_SYNTAX_MYSQL:
+         _sntprintf(query, 512, _T("DELETE FROM %s WHERE %s<") INT64_FMT _T(" LIMIT %d"),
+                  table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime), batchSize);
+         break;
+      case DB_SYNTAX_ORACLE:
+         _sntprintf(query, 512, _T("DELETE FROM %s WHERE %s<") INT64_FMT _T(" AND ROWNUM<=%d"),
+                  table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime), batchSize);
+         break;
+      case DB_SYNTAX_PGSQL:
+      case DB_SYNTAX_TSDB:
+         _sntprintf(query, 512, _T("DELETE FROM %s WHERE %s IN (SELECT %s FROM %s WHERE %s<") INT64_FMT _T(" LIMIT %d)"),
+                  table->name, table->idColumn, table->idColumn, table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime), batchSize);
+         break;
+      case DB_SYNTAX_SQLITE:
+         _sntprintf(query, 512, _T("DELETE FROM %s WHERE rowid IN (SELECT rowid FROM %s WHERE %s<") INT64_FMT _T(" LIMIT %d)"),
+                  table->name, table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime), batchSize);
+         break;
+      case DB_SYNTAX_DB2:
+         _sntprintf(query, 512, _T("DELETE FROM (SELECT 1 FROM %s WHERE %s<") INT64_FMT _T(" FETCH FIRST %d ROWS ONLY)"),
+                  table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime), batchSize);
+         break;
+      default:
+         batchSize = 0;
+         break;
+   }
+
+   if (batchSize == 0)
+   {
+      _sntprintf(query, 512, _T("DELETE FROM %s WHERE %s<") INT64_FMT, table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime));
+      DBQuery(hdb, query);
+      return ThrottleHousekeeper();
+   }
+
+   // Query for checking if there are more records to delete
+   TCHAR checkQuery[512];
+   switch(g_dbSyntax)
+   {
+      case DB_SYNTAX_MSSQL:
+         _sntprintf(checkQuery, 512, _T("SELECT TOP 1 %s FROM %s WHERE %s<") INT64_FMT, table->idColumn, table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime));
+         break;
+      case DB_SYNTAX_ORACLE:
+         _sntprintf(checkQuery, 512, _T("SELECT %s FROM %s WHERE %s<") INT64_FMT _T(" AND ROWNUM<=1"), table->idColumn, table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime));
+         break;
+      case DB_SYNTAX_DB2:
+         _sntprintf(checkQuery, 512, _T("SELECT %s FROM %s WHERE %s<") INT64_FMT _T(" FETCH FIRST 1 ROWS ONLY"), table->idColumn, table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime));
+         break;
+      default:
+         _sntprintf(checkQuery, 512, _T("SELECT %s FROM %s WHERE %s<") INT64_FMT _T(" LIMIT 1"), table->idColumn, table->name, table->timestampColumn, static_cast<int64_t>(cutoffTime));
+         break;
+   }
+
+   int batches = 0;
+   while(!s_shutdown)
+   {
+      if (!DBQuery(hdb, query))
+         break;
+      batches++;
+
+      if (!ThrottleHousekeeper())
+         return false;
+
+      DB_RESULT hResult = DBSelect(hdb, checkQuery);
+      if (hResult == nullptr)
+         break;
+      bool moreRecords = (DBGetNumRows(hResult) > 0);
+      DBFreeResult(hResult);
+      if (!moreRecords)
+         break;
+
+      if (s_logCleanupBatchDelay > 0)
+         ThreadSleepMs(s_logCleanupBatchDelay);
+   }
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("%d delete batches executed on table %s"), batches, table->name);
+   return !s_shutdown;
+}
+
+/**
+ * Clean log tables (event log, syslog, audit log, SNMP trap log). Partitioned tables are maintained by
+ * creating partitions ahead of time and dropping expired partitions. If expireData is false only partitions
+ * are created. Returns false if housekeeper should be stopped.
+ */
+static bool CleanLogTables(DB_HANDLE hdb, time_t cycleStartTime, bool expireData)
+{
+   for(const LogTable *table = s_logTables; table->name != nullptr; table++)
+   {
+      uint32_t retentionTime = expireData ? ConfigReadULong(table->retentionParameter, 90) : 0;
+      if (retentionTime > 0)
+         nxlog_debug_tag(DEBUG_TAG, 2, _T("Clearing %s (retention time %d days)"), table->description, retentionTime);
+      retentionTime *= 86400;   // Convert days to seconds
+      time_t cutoffTime = (retentionTime > 0) ? cycleStartTime - retentionTime : 0;
+      bool unmanagedPartitions = false;
+
+      if ((g_dbSyntax == DB_SYNTAX_TSDB) && table->hypertable)
+      {
+         if (cutoffTime != 0)
+         {
+            TCHAR query[256];
+            _sntprintf(query, 256, _T("SELECT drop_chunks(to_timestamp(") INT64_FMT _T("), '%s')"), static_cast<int64_t>(cutoffTime), table->name);
+            DBQuery(hdb, query);
+         }
+      }
+      else if (IsLogPartitioningSupported() && MaintainLogTablePartitions(hdb, table, cycleStartTime, cutoffTime, &unmanagedPartitions))
+      {
+         nxlog_debug_tag(DEBUG_TAG, 4, _T("Partitions of table %s processed"), table->name);
+         if (unmanagedPartitions && (cutoffTime != 0))
+         {
+            // Expired records in partitions not following naming convention are not removed by dropping partitions
+            if (!DeleteExpiredLogRecords(hdb, table, cutoffTime))
+               return false;
+         }
+      }
+      else if (cutoffTime != 0)
+      {
+         if (!DeleteExpiredLogRecords(hdb, table, cutoffTime))
+            return false;
+      }
+
+      if ((cutoffTime != 0) && !ThrottleHousekeeper())
+         return false;
+   }
+   return true;
+}
+
 /**
  * Callback for validating template DCIs
  */
@@ -298,6 +774,12 @@ static void HouseKeeper()
    }
    nxlog_debug_tag(DEBUG_TAG, 2, _T("Wakeup time is %02d:%02d"), hour, minute);
 
+   // Make sure that partitions for log tables exist before first regular housekeeper run
+   ReadLogCleanupConfiguration();
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+   CleanLogTables(hdb, time(nullptr), false);
+   DBConnectionPoolReleaseConnection(hdb);
+
    int sleepTime = GetSleepTime(hour, minute, 0);
    while(!s_shutdown)
    {
@@ -313,73 +795,17 @@ static void HouseKeeper()
       s_throttlingHighWatermark = ConfigReadInt(_T("Housekeeper.Throttle.HighWatermark"), 250000);
       s_throttlingLowWatermark = ConfigReadInt(_T("Housekeeper.Throttle.LowWatermark"), 50000);
       nxlog_debug_tag(DEBUG_TAG, 5, _T("Throttling high watermark = %d, low watermark= %d"), s_throttlingHighWatermark, s_throttlingLowWatermark);
+      ReadLogCleanupConfiguration();
 
 		DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
 		CleanAlarmHistory(hdb);
 
-		// Remove outdated event log records
-		uint32_t retentionTime = ConfigReadULong(_T("EventLogRetentionTime"), 90);
-		if (retentionTime > 0)
-		{
-	      nxlog_debug_tag(DEBUG_TAG, 2, _T("Clearing event log (retention time %d days)"), retentionTime);
-			retentionTime *= 86400;	// Convert days to seconds
-         TCHAR query[256];
-         if (g_dbSyntax == DB_SYNTAX_TSDB)
-            _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT drop_chunks(to_timestamp(") INT64_FMT _T("), 'event_log')"), static_cast<int64_t>(cycleStartTime - retentionTime));
-         else
-            _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("DELETE FROM event_log WHERE event_timestamp<") INT64_FMT, static_cast<int64_t>(cycleStartTime - retentionTime));
-			DBQuery(hdb, query);
-			if (!ThrottleHousekeeper())
-			   break;
-		}
-
-		// Remove outdated syslog records
-		retentionTime = ConfigReadULong(_T("SyslogRetentionTime"), 90);
-		if (retentionTime > 0)
-		{
-         nxlog_debug_tag(DEBUG_TAG, 2, _T("Clearing syslog (retention time %d days)"), retentionTime);
-			retentionTime *= 86400;	// Convert days to seconds
-         TCHAR query[256];
-         if (g_dbSyntax == DB_SYNTAX_TSDB)
-            _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT drop_chunks(to_timestamp(") INT64_FMT _T("), 'syslog')"), static_cast<int64_t>(cycleStartTime - retentionTime));
-         else
-            _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("DELETE FROM syslog WHERE msg_timestamp<") INT64_FMT, static_cast<int64_t>(cycleStartTime - retentionTime));
-			DBQuery(hdb, query);
-         if (!ThrottleHousekeeper())
-            break;
-		}
-
-		// Remove outdated audit log records
-		retentionTime = ConfigReadULong(_T("AuditLogRetentionTime"), 90);
-		if (retentionTime > 0)
-		{
-         nxlog_debug_tag(DEBUG_TAG, 2, _T("Clearing audit log (retention time %d days)"), retentionTime);
-			retentionTime *= 86400;	// Convert days to seconds
-         TCHAR query[256];
-			_sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("DELETE FROM audit_log WHERE timestamp<") INT64_FMT, static_cast<int64_t>(cycleStartTime - retentionTime));
-			DBQuery(hdb, query);
-         if (!ThrottleHousekeeper())
-            break;
-		}
-
-		// Remove outdated SNMP trap log records
-		retentionTime = ConfigReadULong(_T("SNMPTrapLogRetentionTime"), 90);
-		if (retentionTime > 0)
-		{
-         nxlog_debug_tag(DEBUG_TAG, 2, _T("Clearing SNMP trap log (retention time %d days)"), retentionTime);
-			retentionTime *= 86400;	// Convert days to seconds
-         TCHAR query[256];
-         if (g_dbSyntax == DB_SYNTAX_TSDB)
-            _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT drop_chunks(to_timestamp(") INT64_FMT _T("), 'snmp_trap_log')"), static_cast<int64_t>(cycleStartTime - retentionTime));
-         else
-            _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("DELETE FROM snmp_trap_log WHERE trap_timestamp<") INT64_FMT, static_cast<int64_t>(cycleStartTime - retentionTime));
-			DBQuery(hdb, query);
-         if (!ThrottleHousekeeper())
-            break;
-		}
+		// Remove outdated event log, syslog, audit log, and SNMP trap log records
+		if (!CleanLogTables(hdb, cycleStartTime, true))
+		   break;
 
       // Delete old user agent messages
-      retentionTime = ConfigReadULong(_T("UserAgent.RetentionTime"), 30);
+      uint32_t retentionTime = ConfigReadULong(_T("UserAgent.RetentionTime"), 30);
       if (retentionTime > 0)
       {
          nxlog_debug_tag(DEBUG_TAG, 2, _T("Clearing user agent messages log (retention time %d days)"), retentionTime);
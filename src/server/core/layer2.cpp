@@ -61,6 +61,14 @@ void BuildL2Topology(NetworkMapObjectList &topology, Node *root, int nDepth, boo
 	nbs->decRefCount();
 }
 
+/**
+ * Filter for wireless controllers
+ */
+static bool WirelessControllerFilter(NetObj *object, void *context)
+{
+   return static_cast<Node*>(object)->isWirelessController();
+}
+
 /**
  * Find connection point for interface
  */
@@ -75,68 +83,67 @@ shared_ptr<NetObj> FindInterfaceConnectionPoint(const MacAddress& macAddr, int *
       return shared_ptr<NetObj>();
 
 	shared_ptr<NetObj> cp;
-	SharedObjectArray<NetObj> *nodes = g_idxNodeById.getObjects();
 
-	Node *bestMatchNode = nullptr;
+	shared_ptr<Node> bestMatchNode;
 	uint32_t bestMatchIfIndex = 0;
 	int bestMatchCount = 0x7FFFFFFF;
 
-	for(int i = 0; (i < nodes->size()) && (cp == nullptr); i++)
+	// Check switch ports where this MAC address was learned
+	StructArray<MacPortLocation> locations(0, 8);
+	MacDbFindSwitchPorts(macAddr.value(), &locations);
+	for(int i = 0; (i < locations.size()) && (cp == nullptr); i++)
 	{
-		Node *node = (Node *)nodes->get(i);
-		
-      ForwardingDatabase *fdb = node->getSwitchForwardingDatabase();
-		if (fdb != nullptr)
-		{
-			DbgPrintf(6, _T("FindInterfaceConnectionPoint(%s): FDB obtained for node %s [%d]"),
-			          macAddrText, node->getName(), (int)node->getId());
-         bool isStatic;
-         uint32_t ifIndex = fdb->findMacAddress(macAddr.value(), &isStatic);
-			if (ifIndex != 0)
-			{
-			   DbgPrintf(6, _T("FindInterfaceConnectionPoint(%s): MAC address found on interface %d (%s)"),
-                      macAddrText, ifIndex, isStatic ? _T("static") : _T("dynamic"));
-				int count = fdb->getMacCountOnPort(ifIndex);
-				if (count == 1)
-				{
-               if (isStatic)
-               {
-                  // keep it as best match and continue search for dynamic connection
-   					bestMatchCount = count;
-					   bestMatchNode = node;
-					   bestMatchIfIndex = ifIndex;
-               }
-               else
-               {
-					   shared_ptr<Interface> iface = node->findInterfaceByIndex(ifIndex);
-					   if (iface != nullptr)
-					   {
-						   DbgPrintf(4, _T("FindInterfaceConnectionPoint(%s): found interface %s [%u] on node %s [%u]"), macAddrText,
-									    iface->getName(), iface->getId(), iface->getParentNodeName().cstr(), iface->getParentNodeId());
-                     cp = iface;
-                     *type = CP_TYPE_DIRECT;
-					   }
-					   else
-					   {
-						   DbgPrintf(4, _T("FindInterfaceConnectionPoint(%s): cannot find interface object for node %s [%d] ifIndex %d"),
-									    macAddrText, node->getName(), node->getId(), ifIndex);
-					   }
-               }
-				}
-            else if (count < bestMatchCount)
-				{
-					bestMatchCount = count;
-					bestMatchNode = node;
-					bestMatchIfIndex = ifIndex;
-					DbgPrintf(4, _T("FindInterfaceConnectionPoint(%s): found potential interface [ifIndex=%d] on node %s [%d], count %d"), 
-					          macAddrText, ifIndex, node->getName(), (int)node->getId(), count);
-				}
-			}
-			fdb->decRefCount();
-		}
+	   MacPortLocation *location = locations.get(i);
+	   shared_ptr<Node> node = static_pointer_cast<Node>(FindObjectById(location->nodeId, OBJECT_NODE));
+	   if (node == nullptr)
+	      continue;
+
+      DbgPrintf(6, _T("FindInterfaceConnectionPoint(%s): MAC address found on node %s [%d] interface %d (%s)"),
+                macAddrText, node->getName(), (int)node->getId(), location->ifIndex, location->isStatic ? _T("static") : _T("dynamic"));
+      int count = location->macCountOnPort;
+      if (count == 1)
+      {
+         if (location->isStatic)
+         {
+            // keep it as best match and continue search for dynamic connection
+            bestMatchCount = count;
+            bestMatchNode = node;
+            bestMatchIfIndex = location->ifIndex;
+         }
+         else
+         {
+            shared_ptr<Interface> iface = node->findInterfaceByIndex(location->ifIndex);
+            if (iface != nullptr)
+            {
+               DbgPrintf(4, _T("FindInterfaceConnectionPoint(%s): found interface %s [%u] on node %s [%u]"), macAddrText,
+                         iface->getName(), iface->getId(), iface->getParentNodeName().cstr(), iface->getParentNodeId());
+               cp = iface;
+               *type = CP_TYPE_DIRECT;
+            }
+            else
+            {
+               DbgPrintf(4, _T("FindInterfaceConnectionPoint(%s): cannot find interface object for node %s [%d] ifIndex %d"),
+                         macAddrText, node->getName(), node->getId(), location->ifIndex);
+            }
+         }
+      }
+      else if (count < bestMatchCount)
+      {
+         bestMatchCount = count;
+         bestMatchNode = node;
+         bestMatchIfIndex = location->ifIndex;
+         DbgPrintf(4, _T("FindInterfaceConnectionPoint(%s): found potential interface [ifIndex=%d] on node %s [%d], count %d"),
+                   macAddrText, location->ifIndex, node->getName(), (int)node->getId(), count);
+      }
+	}
 
-      if (node->isWirelessController())
+	// Check stations registered on wireless controllers
+	if (cp == nullptr)
+	{
+	   SharedObjectArray<NetObj> *controllers = g_idxNodeById.getObjects(WirelessControllerFilter);
+      for(int i = 0; (i < controllers->size()) && (cp == nullptr); i++)
       {
+         Node *node = static_cast<Node*>(controllers->get(i));
 			DbgPrintf(6, _T("FindInterfaceConnectionPoint(%s): node %s [%d] is a wireless controller, checking associated stations"),
 			          macAddrText, node->getName(), (int)node->getId());
          ObjectArray<WirelessStationInfo> *wsList = node->getWirelessStations();
@@ -145,9 +152,9 @@ shared_ptr<NetObj> FindInterfaceConnectionPoint(const MacAddress& macAddr, int *
 			   DbgPrintf(6, _T("FindInterfaceConnectionPoint(%s): %d wireless stations registered on node %s [%d]"),
                       macAddrText, wsList->size(), node->getName(), (int)node->getId());
 
-            for(int i = 0; i < wsList->size(); i++)
+            for(int j = 0; j < wsList->size(); j++)
             {
-               WirelessStationInfo *ws = wsList->get(i);
+               WirelessStationInfo *ws = wsList->get(j);
                if (!memcmp(ws->macAddr, macAddr.value(), MAC_ADDR_LENGTH))
                {
                   auto ap = static_pointer_cast<AccessPoint>(FindObjectById(ws->apObjectId, OBJECT_ACCESSPOINT));
@@ -186,6 +193,7 @@ shared_ptr<NetObj> FindInterfaceConnectionPoint(const MacAddress& macAddr, int *
 			             macAddrText, node->getName(), (int)node->getId());
          }
       }
+      delete controllers;
 	}
 
 	if ((cp == nullptr) && (bestMatchNode != nullptr))
@@ -198,6 +206,5 @@ shared_ptr<NetObj> FindInterfaceConnectionPoint(const MacAddress& macAddr, int *
       }
 	}
 
-   delete nodes;
 	return cp;
 }
@@ -152,3 +152,213 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE MacDbFind(const MacAddress& macAddr)
       return shared_ptr<NetObj>();
    return MacDbFind(macAddr.value());
 }
+
+/**
+ * Switch port index entry - all known switch ports where given MAC address is learned
+ */
+struct MacPortIndexEntry
+{
+   UT_hash_handle hh;
+   BYTE macAddr[MAC_ADDR_LENGTH];
+   StructArray<MacPortLocation> locations;
+
+   MacPortIndexEntry(const BYTE *addr) : locations(0, 4)
+   {
+      memset(&hh, 0, sizeof(UT_hash_handle));
+      memcpy(macAddr, addr, MAC_ADDR_LENGTH);
+   }
+};
+
+/**
+ * MAC addresses currently indexed for given switch
+ */
+struct MacPortIndexSwitch
+{
+   UT_hash_handle hh;
+   uint32_t nodeId;
+   int macCount;
+   BYTE *macList;
+
+   MacPortIndexSwitch(uint32_t id)
+   {
+      memset(&hh, 0, sizeof(UT_hash_handle));
+      nodeId = id;
+      macCount = 0;
+      macList = nullptr;
+   }
+
+   ~MacPortIndexSwitch()
+   {
+      MemFree(macList);
+   }
+};
+
+/**
+ * Switch port index root
+ */
+static MacPortIndexEntry *s_portIndex = nullptr;
+static MacPortIndexSwitch *s_portIndexSwitches = nullptr;
+
+/**
+ * Switch port index access lock
+ */
+static RWLOCK s_portIndexLock = RWLockCreate();
+
+/**
+ * Remove all locations of given switch from port index. Caller must hold write lock.
+ */
+static void RemoveSwitchPortsInternal(uint32_t nodeId)
+{
+   MacPortIndexSwitch *sw;
+   HASH_FIND(hh, s_portIndexSwitches, &nodeId, sizeof(uint32_t), sw);
+   if (sw == nullptr)
+      return;
+
+   for(int i = 0; i < sw->macCount; i++)
+   {
+      MacPortIndexEntry *entry;
+      HASH_FIND(hh, s_portIndex, &sw->macList[i * MAC_ADDR_LENGTH], MAC_ADDR_LENGTH, entry);
+      if (entry == nullptr)
+         continue;
+
+      for(int j = 0; j < entry->locations.size(); j++)
+      {
+         if (entry->locations.get(j)->nodeId == nodeId)
+         {
+            entry->locations.remove(j);
+            break;
+         }
+      }
+      if (entry->locations.isEmpty())
+      {
+         HASH_DEL(s_portIndex, entry);
+         delete entry;
+      }
+   }
+
+   HASH_DEL(s_portIndexSwitches, sw);
+   delete sw;
+}
+
+/**
+ * Per-port MAC address counter
+ */
+struct PortMacCount
+{
+   uint32_t ifIndex;
+   int count;
+};
+
+/**
+ * Comparator for interface indexes
+ */
+static int CompareIfIndex(const void *e1, const void *e2)
+{
+   uint32_t i1 = *static_cast<const uint32_t*>(e1);
+   uint32_t i2 = *static_cast<const uint32_t*>(e2);
+   return (i1 < i2) ? -1 : ((i1 > i2) ? 1 : 0);
+}
+
+/**
+ * Update switch port index from switch forwarding database. Previously indexed
+ * entries for this switch are replaced. If fdb is nullptr, switch is removed from index.
+ */
+void MacDbUpdateSwitchPorts(uint32_t nodeId, ForwardingDatabase *fdb)
+{
+   // Calculate number of MAC addresses on each port before taking the lock
+   int size = (fdb != nullptr) ? fdb->getSize() : 0;
+   PortMacCount *portCounts = nullptr;
+   int numPorts = 0;
+   if (size > 0)
+   {
+      uint32_t *ifIndexList = MemAllocArrayNoInit<uint32_t>(size);
+      for(int i = 0; i < size; i++)
+         ifIndexList[i] = fdb->getEntry(i)->ifIndex;
+      qsort(ifIndexList, size, sizeof(uint32_t), CompareIfIndex);
+
+      portCounts = MemAllocArrayNoInit<PortMacCount>(size);
+      for(int i = 0; i < size; i++)
+      {
+         if ((numPorts > 0) && (portCounts[numPorts - 1].ifIndex == ifIndexList[i]))
+         {
+            portCounts[numPorts - 1].count++;
+         }
+         else
+         {
+            portCounts[numPorts].ifIndex = ifIndexList[i];
+            portCounts[numPorts].count = 1;
+            numPorts++;
+         }
+      }
+      MemFree(ifIndexList);
+   }
+
+   RWLockWriteLock(s_portIndexLock);
+
+   RemoveSwitchPortsInternal(nodeId);
+
+   if (size > 0)
+   {
+      MacPortIndexSwitch *sw = new MacPortIndexSwitch(nodeId);
+      sw->macList = MemAllocArrayNoInit<BYTE>(size * MAC_ADDR_LENGTH);
+      for(int i = 0; i < size; i++)
+      {
+         FDB_ENTRY *e = fdb->getEntry(i);
+         if (e->ifIndex == 0)
+            continue;   // port not mapped to interface
+
+         MacPortLocation location;
+         location.nodeId = nodeId;
+         location.ifIndex = e->ifIndex;
+         location.isStatic = (e->type == 5);
+         PortMacCount *pc = static_cast<PortMacCount*>(bsearch(&e->ifIndex, portCounts, numPorts, sizeof(PortMacCount), CompareIfIndex));
+         location.macCountOnPort = (pc != nullptr) ? pc->count : 1;
+
+         MacPortIndexEntry *entry;
+         HASH_FIND(hh, s_portIndex, e->macAddr, MAC_ADDR_LENGTH, entry);
+         if (entry == nullptr)
+         {
+            entry = new MacPortIndexEntry(e->macAddr);
+            HASH_ADD(hh, s_portIndex, macAddr, MAC_ADDR_LENGTH, entry);
+         }
+         entry->locations.add(location);
+
+         memcpy(&sw->macList[sw->macCount * MAC_ADDR_LENGTH], e->macAddr, MAC_ADDR_LENGTH);
+         sw->macCount++;
+      }
+      HASH_ADD(hh, s_portIndexSwitches, nodeId, sizeof(uint32_t), sw);
+   }
+
+   RWLockUnlock(s_portIndexLock);
+   MemFree(portCounts);
+}
+
+/**
+ * Remove switch from switch port index
+ */
+void MacDbRemoveSwitchPorts(uint32_t nodeId)
+{
+   RWLockWriteLock(s_portIndexLock);
+   RemoveSwitchPortsInternal(nodeId);
+   RWLockUnlock(s_portIndexLock);
+}
+
+/**
+ * Find all switch ports where given MAC address is learned. Found locations are added to provided array.
+ * Returns number of locations found.
+ */
+int MacDbFindSwitchPorts(const BYTE *macAddr, StructArray<MacPortLocation> *locations)
+{
+   int count = 0;
+   RWLockReadLock(s_portIndexLock);
+   MacPortIndexEntry *entry;
+   HASH_FIND(hh, s_portIndex, macAddr, MAC_ADDR_LENGTH, entry);
+   if (entry != nullptr)
+   {
+      for(int i = 0; i < entry->locations.size(); i++)
+         locations->add(entry->locations.get(i));
+      count = entry->locations.size();
+   }
+   RWLockUnlock(s_portIndexLock);
+   return count;
+}
@@ -572,20 +572,8 @@ bool Node::loadFromDatabase(DB_HANDLE hdb, UINT32 dwId)
    DBFreeResult(hResult);
    DBFreeStatement(hStmt);
 
-   loadItemsFromDB(hdb);
+   bResult = loadItemsFromDB(hdb);
    loadACLFromDB(hdb);
-
-   // Walk through all items in the node and load appropriate thresholds
-   bResult = true;
-   for(i = 0; i < m_dcObjects->size(); i++)
-   {
-      if (!m_dcObjects->get(i)->loadThresholdsFromDB(hdb))
-      {
-         DbgPrintf(3, _T("Cannot load thresholds for DCI %d of node %d (%s)"),
-                   m_dcObjects->get(i)->getId(), dwId, m_name);
-         bResult = false;
-      }
-   }
    loadDCIListForCleanup(hdb);
 
    updatePhysicalContainerBinding(m_physicalContainer);
@@ -6192,6 +6180,8 @@ DataCollectionError Node::getInternalTable(const TCHAR *param, Table **result)
          table->addColumn(_T("QUEUE_SIZE"), DCI_DT_UINT, _T("Queue Size"));
          table->addColumn(_T("AVG_WAIT_TIME"), DCI_DT_UINT, _T("Avg. Wait Time"));
          table->addColumn(_T("PROCESSED_EVENTS"), DCI_DT_COUNTER64, _T("Processed Events"));
+         table->addColumn(_T("DISPATCHED_EVENTS"), DCI_DT_COUNTER64, _T("Dispatched Events"));
+         table->addColumn(_T("BINDING_ASSIGNMENTS"), DCI_DT_COUNTER64, _T("Binding Assignments"));
 
          StructArray<EventProcessingThreadStats> *stats = GetEventProcessingThreadStats();
          for(int i = 0; i < stats->size(); i++)
@@ -6203,6 +6193,8 @@ DataCollectionError Node::getInternalTable(const TCHAR *param, Table **result)
             table->set(2, s->queueSize);
             table->set(3, s->averageWaitTime);
             table->set(4, s->processedEvents);
+            table->set(5, s->dispatchedEvents);
+            table->set(6, s->bindingAssignments);
          }
          delete stats;
 
@@ -6243,9 +6235,15 @@ static DataCollectionError GetEventProcessorStatistic(const TCHAR *param, int ty
    auto s = stats->get(pid - 1);
    switch(type)
    {
+      case 'A':
+         ret_uint64(value, s->bindingAssignments);
+         break;
       case 'B':
          ret_uint(value, s->bindings);
          break;
+      case 'D':
+         ret_uint64(value, s->dispatchedEvents);
+         break;
       case 'P':
          ret_uint64(value, s->processedEvents);
          break;
@@ -6623,14 +6621,46 @@ DataCollectionError Node::getInternalMetric(const TCHAR *param, size_t bufSize,
       {
          _sntprintf(buffer, bufSize, UINT64_FMT, g_rawDataWriteRequests);
       }
+      else if (!_tcsicmp(param, _T("Server.EventLogWriter.AverageWriteTime")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStats(&stats);
+         ret_uint(buffer, stats.averageWriteTime);
+      }
+      else if (!_tcsicmp(param, _T("Server.EventLogWriter.EventsWritten")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStats(&stats);
+         ret_uint64(buffer, stats.eventsWritten);
+      }
+      else if (!_tcsicmp(param, _T("Server.EventLogWriter.MaxQueueSize")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStats(&stats);
+         ret_uint(buffer, stats.maxQueueSize);
+      }
+      else if (!_tcsicmp(param, _T("Server.EventLogWriter.Transactions")))
+      {
+         EventLogWriterStats stats;
+         GetEventLogWriterStats(&stats);
+         ret_uint64(buffer, stats.transactions);
+      }
       else if (MatchString(_T("Server.EventProcessor.AverageWaitTime(*)"), param, false))
       {
          rc = GetEventProcessorStatistic(param, 'W', buffer);
       }
+      else if (MatchString(_T("Server.EventProcessor.BindingAssignments(*)"), param, false))
+      {
+         rc = GetEventProcessorStatistic(param, 'A', buffer);
+      }
       else if (MatchString(_T("Server.EventProcessor.Bindings(*)"), param, false))
       {
          rc = GetEventProcessorStatistic(param, 'B', buffer);
       }
+      else if (MatchString(_T("Server.EventProcessor.DispatchedEvents(*)"), param, false))
+      {
+         rc = GetEventProcessorStatistic(param, 'D', buffer);
+      }
       else if (MatchString(_T("Server.EventProcessor.ProcessedEvents(*)"), param, false))
       {
          rc = GetEventProcessorStatistic(param, 'P', buffer);
@@ -8178,6 +8208,7 @@ void Node::prepareForDeletion()
    nxlog_debug(4, _T("Node::PrepareForDeletion(%s [%u]): no outstanding polls left"), m_name, m_id);
 
    UnbindAgentTunnel(m_id, 0);
+   MacDbRemoveSwitchPorts(m_id);
 
    super::prepareForDeletion();
 }
@@ -8768,6 +8799,7 @@ void Node::topologyPoll(PollerInfo *poller, ClientSession *pSession, UINT32 rqId
       m_fdb->decRefCount();
    m_fdb = fdb;
    MutexUnlock(m_mutexTopoAccess);
+   MacDbUpdateSwitchPorts(m_id, fdb);
    if (fdb != nullptr)
    {
       nxlog_debug_tag(DEBUG_TAG_TOPOLOGY_POLL, 4, _T("Switch forwarding database retrieved for node %s [%d]"), m_name, m_id);
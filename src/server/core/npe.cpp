@@ -170,6 +170,23 @@ static StringObjectMap<PredictionEngine> s_engines(Ownership::True);
  */
 static ThreadPool *s_npeThreadPool = nullptr;
 
+/**
+ * Prediction engine training statistics
+ */
+struct TrainingStatistics
+{
+   uint32_t queued;
+   uint32_t completed;
+   uint64_t totalTime;
+   uint32_t maxTime;
+};
+
+/**
+ * Training statistics for registered engines
+ */
+static StringObjectMap<TrainingStatistics> s_trainingStatistics(Ownership::True);
+static Mutex s_trainingStatisticsLock;
+
 /**
  * Register prediction engines on startup
  */
@@ -187,6 +204,7 @@ void RegisterPredictionEngines()
          if (e->initialize(errorMessage))
          {
             s_engines.set(e->getName(), e);
+            s_trainingStatistics.set(e->getName(), new TrainingStatistics());
             nxlog_write(NXLOG_INFO, _T("Prediction engine %s version %s registered"), e->getName(), e->getVersion());
          }
          else
@@ -206,6 +224,7 @@ void ShutdownPredictionEngines()
 {
    ThreadPoolDestroy(s_npeThreadPool);
    s_engines.clear();
+   s_trainingStatistics.clear();
 }
 
 /**
@@ -214,7 +233,16 @@ void ShutdownPredictionEngines()
 static EnumerationCallbackResult ShowEngineDetails(const TCHAR *key, const void *value, void *data)
 {
    const PredictionEngine *p = (const PredictionEngine *)value;
-   ConsolePrintf((CONSOLE_CTX)data, _T("%-16s | %-24s | %s\n"), key, p->getVersion(), p->getVendor());
+   TrainingStatistics stats;
+   s_trainingStatisticsLock.lock();
+   TrainingStatistics *s = s_trainingStatistics.get(key);
+   if (s != nullptr)
+      memcpy(&stats, s, sizeof(TrainingStatistics));
+   else
+      memset(&stats, 0, sizeof(TrainingStatistics));
+   s_trainingStatisticsLock.unlock();
+   ConsolePrintf((CONSOLE_CTX)data, _T("%-16s | %-24s | %-30s | %6u | %8u | %8u | %8u\n"), key, p->getVersion(), p->getVendor(),
+            stats.queued, stats.completed, (stats.completed > 0) ? static_cast<uint32_t>(stats.totalTime / stats.completed) : 0, stats.maxTime);
    return _CONTINUE;
 }
 
@@ -229,8 +257,8 @@ void ShowPredictionEngines(CONSOLE_CTX console)
       return;
    }
 
-   ConsolePrintf(console, _T("Name             | Version                  | Vendor\n"));
-   ConsolePrintf(console, _T("-----------------+--------------------------+------------------------------\n"));
+   ConsolePrintf(console, _T("Name             | Version                  | Vendor                         | Queued | Trained  | Avg (ms) | Max (ms)\n"));
+   ConsolePrintf(console, _T("-----------------+--------------------------+--------------------------------+--------+----------+----------+---------\n"));
    s_engines.forEach(ShowEngineDetails, console);
 }
 
@@ -355,10 +383,57 @@ bool GetPredictedData(ClientSession *session, const NXCPMessage *request, NXCPMe
    return true;
 }
 
+/**
+ * Prediction engine training request
+ */
+struct TrainingRequest
+{
+   PredictionEngine *engine;
+   uint32_t nodeId;
+   uint32_t dciId;
+   DCObjectStorageClass storageClass;
+};
+
+/**
+ * Run prediction engine training and update training statistics
+ */
+static void TrainPredictionEngine(TrainingRequest *request)
+{
+   int64_t startTime = GetCurrentTimeMs();
+   request->engine->train(request->nodeId, request->dciId, request->storageClass);
+   uint32_t elapsedTime = static_cast<uint32_t>(GetCurrentTimeMs() - startTime);
+
+   s_trainingStatisticsLock.lock();
+   TrainingStatistics *stats = s_trainingStatistics.get(request->engine->getName());
+   if (stats != nullptr)
+   {
+      stats->queued--;
+      stats->completed++;
+      stats->totalTime += elapsedTime;
+      if (stats->maxTime < elapsedTime)
+         stats->maxTime = elapsedTime;
+   }
+   s_trainingStatisticsLock.unlock();
+
+   delete request;
+}
+
 /**
  * Queue training run for prediction engine
  */
 void QueuePredictionEngineTraining(PredictionEngine *engine, DCItem *dci)
 {
-   ThreadPoolExecute(s_npeThreadPool, engine, &PredictionEngine::train, dci->getOwner()->getId(), dci->getId(), dci->getStorageClass());
+   TrainingRequest *request = new TrainingRequest;
+   request->engine = engine;
+   request->nodeId = dci->getOwner()->getId();
+   request->dciId = dci->getId();
+   request->storageClass = dci->getStorageClass();
+
+   s_trainingStatisticsLock.lock();
+   TrainingStatistics *stats = s_trainingStatistics.get(engine->getName());
+   if (stats != nullptr)
+      stats->queued++;
+   s_trainingStatisticsLock.unlock();
+
+   ThreadPoolExecute(s_npeThreadPool, TrainPredictionEngine, request);
 }
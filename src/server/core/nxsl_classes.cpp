@@ -495,6 +495,295 @@ NXSL_METHOD_DEFINITION(NetObj, unmanage)
    return 0;
 }
 
+/**
+ * NetObj::alarms
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, alarms)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   ObjectArray<Alarm> *alarms = GetAlarms(netobj->getId(), true);
+   alarms->setOwner(Ownership::False);
+   NXSL_Array *array = new NXSL_Array(vm);
+   for(int i = 0; i < alarms->size(); i++)
+      array->append(vm->createValue(new NXSL_Object(vm, &g_nxslAlarmClass, alarms->get(i))));
+   value = vm->createValue(array);
+   delete alarms;
+   return value;
+}
+
+/**
+ * NetObj::alias
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, alias)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAlias());
+}
+
+/**
+ * NetObj::backupZoneProxy
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, backupZoneProxy)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   uint32_t id = netobj->getAssignedZoneProxyId(true);
+   if (id != 0)
+   {
+      shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
+      value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::backupZoneProxyId
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, backupZoneProxyId)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAssignedZoneProxyId(true));
+}
+
+/**
+ * NetObj::children
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, children)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getChildrenForNXSL(vm));
+}
+
+/**
+ * NetObj::city
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, city)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress()->getCity());
+}
+
+/**
+ * NetObj::comments
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, comments)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getComments());
+}
+
+/**
+ * NetObj::country
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, country)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress()->getCountry());
+}
+
+/**
+ * NetObj::creationTime
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, creationTime)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(static_cast<INT64>(netobj->getCreationTime()));
+}
+
+/**
+ * NetObj::customAttributes
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, customAttributes)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return netobj->getCustomAttributesForNXSL(vm);
+}
+
+/**
+ * NetObj::geolocation
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, geolocation)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return NXSL_GeoLocationClass::createObject(vm, netobj->getGeoLocation());
+}
+
+/**
+ * NetObj::guid
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, guid)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   TCHAR buffer[64];
+   return vm->createValue(netobj->getGuid().toString(buffer));
+}
+
+/**
+ * NetObj::id
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, id)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getId());
+}
+
+/**
+ * NetObj::ipAddr
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, ipAddr)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   TCHAR buffer[64];
+   netobj->getPrimaryIpAddress().toString(buffer);
+   return vm->createValue(buffer);
+}
+
+/**
+ * NetObj::isInMaintenanceMode
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, isInMaintenanceMode)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->isInMaintenanceMode());
+}
+
+/**
+ * NetObj::maintenanceInitiator
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, maintenanceInitiator)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getMaintenanceInitiator());
+}
+
+/**
+ * NetObj::mapImage
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, mapImage)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   TCHAR buffer[64];
+   return vm->createValue(netobj->getMapImage().toString(buffer));
+}
+
+/**
+ * NetObj::name
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, name)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getName());
+}
+
+/**
+ * NetObj::parents
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, parents)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getParentsForNXSL(vm));
+}
+
+/**
+ * NetObj::postcode
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, postcode)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress()->getPostCode());
+}
+
+/**
+ * NetObj::primaryZoneProxy
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, primaryZoneProxy)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   UINT32 id = netobj->getAssignedZoneProxyId(false);
+   if (id != 0)
+   {
+      shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
+      value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::primaryZoneProxyId
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, primaryZoneProxyId)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAssignedZoneProxyId(false));
+}
+
+/**
+ * NetObj::responsibleUsers
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, responsibleUsers)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value = nullptr;
+   NXSL_Array *array = new NXSL_Array(vm);
+   IntegerArray<UINT32> *responsibleUsers = netobj->getAllResponsibleUsers();
+   ObjectArray<UserDatabaseObject> *userDB = FindUserDBObjects(responsibleUsers);
+   userDB->setOwner(Ownership::False);
+   for(int i = 0; i < userDB->size(); i++)
+   {
+      array->append(userDB->get(i)->createNXSLObject(vm));
+   }
+   value = vm->createValue(array);
+   delete userDB;
+   delete responsibleUsers;
+   return value;
+}
+
+/**
+ * NetObj::state
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, state)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getState());
+}
+
+/**
+ * NetObj::status
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, status)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue((LONG)netobj->getStatus());
+}
+
+/**
+ * NetObj::streetAddress
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, streetAddress)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress()->getStreetAddress());
+}
+
+/**
+ * NetObj::type
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, type)
+{
+   auto netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue((LONG)netobj->getObjectClass());
+}
+
 /**
  * NXSL class NetObj: constructor
  */
@@ -523,6 +812,34 @@ NXSL_NetObjClass::NXSL_NetObjClass() : NXSL_Class()
    NXSL_REGISTER_METHOD(NetObj, unbind, 1);
    NXSL_REGISTER_METHOD(NetObj, unbindFrom, 1);
    NXSL_REGISTER_METHOD(NetObj, unmanage, 0);
+
+   NXSL_REGISTER_ATTRIBUTE(NetObj, alarms);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, alias);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, backupZoneProxy);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, backupZoneProxyId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, children);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, city);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, comments);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, country);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, creationTime);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, customAttributes);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, geolocation);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, guid);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, id);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, ipAddr);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, isInMaintenanceMode);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, maintenanceInitiator);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, mapImage);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, name);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, parents);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, postcode);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, primaryZoneProxy);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, primaryZoneProxyId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, responsibleUsers);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, state);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, status);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, streetAddress);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, type);
 }
 
 /**
@@ -544,153 +861,7 @@ NXSL_Value *NXSL_NetObjClass::getAttr(NXSL_Object *_object, const char *attr)
 
    NXSL_VM *vm = _object->vm();
    auto object = SharedObjectFromData<NetObj>(_object);
-   if (compareAttributeName(attr, "alarms"))
-   {
-      ObjectArray<Alarm> *alarms = GetAlarms(object->getId(), true);
-      alarms->setOwner(Ownership::False);
-      NXSL_Array *array = new NXSL_Array(vm);
-      for(int i = 0; i < alarms->size(); i++)
-         array->append(vm->createValue(new NXSL_Object(vm, &g_nxslAlarmClass, alarms->get(i))));
-      value = vm->createValue(array);
-      delete alarms;
-   }
-   else if (compareAttributeName(attr, "alias"))
-   {
-      value = vm->createValue(object->getAlias());
-   }
-   else if (compareAttributeName(attr, "backupZoneProxy"))
-   {
-      uint32_t id = object->getAssignedZoneProxyId(true);
-      if (id != 0)
-      {
-         shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
-         value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "backupZoneProxyId"))
-   {
-      value = vm->createValue(object->getAssignedZoneProxyId(true));
-   }
-   else if (compareAttributeName(attr, "children"))
-   {
-      value = vm->createValue(object->getChildrenForNXSL(vm));
-   }
-   else if (compareAttributeName(attr, "city"))
-   {
-      value = vm->createValue(object->getPostalAddress()->getCity());
-   }
-   else if (compareAttributeName(attr, "comments"))
-   {
-      value = vm->createValue(object->getComments());
-   }
-   else if (compareAttributeName(attr, "country"))
-   {
-      value = vm->createValue(object->getPostalAddress()->getCountry());
-   }
-   else if (compareAttributeName(attr, "creationTime"))
-   {
-      value = vm->createValue(static_cast<INT64>(object->getCreationTime()));
-   }
-   else if (compareAttributeName(attr, "customAttributes"))
-   {
-      value = object->getCustomAttributesForNXSL(vm);
-   }
-   else if (compareAttributeName(attr, "geolocation"))
-   {
-      value = NXSL_GeoLocationClass::createObject(vm, object->getGeoLocation());
-   }
-   else if (compareAttributeName(attr, "guid"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getGuid().toString(buffer));
-   }
-   else if (compareAttributeName(attr, "id"))
-   {
-      value = vm->createValue(object->getId());
-   }
-   else if (compareAttributeName(attr, "ipAddr"))
-   {
-      TCHAR buffer[64];
-      object->getPrimaryIpAddress().toString(buffer);
-      value = vm->createValue(buffer);
-   }
-   else if (compareAttributeName(attr, "isInMaintenanceMode"))
-   {
-      value = vm->createValue(object->isInMaintenanceMode());
-   }
-   else if (compareAttributeName(attr, "maintenanceInitiator"))
-   {
-      value = vm->createValue(object->getMaintenanceInitiator());
-   }
-   else if (compareAttributeName(attr, "mapImage"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getMapImage().toString(buffer));
-   }
-   else if (compareAttributeName(attr, "name"))
-   {
-      value = vm->createValue(object->getName());
-   }
-   else if (compareAttributeName(attr, "parents"))
-   {
-      value = vm->createValue(object->getParentsForNXSL(vm));
-   }
-   else if (compareAttributeName(attr, "postcode"))
-   {
-      value = vm->createValue(object->getPostalAddress()->getPostCode());
-   }
-   else if (compareAttributeName(attr, "primaryZoneProxy"))
-   {
-      UINT32 id = object->getAssignedZoneProxyId(false);
-      if (id != 0)
-      {
-         shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
-         value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "primaryZoneProxyId"))
-   {
-      value = vm->createValue(object->getAssignedZoneProxyId(false));
-   }
-   else if (compareAttributeName(attr, "responsibleUsers"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      IntegerArray<UINT32> *responsibleUsers = object->getAllResponsibleUsers();
-      ObjectArray<UserDatabaseObject> *userDB = FindUserDBObjects(responsibleUsers);
-      userDB->setOwner(Ownership::False);
-      for(int i = 0; i < userDB->size(); i++)
-      {
-         array->append(userDB->get(i)->createNXSLObject(vm));
-      }
-      value = vm->createValue(array);
-      delete userDB;
-      delete responsibleUsers;
-   }
-   else if (compareAttributeName(attr, "state"))
-   {
-      value = vm->createValue(object->getState());
-   }
-   else if (compareAttributeName(attr, "status"))
-   {
-      value = vm->createValue((LONG)object->getStatus());
-   }
-   else if (compareAttributeName(attr, "streetAddress"))
-   {
-      value = vm->createValue(object->getPostalAddress()->getStreetAddress());
-   }
-   else if (compareAttributeName(attr, "type"))
-   {
-      value = vm->createValue((LONG)object->getObjectClass());
-   }
-   else if (object != nullptr)   // Object can be null if attribute scan is running
+   if (object != nullptr)   // Object can be null if attribute scan is running
    {
 #ifdef UNICODE
       WCHAR wattr[MAX_IDENTIFIER_LENGTH];
@@ -705,67 +876,80 @@ NXSL_Value *NXSL_NetObjClass::getAttr(NXSL_Object *_object, const char *attr)
 }
 
 /**
- * NXSL class Zone: constructor
+ * Subnet::ipNetMask
  */
-NXSL_SubnetClass::NXSL_SubnetClass() : NXSL_NetObjClass()
+NXSL_ATTRIBUTE_DEFINITION(Subnet, ipNetMask)
 {
-   setName(_T("Subnet"));
+   auto subnet = SharedObjectFromData<Subnet>(object);
+   return vm->createValue(subnet->getIpAddress().getMaskBits());
 }
 
 /**
- * NXSL class Zone: get attribute
+ * Subnet::isSyntheticMask
  */
-NXSL_Value *NXSL_SubnetClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Subnet, isSyntheticMask)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   auto subnet = SharedObjectFromData<Subnet>(object);
+   return vm->createValue(subnet->isSyntheticMask());
+}
 
-   NXSL_VM *vm = object->vm();
+/**
+ * Subnet::zone
+ */
+NXSL_ATTRIBUTE_DEFINITION(Subnet, zone)
+{
    auto subnet = SharedObjectFromData<Subnet>(object);
-   if (compareAttributeName(attr, "ipNetMask"))
-   {
-      value = vm->createValue(subnet->getIpAddress().getMaskBits());
-   }
-   else if (compareAttributeName(attr, "isSyntheticMask"))
-   {
-      value = vm->createValue(subnet->isSyntheticMask());
-   }
-   else if (compareAttributeName(attr, "zone"))
+   NXSL_Value *value = nullptr;
+   if (g_flags & AF_ENABLE_ZONING)
    {
-      if (g_flags & AF_ENABLE_ZONING)
+      shared_ptr<Zone> zone = FindZoneByUIN(subnet->getZoneUIN());
+      if (zone != nullptr)
       {
-         shared_ptr<Zone> zone = FindZoneByUIN(subnet->getZoneUIN());
-         if (zone != nullptr)
-         {
-            value = zone->createNXSLObject(vm);
-         }
-         else
-         {
-            value = vm->createValue();
-         }
+         value = zone->createNXSLObject(vm);
       }
       else
       {
          value = vm->createValue();
       }
    }
-   else if (compareAttributeName(attr, "zoneUIN"))
+   else
    {
-      value = vm->createValue(subnet->getZoneUIN());
+      value = vm->createValue();
    }
    return value;
 }
 
 /**
- * DataCollectionTarget::applyTemplate(object)
+ * Subnet::zoneUIN
  */
-NXSL_METHOD_DEFINITION(DataCollectionTarget, applyTemplate)
+NXSL_ATTRIBUTE_DEFINITION(Subnet, zoneUIN)
 {
-   shared_ptr<DataCollectionTarget> thisObject = *static_cast<shared_ptr<DataCollectionTarget>*>(object->getData());
+   auto subnet = SharedObjectFromData<Subnet>(object);
+   return vm->createValue(subnet->getZoneUIN());
+}
 
-   if (!argv[0]->isObject())
-      return NXSL_ERR_NOT_OBJECT;
+/**
+ * NXSL class Zone: constructor
+ */
+NXSL_SubnetClass::NXSL_SubnetClass() : NXSL_NetObjClass()
+{
+   setName(_T("Subnet"));
+
+   NXSL_REGISTER_ATTRIBUTE(Subnet, ipNetMask);
+   NXSL_REGISTER_ATTRIBUTE(Subnet, isSyntheticMask);
+   NXSL_REGISTER_ATTRIBUTE(Subnet, zone);
+   NXSL_REGISTER_ATTRIBUTE(Subnet, zoneUIN);
+}
+
+/**
+ * DataCollectionTarget::applyTemplate(object)
+ */
+NXSL_METHOD_DEFINITION(DataCollectionTarget, applyTemplate)
+{
+   shared_ptr<DataCollectionTarget> thisObject = *static_cast<shared_ptr<DataCollectionTarget>*>(object->getData());
+
+   if (!argv[0]->isObject())
+      return NXSL_ERR_NOT_OBJECT;
 
    NXSL_Object *nxslTemplate = argv[0]->getValueAsObject();
    if (!nxslTemplate->getClass()->instanceOf(g_nxslTemplateClass.getName()))
@@ -816,6 +1000,15 @@ NXSL_METHOD_DEFINITION(DataCollectionTarget, removeTemplate)
    return 0;
 }
 
+/**
+ * DCTarget::templates
+ */
+NXSL_ATTRIBUTE_DEFINITION(DCTarget, templates)
+{
+   auto dcTarget = SharedObjectFromData<DataCollectionTarget>(object);
+   return vm->createValue(dcTarget->getTemplatesForNXSL(vm));
+}
+
 /**
  * NXSL class DataCollectionTarget: constructor
  */
@@ -826,72 +1019,65 @@ NXSL_DCTargetClass::NXSL_DCTargetClass() : NXSL_NetObjClass()
    NXSL_REGISTER_METHOD(DataCollectionTarget, applyTemplate, 1);
    NXSL_REGISTER_METHOD(DataCollectionTarget, readInternalParameter, 1);
    NXSL_REGISTER_METHOD(DataCollectionTarget, removeTemplate, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(DCTarget, templates);
 }
 
 /**
- * NXSL class Zone: get attribute
+ * Zone::proxyNodes
  */
-NXSL_Value *NXSL_DCTargetClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Zone, proxyNodes)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   auto dcTarget = SharedObjectFromData<DataCollectionTarget>(object);
-   if (compareAttributeName(attr, "templates"))
+   auto zone = SharedObjectFromData<Zone>(object);
+   NXSL_Value *value = nullptr;
+   NXSL_Array *array = new NXSL_Array(vm);
+   IntegerArray<UINT32> *proxies = zone->getAllProxyNodes();
+   for(int i = 0; i < proxies->size(); i++)
    {
-      value = vm->createValue(dcTarget->getTemplatesForNXSL(vm));
+      shared_ptr<NetObj> node = FindObjectById(proxies->get(i), OBJECT_NODE);
+      if (node != nullptr)
+         array->append(node->createNXSLObject(vm));
    }
+   value = vm->createValue(array);
+   delete proxies;
    return value;
 }
 
 /**
- * NXSL class Zone: constructor
+ * Zone::proxyNodeIds
  */
-NXSL_ZoneClass::NXSL_ZoneClass() : NXSL_NetObjClass()
+NXSL_ATTRIBUTE_DEFINITION(Zone, proxyNodeIds)
 {
-   setName(_T("Zone"));
+   auto zone = SharedObjectFromData<Zone>(object);
+   NXSL_Value *value = nullptr;
+   NXSL_Array *array = new NXSL_Array(vm);
+   IntegerArray<UINT32> *proxies = zone->getAllProxyNodes();
+   for(int i = 0; i < proxies->size(); i++)
+      array->append(vm->createValue(proxies->get(i)));
+   value = vm->createValue(array);
+   delete proxies;
+   return value;
 }
 
 /**
- * NXSL class Zone: get attribute
+ * Zone::uin
  */
-NXSL_Value *NXSL_ZoneClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Zone, uin)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
    auto zone = SharedObjectFromData<Zone>(object);
-   if (compareAttributeName(attr, "proxyNodes"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      IntegerArray<UINT32> *proxies = zone->getAllProxyNodes();
-      for(int i = 0; i < proxies->size(); i++)
-      {
-         shared_ptr<NetObj> node = FindObjectById(proxies->get(i), OBJECT_NODE);
-         if (node != nullptr)
-            array->append(node->createNXSLObject(vm));
-      }
-      value = vm->createValue(array);
-      delete proxies;
-   }
-   else if (compareAttributeName(attr, "proxyNodeIds"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      IntegerArray<UINT32> *proxies = zone->getAllProxyNodes();
-      for(int i = 0; i < proxies->size(); i++)
-         array->append(vm->createValue(proxies->get(i)));
-      value = vm->createValue(array);
-      delete proxies;
-   }
-   else if (compareAttributeName(attr, "uin"))
-   {
-      value = vm->createValue(zone->getUIN());
-   }
-   return value;
+   return vm->createValue(zone->getUIN());
+}
+
+/**
+ * NXSL class Zone: constructor
+ */
+NXSL_ZoneClass::NXSL_ZoneClass() : NXSL_NetObjClass()
+{
+   setName(_T("Zone"));
+
+   NXSL_REGISTER_ATTRIBUTE(Zone, proxyNodes);
+   NXSL_REGISTER_ATTRIBUTE(Zone, proxyNodeIds);
+   NXSL_REGISTER_ATTRIBUTE(Zone, uin);
 }
 
 /**
@@ -1254,40 +1440,6 @@ NXSL_METHOD_DEFINITION(Node, readWebServiceList)
    return 0;
 }
 
-/**
- * NXSL class Node: constructor
- */
-NXSL_NodeClass::NXSL_NodeClass() : NXSL_DCTargetClass()
-{
-   setName(_T("Node"));
-
-   NXSL_REGISTER_METHOD(Node, createSNMPTransport, -1);
-   NXSL_REGISTER_METHOD(Node, enableAgent, 1);
-   NXSL_REGISTER_METHOD(Node, enableConfigurationPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableDiscoveryPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableEtherNetIP, 1);
-   NXSL_REGISTER_METHOD(Node, enableIcmp, 1);
-   NXSL_REGISTER_METHOD(Node, enablePrimaryIPPing, 1);
-   NXSL_REGISTER_METHOD(Node, enableRoutingTablePolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableSnmp, 1);
-   NXSL_REGISTER_METHOD(Node, enableStatusPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableTopologyPolling, 1);
-   NXSL_REGISTER_METHOD(Node, executeSSHCommand, 1);
-   NXSL_REGISTER_METHOD(Node, getInterface, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByIndex, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByMACAddress, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByName, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceName, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentList, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentTable, 1);
-   NXSL_REGISTER_METHOD(Node, readDriverParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readInternalParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readInternalTable, 1);
-   NXSL_REGISTER_METHOD(Node, readWebServiceList, 1);
-   NXSL_REGISTER_METHOD(Node, readWebServiceParameter, 1);
-}
-
 /**
  * Get ICMP statistic for object
  */
@@ -1307,2150 +1459,3497 @@ static NXSL_Value *GetNodeIcmpStatistic(Node *node, IcmpStatFunction function, N
 }
 
 /**
- * NXSL class Node: get attribute
+ * Node::agentCertificateSubject
  */
-NXSL_Value *NXSL_NodeClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateSubject)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentCertificateSubject());
+}
 
-   NXSL_VM *vm = object->vm();
+/**
+ * Node::agentId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentId)
+{
    auto node = SharedObjectFromData<Node>(object);
-   if (compareAttributeName(attr, "agentCertificateSubject"))
-   {
-      value = vm->createValue(node->getAgentCertificateSubject());
-   }
-   else if (compareAttributeName(attr, "agentId"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(node->getAgentId().toString(buffer));
-   }
-   else if (compareAttributeName(attr, "agentVersion"))
-   {
-      value = vm->createValue(node->getAgentVersion());
-   }
-   else if (compareAttributeName(attr, "bootTime"))
-   {
-      value = vm->createValue(static_cast<INT64>(node->getBootTime()));
-   }
-   else if (compareAttributeName(attr, "bridgeBaseAddress"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(BinToStr(node->getBridgeId(), MAC_ADDR_LENGTH, buffer));
-   }
-   else if (compareAttributeName(attr, "capabilities"))
-   {
-      value = vm->createValue(node->getCapabilities());
-   }
-   else if (compareAttributeName(attr, "cipDeviceType"))
-   {
-      value = vm->createValue(node->getCipDeviceType());
-   }
-   else if (compareAttributeName(attr, "cipDeviceTypeAsText"))
-   {
-      value = vm->createValue(CIP_DeviceTypeNameFromCode(node->getCipDeviceType()));
-   }
-   else if (compareAttributeName(attr, "cipExtendedStatus"))
-   {
-      value = vm->createValue((node->getCipStatus() & CIP_DEVICE_STATUS_EXTENDED_STATUS_MASK) >> 4);
-   }
-   else if (compareAttributeName(attr, "cipExtendedStatusAsText"))
-   {
-      value = vm->createValue(CIP_DecodeExtendedDeviceStatus(node->getCipStatus()));
-   }
-   else if (compareAttributeName(attr, "cipStatus"))
-   {
-      value = vm->createValue(node->getCipStatus());
-   }
-   else if (compareAttributeName(attr, "cipStatusAsText"))
-   {
-      value = vm->createValue(CIP_DecodeDeviceStatus(node->getCipStatus()));
-   }
-   else if (compareAttributeName(attr, "cipState"))
-   {
-      value = vm->createValue(node->getCipState());
-   }
-   else if (compareAttributeName(attr, "cipStateAsText"))
-   {
-      value = vm->createValue(CIP_DeviceStateTextFromCode(node->getCipState()));
-   }
-   else if (compareAttributeName(attr, "cipVendorCode"))
-   {
-      value = vm->createValue(node->getCipVendorCode());
-   }
-   else if (compareAttributeName(attr, "components"))
-   {
-      shared_ptr<ComponentTree> components = node->getComponents();
-      if (components != nullptr)
-      {
-         value = ComponentTree::getRootForNXSL(vm, components);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "dependentNodes"))
-   {
-      StructArray<DependentNode> *dependencies = GetNodeDependencies(node->getId());
-      NXSL_Array *a = new NXSL_Array(vm);
-      for(int i = 0; i < dependencies->size(); i++)
-      {
-         a->append(vm->createValue(new NXSL_Object(vm, &g_nxslNodeDependencyClass, new DependentNode(*dependencies->get(i)))));
-      }
-      value = vm->createValue(a);
-   }
-   else if (compareAttributeName(attr, "driver"))
-   {
-      value = vm->createValue(node->getDriverName());
-   }
-   else if (compareAttributeName(attr, "downSince"))
-   {
-      value = vm->createValue(static_cast<INT64>(node->getDownSince()));
-   }
-   else if (compareAttributeName(attr, "flags"))
-   {
-		value = vm->createValue(node->getFlags());
-   }
-   else if (compareAttributeName(attr, "hasAgentIfXCounters"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_AGENT_IFXCOUNTERS) ? 1 : 0);
-   }
-   else if (compareAttributeName(attr, "hasEntityMIB"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_ENTITY_MIB) ? 1 : 0);
-   }
-   else if (compareAttributeName(attr, "hasIfXTable"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_IFXTABLE) ? 1 : 0);
-   }
-   else if (compareAttributeName(attr, "hasUserAgent"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_HAS_USER_AGENT) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "hasVLANs"))
-   {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_VLANS) ? 1 : 0);
-   }
-   else if (compareAttributeName(attr, "hardwareId"))
+   TCHAR buffer[64];
+   return vm->createValue(node->getAgentId().toString(buffer));
+}
+
+/**
+ * Node::agentVersion
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentVersion)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentVersion());
+}
+
+/**
+ * Node::bootTime
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, bootTime)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<INT64>(node->getBootTime()));
+}
+
+/**
+ * Node::bridgeBaseAddress
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, bridgeBaseAddress)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   TCHAR buffer[64];
+   return vm->createValue(BinToStr(node->getBridgeId(), MAC_ADDR_LENGTH, buffer));
+}
+
+/**
+ * Node::capabilities
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, capabilities)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCapabilities());
+}
+
+/**
+ * Node::cipDeviceType
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipDeviceType)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipDeviceType());
+}
+
+/**
+ * Node::cipDeviceTypeAsText
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipDeviceTypeAsText)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DeviceTypeNameFromCode(node->getCipDeviceType()));
+}
+
+/**
+ * Node::cipExtendedStatus
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipExtendedStatus)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCipStatus() & CIP_DEVICE_STATUS_EXTENDED_STATUS_MASK) >> 4);
+}
+
+/**
+ * Node::cipExtendedStatusAsText
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipExtendedStatusAsText)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DecodeExtendedDeviceStatus(node->getCipStatus()));
+}
+
+/**
+ * Node::cipStatus
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStatus)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipStatus());
+}
+
+/**
+ * Node::cipStatusAsText
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStatusAsText)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DecodeDeviceStatus(node->getCipStatus()));
+}
+
+/**
+ * Node::cipState
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipState)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipState());
+}
+
+/**
+ * Node::cipStateAsText
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStateAsText)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DeviceStateTextFromCode(node->getCipState()));
+}
+
+/**
+ * Node::cipVendorCode
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipVendorCode)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipVendorCode());
+}
+
+/**
+ * Node::components
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, components)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<ComponentTree> components = node->getComponents();
+   if (components != nullptr)
    {
-      TCHAR buffer[HARDWARE_ID_LENGTH * 2 + 1];
-      value = vm->createValue(BinToStr(node->getHardwareId().value(), HARDWARE_ID_LENGTH, buffer));
+      value = ComponentTree::getRootForNXSL(vm, components);
    }
-   else if (compareAttributeName(attr, "hasWinPDH"))
+   else
    {
-      value = vm->createValue((node->getCapabilities() & NC_HAS_WINPDH) ? 1 : 0);
+      value = vm->createValue();
    }
-   else if (compareAttributeName(attr, "hypervisorInfo"))
+   return value;
+}
+
+/**
+ * Node::dependentNodes
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, dependentNodes)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   StructArray<DependentNode> *dependencies = GetNodeDependencies(node->getId());
+   NXSL_Array *a = new NXSL_Array(vm);
+   for(int i = 0; i < dependencies->size(); i++)
    {
-      value = vm->createValue(node->getHypervisorInfo());
+      a->append(vm->createValue(new NXSL_Object(vm, &g_nxslNodeDependencyClass, new DependentNode(*dependencies->get(i)))));
    }
-   else if (compareAttributeName(attr, "hypervisorType"))
-   {
-      value = vm->createValue(node->getHypervisorType());
-   }
-   else if (compareAttributeName(attr, "icmpAverageRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::AVERAGE, vm);
-   }
-   else if (compareAttributeName(attr, "icmpLastRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::LAST, vm);
-   }
-   else if (compareAttributeName(attr, "icmpMaxRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::MAX, vm);
-   }
-   else if (compareAttributeName(attr, "icmpMinRTT"))
+   return vm->createValue(a);
+}
+
+/**
+ * Node::driver
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, driver)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getDriverName());
+}
+
+/**
+ * Node::downSince
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, downSince)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<INT64>(node->getDownSince()));
+}
+
+/**
+ * Node::flags
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, flags)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getFlags());
+}
+
+/**
+ * Node::hasAgentIfXCounters
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasAgentIfXCounters)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_AGENT_IFXCOUNTERS) ? 1 : 0);
+}
+
+/**
+ * Node::hasEntityMIB
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasEntityMIB)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_ENTITY_MIB) ? 1 : 0);
+}
+
+/**
+ * Node::hasIfXTable
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasIfXTable)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_IFXTABLE) ? 1 : 0);
+}
+
+/**
+ * Node::hasUserAgent
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasUserAgent)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_HAS_USER_AGENT) ? 1 : 0));
+}
+
+/**
+ * Node::hasVLANs
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasVLANs)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_VLANS) ? 1 : 0);
+}
+
+/**
+ * Node::hardwareId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hardwareId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   TCHAR buffer[HARDWARE_ID_LENGTH * 2 + 1];
+   return vm->createValue(BinToStr(node->getHardwareId().value(), HARDWARE_ID_LENGTH, buffer));
+}
+
+/**
+ * Node::hasWinPDH
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasWinPDH)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_HAS_WINPDH) ? 1 : 0);
+}
+
+/**
+ * Node::hypervisorInfo
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hypervisorInfo)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getHypervisorInfo());
+}
+
+/**
+ * Node::hypervisorType
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hypervisorType)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getHypervisorType());
+}
+
+/**
+ * Node::icmpAverageRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpAverageRTT)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::AVERAGE, vm);
+}
+
+/**
+ * Node::icmpLastRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpLastRTT)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::LAST, vm);
+}
+
+/**
+ * Node::icmpMaxRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpMaxRTT)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::MAX, vm);
+}
+
+/**
+ * Node::icmpMinRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpMinRTT)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::MIN, vm);
+}
+
+/**
+ * Node::icmpPacketLoss
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpPacketLoss)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::LOSS, vm);
+}
+
+/**
+ * Node::interfaces
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, interfaces)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getInterfacesForNXSL(vm));
+}
+
+/**
+ * Node::isAgent
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isAgent)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_NATIVE_AGENT) ? 1 : 0));
+}
+
+/**
+ * Node::isBridge
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isBridge)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_BRIDGE) ? 1 : 0));
+}
+
+/**
+ * Node::isCDP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isCDP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_CDP) ? 1 : 0));
+}
+
+/**
+ * Node::isEtherNetIP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isEtherNetIP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_ETHERNET_IP) ? 1 : 0));
+}
+
+/**
+ * Node::isLLDP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isLLDP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_LLDP) ? 1 : 0));
+}
+
+/**
+ * Node::isLocalMgmt
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isLocalMgmt)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->isLocalManagement()) ? 1 : 0));
+}
+
+/**
+ * Node::isModbusTCP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isModbusTCP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_MODBUS_TCP) ? 1 : 0));
+}
+
+/**
+ * Node::isOSPF
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isOSPF)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_OSPF) ? 1 : 0));
+}
+
+/**
+ * Node::isPAE
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isPAE)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_8021X) ? 1 : 0));
+}
+
+/**
+ * Node::isPrinter
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isPrinter)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_PRINTER) ? 1 : 0));
+}
+
+/**
+ * Node::isProfiNet
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isProfiNet)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_PROFINET) ? 1 : 0));
+}
+
+/**
+ * Node::isRemotelyManaged
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isRemotelyManaged)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getFlags() & NF_EXTERNAL_GATEWAY) ? 1 : 0));
+}
+
+/**
+ * Node::isRouter
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isRouter)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_ROUTER) ? 1 : 0));
+}
+
+/**
+ * Node::isSMCLP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSMCLP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_SMCLP) ? 1 : 0));
+}
+
+/**
+ * Node::isSNMP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSNMP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_SNMP) ? 1 : 0));
+}
+
+/**
+ * Node::isSONMP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSONMP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_NDP) ? 1 : 0));
+}
+
+/**
+ * Node::isSTP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSTP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)((node->getCapabilities() & NC_IS_STP) ? 1 : 0));
+}
+
+/**
+ * Node::isVirtual
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isVirtual)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)(node->isVirtual() ? 1 : 0));
+}
+
+/**
+ * Node::isVRRP
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isVRRP)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCapabilities() & NC_IS_VRRP) ? 1 : 0);
+}
+
+/**
+ * Node::lastAgentCommTime
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, lastAgentCommTime)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((INT64)node->getLastAgentCommTime());
+}
+
+/**
+ * Node::nodeSubType
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, nodeSubType)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSubType());
+}
+
+/**
+ * Node::nodeType
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, nodeType)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((INT32)node->getType());
+}
+
+/**
+ * Node::physicalContainer
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, physicalContainer)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> container = FindObjectById(node->getPhysicalContainerId());
+   if (container != nullptr)
    {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::MIN, vm);
+      value = container->createNXSLObject(vm);
    }
-   else if (compareAttributeName(attr, "icmpPacketLoss"))
+   else
    {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::LOSS, vm);
+      value = vm->createValue();
    }
-   else if (compareAttributeName(attr, "interfaces"))
-   {
-      value = vm->createValue(node->getInterfacesForNXSL(vm));
-   }
-   else if (compareAttributeName(attr, "isAgent"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_NATIVE_AGENT) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isBridge"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_BRIDGE) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isCDP"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_CDP) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isEtherNetIP"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_ETHERNET_IP) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isInMaintenanceMode"))
-   {
-      value = vm->createValue((LONG)(node->isInMaintenanceMode() ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isLLDP"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_LLDP) ? 1 : 0));
-   }
-	else if (compareAttributeName(attr, "isLocalMgmt") || compareAttributeName(attr, "isLocalManagement"))
-	{
-		value = vm->createValue((LONG)((node->isLocalManagement()) ? 1 : 0));
-	}
-   else if (compareAttributeName(attr, "isModbusTCP"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_MODBUS_TCP) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isOSPF"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_OSPF) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isPAE") || compareAttributeName(attr, "is802_1x"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_8021X) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isPrinter"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_PRINTER) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isProfiNet"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_PROFINET) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isRemotelyManaged") || compareAttributeName(attr, "isExternalGateway"))
-   {
-      value = vm->createValue((LONG)((node->getFlags() & NF_EXTERNAL_GATEWAY) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isRouter"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_ROUTER) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isSMCLP"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_SMCLP) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isSNMP"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_SNMP) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isSONMP") || compareAttributeName(attr, "isNDP"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_NDP) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isSTP"))
-   {
-      value = vm->createValue((LONG)((node->getCapabilities() & NC_IS_STP) ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isVirtual"))
-   {
-      value = vm->createValue((LONG)(node->isVirtual() ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isVRRP"))
+   return value;
+}
+
+/**
+ * Node::physicalContainerId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, physicalContainerId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPhysicalContainerId());
+}
+
+/**
+ * Node::platformName
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, platformName)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPlatformName());
+}
+
+/**
+ * Node::primaryHostName
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, primaryHostName)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPrimaryHostName());
+}
+
+/**
+ * Node::productCode
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productCode)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductCode());
+}
+
+/**
+ * Node::productName
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productName)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductName());
+}
+
+/**
+ * Node::productVersion
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productVersion)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductVersion());
+}
+
+/**
+ * Node::rack
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rack)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> rack = FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK);
+   if (rack != nullptr)
    {
-      value = vm->createValue((node->getCapabilities() & NC_IS_VRRP) ? 1 : 0);
+      value = rack->createNXSLObject(vm);
    }
-   else if (compareAttributeName(attr, "lastAgentCommTime"))
+   else
    {
-      value = vm->createValue((INT64)node->getLastAgentCommTime());
+      value = vm->createValue();
    }
-   else if (compareAttributeName(attr, "nodeSubType"))
+   return value;
+}
+
+/**
+ * Node::rackId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackId)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK) != nullptr)
    {
-      value = vm->createValue(node->getSubType());
+      value = vm->createValue(node->getPhysicalContainerId());
    }
-   else if (compareAttributeName(attr, "nodeType"))
+   else
    {
-      value = vm->createValue((INT32)node->getType());
+      value = vm->createValue(0);
    }
-   else if (compareAttributeName(attr, "physicalContainer"))
+   return value;
+}
+
+/**
+ * Node::rackHeight
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackHeight)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRackHeight());
+}
+
+/**
+ * Node::rackPosition
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackPosition)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRackPosition());
+}
+
+/**
+ * Node::runtimeFlags
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, runtimeFlags)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRuntimeFlags());
+}
+
+/**
+ * Node::serialNumber
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, serialNumber)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSerialNumber());
+}
+
+/**
+ * Node::snmpOID
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpOID)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSNMPObjectId());
+}
+
+/**
+ * Node::snmpSysContact
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysContact)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysContact());
+}
+
+/**
+ * Node::snmpSysLocation
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysLocation)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysLocation());
+}
+
+/**
+ * Node::snmpSysName
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysName)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysName());
+}
+
+/**
+ * Node::snmpVersion
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpVersion)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)node->getSNMPVersion());
+}
+
+/**
+ * Node::sysDescription
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, sysDescription)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysDescription());
+}
+
+/**
+ * Node::vendor
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, vendor)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getVendor());
+}
+
+/**
+ * Node::vlans
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, vlans)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<VlanList> vlans = node->getVlans();
+   if (vlans != nullptr)
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getPhysicalContainerId());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
+      NXSL_Array *a = new NXSL_Array(vm);
+      for(int i = 0; i < vlans->size(); i++)
       {
-         value = vm->createValue();
+         a->append(vm->createValue(new NXSL_Object(vm, &g_nxslVlanClass, new VlanInfo(vlans->get(i), node->getId()))));
       }
+      value = vm->createValue(a);
    }
-   else if (compareAttributeName(attr, "physicalContainerId"))
-   {
-      value = vm->createValue(node->getPhysicalContainerId());
-   }
-   else if (compareAttributeName(attr, "platformName"))
-   {
-      value = vm->createValue(node->getPlatformName());
-   }
-   else if (compareAttributeName(attr, "primaryHostName"))
-   {
-      value = vm->createValue(node->getPrimaryHostName());
-   }
-   else if (compareAttributeName(attr, "productCode"))
-   {
-      value = vm->createValue(node->getProductCode());
-   }
-   else if (compareAttributeName(attr, "productName"))
-   {
-      value = vm->createValue(node->getProductName());
-   }
-   else if (compareAttributeName(attr, "productVersion"))
+   else
    {
-      value = vm->createValue(node->getProductVersion());
+      value = vm->createValue();
    }
-   else if (compareAttributeName(attr, "rack"))
+   return value;
+}
+
+/**
+ * Node::zone
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zone)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (IsZoningEnabled())
    {
-      shared_ptr<NetObj> rack = FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK);
-      if (rack != nullptr)
+      shared_ptr<Zone> zone = FindZoneByUIN(node->getZoneUIN());
+      if (zone != nullptr)
       {
-         value = rack->createNXSLObject(vm);
+         value = zone->createNXSLObject(vm);
       }
       else
       {
          value = vm->createValue();
       }
    }
-   else if (compareAttributeName(attr, "rackId"))
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Node::zoneProxyAssignments
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneProxyAssignments)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (IsZoningEnabled())
    {
-      if (FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK) != nullptr)
+      shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
+      if (zone != nullptr)
       {
-         value = vm->createValue(node->getPhysicalContainerId());
+         value = vm->createValue(zone->getProxyNodeAssignments(node->getId()));
       }
       else
       {
          value = vm->createValue(0);
       }
    }
-   else if (compareAttributeName(attr, "rackHeight"))
-   {
-      value = vm->createValue(node->getRackHeight());
-   }
-   else if (compareAttributeName(attr, "rackPosition"))
-   {
-      value = vm->createValue(node->getRackPosition());
-   }
-   else if (compareAttributeName(attr, "runtimeFlags"))
-   {
-      value = vm->createValue(node->getRuntimeFlags());
-   }
-   else if (compareAttributeName(attr, "serialNumber"))
-   {
-      value = vm->createValue(node->getSerialNumber());
-   }
-   else if (compareAttributeName(attr, "snmpOID"))
-   {
-      value = vm->createValue(node->getSNMPObjectId());
-   }
-   else if (compareAttributeName(attr, "snmpSysContact"))
-   {
-      value = vm->createValue(node->getSysContact());
-   }
-   else if (compareAttributeName(attr, "snmpSysLocation"))
-   {
-      value = vm->createValue(node->getSysLocation());
-   }
-   else if (compareAttributeName(attr, "snmpSysName"))
-   {
-      value = vm->createValue(node->getSysName());
-   }
-   else if (compareAttributeName(attr, "snmpVersion"))
-   {
-      value = vm->createValue((LONG)node->getSNMPVersion());
-   }
-   else if (compareAttributeName(attr, "sysDescription"))
-   {
-      value = vm->createValue(node->getSysDescription());
-   }
-   else if (compareAttributeName(attr, "vendor"))
+   else
    {
-      value = vm->createValue(node->getVendor());
+      value = vm->createValue(0);
    }
-   else if (compareAttributeName(attr, "vlans"))
+   return value;
+}
+
+/**
+ * Node::zoneProxyStatus
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneProxyStatus)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value = nullptr;
+   if (IsZoningEnabled())
    {
-      shared_ptr<VlanList> vlans = node->getVlans();
-      if (vlans != nullptr)
-      {
-         NXSL_Array *a = new NXSL_Array(vm);
-         for(int i = 0; i < vlans->size(); i++)
-         {
-            a->append(vm->createValue(new NXSL_Object(vm, &g_nxslVlanClass, new VlanInfo(vlans->get(i), node->getId()))));
-         }
-         value = vm->createValue(a);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "zone"))
-	{
-      if (IsZoningEnabled())
-      {
-         shared_ptr<Zone> zone = FindZoneByUIN(node->getZoneUIN());
-		   if (zone != nullptr)
-		   {
-			   value = zone->createNXSLObject(vm);
-		   }
-		   else
-		   {
-			   value = vm->createValue();
-		   }
-	   }
-	   else
-	   {
-		   value = vm->createValue();
-	   }
-	}
-   else if (compareAttributeName(attr, "zoneProxyAssignments"))
-   {
-      if (IsZoningEnabled())
+      shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
+      if (zone != nullptr)
       {
-         shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
-         if (zone != nullptr)
-         {
-            value = vm->createValue(zone->getProxyNodeAssignments(node->getId()));
-         }
-         else
-         {
-            value = vm->createValue(0);
-         }
+         value = vm->createValue(zone->isProxyNodeAvailable(node->getId()));
       }
       else
       {
          value = vm->createValue(0);
       }
    }
-   else if (compareAttributeName(attr, "zoneProxyStatus"))
+   else
    {
-      if (IsZoningEnabled())
-      {
-         shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
-         if (zone != nullptr)
-         {
-            value = vm->createValue(zone->isProxyNodeAvailable(node->getId()));
-         }
-         else
-         {
-            value = vm->createValue(0);
-         }
-      }
-      else
-      {
-         value = vm->createValue(0);
-      }
-   }
-   else if (compareAttributeName(attr, "zoneUIN"))
-	{
-      value = vm->createValue(node->getZoneUIN());
+      value = vm->createValue(0);
    }
    return value;
 }
 
 /**
- * Interface::setExcludeFromTopology(enabled) method
+ * Node::zoneUIN
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneUIN)
+{
+   auto node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getZoneUIN());
+}
+
+/**
+ * NXSL class Node: constructor
+ */
+NXSL_NodeClass::NXSL_NodeClass() : NXSL_DCTargetClass()
+{
+   setName(_T("Node"));
+
+   NXSL_REGISTER_METHOD(Node, createSNMPTransport, -1);
+   NXSL_REGISTER_METHOD(Node, enableAgent, 1);
+   NXSL_REGISTER_METHOD(Node, enableConfigurationPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableDiscoveryPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableEtherNetIP, 1);
+   NXSL_REGISTER_METHOD(Node, enableIcmp, 1);
+   NXSL_REGISTER_METHOD(Node, enablePrimaryIPPing, 1);
+   NXSL_REGISTER_METHOD(Node, enableRoutingTablePolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableSnmp, 1);
+   NXSL_REGISTER_METHOD(Node, enableStatusPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableTopologyPolling, 1);
+   NXSL_REGISTER_METHOD(Node, executeSSHCommand, 1);
+   NXSL_REGISTER_METHOD(Node, getInterface, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByIndex, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByMACAddress, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByName, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceName, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentList, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentTable, 1);
+   NXSL_REGISTER_METHOD(Node, readDriverParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readInternalParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readInternalTable, 1);
+   NXSL_REGISTER_METHOD(Node, readWebServiceList, 1);
+   NXSL_REGISTER_METHOD(Node, readWebServiceParameter, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(Node, agentCertificateSubject);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentId);
+   NXSL_REGISTER_ATTRIBUTE(Node, agentVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, bootTime);
+   NXSL_REGISTER_ATTRIBUTE(Node, bridgeBaseAddress);
+   NXSL_REGISTER_ATTRIBUTE(Node, capabilities);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipDeviceType);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipDeviceTypeAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipExtendedStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipExtendedStatusAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStatusAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipState);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipStateAsText);
+   NXSL_REGISTER_ATTRIBUTE(Node, cipVendorCode);
+   NXSL_REGISTER_ATTRIBUTE(Node, components);
+   NXSL_REGISTER_ATTRIBUTE(Node, dependentNodes);
+   NXSL_REGISTER_ATTRIBUTE(Node, driver);
+   NXSL_REGISTER_ATTRIBUTE(Node, downSince);
+   NXSL_REGISTER_ATTRIBUTE(Node, flags);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasAgentIfXCounters);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasEntityMIB);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasIfXTable);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasUserAgent);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasVLANs);
+   NXSL_REGISTER_ATTRIBUTE(Node, hardwareId);
+   NXSL_REGISTER_ATTRIBUTE(Node, hasWinPDH);
+   NXSL_REGISTER_ATTRIBUTE(Node, hypervisorInfo);
+   NXSL_REGISTER_ATTRIBUTE(Node, hypervisorType);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpAverageRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpLastRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpMaxRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpMinRTT);
+   NXSL_REGISTER_ATTRIBUTE(Node, icmpPacketLoss);
+   NXSL_REGISTER_ATTRIBUTE(Node, interfaces);
+   NXSL_REGISTER_ATTRIBUTE(Node, isAgent);
+   NXSL_REGISTER_ATTRIBUTE(Node, isBridge);
+   NXSL_REGISTER_ATTRIBUTE(Node, isCDP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isEtherNetIP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isLLDP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isLocalMgmt);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isLocalMgmt, isLocalManagement);
+   NXSL_REGISTER_ATTRIBUTE(Node, isModbusTCP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isOSPF);
+   NXSL_REGISTER_ATTRIBUTE(Node, isPAE);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isPAE, is802_1x);
+   NXSL_REGISTER_ATTRIBUTE(Node, isPrinter);
+   NXSL_REGISTER_ATTRIBUTE(Node, isProfiNet);
+   NXSL_REGISTER_ATTRIBUTE(Node, isRemotelyManaged);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isRemotelyManaged, isExternalGateway);
+   NXSL_REGISTER_ATTRIBUTE(Node, isRouter);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSMCLP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSNMP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSONMP);
+   NXSL_REGISTER_ATTRIBUTE_ALIAS(Node, isSONMP, isNDP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isSTP);
+   NXSL_REGISTER_ATTRIBUTE(Node, isVirtual);
+   NXSL_REGISTER_ATTRIBUTE(Node, isVRRP);
+   NXSL_REGISTER_ATTRIBUTE(Node, lastAgentCommTime);
+   NXSL_REGISTER_ATTRIBUTE(Node, nodeSubType);
+   NXSL_REGISTER_ATTRIBUTE(Node, nodeType);
+   NXSL_REGISTER_ATTRIBUTE(Node, physicalContainer);
+   NXSL_REGISTER_ATTRIBUTE(Node, physicalContainerId);
+   NXSL_REGISTER_ATTRIBUTE(Node, platformName);
+   NXSL_REGISTER_ATTRIBUTE(Node, primaryHostName);
+   NXSL_REGISTER_ATTRIBUTE(Node, productCode);
+   NXSL_REGISTER_ATTRIBUTE(Node, productName);
+   NXSL_REGISTER_ATTRIBUTE(Node, productVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, rack);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackId);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackHeight);
+   NXSL_REGISTER_ATTRIBUTE(Node, rackPosition);
+   NXSL_REGISTER_ATTRIBUTE(Node, runtimeFlags);
+   NXSL_REGISTER_ATTRIBUTE(Node, serialNumber);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpOID);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysContact);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysLocation);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpSysName);
+   NXSL_REGISTER_ATTRIBUTE(Node, snmpVersion);
+   NXSL_REGISTER_ATTRIBUTE(Node, sysDescription);
+   NXSL_REGISTER_ATTRIBUTE(Node, vendor);
+   NXSL_REGISTER_ATTRIBUTE(Node, vlans);
+   NXSL_REGISTER_ATTRIBUTE(Node, zone);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneProxyAssignments);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneProxyStatus);
+   NXSL_REGISTER_ATTRIBUTE(Node, zoneUIN);
+}
+
+/**
+ * Interface::setExcludeFromTopology(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Interface, setExcludeFromTopology)
+{
+   if (!argv[0]->isInteger())
+      return NXSL_ERR_NOT_INTEGER;
+
+   Interface *iface = static_cast<shared_ptr<Interface>*>(object->getData())->get();
+   iface->setExcludeFromTopology(argv[0]->getValueAsBoolean());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Interface::setExpectedState(state) method
+ */
+NXSL_METHOD_DEFINITION(Interface, setExpectedState)
+{
+   int state;
+   if (argv[0]->isInteger())
+   {
+      state = argv[0]->getValueAsInt32();
+   }
+   else if (argv[0]->isString())
+   {
+      static const TCHAR *stateNames[] = { _T("UP"), _T("DOWN"), _T("IGNORE"), nullptr };
+      const TCHAR *name = argv[0]->getValueAsCString();
+      for(state = 0; stateNames[state] != nullptr; state++)
+         if (!_tcsicmp(stateNames[state], name))
+            break;
+   }
+   else
+   {
+      return NXSL_ERR_NOT_STRING;
+   }
+
+   if ((state >= 0) && (state <= 2))
+      static_cast<shared_ptr<Interface>*>(object->getData())->get()->setExpectedState(state);
+
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Interface::setIncludeInIcmpPoll(enabled) method
+ */
+NXSL_METHOD_DEFINITION(Interface, setIncludeInIcmpPoll)
+{
+   if (!argv[0]->isInteger())
+      return NXSL_ERR_NOT_INTEGER;
+
+   Interface *iface = static_cast<shared_ptr<Interface>*>(object->getData())->get();
+   iface->setIncludeInIcmpPoll(argv[0]->getValueAsBoolean());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Interface::adminState
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, adminState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)iface->getAdminState());
+}
+
+/**
+ * Interface::bridgePortNumber
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, bridgePortNumber)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getBridgePortNumber());
+}
+
+/**
+ * Interface::chassis
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, chassis)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getChassis());
+}
+
+/**
+ * Interface::description
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, description)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getDescription());
+}
+
+/**
+ * Interface::dot1xBackendAuthState
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, dot1xBackendAuthState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)iface->getDot1xBackendAuthState());
+}
+
+/**
+ * Interface::dot1xPaeAuthState
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, dot1xPaeAuthState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)iface->getDot1xPaeAuthState());
+}
+
+/**
+ * Interface::expectedState
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, expectedState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((iface->getFlags() & IF_EXPECTED_STATE_MASK) >> 28);
+}
+
+/**
+ * Interface::flags
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, flags)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getFlags());
+}
+
+/**
+ * Interface::icmpAverageRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpAverageRTT)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetObjectIcmpStatistic(iface, IcmpStatFunction::AVERAGE, vm);
+}
+
+/**
+ * Interface::icmpLastRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpLastRTT)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetObjectIcmpStatistic(iface, IcmpStatFunction::LAST, vm);
+}
+
+/**
+ * Interface::icmpMaxRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpMaxRTT)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetObjectIcmpStatistic(iface, IcmpStatFunction::MAX, vm);
+}
+
+/**
+ * Interface::icmpMinRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpMinRTT)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetObjectIcmpStatistic(iface, IcmpStatFunction::MIN, vm);
+}
+
+/**
+ * Interface::icmpPacketLoss
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, icmpPacketLoss)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return GetObjectIcmpStatistic(iface, IcmpStatFunction::LOSS, vm);
+}
+
+/**
+ * Interface::ifIndex
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ifIndex)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getIfIndex());
+}
+
+/**
+ * Interface::ifType
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ifType)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getIfType());
+}
+
+/**
+ * Interface::ipAddressList
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, ipAddressList)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   const InetAddressList *addrList = iface->getIpAddressList();
+   NXSL_Array *a = new NXSL_Array(vm);
+   for(int i = 0; i < addrList->size(); i++)
+   {
+      a->append(NXSL_InetAddressClass::createObject(vm, addrList->get(i)));
+   }
+   return vm->createValue(a);
+}
+
+/**
+ * Interface::isExcludedFromTopology
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isExcludedFromTopology)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)(iface->isExcludedFromTopology() ? 1 : 0));
+}
+
+/**
+ * Interface::isIncludedInIcmpPoll
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isIncludedInIcmpPoll)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)(iface->isIncludedInIcmpPoll() ? 1 : 0));
+}
+
+/**
+ * Interface::isLoopback
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isLoopback)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)(iface->isLoopback() ? 1 : 0));
+}
+
+/**
+ * Interface::isManuallyCreated
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isManuallyCreated)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)(iface->isManuallyCreated() ? 1 : 0));
+}
+
+/**
+ * Interface::isPhysicalPort
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, isPhysicalPort)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)(iface->isPhysicalPort() ? 1 : 0));
+}
+
+/**
+ * Interface::macAddr
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, macAddr)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   TCHAR buffer[256];
+   return vm->createValue(iface->getMacAddr().toString(buffer));
+}
+
+/**
+ * Interface::module
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, module)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getModule());
+}
+
+/**
+ * Interface::mtu
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, mtu)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getMTU());
+}
+
+/**
+ * Interface::node
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, node)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<Node> parentNode = iface->getParentNode();
+   if (parentNode != nullptr)
+   {
+      value = parentNode->createNXSLObject(vm);
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Interface::operState
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, operState)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue((LONG)iface->getOperState());
+}
+
+/**
+ * Interface::peerInterface
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, peerInterface)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> peerIface = FindObjectById(iface->getPeerInterfaceId(), OBJECT_INTERFACE);
+   if (peerIface != nullptr)
+   {
+      if (g_flags & AF_CHECK_TRUSTED_NODES)
+      {
+         shared_ptr<Node> parentNode = iface->getParentNode();
+         shared_ptr<Node> peerNode = static_cast<Interface*>(peerIface.get())->getParentNode();
+         if ((parentNode != nullptr) && (peerNode != nullptr))
+         {
+            if (peerNode->isTrustedNode(parentNode->getId()))
+            {
+               value = peerIface->createNXSLObject(vm);
+            }
+            else
+            {
+               // No access, return null
+               value = vm->createValue();
+               DbgPrintf(4, _T("NXSL::Interface::peerInterface(%s [%d]): access denied for node %s [%d]"),
+                         iface->getName(), iface->getId(), peerNode->getName(), peerNode->getId());
+            }
+         }
+         else
+         {
+            value = vm->createValue();
+            DbgPrintf(4, _T("NXSL::Interface::peerInterface(%s [%d]): parentNode=% [%u] peerNode=%s [%u]"),
+                  iface->getName(), iface->getId(), parentNode->getName(), parentNode->getId(), peerNode->getName(), peerNode->getId());
+         }
+      }
+      else
+      {
+         value = peerIface->createNXSLObject(vm);
+      }
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Interface::peerNode
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, peerNode)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> peerNode = FindObjectById(iface->getPeerNodeId(), OBJECT_NODE);
+   if (peerNode != nullptr)
+   {
+      if (g_flags & AF_CHECK_TRUSTED_NODES)
+      {
+         shared_ptr<Node> parentNode = iface->getParentNode();
+         if ((parentNode != nullptr) && (peerNode->isTrustedNode(parentNode->getId())))
+         {
+            value = peerNode->createNXSLObject(vm);
+         }
+         else
+         {
+            // No access, return null
+            value = vm->createValue();
+            DbgPrintf(4, _T("NXSL::Interface::peerNode(%s [%d]): access denied for node %s [%d]"),
+                      iface->getName(), iface->getId(), peerNode->getName(), peerNode->getId());
+         }
+      }
+      else
+      {
+         value = peerNode->createNXSLObject(vm);
+      }
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Interface::pic
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, pic)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getPIC());
+}
+
+/**
+ * Interface::port
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, port)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getPort());
+}
+
+/**
+ * Interface::speed
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, speed)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getSpeed());
+}
+
+/**
+ * Interface::vlans
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, vlans)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return iface->getVlanListForNXSL(vm);
+}
+
+/**
+ * Interface::zone
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, zone)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   NXSL_Value *value = nullptr;
+   if (g_flags & AF_ENABLE_ZONING)
+   {
+      shared_ptr<Zone> zone = FindZoneByUIN(iface->getZoneUIN());
+      if (zone != nullptr)
+      {
+         value = zone->createNXSLObject(vm);
+      }
+      else
+      {
+         value = vm->createValue();
+      }
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Interface::zoneUIN
+ */
+NXSL_ATTRIBUTE_DEFINITION(Interface, zoneUIN)
+{
+   auto iface = SharedObjectFromData<Interface>(object);
+   return vm->createValue(iface->getZoneUIN());
+}
+
+/**
+ * NXSL class Interface: constructor
+ */
+NXSL_InterfaceClass::NXSL_InterfaceClass() : NXSL_NetObjClass()
+{
+   setName(_T("Interface"));
+
+   NXSL_REGISTER_METHOD(Interface, setExcludeFromTopology, 1);
+   NXSL_REGISTER_METHOD(Interface, setExpectedState, 1);
+   NXSL_REGISTER_METHOD(Interface, setIncludeInIcmpPoll, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(Interface, adminState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, bridgePortNumber);
+   NXSL_REGISTER_ATTRIBUTE(Interface, chassis);
+   NXSL_REGISTER_ATTRIBUTE(Interface, description);
+   NXSL_REGISTER_ATTRIBUTE(Interface, dot1xBackendAuthState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, dot1xPaeAuthState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, expectedState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, flags);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpAverageRTT);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpLastRTT);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpMaxRTT);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpMinRTT);
+   NXSL_REGISTER_ATTRIBUTE(Interface, icmpPacketLoss);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ifIndex);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ifType);
+   NXSL_REGISTER_ATTRIBUTE(Interface, ipAddressList);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isExcludedFromTopology);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isIncludedInIcmpPoll);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isLoopback);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isManuallyCreated);
+   NXSL_REGISTER_ATTRIBUTE(Interface, isPhysicalPort);
+   NXSL_REGISTER_ATTRIBUTE(Interface, macAddr);
+   NXSL_REGISTER_ATTRIBUTE(Interface, module);
+   NXSL_REGISTER_ATTRIBUTE(Interface, mtu);
+   NXSL_REGISTER_ATTRIBUTE(Interface, node);
+   NXSL_REGISTER_ATTRIBUTE(Interface, operState);
+   NXSL_REGISTER_ATTRIBUTE(Interface, peerInterface);
+   NXSL_REGISTER_ATTRIBUTE(Interface, peerNode);
+   NXSL_REGISTER_ATTRIBUTE(Interface, pic);
+   NXSL_REGISTER_ATTRIBUTE(Interface, port);
+   NXSL_REGISTER_ATTRIBUTE(Interface, speed);
+   NXSL_REGISTER_ATTRIBUTE(Interface, vlans);
+   NXSL_REGISTER_ATTRIBUTE(Interface, zone);
+   NXSL_REGISTER_ATTRIBUTE(Interface, zoneUIN);
+}
+
+/**
+ * AccessPoint::icmpAverageRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, icmpAverageRTT)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return GetObjectIcmpStatistic(ap, IcmpStatFunction::AVERAGE, vm);
+}
+
+/**
+ * AccessPoint::icmpLastRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, icmpLastRTT)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return GetObjectIcmpStatistic(ap, IcmpStatFunction::LAST, vm);
+}
+
+/**
+ * AccessPoint::icmpMaxRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, icmpMaxRTT)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return GetObjectIcmpStatistic(ap, IcmpStatFunction::MAX, vm);
+}
+
+/**
+ * AccessPoint::icmpMinRTT
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, icmpMinRTT)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return GetObjectIcmpStatistic(ap, IcmpStatFunction::MIN, vm);
+}
+
+/**
+ * AccessPoint::icmpPacketLoss
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, icmpPacketLoss)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return GetObjectIcmpStatistic(ap, IcmpStatFunction::LOSS, vm);
+}
+
+/**
+ * AccessPoint::index
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, index)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return vm->createValue(ap->getIndex());
+}
+
+/**
+ * AccessPoint::model
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, model)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return vm->createValue(ap->getModel());
+}
+
+/**
+ * AccessPoint::node
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, node)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<Node> parentNode = ap->getParentNode();
+   if (parentNode != nullptr)
+   {
+      value = parentNode->createNXSLObject(vm);
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * AccessPoint::serialNumber
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, serialNumber)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return vm->createValue(ap->getSerialNumber());
+}
+
+/**
+ * AccessPoint::vendor
+ */
+NXSL_ATTRIBUTE_DEFINITION(AccessPoint, vendor)
+{
+   auto ap = SharedObjectFromData<AccessPoint>(object);
+   return vm->createValue(ap->getVendor());
+}
+
+/**
+ * NXSL class AccessPoint: constructor
+ */
+NXSL_AccessPointClass::NXSL_AccessPointClass() : NXSL_DCTargetClass()
+{
+   setName(_T("AccessPoint"));
+
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, icmpAverageRTT);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, icmpLastRTT);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, icmpMaxRTT);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, icmpMinRTT);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, icmpPacketLoss);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, index);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, model);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, node);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, serialNumber);
+   NXSL_REGISTER_ATTRIBUTE(AccessPoint, vendor);
+}
+
+/**
+ * MobileDevice::deviceId
+ */
+NXSL_ATTRIBUTE_DEFINITION(MobileDevice, deviceId)
+{
+   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
+   return vm->createValue(mobDevice->getDeviceId());
+}
+
+/**
+ * MobileDevice::vendor
+ */
+NXSL_ATTRIBUTE_DEFINITION(MobileDevice, vendor)
+{
+   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
+   return vm->createValue(mobDevice->getVendor());
+}
+
+/**
+ * MobileDevice::model
+ */
+NXSL_ATTRIBUTE_DEFINITION(MobileDevice, model)
+{
+   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
+   return vm->createValue(mobDevice->getModel());
+}
+
+/**
+ * MobileDevice::serialNumber
+ */
+NXSL_ATTRIBUTE_DEFINITION(MobileDevice, serialNumber)
+{
+   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
+   return vm->createValue(mobDevice->getSerialNumber());
+}
+
+/**
+ * MobileDevice::osName
+ */
+NXSL_ATTRIBUTE_DEFINITION(MobileDevice, osName)
+{
+   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
+   return vm->createValue(mobDevice->getOsName());
+}
+
+/**
+ * MobileDevice::osVersion
+ */
+NXSL_ATTRIBUTE_DEFINITION(MobileDevice, osVersion)
+{
+   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
+   return vm->createValue(mobDevice->getOsVersion());
+}
+
+/**
+ * MobileDevice::userId
+ */
+NXSL_ATTRIBUTE_DEFINITION(MobileDevice, userId)
+{
+   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
+   return vm->createValue(mobDevice->getUserId());
+}
+
+/**
+ * MobileDevice::batteryLevel
+ */
+NXSL_ATTRIBUTE_DEFINITION(MobileDevice, batteryLevel)
+{
+   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
+   return vm->createValue(mobDevice->getBatteryLevel());
+}
+
+/**
+ * NXSL class Mobile Device: constructor
+ */
+NXSL_MobileDeviceClass::NXSL_MobileDeviceClass() : NXSL_DCTargetClass()
+{
+   setName(_T("MobileDevice"));
+
+   NXSL_REGISTER_ATTRIBUTE(MobileDevice, deviceId);
+   NXSL_REGISTER_ATTRIBUTE(MobileDevice, vendor);
+   NXSL_REGISTER_ATTRIBUTE(MobileDevice, model);
+   NXSL_REGISTER_ATTRIBUTE(MobileDevice, serialNumber);
+   NXSL_REGISTER_ATTRIBUTE(MobileDevice, osName);
+   NXSL_REGISTER_ATTRIBUTE(MobileDevice, osVersion);
+   NXSL_REGISTER_ATTRIBUTE(MobileDevice, userId);
+   NXSL_REGISTER_ATTRIBUTE(MobileDevice, batteryLevel);
+}
+
+/**
+ * Chassis::controller
+ */
+NXSL_ATTRIBUTE_DEFINITION(Chassis, controller)
+{
+   auto chassis = SharedObjectFromData<Chassis>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> node = FindObjectById(chassis->getControllerId(), OBJECT_NODE);
+   if (node != nullptr)
+   {
+      value = node->createNXSLObject(vm);
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Chassis::controllerId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Chassis, controllerId)
+{
+   auto chassis = SharedObjectFromData<Chassis>(object);
+   return vm->createValue(chassis->getControllerId());
+}
+
+/**
+ * Chassis::flags
+ */
+NXSL_ATTRIBUTE_DEFINITION(Chassis, flags)
+{
+   auto chassis = SharedObjectFromData<Chassis>(object);
+   return vm->createValue(chassis->getFlags());
+}
+
+/**
+ * Chassis::rack
+ */
+NXSL_ATTRIBUTE_DEFINITION(Chassis, rack)
+{
+   auto chassis = SharedObjectFromData<Chassis>(object);
+   NXSL_Value *value = nullptr;
+   shared_ptr<NetObj> rack = FindObjectById(chassis->getRackId(), OBJECT_RACK);
+   if (rack != nullptr)
+   {
+      value = rack->createNXSLObject(vm);
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Chassis::rackId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Chassis, rackId)
+{
+   auto chassis = SharedObjectFromData<Chassis>(object);
+   return vm->createValue(chassis->getRackId());
+}
+
+/**
+ * Chassis::rackHeight
+ */
+NXSL_ATTRIBUTE_DEFINITION(Chassis, rackHeight)
+{
+   auto chassis = SharedObjectFromData<Chassis>(object);
+   return vm->createValue(chassis->getRackHeight());
+}
+
+/**
+ * Chassis::rackPosition
+ */
+NXSL_ATTRIBUTE_DEFINITION(Chassis, rackPosition)
+{
+   auto chassis = SharedObjectFromData<Chassis>(object);
+   return vm->createValue(chassis->getRackPosition());
+}
+
+/**
+ * NXSL class "Chassis" constructor
+ */
+NXSL_ChassisClass::NXSL_ChassisClass() : NXSL_DCTargetClass()
+{
+   setName(_T("Chassis"));
+
+   NXSL_REGISTER_ATTRIBUTE(Chassis, controller);
+   NXSL_REGISTER_ATTRIBUTE(Chassis, controllerId);
+   NXSL_REGISTER_ATTRIBUTE(Chassis, flags);
+   NXSL_REGISTER_ATTRIBUTE(Chassis, rack);
+   NXSL_REGISTER_ATTRIBUTE(Chassis, rackId);
+   NXSL_REGISTER_ATTRIBUTE(Chassis, rackHeight);
+   NXSL_REGISTER_ATTRIBUTE(Chassis, rackPosition);
+}
+
+/**
+ * Cluster::getResourceOwner() method
+ */
+NXSL_METHOD_DEFINITION(Cluster, getResourceOwner)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   UINT32 ownerId = static_cast<shared_ptr<Cluster>*>(object->getData())->get()->getResourceOwner(argv[0]->getValueAsCString());
+   if (ownerId != 0)
+   {
+      shared_ptr<NetObj> object = FindObjectById(ownerId);
+      *result = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      *result = vm->createValue();
+   }
+   return 0;
+}
+
+/**
+ * Cluster::nodes
+ */
+NXSL_ATTRIBUTE_DEFINITION(Cluster, nodes)
+{
+   auto cluster = SharedObjectFromData<Cluster>(object);
+   return vm->createValue(cluster->getNodesForNXSL(vm));
+}
+
+/**
+ * Cluster::zone
+ */
+NXSL_ATTRIBUTE_DEFINITION(Cluster, zone)
+{
+   auto cluster = SharedObjectFromData<Cluster>(object);
+   NXSL_Value *value = nullptr;
+   if (g_flags & AF_ENABLE_ZONING)
+   {
+      shared_ptr<Zone> zone = FindZoneByUIN(cluster->getZoneUIN());
+      if (zone != nullptr)
+      {
+         value = zone->createNXSLObject(vm);
+      }
+      else
+      {
+         value = vm->createValue();
+      }
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * Cluster::zoneUIN
+ */
+NXSL_ATTRIBUTE_DEFINITION(Cluster, zoneUIN)
+{
+   auto cluster = SharedObjectFromData<Cluster>(object);
+   return vm->createValue(cluster->getZoneUIN());
+}
+
+/**
+ * NXSL class "Cluster" constructor
+ */
+NXSL_ClusterClass::NXSL_ClusterClass() : NXSL_DCTargetClass()
+{
+   setName(_T("Cluster"));
+
+   NXSL_REGISTER_METHOD(Cluster, getResourceOwner, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(Cluster, nodes);
+   NXSL_REGISTER_ATTRIBUTE(Cluster, zone);
+   NXSL_REGISTER_ATTRIBUTE(Cluster, zoneUIN);
+}
+
+/**
+ * Container::setAutoBindMode() method
+ */
+NXSL_METHOD_DEFINITION(Container, setAutoBindMode)
+{
+   if (!argv[0]->isInteger() || !argv[1]->isInteger())
+      return NXSL_ERR_NOT_INTEGER;
+
+   static_cast<shared_ptr<Container>*>(object->getData())->get()->setAutoBindMode(argv[0]->getValueAsBoolean(), argv[1]->getValueAsBoolean());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Container::setAutoBindScript() method
+ */
+NXSL_METHOD_DEFINITION(Container, setAutoBindScript)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   static_cast<shared_ptr<Container>*>(object->getData())->get()->setAutoBindFilter(argv[0]->getValueAsCString());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Container::autoBindScript
+ */
+NXSL_ATTRIBUTE_DEFINITION(Container, autoBindScript)
+{
+   auto container = SharedObjectFromData<Container>(object);
+   const TCHAR *script = container->getAutoBindScriptSource();
+   return vm->createValue(CHECK_NULL_EX(script));
+}
+
+/**
+ * Container::isAutoBindEnabled
+ */
+NXSL_ATTRIBUTE_DEFINITION(Container, isAutoBindEnabled)
+{
+   auto container = SharedObjectFromData<Container>(object);
+   return vm->createValue(container->isAutoBindEnabled() ? 1 : 0);
+}
+
+/**
+ * Container::isAutoUnbindEnabled
+ */
+NXSL_ATTRIBUTE_DEFINITION(Container, isAutoUnbindEnabled)
+{
+   auto container = SharedObjectFromData<Container>(object);
+   return vm->createValue(container->isAutoUnbindEnabled() ? 1 : 0);
+}
+
+/**
+ * NXSL class "Container" constructor
+ */
+NXSL_ContainerClass::NXSL_ContainerClass() : NXSL_NetObjClass()
+{
+   setName(_T("Container"));
+
+   NXSL_REGISTER_METHOD(Container, setAutoBindMode, 2);
+   NXSL_REGISTER_METHOD(Container, setAutoBindScript, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(Container, autoBindScript);
+   NXSL_REGISTER_ATTRIBUTE(Container, isAutoBindEnabled);
+   NXSL_REGISTER_ATTRIBUTE(Container, isAutoUnbindEnabled);
+}
+
+/**
+ * Template::applyTo(object)
+ */
+NXSL_METHOD_DEFINITION(Template, applyTo)
+{
+   shared_ptr<Template> thisObject = *static_cast<shared_ptr<Template>*>(object->getData());
+
+   if (!argv[0]->isObject())
+      return NXSL_ERR_NOT_OBJECT;
+
+   NXSL_Object *nxslTarget = argv[0]->getValueAsObject();
+   if (!nxslTarget->getClass()->instanceOf(_T("DataCollectionTarget")))
+      return NXSL_ERR_BAD_CLASS;
+
+   thisObject->applyToTarget(*static_cast<shared_ptr<DataCollectionTarget>*>(nxslTarget->getData()));
+
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Template::removeFrom(object)
+ */
+NXSL_METHOD_DEFINITION(Template, removeFrom)
+{
+   shared_ptr<Template> thisObject = *static_cast<shared_ptr<Template>*>(object->getData());
+
+   if (!argv[0]->isObject())
+      return NXSL_ERR_NOT_OBJECT;
+
+   NXSL_Object *nxslTarget = argv[0]->getValueAsObject();
+   if (!nxslTarget->getClass()->instanceOf(_T("DataCollectionTarget")))
+      return NXSL_ERR_BAD_CLASS;
+
+   auto target = *static_cast<shared_ptr<DataCollectionTarget>*>(nxslTarget->getData());
+   thisObject->deleteChild(*target);
+   target->deleteParent(*thisObject);
+   thisObject->queueRemoveFromTarget(target->getId(), true);
+
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Template::setAutoApplyMode() method
+ */
+NXSL_METHOD_DEFINITION(Template, setAutoApplyMode)
+{
+   if (!argv[0]->isInteger() || !argv[1]->isInteger())
+      return NXSL_ERR_NOT_INTEGER;
+
+   static_cast<shared_ptr<Template>*>(object->getData())->get()->setAutoBindMode(argv[0]->getValueAsBoolean(), argv[1]->getValueAsBoolean());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Template::setAutoApplyScript() method
+ */
+NXSL_METHOD_DEFINITION(Template, setAutoApplyScript)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   static_cast<shared_ptr<Template>*>(object->getData())->get()->setAutoBindFilter(argv[0]->getValueAsCString());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Template::autoApplyScript
+ */
+NXSL_ATTRIBUTE_DEFINITION(Template, autoApplyScript)
+{
+   auto tmpl = SharedObjectFromData<Template>(object);
+   const TCHAR *script = tmpl->getAutoBindScriptSource();
+   return vm->createValue(CHECK_NULL_EX(script));
+}
+
+/**
+ * Template::isAutoApplyEnabled
+ */
+NXSL_ATTRIBUTE_DEFINITION(Template, isAutoApplyEnabled)
+{
+   auto tmpl = SharedObjectFromData<Template>(object);
+   return vm->createValue(tmpl->isAutoBindEnabled() ? 1 : 0);
+}
+
+/**
+ * Template::isAutoRemoveEnabled
+ */
+NXSL_ATTRIBUTE_DEFINITION(Template, isAutoRemoveEnabled)
+{
+   auto tmpl = SharedObjectFromData<Template>(object);
+   return vm->createValue(tmpl->isAutoUnbindEnabled() ? 1 : 0);
+}
+
+/**
+ * Template::version
+ */
+NXSL_ATTRIBUTE_DEFINITION(Template, version)
+{
+   auto tmpl = SharedObjectFromData<Template>(object);
+   return vm->createValue(tmpl->getVersion());
+}
+
+/**
+ * NXSL class "Template" constructor
+ */
+NXSL_TemplateClass::NXSL_TemplateClass() : NXSL_NetObjClass()
+{
+   setName(_T("Template"));
+
+   NXSL_REGISTER_METHOD(Template, applyTo, 1);
+   NXSL_REGISTER_METHOD(Template, removeFrom, 1);
+   NXSL_REGISTER_METHOD(Template, setAutoApplyMode, 2);
+   NXSL_REGISTER_METHOD(Template, setAutoApplyScript, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(Template, autoApplyScript);
+   NXSL_REGISTER_ATTRIBUTE(Template, isAutoApplyEnabled);
+   NXSL_REGISTER_ATTRIBUTE(Template, isAutoRemoveEnabled);
+   NXSL_REGISTER_ATTRIBUTE(Template, version);
+}
+
+/**
+ * Tunnel::address
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, address)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(NXSL_InetAddressClass::createObject(vm, tunnel->getAddress()));
+}
+
+/**
+ * Tunnel::agentBuildTag
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, agentBuildTag)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getAgentBuildTag());
+}
+
+/**
+ * Tunnel::agentId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, agentId)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getAgentId().toString());
+}
+
+/**
+ * Tunnel::agentVersion
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, agentVersion)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getAgentVersion());
+}
+
+/**
+ * Tunnel::certificateExpirationTime
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, certificateExpirationTime)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(static_cast<int64_t>(tunnel->getCertificateExpirationTime()));
+}
+
+/**
+ * Tunnel::guid
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, guid)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getGUID().toString());
+}
+
+/**
+ * Tunnel::hostname
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, hostname)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getHostname());
+}
+
+/**
+ * Tunnel::hardwareId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, hardwareId)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getHostname());
+}
+
+/**
+ * Tunnel::id
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, id)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getId());
+}
+
+/**
+ * Tunnel::isAgentProxy
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, isAgentProxy)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->isAgentProxy());
+}
+
+/**
+ * Tunnel::isBound
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, isBound)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->isBound());
+}
+
+/**
+ * Tunnel::isSnmpProxy
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, isSnmpProxy)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->isSnmpProxy());
+}
+
+/**
+ * Tunnel::isSnmpTrapProxy
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, isSnmpTrapProxy)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->isSnmpTrapProxy());
+}
+
+/**
+ * Tunnel::isUserAgentInstalled
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, isUserAgentInstalled)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->isUserAgentInstalled());
+}
+
+/**
+ * Tunnel::platformName
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, platformName)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getPlatformName());
+}
+
+/**
+ * Tunnel::startTime
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, startTime)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(static_cast<int64_t>(tunnel->getStartTime()));
+}
+
+/**
+ * Tunnel::systemInfo
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, systemInfo)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getSystemInfo());
+}
+
+/**
+ * Tunnel::systemName
+ */
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, systemName)
+{
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getSystemName());
+}
+
+/**
+ * Tunnel::zoneUIN
  */
-NXSL_METHOD_DEFINITION(Interface, setExcludeFromTopology)
+NXSL_ATTRIBUTE_DEFINITION(Tunnel, zoneUIN)
 {
-   if (!argv[0]->isInteger())
-      return NXSL_ERR_NOT_INTEGER;
+   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
+   return vm->createValue(tunnel->getZoneUIN());
+}
 
-   Interface *iface = static_cast<shared_ptr<Interface>*>(object->getData())->get();
-   iface->setExcludeFromTopology(argv[0]->getValueAsBoolean());
+/**
+ * NXSL class Alarm: constructor
+ */
+NXSL_TunnelClass::NXSL_TunnelClass() : NXSL_Class()
+{
+   setName(_T("Tunnel"));
+
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, address);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, agentBuildTag);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, agentId);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, agentVersion);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, certificateExpirationTime);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, guid);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, hostname);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, hardwareId);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, id);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, isAgentProxy);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, isBound);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, isSnmpProxy);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, isSnmpTrapProxy);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, isUserAgentInstalled);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, platformName);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, startTime);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, systemInfo);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, systemName);
+   NXSL_REGISTER_ATTRIBUTE(Tunnel, zoneUIN);
+}
+
+/**
+ * NXSL object creation handler
+ */
+void NXSL_TunnelClass::onObjectCreate(NXSL_Object *object)
+{
+   static_cast<AgentTunnel*>(object->getData())->incRefCount();
+}
+
+/**
+ * NXSL object destructor
+ */
+void NXSL_TunnelClass::onObjectDelete(NXSL_Object *object)
+{
+   static_cast<AgentTunnel*>(object->getData())->decRefCount();
+}
+
+/**
+ * Event::setMessage() method
+ */
+NXSL_METHOD_DEFINITION(Event, setMessage)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   Event *event = static_cast<Event*>(object->getData());
+   event->setMessage(argv[0]->getValueAsCString());
    *result = vm->createValue();
    return 0;
 }
 
 /**
- * Interface::setExpectedState(state) method
+ * Event::setSeverity() method
  */
-NXSL_METHOD_DEFINITION(Interface, setExpectedState)
+NXSL_METHOD_DEFINITION(Event, setSeverity)
 {
-   int state;
-   if (argv[0]->isInteger())
-   {
-      state = argv[0]->getValueAsInt32();
-   }
-   else if (argv[0]->isString())
+   if (!argv[0]->isInteger())
+      return NXSL_ERR_NOT_STRING;
+
+   int s = argv[0]->getValueAsInt32();
+   if ((s >= SEVERITY_NORMAL) && (s <= SEVERITY_CRITICAL))
    {
-      static const TCHAR *stateNames[] = { _T("UP"), _T("DOWN"), _T("IGNORE"), nullptr };
-      const TCHAR *name = argv[0]->getValueAsCString();
-      for(state = 0; stateNames[state] != nullptr; state++)
-         if (!_tcsicmp(stateNames[state], name))
-            break;
+      Event *event = static_cast<Event*>(object->getData());
+      event->setSeverity(s);
    }
-   else
-   {
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Event::addParameter() method
+ */
+NXSL_METHOD_DEFINITION(Event, addParameter)
+{
+   if ((argc < 1) || (argc > 2))
+      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
+
+   if (!argv[0]->isString() || ((argc == 2) && !argv[1]->isString()))
       return NXSL_ERR_NOT_STRING;
-   }
 
-   if ((state >= 0) && (state <= 2))
-      static_cast<shared_ptr<Interface>*>(object->getData())->get()->setExpectedState(state);
+   Event *event = static_cast<Event*>(object->getData());
+   if (argc == 1)
+      event->addParameter(_T(""), argv[0]->getValueAsCString());
+   else
+      event->addParameter(argv[0]->getValueAsCString(), argv[1]->getValueAsCString());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Event::addTag() method
+ */
+NXSL_METHOD_DEFINITION(Event, addTag)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
 
+   Event *event = static_cast<Event*>(object->getData());
+   event->addTag(argv[0]->getValueAsCString());
    *result = vm->createValue();
    return 0;
 }
 
 /**
- * Interface::setIncludeInIcmpPoll(enabled) method
+ * Event::correlateTo() method
  */
-NXSL_METHOD_DEFINITION(Interface, setIncludeInIcmpPoll)
+NXSL_METHOD_DEFINITION(Event, correlateTo)
 {
    if (!argv[0]->isInteger())
       return NXSL_ERR_NOT_INTEGER;
 
-   Interface *iface = static_cast<shared_ptr<Interface>*>(object->getData())->get();
-   iface->setIncludeInIcmpPoll(argv[0]->getValueAsBoolean());
+   Event *event = static_cast<Event*>(object->getData());
+   event->setRootId(argv[0]->getValueAsUInt64());
    *result = vm->createValue();
    return 0;
 }
 
 /**
- * NXSL class Interface: constructor
+ * Event::expandString() method
  */
-NXSL_InterfaceClass::NXSL_InterfaceClass() : NXSL_NetObjClass()
+NXSL_METHOD_DEFINITION(Event, expandString)
 {
-   setName(_T("Interface"));
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
 
-   NXSL_REGISTER_METHOD(Interface, setExcludeFromTopology, 1);
-   NXSL_REGISTER_METHOD(Interface, setExpectedState, 1);
-   NXSL_REGISTER_METHOD(Interface, setIncludeInIcmpPoll, 1);
+   Event *event = static_cast<Event*>(object->getData());
+   *result = vm->createValue(event->expandText(argv[0]->getValueAsCString()));
+   return 0;
 }
 
 /**
- * NXSL class Interface: get attribute
+ * Event::hasTag() method
  */
-NXSL_Value *NXSL_InterfaceClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_METHOD_DEFINITION(Event, hasTag)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
 
-   NXSL_VM *vm = object->vm();
-   auto iface = SharedObjectFromData<Interface>(object);
-   if (compareAttributeName(attr, "adminState"))
-   {
-		value = vm->createValue((LONG)iface->getAdminState());
-   }
-   else if (compareAttributeName(attr, "bridgePortNumber"))
-   {
-		value = vm->createValue(iface->getBridgePortNumber());
-   }
-   else if (compareAttributeName(attr, "chassis"))
-   {
-      value = vm->createValue(iface->getChassis());
-   }
-   else if (compareAttributeName(attr, "description"))
-   {
-      value = vm->createValue(iface->getDescription());
-   }
-   else if (compareAttributeName(attr, "dot1xBackendAuthState"))
-   {
-		value = vm->createValue((LONG)iface->getDot1xBackendAuthState());
-   }
-   else if (compareAttributeName(attr, "dot1xPaeAuthState"))
-   {
-		value = vm->createValue((LONG)iface->getDot1xPaeAuthState());
-   }
-   else if (compareAttributeName(attr, "expectedState"))
-   {
-		value = vm->createValue((iface->getFlags() & IF_EXPECTED_STATE_MASK) >> 28);
-   }
-   else if (compareAttributeName(attr, "flags"))
-   {
-		value = vm->createValue(iface->getFlags());
-   }
-   else if (compareAttributeName(attr, "icmpAverageRTT"))
-   {
-      value = GetObjectIcmpStatistic(iface, IcmpStatFunction::AVERAGE, vm);
-   }
-   else if (compareAttributeName(attr, "icmpLastRTT"))
-   {
-      value = GetObjectIcmpStatistic(iface, IcmpStatFunction::LAST, vm);
-   }
-   else if (compareAttributeName(attr, "icmpMaxRTT"))
-   {
-      value = GetObjectIcmpStatistic(iface, IcmpStatFunction::MAX, vm);
-   }
-   else if (compareAttributeName(attr, "icmpMinRTT"))
-   {
-      value = GetObjectIcmpStatistic(iface, IcmpStatFunction::MIN, vm);
-   }
-   else if (compareAttributeName(attr, "icmpPacketLoss"))
-   {
-      value = GetObjectIcmpStatistic(iface, IcmpStatFunction::LOSS, vm);
-   }
-   else if (compareAttributeName(attr, "ifIndex"))
-   {
-		value = vm->createValue(iface->getIfIndex());
-   }
-   else if (compareAttributeName(attr, "ifType"))
-   {
-		value = vm->createValue(iface->getIfType());
-   }
-   else if (compareAttributeName(attr, "ipAddressList"))
+   Event *event = static_cast<Event*>(object->getData());
+   *result = vm->createValue(event->hasTag(argv[0]->getValueAsCString()));
+   return 0;
+}
+
+/**
+ * Event::removeTag() method
+ */
+NXSL_METHOD_DEFINITION(Event, removeTag)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   Event *event = static_cast<Event*>(object->getData());
+   event->removeTag(argv[0]->getValueAsCString());
+   *result = vm->createValue();
+   return 0;
+}
+
+/**
+ * Event::toJson() method
+ */
+NXSL_METHOD_DEFINITION(Event, toJson)
+{
+   Event *event = static_cast<Event*>(object->getData());
+   json_t *json = event->toJson();
+   char *text = json_dumps(json, JSON_INDENT(3) | JSON_EMBED);
+   *result = vm->createValue(text);
+   MemFree(text);
+   json_decref(json);
+   return 0;
+}
+
+/**
+ * Event::code
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, code)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getCode());
+}
+
+/**
+ * Event::customMessage
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, customMessage)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getCustomMessage());
+}
+
+/**
+ * Event::dci
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, dci)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   NXSL_Value *value = nullptr;
+   UINT32 dciId = event->getDciId();
+   if (dciId != 0)
    {
-      const InetAddressList *addrList = iface->getIpAddressList();
-      NXSL_Array *a = new NXSL_Array(vm);
-      for(int i = 0; i < addrList->size(); i++)
+      shared_ptr<NetObj> object = FindObjectById(event->getSourceId());
+      if ((object != nullptr) && object->isDataCollectionTarget())
+      {
+         shared_ptr<DCObject> dci = static_cast<DataCollectionTarget*>(object.get())->getDCObjectById(dciId, 0, true);
+         if (dci != nullptr)
+         {
+            value = dci->createNXSLObject(vm);
+         }
+         else
+         {
+            value = vm->createValue();
+         }
+      }
+      else
       {
-         a->append(NXSL_InetAddressClass::createObject(vm, addrList->get(i)));
+         value = vm->createValue();
       }
-      value = vm->createValue(a);
    }
-   else if (compareAttributeName(attr, "isExcludedFromTopology"))
-   {
-      value = vm->createValue((LONG)(iface->isExcludedFromTopology() ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isIncludedInIcmpPoll"))
-   {
-      value = vm->createValue((LONG)(iface->isIncludedInIcmpPoll() ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isLoopback"))
-   {
-		value = vm->createValue((LONG)(iface->isLoopback() ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isManuallyCreated"))
-   {
-		value = vm->createValue((LONG)(iface->isManuallyCreated() ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "isPhysicalPort"))
-   {
-		value = vm->createValue((LONG)(iface->isPhysicalPort() ? 1 : 0));
-   }
-   else if (compareAttributeName(attr, "macAddr"))
-   {
-		TCHAR buffer[256];
-		value = vm->createValue(iface->getMacAddr().toString(buffer));
-   }
-   else if (compareAttributeName(attr, "module"))
-   {
-      value = vm->createValue(iface->getModule());
-   }
-   else if (compareAttributeName(attr, "mtu"))
-   {
-      value = vm->createValue(iface->getMTU());
-   }
-   else if (compareAttributeName(attr, "node"))
-	{
-      shared_ptr<Node> parentNode = iface->getParentNode();
-		if (parentNode != nullptr)
-		{
-         value = parentNode->createNXSLObject(vm);
-		}
-		else
-		{
-			value = vm->createValue();
-		}
-	}
-   else if (compareAttributeName(attr, "operState"))
-   {
-		value = vm->createValue((LONG)iface->getOperState());
-   }
-   else if (compareAttributeName(attr, "peerInterface"))
-   {
-      shared_ptr<NetObj> peerIface = FindObjectById(iface->getPeerInterfaceId(), OBJECT_INTERFACE);
-		if (peerIface != nullptr)
-		{
-			if (g_flags & AF_CHECK_TRUSTED_NODES)
-			{
-			   shared_ptr<Node> parentNode = iface->getParentNode();
-				shared_ptr<Node> peerNode = static_cast<Interface*>(peerIface.get())->getParentNode();
-				if ((parentNode != nullptr) && (peerNode != nullptr))
-				{
-					if (peerNode->isTrustedNode(parentNode->getId()))
-					{
-						value = peerIface->createNXSLObject(vm);
-					}
-					else
-					{
-						// No access, return null
-						value = vm->createValue();
-						DbgPrintf(4, _T("NXSL::Interface::peerInterface(%s [%d]): access denied for node %s [%d]"),
-									 iface->getName(), iface->getId(), peerNode->getName(), peerNode->getId());
-					}
-				}
-				else
-				{
-					value = vm->createValue();
-					DbgPrintf(4, _T("NXSL::Interface::peerInterface(%s [%d]): parentNode=% [%u] peerNode=%s [%u]"),
-                     iface->getName(), iface->getId(), parentNode->getName(), parentNode->getId(), peerNode->getName(), peerNode->getId());
-				}
-			}
-			else
-			{
-				value = peerIface->createNXSLObject(vm);
-			}
-		}
-		else
-		{
-			value = vm->createValue();
-		}
-   }
-   else if (compareAttributeName(attr, "peerNode"))
-   {
-      shared_ptr<NetObj> peerNode = FindObjectById(iface->getPeerNodeId(), OBJECT_NODE);
-		if (peerNode != nullptr)
-		{
-			if (g_flags & AF_CHECK_TRUSTED_NODES)
-			{
-			   shared_ptr<Node> parentNode = iface->getParentNode();
-				if ((parentNode != nullptr) && (peerNode->isTrustedNode(parentNode->getId())))
-				{
-					value = peerNode->createNXSLObject(vm);
-				}
-				else
-				{
-					// No access, return null
-					value = vm->createValue();
-					DbgPrintf(4, _T("NXSL::Interface::peerNode(%s [%d]): access denied for node %s [%d]"),
-					          iface->getName(), iface->getId(), peerNode->getName(), peerNode->getId());
-				}
-			}
-			else
-			{
-				value = peerNode->createNXSLObject(vm);
-			}
-		}
-		else
-		{
-			value = vm->createValue();
-		}
-   }
-   else if (compareAttributeName(attr, "pic"))
-   {
-      value = vm->createValue(iface->getPIC());
-   }
-   else if (compareAttributeName(attr, "port"))
-   {
-      value = vm->createValue(iface->getPort());
-   }
-   else if (compareAttributeName(attr, "speed"))
-   {
-      value = vm->createValue(iface->getSpeed());
-   }
-   else if (compareAttributeName(attr, "vlans"))
-   {
-      value = iface->getVlanListForNXSL(vm);
-   }
-   else if (compareAttributeName(attr, "zone"))
-	{
-      if (g_flags & AF_ENABLE_ZONING)
-      {
-         shared_ptr<Zone> zone = FindZoneByUIN(iface->getZoneUIN());
-		   if (zone != nullptr)
-		   {
-			   value = zone->createNXSLObject(vm);
-		   }
-		   else
-		   {
-			   value = vm->createValue();
-		   }
-	   }
-	   else
-	   {
-		   value = vm->createValue();
-	   }
-	}
-   else if (compareAttributeName(attr, "zoneUIN"))
-	{
-      value = vm->createValue(iface->getZoneUIN());
+   else
+   {
+      value = vm->createValue();
    }
    return value;
 }
 
 /**
- * NXSL class AccessPoint: constructor
+ * Event::dciId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, dciId)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getDciId());
+}
+
+/**
+ * Event::id
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, id)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getId());
+}
+
+/**
+ * Event::message
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, message)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getMessage());
+}
+
+/**
+ * Event::name
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, name)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getName());
+}
+
+/**
+ * Event::origin
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, origin)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(static_cast<INT32>(event->getOrigin()));
+}
+
+/**
+ * Event::originTimestamp
  */
-NXSL_AccessPointClass::NXSL_AccessPointClass() : NXSL_DCTargetClass()
+NXSL_ATTRIBUTE_DEFINITION(Event, originTimestamp)
 {
-   setName(_T("AccessPoint"));
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(static_cast<INT64>(event->getOriginTimestamp()));
 }
 
 /**
- * NXSL class AccessPoint: get attribute
+ * Event::parameters
  */
-NXSL_Value *NXSL_AccessPointClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Event, parameters)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   auto ap = SharedObjectFromData<AccessPoint>(object);
-   if (compareAttributeName(attr, "icmpAverageRTT"))
-   {
-      value = GetObjectIcmpStatistic(ap, IcmpStatFunction::AVERAGE, vm);
-   }
-   else if (compareAttributeName(attr, "icmpLastRTT"))
-   {
-      value = GetObjectIcmpStatistic(ap, IcmpStatFunction::LAST, vm);
-   }
-   else if (compareAttributeName(attr, "icmpMaxRTT"))
-   {
-      value = GetObjectIcmpStatistic(ap, IcmpStatFunction::MAX, vm);
-   }
-   else if (compareAttributeName(attr, "icmpMinRTT"))
-   {
-      value = GetObjectIcmpStatistic(ap, IcmpStatFunction::MIN, vm);
-   }
-   else if (compareAttributeName(attr, "icmpPacketLoss"))
-   {
-      value = GetObjectIcmpStatistic(ap, IcmpStatFunction::LOSS, vm);
-   }
-   else if (compareAttributeName(attr, "index"))
-   {
-      value = vm->createValue(ap->getIndex());
-   }
-   else if (compareAttributeName(attr, "model"))
-   {
-      value = vm->createValue(ap->getModel());
-   }
-   else if (compareAttributeName(attr, "node"))
-   {
-      shared_ptr<Node> parentNode = ap->getParentNode();
-      if (parentNode != nullptr)
-      {
-         value = parentNode->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "serialNumber"))
-   {
-      value = vm->createValue(ap->getSerialNumber());
-   }
-   else if (compareAttributeName(attr, "state"))
-   {
-      value = vm->createValue(ap->getApState());
-   }
-   else if (compareAttributeName(attr, "vendor"))
-   {
-      value = vm->createValue(ap->getVendor());
-   }
-   return value;
+   const Event *event = static_cast<Event*>(object->getData());
+   NXSL_Array *array = new NXSL_Array(vm);
+   for(int i = 0; i < event->getParametersCount(); i++)
+      array->set(i + 1, vm->createValue(event->getParameter(i)));
+   return vm->createValue(array);
 }
 
 /**
- * NXSL class Mobile Device: constructor
+ * Event::parameterNames
  */
-NXSL_MobileDeviceClass::NXSL_MobileDeviceClass() : NXSL_DCTargetClass()
+NXSL_ATTRIBUTE_DEFINITION(Event, parameterNames)
 {
-   setName(_T("MobileDevice"));
+   const Event *event = static_cast<Event*>(object->getData());
+   NXSL_Array *array = new NXSL_Array(vm);
+   for(int i = 0; i < event->getParametersCount(); i++)
+      array->set(i + 1, vm->createValue(event->getParameterName(i)));
+   return vm->createValue(array);
 }
 
 /**
- * NXSL class Mobile Device: get attribute
+ * Event::rootId
  */
-NXSL_Value *NXSL_MobileDeviceClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Event, rootId)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getRootId());
+}
 
-   NXSL_VM *vm = object->vm();
-   auto mobDevice = SharedObjectFromData<MobileDevice>(object);
-   if (compareAttributeName(attr, "deviceId"))
-   {
-		value = vm->createValue(mobDevice->getDeviceId());
-   }
-   else if (compareAttributeName(attr, "vendor"))
-   {
-      value = vm->createValue(mobDevice->getVendor());
-   }
-   else if (compareAttributeName(attr, "model"))
-   {
-      value = vm->createValue(mobDevice->getModel());
-   }
-   else if (compareAttributeName(attr, "serialNumber"))
-   {
-      value = vm->createValue(mobDevice->getSerialNumber());
-   }
-   else if (compareAttributeName(attr, "osName"))
-   {
-      value = vm->createValue(mobDevice->getOsName());
-   }
-   else if (compareAttributeName(attr, "osVersion"))
-   {
-      value = vm->createValue(mobDevice->getOsVersion());
-   }
-   else if (compareAttributeName(attr, "userId"))
-   {
-      value = vm->createValue(mobDevice->getUserId());
-   }
-   else if (compareAttributeName(attr, "batteryLevel"))
-   {
-      value = vm->createValue(mobDevice->getBatteryLevel());
-   }
+/**
+ * Event::severity
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, severity)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getSeverity());
+}
 
-   return value;
+/**
+ * Event::source
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, source)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   shared_ptr<NetObj> source = FindObjectById(event->getSourceId());
+   return (source != nullptr) ? source->createNXSLObject(vm) : vm->createValue();
 }
 
 /**
- * NXSL class "Chassis" constructor
+ * Event::sourceId
  */
-NXSL_ChassisClass::NXSL_ChassisClass() : NXSL_DCTargetClass()
+NXSL_ATTRIBUTE_DEFINITION(Event, sourceId)
 {
-   setName(_T("Chassis"));
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getSourceId());
 }
 
 /**
- * NXSL class "Chassis" attributes
+ * Event::tagList
  */
-NXSL_Value *NXSL_ChassisClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Event, tagList)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(event->getTagsAsList());
+}
 
-   NXSL_VM *vm = object->vm();
-   auto chassis = SharedObjectFromData<Chassis>(object);
-   if (compareAttributeName(attr, "controller"))
-   {
-      shared_ptr<NetObj> node = FindObjectById(chassis->getControllerId(), OBJECT_NODE);
-      if (node != nullptr)
-      {
-         value = node->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "controllerId"))
-   {
-      value = vm->createValue(chassis->getControllerId());
-   }
-   else if (compareAttributeName(attr, "flags"))
-   {
-      value = vm->createValue(chassis->getFlags());
-   }
-   else if (compareAttributeName(attr, "rack"))
-   {
-      shared_ptr<NetObj> rack = FindObjectById(chassis->getRackId(), OBJECT_RACK);
-      if (rack != nullptr)
-      {
-         value = rack->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "rackId"))
-   {
-      value = vm->createValue(chassis->getRackId());
-   }
-   else if (compareAttributeName(attr, "rackHeight"))
-   {
-      value = vm->createValue(chassis->getRackHeight());
-   }
-   else if (compareAttributeName(attr, "rackPosition"))
-   {
-      value = vm->createValue(chassis->getRackPosition());
-   }
+/**
+ * Event::tags
+ */
+NXSL_ATTRIBUTE_DEFINITION(Event, tags)
+{
+   const Event *event = static_cast<Event*>(object->getData());
+   NXSL_Value *value = nullptr;
+   StringList *tags = String(event->getTagsAsList()).split(_T(","));
+   value = vm->createValue(new NXSL_Array(vm, tags));
+   delete tags;
    return value;
 }
 
 /**
- * Cluster::getResourceOwner() method
+ * Event::timestamp
  */
-NXSL_METHOD_DEFINITION(Cluster, getResourceOwner)
+NXSL_ATTRIBUTE_DEFINITION(Event, timestamp)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   UINT32 ownerId = static_cast<shared_ptr<Cluster>*>(object->getData())->get()->getResourceOwner(argv[0]->getValueAsCString());
-   if (ownerId != 0)
-   {
-      shared_ptr<NetObj> object = FindObjectById(ownerId);
-      *result = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
-   }
-   else
-   {
-      *result = vm->createValue();
-   }
-   return 0;
+   const Event *event = static_cast<Event*>(object->getData());
+   return vm->createValue(static_cast<INT64>(event->getTimestamp()));
 }
 
 /**
- * NXSL class "Cluster" constructor
+ * NXSL class Event: constructor
  */
-NXSL_ClusterClass::NXSL_ClusterClass() : NXSL_DCTargetClass()
+NXSL_EventClass::NXSL_EventClass() : NXSL_Class()
 {
-   setName(_T("Cluster"));
+   setName(_T("Event"));
 
-   NXSL_REGISTER_METHOD(Cluster, getResourceOwner, 1);
+   NXSL_REGISTER_METHOD(Event, addParameter, -1);
+   NXSL_REGISTER_METHOD(Event, addTag, 1);
+   NXSL_REGISTER_METHOD(Event, correlateTo, 1);
+   NXSL_REGISTER_METHOD(Event, expandString, 1);
+   NXSL_REGISTER_METHOD(Event, hasTag, 1);
+   NXSL_REGISTER_METHOD(Event, removeTag, 1);
+   NXSL_REGISTER_METHOD(Event, setMessage, 1);
+   NXSL_REGISTER_METHOD(Event, setSeverity, 1);
+   NXSL_REGISTER_METHOD(Event, toJson, 0);
+
+   NXSL_REGISTER_ATTRIBUTE(Event, code);
+   NXSL_REGISTER_ATTRIBUTE(Event, customMessage);
+   NXSL_REGISTER_ATTRIBUTE(Event, dci);
+   NXSL_REGISTER_ATTRIBUTE(Event, dciId);
+   NXSL_REGISTER_ATTRIBUTE(Event, id);
+   NXSL_REGISTER_ATTRIBUTE(Event, message);
+   NXSL_REGISTER_ATTRIBUTE(Event, name);
+   NXSL_REGISTER_ATTRIBUTE(Event, origin);
+   NXSL_REGISTER_ATTRIBUTE(Event, originTimestamp);
+   NXSL_REGISTER_ATTRIBUTE(Event, parameters);
+   NXSL_REGISTER_ATTRIBUTE(Event, parameterNames);
+   NXSL_REGISTER_ATTRIBUTE(Event, rootId);
+   NXSL_REGISTER_ATTRIBUTE(Event, severity);
+   NXSL_REGISTER_ATTRIBUTE(Event, source);
+   NXSL_REGISTER_ATTRIBUTE(Event, sourceId);
+   NXSL_REGISTER_ATTRIBUTE(Event, tagList);
+   NXSL_REGISTER_ATTRIBUTE(Event, tags);
+   NXSL_REGISTER_ATTRIBUTE(Event, timestamp);
+}
+
+/**
+ * Destructor
+ */
+void NXSL_EventClass::onObjectDelete(NXSL_Object *object)
+{
+   delete static_cast<Event*>(object->getData());
 }
 
 /**
- * NXSL class "Cluster" attributes
+ * NXSL class Event: get attribute
  */
-NXSL_Value *NXSL_ClusterClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_Value *NXSL_EventClass::getAttr(NXSL_Object *object, const char *attr)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
+   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
    if (value != nullptr)
       return value;
 
    NXSL_VM *vm = object->vm();
-   auto cluster = SharedObjectFromData<Cluster>(object);
-   if (compareAttributeName(attr, "nodes"))
-   {
-      value = vm->createValue(cluster->getNodesForNXSL(vm));
-   }
-   else if (compareAttributeName(attr, "zone"))
+   const Event *event = static_cast<Event*>(object->getData());
+   if (event != nullptr)    // Event can be null if getAttr called by attribute scan
    {
-      if (g_flags & AF_ENABLE_ZONING)
+      if (attr[0] == _T('$'))
       {
-         shared_ptr<Zone> zone = FindZoneByUIN(cluster->getZoneUIN());
-         if (zone != nullptr)
+         // Try to find parameter with given index
+         char *eptr;
+         int index = strtol(&attr[1], &eptr, 10);
+         if ((index > 0) && (*eptr == 0))
          {
-            value = zone->createNXSLObject(vm);
+            const TCHAR *s = event->getParameter(index - 1);
+            if (s != nullptr)
+            {
+               value = vm->createValue(s);
+            }
          }
-         else
+      }
+
+      // Try to find named parameter with given name
+      if (value == nullptr)
+      {
+#ifdef UNICODE
+         WCHAR wattr[MAX_IDENTIFIER_LENGTH];
+         MultiByteToWideChar(CP_UTF8, 0, attr, -1, wattr, MAX_IDENTIFIER_LENGTH);
+         wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
+         const TCHAR *s = event->getNamedParameter(wattr);
+#else
+         const TCHAR *s = event->getNamedParameter(attr);
+#endif
+         if (s != nullptr)
          {
-            value = vm->createValue();
+            value = vm->createValue(s);
          }
       }
+   }
+   return value;
+}
+
+/**
+ * NXSL class Event: set attribute
+ */
+bool NXSL_EventClass::setAttr(NXSL_Object *object, const char *attr, NXSL_Value *value)
+{
+   Event *event = static_cast<Event*>(object->getData());
+   if (!strcmp(attr, "customMessage"))
+   {
+      if (value->isString())
+      {
+         event->setCustomMessage(value->getValueAsCString());
+      }
       else
       {
-         value = vm->createValue();
+         event->setCustomMessage(nullptr);
       }
    }
-   else if (compareAttributeName(attr, "zoneUIN"))
+   else if (!strcmp(attr, "message"))
    {
-      value = vm->createValue(cluster->getZoneUIN());
+      if (value->isString())
+      {
+         event->setMessage(value->getValueAsCString());
+      }
    }
-   return value;
+   else if (!strcmp(attr, "severity"))
+   {
+      int s = value->getValueAsInt32();
+      if ((s >= SEVERITY_NORMAL) && (s <= SEVERITY_CRITICAL))
+      {
+         event->setSeverity(s);
+      }
+   }
+   else
+   {
+      bool success = false;
+      if (attr[0] == _T('$'))
+      {
+         // Try to find parameter with given index
+         char *eptr;
+         int index = strtol(&attr[1], &eptr, 10);
+         if ((index > 0) && (*eptr == 0))
+         {
+            const TCHAR *name = event->getParameterName(index - 1);
+            event->setParameter(index - 1, CHECK_NULL_EX(name), value->getValueAsCString());
+            success = true;
+         }
+      }
+      if (!success)
+      {
+#ifdef UNICODE
+         WCHAR wattr[MAX_IDENTIFIER_LENGTH];
+         MultiByteToWideChar(CP_UTF8, 0, attr, -1, wattr, MAX_IDENTIFIER_LENGTH);
+         wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
+         event->setNamedParameter(wattr, value->getValueAsCString());
+#else
+         event->setNamedParameter(attr, value->getValueAsCString());
+#endif
+      }
+   }
+   return true;
 }
 
 /**
- * Container::setAutoBindMode() method
+ * Alarm::acknowledge() method
  */
-NXSL_METHOD_DEFINITION(Container, setAutoBindMode)
+NXSL_METHOD_DEFINITION(Alarm, acknowledge)
 {
-   if (!argv[0]->isInteger() || !argv[1]->isInteger())
-      return NXSL_ERR_NOT_INTEGER;
+   if (argc > 1)
+      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
 
-   static_cast<shared_ptr<Container>*>(object->getData())->get()->setAutoBindMode(argv[0]->getValueAsBoolean(), argv[1]->getValueAsBoolean());
-   *result = vm->createValue();
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   *result = vm->createValue(AckAlarmById(alarm->getAlarmId(), nullptr, false, 0, (argc == 1) ? argv[0]->getValueAsBoolean() : false));
    return 0;
 }
 
 /**
- * Container::setAutoBindScript() method
+ * Alarm::resolve() method
  */
-NXSL_METHOD_DEFINITION(Container, setAutoBindScript)
+NXSL_METHOD_DEFINITION(Alarm, resolve)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
+   if (argc > 1)
+      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
 
-   static_cast<shared_ptr<Container>*>(object->getData())->get()->setAutoBindFilter(argv[0]->getValueAsCString());
-   *result = vm->createValue();
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   *result = vm->createValue(ResolveAlarmById(alarm->getAlarmId(), nullptr, false, (argc == 1) ? argv[0]->getValueAsBoolean() : false));
    return 0;
 }
 
 /**
- * NXSL class "Container" constructor
+ * Alarm::terminate() method
  */
-NXSL_ContainerClass::NXSL_ContainerClass() : NXSL_NetObjClass()
+NXSL_METHOD_DEFINITION(Alarm, terminate)
 {
-   setName(_T("Container"));
+   if (argc > 1)
+      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
 
-   NXSL_REGISTER_METHOD(Container, setAutoBindMode, 2);
-   NXSL_REGISTER_METHOD(Container, setAutoBindScript, 1);
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   *result = vm->createValue(ResolveAlarmById(alarm->getAlarmId(), nullptr, true, (argc == 1) ? argv[0]->getValueAsBoolean() : false));
+   return 0;
 }
 
 /**
- * NXSL class "Container" attributes
+ * Alarm::addComment() method
  */
-NXSL_Value *NXSL_ContainerClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_METHOD_DEFINITION(Alarm, addComment)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
 
-   NXSL_VM *vm = object->vm();
-   auto container = SharedObjectFromData<Container>(object);
-   if (compareAttributeName(attr, "autoBindScript"))
-   {
-      const TCHAR *script = container->getAutoBindScriptSource();
-      value = vm->createValue(CHECK_NULL_EX(script));
-   }
-   else if (compareAttributeName(attr, "isAutoBindEnabled"))
-   {
-      value = vm->createValue(container->isAutoBindEnabled() ? 1 : 0);
-   }
-   else if (compareAttributeName(attr, "isAutoUnbindEnabled"))
+   bool syncWithHelpdesk = true;
+   if (argc > 1)
    {
-      value = vm->createValue(container->isAutoUnbindEnabled() ? 1 : 0);
+      if(!argv[1]->isInteger())
+         return NXSL_ERR_NOT_INTEGER;
+      else
+         syncWithHelpdesk = argv[1]->getValueAsBoolean();
    }
-   return value;
+
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   UINT32 id = 0;
+   UINT32 rcc = UpdateAlarmComment(alarm->getAlarmId(), &id, argv[0]->getValueAsCString(), 0, syncWithHelpdesk);
+   if(rcc != RCC_SUCCESS)
+      return NXSL_ERR_INTERNAL;
+
+   *result = vm->createValue(id);
+   return 0;
 }
 
 /**
- * Template::applyTo(object)
+ * Alarm::getComments() method
  */
-NXSL_METHOD_DEFINITION(Template, applyTo)
+NXSL_METHOD_DEFINITION(Alarm, getComments)
 {
-   shared_ptr<Template> thisObject = *static_cast<shared_ptr<Template>*>(object->getData());
-
-   if (!argv[0]->isObject())
-      return NXSL_ERR_NOT_OBJECT;
-
-   NXSL_Object *nxslTarget = argv[0]->getValueAsObject();
-   if (!nxslTarget->getClass()->instanceOf(_T("DataCollectionTarget")))
-      return NXSL_ERR_BAD_CLASS;
-
-   thisObject->applyToTarget(*static_cast<shared_ptr<DataCollectionTarget>*>(nxslTarget->getData()));
-
-   *result = vm->createValue();
+   NXSL_Array *array = new NXSL_Array(vm);
+   ObjectArray<AlarmComment> *alarmComments = GetAlarmComments(((Alarm *)object->getData())->getAlarmId());
+   for(int i = 0; i < alarmComments->size(); i++)
+   {
+      array->append(vm->createValue(new NXSL_Object(vm, &g_nxslAlarmCommentClass, alarmComments->get(i))));
+   }
+   delete alarmComments;
+   *result = vm->createValue(array);
    return 0;
 }
 
 /**
- * Template::removeFrom(object)
+ * Alarm::ackBy
  */
-NXSL_METHOD_DEFINITION(Template, removeFrom)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, ackBy)
 {
-   shared_ptr<Template> thisObject = *static_cast<shared_ptr<Template>*>(object->getData());
-
-   if (!argv[0]->isObject())
-      return NXSL_ERR_NOT_OBJECT;
-
-   NXSL_Object *nxslTarget = argv[0]->getValueAsObject();
-   if (!nxslTarget->getClass()->instanceOf(_T("DataCollectionTarget")))
-      return NXSL_ERR_BAD_CLASS;
-
-   auto target = *static_cast<shared_ptr<DataCollectionTarget>*>(nxslTarget->getData());
-   thisObject->deleteChild(*target);
-   target->deleteParent(*thisObject);
-   thisObject->queueRemoveFromTarget(target->getId(), true);
-
-   *result = vm->createValue();
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getAckByUser());
 }
 
 /**
- * Template::setAutoApplyMode() method
+ * Alarm::creationTime
  */
-NXSL_METHOD_DEFINITION(Template, setAutoApplyMode)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, creationTime)
 {
-   if (!argv[0]->isInteger() || !argv[1]->isInteger())
-      return NXSL_ERR_NOT_INTEGER;
-
-   static_cast<shared_ptr<Template>*>(object->getData())->get()->setAutoBindMode(argv[0]->getValueAsBoolean(), argv[1]->getValueAsBoolean());
-   *result = vm->createValue();
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue((INT64)alarm->getCreationTime());
 }
 
 /**
- * Template::setAutoApplyScript() method
+ * Alarm::dciId
  */
-NXSL_METHOD_DEFINITION(Template, setAutoApplyScript)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, dciId)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   static_cast<shared_ptr<Template>*>(object->getData())->get()->setAutoBindFilter(argv[0]->getValueAsCString());
-   *result = vm->createValue();
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getDciId());
 }
 
 /**
- * NXSL class "Template" constructor
+ * Alarm::eventCode
  */
-NXSL_TemplateClass::NXSL_TemplateClass() : NXSL_NetObjClass()
+NXSL_ATTRIBUTE_DEFINITION(Alarm, eventCode)
 {
-   setName(_T("Template"));
-
-   NXSL_REGISTER_METHOD(Template, applyTo, 1);
-   NXSL_REGISTER_METHOD(Template, removeFrom, 1);
-   NXSL_REGISTER_METHOD(Template, setAutoApplyMode, 2);
-   NXSL_REGISTER_METHOD(Template, setAutoApplyScript, 1);
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getSourceEventCode());
 }
 
 /**
- * NXSL class "Template" attributes
+ * Alarm::eventId
  */
-NXSL_Value *NXSL_TemplateClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, eventId)
 {
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   auto tmpl = SharedObjectFromData<Template>(object);
-   if (compareAttributeName(attr, "autoApplyScript"))
-   {
-      const TCHAR *script = tmpl->getAutoBindScriptSource();
-      value = vm->createValue(CHECK_NULL_EX(script));
-   }
-   else if (compareAttributeName(attr, "isAutoApplyEnabled"))
-   {
-      value = vm->createValue(tmpl->isAutoBindEnabled() ? 1 : 0);
-   }
-   else if (compareAttributeName(attr, "isAutoRemoveEnabled"))
-   {
-      value = vm->createValue(tmpl->isAutoUnbindEnabled() ? 1 : 0);
-   }
-   else if (compareAttributeName(attr, "version"))
-   {
-      value = vm->createValue(tmpl->getVersion());
-   }
-   return value;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getSourceEventId());
 }
 
 /**
- * NXSL class Alarm: constructor
+ * Alarm::eventTagList
  */
-NXSL_TunnelClass::NXSL_TunnelClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(Alarm, eventTagList)
 {
-   setName(_T("Tunnel"));
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getEventTags());
 }
 
 /**
- * NXSL object creation handler
+ * Alarm::helpdeskReference
  */
-void NXSL_TunnelClass::onObjectCreate(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, helpdeskReference)
 {
-   static_cast<AgentTunnel*>(object->getData())->incRefCount();
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getHelpDeskRef());
 }
 
 /**
- * NXSL object destructor
+ * Alarm::helpdeskState
  */
-void NXSL_TunnelClass::onObjectDelete(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, helpdeskState)
 {
-   static_cast<AgentTunnel*>(object->getData())->decRefCount();
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getHelpDeskState());
 }
 
 /**
- * NXSL class Alarm: get attribute
+ * Alarm::id
  */
-NXSL_Value *NXSL_TunnelClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, id)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   AgentTunnel *tunnel = static_cast<AgentTunnel*>(object->getData());
-
-   if (compareAttributeName(attr, "address"))
-   {
-      value = vm->createValue(NXSL_InetAddressClass::createObject(vm, tunnel->getAddress()));
-   }
-   else if (compareAttributeName(attr, "agentBuildTag"))
-   {
-      value = vm->createValue(tunnel->getAgentBuildTag());
-   }
-   else if (compareAttributeName(attr, "agentId"))
-   {
-      value = vm->createValue(tunnel->getAgentId().toString());
-   }
-   else if (compareAttributeName(attr, "agentVersion"))
-   {
-      value = vm->createValue(tunnel->getAgentVersion());
-   }
-   else if (compareAttributeName(attr, "certificateExpirationTime"))
-   {
-      value = vm->createValue(static_cast<int64_t>(tunnel->getCertificateExpirationTime()));
-   }
-   else if (compareAttributeName(attr, "guid"))
-   {
-      value = vm->createValue(tunnel->getGUID().toString());
-   }
-   else if (compareAttributeName(attr, "hostname"))
-   {
-      value = vm->createValue(tunnel->getHostname());
-   }
-   else if (compareAttributeName(attr, "hardwareId"))
-   {
-      value = vm->createValue(tunnel->getHostname());
-   }
-   else if (compareAttributeName(attr, "id"))
-   {
-      value = vm->createValue(tunnel->getId());
-   }
-   else if (compareAttributeName(attr, "isAgentProxy"))
-   {
-      value = vm->createValue(tunnel->isAgentProxy());
-   }
-   else if (compareAttributeName(attr, "isBound"))
-   {
-      value = vm->createValue(tunnel->isBound());
-   }
-   else if (compareAttributeName(attr, "isSnmpProxy"))
-   {
-      value = vm->createValue(tunnel->isSnmpProxy());
-   }
-   else if (compareAttributeName(attr, "isSnmpTrapProxy"))
-   {
-      value = vm->createValue(tunnel->isSnmpTrapProxy());
-   }
-   else if (compareAttributeName(attr, "isUserAgentInstalled"))
-   {
-      value = vm->createValue(tunnel->isUserAgentInstalled());
-   }
-   else if (compareAttributeName(attr, "platformName"))
-   {
-      value = vm->createValue(tunnel->getPlatformName());
-   }
-   else if (compareAttributeName(attr, "startTime"))
-   {
-      value = vm->createValue(static_cast<int64_t>(tunnel->getStartTime()));
-   }
-   else if (compareAttributeName(attr, "systemInfo"))
-   {
-      value = vm->createValue(tunnel->getSystemInfo());
-   }
-   else if (compareAttributeName(attr, "systemName"))
-   {
-      value = vm->createValue(tunnel->getSystemName());
-   }
-   else if (compareAttributeName(attr, "zoneUIN"))
-   {
-      value = vm->createValue(tunnel->getZoneUIN());
-   }
-   return value;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getAlarmId());
 }
 
 /**
- * Event::setMessage() method
+ * Alarm::impact
  */
-NXSL_METHOD_DEFINITION(Event, setMessage)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, impact)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   Event *event = static_cast<Event*>(object->getData());
-   event->setMessage(argv[0]->getValueAsCString());
-   *result = vm->createValue();
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getImpact());
 }
 
 /**
- * Event::setSeverity() method
+ * Alarm::key
  */
-NXSL_METHOD_DEFINITION(Event, setSeverity)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, key)
 {
-   if (!argv[0]->isInteger())
-      return NXSL_ERR_NOT_STRING;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getKey());
+}
 
-   int s = argv[0]->getValueAsInt32();
-   if ((s >= SEVERITY_NORMAL) && (s <= SEVERITY_CRITICAL))
-   {
-      Event *event = static_cast<Event*>(object->getData());
-      event->setSeverity(s);
-   }
-   *result = vm->createValue();
-   return 0;
+/**
+ * Alarm::lastChangeTime
+ */
+NXSL_ATTRIBUTE_DEFINITION(Alarm, lastChangeTime)
+{
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue((INT64)alarm->getLastChangeTime());
 }
 
 /**
- * Event::addParameter() method
+ * Alarm::message
  */
-NXSL_METHOD_DEFINITION(Event, addParameter)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, message)
 {
-   if ((argc < 1) || (argc > 2))
-      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getMessage());
+}
 
-   if (!argv[0]->isString() || ((argc == 2) && !argv[1]->isString()))
-      return NXSL_ERR_NOT_STRING;
+/**
+ * Alarm::originalSeverity
+ */
+NXSL_ATTRIBUTE_DEFINITION(Alarm, originalSeverity)
+{
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getOriginalSeverity());
+}
 
-   Event *event = static_cast<Event*>(object->getData());
-   if (argc == 1)
-      event->addParameter(_T(""), argv[0]->getValueAsCString());
-   else
-      event->addParameter(argv[0]->getValueAsCString(), argv[1]->getValueAsCString());
-   *result = vm->createValue();
-   return 0;
+/**
+ * Alarm::parentId
+ */
+NXSL_ATTRIBUTE_DEFINITION(Alarm, parentId)
+{
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getParentAlarmId());
 }
 
 /**
- * Event::addTag() method
+ * Alarm::repeatCount
  */
-NXSL_METHOD_DEFINITION(Event, addTag)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, repeatCount)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   Event *event = static_cast<Event*>(object->getData());
-   event->addTag(argv[0]->getValueAsCString());
-   *result = vm->createValue();
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getRepeatCount());
 }
 
 /**
- * Event::correlateTo() method
+ * Alarm::resolvedBy
  */
-NXSL_METHOD_DEFINITION(Event, correlateTo)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, resolvedBy)
 {
-   if (!argv[0]->isInteger())
-      return NXSL_ERR_NOT_INTEGER;
-
-   Event *event = static_cast<Event*>(object->getData());
-   event->setRootId(argv[0]->getValueAsUInt64());
-   *result = vm->createValue();
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getResolvedByUser());
 }
 
 /**
- * Event::expandString() method
+ * Alarm::rcaScriptName
  */
-NXSL_METHOD_DEFINITION(Event, expandString)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, rcaScriptName)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   Event *event = static_cast<Event*>(object->getData());
-   *result = vm->createValue(event->expandText(argv[0]->getValueAsCString()));
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getRcaScriptName());
 }
 
 /**
- * Event::hasTag() method
+ * Alarm::ruleGuid
  */
-NXSL_METHOD_DEFINITION(Event, hasTag)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, ruleGuid)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   Event *event = static_cast<Event*>(object->getData());
-   *result = vm->createValue(event->hasTag(argv[0]->getValueAsCString()));
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   TCHAR buffer[64];
+   return vm->createValue(alarm->getRule().toString(buffer));
 }
 
 /**
- * Event::removeTag() method
+ * Alarm::severity
  */
-NXSL_METHOD_DEFINITION(Event, removeTag)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, severity)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getCurrentSeverity());
+}
 
-   Event *event = static_cast<Event*>(object->getData());
-   event->removeTag(argv[0]->getValueAsCString());
-   *result = vm->createValue();
-   return 0;
+/**
+ * Alarm::sourceObject
+ */
+NXSL_ATTRIBUTE_DEFINITION(Alarm, sourceObject)
+{
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getSourceObject());
 }
 
 /**
- * Event::toJson() method
+ * Alarm::state
  */
-NXSL_METHOD_DEFINITION(Event, toJson)
+NXSL_ATTRIBUTE_DEFINITION(Alarm, state)
 {
-   Event *event = static_cast<Event*>(object->getData());
-   json_t *json = event->toJson();
-   char *text = json_dumps(json, JSON_INDENT(3) | JSON_EMBED);
-   *result = vm->createValue(text);
-   MemFree(text);
-   json_decref(json);
-   return 0;
+   Alarm *alarm = static_cast<Alarm*>(object->getData());
+   return vm->createValue(alarm->getState());
 }
 
 /**
- * NXSL class Event: constructor
+ * NXSL class Alarm: constructor
  */
-NXSL_EventClass::NXSL_EventClass() : NXSL_Class()
+NXSL_AlarmClass::NXSL_AlarmClass() : NXSL_Class()
 {
-   setName(_T("Event"));
+   setName(_T("Alarm"));
 
-   NXSL_REGISTER_METHOD(Event, addParameter, -1);
-   NXSL_REGISTER_METHOD(Event, addTag, 1);
-   NXSL_REGISTER_METHOD(Event, correlateTo, 1);
-   NXSL_REGISTER_METHOD(Event, expandString, 1);
-   NXSL_REGISTER_METHOD(Event, hasTag, 1);
-   NXSL_REGISTER_METHOD(Event, removeTag, 1);
-   NXSL_REGISTER_METHOD(Event, setMessage, 1);
-   NXSL_REGISTER_METHOD(Event, setSeverity, 1);
-   NXSL_REGISTER_METHOD(Event, toJson, 0);
+   NXSL_REGISTER_METHOD(Alarm, acknowledge, -1);
+   NXSL_REGISTER_METHOD(Alarm, resolve, -1);
+   NXSL_REGISTER_METHOD(Alarm, terminate, -1);
+   NXSL_REGISTER_METHOD(Alarm, addComment, -1);
+   NXSL_REGISTER_METHOD(Alarm, getComments, 0);
+
+   NXSL_REGISTER_ATTRIBUTE(Alarm, ackBy);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, creationTime);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, dciId);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, eventCode);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, eventId);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, eventTagList);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, helpdeskReference);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, helpdeskState);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, id);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, impact);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, key);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, lastChangeTime);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, message);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, originalSeverity);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, parentId);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, repeatCount);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, resolvedBy);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, rcaScriptName);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, ruleGuid);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, severity);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, sourceObject);
+   NXSL_REGISTER_ATTRIBUTE(Alarm, state);
 }
 
 /**
- * Destructor
+ * NXSL object destructor
  */
-void NXSL_EventClass::onObjectDelete(NXSL_Object *object)
+void NXSL_AlarmClass::onObjectDelete(NXSL_Object *object)
 {
-   delete static_cast<Event*>(object->getData());
+   delete static_cast<Alarm*>(object->getData());
 }
 
 /**
- * NXSL class Event: get attribute
+ * AlarmComment::id
  */
-NXSL_Value *NXSL_EventClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(AlarmComment, id)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   AlarmComment *alarmComment = static_cast<AlarmComment*>(object->getData());
+   return vm->createValue(alarmComment->getId());
+}
 
-   NXSL_VM *vm = object->vm();
-   const Event *event = static_cast<Event*>(object->getData());
-   if (compareAttributeName(attr, "code"))
-   {
-      value = vm->createValue(event->getCode());
-   }
-   else if (compareAttributeName(attr, "customMessage"))
-   {
-      value = vm->createValue(event->getCustomMessage());
-   }
-   else if (compareAttributeName(attr, "dci"))
-   {
-      UINT32 dciId = event->getDciId();
-      if (dciId != 0)
-      {
-         shared_ptr<NetObj> object = FindObjectById(event->getSourceId());
-         if ((object != nullptr) && object->isDataCollectionTarget())
-         {
-            shared_ptr<DCObject> dci = static_cast<DataCollectionTarget*>(object.get())->getDCObjectById(dciId, 0, true);
-            if (dci != nullptr)
-            {
-               value = dci->createNXSLObject(vm);
-            }
-            else
-            {
-               value = vm->createValue();
-            }
-         }
-         else
-         {
-            value = vm->createValue();
-         }
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "dciId"))
-   {
-      value = vm->createValue(event->getDciId());
-   }
-   else if (compareAttributeName(attr, "id"))
-   {
-      value = vm->createValue(event->getId());
-   }
-   else if (compareAttributeName(attr, "message"))
-   {
-      value = vm->createValue(event->getMessage());
-   }
-   else if (compareAttributeName(attr, "name"))
-   {
-		value = vm->createValue(event->getName());
-   }
-   else if (compareAttributeName(attr, "origin"))
-   {
-      value = vm->createValue(static_cast<INT32>(event->getOrigin()));
-   }
-   else if (compareAttributeName(attr, "originTimestamp"))
-   {
-      value = vm->createValue(static_cast<INT64>(event->getOriginTimestamp()));
-   }
-   else if (compareAttributeName(attr, "parameters"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      for(int i = 0; i < event->getParametersCount(); i++)
-         array->set(i + 1, vm->createValue(event->getParameter(i)));
-      value = vm->createValue(array);
-   }
-   else if (compareAttributeName(attr, "parameterNames"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      for(int i = 0; i < event->getParametersCount(); i++)
-         array->set(i + 1, vm->createValue(event->getParameterName(i)));
-      value = vm->createValue(array);
-   }
-   else if (compareAttributeName(attr, "rootId"))
-   {
-      value = vm->createValue(event->getRootId());
-   }
-   else if (compareAttributeName(attr, "severity"))
-   {
-      value = vm->createValue(event->getSeverity());
-   }
-   else if (compareAttributeName(attr, "source"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(event->getSourceId());
-      value = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
-   }
-   else if (compareAttributeName(attr, "sourceId"))
-   {
-      value = vm->createValue(event->getSourceId());
-   }
-   else if (compareAttributeName(attr, "tagList"))
-   {
-      value = vm->createValue(event->getTagsAsList());
-   }
-   else if (compareAttributeName(attr, "tags"))
-   {
-      StringList *tags = String(event->getTagsAsList()).split(_T(","));
-      value = vm->createValue(new NXSL_Array(vm, tags));
-      delete tags;
-   }
-   else if (compareAttributeName(attr, "timestamp"))
-   {
-      value = vm->createValue(static_cast<INT64>(event->getTimestamp()));
-   }
-   else if (event != nullptr)    // Event can be null if getAttr called by attribute scan
-   {
-      if (attr[0] == _T('$'))
-      {
-         // Try to find parameter with given index
-         char *eptr;
-         int index = strtol(&attr[1], &eptr, 10);
-         if ((index > 0) && (*eptr == 0))
-         {
-            const TCHAR *s = event->getParameter(index - 1);
-            if (s != nullptr)
-            {
-               value = vm->createValue(s);
-            }
-         }
-      }
+/**
+ * AlarmComment::changeTime
+ */
+NXSL_ATTRIBUTE_DEFINITION(AlarmComment, changeTime)
+{
+   AlarmComment *alarmComment = static_cast<AlarmComment*>(object->getData());
+   return vm->createValue((INT64)alarmComment->getChangeTime());
+}
 
-      // Try to find named parameter with given name
-      if (value == nullptr)
-      {
-#ifdef UNICODE
-         WCHAR wattr[MAX_IDENTIFIER_LENGTH];
-         MultiByteToWideChar(CP_UTF8, 0, attr, -1, wattr, MAX_IDENTIFIER_LENGTH);
-         wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
-         const TCHAR *s = event->getNamedParameter(wattr);
-#else
-         const TCHAR *s = event->getNamedParameter(attr);
-#endif
-         if (s != nullptr)
-         {
-            value = vm->createValue(s);
-         }
-      }
-   }
-   return value;
+/**
+ * AlarmComment::userId
+ */
+NXSL_ATTRIBUTE_DEFINITION(AlarmComment, userId)
+{
+   AlarmComment *alarmComment = static_cast<AlarmComment*>(object->getData());
+   return vm->createValue(alarmComment->getUserId());
 }
 
 /**
- * NXSL class Event: set attribute
+ * AlarmComment::text
  */
-bool NXSL_EventClass::setAttr(NXSL_Object *object, const char *attr, NXSL_Value *value)
+NXSL_ATTRIBUTE_DEFINITION(AlarmComment, text)
 {
-   Event *event = static_cast<Event*>(object->getData());
-   if (!strcmp(attr, "customMessage"))
-   {
-      if (value->isString())
-      {
-         event->setCustomMessage(value->getValueAsCString());
-      }
-      else
-      {
-         event->setCustomMessage(nullptr);
-      }
-   }
-   else if (!strcmp(attr, "message"))
-   {
-      if (value->isString())
-      {
-         event->setMessage(value->getValueAsCString());
-      }
-   }
-   else if (!strcmp(attr, "severity"))
-   {
-      int s = value->getValueAsInt32();
-      if ((s >= SEVERITY_NORMAL) && (s <= SEVERITY_CRITICAL))
-      {
-         event->setSeverity(s);
-      }
-   }
-   else
-   {
-      bool success = false;
-      if (attr[0] == _T('$'))
-      {
-         // Try to find parameter with given index
-         char *eptr;
-         int index = strtol(&attr[1], &eptr, 10);
-         if ((index > 0) && (*eptr == 0))
-         {
-            const TCHAR *name = event->getParameterName(index - 1);
-            event->setParameter(index - 1, CHECK_NULL_EX(name), value->getValueAsCString());
-            success = true;
-         }
-      }
-      if (!success)
-      {
-#ifdef UNICODE
-         WCHAR wattr[MAX_IDENTIFIER_LENGTH];
-         MultiByteToWideChar(CP_UTF8, 0, attr, -1, wattr, MAX_IDENTIFIER_LENGTH);
-         wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
-         event->setNamedParameter(wattr, value->getValueAsCString());
-#else
-         event->setNamedParameter(attr, value->getValueAsCString());
-#endif
-      }
-   }
-   return true;
+   AlarmComment *alarmComment = static_cast<AlarmComment*>(object->getData());
+   return vm->createValue(alarmComment->getText());
 }
 
 /**
- * Alarm::acknowledge() method
+ * NXSL class Alarm: constructor
  */
-NXSL_METHOD_DEFINITION(Alarm, acknowledge)
+NXSL_AlarmCommentClass::NXSL_AlarmCommentClass() : NXSL_Class()
 {
-   if (argc > 1)
-      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
+   setName(_T("AlarmComment"));
 
-   Alarm *alarm = static_cast<Alarm*>(object->getData());
-   *result = vm->createValue(AckAlarmById(alarm->getAlarmId(), nullptr, false, 0, (argc == 1) ? argv[0]->getValueAsBoolean() : false));
-   return 0;
+   NXSL_REGISTER_ATTRIBUTE(AlarmComment, id);
+   NXSL_REGISTER_ATTRIBUTE(AlarmComment, changeTime);
+   NXSL_REGISTER_ATTRIBUTE(AlarmComment, userId);
+   NXSL_REGISTER_ATTRIBUTE(AlarmComment, text);
 }
 
 /**
- * Alarm::resolve() method
+ * NXSL object destructor
  */
-NXSL_METHOD_DEFINITION(Alarm, resolve)
+void NXSL_AlarmCommentClass::onObjectDelete(NXSL_Object *object)
 {
-   if (argc > 1)
-      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
+   delete static_cast<AlarmComment*>(object->getData());
+}
 
-   Alarm *alarm = static_cast<Alarm*>(object->getData());
-   *result = vm->createValue(ResolveAlarmById(alarm->getAlarmId(), nullptr, false, (argc == 1) ? argv[0]->getValueAsBoolean() : false));
+/**
+ * DCI::forcePoll() method
+ */
+NXSL_METHOD_DEFINITION(DCI, forcePoll)
+{
+   const DCObjectInfo *dci = static_cast<shared_ptr<DCObjectInfo>*>(object->getData())->get();
+   shared_ptr<NetObj> dcTarget = FindObjectById(dci->getOwnerId());
+   if ((dcTarget != nullptr) && dcTarget->isDataCollectionTarget())
+   {
+      shared_ptr<DCObject> dcObject = static_cast<DataCollectionTarget*>(dcTarget.get())->getDCObjectById(dci->getId(), 0, true);
+      if (dcObject != nullptr)
+      {
+         dcObject->requestForcePoll(nullptr);
+      }
+   }
+   *result = vm->createValue();
    return 0;
 }
 
 /**
- * Alarm::terminate() method
+ * Dci::activeThresholdSeverity
  */
-NXSL_METHOD_DEFINITION(Alarm, terminate)
+NXSL_ATTRIBUTE_DEFINITION(Dci, activeThresholdSeverity)
 {
-   if (argc > 1)
-      return NXSL_ERR_INVALID_ARGUMENT_COUNT;
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getThresholdSeverity());
+}
 
-   Alarm *alarm = static_cast<Alarm*>(object->getData());
-   *result = vm->createValue(ResolveAlarmById(alarm->getAlarmId(), nullptr, true, (argc == 1) ? argv[0]->getValueAsBoolean() : false));
-   return 0;
+/**
+ * Dci::comments
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, comments)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getComments());
 }
 
 /**
- * Alarm::addComment() method
+ * Dci::description
  */
-NXSL_METHOD_DEFINITION(Alarm, addComment)
+NXSL_ATTRIBUTE_DEFINITION(Dci, description)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getDescription());
+}
 
-   bool syncWithHelpdesk = true;
-   if (argc > 1)
-   {
-      if(!argv[1]->isInteger())
-         return NXSL_ERR_NOT_INTEGER;
-      else
-         syncWithHelpdesk = argv[1]->getValueAsBoolean();
-   }
+/**
+ * Dci::errorCount
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, errorCount)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getErrorCount());
+}
 
-   Alarm *alarm = static_cast<Alarm*>(object->getData());
-   UINT32 id = 0;
-   UINT32 rcc = UpdateAlarmComment(alarm->getAlarmId(), &id, argv[0]->getValueAsCString(), 0, syncWithHelpdesk);
-   if(rcc != RCC_SUCCESS)
-      return NXSL_ERR_INTERNAL;
+/**
+ * Dci::hasActiveThreshold
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, hasActiveThreshold)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->hasActiveThreshold() ? 1 : 0);
+}
 
-   *result = vm->createValue(id);
-   return 0;
+/**
+ * Dci::id
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, id)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getId());
 }
 
 /**
- * Alarm::getComments() method
+ * Dci::instance
  */
-NXSL_METHOD_DEFINITION(Alarm, getComments)
+NXSL_ATTRIBUTE_DEFINITION(Dci, instance)
 {
-   NXSL_Array *array = new NXSL_Array(vm);
-   ObjectArray<AlarmComment> *alarmComments = GetAlarmComments(((Alarm *)object->getData())->getAlarmId());
-   for(int i = 0; i < alarmComments->size(); i++)
-   {
-      array->append(vm->createValue(new NXSL_Object(vm, &g_nxslAlarmCommentClass, alarmComments->get(i))));
-   }
-   delete alarmComments;
-   *result = vm->createValue(array);
-   return 0;
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getInstance());
 }
 
 /**
- * NXSL class Alarm: constructor
+ * Dci::instanceData
  */
-NXSL_AlarmClass::NXSL_AlarmClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(Dci, instanceData)
 {
-   setName(_T("Alarm"));
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getInstanceData());
+}
 
-   NXSL_REGISTER_METHOD(Alarm, acknowledge, -1);
-   NXSL_REGISTER_METHOD(Alarm, resolve, -1);
-   NXSL_REGISTER_METHOD(Alarm, terminate, -1);
-   NXSL_REGISTER_METHOD(Alarm, addComment, -1);
-   NXSL_REGISTER_METHOD(Alarm, getComments, 0);
+/**
+ * Dci::lastPollTime
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, lastPollTime)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue((INT64)dci->getLastPollTime());
 }
 
 /**
- * NXSL object destructor
+ * Dci::name
  */
-void NXSL_AlarmClass::onObjectDelete(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(Dci, name)
 {
-   delete static_cast<Alarm*>(object->getData());
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getName());
 }
 
 /**
- * NXSL class Alarm: get attribute
+ * Dci::origin
  */
-NXSL_Value *NXSL_AlarmClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Dci, origin)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue((LONG)dci->getOrigin());
+}
 
-   NXSL_VM *vm = object->vm();
-   Alarm *alarm = static_cast<Alarm*>(object->getData());
+/**
+ * Dci::pollingInterval
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, pollingInterval)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getPollingInterval());
+}
 
-   if (compareAttributeName(attr, "ackBy"))
-   {
-      value = vm->createValue(alarm->getAckByUser());
-   }
-   else if (compareAttributeName(attr, "creationTime"))
-   {
-      value = vm->createValue((INT64)alarm->getCreationTime());
-   }
-   else if (compareAttributeName(attr, "dciId"))
-   {
-      value = vm->createValue(alarm->getDciId());
-   }
-   else if (compareAttributeName(attr, "eventCode"))
-   {
-      value = vm->createValue(alarm->getSourceEventCode());
-   }
-   else if (compareAttributeName(attr, "eventId"))
-   {
-      value = vm->createValue(alarm->getSourceEventId());
-   }
-   else if (compareAttributeName(attr, "eventTagList"))
-   {
-      value = vm->createValue(alarm->getEventTags());
-   }
-   else if (compareAttributeName(attr, "helpdeskReference"))
-   {
-      value = vm->createValue(alarm->getHelpDeskRef());
-   }
-   else if (compareAttributeName(attr, "helpdeskState"))
-   {
-      value = vm->createValue(alarm->getHelpDeskState());
-   }
-   else if (compareAttributeName(attr, "id"))
-   {
-      value = vm->createValue(alarm->getAlarmId());
-   }
-   else if (compareAttributeName(attr, "impact"))
-   {
-      value = vm->createValue(alarm->getImpact());
-   }
-   else if (compareAttributeName(attr, "key"))
-   {
-      value = vm->createValue(alarm->getKey());
-   }
-   else if (compareAttributeName(attr, "lastChangeTime"))
-   {
-      value = vm->createValue((INT64)alarm->getLastChangeTime());
-   }
-   else if (compareAttributeName(attr, "message"))
-   {
-      value = vm->createValue(alarm->getMessage());
-   }
-   else if (compareAttributeName(attr, "originalSeverity"))
-   {
-      value = vm->createValue(alarm->getOriginalSeverity());
-   }
-   else if (compareAttributeName(attr, "parentId"))
-   {
-      value = vm->createValue(alarm->getParentAlarmId());
-   }
-   else if (compareAttributeName(attr, "repeatCount"))
-   {
-      value = vm->createValue(alarm->getRepeatCount());
-   }
-   else if (compareAttributeName(attr, "resolvedBy"))
-   {
-      value = vm->createValue(alarm->getResolvedByUser());
-   }
-   else if (compareAttributeName(attr, "rcaScriptName"))
-   {
-      value = vm->createValue(alarm->getRcaScriptName());
-   }
-   else if (compareAttributeName(attr, "ruleGuid"))
+/**
+ * Dci::relatedObject
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, relatedObject)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   NXSL_Value *value = nullptr;
+   if (dci->getRelatedObject() != 0)
    {
-      TCHAR buffer[64];
-      value = vm->createValue(alarm->getRule().toString(buffer));
+      shared_ptr<NetObj> object = FindObjectById(dci->getRelatedObject());
+      value = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
    }
-   else if (compareAttributeName(attr, "severity"))
+   else
    {
-      value = vm->createValue(alarm->getCurrentSeverity());
+      value = vm->createValue();
    }
-   else if (compareAttributeName(attr, "sourceObject"))
+   return value;
+}
+
+/**
+ * Dci::status
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, status)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue((LONG)dci->getStatus());
+}
+
+/**
+ * Dci::systemTag
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, systemTag)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getSystemTag());
+}
+
+/**
+ * Dci::template
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, template)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   NXSL_Value *value = nullptr;
+   if (dci->getTemplateId() != 0)
    {
-      value = vm->createValue(alarm->getSourceObject());
+      shared_ptr<NetObj> object = FindObjectById(dci->getTemplateId());
+      value = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
    }
-   else if (compareAttributeName(attr, "state"))
+   else
    {
-      value = vm->createValue(alarm->getState());
+      value = vm->createValue();
    }
    return value;
 }
 
 /**
- * NXSL class Alarm: constructor
+ * Dci::templateId
  */
-NXSL_AlarmCommentClass::NXSL_AlarmCommentClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(Dci, templateId)
 {
-   setName(_T("AlarmComment"));
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getTemplateId());
 }
 
 /**
- * NXSL object destructor
+ * Dci::templateItemId
  */
-void NXSL_AlarmCommentClass::onObjectDelete(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(Dci, templateItemId)
 {
-   delete static_cast<AlarmComment*>(object->getData());
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue(dci->getTemplateItemId());
+}
+
+/**
+ * Dci::type
+ */
+NXSL_ATTRIBUTE_DEFINITION(Dci, type)
+{
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   return vm->createValue((LONG)dci->getType());
+}
+
+/**
+ * Implementation of "DCI" class: constructor
+ */
+NXSL_DciClass::NXSL_DciClass() : NXSL_Class()
+{
+   setName(_T("DCI"));
+
+   NXSL_REGISTER_METHOD(DCI, forcePoll, 0);
+
+   NXSL_REGISTER_ATTRIBUTE(Dci, activeThresholdSeverity);
+   NXSL_REGISTER_ATTRIBUTE(Dci, comments);
+   NXSL_REGISTER_ATTRIBUTE(Dci, description);
+   NXSL_REGISTER_ATTRIBUTE(Dci, errorCount);
+   NXSL_REGISTER_ATTRIBUTE(Dci, hasActiveThreshold);
+   NXSL_REGISTER_ATTRIBUTE(Dci, id);
+   NXSL_REGISTER_ATTRIBUTE(Dci, instance);
+   NXSL_REGISTER_ATTRIBUTE(Dci, instanceData);
+   NXSL_REGISTER_ATTRIBUTE(Dci, lastPollTime);
+   NXSL_REGISTER_ATTRIBUTE(Dci, name);
+   NXSL_REGISTER_ATTRIBUTE(Dci, origin);
+   NXSL_REGISTER_ATTRIBUTE(Dci, pollingInterval);
+   NXSL_REGISTER_ATTRIBUTE(Dci, relatedObject);
+   NXSL_REGISTER_ATTRIBUTE(Dci, status);
+   NXSL_REGISTER_ATTRIBUTE(Dci, systemTag);
+   NXSL_REGISTER_ATTRIBUTE(Dci, template);
+   NXSL_REGISTER_ATTRIBUTE(Dci, templateId);
+   NXSL_REGISTER_ATTRIBUTE(Dci, templateItemId);
+   NXSL_REGISTER_ATTRIBUTE(Dci, type);
+}
+
+/**
+ * Object destructor
+ */
+void NXSL_DciClass::onObjectDelete(NXSL_Object *object)
+{
+   delete static_cast<shared_ptr<DCObjectInfo>*>(object->getData());
 }
 
 /**
- * NXSL class Alarm: get attribute
+ * Implementation of "DCI" class: get attribute
  */
-NXSL_Value *NXSL_AlarmCommentClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_Value *NXSL_DciClass::getAttr(NXSL_Object *object, const char *attr)
 {
    NXSL_Value *value = NXSL_Class::getAttr(object, attr);
    if (value != nullptr)
       return value;
 
    NXSL_VM *vm = object->vm();
-   AlarmComment *alarmComment = static_cast<AlarmComment*>(object->getData());
-
-   if (compareAttributeName(attr, "id"))
-   {
-      value = vm->createValue(alarmComment->getId());
-   }
-   else if (compareAttributeName(attr, "changeTime"))
-   {
-      value = vm->createValue((INT64)alarmComment->getChangeTime());
-   }
-   else if (compareAttributeName(attr, "userId"))
-   {
-      value = vm->createValue(alarmComment->getUserId());
-   }
-   else if (compareAttributeName(attr, "text"))
+   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
+   if (compareAttributeName(attr, "dataType") && (dci->getType() == DCO_TYPE_ITEM))
    {
-      value = vm->createValue(alarmComment->getText());
+      value = vm->createValue(dci->getDataType());
    }
    return value;
 }
 
 /**
- * DCI::forcePoll() method
+ * Sensor::description
  */
-NXSL_METHOD_DEFINITION(DCI, forcePoll)
+NXSL_ATTRIBUTE_DEFINITION(Sensor, description)
 {
-   const DCObjectInfo *dci = static_cast<shared_ptr<DCObjectInfo>*>(object->getData())->get();
-   shared_ptr<NetObj> dcTarget = FindObjectById(dci->getOwnerId());
-   if ((dcTarget != nullptr) && dcTarget->isDataCollectionTarget())
-   {
-      shared_ptr<DCObject> dcObject = static_cast<DataCollectionTarget*>(dcTarget.get())->getDCObjectById(dci->getId(), 0, true);
-      if (dcObject != nullptr)
-      {
-         dcObject->requestForcePoll(nullptr);
-      }
-   }
-   *result = vm->createValue();
-   return 0;
+   auto sensor = SharedObjectFromData<Sensor>(object);
+   return vm->createValue(sensor->getDescription());
+}
+
+/**
+ * Sensor::frameCount
+ */
+NXSL_ATTRIBUTE_DEFINITION(Sensor, frameCount)
+{
+   auto sensor = SharedObjectFromData<Sensor>(object);
+   return vm->createValue(sensor->getFrameCount());
 }
 
 /**
- * Implementation of "DCI" class: constructor
+ * Sensor::lastContact
  */
-NXSL_DciClass::NXSL_DciClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(Sensor, lastContact)
 {
-   setName(_T("DCI"));
-
-   NXSL_REGISTER_METHOD(DCI, forcePoll, 0);
+   auto sensor = SharedObjectFromData<Sensor>(object);
+   return vm->createValue((UINT32)sensor->getLastContact());
 }
 
 /**
- * Object destructor
+ * Sensor::metaType
  */
-void NXSL_DciClass::onObjectDelete(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(Sensor, metaType)
 {
-   delete static_cast<shared_ptr<DCObjectInfo>*>(object->getData());
+   auto sensor = SharedObjectFromData<Sensor>(object);
+   return vm->createValue(sensor->getMetaType());
 }
 
 /**
- * Implementation of "DCI" class: get attribute
+ * Sensor::protocol
  */
-NXSL_Value *NXSL_DciClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Sensor, protocol)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   const DCObjectInfo *dci = SharedObjectFromData<DCObjectInfo>(object);
-   if (compareAttributeName(attr, "activeThresholdSeverity"))
-   {
-      value = vm->createValue(dci->getThresholdSeverity());
-   }
-   else if (compareAttributeName(attr, "comments"))
-   {
-		value = vm->createValue(dci->getComments());
-   }
-   else if (compareAttributeName(attr, "dataType") && (dci->getType() == DCO_TYPE_ITEM))
-   {
-		value = vm->createValue(dci->getDataType());
-   }
-   else if (compareAttributeName(attr, "description"))
-   {
-		value = vm->createValue(dci->getDescription());
-   }
-   else if (compareAttributeName(attr, "errorCount"))
-   {
-		value = vm->createValue(dci->getErrorCount());
-   }
-   else if (compareAttributeName(attr, "hasActiveThreshold"))
-   {
-      value = vm->createValue(dci->hasActiveThreshold() ? 1 : 0);
-   }
-   else if (compareAttributeName(attr, "id"))
-   {
-		value = vm->createValue(dci->getId());
-   }
-   else if (compareAttributeName(attr, "instance"))
-   {
-		value = vm->createValue(dci->getInstance());
-   }
-   else if (compareAttributeName(attr, "instanceData"))
-   {
-		value = vm->createValue(dci->getInstanceData());
-   }
-   else if (compareAttributeName(attr, "lastPollTime"))
-   {
-		value = vm->createValue((INT64)dci->getLastPollTime());
-   }
-   else if (compareAttributeName(attr, "name"))
-   {
-		value = vm->createValue(dci->getName());
-   }
-   else if (compareAttributeName(attr, "origin"))
-   {
-		value = vm->createValue((LONG)dci->getOrigin());
-   }
-   else if (compareAttributeName(attr, "pollingInterval"))
-   {
-      value = vm->createValue(dci->getPollingInterval());
-   }
-   else if (compareAttributeName(attr, "relatedObject"))
-   {
-      if (dci->getRelatedObject() != 0)
-      {
-         shared_ptr<NetObj> object = FindObjectById(dci->getRelatedObject());
-         value = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "status"))
-   {
-		value = vm->createValue((LONG)dci->getStatus());
-   }
-   else if (compareAttributeName(attr, "systemTag"))
-   {
-		value = vm->createValue(dci->getSystemTag());
-   }
-   else if (compareAttributeName(attr, "template"))
-   {
-      if (dci->getTemplateId() != 0)
-      {
-         shared_ptr<NetObj> object = FindObjectById(dci->getTemplateId());
-         value = (object != nullptr) ? object->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (compareAttributeName(attr, "templateId"))
-   {
-      value = vm->createValue(dci->getTemplateId());
-   }
-   else if (compareAttributeName(attr, "templateItemId"))
-   {
-      value = vm->createValue(dci->getTemplateItemId());
-   }
-   else if (compareAttributeName(attr, "type"))
-   {
-		value = vm->createValue((LONG)dci->getType());
-   }
-   return value;
+   auto sensor = SharedObjectFromData<Sensor>(object);
+   return vm->createValue(sensor->getCommProtocol());
 }
 
 /**
- * Implementation of "Sensor" class: constructor
+ * Sensor::serial
  */
-NXSL_SensorClass::NXSL_SensorClass() : NXSL_DCTargetClass()
+NXSL_ATTRIBUTE_DEFINITION(Sensor, serial)
 {
-   setName(_T("Sensor"));
+   auto sensor = SharedObjectFromData<Sensor>(object);
+   return vm->createValue(sensor->getSerialNumber());
 }
 
 /**
- * Implementation of "Sensor" class: get attribute
+ * Sensor::vendor
  */
-NXSL_Value *NXSL_SensorClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Sensor, vendor)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
    auto sensor = SharedObjectFromData<Sensor>(object);
-   if (compareAttributeName(attr, "description"))
-   {
-      value = vm->createValue(sensor->getDescription());
-   }
-   else if (compareAttributeName(attr, "frameCount"))
-   {
-      value = vm->createValue(sensor->getFrameCount());
-   }
-   else if (compareAttributeName(attr, "lastContact"))
-   {
-      value = vm->createValue((UINT32)sensor->getLastContact());
-   }
-   else if (compareAttributeName(attr, "metaType"))
-   {
-      value = vm->createValue(sensor->getMetaType());
-   }
-   else if (compareAttributeName(attr, "protocol"))
-   {
-      value = vm->createValue(sensor->getCommProtocol());
-   }
-   else if (compareAttributeName(attr, "serial"))
-   {
-      value = vm->createValue(sensor->getSerialNumber());
-   }
-   else if (compareAttributeName(attr, "type"))
-   {
-      value = vm->createValue(sensor->getSensorClass());
-   }
-   else if (compareAttributeName(attr, "vendor"))
-   {
-      value = vm->createValue(sensor->getVendor());
-   }
+   return vm->createValue(sensor->getVendor());
+}
 
-   return value;
+/**
+ * Implementation of "Sensor" class: constructor
+ */
+NXSL_SensorClass::NXSL_SensorClass() : NXSL_DCTargetClass()
+{
+   setName(_T("Sensor"));
+
+   NXSL_REGISTER_ATTRIBUTE(Sensor, description);
+   NXSL_REGISTER_ATTRIBUTE(Sensor, frameCount);
+   NXSL_REGISTER_ATTRIBUTE(Sensor, lastContact);
+   NXSL_REGISTER_ATTRIBUTE(Sensor, metaType);
+   NXSL_REGISTER_ATTRIBUTE(Sensor, protocol);
+   NXSL_REGISTER_ATTRIBUTE(Sensor, serial);
+   NXSL_REGISTER_ATTRIBUTE(Sensor, vendor);
 }
 
 /**
@@ -3478,9 +4977,8 @@ NXSL_METHOD_DEFINITION(SNMPTransport, get)
    {
       if ((rspPDU->getNumVariables() > 0) && (rspPDU->getErrorCode() == SNMP_PDU_ERR_SUCCESS))
       {
-         SNMP_Variable *pVar = rspPDU->getVariable(0);
+         SNMP_Variable *pVar = rspPDU->detachVariable(0);
          *result = vm->createValue(new NXSL_Object(vm, &g_nxslSnmpVarBindClass, pVar));
-         rspPDU->unlinkVariables();
       }
       else
       {
@@ -3589,285 +5087,390 @@ NXSL_METHOD_DEFINITION(SNMPTransport, set)
 }
 
 /**
- * SNMP walk callback
+ * SNMP walk callback
+ */
+static UINT32 WalkCallback(SNMP_Variable *var, SNMP_Transport *transport, void *context)
+{
+   NXSL_VM *vm = static_cast<NXSL_VM*>(static_cast<NXSL_Array*>(context)->vm());
+   static_cast<NXSL_Array*>(context)->append(vm->createValue(new NXSL_Object(vm, &g_nxslSnmpVarBindClass, new SNMP_Variable(var))));
+   return SNMP_ERR_SUCCESS;
+}
+
+/**
+ * SNMPTransport::walk() method
+ */
+NXSL_METHOD_DEFINITION(SNMPTransport, walk)
+{
+   if (!argv[0]->isString())
+      return NXSL_ERR_NOT_STRING;
+
+   SNMP_Transport *transport = static_cast<SNMP_Transport*>(object->getData());
+
+   NXSL_Array *varbinds = new NXSL_Array(vm);
+   if (SnmpWalk(transport, argv[0]->getValueAsCString(), WalkCallback, varbinds) == SNMP_ERR_SUCCESS)
+   {
+      *result = vm->createValue(varbinds);
+   }
+   else
+   {
+      *result = vm->createValue();
+      delete varbinds;
+   }
+   return 0;
+}
+
+/**
+ * SNMPTransport::snmpVersion
+ */
+NXSL_ATTRIBUTE_DEFINITION(SNMPTransport, snmpVersion)
+{
+   SNMP_Transport *t = static_cast<SNMP_Transport*>(object->getData());
+   const TCHAR *version = NULL;
+   switch (t->getSnmpVersion())
+   {
+      case SNMP_VERSION_1:
+         version = _T("1");
+         break;
+      case SNMP_VERSION_2C:
+         version = _T("2c");
+         break;
+      case SNMP_VERSION_3:
+         version = _T("3");
+         break;
+      case SNMP_VERSION_DEFAULT:
+         version = _T("Default");
+         break;
+      default:
+         version = _T("Unknown");
+   }
+
+   return object->vm()->createValue(version);
+}
+
+/**
+ * Implementation of "SNMP_Transport" class: constructor
+ */
+NXSL_SNMPTransportClass::NXSL_SNMPTransportClass() : NXSL_Class()
+{
+	setName(_T("SNMPTransport"));
+
+   NXSL_REGISTER_METHOD(SNMPTransport, get, 1);
+   NXSL_REGISTER_METHOD(SNMPTransport, getValue, 1);
+   NXSL_REGISTER_METHOD(SNMPTransport, set, -1);
+   NXSL_REGISTER_METHOD(SNMPTransport, walk, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(SNMPTransport, snmpVersion);
+}
+
+/**
+ * Implementation of "SNMP_Transport" class: NXSL object destructor
+ */
+void NXSL_SNMPTransportClass::onObjectDelete(NXSL_Object *object)
+{
+	delete (SNMP_Transport *)object->getData();
+}
+
+/**
+ * SNMPVarBind::type
+ */
+NXSL_ATTRIBUTE_DEFINITION(SNMPVarBind, type)
+{
+   SNMP_Variable *t = static_cast<SNMP_Variable*>(object->getData());
+   return vm->createValue((UINT32)t->getType());
+}
+
+/**
+ * SNMPVarBind::name
+ */
+NXSL_ATTRIBUTE_DEFINITION(SNMPVarBind, name)
+{
+   SNMP_Variable *t = static_cast<SNMP_Variable*>(object->getData());
+   return vm->createValue(t->getName().toString());
+}
+
+/**
+ * SNMPVarBind::value
+ */
+NXSL_ATTRIBUTE_DEFINITION(SNMPVarBind, value)
+{
+   SNMP_Variable *t = static_cast<SNMP_Variable*>(object->getData());
+   TCHAR strValue[1024];
+   return vm->createValue(t->getValueAsString(strValue, 1024));
+}
+
+/**
+ * SNMPVarBind::printableValue
+ */
+NXSL_ATTRIBUTE_DEFINITION(SNMPVarBind, printableValue)
+{
+   SNMP_Variable *t = static_cast<SNMP_Variable*>(object->getData());
+   TCHAR strValue[1024];
+   bool convToHex = true;
+   t->getValueAsPrintableString(strValue, 1024, &convToHex);
+   return vm->createValue(strValue);
+}
+
+/**
+ * SNMPVarBind::valueAsIp
+ */
+NXSL_ATTRIBUTE_DEFINITION(SNMPVarBind, valueAsIp)
+{
+   SNMP_Variable *t = static_cast<SNMP_Variable*>(object->getData());
+   TCHAR strValue[128];
+   t->getValueAsIPAddr(strValue);
+   return vm->createValue(strValue);
+}
+
+/**
+ * SNMPVarBind::valueAsMac
+ */
+NXSL_ATTRIBUTE_DEFINITION(SNMPVarBind, valueAsMac)
+{
+   SNMP_Variable *t = static_cast<SNMP_Variable*>(object->getData());
+   TCHAR strValue[128];
+   return vm->createValue(t->getValueAsMACAddr().toString(strValue));
+}
+
+/**
+ * NXSL class SNMP_VarBind: constructor
+ */
+NXSL_SNMPVarBindClass::NXSL_SNMPVarBindClass() : NXSL_Class()
+{
+	setName(_T("SNMP_VarBind"));
+
+   NXSL_REGISTER_ATTRIBUTE(SNMPVarBind, type);
+   NXSL_REGISTER_ATTRIBUTE(SNMPVarBind, name);
+   NXSL_REGISTER_ATTRIBUTE(SNMPVarBind, value);
+   NXSL_REGISTER_ATTRIBUTE(SNMPVarBind, printableValue);
+   NXSL_REGISTER_ATTRIBUTE(SNMPVarBind, valueAsIp);
+   NXSL_REGISTER_ATTRIBUTE(SNMPVarBind, valueAsMac);
+}
+
+/**
+ * NXSL class SNMP_VarBind: NXSL object desctructor
+ */
+void NXSL_SNMPVarBindClass::onObjectDelete(NXSL_Object *object)
+{
+	delete static_cast<SNMP_Variable*>(object->getData());
+}
+
+/**
+ * UserDBObject::description
+ */
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, description)
+{
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->getDescription());
+}
+
+/**
+ * UserDBObject::flags
+ */
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, flags)
+{
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->getFlags());
+}
+
+/**
+ * UserDBObject::guid
+ */
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, guid)
+{
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   TCHAR buffer[64];
+   return vm->createValue(dbObject->getGuidAsText(buffer));
+}
+
+/**
+ * UserDBObject::id
+ */
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, id)
+{
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->getId());
+}
+
+/**
+ * UserDBObject::isDeleted
+ */
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, isDeleted)
+{
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->isDeleted());
+}
+
+/**
+ * UserDBObject::isDisabled
+ */
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, isDisabled)
+{
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->isDisabled());
+}
+
+/**
+ * UserDBObject::isGroup
  */
-static UINT32 WalkCallback(SNMP_Variable *var, SNMP_Transport *transport, void *context)
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, isGroup)
 {
-   NXSL_VM *vm = static_cast<NXSL_VM*>(static_cast<NXSL_Array*>(context)->vm());
-   static_cast<NXSL_Array*>(context)->append(vm->createValue(new NXSL_Object(vm, &g_nxslSnmpVarBindClass, new SNMP_Variable(var))));
-   return SNMP_ERR_SUCCESS;
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->isGroup());
 }
 
 /**
- * SNMPTransport::walk() method
+ * UserDBObject::isModified
  */
-NXSL_METHOD_DEFINITION(SNMPTransport, walk)
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, isModified)
 {
-   if (!argv[0]->isString())
-      return NXSL_ERR_NOT_STRING;
-
-   SNMP_Transport *transport = static_cast<SNMP_Transport*>(object->getData());
-
-   NXSL_Array *varbinds = new NXSL_Array(vm);
-   if (SnmpWalk(transport, argv[0]->getValueAsCString(), WalkCallback, varbinds) == SNMP_ERR_SUCCESS)
-   {
-      *result = vm->createValue(varbinds);
-   }
-   else
-   {
-      *result = vm->createValue();
-      delete varbinds;
-   }
-   return 0;
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->isModified());
 }
 
 /**
- * Implementation of "SNMP_Transport" class: constructor
+ * UserDBObject::isLDAPUser
  */
-NXSL_SNMPTransportClass::NXSL_SNMPTransportClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, isLDAPUser)
 {
-	setName(_T("SNMPTransport"));
-
-   NXSL_REGISTER_METHOD(SNMPTransport, get, 1);
-   NXSL_REGISTER_METHOD(SNMPTransport, getValue, 1);
-   NXSL_REGISTER_METHOD(SNMPTransport, set, -1);
-   NXSL_REGISTER_METHOD(SNMPTransport, walk, 1);
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->isLDAPUser());
 }
 
 /**
- * Implementation of "SNMP_Transport" class: get attribute
+ * UserDBObject::ldapDomain
  */
-NXSL_Value *NXSL_SNMPTransportClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, ldapDomain)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-	SNMP_Transport *t = static_cast<SNMP_Transport*>(object->getData());
-
-	if (compareAttributeName(attr, "snmpVersion"))
-	{
-	   const TCHAR *version = NULL;
-		switch (t->getSnmpVersion())
-		{
-		   case SNMP_VERSION_1:
-		      version = _T("1");
-		      break;
-		   case SNMP_VERSION_2C:
-		      version = _T("2c");
-		      break;
-		   case SNMP_VERSION_3:
-		      version = _T("3");
-		      break;
-		   case SNMP_VERSION_DEFAULT:
-		      version = _T("Default");
-		      break;
-		   default:
-		      version = _T("Unknown");
-		}
-
-		value = object->vm()->createValue(version);
-	}
-
-	return value;
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->getDn());
 }
 
 /**
- * Implementation of "SNMP_Transport" class: NXSL object destructor
+ * UserDBObject::ldapId
  */
-void NXSL_SNMPTransportClass::onObjectDelete(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, ldapId)
 {
-	delete (SNMP_Transport *)object->getData();
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->getLdapId());
 }
 
 /**
- * NXSL class SNMP_VarBind: constructor
+ * UserDBObject::systemRights
  */
-NXSL_SNMPVarBindClass::NXSL_SNMPVarBindClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(UserDBObject, systemRights)
 {
-	setName(_T("SNMP_VarBind"));
+   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   return vm->createValue(dbObject->getSystemRights());
 }
 
 /**
- * NXSL class SNMP_VarBind: get attribute
+ * NXSL class UserDBObjectClass: constructor
  */
-NXSL_Value *NXSL_SNMPVarBindClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_UserDBObjectClass::NXSL_UserDBObjectClass() : NXSL_Class()
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   setName(_T("UserDBObject"));
 
-   NXSL_VM *vm = object->vm();
-	SNMP_Variable *t = static_cast<SNMP_Variable*>(object->getData());
-	if (compareAttributeName(attr, "type"))
-	{
-		value = vm->createValue((UINT32)t->getType());
-	}
-	else if (compareAttributeName(attr, "name"))
-	{
-		value = vm->createValue(t->getName().toString());
-	}
-	else if (compareAttributeName(attr, "value"))
-	{
-   	TCHAR strValue[1024];
-		value = vm->createValue(t->getValueAsString(strValue, 1024));
-	}
-	else if (compareAttributeName(attr, "printableValue"))
-	{
-   	TCHAR strValue[1024];
-		bool convToHex = true;
-		t->getValueAsPrintableString(strValue, 1024, &convToHex);
-		value = vm->createValue(strValue);
-	}
-	else if (compareAttributeName(attr, "valueAsIp"))
-	{
-   	TCHAR strValue[128];
-		t->getValueAsIPAddr(strValue);
-		value = vm->createValue(strValue);
-	}
-	else if (compareAttributeName(attr, "valueAsMac"))
-	{
-   	TCHAR strValue[128];
-		value = vm->createValue(t->getValueAsMACAddr().toString(strValue));
-	}
-
-	return value;
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, description);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, flags);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, guid);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, id);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, isDeleted);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, isDisabled);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, isGroup);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, isModified);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, isLDAPUser);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, ldapDomain);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, ldapId);
+   NXSL_REGISTER_ATTRIBUTE(UserDBObject, systemRights);
 }
 
 /**
- * NXSL class SNMP_VarBind: NXSL object desctructor
+ * User::authMethod
  */
-void NXSL_SNMPVarBindClass::onObjectDelete(NXSL_Object *object)
+NXSL_ATTRIBUTE_DEFINITION(User, authMethod)
 {
-	delete static_cast<SNMP_Variable*>(object->getData());
+   User *user = static_cast<User*>(object->getData());
+   return vm->createValue(user->getAuthMethod());
 }
 
 /**
- * NXSL class UserDBObjectClass: constructor
+ * User::certMappingData
  */
-NXSL_UserDBObjectClass::NXSL_UserDBObjectClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(User, certMappingData)
 {
-   setName(_T("UserDBObject"));
+   User *user = static_cast<User*>(object->getData());
+   return vm->createValue(user->getCertMappingData());
 }
 
 /**
- * NXSL class UserDBObjectClass: get attribute
+ * User::certMappingMethod
  */
-NXSL_Value *NXSL_UserDBObjectClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(User, certMappingMethod)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
-   UserDatabaseObject *dbObject = static_cast<UserDatabaseObject*>(object->getData());
+   User *user = static_cast<User*>(object->getData());
+   return vm->createValue(user->getCertMappingMethod());
+}
 
-   if (compareAttributeName(attr, "description"))
-   {
-      value = vm->createValue(dbObject->getDescription());
-   }
-   else if (compareAttributeName(attr, "flags"))
-   {
-      value = vm->createValue(dbObject->getFlags());
-   }
-   else if (compareAttributeName(attr, "guid"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(dbObject->getGuidAsText(buffer));
-   }
-   else if (compareAttributeName(attr, "id"))
-   {
-      value = vm->createValue(dbObject->getId());
-   }
-   else if (compareAttributeName(attr, "isDeleted"))
-   {
-      value = vm->createValue(dbObject->isDeleted());
-   }
-   else if (compareAttributeName(attr, "isDisabled"))
-   {
-      value = vm->createValue(dbObject->isDisabled());
-   }
-   else if (compareAttributeName(attr, "isGroup"))
-   {
-      value = vm->createValue(dbObject->isGroup());
-   }
-   else if (compareAttributeName(attr, "isModified"))
-   {
-      value = vm->createValue(dbObject->isModified());
-   }
-   else if (compareAttributeName(attr, "isLDAPUser"))
-   {
-      value = vm->createValue(dbObject->isLDAPUser());
-   }
-   else if (compareAttributeName(attr, "ldapDomain"))
-   {
-      value = vm->createValue(dbObject->getDn());
-   }
-   else if (compareAttributeName(attr, "ldapId"))
-   {
-      value = vm->createValue(dbObject->getLdapId());
-   }
-   else if (compareAttributeName(attr, "systemRights"))
-   {
-      value = vm->createValue(dbObject->getSystemRights());
-   }
+/**
+ * User::disabledUntil
+ */
+NXSL_ATTRIBUTE_DEFINITION(User, disabledUntil)
+{
+   User *user = static_cast<User*>(object->getData());
+   return vm->createValue(static_cast<UINT32>(user->getReEnableTime()));
+}
 
-   return value;
+/**
+ * User::fullName
+ */
+NXSL_ATTRIBUTE_DEFINITION(User, fullName)
+{
+   User *user = static_cast<User*>(object->getData());
+   return vm->createValue(user->getFullName());
 }
 
 /**
- * NXSL class UserClass: constructor
+ * User::graceLogins
  */
-NXSL_UserClass::NXSL_UserClass() : NXSL_UserDBObjectClass()
+NXSL_ATTRIBUTE_DEFINITION(User, graceLogins)
 {
-   setName(_T("User"));
+   User *user = static_cast<User*>(object->getData());
+   return vm->createValue(user->getGraceLogins());
 }
 
 /**
- * NXSL class UserDBObjectClass: get attribute
+ * User::lastLogin
  */
-NXSL_Value *NXSL_UserClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(User, lastLogin)
 {
-   NXSL_Value *value = NXSL_UserDBObjectClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   User *user = static_cast<User*>(object->getData());
+   return vm->createValue(static_cast<UINT32>(user->getLastLoginTime()));
+}
 
-   NXSL_VM *vm = object->vm();
+/**
+ * User::xmppId
+ */
+NXSL_ATTRIBUTE_DEFINITION(User, xmppId)
+{
    User *user = static_cast<User*>(object->getData());
-   if (compareAttributeName(attr, "authMethod"))
-   {
-      value = vm->createValue(user->getAuthMethod());
-   }
-   else if (compareAttributeName(attr, "certMappingData"))
-   {
-      value = vm->createValue(user->getCertMappingData());
-   }
-   else if (compareAttributeName(attr, "certMappingMethod"))
-   {
-      value = vm->createValue(user->getCertMappingMethod());
-   }
-   else if (compareAttributeName(attr, "disabledUntil"))
-   {
-      value = vm->createValue(static_cast<UINT32>(user->getReEnableTime()));
-   }
-   else if (compareAttributeName(attr, "fullName"))
-   {
-      value = vm->createValue(user->getFullName());
-   }
-   else if (compareAttributeName(attr, "graceLogins"))
-   {
-      value = vm->createValue(user->getGraceLogins());
-   }
-   else if (compareAttributeName(attr, "lastLogin"))
-   {
-      value = vm->createValue(static_cast<UINT32>(user->getLastLoginTime()));
-   }
-   else if (compareAttributeName(attr, "xmppId"))
-   {
-      value = vm->createValue(user->getXmppId());
-   }
+   return vm->createValue(user->getXmppId());
+}
 
-   return value;
+/**
+ * NXSL class UserClass: constructor
+ */
+NXSL_UserClass::NXSL_UserClass() : NXSL_UserDBObjectClass()
+{
+   setName(_T("User"));
+
+   NXSL_REGISTER_ATTRIBUTE(User, authMethod);
+   NXSL_REGISTER_ATTRIBUTE(User, certMappingData);
+   NXSL_REGISTER_ATTRIBUTE(User, certMappingMethod);
+   NXSL_REGISTER_ATTRIBUTE(User, disabledUntil);
+   NXSL_REGISTER_ATTRIBUTE(User, fullName);
+   NXSL_REGISTER_ATTRIBUTE(User, graceLogins);
+   NXSL_REGISTER_ATTRIBUTE(User, lastLogin);
+   NXSL_REGISTER_ATTRIBUTE(User, xmppId);
 }
 
 /**
@@ -3879,47 +5482,47 @@ void NXSL_UserClass::onObjectDelete(NXSL_Object *object)
 }
 
 /**
- * NXSL class UserGroupClass: constructor
+ * UserGroup::memberCount
  */
-NXSL_UserGroupClass::NXSL_UserGroupClass() : NXSL_UserDBObjectClass()
+NXSL_ATTRIBUTE_DEFINITION(UserGroup, memberCount)
 {
-   setName(_T("UserGroup"));
+   Group *group = static_cast<Group*>(object->getData());
+   return vm->createValue(group->getMemberCount());
 }
 
 /**
- * NXSL class UserDBObjectClass: get attribute
+ * UserGroup::members
  */
-NXSL_Value *NXSL_UserGroupClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(UserGroup, members)
 {
-   NXSL_Value *value = NXSL_UserDBObjectClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
    Group *group = static_cast<Group*>(object->getData());
-   if (compareAttributeName(attr, "memberCount"))
-   {
-      value = vm->createValue(group->getMemberCount());
-   }
-   else if (compareAttributeName(attr, "members"))
+   NXSL_Value *value = nullptr;
+   NXSL_Array *array = new NXSL_Array(vm);
+   ObjectArray<UserDatabaseObject> *userDB = FindUserDBObjects(group->getMembers());
+   userDB->setOwner(Ownership::False);
+   for(int i = 0; i < userDB->size(); i++)
    {
-      NXSL_Array *array = new NXSL_Array(vm);
-      ObjectArray<UserDatabaseObject> *userDB = FindUserDBObjects(group->getMembers());
-      userDB->setOwner(Ownership::False);
-      for(int i = 0; i < userDB->size(); i++)
-      {
-         if (userDB->get(i)->isGroup())
-            array->append(vm->createValue(new NXSL_Object(vm, &g_nxslUserGroupClass, userDB->get(i))));
-         else
-            array->append(vm->createValue(new NXSL_Object(vm, &g_nxslUserClass, userDB->get(i))));
-      }
-      value = vm->createValue(array);
-      delete userDB;
+      if (userDB->get(i)->isGroup())
+         array->append(vm->createValue(new NXSL_Object(vm, &g_nxslUserGroupClass, userDB->get(i))));
+      else
+         array->append(vm->createValue(new NXSL_Object(vm, &g_nxslUserClass, userDB->get(i))));
    }
-
+   value = vm->createValue(array);
+   delete userDB;
    return value;
 }
 
+/**
+ * NXSL class UserGroupClass: constructor
+ */
+NXSL_UserGroupClass::NXSL_UserGroupClass() : NXSL_UserDBObjectClass()
+{
+   setName(_T("UserGroup"));
+
+   NXSL_REGISTER_ATTRIBUTE(UserGroup, memberCount);
+   NXSL_REGISTER_ATTRIBUTE(UserGroup, members);
+}
+
 /**
  * NXSL class UserGroupClass: NXSL object destructor
  */
@@ -3929,50 +5532,72 @@ void NXSL_UserGroupClass::onObjectDelete(NXSL_Object *object)
 }
 
 /**
- * NXSL class NodeDependency: constructor
+ * NodeDependency::id
  */
-NXSL_NodeDependencyClass::NXSL_NodeDependencyClass() : NXSL_Class()
+NXSL_ATTRIBUTE_DEFINITION(NodeDependency, id)
 {
-   setName(_T("NodeDependency"));
+   DependentNode *dn = static_cast<DependentNode*>(object->getData());
+   return vm->createValue(dn->nodeId);
 }
 
 /**
- * NXSL class NodeDependency: get attribute
+ * NodeDependency::isAgentProxy
  */
-NXSL_Value *NXSL_NodeDependencyClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(NodeDependency, isAgentProxy)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   DependentNode *dn = static_cast<DependentNode*>(object->getData());
+   return vm->createValue((dn->dependencyType & NODE_DEP_AGENT_PROXY) != 0);
+}
 
-   NXSL_VM *vm = object->vm();
+/**
+ * NodeDependency::isDataCollectionSource
+ */
+NXSL_ATTRIBUTE_DEFINITION(NodeDependency, isDataCollectionSource)
+{
    DependentNode *dn = static_cast<DependentNode*>(object->getData());
+   return vm->createValue((dn->dependencyType & NODE_DEP_DC_SOURCE) != 0);
+}
 
-   if (compareAttributeName(attr, "id"))
-   {
-      value = vm->createValue(dn->nodeId);
-   }
-   else if (compareAttributeName(attr, "isAgentProxy"))
-   {
-      value = vm->createValue((dn->dependencyType & NODE_DEP_AGENT_PROXY) != 0);
-   }
-   else if (compareAttributeName(attr, "isDataCollectionSource"))
-   {
-      value = vm->createValue((dn->dependencyType & NODE_DEP_DC_SOURCE) != 0);
-   }
-   else if (compareAttributeName(attr, "isICMPProxy"))
-   {
-      value = vm->createValue((dn->dependencyType & NODE_DEP_ICMP_PROXY) != 0);
-   }
-   else if (compareAttributeName(attr, "isSNMPProxy"))
-   {
-      value = vm->createValue((dn->dependencyType & NODE_DEP_SNMP_PROXY) != 0);
-   }
-   else if (compareAttributeName(attr, "type"))
-   {
-      value = vm->createValue(dn->dependencyType);
-   }
-   return value;
+/**
+ * NodeDependency::isICMPProxy
+ */
+NXSL_ATTRIBUTE_DEFINITION(NodeDependency, isICMPProxy)
+{
+   DependentNode *dn = static_cast<DependentNode*>(object->getData());
+   return vm->createValue((dn->dependencyType & NODE_DEP_ICMP_PROXY) != 0);
+}
+
+/**
+ * NodeDependency::isSNMPProxy
+ */
+NXSL_ATTRIBUTE_DEFINITION(NodeDependency, isSNMPProxy)
+{
+   DependentNode *dn = static_cast<DependentNode*>(object->getData());
+   return vm->createValue((dn->dependencyType & NODE_DEP_SNMP_PROXY) != 0);
+}
+
+/**
+ * NodeDependency::type
+ */
+NXSL_ATTRIBUTE_DEFINITION(NodeDependency, type)
+{
+   DependentNode *dn = static_cast<DependentNode*>(object->getData());
+   return vm->createValue(dn->dependencyType);
+}
+
+/**
+ * NXSL class NodeDependency: constructor
+ */
+NXSL_NodeDependencyClass::NXSL_NodeDependencyClass() : NXSL_Class()
+{
+   setName(_T("NodeDependency"));
+
+   NXSL_REGISTER_ATTRIBUTE(NodeDependency, id);
+   NXSL_REGISTER_ATTRIBUTE(NodeDependency, isAgentProxy);
+   NXSL_REGISTER_ATTRIBUTE(NodeDependency, isDataCollectionSource);
+   NXSL_REGISTER_ATTRIBUTE(NodeDependency, isICMPProxy);
+   NXSL_REGISTER_ATTRIBUTE(NodeDependency, isSNMPProxy);
+   NXSL_REGISTER_ATTRIBUTE(NodeDependency, type);
 }
 
 /**
@@ -3984,52 +5609,56 @@ void NXSL_NodeDependencyClass::onObjectDelete(NXSL_Object *object)
 }
 
 /**
- * NXSL "VLAN" class
+ * Vlan::id
  */
-NXSL_VlanClass::NXSL_VlanClass()
+NXSL_ATTRIBUTE_DEFINITION(Vlan, id)
 {
-   setName(_T("VLAN"));
+   VlanInfo *vlan = static_cast<VlanInfo*>(object->getData());
+   return vm->createValue(vlan->getVlanId());
 }
 
 /**
- * NXSL "VLAN" class: get attribute
+ * Vlan::interfaces
  */
-NXSL_Value *NXSL_VlanClass::getAttr(NXSL_Object *object, const char *attr)
+NXSL_ATTRIBUTE_DEFINITION(Vlan, interfaces)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
-
-   NXSL_VM *vm = object->vm();
    VlanInfo *vlan = static_cast<VlanInfo*>(object->getData());
-
-   if (compareAttributeName(attr, "id"))
-   {
-      value = vm->createValue(vlan->getVlanId());
-   }
-   else if (compareAttributeName(attr, "interfaces"))
+   NXSL_Array *a = new NXSL_Array(vm);
+   shared_ptr<Node> node = static_pointer_cast<Node>(FindObjectById(vlan->getNodeId(), OBJECT_NODE));
+   if (node != nullptr)
    {
-      NXSL_Array *a = new NXSL_Array(vm);
-      shared_ptr<Node> node = static_pointer_cast<Node>(FindObjectById(vlan->getNodeId(), OBJECT_NODE));
-      if (node != nullptr)
+      VlanPortInfo *ports = vlan->getPorts();
+      for(int i = 0; i < vlan->getNumPorts(); i++)
       {
-         VlanPortInfo *ports = vlan->getPorts();
-         for(int i = 0; i < vlan->getNumPorts(); i++)
+         shared_ptr<Interface> iface = node->findInterfaceByIndex(ports[i].ifIndex);
+         if (iface != nullptr)
          {
-            shared_ptr<Interface> iface = node->findInterfaceByIndex(ports[i].ifIndex);
-            if (iface != nullptr)
-            {
-               a->append(iface->createNXSLObject(vm));
-            }
+            a->append(iface->createNXSLObject(vm));
          }
       }
-      value = vm->createValue(a);
-   }
-   else if (compareAttributeName(attr, "name"))
-   {
-      value = vm->createValue(vlan->getName());
    }
-   return value;
+   return vm->createValue(a);
+}
+
+/**
+ * Vlan::name
+ */
+NXSL_ATTRIBUTE_DEFINITION(Vlan, name)
+{
+   VlanInfo *vlan = static_cast<VlanInfo*>(object->getData());
+   return vm->createValue(vlan->getName());
+}
+
+/**
+ * NXSL "VLAN" class
+ */
+NXSL_VlanClass::NXSL_VlanClass()
+{
+   setName(_T("VLAN"));
+
+   NXSL_REGISTER_ATTRIBUTE(Vlan, id);
+   NXSL_REGISTER_ATTRIBUTE(Vlan, interfaces);
+   NXSL_REGISTER_ATTRIBUTE(Vlan, name);
 }
 
 /**
@@ -1086,9 +1086,8 @@ static int F_SNMPGet(int argc, NXSL_Value **argv, NXSL_Value **ppResult, NXSL_VM
    {
       if ((rspPDU->getNumVariables() > 0) && (rspPDU->getErrorCode() == SNMP_PDU_ERR_SUCCESS))
       {
-         SNMP_Variable *pVar = rspPDU->getVariable(0);
+         SNMP_Variable *pVar = rspPDU->detachVariable(0);
 		   *ppResult = vm->createValue(new NXSL_Object(vm, &g_nxslSnmpVarBindClass, pVar));
-         rspPDU->unlinkVariables();
 	   }
       else
       {
@@ -23,6 +23,13 @@
 #include "nxcore.h"
 #include <netxms-regex.h>
 
+#define DEBUG_TAG_OBJECT_INIT    _T("obj.init")
+
+/**
+ * Maximum number of database connections used for caching configuration tables on startup
+ */
+#define MAX_CACHE_LOADER_CONNECTIONS   8
+
 /**
  * Global data
  */
@@ -145,6 +152,8 @@ static THREAD_RESULT THREAD_CALL CacheLoadingThread(void *pArg)
    ThreadSetName("CacheLoader");
    DbgPrintf(1, _T("Started caching of DCI values"));
 
+   LoadDCICacheSnapshot();
+
 	UpdateDataCollectionCache(&g_idxNodeById);
 	UpdateDataCollectionCache(&g_idxClusterById);
 	UpdateDataCollectionCache(&g_idxMobileDeviceById);
@@ -152,6 +161,8 @@ static THREAD_RESULT THREAD_CALL CacheLoadingThread(void *pArg)
    UpdateDataCollectionCache(&g_idxChassisById);
    UpdateDataCollectionCache(&g_idxSensorById);
 
+   ReleaseDCICacheSnapshot();
+
    DbgPrintf(1, _T("Finished caching of DCI values"));
    return THREAD_OK;
 }
@@ -1374,6 +1385,46 @@ static void PruneCustomAttributes(NetObj *object, void *data)
    object->pruneCustomAttributes();
 }
 
+/**
+ * Helper class for logging time spent in object loading phases
+ */
+class ObjectLoadingTimer
+{
+private:
+   const TCHAR *m_phase;
+   INT64 m_phaseStartTime;
+   INT64 m_startTime;
+
+public:
+   ObjectLoadingTimer()
+   {
+      m_phase = nullptr;
+      m_startTime = GetCurrentTimeMs();
+      m_phaseStartTime = m_startTime;
+   }
+
+   void startPhase(const TCHAR *phase)
+   {
+      endPhase();
+      m_phase = phase;
+      m_phaseStartTime = GetCurrentTimeMs();
+      nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 2, _T("Loading %s..."), phase);
+   }
+
+   void endPhase()
+   {
+      if (m_phase == nullptr)
+         return;
+      nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 1, _T("Loading %s completed in ") INT64_FMT _T(" ms"), m_phase, GetCurrentTimeMs() - m_phaseStartTime);
+      m_phase = nullptr;
+   }
+
+   INT64 elapsedTime() const
+   {
+      return GetCurrentTimeMs() - m_startTime;
+   }
+};
+
 /**
  * Load objects from database at stratup
  */
@@ -1382,6 +1433,8 @@ BOOL LoadObjects()
    // Prevent objects to change it's modification flag
    g_bModificationsLocked = TRUE;
 
+   ObjectLoadingTimer timer;
+
    DB_HANDLE mainDB = DBConnectionPoolAcquireConnection();
    DB_HANDLE hdb = mainDB;
    DB_HANDLE cachedb = (g_flags & AF_CACHE_DB_ON_STARTUP) ? DBOpenInMemoryDatabase() : nullptr;
@@ -1394,72 +1447,80 @@ BOOL LoadObjects()
                                            _T("last_event_timestamp"), _T("table_id"), _T("flags"), _T("id"), _T("activation_event"),
                                            _T("deactivation_event"), _T("group_id"), _T("iface_id"), _T("vlan_id"), _T("object_id"), nullptr };
 
-      nxlog_debug(1, _T("Caching object configuration tables"));
-      bool success =
-               DBCacheTable(cachedb, mainDB, _T("object_properties"), _T("object_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("object_custom_attributes"), _T("object_id,attr_name"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("object_urls"), _T("object_id,url_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("responsible_users"), _T("object_id,user_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("nodes"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("zones"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("zone_proxies"), _T("object_id,proxy_node"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("conditions"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("cond_dci_map"), _T("condition_id,sequence_number"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("subnets"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("nsmap"), _T("subnet_id,node_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("racks"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("rack_passive_elements"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("physical_links"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("chassis"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("mobile_devices"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("sensors"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("access_points"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("interfaces"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("interface_address_list"), _T("iface_id,ip_addr"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("interface_vlan_list"), _T("iface_id,vlan_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("network_services"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("vpn_connectors"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("vpn_connector_networks"), _T("vpn_id,ip_addr"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("clusters"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("cluster_members"), _T("cluster_id,node_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("cluster_sync_subnets"), _T("cluster_id,subnet_addr"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("cluster_resources"), _T("cluster_id,resource_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("templates"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("items"), _T("item_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("thresholds"), _T("threshold_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("raw_dci_values"), _T("item_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dc_tables"), _T("item_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dc_table_columns"), _T("table_id,column_name"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_column_names"), _T("column_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_thresholds"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_threshold_conditions"), _T("threshold_id,group_id,sequence_number"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_threshold_instances"), _T("threshold_id,instance_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_node_map"), _T("template_id,node_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dci_delete_list"), _T("node_id,dci_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dci_schedules"), _T("item_id,schedule_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dci_access"), _T("dci_id,user_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("ap_common"), _T("guid"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_maps"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_map_elements"), _T("map_id,element_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_map_links"), nullptr, _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_map_seed_nodes"), _T("map_id,seed_node_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("node_components"), _T("node_id,component_index"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("object_containers"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("container_members"), _T("container_id,object_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dashboards"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dashboard_elements"), _T("dashboard_id,element_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dashboard_associations"), _T("object_id,dashboard_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("slm_checks"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("business_services"), _T("service_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("node_links"), _T("nodelink_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("acl"), _T("object_id,user_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("trusted_nodes"), _T("source_object_id,target_node_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("auto_bind_target"), _T("object_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("icmp_statistics"), _T("object_id,poll_target"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("icmp_target_address_list"), _T("node_id,ip_addr"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("software_inventory"), _T("node_id,name,version"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("hardware_inventory"), _T("node_id,category,component_index"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("versionable_object"), _T("object_id"), _T("*"));
+      static const DBCachedTableDefinition tables[] =
+      {
+         { _T("object_properties"), _T("object_id"), _T("*"), nullptr },
+         { _T("object_custom_attributes"), _T("object_id,attr_name"), _T("*"), nullptr },
+         { _T("object_urls"), _T("object_id,url_id"), _T("*"), nullptr },
+         { _T("responsible_users"), _T("object_id,user_id"), _T("*"), nullptr },
+         { _T("nodes"), _T("id"), _T("*"), nullptr },
+         { _T("zones"), _T("id"), _T("*"), nullptr },
+         { _T("zone_proxies"), _T("object_id,proxy_node"), _T("*"), nullptr },
+         { _T("conditions"), _T("id"), _T("*"), nullptr },
+         { _T("cond_dci_map"), _T("condition_id,sequence_number"), _T("*"), intColumns },
+         { _T("subnets"), _T("id"), _T("*"), nullptr },
+         { _T("nsmap"), _T("subnet_id,node_id"), _T("*"), nullptr },
+         { _T("racks"), _T("id"), _T("*"), nullptr },
+         { _T("rack_passive_elements"), _T("id"), _T("*"), nullptr },
+         { _T("physical_links"), _T("id"), _T("*"), nullptr },
+         { _T("chassis"), _T("id"), _T("*"), nullptr },
+         { _T("mobile_devices"), _T("id"), _T("*"), nullptr },
+         { _T("sensors"), _T("id"), _T("*"), nullptr },
+         { _T("access_points"), _T("id"), _T("*"), nullptr },
+         { _T("interfaces"), _T("id"), _T("*"), intColumns },
+         { _T("interface_address_list"), _T("iface_id,ip_addr"), _T("*"), intColumns },
+         { _T("interface_vlan_list"), _T("iface_id,vlan_id"), _T("*"), intColumns },
+         { _T("network_services"), _T("id"), _T("*"), nullptr },
+         { _T("vpn_connectors"), _T("id"), _T("*"), nullptr },
+         { _T("vpn_connector_networks"), _T("vpn_id,ip_addr"), _T("*"), nullptr },
+         { _T("clusters"), _T("id"), _T("*"), nullptr },
+         { _T("cluster_members"), _T("cluster_id,node_id"), _T("*"), nullptr },
+         { _T("cluster_sync_subnets"), _T("cluster_id,subnet_addr"), _T("*"), nullptr },
+         { _T("cluster_resources"), _T("cluster_id,resource_id"), _T("*"), nullptr },
+         { _T("templates"), _T("id"), _T("*"), nullptr },
+         { _T("items"), _T("item_id"), _T("*"), nullptr },
+         { _T("thresholds"), _T("threshold_id"), _T("*"), intColumns },
+         { _T("raw_dci_values"), _T("item_id"), _T("*"), intColumns },
+         { _T("dc_tables"), _T("item_id"), _T("*"), nullptr },
+         { _T("dc_table_columns"), _T("table_id,column_name"), _T("*"), intColumns },
+         { _T("dct_column_names"), _T("column_id"), _T("*"), nullptr },
+         { _T("dct_thresholds"), _T("id"), _T("*"), intColumns },
+         { _T("dct_threshold_conditions"), _T("threshold_id,group_id,sequence_number"), _T("*"), nullptr },
+         { _T("dct_threshold_instances"), _T("threshold_id,instance_id"), _T("*"), nullptr },
+         { _T("dct_node_map"), _T("template_id,node_id"), _T("*"), intColumns },
+         { _T("dci_delete_list"), _T("node_id,dci_id"), _T("*"), nullptr },
+         { _T("dci_schedules"), _T("item_id,schedule_id"), _T("*"), intColumns },
+         { _T("dci_access"), _T("dci_id,user_id"), _T("*"), intColumns },
+         { _T("ap_common"), _T("guid"), _T("*"), nullptr },
+         { _T("network_maps"), _T("id"), _T("*"), nullptr },
+         { _T("network_map_elements"), _T("map_id,element_id"), _T("*"), nullptr },
+         { _T("network_map_links"), nullptr, _T("*"), nullptr },
+         { _T("network_map_seed_nodes"), _T("map_id,seed_node_id"), _T("*"), nullptr },
+         { _T("node_components"), _T("node_id,component_index"), _T("*"), nullptr },
+         { _T("object_containers"), _T("id"), _T("*"), nullptr },
+         { _T("container_members"), _T("container_id,object_id"), _T("*"), nullptr },
+         { _T("dashboards"), _T("id"), _T("*"), nullptr },
+         { _T("dashboard_elements"), _T("dashboard_id,element_id"), _T("*"), intColumns },
+         { _T("dashboard_associations"), _T("object_id,dashboard_id"), _T("*"), nullptr },
+         { _T("slm_checks"), _T("id"), _T("*"), nullptr },
+         { _T("business_services"), _T("service_id"), _T("*"), nullptr },
+         { _T("node_links"), _T("nodelink_id"), _T("*"), nullptr },
+         { _T("acl"), _T("object_id,user_id"), _T("*"), nullptr },
+         { _T("trusted_nodes"), _T("source_object_id,target_node_id"), _T("*"), nullptr },
+         { _T("auto_bind_target"), _T("object_id"), _T("*"), nullptr },
+         { _T("icmp_statistics"), _T("object_id,poll_target"), _T("*"), intColumns },
+         { _T("icmp_target_address_list"), _T("node_id,ip_addr"), _T("*"), intColumns },
+         { _T("software_inventory"), _T("node_id,name,version"), _T("*"), nullptr },
+         { _T("hardware_inventory"), _T("node_id,category,component_index"), _T("*"), nullptr },
+         { _T("versionable_object"), _T("object_id"), _T("*"), nullptr },
+         { nullptr, nullptr, nullptr, nullptr }
+      };
+
+      nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 1, _T("Caching object configuration tables"));
+      INT64 startTime = GetCurrentTimeMs();
+      bool success = DBCacheTables(cachedb, mainDB, tables, std::min(DBConnectionPoolGetSize(), MAX_CACHE_LOADER_CONNECTIONS));
+      nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 1, _T("Object configuration tables %s in ") INT64_FMT _T(" ms"),
+               success ? _T("cached") : _T("caching failed"), GetCurrentTimeMs() - startTime);
 
       if (success)
       {
@@ -1474,7 +1535,7 @@ BOOL LoadObjects()
    }
 
    // Load built-in object properties
-   DbgPrintf(2, _T("Loading built-in object properties..."));
+   timer.startPhase(_T("built-in object properties"));
    g_entireNetwork->loadFromDatabase(hdb);
    g_infrastructureServiceRoot->loadFromDatabase(hdb);
    g_templateRoot->loadFromDatabase(hdb);
@@ -1499,7 +1560,7 @@ BOOL LoadObjects()
    // Load zones
    if (g_flags & AF_ENABLE_ZONING)
    {
-      DbgPrintf(2, _T("Loading zones..."));
+      timer.startPhase(_T("zones"));
 
       // Load (or create) default zone
       auto zone = MakeSharedNObject<Zone>();
@@ -1536,7 +1597,7 @@ BOOL LoadObjects()
    // Load conditions
    // We should load conditions before nodes because
    // DCI cache size calculation uses information from condition objects
-   DbgPrintf(2, _T("Loading conditions..."));
+   timer.startPhase(_T("conditions"));
    DB_RESULT hResult = DBSelect(hdb, _T("SELECT id FROM conditions"));
    if (hResult != nullptr)
    {
@@ -1560,7 +1621,7 @@ BOOL LoadObjects()
    g_idxConditionById.setStartupMode(false);
 
    // Load subnets
-   DbgPrintf(2, _T("Loading subnets..."));
+   timer.startPhase(_T("subnets"));
    hResult = DBSelect(hdb, _T("SELECT id FROM subnets"));
    if (hResult != nullptr)
    {
@@ -1597,7 +1658,7 @@ BOOL LoadObjects()
    g_idxSubnetById.setStartupMode(false);
 
    // Load racks
-   DbgPrintf(2, _T("Loading racks..."));
+   timer.startPhase(_T("racks"));
    hResult = DBSelect(hdb, _T("SELECT id FROM racks"));
    if (hResult != nullptr)
    {
@@ -1620,7 +1681,7 @@ BOOL LoadObjects()
    }
 
    // Load chassis
-   DbgPrintf(2, _T("Loading chassis..."));
+   timer.startPhase(_T("chassis"));
    hResult = DBSelect(hdb, _T("SELECT id FROM chassis"));
    if (hResult != nullptr)
    {
@@ -1644,7 +1705,7 @@ BOOL LoadObjects()
    g_idxChassisById.setStartupMode(false);
 
    // Load mobile devices
-   DbgPrintf(2, _T("Loading mobile devices..."));
+   timer.startPhase(_T("mobile devices"));
    hResult = DBSelect(hdb, _T("SELECT id FROM mobile_devices"));
    if (hResult != nullptr)
    {
@@ -1668,7 +1729,7 @@ BOOL LoadObjects()
    g_idxMobileDeviceById.setStartupMode(false);
 
    // Load sensors
-   DbgPrintf(2, _T("Loading sensors..."));
+   timer.startPhase(_T("sensors"));
    hResult = DBSelect(hdb, _T("SELECT id FROM sensors"));
    if (hResult != nullptr)
    {
@@ -1692,7 +1753,7 @@ BOOL LoadObjects()
    g_idxSensorById.setStartupMode(false);
 
    // Load nodes
-   DbgPrintf(2, _T("Loading nodes..."));
+   timer.startPhase(_T("nodes"));
    hResult = DBSelect(hdb, _T("SELECT id FROM nodes"));
    if (hResult != nullptr)
    {
@@ -1724,7 +1785,7 @@ BOOL LoadObjects()
    g_idxNodeById.setStartupMode(false);
 
    // Load access points
-   DbgPrintf(2, _T("Loading access points..."));
+   timer.startPhase(_T("access points"));
    hResult = DBSelect(hdb, _T("SELECT id FROM access_points"));
    if (hResult != nullptr)
    {
@@ -1748,7 +1809,7 @@ BOOL LoadObjects()
    g_idxAccessPointById.setStartupMode(false);
 
    // Load interfaces
-   DbgPrintf(2, _T("Loading interfaces..."));
+   timer.startPhase(_T("interfaces"));
    hResult = DBSelect(hdb, _T("SELECT id FROM interfaces"));
    if (hResult != nullptr)
    {
@@ -1771,7 +1832,7 @@ BOOL LoadObjects()
    }
 
    // Load network services
-   DbgPrintf(2, _T("Loading network services..."));
+   timer.startPhase(_T("network services"));
    hResult = DBSelect(hdb, _T("SELECT id FROM network_services"));
    if (hResult != nullptr)
    {
@@ -1794,7 +1855,7 @@ BOOL LoadObjects()
    }
 
    // Load VPN connectors
-   DbgPrintf(2, _T("Loading VPN connectors..."));
+   timer.startPhase(_T("VPN connectors"));
    hResult = DBSelect(hdb, _T("SELECT id FROM vpn_connectors"));
    if (hResult != nullptr)
    {
@@ -1817,7 +1878,7 @@ BOOL LoadObjects()
    }
 
    // Load clusters
-   DbgPrintf(2, _T("Loading clusters..."));
+   timer.startPhase(_T("clusters"));
    hResult = DBSelect(hdb, _T("SELECT id FROM clusters"));
    if (hResult != nullptr)
    {
@@ -1845,7 +1906,7 @@ BOOL LoadObjects()
    ThreadCreate(CacheLoadingThread, 0, nullptr);
 
    // Load templates
-   DbgPrintf(2, _T("Loading templates..."));
+   timer.startPhase(_T("templates"));
    hResult = DBSelect(hdb, _T("SELECT id FROM templates"));
    if (hResult != nullptr)
    {
@@ -1869,7 +1930,7 @@ BOOL LoadObjects()
    }
 
    // Load network maps
-   DbgPrintf(2, _T("Loading network maps..."));
+   timer.startPhase(_T("network maps"));
    hResult = DBSelect(hdb, _T("SELECT id FROM network_maps"));
    if (hResult != nullptr)
    {
@@ -1893,7 +1954,7 @@ BOOL LoadObjects()
    g_idxNetMapById.setStartupMode(false);
 
    // Load container objects
-   DbgPrintf(2, _T("Loading containers..."));
+   timer.startPhase(_T("containers"));
    TCHAR query[256];
    _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT id FROM object_containers WHERE object_class=%d"), OBJECT_CONTAINER);
    hResult = DBSelect(hdb, query);
@@ -1918,7 +1979,7 @@ BOOL LoadObjects()
    }
 
    // Load template group objects
-   DbgPrintf(2, _T("Loading template groups..."));
+   timer.startPhase(_T("template groups"));
    _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT id FROM object_containers WHERE object_class=%d"), OBJECT_TEMPLATEGROUP);
    hResult = DBSelect(hdb, query);
    if (hResult != nullptr)
@@ -1942,7 +2003,7 @@ BOOL LoadObjects()
    }
 
    // Load map group objects
-   DbgPrintf(2, _T("Loading map groups..."));
+   timer.startPhase(_T("map groups"));
    _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT id FROM object_containers WHERE object_class=%d"), OBJECT_NETWORKMAPGROUP);
    hResult = DBSelect(hdb, query);
    if (hResult != nullptr)
@@ -1966,7 +2027,7 @@ BOOL LoadObjects()
    }
 
    // Load dashboard objects
-   DbgPrintf(2, _T("Loading dashboards..."));
+   timer.startPhase(_T("dashboards"));
    hResult = DBSelect(hdb, _T("SELECT id FROM dashboards"));
    if (hResult != nullptr)
    {
@@ -1989,7 +2050,7 @@ BOOL LoadObjects()
    }
 
    // Load dashboard group objects
-   DbgPrintf(2, _T("Loading dashboard groups..."));
+   timer.startPhase(_T("dashboard groups"));
    _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT id FROM object_containers WHERE object_class=%d"), OBJECT_DASHBOARDGROUP);
    hResult = DBSelect(hdb, query);
    if (hResult != nullptr)
@@ -2013,7 +2074,7 @@ BOOL LoadObjects()
    }
 
    // Loading business service objects
-   DbgPrintf(2, _T("Loading business services..."));
+   timer.startPhase(_T("business services"));
    _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT id FROM object_containers WHERE object_class=%d"), OBJECT_BUSINESSSERVICE);
    hResult = DBSelect(hdb, query);
    if (hResult != nullptr)
@@ -2037,7 +2098,7 @@ BOOL LoadObjects()
    }
 
    // Loading business service objects
-   DbgPrintf(2, _T("Loading node links..."));
+   timer.startPhase(_T("node links"));
    _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("SELECT id FROM object_containers WHERE object_class=%d"), OBJECT_NODELINK);
    hResult = DBSelect(hdb, query);
    if (hResult != nullptr)
@@ -2061,7 +2122,7 @@ BOOL LoadObjects()
    }
 
    // Load service check objects
-   DbgPrintf(2, _T("Loading service checks..."));
+   timer.startPhase(_T("service checks"));
    hResult = DBSelect(hdb, _T("SELECT id FROM slm_checks"));
    if (hResult != nullptr)
    {
@@ -2087,14 +2148,16 @@ BOOL LoadObjects()
    g_idxServiceCheckById.setStartupMode(false);
 
 	// Load custom object classes provided by modules
+   timer.startPhase(_T("module objects"));
    CALL_ALL_MODULES(pfLoadObjects, ());
 
    // Link children to container and template group objects
-   DbgPrintf(2, _T("Linking objects..."));
+   timer.startPhase(_T("object links"));
 	g_idxObjectById.forEach(LinkObjects, nullptr);
 
 	// Link custom object classes provided by modules
    CALL_ALL_MODULES(pfLinkObjects, ());
+   timer.endPhase();
 
    // Allow objects to change it's modification flag
    g_bModificationsLocked = FALSE;
@@ -2129,6 +2192,7 @@ BOOL LoadObjects()
    if (cachedb != nullptr)
       DBCloseInMemoryDatabase(cachedb);
 
+   nxlog_write_tag(NXLOG_INFO, DEBUG_TAG_OBJECT_INIT, _T("%d objects loaded in ") INT64_FMT _T(" ms"), static_cast<int>(g_idxObjectById.size()), timer.elapsedTime());
    return TRUE;
 }
 
@@ -223,10 +223,8 @@ bool Sensor::loadFromDatabase(DB_HANDLE hdb, UINT32 id)
 
    // Load DCI and access list
    loadACLFromDB(hdb);
-   loadItemsFromDB(hdb);
-   for(int i = 0; i < m_dcObjects->size(); i++)
-      if (!m_dcObjects->get(i)->loadThresholdsFromDB(hdb))
-         return false;
+   if (!loadItemsFromDB(hdb))
+      return false;
    loadDCIListForCleanup(hdb);
 
    return true;
@@ -4189,6 +4189,58 @@ static DB_STATEMENT PrepareDataSelect(DB_HANDLE hdb, UINT32 nodeId, int dciType,
 	return DBPrepare(hdb, query);
 }
 
+/**
+ * Get downsampled collected data for simple DCI. Values are always sent as floating point numbers.
+ */
+bool ClientSession::getDownsampledCollectedData(NXCPMessage *request, NXCPMessage *response, DCItem *dci, time_t timeFrom, time_t timeTo)
+{
+   uint32_t targetPoints = request->getFieldAsUInt32(VID_TARGET_POINT_COUNT);
+   if (targetPoints > MAX_DCI_DATA_RECORDS)
+      targetPoints = MAX_DCI_DATA_RECORDS;
+   DownsamplingMethod method = static_cast<DownsamplingMethod>(request->getFieldAsUInt16(VID_DOWNSAMPLING_METHOD));
+   if ((method < DCI_DOWNSAMPLE_AVG) || (method > DCI_DOWNSAMPLE_LTTB))
+   {
+      response->setField(VID_RCC, RCC_INVALID_ARGUMENT);
+      return false;
+   }
+
+   debugPrintf(7, _T("getDownsampledCollectedData: DCI %s [%u], target point count %u, method %d"), dci->getName().cstr(), dci->getId(), targetPoints, method);
+
+   StructArray<DataPoint> points(0, 1024);
+   if (!GetDownsampledDCIData(dci, timeFrom, timeTo, targetPoints, method, &points))
+   {
+      response->setField(VID_RCC, RCC_DB_FAILURE);
+      return false;
+   }
+
+   // Send CMD_REQUEST_COMPLETED message
+   response->setField(VID_RCC, RCC_SUCCESS);
+   dci->fillMessageWithThresholds(response, false);
+   sendMessage(response);
+
+   size_t dataSize = points.size() * 16 + sizeof(DCI_DATA_HEADER);
+   DCI_DATA_HEADER *pData = static_cast<DCI_DATA_HEADER*>(MemAlloc(dataSize));
+   pData->dataType = htonl(DCI_DT_FLOAT);
+   pData->dciId = htonl(dci->getId());
+   pData->numRows = htonl(points.size());
+
+   DCI_DATA_ROW *pCurr = reinterpret_cast<DCI_DATA_ROW*>(reinterpret_cast<char*>(pData) + sizeof(DCI_DATA_HEADER));
+   for(int i = 0; i < points.size(); i++)
+   {
+      DataPoint *p = points.get(i);
+      pCurr->timeStamp = htonl(static_cast<UINT32>(p->timestamp));
+      pCurr->value.ext.v64.real = htond(p->value);
+      pCurr = reinterpret_cast<DCI_DATA_ROW*>(reinterpret_cast<char*>(pCurr) + 16);
+   }
+
+   // Prepare and send raw message with fetched data
+   NXCP_MESSAGE *msg = CreateRawNXCPMessage(CMD_DCI_DATA, request->getId(), 0, pData, dataSize, nullptr, isCompressionEnabled());
+   MemFree(pData);
+   sendRawMessage(msg);
+   MemFree(msg);
+   return true;
+}
+
 /**
  * Get collected data for table or simple DCI
  */
@@ -4366,6 +4418,13 @@ bool ClientSession::getCollectedDataFromDB(NXCPMessage *request, NXCPMessage *re
 	}
 
 read_from_db:
+   // Downsampled history requested
+   if ((dciType == DCO_TYPE_ITEM) && (historicalDataType == DCO_TYPE_PROCESSED) && (timeFrom != 0) &&
+       (static_cast<DCItem*>(dci.get())->getDataType() != DCI_DT_STRING) && (request->getFieldAsUInt32(VID_TARGET_POINT_COUNT) > 0))
+   {
+      return getDownsampledCollectedData(request, response, static_cast<DCItem*>(dci.get()), timeFrom, (timeTo != 0) ? timeTo : time(nullptr));
+   }
+
    debugPrintf(7, _T("getCollectedDataFromDB: will read from database (maxRows = %d)"), maxRows);
 
 	TCHAR condition[256] = _T("");
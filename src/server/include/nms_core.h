@@ -575,6 +575,7 @@ class NXCORE_EXPORTABLE ClientSession
    void getCollectedData(NXCPMessage *pRequest);
    void getTableCollectedData(NXCPMessage *pRequest);
 	bool getCollectedDataFromDB(NXCPMessage *request, NXCPMessage *response, const DataCollectionTarget& object, int dciType, HistoricalDataType historicalDataType);
+   bool getDownsampledCollectedData(NXCPMessage *request, NXCPMessage *response, DCItem *dci, time_t timeFrom, time_t timeTo);
 	void clearDCIData(NXCPMessage *pRequest);
 	void deleteDCIEntry(NXCPMessage *request);
 	void forceDCIPoll(NXCPMessage *pRequest);
@@ -23,6 +23,8 @@
 #ifndef _nms_dcoll_h_
 #define _nms_dcoll_h_
 
+#include "nxcore_downsample.h"
+
 /**
  * Max. length for prediction engine name
  */
@@ -117,10 +119,60 @@ class NXCORE_EXPORTABLE ItemValue
    const ItemValue& operator=(UINT64 value);
 };
 
-
 class DCItem;
 class DataCollectionTarget;
 
+/**
+ * Numeric value in threshold sample window
+ */
+union ThresholdWindowValue
+{
+   INT32 i32;
+   UINT32 u32;
+   INT64 i64;
+   UINT64 u64;
+   double d;
+};
+
+/**
+ * Sliding window of last N values used for threshold function calculation. Keeps values
+ * already converted to DCI data type and running sum for integer types, so that new sample
+ * is added in O(1). Window is validated against DCI value cache on each update and rebuilt
+ * from cache if they diverge (cache reload, entry deletion, etc.).
+ */
+class ThresholdWindow
+{
+private:
+   ThresholdWindowValue *m_values;  // Ring buffer, newest value at m_head
+   int m_size;
+   int m_head;
+   BYTE m_dataType;
+   bool m_valid;
+   ThresholdWindowValue m_sum;      // Running sum (integer types only)
+   const ItemValue *m_newest;       // Cache entry expected at position 0 on next update
+   time_t m_newestTimestamp;
+   const ItemValue *m_tail;         // Cache entry expected at position N - 2 on next update
+   time_t m_tailTimestamp;
+
+   const ThresholdWindowValue& at(int index) const { return m_values[(m_head + index) % m_size]; }
+   void set(int index, const ItemValue& value);
+   void push(const ItemValue& value);
+   void rebuild(const ItemValue& value, ItemValue **prevValues);
+
+public:
+   ThresholdWindow(int size, BYTE dataType);
+   ThresholdWindow(const ThresholdWindow *src);
+   ~ThresholdWindow();
+
+   int getSize() const { return m_size; }
+   BYTE getDataType() const { return m_dataType; }
+
+   void update(const ItemValue& value, ItemValue **prevValues);
+   void sum(ItemValue *result) const;
+   void average(ItemValue *result) const;
+   void meanDeviation(ItemValue *result) const;
+};
+
 /**
  * Threshold definition class
  */
@@ -148,11 +200,10 @@ class NXCORE_EXPORTABLE Threshold
 	int m_numMatches;			// Number of consecutive matches
 	int m_repeatInterval;		// -1 = default, 0 = off, >0 = seconds between repeats
 	time_t m_lastEventTimestamp;
+   ThresholdWindow *m_window;   // Sample window for average, sum and deviation functions
 
    const ItemValue& value() { return m_value; }
-   void calculateAverageValue(ItemValue *pResult, ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateSumValue(ItemValue *pResult, ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateMDValue(ItemValue *pResult, ItemValue &lastValue, ItemValue **ppPrevValues);
+   ThresholdWindow *updateWindow(ItemValue &lastValue, ItemValue **ppPrevValues);
    void calculateDiff(ItemValue *pResult, ItemValue &lastValue, ItemValue **ppPrevValues);
    void setScript(TCHAR *script);
 
@@ -242,6 +293,40 @@ enum DCObjectRetentionType
    DC_RETENTION_NONE = 2
 };
 
+/**
+ * Result set from DCI related table loaded in bulk for all DCIs of single owner.
+ * Result must be ordered by DCI ID column.
+ */
+class DCObjectRowSet
+{
+private:
+   DB_RESULT m_hResult;
+   int m_idColumn;
+   int m_rowCount;
+
+public:
+   DCObjectRowSet(DB_RESULT hResult, int idColumn);
+   ~DCObjectRowSet();
+
+   bool isValid() const { return m_hResult != nullptr; }
+   DB_RESULT getResult() const { return m_hResult; }
+   int find(uint32_t id, int *count) const;
+};
+
+/**
+ * Data loaded in bulk for all DCIs of single data collection owner
+ */
+class DCObjectBulkData
+{
+public:
+   DCObjectRowSet rawValues;
+   DCObjectRowSet thresholds;
+   DCObjectRowSet accessLists;
+   DCObjectRowSet schedules;
+
+   DCObjectBulkData(DB_HANDLE hdb, uint32_t ownerId);
+};
+
 #ifdef _WIN32
 template class NXCORE_EXPORTABLE weak_ptr<DataCollectionOwner>;
 #endif
@@ -305,8 +390,8 @@ class NXCORE_EXPORTABLE DCObject
    bool tryLock() const { return MutexTryLock(m_hMutex); }
    void unlock() const { MutexUnlock(m_hMutex); }
 
-   bool loadAccessList(DB_HANDLE hdb);
-	bool loadCustomSchedules(DB_HANDLE hdb);
+   bool loadAccessList(DB_HANDLE hdb, const DCObjectBulkData *bulkData = nullptr);
+	bool loadCustomSchedules(DB_HANDLE hdb, const DCObjectBulkData *bulkData = nullptr);
 	String expandSchedule(const TCHAR *schedule);
 
    void updateTimeIntervalsInternal();
@@ -338,7 +423,7 @@ class NXCORE_EXPORTABLE DCObject
 
    virtual bool saveToDatabase(DB_HANDLE hdb);
    virtual void deleteFromDatabase();
-   virtual bool loadThresholdsFromDB(DB_HANDLE hdb);
+   virtual bool loadThresholdsFromDB(DB_HANDLE hdb, const DCObjectBulkData *bulkData = nullptr);
 
    virtual bool processNewValue(time_t nTimeStamp, void *value, bool *updateStatus);
    void processNewError(bool noInstance);
@@ -475,7 +560,7 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
 
 public:
    DCItem(const DCItem *src, bool shadowCopy);
-   DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay);
+   DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay, const DCObjectBulkData *bulkData = nullptr);
    DCItem(UINT32 id, const TCHAR *name, int source, int dataType, const TCHAR *pollingInterval, const TCHAR *retentionTime,
             const shared_ptr<DataCollectionOwner>& owner, const TCHAR *description = nullptr, const TCHAR *systemTag = nullptr);
 	DCItem(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& owner);
@@ -490,10 +575,11 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
 
    virtual bool saveToDatabase(DB_HANDLE hdb) override;
    virtual void deleteFromDatabase() override;
-   virtual bool loadThresholdsFromDB(DB_HANDLE hdb) override;
+   virtual bool loadThresholdsFromDB(DB_HANDLE hdb, const DCObjectBulkData *bulkData = nullptr) override;
 
    void updateCacheSize(UINT32 conditionId = 0) { lock(); updateCacheSizeInternal(true, conditionId); unlock(); }
    void reloadCache(bool forceReload);
+   bool saveCacheSnapshot(ByteStream *s);
 
    int getDataType() const { return m_dataType; }
    int getNXSLDataType() const;
@@ -519,6 +605,7 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
    const TCHAR *getLastValue();
    ItemValue *getInternalLastValue();
    TCHAR *getAggregateValue(AggregationFunction func, time_t periodStart, time_t periodEnd);
+   bool getCachedValues(time_t periodStart, time_t periodEnd, StructArray<DataPoint> *values);
 
    virtual void createMessage(NXCPMessage *msg) override;
    void updateFromMessage(const NXCPMessage& msg, uint32_t *numMaps, uint32_t **mapIndex, uint32_t **mapId);
@@ -744,7 +831,7 @@ class NXCORE_EXPORTABLE DCTable : public DCObject
    DCTable(const DCTable *src, bool shadowCopy);
    DCTable(UINT32 id, const TCHAR *name, int source, const TCHAR *pollingInterval, const TCHAR *retentionTime,
             const shared_ptr<DataCollectionOwner>& owner, const TCHAR *description = nullptr, const TCHAR *systemTag = nullptr);
-   DCTable(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay);
+   DCTable(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataCollectionOwner>& owner, bool useStartupDelay, const DCObjectBulkData *bulkData = nullptr);
    DCTable(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& owner);
 	virtual ~DCTable();
 
@@ -877,6 +964,14 @@ DataCollectionError GetQueueStatistic(const TCHAR *parameter, StatisticType type
 
 UINT64 GetDCICacheMemoryUsage();
 
+void LoadDCICacheSnapshot();
+void ReleaseDCICacheSnapshot();
+void SaveDCICacheSnapshot();
+ItemValue **ReadDCICacheSnapshot(uint32_t dciId, uint32_t ownerId, uint32_t count, time_t lastValueTimestamp);
+void WriteDCICacheSnapshotEntry(ByteStream *s, uint32_t dciId, uint32_t ownerId, ItemValue * const *values, uint32_t count);
+
+bool GetDownsampledDCIData(DCItem *dci, time_t periodStart, time_t periodEnd, uint32_t targetPoints, DownsamplingMethod method, StructArray<DataPoint> *points);
+
 /**
  * DCI cache loader queue
  */
@@ -349,11 +349,25 @@ class EventPolicy
 struct EventProcessingThreadStats
 {
    uint64_t processedEvents;
+   uint64_t dispatchedEvents;
+   uint64_t bindingAssignments;
    uint32_t averageWaitTime;
    uint32_t queueSize;
    uint32_t bindings;
 };
 
+/**
+ * Stats for event log writer
+ */
+struct EventLogWriterStats
+{
+   uint64_t eventsWritten;
+   uint64_t transactions;
+   uint32_t averageWriteTime;
+   uint32_t queueSize;
+   uint32_t maxQueueSize;
+};
+
 /**
  * Functions
  */
@@ -369,6 +383,7 @@ void CorrelateEvent(Event *event);
 Event *LoadEventFromDatabase(uint64_t eventId);
 Event *FindEventInLoggerQueue(uint64_t eventId);
 StructArray<EventProcessingThreadStats> *GetEventProcessingThreadStats();
+void GetEventLogWriterStats(EventLogWriterStats *stats);
 
 bool EventNameFromCode(UINT32 eventCode, TCHAR *buffer);
 UINT32 NXCORE_EXPORTABLE EventCodeFromName(const TCHAR *name, UINT32 defaultValue = 0);
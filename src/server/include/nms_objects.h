@@ -1241,7 +1241,7 @@ class NXCORE_EXPORTABLE DataCollectionOwner : public NetObj
    virtual void onDataCollectionLoad() { }
    virtual void onDataCollectionChange() { }
 
-   void loadItemsFromDB(DB_HANDLE hdb);
+   bool loadItemsFromDB(DB_HANDLE hdb);
    void destroyItems();
    void updateInstanceDiscoveryItems(DCObject *dci);
 
@@ -2039,6 +2039,7 @@ class NXCORE_EXPORTABLE DataCollectionTarget : public DataCollectionOwner
    double getProxyLoadFactor() const { return GetAttributeWithLock(m_proxyLoadFactor, m_mutexProperties); }
 
    void updateDciCache();
+   int saveDciCacheSnapshot(ByteStream *s);
    void updateDCItemCacheSize(UINT32 dciId, UINT32 conditionId = 0);
    void reloadDCItemCache(UINT32 dciId);
    void cleanDCIData(DB_HANDLE hdb);
@@ -3797,6 +3798,8 @@ class NXCORE_EXPORTABLE ConditionObject : public NetObj
 
    virtual json_t *toJson() override;
 
+   virtual void prepareForDeletion() override;
+
    void lockForPoll();
    void doPoll(PollerInfo *poller);
    void check();
@@ -4299,6 +4302,11 @@ void NXCORE_EXPORTABLE MacDbRemove(const BYTE *macAddr);
 void NXCORE_EXPORTABLE MacDbRemove(const MacAddress& macAddr);
 shared_ptr<NetObj> NXCORE_EXPORTABLE MacDbFind(const BYTE *macAddr);
 shared_ptr<NetObj> NXCORE_EXPORTABLE MacDbFind(const MacAddress& macAddr);
+void MacDbUpdateSwitchPorts(uint32_t nodeId, ForwardingDatabase *fdb);
+void MacDbRemoveSwitchPorts(uint32_t nodeId);
+int MacDbFindSwitchPorts(const BYTE *macAddr, StructArray<MacPortLocation> *locations);
+
+uint32_t GetConditionCacheSizeForDCI(uint32_t dciId, uint32_t conditionId);
 
 shared_ptr<NetObj> NXCORE_EXPORTABLE FindObjectById(uint32_t id, int objClass = -1);
 shared_ptr<NetObj> NXCORE_EXPORTABLE FindObjectByName(const TCHAR *name, int objClass = -1);
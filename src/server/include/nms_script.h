@@ -43,8 +43,6 @@ class NXSL_SubnetClass : public NXSL_NetObjClass
 {
 public:
    NXSL_SubnetClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -54,8 +52,6 @@ class NXSL_DCTargetClass : public NXSL_NetObjClass
 {
 public:
    NXSL_DCTargetClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -65,8 +61,6 @@ class NXSL_NodeClass : public NXSL_DCTargetClass
 {
 public:
    NXSL_NodeClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -76,8 +70,6 @@ class NXSL_InterfaceClass : public NXSL_NetObjClass
 {
 public:
    NXSL_InterfaceClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -87,8 +79,6 @@ class NXSL_AccessPointClass : public NXSL_DCTargetClass
 {
 public:
    NXSL_AccessPointClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -98,8 +88,6 @@ class NXSL_MobileDeviceClass : public NXSL_DCTargetClass
 {
 public:
    NXSL_MobileDeviceClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -109,8 +97,6 @@ class NXSL_ChassisClass : public NXSL_DCTargetClass
 {
 public:
    NXSL_ChassisClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -120,8 +106,6 @@ class NXSL_ClusterClass : public NXSL_DCTargetClass
 {
 public:
    NXSL_ClusterClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -131,8 +115,6 @@ class NXSL_ContainerClass : public NXSL_NetObjClass
 {
 public:
    NXSL_ContainerClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -142,8 +124,6 @@ class NXSL_TemplateClass : public NXSL_NetObjClass
 {
 public:
    NXSL_TemplateClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -153,8 +133,6 @@ class NXSL_ZoneClass : public NXSL_NetObjClass
 {
 public:
    NXSL_ZoneClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -164,8 +142,6 @@ class NXSL_SensorClass : public NXSL_DCTargetClass
 {
 public:
    NXSL_SensorClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -189,7 +165,6 @@ class NXSL_AlarmClass : public NXSL_Class
 public:
    NXSL_AlarmClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -201,7 +176,6 @@ class NXSL_AlarmCommentClass : public NXSL_Class
 public:
    NXSL_AlarmCommentClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -225,7 +199,6 @@ class NXSL_SNMPTransportClass : public NXSL_Class
 public:
    NXSL_SNMPTransportClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -237,7 +210,6 @@ class NXSL_SNMPVarBindClass : public NXSL_Class
 public:
    NXSL_SNMPVarBindClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -249,7 +221,6 @@ class NXSL_NodeDependencyClass : public NXSL_Class
 public:
    NXSL_NodeDependencyClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -295,8 +266,6 @@ class NXSL_UserDBObjectClass : public NXSL_Class
 {
 public:
    NXSL_UserDBObjectClass();
-
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
 };
 
 /**
@@ -307,7 +276,6 @@ class NXSL_UserClass : public NXSL_UserDBObjectClass
 public:
    NXSL_UserClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -319,7 +287,6 @@ class NXSL_UserGroupClass : public NXSL_UserDBObjectClass
 public:
    NXSL_UserGroupClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -331,7 +298,6 @@ class NXSL_VlanClass : public NXSL_Class
 public:
    NXSL_VlanClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
 
@@ -343,7 +309,6 @@ class NXSL_TunnelClass : public NXSL_Class
 public:
    NXSL_TunnelClass();
 
-   virtual NXSL_Value *getAttr(NXSL_Object *object, const char *attr) override;
    virtual void onObjectCreate(NXSL_Object *object) override;
    virtual void onObjectDelete(NXSL_Object *object) override;
 };
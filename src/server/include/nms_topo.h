@@ -104,6 +104,17 @@ struct FDB_ENTRY
 	uint16_t type;
 };
 
+/**
+ * Location of MAC address on switch port (used by switch port index)
+ */
+struct MacPortLocation
+{
+   uint32_t nodeId;
+   uint32_t ifIndex;
+   int macCountOnPort;
+   bool isStatic;
+};
+
 /**
  * FDB port mapping entry
  */
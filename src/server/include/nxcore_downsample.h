@@ -0,0 +1,199 @@
+/*
+** NetXMS - Network Management System
+** Copyright (C) 2003-2020 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation; either version 2 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: nxcore_downsample.h
+**
+**/
+
+#ifndef _nxcore_downsample_h_
+#define _nxcore_downsample_h_
+
+#include <nms_util.h>
+#include <nxcldefs.h>
+#include <math.h>
+
+/**
+ * Single point of DCI history (used for downsampling)
+ */
+struct DataPoint
+{
+   time_t timestamp;
+   double value;
+};
+
+/**
+ * Calculate bucket size for downsampling given period into given number of points. Buckets are
+ * counted from period start, so with this size index of last bucket is always below targetPoints.
+ */
+static inline time_t GetDownsampleBucketSize(time_t periodStart, time_t periodEnd, uint32_t targetPoints)
+{
+   return (periodEnd - periodStart) / targetPoints + 1;
+}
+
+/**
+ * Get index of bucket for given timestamp (buckets are counted from period start)
+ */
+static inline INT64 GetDownsampleBucketIndex(time_t timestamp, time_t periodStart, time_t bucketSize)
+{
+   return static_cast<INT64>(timestamp - periodStart) / bucketSize;
+}
+
+/**
+ * Streaming bucket aggregator. Expects points ordered by timestamp (in any direction)
+ * and produces one point per bucket. Buckets are aligned to given origin (start of requested period).
+ */
+class BucketAggregator
+{
+private:
+   time_t m_origin;
+   time_t m_bucketSize;
+   DownsamplingMethod m_method;
+   StructArray<DataPoint> *m_output;
+   INT64 m_bucket;
+   double m_min;
+   double m_max;
+   double m_sum;
+   int m_count;
+
+   void emit()
+   {
+      if (m_count == 0)
+         return;
+
+      DataPoint p;
+      p.timestamp = m_origin + static_cast<time_t>(m_bucket * m_bucketSize);
+      switch(m_method)
+      {
+         case DCI_DOWNSAMPLE_MIN:
+            p.value = m_min;
+            break;
+         case DCI_DOWNSAMPLE_MAX:
+            p.value = m_max;
+            break;
+         default:
+            p.value = m_sum / m_count;
+            break;
+      }
+      m_output->add(p);
+   }
+
+public:
+   BucketAggregator(time_t origin, time_t bucketSize, DownsamplingMethod method, StructArray<DataPoint> *output)
+   {
+      m_origin = origin;
+      m_bucketSize = bucketSize;
+      m_method = method;
+      m_output = output;
+      m_bucket = 0;
+      m_min = 0;
+      m_max = 0;
+      m_sum = 0;
+      m_count = 0;
+   }
+
+   void add(time_t timestamp, double value)
+   {
+      INT64 bucket = GetDownsampleBucketIndex(timestamp, m_origin, m_bucketSize);
+      if ((bucket != m_bucket) || (m_count == 0))
+      {
+         emit();
+         m_bucket = bucket;
+         m_min = value;
+         m_max = value;
+         m_sum = value;
+         m_count = 1;
+      }
+      else
+      {
+         if (value < m_min)
+            m_min = value;
+         if (value > m_max)
+            m_max = value;
+         m_sum += value;
+         m_count++;
+      }
+   }
+
+   void finish()
+   {
+      emit();
+      m_count = 0;
+   }
+};
+
+/**
+ * Select points using Largest Triangle Three Buckets algorithm. Input points should be ordered
+ * by timestamp in ascending order. Selected points are added to output in same order.
+ */
+static inline void SelectPointsLTTB(const StructArray<DataPoint>& input, uint32_t threshold, StructArray<DataPoint> *output)
+{
+   int size = input.size();
+   if ((threshold >= static_cast<uint32_t>(size)) || (threshold < 3))
+   {
+      for(int i = 0; i < size; i++)
+         output->add(input.get(i));
+      return;
+   }
+
+   const DataPoint *data = input.getBuffer();
+   double every = static_cast<double>(size - 2) / (threshold - 2);
+
+   int a = 0;
+   output->add(data[a]);
+   for(uint32_t i = 0; i < threshold - 2; i++)
+   {
+      // Average point in next bucket
+      int avgStart = static_cast<int>((i + 1) * every) + 1;
+      int avgEnd = std::min(static_cast<int>((i + 2) * every) + 1, size);
+      double avgX = 0, avgY = 0;
+      for(int j = avgStart; j < avgEnd; j++)
+      {
+         avgX += static_cast<double>(data[j].timestamp);
+         avgY += data[j].value;
+      }
+      int avgCount = avgEnd - avgStart;
+      if (avgCount > 0)
+      {
+         avgX /= avgCount;
+         avgY /= avgCount;
+      }
+
+      // Point in current bucket which forms largest triangle with previously selected point and average of next bucket
+      int rangeStart = static_cast<int>(i * every) + 1;
+      int rangeEnd = static_cast<int>((i + 1) * every) + 1;
+      double ax = static_cast<double>(data[a].timestamp);
+      double ay = data[a].value;
+      double maxArea = -1;
+      int selected = rangeStart;
+      for(int j = rangeStart; j < rangeEnd; j++)
+      {
+         double area = fabs((ax - avgX) * (data[j].value - ay) - (ax - static_cast<double>(data[j].timestamp)) * (avgY - ay));
+         if (area > maxArea)
+         {
+            maxArea = area;
+            selected = j;
+         }
+      }
+
+      output->add(data[selected]);
+      a = selected;
+   }
+   output->add(data[size - 1]);
+}
+
+#endif
@@ -367,7 +367,17 @@ void AgentConnectionReceiver::run()
                case CMD_DCI_DATA:
                   if (g_agentConnectionThreadPool != nullptr)
                   {
-                     ThreadPoolExecute(g_agentConnectionThreadPool, connection, &AgentConnection::processCollectedDataCallback, msg);
+                     if (msg->getFieldAsBoolean(VID_BULK_RECONCILIATION))
+                     {
+                        // Agent may pipeline several bulk data messages, process them in order
+                        TCHAR key[64];
+                        _sntprintf(key, 64, _T("BulkData_%p"), this);
+                        ThreadPoolExecuteSerialized(g_agentConnectionThreadPool, key, connection, &AgentConnection::processCollectedDataCallback, msg);
+                     }
+                     else
+                     {
+                        ThreadPoolExecute(g_agentConnectionThreadPool, connection, &AgentConnection::processCollectedDataCallback, msg);
+                     }
                   }
                   else
                   {
@@ -1185,6 +1195,7 @@ UINT32 AgentConnection::setServerCapabilities()
    msg.setField(VID_ENABLED, (INT16)1);   // Enables IPv6 on pre-2.0 agents
    msg.setField(VID_IPV6_SUPPORT, (INT16)1);
    msg.setField(VID_BULK_RECONCILIATION, (INT16)1);
+   msg.setField(VID_BULK_DATA_PUSH, (INT16)1);
    msg.setField(VID_ENABLE_COMPRESSION, (INT16)(m_allowCompression ? 1 : 0));
    msg.setId(dwRqId);
    if (!sendMessage(&msg))
@@ -24,50 +24,55 @@
 #include <math.h>
 
 /**
- * Node constructor
+ * Get random initial weight
  */
-NeuralNetworkNode::NeuralNetworkNode(int nextLevelSize)
+static inline double RandomWeight()
 {
-   numWeights = nextLevelSize;
-   weights = new double[nextLevelSize];
-   weightGradients = new double[nextLevelSize];
-   for(int i = 0; i < nextLevelSize; i++)
-      weights[i] = static_cast<double>(rand()) / RAND_MAX * (0.001 - 0.0001) + 0.0001;
-   bias = static_cast<double>(rand()) / RAND_MAX * (0.001 - 0.0001) + 0.0001;
-   biasGradient = 0.0;
-   value = 0.0;
+   return static_cast<double>(rand()) / RAND_MAX * (0.001 - 0.0001) + 0.0001;
 }
 
 /**
- * Node destructor
+ * Allocate memory block for weights and work buffers. All arrays are aligned on 32 byte boundary.
  */
-NeuralNetworkNode::~NeuralNetworkNode()
+void NeuralNetwork::allocate(int inputCount, int hiddenCount)
 {
-   delete[] weights;
-   delete[] weightGradients;
+   m_inputCount = inputCount;
+   m_hiddenCount = hiddenCount;
+   m_stride = (inputCount + 3) & ~3;
+   int hiddenStride = (hiddenCount + 3) & ~3;
+   m_memory = MemAllocArray<double>(hiddenCount * m_stride + hiddenStride * 3 + 4);
+   double *p = reinterpret_cast<double*>((reinterpret_cast<uintptr_t>(m_memory) + 31) & ~static_cast<uintptr_t>(31));
+   m_ihWeights = p;
+   m_hiddenBiases = m_ihWeights + hiddenCount * m_stride;
+   m_hoWeights = m_hiddenBiases + hiddenStride;
+   m_hiddenValues = m_hoWeights + hiddenStride;
+   m_mutex = MutexCreate();
 }
 
 /**
- * Reset node before training
+ * Constructor
  */
-void NeuralNetworkNode::reset()
+NeuralNetwork::NeuralNetwork(int inputCount, int hiddenCount)
 {
-   for(int i = 0; i < numWeights; i++)
-      weightGradients[i] = 0.0;
-   biasGradient = 0.0;
+   allocate(inputCount, hiddenCount);
+   for(int i = 0; i < hiddenCount; i++)
+   {
+      double *w = &m_ihWeights[i * m_stride];
+      for(int j = 0; j < inputCount; j++)
+         w[j] = RandomWeight();
+      m_hiddenBiases[i] = RandomWeight();
+      m_hoWeights[i] = RandomWeight();
+   }
+   m_outputBias = RandomWeight();
 }
 
 /**
- * Constructor
+ * Create copy of another network (weights only)
  */
-NeuralNetwork::NeuralNetwork(int inputCount, int hiddenCount) :
-      m_input(inputCount, 8, Ownership::True), m_hidden(hiddenCount, 8, Ownership::True), m_output(1)
+NeuralNetwork::NeuralNetwork(const NeuralNetwork *src)
 {
-   for(int i = 0; i < inputCount; i++)
-      m_input.add(new NeuralNetworkNode(hiddenCount));
-   for(int i = 0; i < hiddenCount; i++)
-      m_hidden.add(new NeuralNetworkNode(1));
-   m_mutex = MutexCreate();
+   allocate(src->m_inputCount, src->m_hiddenCount);
+   copyWeights(src);
 }
 
 /**
@@ -75,38 +80,51 @@ NeuralNetwork::NeuralNetwork(int inputCount, int hiddenCount) :
  */
 NeuralNetwork::~NeuralNetwork()
 {
+   MemFree(m_memory);
    MutexDestroy(m_mutex);
 }
 
 /**
- * Compute output value
+ * Copy weights from another network with same topology
  */
-double NeuralNetwork::computeOutput(double *inputs)
+void NeuralNetwork::copyWeights(const NeuralNetwork *src)
 {
-   for(int i = 0; i < m_input.size(); i++)
-      m_input.get(i)->value = inputs[i];
+   if ((src->m_inputCount != m_inputCount) || (src->m_hiddenCount != m_hiddenCount))
+      return;
+   memcpy(m_ihWeights, src->m_ihWeights, sizeof(double) * m_hiddenCount * m_stride);
+   memcpy(m_hiddenBiases, src->m_hiddenBiases, sizeof(double) * m_hiddenCount);
+   memcpy(m_hoWeights, src->m_hoWeights, sizeof(double) * m_hiddenCount);
+   m_outputBias = src->m_outputBias;
+}
 
-   double os = 0.0;
-   for(int i = 0; i < m_hidden.size(); i++)
+/**
+ * Forward pass - calculate hidden layer values and network output
+ */
+double NeuralNetwork::forward(const double *inputs, double *hiddenValues) const
+{
+   double os = m_outputBias;
+   for(int i = 0; i < m_hiddenCount; i++)
    {
-      double s = 0.0;
-      for(int j = 0; j < m_input.size(); j++)   // compute i-h sum of weights * inputs
-      {
-         s += inputs[j] + m_input.get(j)->weights[i];
-      }
-      s += m_hidden.get(i)->bias;
+      const double *w = &m_ihWeights[i * m_stride];
+      double s = m_hiddenBiases[i];
+      for(int j = 0; j < m_inputCount; j++)   // compute i-h sum of weights * inputs
+         s += inputs[j] * w[j];
 
       double v = tanh(s);
-      m_hidden.get(i)->value = v;
-
-      os += v * m_hidden.get(i)->weights[0]; // update h-o sum of weights * hidden
+      hiddenValues[i] = v;
+      os += v * m_hoWeights[i]; // update h-o sum of weights * hidden
    }
-
-   os += m_output.bias; // add bias to output sum
-   m_output.value = os;
    return os;
 }
 
+/**
+ * Compute output value
+ */
+double NeuralNetwork::computeOutput(const double *inputs)
+{
+   return forward(inputs, m_hiddenValues);
+}
+
 /**
  * Shuffle array
  */
@@ -115,107 +133,113 @@ static void Shuffle(int *data, int size)
    for(int i = 0; i < size - 1; i++)
    {
       int idx = i + rand() % (size - i);
-      int t = data[idx];
+      int t = data[i];
       data[i] = data[idx];
       data[idx] = t;
    }
 }
 
 /**
- * Train network using given data series
+ * Train network using given data series. Each training sample is a window of input count
+ * consecutive values with next value as target. Gradients are accumulated over mini-batch
+ * of given size and applied once per batch. Training stops after given number of rounds or
+ * when time limit (in milliseconds, 0 for unlimited) is reached.
  */
-void NeuralNetwork::train(double *series, size_t length, int rounds, double learnRate)
+NeuralNetworkTrainingStats NeuralNetwork::train(const double *series, size_t length, int rounds, double learnRate, int batchSize, uint32_t timeLimit)
 {
-   if (length <= m_input.size())
-      return;  // Series is too short
-
-   // Prepare training data
-   int blockCount = static_cast<int>(length) - m_input.size();
-   int blockSize = m_input.size() + 1;
-   double **trainData = new double*[blockCount];
-   int idx = 0;
-   for(int i = 0; i < blockCount; i++)
-   {
-      trainData[i] = new double[blockSize];
-      memcpy(trainData[i], &series[idx++], sizeof(double) * blockSize);
-   }
-
-   double *hSignals = new double[m_hidden.size()];
-
-   for(int i = 0; i < m_input.size(); i++)
-      m_input.get(i)->reset();
-   for(int i = 0; i < m_hidden.size(); i++)
-      m_hidden.get(i)->reset();
-   m_output.reset();
+   NeuralNetworkTrainingStats stats;
+   stats.rounds = 0;
+   stats.error = 0;
+   stats.timeLimitHit = false;
+
+   if (length <= static_cast<size_t>(m_inputCount))
+      return stats;  // Series is too short
+
+   int sampleCount = static_cast<int>(length) - m_inputCount;
+   if (batchSize < 1)
+      batchSize = 1;
+
+   // Gradient and work buffers
+   int hiddenStride = (m_hiddenCount + 3) & ~3;
+   size_t ihSize = m_hiddenCount * m_stride;
+   double *buffer = MemAllocArrayNoInit<double>(ihSize + hiddenStride * 4);
+   double *ihGradients = buffer;
+   double *hbGradients = ihGradients + ihSize;
+   double *hoGradients = hbGradients + hiddenStride;
+   double *hValues = hoGradients + hiddenStride;
+   double *hSignals = hValues + hiddenStride;
 
    // Processing sequence
-   int *sequence = new int[blockCount];
-   for(int i = 0; i < blockCount; i++)
+   int *sequence = MemAllocArrayNoInit<int>(sampleCount);
+   for(int i = 0; i < sampleCount; i++)
       sequence[i] = i;
 
+   int64_t startTime = GetCurrentTimeMs();
    while(rounds-- > 0)
    {
-      Shuffle(sequence, blockCount); // visit each block in random order
-      for(int i = 0; i < blockCount; i++)
-      {
-         double *block = trainData[sequence[i]];
-         double target = block[m_input.size()];
-         computeOutput(block);
-
-         // 1. compute output node signal
-         double errorSignal = target - m_output.value;
+      Shuffle(sequence, sampleCount); // visit each sample in random order
 
-         // 2. compute hidden-to-output weight gradients using output signals
-         for(int j = 0; j < m_hidden.size(); j++)
-            m_hidden.get(j)->weightGradients[0] = errorSignal * m_hidden.get(j)->value;
+      double errorSum = 0;
+      for(int batchStart = 0; batchStart < sampleCount; batchStart += batchSize)
+      {
+         int batchEnd = std::min(batchStart + batchSize, sampleCount);
 
-         // 3. compute output bias gradients using output signals
-         m_output.biasGradient = errorSignal;
+         memset(ihGradients, 0, sizeof(double) * ihSize);
+         memset(hbGradients, 0, sizeof(double) * m_hiddenCount);
+         memset(hoGradients, 0, sizeof(double) * m_hiddenCount);
+         double obGradient = 0;
 
-         // 4. compute hidden node signals
-         for(int j = 0; j < m_hidden.size(); j++)
+         for(int n = batchStart; n < batchEnd; n++)
          {
-            NeuralNetworkNode *n = m_hidden.get(j);
-            double derivative = (1 + n->value) * (1 - n->value);
-            hSignals[j] = derivative * n->weights[0];
+            const double *inputs = &series[sequence[n]];
+            double target = inputs[m_inputCount];
+            double output = forward(inputs, hValues);
+
+            // Output node signal
+            double errorSignal = target - output;
+            errorSum += errorSignal * errorSignal;
+            obGradient += errorSignal;
+
+            // Hidden-to-output weight gradients and hidden node signals
+            for(int i = 0; i < m_hiddenCount; i++)
+            {
+               hoGradients[i] += errorSignal * hValues[i];
+               hSignals[i] = (1 + hValues[i]) * (1 - hValues[i]) * m_hoWeights[i] * errorSignal;
+               hbGradients[i] += hSignals[i];
+            }
+
+            // Input-to-hidden weight gradients
+            for(int i = 0; i < m_hiddenCount; i++)
+            {
+               double *g = &ihGradients[i * m_stride];
+               double signal = hSignals[i];
+               for(int j = 0; j < m_inputCount; j++)
+                  g[j] += signal * inputs[j];
+            }
          }
 
-         // 5. compute input-hidden weight gradients
-         for(int j = 0; j < m_input.size(); j++)
-         {
-            NeuralNetworkNode *n = m_input.get(j);
-            for(int k = 0; k < m_hidden.size(); k++)
-               n->weightGradients[k] = hSignals[k] * n->value;
-         }
-
-         // 6. compute hidden node bias gradients
-         for(int j = 0; j < m_hidden.size(); j++)
-            m_hidden.get(j)->biasGradient = hSignals[j];
-
-         // 7. update input-to-hidden weights
-         for(int j = 0; j < m_input.size(); j++)
+         // Update weights and biases (padding elements of input-to-hidden matrix have zero gradient)
+         for(size_t i = 0; i < ihSize; i++)
+            m_ihWeights[i] += ihGradients[i] * learnRate;
+         for(int i = 0; i < m_hiddenCount; i++)
          {
-            NeuralNetworkNode *n = m_input.get(j);
-            for(int k = 0; k < m_hidden.size(); k++)
-               n->weights[k] += n->weightGradients[k] * learnRate;
+            m_hiddenBiases[i] += hbGradients[i] * learnRate;
+            m_hoWeights[i] += hoGradients[i] * learnRate;
          }
+         m_outputBias += obGradient * learnRate;
+      }
 
-         // 8. update hidden biases and hidden-to-output weights
-         for(int j = 0; j < m_hidden.size(); j++)
-         {
-            NeuralNetworkNode *n = m_hidden.get(j);
-            n->bias += n->biasGradient * learnRate;
-            n->weights[0] += n->weightGradients[0] * learnRate;
-         }
+      stats.rounds++;
+      stats.error = errorSum / sampleCount;
 
-         // 9. update output node bias
-         m_output.bias += m_output.biasGradient * learnRate;
+      if ((timeLimit > 0) && (rounds > 0) && (GetCurrentTimeMs() - startTime >= timeLimit))
+      {
+         stats.timeLimitHit = true;
+         break;
       }
    }
 
-   delete[] hSignals;
-   delete[] sequence;
-   for(int i = 0; i < blockCount; i++)
-      delete[] trainData[i];
-   delete[] trainData;
+   MemFree(sequence);
+   MemFree(buffer);
+   return stats;
 }
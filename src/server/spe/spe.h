@@ -31,40 +31,49 @@
 #include <npe.h>
 
 /**
- * Neural network node
+ * Neural network training statistics
  */
-struct NeuralNetworkNode
+struct NeuralNetworkTrainingStats
 {
-   int numWeights;
-   double *weights;
-   double *weightGradients;
-   double bias;
-   double biasGradient;
-   double value;
-
-   NeuralNetworkNode(int nextLevelSize);
-   ~NeuralNetworkNode();
-
-   void reset();
+   int rounds;          // Completed training rounds
+   double error;        // Mean squared error on last round
+   bool timeLimitHit;   // Training stopped because of time limit
 };
 
 /**
- * Neural network class
+ * Neural network with one hidden layer. All weights are stored in single contiguous
+ * block as flat arrays (input-to-hidden weights as matrix with one row per hidden node,
+ * each row padded to multiple of 4 values), so forward and backward passes are simple
+ * linear loops which compiler can vectorize.
  */
 class NeuralNetwork
 {
 private:
-   ObjectArray<NeuralNetworkNode> m_input;
-   ObjectArray<NeuralNetworkNode> m_hidden;
-   NeuralNetworkNode m_output;
+   int m_inputCount;
+   int m_hiddenCount;
+   int m_stride;              // Row size of input-to-hidden weight matrix
+   double *m_memory;          // Block holding all weights and work buffers
+   double *m_ihWeights;       // Input-to-hidden weights [hidden][stride]
+   double *m_hiddenBiases;
+   double *m_hoWeights;       // Hidden-to-output weights
+   double *m_hiddenValues;
+   double m_outputBias;
    MUTEX m_mutex;
 
+   void allocate(int inputCount, int hiddenCount);
+   double forward(const double *inputs, double *hiddenValues) const;
+
 public:
    NeuralNetwork(int inputCount, int hiddenCount);
+   NeuralNetwork(const NeuralNetwork *src);
    ~NeuralNetwork();
 
-   double computeOutput(double *inputs);
-   void train(double *series, size_t length, int rounds, double learnRate);
+   double computeOutput(const double *inputs);
+   NeuralNetworkTrainingStats train(const double *series, size_t length, int rounds, double learnRate, int batchSize, uint32_t timeLimit);
+   void copyWeights(const NeuralNetwork *src);
+
+   int getInputCount() const { return m_inputCount; }
+   int getHiddenCount() const { return m_hiddenCount; }
 
    void lock() { MutexLock(m_mutex); }
    void unlock() { MutexUnlock(m_mutex); }
@@ -78,8 +87,9 @@ class TimeSeriesRegressionEngine : public PredictionEngine
 private:
    StringObjectMap<NeuralNetwork> m_networks;
    MUTEX m_networkLock;
+   uint32_t m_trainingTimeLimit;    // Training time limit per DCI in milliseconds
 
-   NeuralNetwork *acquireNetwork(UINT32 nodeId, UINT32 dciId);
+   NeuralNetwork *acquireNetwork(UINT32 nodeId, UINT32 dciId, bool create = true);
 
 public:
    TimeSeriesRegressionEngine();
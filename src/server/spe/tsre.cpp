@@ -26,12 +26,16 @@
 
 #define INPUT_LAYER_SIZE   5
 
+#define TRAINING_ROUNDS       10000
+#define TRAINING_BATCH_SIZE   8
+
 /**
  * Constructor
  */
 TimeSeriesRegressionEngine::TimeSeriesRegressionEngine() : PredictionEngine(), m_networks(Ownership::True)
 {
    m_networkLock = MutexCreate();
+   m_trainingTimeLimit = 0;
 }
 
 /**
@@ -82,6 +86,8 @@ const TCHAR *TimeSeriesRegressionEngine::getVendor() const
  */
 bool TimeSeriesRegressionEngine::initialize(TCHAR *errorMessage)
 {
+   m_trainingTimeLimit = ConfigReadULong(_T("PredictionEngine.TSR.TrainingTimeLimit"), 60) * 1000;
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("Training time limit set to %u milliseconds per DCI"), m_trainingTimeLimit);
    return true;
 }
 
@@ -111,13 +117,33 @@ void TimeSeriesRegressionEngine::train(UINT32 nodeId, UINT32 dciId, DCObjectStor
       double *series = new double[values->size()];
       for(int i = 0, j = values->size(); i < values->size(); i++)
          series[--j] = values->get(i)->value;
+
+      // Train copy of the network so it remains available for predictions during training
       NeuralNetwork *nn = acquireNetwork(nodeId, dciId);
-      nn->train(series, values->size(), 10000, 0.01);
+      NeuralNetwork *model = new NeuralNetwork(nn);
       nn->unlock();
+
+      int64_t startTime = GetCurrentTimeMs();
+      NeuralNetworkTrainingStats stats = model->train(series, values->size(), TRAINING_ROUNDS, 0.01, TRAINING_BATCH_SIZE, m_trainingTimeLimit);
+      uint32_t elapsedTime = static_cast<uint32_t>(GetCurrentTimeMs() - startTime);
+
+      nn = acquireNetwork(nodeId, dciId, false);  // Network could be reset while training
+      if (nn != NULL)
+      {
+         nn->copyWeights(model);
+         nn->unlock();
+      }
+      delete model;
       delete[] series;
+
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("Training completed for DCI %u/%u (%d samples, %d rounds%s, error %f, %u ms)"),
+               nodeId, dciId, values->size(), stats.rounds, stats.timeLimitHit ? _T(", time limit reached") : _T(""), stats.error, elapsedTime);
+   }
+   else
+   {
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("Not enough data for training DCI %u/%u"), nodeId, dciId);
    }
    delete values;
-   nxlog_debug_tag(DEBUG_TAG, 5, _T("Training completed for DCI %u/%u"), nodeId, dciId);
 }
 
 /**
@@ -238,20 +264,22 @@ int TimeSeriesRegressionEngine::getRequiredCacheSize() const
 
 /**
  * Acquire neural network object. Caller must unlock acquired object when done.
+ * If create is false and network does not exist NULL is returned.
  */
-NeuralNetwork *TimeSeriesRegressionEngine::acquireNetwork(UINT32 nodeId, UINT32 dciId)
+NeuralNetwork *TimeSeriesRegressionEngine::acquireNetwork(UINT32 nodeId, UINT32 dciId, bool create)
 {
    TCHAR nid[64];
    _sntprintf(nid, 64, _T("%u/%u"), nodeId, dciId);
 
    MutexLock(m_networkLock);
    NeuralNetwork *nn = m_networks.get(nid);
-   if (nn == NULL)
+   if ((nn == NULL) && create)
    {
       nn = new NeuralNetwork(INPUT_LAYER_SIZE, 10);
       m_networks.set(nid, nn);
    }
-   nn->lock();
+   if (nn != NULL)
+      nn->lock();
    MutexUnlock(m_networkLock);
 
    return nn;
@@ -23,6 +23,19 @@
 #include "nxdbmgr.h"
 #include <nxevent.h>
 
+/**
+ * Upgrade form 40.11 to 40.12
+ */
+static bool H_UpgradeFromV11()
+{
+   CHK_EXEC(CreateConfigParam(_T("Housekeeper.LogCleanup.BatchDelay"), _T("100"), _T("Delay between batches when deleting expired log records (in milliseconds)."), _T("ms"), 'I', true, false, false, false));
+   CHK_EXEC(CreateConfigParam(_T("Housekeeper.LogCleanup.BatchSize"), _T("10000"), _T("Number of expired log records deleted in single batch. Set to 0 to delete all expired records with single query."), nullptr, 'I', true, false, false, false));
+   CHK_EXEC(CreateConfigParam(_T("Housekeeper.LogPartitions.PrecreateDays"), _T("7"), _T("Number of days ahead for which partitions of partitioned log tables are created."), _T("days"), 'I', true, false, false, false));
+   CHK_EXEC(CreateConfigParam(_T("PredictionEngine.TSR.TrainingTimeLimit"), _T("60"), _T("Time limit for training time series regression model for single DCI (in seconds)."), _T("seconds"), 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(12));
+   return true;
+}
+
 /**
  * Upgrade form 40.10 to 40.11
  */
@@ -336,6 +349,7 @@ static struct
    bool (*upgradeProc)();
 } s_dbUpgradeMap[] =
 {
+   { 11, 40, 12, H_UpgradeFromV11 },
    { 10, 40, 11, H_UpgradeFromV10 },
    { 9,  40, 10, H_UpgradeFromV9  },
    { 8,  40, 9,  H_UpgradeFromV8  },
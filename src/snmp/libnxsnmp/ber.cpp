@@ -24,50 +24,94 @@
 #include "libnxsnmp.h"
 
 /**
- * Decode BER-encoded variable
+ * Decode identifier and length of BER-encoded variable. Only checks that header itself fits
+ * into given raw data, content may be incomplete (used for pre-parsing of partially received PDUs).
  */
-bool BER_DecodeIdentifier(const BYTE *rawData, size_t rawSize, uint32_t *type, size_t *dataLength, const BYTE **data, size_t *idLength)
+bool BER_DecodeHeader(const BYTE *rawData, size_t rawSize, uint32_t *type, size_t *dataLength, const BYTE **data, size_t *idLength)
 {
-   bool bResult = false;
-   const BYTE *pbCurrPos = rawData;
-   uint32_t dwIdLength = 0;
+   if (rawSize < 2)
+      return false;
 
+   const BYTE *pbCurrPos = rawData;
    *type = (uint32_t)(*pbCurrPos);
    pbCurrPos++;
-   dwIdLength++;
 
    // Get length
    if ((*pbCurrPos & 0x80) == 0)
    {
       *dataLength = (size_t)(*pbCurrPos);
       pbCurrPos++;
-      dwIdLength++;
-      bResult = true;
    }
    else
    {
-      uint32_t length = 0;
       int numBytes = *pbCurrPos & 0x7F;
       pbCurrPos++;
-      dwIdLength++;
-      BYTE *temp = ((BYTE *)&length) + (4 - numBytes);
-      if ((numBytes >= 1) && (numBytes <= 4))
+      if ((numBytes < 1) || (numBytes > 4) || (rawSize < static_cast<size_t>(numBytes) + 2))
+         return false;
+
+      uint32_t length = 0;
+      while(numBytes > 0)
       {
-         while(numBytes > 0)
-         {
-            *temp++ = *pbCurrPos++;
-            dwIdLength++;
-            numBytes--;
-         }
-         *dataLength = (size_t)ntohl(length);
-         bResult = true;
+         length = (length << 8) | *pbCurrPos++;
+         numBytes--;
       }
+      *dataLength = (size_t)length;
    }
 
    // Set pointer to variable's data
    *data = pbCurrPos;
-   *idLength = dwIdLength;
-   return bResult;
+   *idLength = pbCurrPos - rawData;
+   return true;
+}
+
+/**
+ * Decode BER-encoded variable. Fails if identifier or content does not fit into given raw data.
+ */
+bool BER_DecodeIdentifier(const BYTE *rawData, size_t rawSize, uint32_t *type, size_t *dataLength, const BYTE **data, size_t *idLength)
+{
+   if (!BER_DecodeHeader(rawData, rawSize, type, dataLength, data, idLength))
+      return false;
+   return *dataLength <= rawSize - *idLength;
+}
+
+/**
+ * Decode BER-encoded object identifier into provided buffer. Buffer should be large enough
+ * to hold (length + 1) elements. Returns number of decoded OID elements.
+ */
+size_t BER_DecodeOID(const BYTE *data, size_t length, uint32_t *buffer)
+{
+   if (length == 0)
+      return 0;
+
+   // First octet need special handling
+   buffer[0] = *data / 40;
+   buffer[1] = *data % 40;
+   data++;
+   length--;
+   size_t count = 2;
+
+   // Parse remaining octets
+   while(length > 0)
+   {
+      uint32_t value = 0;
+
+      // Loop through octets with 8th bit set to 1
+      while((length > 0) && (*data & 0x80))
+      {
+         value = (value << 7) | (*data & 0x7F);
+         data++;
+         length--;
+      }
+
+      // Last octet in element
+      if (length > 0)
+      {
+         buffer[count++] = (value << 7) | *data;
+         data++;
+         length--;
+      }
+   }
+   return count;
 }
 
 /**
@@ -144,35 +188,7 @@ bool BER_DecodeContent(uint32_t type, const BYTE *data, size_t length, BYTE *buf
          {
             SNMP_OID *oid = reinterpret_cast<SNMP_OID*>(buffer);
             oid->value = MemAllocArrayNoInit<uint32_t>(length + 1);
-
-            // First octet need special handling
-            oid->value[0] = *data / 40;
-            oid->value[1] = *data % 40;
-            data++;
-            oid->length = 2;
-            length--;
-
-            // Parse remaining octets
-            while(length > 0)
-            {
-               uint32_t value = 0;
-
-               // Loop through octets with 8th bit set to 1
-               while((*data & 0x80) && (length > 0))
-               {
-                  value = (value << 7) | (*data & 0x7F);
-                  data++;
-                  length--;
-               }
-
-               // Last octet in element
-               if (length > 0)
-               {
-                  oid->value[oid->length++] = (value << 7) | *data;
-                  data++;
-                  length--;
-               }
-            }
+            oid->length = static_cast<uint32_t>(BER_DecodeOID(data, length, oid->value));
          }
          break;
       default:    // For unknown types, simply move content to buffer
@@ -183,13 +199,35 @@ bool BER_DecodeContent(uint32_t type, const BYTE *data, size_t length, BYTE *buf
 }
 
 /**
- * Encode content
+ * Encode unsigned integer in network byte order with minimal number of bytes, adding leading
+ * zero byte if most significant bit is set. If result is NULL, only calculates encoded size.
+ */
+static inline size_t EncodeUnsigned(const BYTE *value, size_t size, BYTE *pResult)
+{
+   size_t nBytes;
+   for(nBytes = size; (*value == 0) && (nBytes > 1); value++, nBytes--);
+   if (*value & 0x80)
+   {
+      if (pResult != nullptr)
+      {
+         pResult[0] = 0;
+         memcpy(&pResult[1], value, nBytes);
+      }
+      return nBytes + 1;
+   }
+   if (pResult != nullptr)
+      memcpy(pResult, value, nBytes);
+   return nBytes;
+}
+
+/**
+ * Encode content. If pResult is NULL, only calculates size of encoded content.
  */
-static size_t EncodeContent(UINT32 type, const BYTE *data, size_t dataLength, BYTE *pResult)
+static size_t EncodeContent(uint32_t type, const BYTE *data, size_t dataLength, BYTE *pResult)
 {
    size_t nBytes = 0;
-   UINT32 dwTemp;
-   QWORD qwTemp;
+   uint32_t dwTemp;
+   uint64_t qwTemp;
    BYTE *pTemp, sign;
    size_t oidLength;
 
@@ -198,17 +236,20 @@ static size_t EncodeContent(UINT32 type, const BYTE *data, size_t dataLength, BY
       case ASN_NULL:
          break;
       case ASN_INTEGER:
-         dwTemp = htonl(*((UINT32 *)data));
+         dwTemp = htonl(*((uint32_t *)data));
          pTemp = (BYTE *)&dwTemp;
          sign = (*pTemp & 0x80) ? 0xFF : 0;
          for(nBytes = 4; (*pTemp == sign) && (nBytes > 1); pTemp++, nBytes--);
          if ((*pTemp & 0x80) != (sign & 0x80))
          {
-            memcpy(&pResult[1], pTemp, nBytes);
-            pResult[0] = sign;
+            if (pResult != nullptr)
+            {
+               memcpy(&pResult[1], pTemp, nBytes);
+               pResult[0] = sign;
+            }
             nBytes++;
          }
-         else
+         else if (pResult != nullptr)
          {
             memcpy(pResult, pTemp, nBytes);
          }
@@ -217,64 +258,47 @@ static size_t EncodeContent(UINT32 type, const BYTE *data, size_t dataLength, BY
       case ASN_GAUGE32:
       case ASN_TIMETICKS:
       case ASN_UINTEGER32:
-         dwTemp = htonl(*((UINT32 *)data));
-         pTemp = (BYTE *)&dwTemp;
-         for(nBytes = 4; (*pTemp == 0) && (nBytes > 1); pTemp++, nBytes--);
-         if (*pTemp & 0x80)
-         {
-            memcpy(&pResult[1], pTemp, nBytes);
-            pResult[0] = 0;
-            nBytes++;
-         }
-         else
-         {
-            memcpy(pResult, pTemp, nBytes);
-         }
+         dwTemp = htonl(*((uint32_t *)data));
+         nBytes = EncodeUnsigned((BYTE *)&dwTemp, 4, pResult);
          break;
       case ASN_COUNTER64:
-         qwTemp = htonq(*((QWORD *)data));
-         pTemp = (BYTE *)&qwTemp;
-         for(nBytes = 8; (*pTemp == 0) && (nBytes > 1); pTemp++, nBytes--);
-         if (*pTemp & 0x80)
-         {
-            memcpy(&pResult[1], pTemp, nBytes);
-            pResult[0] = 0;
-            nBytes++;
-         }
-         else
-         {
-            memcpy(pResult, pTemp, nBytes);
-         }
+         qwTemp = htonq(*((uint64_t *)data));
+         nBytes = EncodeUnsigned((BYTE *)&qwTemp, 8, pResult);
          break;
       case ASN_OBJECT_ID:
-         oidLength = dataLength / sizeof(UINT32);
+         oidLength = dataLength / sizeof(uint32_t);
          if (oidLength > 1)
          {
             BYTE *pbCurrPos = pResult;
-            UINT32 j, dwValue, dwSize, *pdwCurrId = (UINT32 *)data;
-            static UINT32 dwLengthMask[5] = { 0x0000007F, 0x00003FFF, 0x001FFFFF, 0x0FFFFFFF, 0xFFFFFFFF };
+            const uint32_t *pdwCurrId = (const uint32_t *)data;
+            static uint32_t dwLengthMask[5] = { 0x0000007F, 0x00003FFF, 0x001FFFFF, 0x0FFFFFFF, 0xFFFFFFFF };
 
             // First two ids encoded in one byte
-            *pbCurrPos = (BYTE)pdwCurrId[0] * 40 + (BYTE)pdwCurrId[1];
-            pbCurrPos++;
+            if (pbCurrPos != nullptr)
+               *pbCurrPos++ = (BYTE)pdwCurrId[0] * 40 + (BYTE)pdwCurrId[1];
             pdwCurrId += 2;
             nBytes++;
 
             // Encode other ids
             for(size_t i = 2; i < oidLength; i++, pdwCurrId++)
             {
-               dwValue = *pdwCurrId;
+               uint32_t dwValue = *pdwCurrId;
 
                // Determine size of oid
+               uint32_t dwSize;
                for(dwSize = 0; (dwLengthMask[dwSize] & dwValue) != dwValue; dwSize++);
                dwSize++;   // Size is at least one byte...
+               nBytes += dwSize;
+
+               if (pbCurrPos == nullptr)
+                  continue;
 
                if (dwSize > 1)
                {
                   // Encode by 7 bits
                   pbCurrPos += (dwSize - 1);
                   *pbCurrPos-- = (BYTE)(dwValue & 0x7F);
-                  for(j = dwSize - 1; j > 0; j--)
+                  for(uint32_t j = dwSize - 1; j > 0; j--)
                   {
                      dwValue >>= 7;
                      *pbCurrPos-- = (BYTE)(dwValue & 0x7F) | 0x80;
@@ -285,17 +309,17 @@ static size_t EncodeContent(UINT32 type, const BYTE *data, size_t dataLength, BY
                {
                   *pbCurrPos++ = (BYTE)(dwValue & 0x7F);
                }
-               nBytes += dwSize;
             }
          }
-			else if (oidLength == 1)
-			{
-				*pResult = (BYTE)(*((UINT32 *)data)) * 40;
-				nBytes++;
-			}
+         else if (oidLength == 1)
+         {
+            if (pResult != nullptr)
+               *pResult = (BYTE)(*((uint32_t *)data)) * 40;
+            nBytes++;
+         }
          break;
       default:
-         if (dataLength > 0)
+         if ((dataLength > 0) && (pResult != nullptr))
             memcpy(pResult, data, dataLength);
          nBytes = dataLength;
          break;
@@ -304,67 +328,61 @@ static size_t EncodeContent(UINT32 type, const BYTE *data, size_t dataLength, BY
 }
 
 /**
- * Encode identifier and content
- * Return value is size of encoded identifier and content in buffer
- * or 0 if there are not enough place in buffer or type is unknown
+ * Encode identifier and length for content of given size.
+ * If buffer is NULL, only calculates header size.
+ * Return value is size of encoded header or 0 if there are not enough place in buffer.
  */
-size_t BER_Encode(UINT32 type, const BYTE *data, size_t dataLength, BYTE *buffer, size_t bufferSize)
+size_t BER_EncodeHeader(uint32_t type, size_t contentLength, BYTE *buffer, size_t bufferSize)
 {
-   if (bufferSize < 2)
-      return 0;
-
-   size_t bytes = 0;
-   BYTE *pbCurrPos = buffer;
-
-   *pbCurrPos++ = (BYTE)type;
-   bytes++;
+   size_t lengthBytes;
+   if (contentLength < 128)
+      lengthBytes = 0;
+   else if (contentLength < 0x100)
+      lengthBytes = 1;
+   else if (contentLength < 0x10000)
+      lengthBytes = 2;
+   else if (contentLength < 0x1000000)
+      lengthBytes = 3;
+   else
+      lengthBytes = 4;
 
-   // Encode content
-   BYTE *pEncodedData = static_cast<BYTE*>(SNMP_MemAlloc(dataLength));
-   size_t nDataBytes = EncodeContent(type, data, dataLength, pEncodedData);
+   size_t bytes = lengthBytes + 2;
+   if (buffer == nullptr)
+      return bytes;
+   if (bufferSize < bytes)
+      return 0;
 
-   // Encode length
-   if (nDataBytes < 128)
+   buffer[0] = (BYTE)type;
+   if (lengthBytes == 0)
    {
-      *pbCurrPos++ = (BYTE)nDataBytes;
-      bytes++;
+      buffer[1] = (BYTE)contentLength;
    }
    else
    {
-      BYTE bLength[8];
-      LONG nHdrBytes;
-      int i;
-
-      *((UINT32 *)bLength) = htonl((UINT32)nDataBytes);
-      for(i = 0, nHdrBytes = 4; (bLength[i] == 0) && (nHdrBytes > 1); i++, nHdrBytes--);
-      if (i > 0)
-         memmove(bLength, &bLength[i], nHdrBytes);
-
-      // Check for available buffer size
-      if (bufferSize < (UINT32)nHdrBytes + bytes + 1)
+      buffer[1] = (BYTE)(0x80 | lengthBytes);
+      for(size_t i = lengthBytes + 1; i > 1; i--)
       {
-         SNMP_MemFree(pEncodedData, dataLength);
-         return 0;
+         buffer[i] = (BYTE)(contentLength & 0xFF);
+         contentLength >>= 8;
       }
-
-      // Write length field
-      *pbCurrPos++ = (BYTE)(0x80 | nHdrBytes);
-      memcpy(pbCurrPos, bLength, nHdrBytes);
-      pbCurrPos += nHdrBytes;
-      bytes += nHdrBytes + 1;
    }
-
-   // Copy encoded data to buffer
-   if (bufferSize >= bytes + nDataBytes)
-   {
-      memcpy(pbCurrPos, pEncodedData, nDataBytes);
-      bytes += nDataBytes;
-   }
-   else
-   {
-      bytes = 0;   // Buffer is too small
-   }
-
-   SNMP_MemFree(pEncodedData, dataLength);
    return bytes;
 }
+
+/**
+ * Encode identifier and content directly into given buffer.
+ * If buffer is NULL, only calculates size of encoded identifier and content.
+ * Return value is size of encoded identifier and content in buffer
+ * or 0 if there are not enough place in buffer or type is unknown
+ */
+size_t BER_Encode(uint32_t type, const BYTE *data, size_t dataLength, BYTE *buffer, size_t bufferSize)
+{
+   size_t contentSize = EncodeContent(type, data, dataLength, nullptr);
+   size_t headerSize = BER_EncodeHeader(type, contentSize, buffer, bufferSize);
+   if (buffer == nullptr)
+      return headerSize + contentSize;
+   if ((headerSize == 0) || (bufferSize < headerSize + contentSize))
+      return 0;   // Buffer is too small
+   EncodeContent(type, data, dataLength, buffer + headerSize);
+   return headerSize + contentSize;
+}
@@ -77,6 +77,45 @@ typedef struct
  */
 #define MIB_FILE_MAGIC     "NXMIB "
 #define MIB_FILE_VERSION   2
+#define MIB_FILE_VERSION_INDEXED   3
+
+/**
+ * Index header for compiled MIB file in indexed format (follows file header).
+ * All offsets are from file start, all numbers are in network byte order.
+ */
+struct SNMP_MIB_INDEX_HEADER
+{
+   uint32_t nodeCount;
+   uint32_t nodesOffset;
+   uint32_t nameIndexOffset;   // Node indexes sorted by name
+   uint32_t stringsOffset;     // Names and textual conventions (UTF-8, zero terminated)
+   uint32_t stringsSize;
+   uint32_t descriptionsOffset;
+   uint32_t descriptionsSize;
+   uint32_t reserved;
+};
+
+/**
+ * Node in compiled MIB file in indexed format. Nodes are stored in breadth-first order,
+ * so children of each node occupy continuous range sorted by OID.
+ */
+struct SNMP_MIB_INDEX_NODE
+{
+   uint32_t oid;
+   uint32_t parent;
+   uint32_t firstChild;
+   uint32_t childCount;
+   uint32_t name;                // Offset in string table
+   uint32_t textualConvention;   // Offset in string table (0 if not set)
+   uint32_t description;         // Offset in description table (0 if not set)
+   uint32_t reserved;
+   BYTE type;
+   BYTE status;
+   BYTE access;
+   BYTE padding;
+};
+
+uint32_t SaveIndexedMIBTree(FILE *file, SNMP_MIBObject *root, uint32_t flags);
 
 /**
  * Tags for compiled MIB file
@@ -136,8 +175,11 @@ class ZFile
 /**
  * Functions
  */
+bool BER_DecodeHeader(const BYTE *rawData, size_t rawSize, uint32_t *type, size_t *length, const BYTE **data, size_t *idLength);
 bool BER_DecodeIdentifier(const BYTE *rawData, size_t rawSize, uint32_t *type, size_t *length, const BYTE **data, size_t *idLength);
 bool BER_DecodeContent(uint32_t type, const BYTE *data, size_t length, BYTE *buffer);
+size_t BER_DecodeOID(const BYTE *data, size_t length, uint32_t *buffer);
 size_t BER_Encode(uint32_t type, const BYTE *data, size_t dataLength, BYTE *buffer, size_t bufferSize);
+size_t BER_EncodeHeader(uint32_t type, size_t contentLength, BYTE *buffer, size_t bufferSize);
 
 #endif   /* _libnxsnmp_h_ */
@@ -23,6 +23,11 @@
 
 #include "libnxsnmp.h"
 
+/**
+ * Lock for lazy loading of index backed MIB objects
+ */
+static Mutex s_indexLoadLock(true);
+
 /**
  * Default constructor for SNMP_MIBObject
  */
@@ -83,6 +88,38 @@ void SNMP_MIBObject::Initialize()
    m_pPrev = NULL;
    m_pFirst = NULL;
    m_pLast = NULL;
+   m_index = nullptr;
+   m_indexNode = 0;
+   m_children = nullptr;
+   m_childrenLoaded = false;
+   m_descriptionLoaded = false;
+}
+
+/**
+ * Construct object backed by node in MIB index. Children and description are loaded on demand.
+ */
+SNMP_MIBObject::SNMP_MIBObject(SNMP_MIBIndex *index, uint32_t node)
+{
+   Initialize();
+
+   m_index = index;
+   m_indexNode = node;
+   const char *name = index->getNameUTF8(node);
+   m_dwOID = index->getObjectId(node);
+   m_pszName = (*name != 0) ? TStringFromUTF8String(name) : NULL;
+   m_pszDescription = NULL;
+   m_pszTextualConvention = NULL;
+   m_iType = index->getType(node);
+   m_iStatus = index->getStatus(node);
+   m_iAccess = index->getAccess(node);
+}
+
+/**
+ * Create MIB tree backed by given index. Root object takes ownership of the index.
+ */
+SNMP_MIBObject *SNMP_MIBObject::createFromIndex(SNMP_MIBIndex *index)
+{
+   return new SNMP_MIBObject(index, 0);
 }
 
 /**
@@ -100,6 +137,61 @@ SNMP_MIBObject::~SNMP_MIBObject()
    MemFree(m_pszName);
    MemFree(m_pszDescription);
 	MemFree(m_pszTextualConvention);
+   MemFree(m_children);
+   if ((m_index != nullptr) && (m_indexNode == 0))
+      delete m_index;
+}
+
+/**
+ * Create child objects from backing index
+ */
+void SNMP_MIBObject::loadChildren()
+{
+   s_indexLoadLock.lock();
+   if (!m_childrenLoaded)
+   {
+      uint32_t count = m_index->getChildCount(m_indexNode);
+      if (count > 0)
+      {
+         m_children = MemAllocArrayNoInit<SNMP_MIBObject*>(count);
+         uint32_t first = m_index->getChild(m_indexNode, 0);
+         for(uint32_t i = 0; i < count; i++)
+         {
+            SNMP_MIBObject *object = new SNMP_MIBObject(m_index, first + i);
+            if (m_pLast == NULL)
+            {
+               m_pFirst = object;
+            }
+            else
+            {
+               m_pLast->m_pNext = object;
+               object->m_pPrev = m_pLast;
+            }
+            m_pLast = object;
+            object->m_pParent = this;
+            m_children[i] = object;
+         }
+      }
+      m_childrenLoaded = true;
+   }
+   s_indexLoadLock.unlock();
+}
+
+/**
+ * Read description and textual convention from backing index
+ */
+void SNMP_MIBObject::loadDescription()
+{
+   s_indexLoadLock.lock();
+   if (!m_descriptionLoaded)
+   {
+      String description = m_index->getDescription(m_indexNode);
+      String tc = m_index->getTextualConvention(m_indexNode);
+      m_pszDescription = !description.isEmpty() ? MemCopyString(description) : NULL;
+      m_pszTextualConvention = !tc.isEmpty() ? MemCopyString(tc) : NULL;
+      m_descriptionLoaded = true;
+   }
+   s_indexLoadLock.unlock();
 }
 
 /**
@@ -107,6 +199,14 @@ SNMP_MIBObject::~SNMP_MIBObject()
  */
 void SNMP_MIBObject::addChild(SNMP_MIBObject *pObject)
 {
+   if (m_index != nullptr)
+   {
+      // Load existing children first; lookup array is no longer valid after modification
+      loadChildren();
+      MemFree(m_children);
+      m_children = nullptr;
+   }
+
    if (m_pLast == NULL)
    {
       m_pFirst = m_pLast = pObject;
@@ -126,14 +226,80 @@ void SNMP_MIBObject::addChild(SNMP_MIBObject *pObject)
  */
 SNMP_MIBObject *SNMP_MIBObject::findChildByID(UINT32 dwOID)
 {
-   SNMP_MIBObject *pCurr;
+   if (m_index != nullptr)
+   {
+      loadChildren();
+      if (m_children != nullptr)
+      {
+         uint32_t node = m_index->findChildByID(m_indexNode, dwOID);
+         return (node != MIB_INVALID_NODE) ? m_children[node - m_index->getChild(m_indexNode, 0)] : NULL;
+      }
+   }
 
+   SNMP_MIBObject *pCurr;
    for(pCurr = m_pFirst; pCurr != NULL; pCurr = pCurr->getNext())
       if (pCurr->m_dwOID == dwOID)
          return pCurr;
    return NULL;
 }
 
+/**
+ * Find object by OID relative to this object. If exactMatch is false, closest existing
+ * parent object is returned when there is no object with given OID.
+ */
+SNMP_MIBObject *SNMP_MIBObject::findByOID(const uint32_t *oid, size_t length, bool exactMatch)
+{
+   SNMP_MIBObject *object = this;
+   for(size_t i = 0; i < length; i++)
+   {
+      SNMP_MIBObject *child = object->findChildByID(oid[i]);
+      if (child == NULL)
+         return exactMatch ? NULL : object;
+      object = child;
+   }
+   return object;
+}
+
+/**
+ * Find object by name within this subtree
+ */
+SNMP_MIBObject *SNMP_MIBObject::findByName(const TCHAR *name)
+{
+   if ((m_index != nullptr) && (m_indexNode == 0))
+   {
+      // Root of index backed tree - find node in name index and walk down from root
+      uint32_t node = m_index->findByName(name);
+      if (node == MIB_INVALID_NODE)
+         return NULL;
+      uint32_t depth = 0;
+      for(uint32_t n = node; n != 0; n = m_index->getParent(n))
+         depth++;
+      uint32_t *path = MemAllocArrayNoInit<uint32_t>(depth);
+      for(uint32_t n = node, i = depth; n != 0; n = m_index->getParent(n))
+         path[--i] = m_index->getObjectId(n);
+      SNMP_MIBObject *object = findByOID(path, depth);
+      MemFree(path);
+      return object;
+   }
+
+   // Iterative depth first search
+   SNMP_MIBObject *curr = this;
+   while(curr != NULL)
+   {
+      if ((curr->m_pszName != NULL) && !_tcscmp(curr->m_pszName, name))
+         return curr;
+      SNMP_MIBObject *next = curr->getFirstChild();
+      while((next == NULL) && (curr != this))
+      {
+         next = curr->m_pNext;
+         if (next == NULL)
+            curr = curr->m_pParent;
+      }
+      curr = next;
+   }
+   return NULL;
+}
+
 /**
  * Set information
  */
@@ -146,6 +312,7 @@ void SNMP_MIBObject::setInfo(int iType, int iStatus, int iAccess, const TCHAR *p
    m_iAccess = iAccess;
    m_pszDescription = (pszDescription != NULL) ? _tcsdup(pszDescription) : NULL;
 	m_pszTextualConvention = (pszTextualConvention != NULL) ? _tcsdup(pszTextualConvention) : NULL;
+   m_descriptionLoaded = true;
 }
 
 /**
@@ -160,7 +327,7 @@ void SNMP_MIBObject::print(int nIndent)
    else
       _tprintf(_T("%*s%s(%d)\n"), nIndent, _T(""), m_pszName, m_dwOID);
 
-   for(pCurr = m_pFirst; pCurr != NULL; pCurr = pCurr->getNext())
+   for(pCurr = getFirstChild(); pCurr != NULL; pCurr = pCurr->getNext())
       pCurr->print(nIndent + 2);
 }
 
@@ -247,10 +414,10 @@ void SNMP_MIBObject::writeToFile(ZFile *pFile, UINT32 dwFlags)
    if (!(dwFlags & SMT_SKIP_DESCRIPTIONS))
    {
       pFile->writeByte(MIB_TAG_DESCRIPTION);
-      WriteStringToFile(pFile, CHECK_NULL_EX(m_pszDescription));
+      WriteStringToFile(pFile, CHECK_NULL_EX(getDescription()));
       pFile->writeByte(MIB_TAG_DESCRIPTION | MIB_END_OF_TAG);
 
-		if (m_pszTextualConvention != NULL)
+		if (getTextualConvention() != NULL)
 		{
 			pFile->writeByte(MIB_TAG_TEXTUAL_CONVENTION);
 			WriteStringToFile(pFile, m_pszTextualConvention);
@@ -259,7 +426,7 @@ void SNMP_MIBObject::writeToFile(ZFile *pFile, UINT32 dwFlags)
    }
 
    // Save children
-   for(pCurr = m_pFirst; pCurr != NULL; pCurr = pCurr->getNext())
+   for(pCurr = getFirstChild(); pCurr != NULL; pCurr = pCurr->getNext())
       pCurr->writeToFile(pFile, dwFlags);
 
    pFile->writeByte(MIB_TAG_OBJECT | MIB_END_OF_TAG);
@@ -276,7 +443,23 @@ uint32_t LIBNXSNMP_EXPORTABLE SNMPSaveMIBTree(const TCHAR *pszFile, SNMP_MIBObje
    uint32_t dwRet = SNMP_ERR_SUCCESS;
 
    pFile = _tfopen(pszFile, _T("wb"));
-   if (pFile != nullptr)
+   if ((pFile != nullptr) && (flags & SMT_INDEXED_FORMAT))
+   {
+      // Indexed format is intended for memory mapping and is never compressed
+      memcpy(header.chMagic, MIB_FILE_MAGIC, 6);
+      header.bVersion = MIB_FILE_VERSION_INDEXED;
+      header.bHeaderSize = sizeof(SNMP_MIB_HEADER);
+      header.flags = htons((WORD)(flags & ~SMT_COMPRESS_DATA));
+      header.dwTimeStamp = htonl((UINT32)time(nullptr));
+      memset(header.bReserved, 0, sizeof(header.bReserved));
+      if (fwrite(&header, sizeof(SNMP_MIB_HEADER), 1, pFile) == 1)
+         dwRet = SaveIndexedMIBTree(pFile, pRoot, flags);
+      else
+         dwRet = SNMP_ERR_FILE_IO;
+      if ((fclose(pFile) != 0) && (dwRet == SNMP_ERR_SUCCESS))
+         dwRet = SNMP_ERR_FILE_IO;
+   }
+   else if (pFile != nullptr)
    {
       memcpy(header.chMagic, MIB_FILE_MAGIC, 6);
       header.bVersion = MIB_FILE_VERSION;
@@ -423,7 +606,14 @@ uint32_t LIBNXSNMP_EXPORTABLE SNMPLoadMIBTree(const TCHAR *pszFile, SNMP_MIBObje
       SNMP_MIB_HEADER header;
       if (fread(&header, 1, sizeof(SNMP_MIB_HEADER), pFile) == sizeof(SNMP_MIB_HEADER))
       {
-         if (!memcmp(header.chMagic, MIB_FILE_MAGIC, 6))
+         if (!memcmp(header.chMagic, MIB_FILE_MAGIC, 6) && (header.bVersion == MIB_FILE_VERSION_INDEXED))
+         {
+            fclose(pFile);
+            SNMP_MIBIndex *index = SNMP_MIBIndex::open(pszFile, &dwRet);
+            if (index != nullptr)
+               *ppRoot = SNMP_MIBObject::createFromIndex(index);
+         }
+         else if (!memcmp(header.chMagic, MIB_FILE_MAGIC, 6))
          {
             header.flags = ntohs(header.flags);
             fseek(pFile, header.bHeaderSize, SEEK_SET);
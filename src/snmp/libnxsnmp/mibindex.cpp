@@ -0,0 +1,569 @@
+/*
+** NetXMS - Network Management System
+** SNMP support library
+** Copyright (C) 2003-2020 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: mibindex.cpp
+**
+**/
+
+#include "libnxsnmp.h"
+
+#if !defined(_WIN32) && HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+/**
+ * Count nodes in MIB subtree
+ */
+static uint32_t CountNodes(SNMP_MIBObject *object)
+{
+   uint32_t count = 1;
+   for(SNMP_MIBObject *curr = object->getFirstChild(); curr != nullptr; curr = curr->getNext())
+      count += CountNodes(curr);
+   return count;
+}
+
+/**
+ * Compare MIB objects by OID - qsort callback
+ */
+static int CompareObjectsByOID(const void *e1, const void *e2)
+{
+   uint32_t oid1 = (*static_cast<SNMP_MIBObject* const*>(e1))->getObjectId();
+   uint32_t oid2 = (*static_cast<SNMP_MIBObject* const*>(e2))->getObjectId();
+   return (oid1 < oid2) ? -1 : ((oid1 > oid2) ? 1 : 0);
+}
+
+/**
+ * Add string to string table and return its offset (0 for empty strings)
+ */
+static uint32_t AddString(ByteStream *table, const TCHAR *s)
+{
+   if ((s == nullptr) || (*s == 0))
+      return 0;
+   uint32_t offset = static_cast<uint32_t>(table->size());
+   char *utf8 = UTF8StringFromTString(s);
+   table->write(utf8, strlen(utf8) + 1);
+   MemFree(utf8);
+   return offset;
+}
+
+/**
+ * Context for name index sorting
+ */
+struct NameIndexSortContext
+{
+   const SNMP_MIB_INDEX_NODE *nodes;
+   const char *strings;
+};
+
+/**
+ * Compare nodes by name - qsort_s callback
+ */
+static int CompareNodesByName(void *context, const void *e1, const void *e2)
+{
+   const NameIndexSortContext *ctx = static_cast<NameIndexSortContext*>(context);
+   uint32_t n1 = *static_cast<const uint32_t*>(e1);
+   uint32_t n2 = *static_cast<const uint32_t*>(e2);
+   int rc = strcmp(ctx->strings + ntohl(ctx->nodes[n1].name), ctx->strings + ntohl(ctx->nodes[n2].name));
+   return (rc != 0) ? rc : ((n1 < n2) ? -1 : 1);
+}
+
+/**
+ * Write data block to file
+ */
+static inline bool WriteBlock(FILE *file, const void *data, size_t size)
+{
+   return (size == 0) || (fwrite(data, size, 1, file) == 1);
+}
+
+/**
+ * Save MIB tree in indexed format. File header should be already written.
+ */
+uint32_t SaveIndexedMIBTree(FILE *file, SNMP_MIBObject *root, uint32_t flags)
+{
+   uint32_t count = CountNodes(root);
+   SNMP_MIBObject **objects = MemAllocArrayNoInit<SNMP_MIBObject*>(count);
+   SNMP_MIB_INDEX_NODE *nodes = MemAllocArray<SNMP_MIB_INDEX_NODE>(count);
+   uint32_t *nameIndex = MemAllocArrayNoInit<uint32_t>(count);
+
+   ByteStream strings(65536);
+   strings.write(static_cast<BYTE>(0));
+   ByteStream descriptions((flags & SMT_SKIP_DESCRIPTIONS) ? 1 : 1048576);
+   descriptions.write(static_cast<BYTE>(0));
+
+   // Lay out nodes in breadth-first order so that children of each node form continuous range
+   objects[0] = root;
+   nodes[0].parent = htonl(MIB_INVALID_NODE);
+   uint32_t tail = 1;
+   for(uint32_t i = 0; i < count; i++)
+   {
+      SNMP_MIBObject *object = objects[i];
+      uint32_t first = tail;
+      for(SNMP_MIBObject *curr = object->getFirstChild(); curr != nullptr; curr = curr->getNext())
+      {
+         nodes[tail].parent = htonl(i);
+         objects[tail++] = curr;
+      }
+      if (tail - first > 1)
+         qsort(&objects[first], tail - first, sizeof(SNMP_MIBObject*), CompareObjectsByOID);
+
+      SNMP_MIB_INDEX_NODE *node = &nodes[i];
+      node->oid = htonl(object->getObjectId());
+      node->firstChild = htonl(first);
+      node->childCount = htonl(tail - first);
+      node->name = htonl(AddString(&strings, object->getName()));
+      node->type = static_cast<BYTE>(object->getType());
+      node->status = static_cast<BYTE>(object->getStatus());
+      node->access = static_cast<BYTE>(object->getAccess());
+      if (!(flags & SMT_SKIP_DESCRIPTIONS))
+      {
+         node->description = htonl(AddString(&descriptions, object->getDescription()));
+         node->textualConvention = htonl(AddString(&strings, object->getTextualConvention()));
+      }
+      nameIndex[i] = i;
+   }
+
+   NameIndexSortContext context;
+   context.nodes = nodes;
+   context.strings = reinterpret_cast<const char*>(strings.buffer());
+   qsort_s(nameIndex, count, sizeof(uint32_t), CompareNodesByName, &context);
+   for(uint32_t i = 0; i < count; i++)
+      nameIndex[i] = htonl(nameIndex[i]);
+
+   uint32_t offset = sizeof(SNMP_MIB_HEADER) + sizeof(SNMP_MIB_INDEX_HEADER);
+   SNMP_MIB_INDEX_HEADER header;
+   memset(&header, 0, sizeof(header));
+   header.nodeCount = htonl(count);
+   header.nodesOffset = htonl(offset);
+   offset += count * sizeof(SNMP_MIB_INDEX_NODE);
+   header.nameIndexOffset = htonl(offset);
+   offset += count * sizeof(uint32_t);
+   header.stringsOffset = htonl(offset);
+   header.stringsSize = htonl(static_cast<uint32_t>(strings.size()));
+   offset += static_cast<uint32_t>(strings.size());
+   header.descriptionsOffset = htonl(offset);
+   header.descriptionsSize = htonl(static_cast<uint32_t>(descriptions.size()));
+
+   bool success = WriteBlock(file, &header, sizeof(header)) &&
+            WriteBlock(file, nodes, count * sizeof(SNMP_MIB_INDEX_NODE)) &&
+            WriteBlock(file, nameIndex, count * sizeof(uint32_t)) &&
+            WriteBlock(file, strings.buffer(), strings.size()) &&
+            WriteBlock(file, descriptions.buffer(), descriptions.size());
+
+   MemFree(objects);
+   MemFree(nodes);
+   MemFree(nameIndex);
+   return success ? SNMP_ERR_SUCCESS : SNMP_ERR_FILE_IO;
+}
+
+/**
+ * Create empty index
+ */
+SNMP_MIBIndex::SNMP_MIBIndex()
+{
+   m_data = nullptr;
+   m_size = 0;
+#ifdef _WIN32
+   m_hFile = INVALID_HANDLE_VALUE;
+   m_hMapping = nullptr;
+#endif
+   m_nodes = nullptr;
+   m_nodeCount = 0;
+   m_nameIndex = nullptr;
+   m_strings = nullptr;
+   m_descriptions = nullptr;
+   m_timestamp = 0;
+}
+
+/**
+ * Destructor
+ */
+SNMP_MIBIndex::~SNMP_MIBIndex()
+{
+#ifdef _WIN32
+   if (m_data != nullptr)
+      UnmapViewOfFile(m_data);
+   if (m_hMapping != nullptr)
+      CloseHandle(m_hMapping);
+   if (m_hFile != INVALID_HANDLE_VALUE)
+      CloseHandle(m_hFile);
+#elif HAVE_MMAP
+   if (m_data != nullptr)
+      munmap(m_data, m_size);
+#else
+   MemFree(m_data);
+#endif
+}
+
+/**
+ * Open compiled MIB file in indexed format
+ */
+SNMP_MIBIndex *SNMP_MIBIndex::open(const TCHAR *fileName, uint32_t *error)
+{
+   static const size_t minSize = sizeof(SNMP_MIB_HEADER) + sizeof(SNMP_MIB_INDEX_HEADER);
+   uint32_t rc = SNMP_ERR_SUCCESS;
+   SNMP_MIBIndex *index = new SNMP_MIBIndex();
+
+#ifdef _WIN32
+   index->m_hFile = CreateFile(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+   LARGE_INTEGER fsize;
+   if ((index->m_hFile != INVALID_HANDLE_VALUE) && GetFileSizeEx(index->m_hFile, &fsize))
+   {
+      index->m_size = static_cast<size_t>(fsize.QuadPart);
+      if (index->m_size >= minSize)
+      {
+         index->m_hMapping = CreateFileMapping(index->m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+         if (index->m_hMapping != nullptr)
+            index->m_data = MapViewOfFile(index->m_hMapping, FILE_MAP_READ, 0, 0, 0);
+         if (index->m_data == nullptr)
+            rc = SNMP_ERR_FILE_IO;
+      }
+      else
+      {
+         rc = SNMP_ERR_BAD_FILE_HEADER;
+      }
+   }
+   else
+   {
+      rc = SNMP_ERR_FILE_IO;
+   }
+#elif HAVE_MMAP
+   int fd = _topen(fileName, O_RDONLY);
+   if (fd != -1)
+   {
+      struct stat st;
+      if (fstat(fd, &st) == 0)
+      {
+         index->m_size = static_cast<size_t>(st.st_size);
+         if (index->m_size >= minSize)
+         {
+            void *data = mmap(nullptr, index->m_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED)
+               index->m_data = data;
+            else
+               rc = SNMP_ERR_FILE_IO;
+         }
+         else
+         {
+            rc = SNMP_ERR_BAD_FILE_HEADER;
+         }
+      }
+      else
+      {
+         rc = SNMP_ERR_FILE_IO;
+      }
+      _close(fd);
+   }
+   else
+   {
+      rc = SNMP_ERR_FILE_IO;
+   }
+#else
+   size_t size;
+   index->m_data = LoadFile(fileName, &size);
+   if (index->m_data != nullptr)
+   {
+      index->m_size = size;
+      if (size < minSize)
+         rc = SNMP_ERR_BAD_FILE_HEADER;
+   }
+   else
+   {
+      rc = SNMP_ERR_FILE_IO;
+   }
+#endif
+
+   if (rc == SNMP_ERR_SUCCESS)
+      rc = index->validate();
+
+   if (error != nullptr)
+      *error = rc;
+   if (rc != SNMP_ERR_SUCCESS)
+   {
+      delete index;
+      return nullptr;
+   }
+   return index;
+}
+
+/**
+ * Validate mapped file and set pointers to file sections. All node references are checked
+ * here, so accessor methods only have to validate node index passed by caller.
+ */
+uint32_t SNMP_MIBIndex::validate()
+{
+   const BYTE *data = static_cast<const BYTE*>(m_data);
+   const SNMP_MIB_HEADER *fileHeader = reinterpret_cast<const SNMP_MIB_HEADER*>(data);
+   if (memcmp(fileHeader->chMagic, MIB_FILE_MAGIC, 6) || (fileHeader->bVersion != MIB_FILE_VERSION_INDEXED) ||
+       (fileHeader->bHeaderSize < sizeof(SNMP_MIB_HEADER)) || (fileHeader->bHeaderSize % 4 != 0) ||
+       (fileHeader->bHeaderSize + sizeof(SNMP_MIB_INDEX_HEADER) > m_size))
+      return SNMP_ERR_BAD_FILE_HEADER;
+   m_timestamp = ntohl(fileHeader->dwTimeStamp);
+
+   const SNMP_MIB_INDEX_HEADER *header = reinterpret_cast<const SNMP_MIB_INDEX_HEADER*>(data + fileHeader->bHeaderSize);
+   uint64_t nodeCount = ntohl(header->nodeCount);
+   uint64_t nodesOffset = ntohl(header->nodesOffset);
+   uint64_t nameIndexOffset = ntohl(header->nameIndexOffset);
+   uint64_t stringsOffset = ntohl(header->stringsOffset);
+   uint64_t stringsSize = ntohl(header->stringsSize);
+   uint64_t descriptionsOffset = ntohl(header->descriptionsOffset);
+   uint64_t descriptionsSize = ntohl(header->descriptionsSize);
+   if ((nodeCount == 0) || (nodeCount == MIB_INVALID_NODE) || (nodesOffset % 4 != 0) || (nameIndexOffset % 4 != 0) ||
+       (nodesOffset + nodeCount * sizeof(SNMP_MIB_INDEX_NODE) > m_size) ||
+       (nameIndexOffset + nodeCount * sizeof(uint32_t) > m_size) ||
+       (stringsSize == 0) || (stringsOffset + stringsSize > m_size) ||
+       (descriptionsSize == 0) || (descriptionsOffset + descriptionsSize > m_size))
+      return SNMP_ERR_BAD_FILE_DATA;
+
+   m_nodeCount = static_cast<uint32_t>(nodeCount);
+   m_nodes = reinterpret_cast<const SNMP_MIB_INDEX_NODE*>(data + nodesOffset);
+   m_nameIndex = reinterpret_cast<const uint32_t*>(data + nameIndexOffset);
+   m_strings = reinterpret_cast<const char*>(data + stringsOffset);
+   m_descriptions = reinterpret_cast<const char*>(data + descriptionsOffset);
+
+   // Both tables start with empty string and end with terminating zero, so any offset within table points to valid string
+   if ((m_strings[0] != 0) || (m_strings[stringsSize - 1] != 0) || (m_descriptions[0] != 0) || (m_descriptions[descriptionsSize - 1] != 0))
+      return SNMP_ERR_BAD_FILE_DATA;
+
+   // Check that nodes form a tree: children always follow parent in breadth-first layout (which guarantees
+   // absence of cycles), each child points back to the node claiming it, and child ranges cover every
+   // non-root node exactly once. Children within each range should be strictly ordered by OID for binary search.
+   if (ntohl(m_nodes[0].parent) != MIB_INVALID_NODE)
+      return SNMP_ERR_BAD_FILE_DATA;
+   uint64_t claimed = 0;
+   for(uint32_t i = 0; i < m_nodeCount; i++)
+   {
+      const SNMP_MIB_INDEX_NODE *n = &m_nodes[i];
+      uint64_t firstChild = ntohl(n->firstChild);
+      uint64_t childCount = ntohl(n->childCount);
+      if (((childCount > 0) && ((firstChild <= i) || (firstChild + childCount > nodeCount))) ||
+          (ntohl(n->name) >= stringsSize) || (ntohl(n->textualConvention) >= stringsSize) ||
+          (ntohl(n->description) >= descriptionsSize) ||
+          (ntohl(m_nameIndex[i]) >= m_nodeCount))
+         return SNMP_ERR_BAD_FILE_DATA;
+      for(uint64_t c = firstChild; c < firstChild + childCount; c++)
+      {
+         if ((ntohl(m_nodes[c].parent) != i) ||
+             ((c > firstChild) && (ntohl(m_nodes[c].oid) <= ntohl(m_nodes[c - 1].oid))))
+            return SNMP_ERR_BAD_FILE_DATA;
+      }
+      claimed += childCount;
+   }
+   // Every claimed node has single parent reference, so no node can be claimed twice
+   return (claimed == nodeCount - 1) ? SNMP_ERR_SUCCESS : SNMP_ERR_BAD_FILE_DATA;
+}
+
+/**
+ * Get parent node (MIB_INVALID_NODE for root or invalid node index)
+ */
+uint32_t SNMP_MIBIndex::getParent(uint32_t node) const
+{
+   return (node < m_nodeCount) ? ntohl(m_nodes[node].parent) : MIB_INVALID_NODE;
+}
+
+/**
+ * Get number of child nodes
+ */
+uint32_t SNMP_MIBIndex::getChildCount(uint32_t node) const
+{
+   return (node < m_nodeCount) ? ntohl(m_nodes[node].childCount) : 0;
+}
+
+/**
+ * Get child node by position (children are sorted by OID)
+ */
+uint32_t SNMP_MIBIndex::getChild(uint32_t node, uint32_t index) const
+{
+   return (index < getChildCount(node)) ? ntohl(m_nodes[node].firstChild) + index : MIB_INVALID_NODE;
+}
+
+/**
+ * Get last element of node's OID
+ */
+uint32_t SNMP_MIBIndex::getObjectId(uint32_t node) const
+{
+   return (node < m_nodeCount) ? ntohl(m_nodes[node].oid) : 0;
+}
+
+/**
+ * Get node name in UTF-8 (pointer to mapped file data, valid until index is destroyed)
+ */
+const char *SNMP_MIBIndex::getNameUTF8(uint32_t node) const
+{
+   return (node < m_nodeCount) ? m_strings + ntohl(m_nodes[node].name) : "";
+}
+
+/**
+ * Convert UTF-8 string from mapped file to string object
+ */
+static String StringFromUTF8(const char *s)
+{
+   return (*s != 0) ? String(TStringFromUTF8String(s), -1, Ownership::True) : String();
+}
+
+/**
+ * Get node name
+ */
+String SNMP_MIBIndex::getName(uint32_t node) const
+{
+   return StringFromUTF8(getNameUTF8(node));
+}
+
+/**
+ * Get node description
+ */
+String SNMP_MIBIndex::getDescription(uint32_t node) const
+{
+   return StringFromUTF8((node < m_nodeCount) ? m_descriptions + ntohl(m_nodes[node].description) : "");
+}
+
+/**
+ * Get node textual convention
+ */
+String SNMP_MIBIndex::getTextualConvention(uint32_t node) const
+{
+   return StringFromUTF8((node < m_nodeCount) ? m_strings + ntohl(m_nodes[node].textualConvention) : "");
+}
+
+/**
+ * Get node type
+ */
+int SNMP_MIBIndex::getType(uint32_t node) const
+{
+   return (node < m_nodeCount) ? m_nodes[node].type : -1;
+}
+
+/**
+ * Get node status
+ */
+int SNMP_MIBIndex::getStatus(uint32_t node) const
+{
+   return (node < m_nodeCount) ? m_nodes[node].status : -1;
+}
+
+/**
+ * Get node access
+ */
+int SNMP_MIBIndex::getAccess(uint32_t node) const
+{
+   return (node < m_nodeCount) ? m_nodes[node].access : -1;
+}
+
+/**
+ * Find child node by OID element (binary search within sorted child range)
+ */
+uint32_t SNMP_MIBIndex::findChildByID(uint32_t node, uint32_t oid) const
+{
+   if (node >= m_nodeCount)
+      return MIB_INVALID_NODE;
+
+   uint32_t low = ntohl(m_nodes[node].firstChild);
+   uint32_t high = low + ntohl(m_nodes[node].childCount);
+   while(low < high)
+   {
+      uint32_t mid = low + (high - low) / 2;
+      uint32_t curr = ntohl(m_nodes[mid].oid);
+      if (curr == oid)
+         return mid;
+      if (curr < oid)
+         low = mid + 1;
+      else
+         high = mid;
+   }
+   return MIB_INVALID_NODE;
+}
+
+/**
+ * Find node by name. If there are multiple nodes with same name, first one in name index is returned.
+ */
+uint32_t SNMP_MIBIndex::findByName(const TCHAR *name) const
+{
+   char *utf8name = UTF8StringFromTString(name);
+   uint32_t low = 0, high = m_nodeCount;
+   while(low < high)
+   {
+      uint32_t mid = low + (high - low) / 2;
+      if (strcmp(m_strings + ntohl(m_nodes[ntohl(m_nameIndex[mid])].name), utf8name) < 0)
+         low = mid + 1;
+      else
+         high = mid;
+   }
+   uint32_t node = ((low < m_nodeCount) && !strcmp(m_strings + ntohl(m_nodes[ntohl(m_nameIndex[low])].name), utf8name)) ?
+            ntohl(m_nameIndex[low]) : MIB_INVALID_NODE;
+   MemFree(utf8name);
+   return node;
+}
+
+/**
+ * Find node by full OID. If matchedLength is not null, closest existing parent node is
+ * returned when there is no exact match, and number of matched OID elements is stored there.
+ */
+uint32_t SNMP_MIBIndex::findByOID(const uint32_t *oid, size_t length, size_t *matchedLength) const
+{
+   uint32_t node = 0;
+   size_t i;
+   for(i = 0; i < length; i++)
+   {
+      uint32_t child = findChildByID(node, oid[i]);
+      if (child == MIB_INVALID_NODE)
+         break;
+      node = child;
+   }
+   if (matchedLength != nullptr)
+   {
+      *matchedLength = i;
+      return node;
+   }
+   return (i == length) ? node : MIB_INVALID_NODE;
+}
+
+/**
+ * Create heap based MIB tree (for code which works with SNMP_MIBObject). Nodes are
+ * processed in file order - parent always precedes its children and children of each
+ * node are stored in OID order, so tree is built in single pass without recursion.
+ */
+SNMP_MIBObject *SNMP_MIBIndex::createTree(bool withDescriptions) const
+{
+   SNMP_MIBObject **objects = MemAllocArrayNoInit<SNMP_MIBObject*>(m_nodeCount);
+   for(uint32_t i = 0; i < m_nodeCount; i++)
+   {
+      const SNMP_MIB_INDEX_NODE *n = &m_nodes[i];
+      const char *name = m_strings + ntohl(n->name);
+      TCHAR *tname = (*name != 0) ? TStringFromUTF8String(name) : nullptr;
+      if (withDescriptions)
+      {
+         const char *description = m_descriptions + ntohl(n->description);
+         const char *tc = m_strings + ntohl(n->textualConvention);
+         TCHAR *tdescription = (*description != 0) ? TStringFromUTF8String(description) : nullptr;
+         TCHAR *ttc = (*tc != 0) ? TStringFromUTF8String(tc) : nullptr;
+         objects[i] = new SNMP_MIBObject(ntohl(n->oid), tname, n->type, n->status, n->access, tdescription, ttc);
+         MemFree(tdescription);
+         MemFree(ttc);
+      }
+      else
+      {
+         objects[i] = new SNMP_MIBObject(ntohl(n->oid), tname, n->type, n->status, n->access, nullptr, nullptr);
+      }
+      MemFree(tname);
+      if (i > 0)
+         objects[ntohl(n->parent)]->addChild(objects[i]);
+   }
+   SNMP_MIBObject *root = objects[0];
+   MemFree(objects);
+   return root;
+}
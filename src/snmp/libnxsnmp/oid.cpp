@@ -37,8 +37,16 @@ SNMP_ObjectId::SNMP_ObjectId()
  */
 SNMP_ObjectId::SNMP_ObjectId(const SNMP_ObjectId &src)
 {
-   m_length = src.m_length;
-   m_value = MemCopyArray(src.m_value, m_length);
+   if (src.m_value != nullptr)
+   {
+      m_value = nullptr;
+      copyValue(src.m_value, src.m_length);
+   }
+   else
+   {
+      m_length = 0;
+      m_value = nullptr;
+   }
 }
 
 /**
@@ -46,8 +54,8 @@ SNMP_ObjectId::SNMP_ObjectId(const SNMP_ObjectId &src)
  */
 SNMP_ObjectId::SNMP_ObjectId(const uint32_t *value, size_t length)
 {
-   m_length = length;
-   m_value = MemCopyArray(value, length);
+   m_value = nullptr;
+   copyValue(value, length);
 }
 
 /**
@@ -55,7 +63,57 @@ SNMP_ObjectId::SNMP_ObjectId(const uint32_t *value, size_t length)
  */
 SNMP_ObjectId::~SNMP_ObjectId()
 {
-   MemFree(m_value);
+   if (!isInternalBuffer())
+      MemFree(m_value);
+}
+
+/**
+ * Resize value buffer to hold given number of elements (existing elements are preserved)
+ */
+void SNMP_ObjectId::resize(size_t length)
+{
+   if (length <= SNMP_OID_INTERNAL_BUFFER_SIZE)
+   {
+      if ((m_value != nullptr) && !isInternalBuffer())
+      {
+         memcpy(m_internalBuffer, m_value, std::min(m_length, length) * sizeof(uint32_t));
+         MemFree(m_value);
+      }
+      m_value = m_internalBuffer;
+   }
+   else if (isInternalBuffer() || (m_value == nullptr))
+   {
+      uint32_t *value = MemAllocArrayNoInit<uint32_t>(length);
+      if (m_value != nullptr)
+         memcpy(value, m_internalBuffer, std::min(m_length, length) * sizeof(uint32_t));
+      m_value = value;
+   }
+   else
+   {
+      m_value = MemReallocArray(m_value, length);
+   }
+}
+
+/**
+ * Replace value with copy of given array (uses internal buffer for short OIDs)
+ */
+void SNMP_ObjectId::copyValue(const uint32_t *value, size_t length)
+{
+   if (length <= SNMP_OID_INTERNAL_BUFFER_SIZE)
+   {
+      if ((m_value != nullptr) && !isInternalBuffer())
+         MemFree(m_value);
+      m_value = m_internalBuffer;
+   }
+   else if ((m_value == nullptr) || isInternalBuffer() || (length > m_length))
+   {
+      if ((m_value != nullptr) && !isInternalBuffer())
+         MemFree(m_value);
+      m_value = MemAllocArrayNoInit<uint32_t>(length);
+   }
+   if (length > 0)
+      memmove(m_value, value, length * sizeof(uint32_t));
+   m_length = length;
 }
 
 /**
@@ -65,9 +123,17 @@ SNMP_ObjectId& SNMP_ObjectId::operator =(const SNMP_ObjectId &src)
 {
    if (&src == this)
       return *this;
-   MemFree(m_value);
-   m_length = src.m_length;
-   m_value = MemCopyArray(src.m_value, m_length);
+   if (src.m_value != nullptr)
+   {
+      copyValue(src.m_value, src.m_length);
+   }
+   else
+   {
+      if (!isInternalBuffer())
+         MemFree(m_value);
+      m_value = nullptr;
+      m_length = 0;
+   }
    return *this;
 }
 
@@ -138,9 +204,7 @@ int SNMP_ObjectId::compare(const SNMP_ObjectId& oid) const
  */
 void SNMP_ObjectId::setValue(const uint32_t *value, size_t length)
 {
-   MemFree(m_value);
-   m_length = length;
-   m_value = MemCopyArray(value, length);
+   copyValue(value, length);
 }
 
 /**
@@ -150,7 +214,7 @@ void SNMP_ObjectId::setValue(const uint32_t *value, size_t length)
  */
 void SNMP_ObjectId::extend(uint32_t subId)
 {
-   m_value = MemReallocArray(m_value, m_length + 1);
+   resize(m_length + 1);
    m_value[m_length++] = subId;
 }
 
@@ -162,7 +226,7 @@ void SNMP_ObjectId::extend(uint32_t subId)
  */
 void SNMP_ObjectId::extend(const uint32_t *subId, size_t length)
 {
-   m_value = MemReallocArray(m_value, m_length + length);
+   resize(m_length + length);
    memcpy(&m_value[m_length], subId, length * sizeof(uint32_t));
    m_length += length;
 }
@@ -72,7 +72,9 @@ SNMP_PDU::SNMP_PDU()
 {
    m_version = SNMP_VERSION_1;
    m_command = SNMP_INVALID_PDU;
-   m_variables = new ObjectArray<SNMP_Variable>(0, 16, Ownership::True);
+   m_variables = new ObjectArray<SNMP_Variable>(0, 16, Ownership::False);
+   m_variableArena = nullptr;
+   m_arenaSize = 0;
    m_pEnterprise = nullptr;
    m_errorCode = SNMP_PDU_ERR_SUCCESS;
    m_errorIndex = 0;
@@ -99,7 +101,9 @@ SNMP_PDU::SNMP_PDU(uint32_t command, uint32_t requestId, SNMP_Version version)
 {
    m_version = version;
    m_command = command;
-   m_variables = new ObjectArray<SNMP_Variable>(0, 16, Ownership::True);
+   m_variables = new ObjectArray<SNMP_Variable>(0, 16, Ownership::False);
+   m_variableArena = nullptr;
+   m_arenaSize = 0;
    m_pEnterprise = nullptr;
    m_errorCode = SNMP_PDU_ERR_SUCCESS;
    m_errorIndex = 0;
@@ -126,7 +130,9 @@ SNMP_PDU::SNMP_PDU(const SNMP_PDU *src) : m_authoritativeEngine(&src->m_authorit
 {
    m_version = src->m_version;
    m_command = src->m_command;
-   m_variables = new ObjectArray<SNMP_Variable>(src->m_variables->size(), 16, Ownership::True);
+   m_variables = new ObjectArray<SNMP_Variable>(src->m_variables->size(), 16, Ownership::False);
+   m_variableArena = nullptr;
+   m_arenaSize = 0;
    for(int i = 0; i < src->m_variables->size(); i++)
       m_variables->add(new SNMP_Variable(src->m_variables->get(i)));
    m_pEnterprise = (src->m_pEnterprise != nullptr) ? new SNMP_ObjectId(*src->m_pEnterprise) : nullptr;
@@ -155,38 +161,26 @@ SNMP_PDU::SNMP_PDU(const SNMP_PDU *src) : m_authoritativeEngine(&src->m_authorit
 SNMP_PDU::~SNMP_PDU()
 {
    delete m_pEnterprise;
-   delete m_variables;
-	MemFree(m_authObject);
-}
-
-/**
- * Parse single variable binding
- */
-bool SNMP_PDU::parseVariable(const BYTE *pData, size_t varLength)
-{
-   SNMP_Variable *var;
-   bool success = true;
-
-   var = new SNMP_Variable;
-   if (var->parse(pData, varLength))
-   {
-      bindVariable(var);
-   }
-   else
+   for(int i = 0; i < m_variables->size(); i++)
    {
-      delete var;
-      success = false;
+      SNMP_Variable *v = m_variables->get(i);
+      if (isArenaVariable(v))
+         v->~SNMP_Variable();
+      else
+         delete v;
    }
-   return success;
+   delete m_variables;
+   MemFree(m_variableArena);
+	MemFree(m_authObject);
 }
 
 /**
- * Parse variable bindings
+ * Parse variable bindings. All variables are allocated as single memory block.
  */
 bool SNMP_PDU::parseVarBinds(const BYTE *pData, size_t pduLength)
 {
    const BYTE *pbCurrPos;
-   UINT32 dwType;
+   uint32_t dwType;
    size_t dwLength, dwBindingLength, idLength;
 
    // Varbind section should be a SEQUENCE
@@ -195,18 +189,39 @@ bool SNMP_PDU::parseVarBinds(const BYTE *pData, size_t pduLength)
    if (dwType != ASN_SEQUENCE)
       return false;
 
-   while(dwBindingLength > 0)
+   // Count and validate bindings
+   const BYTE *bindings = pbCurrPos;
+   size_t remLength = dwBindingLength;
+   int count = 0;
+   while(remLength > 0)
    {
-      if (!BER_DecodeIdentifier(pbCurrPos, pduLength, &dwType, &dwLength, &pbCurrPos, &idLength))
+      if (!BER_DecodeIdentifier(pbCurrPos, remLength, &dwType, &dwLength, &pbCurrPos, &idLength))
          return false;
       if (dwType != ASN_SEQUENCE)
          return false;  // Every binding is a sequence
-      if (dwLength > dwBindingLength)
-         return false;     // Invalid length
+      remLength -= dwLength + idLength;
+      pbCurrPos += dwLength;
+      count++;
+   }
 
-      if (!parseVariable(pbCurrPos, dwLength))
+   SNMP_Variable *arena = nullptr;
+   if ((count > 0) && (m_variableArena == nullptr))
+   {
+      m_variableArena = MemAllocArrayNoInit<SNMP_Variable>(count);
+      m_arenaSize = count;
+      arena = m_variableArena;
+   }
+
+   pbCurrPos = bindings;
+   remLength = dwBindingLength;
+   for(int i = 0; i < count; i++)
+   {
+      BER_DecodeIdentifier(pbCurrPos, remLength, &dwType, &dwLength, &pbCurrPos, &idLength);
+      SNMP_Variable *var = (arena != nullptr) ? new(&arena[i]) SNMP_Variable() : new SNMP_Variable();
+      m_variables->add(var);
+      if (!var->parse(pbCurrPos, dwLength))
          return false;
-      dwBindingLength -= dwLength + idLength;
+      remLength -= dwLength + idLength;
       pbCurrPos += dwLength;
    }
 
@@ -289,17 +304,14 @@ bool SNMP_PDU::parseTrapPDU(const BYTE *pData, size_t pduLength)
    {
       if (dwType == ASN_OBJECT_ID)
       {
-         SNMP_OID oid;
-         memset(&oid, 0, sizeof(SNMP_OID));
-         if (BER_DecodeContent(dwType, pbCurrPos, dwLength, (BYTE *)&oid))
-         {
-            m_pEnterprise = new SNMP_ObjectId(oid.value, oid.length);
-            pduLength -= dwLength + idLength;
-            pbCurrPos += dwLength;
-
-            bResult = true;
-         }
-         MemFree(oid.value);
+         uint32_t buffer[MAX_OID_LEN];
+         uint32_t *oid = (dwLength < MAX_OID_LEN) ? buffer : MemAllocArrayNoInit<uint32_t>(dwLength + 1);
+         m_pEnterprise = new SNMP_ObjectId(oid, BER_DecodeOID(pbCurrPos, dwLength, oid));
+         if (oid != buffer)
+            MemFree(oid);
+         pduLength -= dwLength + idLength;
+         pbCurrPos += dwLength;
+         bResult = true;
       }
    }
 
@@ -516,7 +528,7 @@ bool SNMP_PDU::parseV3SecurityUsm(const BYTE *data, size_t dataLength, const BYT
 	// Engine ID
    if (!BER_DecodeIdentifier(currPos, remLength, &type, &length, &currPos, &idLength))
       return false;
-   if (type != ASN_OCTET_STRING)
+   if ((type != ASN_OCTET_STRING) || (length > SNMP_MAX_ENGINEID_LEN))
       return false;
 	engineIdLen = length;
    if (!BER_DecodeContent(type, currPos, length, engineId))
@@ -828,6 +840,7 @@ bool SNMP_PDU::parse(const BYTE *rawData, size_t rawLength, SNMP_SecurityContext
 			}
 
 			pbCurrPos = decryptedPdu;
+			dwPacketLength = decryptedPduLength;
 		}
 
 		// Scoped PDU
@@ -861,44 +874,92 @@ bool SNMP_PDU::parse(const BYTE *rawData, size_t rawLength, SNMP_SecurityContext
 		pbCurrPos += dwLength;
 		dwPacketLength -= dwLength + idLength;
 
-		bResult = parsePdu(pbCurrPos, dwLength);
+		bResult = parsePdu(pbCurrPos, dwPacketLength);
 	}
 
    return bResult;
 }
 
 /**
- * Create packet from PDU
+ * Encode single element at given position. If buffer is NULL, only advances position by element size.
  */
-size_t SNMP_PDU::encode(BYTE **ppBuffer, SNMP_SecurityContext *securityContext)
+static inline bool EncodeElement(uint32_t type, const void *data, size_t dataLength, BYTE *buffer, size_t bufferSize, size_t *pos)
 {
-   size_t dwBytes, dwVarBindsSize, dwPDUSize, dwPacketSize;
+   size_t bytes = BER_Encode(type, static_cast<const BYTE*>(data), dataLength, (buffer != nullptr) ? buffer + *pos : nullptr, bufferSize - *pos);
+   *pos += bytes;
+   return bytes != 0;
+}
 
-	// Replace context name if defined in security context
-	if (securityContext->getContextName() != nullptr)
-		strlcpy(m_contextName, securityContext->getContextName(), SNMP_MAX_CONTEXT_NAME);
+/**
+ * Encode PDU content (header fields and variable bindings) directly into given buffer.
+ * If buffer is NULL, only calculates encoded size. Return value is number of bytes
+ * used in buffer or 0 on failure.
+ */
+size_t SNMP_PDU::encodePduContent(uint32_t pduType, bool withVarBinds, BYTE *buffer, size_t bufferSize)
+{
+   size_t varBindsSize = 0;
+   if (withVarBinds)
+   {
+      for(int i = 0; i < m_variables->size(); i++)
+         varBindsSize += m_variables->get(i)->encode(nullptr, 0);
+   }
 
-   // Estimate required buffer size and allocate it
-	size_t bufferSize = 1024;
-   for(int i = 0; i < m_variables->size(); i++)
+   size_t pos = 0;
+   bool success;
+   if (pduType == ASN_TRAP_V1_PDU)
    {
-      SNMP_Variable *var = m_variables->get(i);
-      bufferSize += var->getValueLength() + var->getName().length() * 4 + 16;
+      uint32_t trapType = static_cast<uint32_t>(m_trapType);
+      uint32_t specificTrap = static_cast<uint32_t>(m_specificTrap);
+      success =
+         EncodeElement(ASN_OBJECT_ID, (m_pEnterprise != nullptr) ? m_pEnterprise->value() : nullptr,
+                  (m_pEnterprise != nullptr) ? m_pEnterprise->length() * sizeof(uint32_t) : 0, buffer, bufferSize, &pos) &&
+         EncodeElement(ASN_IP_ADDR, &m_dwAgentAddr, sizeof(uint32_t), buffer, bufferSize, &pos) &&
+         EncodeElement(ASN_INTEGER, &trapType, sizeof(uint32_t), buffer, bufferSize, &pos) &&
+         EncodeElement(ASN_INTEGER, &specificTrap, sizeof(uint32_t), buffer, bufferSize, &pos) &&
+         EncodeElement(ASN_TIMETICKS, &m_timestamp, sizeof(uint32_t), buffer, bufferSize, &pos);
    }
-   BYTE *pBlock = static_cast<BYTE*>(SNMP_MemAlloc(bufferSize));
-   BYTE *pVarBinds = static_cast<BYTE*>(SNMP_MemAlloc(bufferSize));
-   BYTE *pPacket = static_cast<BYTE*>(SNMP_MemAlloc(bufferSize));
+   else
+   {
+      success =
+         EncodeElement(ASN_INTEGER, &m_requestId, sizeof(uint32_t), buffer, bufferSize, &pos) &&
+         EncodeElement(ASN_INTEGER, &m_errorCode, sizeof(uint32_t), buffer, bufferSize, &pos) &&
+         EncodeElement(ASN_INTEGER, &m_errorIndex, sizeof(uint32_t), buffer, bufferSize, &pos);
+   }
+   if (!success)
+      return 0;
 
-   // Encode variables
-   dwVarBindsSize = 0;
-   BYTE *pbCurrPos = pVarBinds;
-   for(int i = 0; i < m_variables->size(); i++)
+   size_t bytes = BER_EncodeHeader(ASN_SEQUENCE, varBindsSize, (buffer != nullptr) ? buffer + pos : nullptr, bufferSize - pos);
+   if (bytes == 0)
+      return 0;
+   pos += bytes;
+
+   if (buffer == nullptr)
+      return pos + varBindsSize;
+
+   if (bufferSize - pos < varBindsSize)
+      return 0;
+   if (withVarBinds)
    {
-      SNMP_Variable *var = m_variables->get(i);
-      dwBytes = var->encode(pbCurrPos, bufferSize - dwVarBindsSize);
-      pbCurrPos += dwBytes;
-      dwVarBindsSize += dwBytes;
+      for(int i = 0; i < m_variables->size(); i++)
+      {
+         bytes = m_variables->get(i)->encode(buffer + pos, bufferSize - pos);
+         if (bytes == 0)
+            return 0;
+         pos += bytes;
+      }
    }
+   return pos;
+}
+
+/**
+ * Create packet from PDU. Community based packets are encoded in single pass directly into
+ * output buffer after calculating size of all elements.
+ */
+size_t SNMP_PDU::encode(BYTE **ppBuffer, SNMP_SecurityContext *securityContext)
+{
+	// Replace context name if defined in security context
+	if (securityContext->getContextName() != nullptr)
+		strlcpy(m_contextName, securityContext->getContextName(), SNMP_MAX_CONTEXT_NAME);
 
    // Determine PDU type
    uint32_t pduType = 0;
@@ -910,195 +971,149 @@ size_t SNMP_PDU::encode(BYTE **ppBuffer, SNMP_SecurityContext *securityContext)
          pduType = s_pduTypeToCommand[i].dwType;
          break;
       }
+   if (pduType == 0)
+      return 0;   // Error
 
-   // Encode PDU header
-   if (pduType != 0)
+   uint32_t version = static_cast<uint32_t>(m_version);
+   size_t dwBytes;
+
+   if (m_version != SNMP_VERSION_3)
    {
-      pbCurrPos = pBlock;
-      dwPDUSize = 0;
-      uint32_t intValue;
-      switch(pduType)
+      const char *community = securityContext->getCommunity();
+      size_t communityLength = strlen(community);
+
+      size_t pduContentSize = encodePduContent(pduType, true, nullptr, 0);
+      size_t packetSize = BER_Encode(ASN_INTEGER, (BYTE *)&version, sizeof(uint32_t), nullptr, 0) +
+               BER_Encode(ASN_OCTET_STRING, (BYTE *)community, communityLength, nullptr, 0) +
+               BER_EncodeHeader(pduType, pduContentSize, nullptr, 0) + pduContentSize;
+      size_t totalSize = BER_EncodeHeader(ASN_SEQUENCE, packetSize, nullptr, 0) + packetSize;
+
+      BYTE *buffer = MemAllocArrayNoInit<BYTE>(totalSize);
+      size_t pos = BER_EncodeHeader(ASN_SEQUENCE, packetSize, buffer, totalSize);
+      if (EncodeElement(ASN_INTEGER, &version, sizeof(uint32_t), buffer, totalSize, &pos) &&
+          EncodeElement(ASN_OCTET_STRING, community, communityLength, buffer, totalSize, &pos))
       {
-         case ASN_TRAP_V1_PDU:
-            dwBytes = BER_Encode(ASN_OBJECT_ID, (BYTE *)m_pEnterprise->value(),
-                                 m_pEnterprise->length() * sizeof(uint32_t),
-                                 pbCurrPos, bufferSize - dwPDUSize);
-            dwPDUSize += dwBytes;
-            pbCurrPos += dwBytes;
-
-            dwBytes = BER_Encode(ASN_IP_ADDR, (BYTE *)&m_dwAgentAddr, sizeof(uint32_t),
-                                 pbCurrPos, bufferSize - dwPDUSize);
-            dwPDUSize += dwBytes;
-            pbCurrPos += dwBytes;
-
-            intValue = static_cast<uint32_t>(m_trapType);
-            dwBytes = BER_Encode(ASN_INTEGER, (BYTE *)&intValue, sizeof(uint32_t),
-                                 pbCurrPos, bufferSize - dwPDUSize);
-            dwPDUSize += dwBytes;
-            pbCurrPos += dwBytes;
-
-            intValue = static_cast<uint32_t>(m_specificTrap);
-            dwBytes = BER_Encode(ASN_INTEGER, (BYTE *)&intValue, sizeof(uint32_t),
-                                 pbCurrPos, bufferSize - dwPDUSize);
-            dwPDUSize += dwBytes;
-            pbCurrPos += dwBytes;
-
-            dwBytes = BER_Encode(ASN_INTEGER, (BYTE *)&m_timestamp, sizeof(uint32_t),
-                                 pbCurrPos, bufferSize - dwPDUSize);
-            dwPDUSize += dwBytes;
-            pbCurrPos += dwBytes;
-            break;
-         default:
-            dwBytes = BER_Encode(ASN_INTEGER, (BYTE *)&m_requestId, sizeof(uint32_t),
-                                 pbCurrPos, bufferSize - dwPDUSize);
-            dwPDUSize += dwBytes;
-            pbCurrPos += dwBytes;
-
-            dwBytes = BER_Encode(ASN_INTEGER, (BYTE *)&m_errorCode, sizeof(uint32_t),
-                                 pbCurrPos, bufferSize - dwPDUSize);
-            dwPDUSize += dwBytes;
-            pbCurrPos += dwBytes;
-
-            dwBytes = BER_Encode(ASN_INTEGER, (BYTE *)&m_errorIndex, sizeof(uint32_t),
-                                 pbCurrPos, bufferSize - dwPDUSize);
-            dwPDUSize += dwBytes;
-            pbCurrPos += dwBytes;
-            break;
+         pos += BER_EncodeHeader(pduType, pduContentSize, buffer + pos, totalSize - pos);
+         pos += encodePduContent(pduType, true, buffer + pos, totalSize - pos);
+      }
+      if (pos != totalSize)
+      {
+         MemFree(buffer);
+         return 0;   // Should not happen - encoded size differs from calculated
       }
+      *ppBuffer = buffer;
+      return totalSize;
+   }
 
-      // Encode varbinds into PDU
-		if ((m_version != SNMP_VERSION_3) || ((securityContext != nullptr) && (securityContext->getAuthoritativeEngine().getIdLen() != 0)))
-		{
-			dwBytes = BER_Encode(ASN_SEQUENCE, pVarBinds, dwVarBindsSize, pbCurrPos, bufferSize - dwPDUSize);
-		}
-		else
-		{
-			// Do not encode varbinds into engine id discovery message
-			dwBytes = BER_Encode(ASN_SEQUENCE, nullptr, 0, pbCurrPos, bufferSize - dwPDUSize);
-		}
-      dwPDUSize += dwBytes;
+   // Do not encode varbinds into engine id discovery message
+   bool withVarBinds = (securityContext != nullptr) && (securityContext->getAuthoritativeEngine().getIdLen() != 0);
 
-      // Encode packet header
-      pbCurrPos = pPacket;
-      dwPacketSize = 0;
+   // Scoped PDU may need padding for encryption, and header and security parameters are limited to ~1.5K
+   size_t bufferSize = encodePduContent(pduType, withVarBinds, nullptr, 0) + SNMP_MAX_CONTEXT_NAME + SNMP_MAX_ENGINEID_LEN + 2048;
+   BYTE *pPacket = static_cast<BYTE*>(SNMP_MemAlloc(bufferSize));
 
-      uint32_t version = static_cast<uint32_t>(m_version);
-      dwBytes = BER_Encode(ASN_INTEGER, (BYTE *)&version, sizeof(uint32_t), pbCurrPos, bufferSize);
-      dwPacketSize += dwBytes;
-      pbCurrPos += dwBytes;
+   // Encode packet header
+   BYTE *pbCurrPos = pPacket;
+   size_t dwPacketSize = 0;
 
-		if (m_version == SNMP_VERSION_3)
-		{
-			// Generate encryption salt if packet has to be encrypted
-			if (securityContext->needEncryption())
-			{
-				uint64_t temp = htonq(GetCurrentTimeMs());
-				memcpy(m_salt, &temp, 8);
-			}
+   dwBytes = BER_Encode(ASN_INTEGER, (BYTE *)&version, sizeof(uint32_t), pbCurrPos, bufferSize);
+   dwPacketSize += dwBytes;
+   pbCurrPos += dwBytes;
 
-			dwBytes = encodeV3Header(pbCurrPos, bufferSize - dwPacketSize, securityContext);
-			dwPacketSize += dwBytes;
-			pbCurrPos += dwBytes;
+   // Generate encryption salt if packet has to be encrypted
+   if (securityContext->needEncryption())
+   {
+      uint64_t temp = htonq(GetCurrentTimeMs());
+      memcpy(m_salt, &temp, 8);
+   }
 
-			dwBytes = encodeV3SecurityParameters(pbCurrPos, bufferSize - dwPacketSize, securityContext);
-			dwPacketSize += dwBytes;
-			pbCurrPos += dwBytes;
+   dwBytes = encodeV3Header(pbCurrPos, bufferSize - dwPacketSize, securityContext);
+   dwPacketSize += dwBytes;
+   pbCurrPos += dwBytes;
 
-			dwBytes = encodeV3ScopedPDU(pduType, pBlock, dwPDUSize, pbCurrPos, bufferSize - dwPacketSize);
-			if (securityContext->needEncryption())
-			{
+   dwBytes = encodeV3SecurityParameters(pbCurrPos, bufferSize - dwPacketSize, securityContext);
+   dwPacketSize += dwBytes;
+   pbCurrPos += dwBytes;
+
+   dwBytes = encodeV3ScopedPDU(pduType, withVarBinds, pbCurrPos, bufferSize - dwPacketSize);
+   if (securityContext->needEncryption())
+   {
 #ifdef _WITH_ENCRYPTION
-				if (securityContext->getPrivMethod() == SNMP_ENCRYPT_DES)
-				{
+      if (securityContext->getPrivMethod() == SNMP_ENCRYPT_DES)
+      {
 #ifndef OPENSSL_NO_DES
-					size_t encSize = (dwBytes % 8 == 0) ? dwBytes : (dwBytes + (8 - (dwBytes % 8)));
-					BYTE *encryptedPdu = static_cast<BYTE*>(SNMP_MemAlloc(encSize));
-
-					DES_cblock key;
-					DES_key_schedule schedule;
-					memcpy(&key, securityContext->getPrivKey(), 8);
-					DES_set_key_unchecked(&key, &schedule);
-
-					DES_cblock iv;
-					memcpy(&iv, securityContext->getPrivKey() + 8, 8);
-					for(int i = 0; i < 8; i++)
-						iv[i] ^= m_salt[i];
-
-					DES_ncbc_encrypt(pbCurrPos, encryptedPdu, (long)dwBytes, &schedule, &iv, DES_ENCRYPT);
-					dwBytes = BER_Encode(ASN_OCTET_STRING, encryptedPdu, encSize, pbCurrPos, bufferSize - dwPacketSize);
-					SNMP_MemFree(encryptedPdu, encSize);
+         size_t encSize = (dwBytes % 8 == 0) ? dwBytes : (dwBytes + (8 - (dwBytes % 8)));
+         BYTE *encryptedPdu = static_cast<BYTE*>(SNMP_MemAlloc(encSize));
+
+         DES_cblock key;
+         DES_key_schedule schedule;
+         memcpy(&key, securityContext->getPrivKey(), 8);
+         DES_set_key_unchecked(&key, &schedule);
+
+         DES_cblock iv;
+         memcpy(&iv, securityContext->getPrivKey() + 8, 8);
+         for(int i = 0; i < 8; i++)
+            iv[i] ^= m_salt[i];
+
+         DES_ncbc_encrypt(pbCurrPos, encryptedPdu, (long)dwBytes, &schedule, &iv, DES_ENCRYPT);
+         dwBytes = BER_Encode(ASN_OCTET_STRING, encryptedPdu, encSize, pbCurrPos, bufferSize - dwPacketSize);
+         SNMP_MemFree(encryptedPdu, encSize);
 #else
-					dwBytes = 0;	// Error - no DES support
-					goto cleanup;
+         dwBytes = 0;	// Error - no DES support
+         goto cleanup;
 #endif
-				}
-				else if (securityContext->getPrivMethod() == SNMP_ENCRYPT_AES)
-				{
+      }
+      else if (securityContext->getPrivMethod() == SNMP_ENCRYPT_AES)
+      {
 #ifndef OPENSSL_NO_AES
-					AES_KEY key;
-					AES_set_encrypt_key(securityContext->getPrivKey(), 128, &key);
-
-					BYTE iv[16];
-					UINT32 boots = htonl((UINT32)securityContext->getAuthoritativeEngine().getBoots());
-					UINT32 engTime = htonl((UINT32)securityContext->getAuthoritativeEngine().getTime());
-					memcpy(iv, &boots, 4);
-					memcpy(&iv[4], &engTime, 4);
-					memcpy(&iv[8], m_salt, 8);
-
-					BYTE *encryptedPdu = static_cast<BYTE*>(SNMP_MemAlloc(dwBytes));
-					int num = 0;
-					AES_cfb128_encrypt(pbCurrPos, encryptedPdu, dwBytes, &key, iv, &num, AES_ENCRYPT);
-					dwBytes = BER_Encode(ASN_OCTET_STRING, encryptedPdu, dwBytes, pbCurrPos, bufferSize - dwPacketSize);
-					SNMP_MemFree(encryptedPdu, dwBytes);
+         AES_KEY key;
+         AES_set_encrypt_key(securityContext->getPrivKey(), 128, &key);
+
+         BYTE iv[16];
+         uint32_t boots = htonl((uint32_t)securityContext->getAuthoritativeEngine().getBoots());
+         uint32_t engTime = htonl((uint32_t)securityContext->getAuthoritativeEngine().getTime());
+         memcpy(iv, &boots, 4);
+         memcpy(&iv[4], &engTime, 4);
+         memcpy(&iv[8], m_salt, 8);
+
+         size_t encSize = dwBytes;
+         BYTE *encryptedPdu = static_cast<BYTE*>(SNMP_MemAlloc(encSize));
+         int num = 0;
+         AES_cfb128_encrypt(pbCurrPos, encryptedPdu, encSize, &key, iv, &num, AES_ENCRYPT);
+         dwBytes = BER_Encode(ASN_OCTET_STRING, encryptedPdu, encSize, pbCurrPos, bufferSize - dwPacketSize);
+         SNMP_MemFree(encryptedPdu, encSize);
 #else
-					dwBytes = 0;	// Error - no AES support
-					goto cleanup;
+         dwBytes = 0;	// Error - no AES support
+         goto cleanup;
 #endif
-				}
-				else
-				{
-					dwBytes = 0;	// Error - unsupported method
-					goto cleanup;
-				}
+      }
+      else
+      {
+         dwBytes = 0;	// Error - unsupported method
+         goto cleanup;
+      }
 #else
-				dwBytes = 0;	// Error
-				goto cleanup;
+      dwBytes = 0;	// Error
+      goto cleanup;
 #endif
-			}
-			dwPacketSize += dwBytes;
-		}
-		else
-		{
-			dwBytes = BER_Encode(ASN_OCTET_STRING, (BYTE *)securityContext->getCommunity(),
-			         strlen(securityContext->getCommunity()), pbCurrPos, bufferSize - dwPacketSize);
-			dwPacketSize += dwBytes;
-			pbCurrPos += dwBytes;
-
-			// Encode PDU into packet
-			dwBytes = BER_Encode(pduType, pBlock, dwPDUSize, pbCurrPos, bufferSize - dwPacketSize);
-			dwPacketSize += dwBytes;
-		}
+   }
+   dwPacketSize += dwBytes;
 
-      // And final step: allocate buffer for entire datagramm and wrap packet
-      // into SEQUENCE
-      *ppBuffer = MemAllocArrayNoInit<BYTE>(dwPacketSize + 6);
-      dwBytes = BER_Encode(ASN_SEQUENCE, pPacket, dwPacketSize, *ppBuffer, dwPacketSize + 6);
+   // And final step: allocate buffer for entire datagramm and wrap packet
+   // into SEQUENCE
+   *ppBuffer = MemAllocArrayNoInit<BYTE>(dwPacketSize + 6);
+   dwBytes = BER_EncodeHeader(ASN_SEQUENCE, dwPacketSize, *ppBuffer, dwPacketSize + 6);
+   memcpy(*ppBuffer + dwBytes, pPacket, dwPacketSize);
+   dwBytes += dwPacketSize;
 
-		// Sign message
-		if ((m_version == SNMP_VERSION_3) && securityContext->needAuthentication())
-		{
-			signMessage(*ppBuffer, dwBytes, securityContext);
-		}
-   }
-   else
+   // Sign message
+   if (securityContext->needAuthentication())
    {
-      dwBytes = 0;   // Error
+      signMessage(*ppBuffer, dwBytes, securityContext);
    }
 
 cleanup:
    SNMP_MemFree(pPacket, bufferSize);
-   SNMP_MemFree(pBlock, bufferSize);
-   SNMP_MemFree(pVarBinds, bufferSize);
    return dwBytes;
 }
 
@@ -1196,22 +1211,26 @@ size_t SNMP_PDU::encodeV3SecurityParameters(BYTE *buffer, size_t bufferSize, SNM
 }
 
 /**
- * Encode versionj 3 scoped PDU
+ * Encode version 3 scoped PDU directly into given buffer
  */
-size_t SNMP_PDU::encodeV3ScopedPDU(uint32_t pduType, BYTE *pdu, size_t pduSize, BYTE *buffer, size_t bufferSize)
+size_t SNMP_PDU::encodeV3ScopedPDU(uint32_t pduType, bool withVarBinds, BYTE *buffer, size_t bufferSize)
 {
-	size_t spduLen = pduSize + SNMP_MAX_CONTEXT_NAME + SNMP_MAX_ENGINEID_LEN + 32;
-	BYTE *spdu = static_cast<BYTE*>(SNMP_MemAlloc(spduLen));
-	size_t bytes;
-
-	bytes = BER_Encode(ASN_OCTET_STRING, m_contextEngineId, m_contextEngineIdLen, spdu, spduLen);
-	bytes += BER_Encode(ASN_OCTET_STRING, (BYTE *)m_contextName, strlen(m_contextName), &spdu[bytes], spduLen - bytes);
-	bytes += BER_Encode(pduType, pdu, pduSize, &spdu[bytes], spduLen - bytes);
-	
-	// Wrap scoped PDU into SEQUENCE
-	bytes = BER_Encode(ASN_SEQUENCE, spdu, bytes, buffer, bufferSize);
-	SNMP_MemFree(spdu, spduLen);
-	return bytes;
+   size_t contextNameLength = strlen(m_contextName);
+   size_t pduContentSize = encodePduContent(pduType, withVarBinds, nullptr, 0);
+   size_t contentSize = BER_Encode(ASN_OCTET_STRING, m_contextEngineId, m_contextEngineIdLen, nullptr, 0) +
+            BER_Encode(ASN_OCTET_STRING, (BYTE *)m_contextName, contextNameLength, nullptr, 0) +
+            BER_EncodeHeader(pduType, pduContentSize, nullptr, 0) + pduContentSize;
+
+   // Scoped PDU is a SEQUENCE
+   size_t pos = BER_EncodeHeader(ASN_SEQUENCE, contentSize, buffer, bufferSize);
+   if ((pos == 0) || (bufferSize - pos < contentSize))
+      return 0;
+
+   pos += BER_Encode(ASN_OCTET_STRING, m_contextEngineId, m_contextEngineIdLen, buffer + pos, bufferSize - pos);
+   pos += BER_Encode(ASN_OCTET_STRING, (BYTE *)m_contextName, contextNameLength, buffer + pos, bufferSize - pos);
+   pos += BER_EncodeHeader(pduType, pduContentSize, buffer + pos, bufferSize - pos);
+   pos += encodePduContent(pduType, withVarBinds, buffer + pos, bufferSize - pos);
+   return pos;
 }
 
 /**
@@ -1352,6 +1371,26 @@ bool SNMP_PDU::validateSignedMessage(const BYTE *msg, size_t msgLen, SNMP_Securi
    return !memcmp(m_signature, hash, signatureSize);
 }
 
+/**
+ * Detach variable from PDU. Returned object is owned by caller and should be destroyed with delete.
+ */
+SNMP_Variable *SNMP_PDU::detachVariable(int index)
+{
+   SNMP_Variable *var = m_variables->get(index);
+   if (var == nullptr)
+      return nullptr;
+
+   m_variables->remove(index);
+   if (isArenaVariable(var))
+   {
+      // Variables in arena cannot be destroyed individually, so caller gets a copy
+      SNMP_Variable *copy = new SNMP_Variable(var);
+      var->~SNMP_Variable();
+      var = copy;
+   }
+   return var;
+}
+
 /**
  * Bind variable to PDU
  */
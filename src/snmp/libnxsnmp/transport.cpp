@@ -426,8 +426,8 @@ size_t SNMP_UDPTransport::preParsePDU()
    size_t dwLength, dwIdLength;
    const BYTE *pbCurrPos;
 
-   if (!BER_DecodeIdentifier(&m_pBuffer[m_dwBufferPos], m_dwBytesInBuffer,
-                             &dwType, &dwLength, &pbCurrPos, &dwIdLength))
+   if (!BER_DecodeHeader(&m_pBuffer[m_dwBufferPos], m_dwBytesInBuffer,
+                         &dwType, &dwLength, &pbCurrPos, &dwIdLength))
       return 0;
    if (dwType != ASN_SEQUENCE)
       return 0;   // Packet should start with SEQUENCE
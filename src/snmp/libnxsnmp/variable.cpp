@@ -67,12 +67,13 @@ SNMP_Variable::SNMP_Variable(const SNMP_ObjectId &name) : m_name(name)
 /**
  * Copy constructor
  */
-SNMP_Variable::SNMP_Variable(const SNMP_Variable *src)
+SNMP_Variable::SNMP_Variable(const SNMP_Variable *src) : m_name(src->m_name)
 {
+   m_value = NULL;
    m_valueLength = src->m_valueLength;
-   m_value = (src->m_value != NULL) ? MemCopyBlock(src->m_value, src->m_valueLength) : NULL;
+   if (src->m_value != NULL)
+      memcpy(reallocValueBuffer(m_valueLength), src->m_value, m_valueLength);
    m_type = src->m_type;
-   m_name = src->m_name;
 }
 
 /**
@@ -80,80 +81,94 @@ SNMP_Variable::SNMP_Variable(const SNMP_Variable *src)
  */
 SNMP_Variable::~SNMP_Variable()
 {
-   free(m_value);
+   if (!isInternalBuffer())
+      MemFree(m_value);
+}
+
+/**
+ * Make value buffer large enough to hold given number of bytes. Small values are kept within
+ * variable object. Existing content is not preserved.
+ */
+BYTE *SNMP_Variable::reallocValueBuffer(size_t length)
+{
+   if (length <= SNMP_VARIABLE_INTERNAL_BUFFER_SIZE)
+   {
+      if (!isInternalBuffer())
+      {
+         MemFree(m_value);
+         m_value = reinterpret_cast<BYTE*>(m_valueBuffer);
+      }
+   }
+   else if (isInternalBuffer() || (m_value == NULL))
+   {
+      m_value = MemAllocArrayNoInit<BYTE>(length);
+   }
+   else
+   {
+      m_value = MemRealloc(m_value, length);
+   }
+   return m_value;
 }
 
 /**
- * Parse variable record in PDU
+ * Parse variable record in PDU. Name and value are decoded directly into variable's own storage,
+ * so no temporary buffers are allocated for typical variables.
  */
 bool SNMP_Variable::parse(const BYTE *data, size_t varLength)
 {
    const BYTE *pbCurrPos;
-   UINT32 type;
-   size_t length, dwIdLength;
-   bool bResult = false;
+   uint32_t type;
+   size_t length, idLength;
 
    // Object ID
-   if (!BER_DecodeIdentifier(data, varLength, &type, &length, &pbCurrPos, &dwIdLength))
+   if (!BER_DecodeIdentifier(data, varLength, &type, &length, &pbCurrPos, &idLength))
       return false;
    if (type != ASN_OBJECT_ID)
       return false;
 
-   SNMP_OID oid;
-   memset(&oid, 0, sizeof(SNMP_OID));
-   if (BER_DecodeContent(type, pbCurrPos, length, (BYTE *)&oid))
+   if (length < MAX_OID_LEN)
    {
-      m_name.setValue(oid.value, (size_t)oid.length);
-      varLength -= length + dwIdLength;
-      pbCurrPos += length;
-      bResult = TRUE;
+      uint32_t name[MAX_OID_LEN];
+      m_name.setValue(name, BER_DecodeOID(pbCurrPos, length, name));
    }
-   MemFree(oid.value);
-
-   if (bResult)
+   else
    {
-      bResult = FALSE;
-      if (BER_DecodeIdentifier(pbCurrPos, varLength, &m_type, &length, &pbCurrPos, &dwIdLength))
-      {
-         switch(m_type)
-         {
-            case ASN_OBJECT_ID:
-               memset(&oid, 0, sizeof(SNMP_OID));
-               if (BER_DecodeContent(m_type, pbCurrPos, length, (BYTE *)&oid))
-               {
-                  m_valueLength = oid.length * sizeof(uint32_t);
-                  m_value = (BYTE *)oid.value;
-                  bResult = true;
-               }
-               else
-               {
-                  MemFree(oid.value);
-               }
-               break;
-            case ASN_INTEGER:
-            case ASN_COUNTER32:
-            case ASN_GAUGE32:
-            case ASN_TIMETICKS:
-            case ASN_UINTEGER32:
-               m_valueLength = sizeof(uint32_t);
-               m_value = (BYTE *)MemAlloc(8);
-               bResult = BER_DecodeContent(m_type, pbCurrPos, length, m_value);
-               break;
-		      case ASN_COUNTER64:
-               m_valueLength = sizeof(uint64_t);
-               m_value = (BYTE *)MemAlloc(16);
-               bResult = BER_DecodeContent(m_type, pbCurrPos, length, m_value);
-               break;
-            default:
-               m_valueLength = length;
-               m_value = MemCopyBlock(pbCurrPos, length);
-               bResult = TRUE;
-               break;
-         }
-      }
+      uint32_t *name = MemAllocArrayNoInit<uint32_t>(length + 1);
+      m_name.setValue(name, BER_DecodeOID(pbCurrPos, length, name));
+      MemFree(name);
    }
+   varLength -= length + idLength;
+   pbCurrPos += length;
+
+   if (!BER_DecodeIdentifier(pbCurrPos, varLength, &m_type, &length, &pbCurrPos, &idLength))
+      return false;
 
-   return bResult;
+   bool success;
+   switch(m_type)
+   {
+      case ASN_OBJECT_ID:
+         m_valueLength = BER_DecodeOID(pbCurrPos, length, reinterpret_cast<uint32_t*>(reallocValueBuffer((length + 1) * sizeof(uint32_t)))) * sizeof(uint32_t);
+         success = true;
+         break;
+      case ASN_INTEGER:
+      case ASN_COUNTER32:
+      case ASN_GAUGE32:
+      case ASN_TIMETICKS:
+      case ASN_UINTEGER32:
+         m_valueLength = sizeof(uint32_t);
+         success = BER_DecodeContent(m_type, pbCurrPos, length, reallocValueBuffer(sizeof(uint32_t)));
+         break;
+      case ASN_COUNTER64:
+         m_valueLength = sizeof(uint64_t);
+         success = BER_DecodeContent(m_type, pbCurrPos, length, reallocValueBuffer(sizeof(uint64_t)));
+         break;
+      default:
+         m_valueLength = length;
+         memcpy(reallocValueBuffer(length), pbCurrPos, length);
+         success = true;
+         break;
+   }
+   return success;
 }
 
 /**
@@ -471,22 +486,21 @@ TCHAR *SNMP_Variable::getValueAsIPAddr(TCHAR *buffer) const
 }
 
 /**
- * Encode variable using BER
- * Normally buffer provided should be at least m_valueLength + (name_length * 4) + 12 bytes
- * Return value is number of bytes actually used in buffer
+ * Encode variable using BER directly into given buffer. If buffer is NULL, only calculates
+ * encoded size. Return value is number of bytes used in buffer or 0 if buffer is too small.
  */
-size_t SNMP_Variable::encode(BYTE *pBuffer, size_t bufferSize)
+size_t SNMP_Variable::encode(BYTE *buffer, size_t bufferSize) const
 {
-   size_t bytes, dwWorkBufSize;
-   BYTE *pWorkBuf;
-
-   dwWorkBufSize = (UINT32)(m_valueLength + m_name.length() * 4 + 16);
-   pWorkBuf = static_cast<BYTE*>(SNMP_MemAlloc(dwWorkBufSize));
-   bytes = BER_Encode(ASN_OBJECT_ID, (BYTE *)m_name.value(), m_name.length() * sizeof(uint32_t), pWorkBuf, dwWorkBufSize);
-   bytes += BER_Encode(m_type, m_value, m_valueLength, pWorkBuf + bytes, dwWorkBufSize - bytes);
-   bytes = BER_Encode(ASN_SEQUENCE, pWorkBuf, bytes, pBuffer, bufferSize);
-   SNMP_MemFree(pWorkBuf, dwWorkBufSize);
-   return bytes;
+   size_t nameSize = BER_Encode(ASN_OBJECT_ID, reinterpret_cast<const BYTE*>(m_name.value()), m_name.length() * sizeof(uint32_t), nullptr, 0);
+   size_t valueSize = BER_Encode(m_type, m_value, m_valueLength, nullptr, 0);
+   size_t headerSize = BER_EncodeHeader(ASN_SEQUENCE, nameSize + valueSize, buffer, bufferSize);
+   if ((buffer == nullptr) || (headerSize == 0))
+      return headerSize + nameSize + valueSize;
+
+   if ((BER_Encode(ASN_OBJECT_ID, reinterpret_cast<const BYTE*>(m_name.value()), m_name.length() * sizeof(uint32_t), buffer + headerSize, bufferSize - headerSize) == 0) ||
+       (BER_Encode(m_type, m_value, m_valueLength, buffer + headerSize + nameSize, bufferSize - headerSize - nameSize) == 0))
+      return 0;
+   return headerSize + nameSize + valueSize;
 }
 
 /**
@@ -502,7 +516,7 @@ void SNMP_Variable::setValueFromString(UINT32 type, const TCHAR *value)
    {
       case ASN_INTEGER:
          m_valueLength = sizeof(LONG);
-         m_value = (BYTE *)realloc(m_value, m_valueLength);
+         reallocValueBuffer(m_valueLength);
          *((LONG *)m_value) = _tcstol(value, NULL, 0);
          break;
       case ASN_COUNTER32:
@@ -510,17 +524,17 @@ void SNMP_Variable::setValueFromString(UINT32 type, const TCHAR *value)
       case ASN_TIMETICKS:
       case ASN_UINTEGER32:
          m_valueLength = sizeof(UINT32);
-         m_value = (BYTE *)realloc(m_value, m_valueLength);
+         reallocValueBuffer(m_valueLength);
          *((UINT32 *)m_value) = _tcstoul(value, NULL, 0);
          break;
       case ASN_COUNTER64:
          m_valueLength = sizeof(QWORD);
-         m_value = (BYTE *)realloc(m_value, m_valueLength);
+         reallocValueBuffer(m_valueLength);
          *((QWORD *)m_value) = _tcstoull(value, NULL, 0);
          break;
       case ASN_IP_ADDR:
          m_valueLength = sizeof(UINT32);
-         m_value = (BYTE *)realloc(m_value, m_valueLength);
+         reallocValueBuffer(m_valueLength);
          *((UINT32 *)m_value) = _t_inet_addr(value);
          break;
       case ASN_OBJECT_ID:
@@ -529,25 +543,29 @@ void SNMP_Variable::setValueFromString(UINT32 type, const TCHAR *value)
          if (length > 0)
          {
             m_valueLength = length * sizeof(UINT32);
-            MemFree(m_value);
-            m_value = reinterpret_cast<BYTE*>(MemCopyBlock(pdwBuffer, m_valueLength));
+            memcpy(reallocValueBuffer(m_valueLength), pdwBuffer, m_valueLength);
          }
          else
          {
             // OID parse error, set to .ccitt.zeroDotZero (.0.0)
             m_valueLength = sizeof(UINT32) * 2;
-            m_value = (BYTE *)MemRealloc(m_value, m_valueLength);
-            memset(m_value, 0, m_valueLength);
+            memset(reallocValueBuffer(m_valueLength), 0, m_valueLength);
          }
+         MemFree(pdwBuffer);
          break;
       case ASN_OCTET_STRING:
-         MemFree(m_value);
+         {
 #ifdef UNICODE
-         m_value = reinterpret_cast<BYTE*>(MBStringFromWideString(value));
+            char *mbValue = MBStringFromWideString(value);
 #else
-         m_value = reinterpret_cast<BYTE*>(MemCopyString(value));
+            const char *mbValue = value;
 #endif
-         m_valueLength = (UINT32)strlen(reinterpret_cast<char*>(m_value));
+            m_valueLength = strlen(mbValue);
+            memcpy(reallocValueBuffer(m_valueLength + 1), mbValue, m_valueLength + 1);
+#ifdef UNICODE
+            MemFree(mbValue);
+#endif
+         }
          break;
       default:
          break;
@@ -118,6 +118,8 @@ static void Help()
 		      _T("   -d <dir>  : Include all MIB files from given directory to compilation\n")
             _T("   -r        : Scan sub-directories \n")
             _T("   -e <ext>  : Specify file extensions (default extension: \"txt\") \n")
+		      _T("   -i        : Write indexed (memory mappable) output file; not readable by\n")
+		      _T("               Java based clients, intended for native tools and libraries\n")
 		      _T("   -o <file> : Set output file name (default is netxms.mib)\n")
 		      _T("   -P        : Pause before exit\n")
 		      _T("   -s        : Strip descriptions from MIB objects\n")
@@ -199,7 +201,7 @@ int main(int argc, char *argv[])
 
    // Parse command line
    opterr = 1;
-   while((ch = getopt(argc, argv, "rd:ho:e:Psz")) != -1)
+   while((ch = getopt(argc, argv, "rd:ho:e:iPsz")) != -1)
    {
       switch(ch)
       {
@@ -218,6 +220,9 @@ int main(int argc, char *argv[])
 #endif
 #endif
             break;
+         case 'i':
+            dwFlags |= SMT_INDEXED_FORMAT;
+            break;
          case 'h':   // Display help and exit
             Help();
             break;
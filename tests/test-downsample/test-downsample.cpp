@@ -0,0 +1,166 @@
+#include <nms_common.h>
+#include <nms_util.h>
+#include <testtools.h>
+#include <nxcore_downsample.h>
+
+NETXMS_EXECUTABLE_HEADER(test-downsample)
+
+/**
+ * Check that all bucket indexes within period are below target point count
+ */
+static bool CheckBucketIndexes(time_t periodStart, time_t periodEnd, uint32_t targetPoints)
+{
+   time_t bucketSize = GetDownsampleBucketSize(periodStart, periodEnd, targetPoints);
+   if (bucketSize < 1)
+      return false;
+   if (GetDownsampleBucketIndex(periodStart, periodStart, bucketSize) != 0)
+      return false;
+   INT64 last = GetDownsampleBucketIndex(periodEnd, periodStart, bucketSize);
+   return (last >= 0) && (last < static_cast<INT64>(targetPoints));
+}
+
+/**
+ * Test bucket size and index calculation
+ */
+static void TestBucketIndex()
+{
+   StartTest(_T("Bucket index"));
+
+   // Period length exactly divisible by target point count
+   AssertTrue(CheckBucketIndexes(1600000000, 1600000000 + 3600, 60));
+   AssertTrue(CheckBucketIndexes(1600000000, 1600000000 + 3600, 3600));
+
+   // Period shorter than target point count, single point period
+   AssertTrue(CheckBucketIndexes(1600000000, 1600000010, 1000));
+   AssertTrue(CheckBucketIndexes(1600000000, 1600000000, 10));
+   AssertTrue(CheckBucketIndexes(1600000000, 1600000000, 1));
+
+   // Unaligned period start (buckets should not depend on epoch alignment)
+   AssertTrue(CheckBucketIndexes(1600000007, 1600086407, 100));
+   AssertTrue(CheckBucketIndexes(1600000007, 1600086406, 100));
+   AssertTrue(CheckBucketIndexes(1600000007, 1600086408, 100));
+   AssertTrue(CheckBucketIndexes(0, 1600000000, 1000));
+
+   for(uint32_t targetPoints = 1; targetPoints < 200; targetPoints++)
+      for(time_t length = 0; length < 1000; length += 7)
+         AssertTrue(CheckBucketIndexes(1600000013, 1600000013 + length, targetPoints));
+
+   EndTest();
+}
+
+/**
+ * Aggregate one value per second over given period (newest first, as returned by database)
+ */
+static void AggregateSeries(time_t periodStart, time_t periodEnd, uint32_t targetPoints, DownsamplingMethod method, StructArray<DataPoint> *output)
+{
+   BucketAggregator aggregator(periodStart, GetDownsampleBucketSize(periodStart, periodEnd, targetPoints), method, output);
+   for(time_t t = periodEnd; t >= periodStart; t--)
+      aggregator.add(t, static_cast<double>(t - periodStart));
+   aggregator.finish();
+}
+
+/**
+ * Test bucket aggregator
+ */
+static void TestBucketAggregator()
+{
+   StartTest(_T("Bucket aggregator"));
+
+   StructArray<DataPoint> output;
+   for(uint32_t targetPoints = 1; targetPoints < 100; targetPoints++)
+   {
+      output.clear();
+      AggregateSeries(1600000007, 1600003607, targetPoints, DCI_DOWNSAMPLE_AVG, &output);
+      AssertTrue(output.size() <= static_cast<int>(targetPoints));
+      AssertTrue(output.size() > 0);
+      for(int i = 0; i < output.size(); i++)
+      {
+         AssertTrue(output.get(i)->timestamp >= 1600000007);
+         AssertTrue(output.get(i)->timestamp <= 1600003607);
+         if (i > 0)
+            AssertTrue(output.get(i)->timestamp < output.get(i - 1)->timestamp);
+      }
+   }
+
+   // 10 values (0..9) in 5 buckets of 2 seconds
+   output.clear();
+   AggregateSeries(1000, 1009, 5, DCI_DOWNSAMPLE_AVG, &output);
+   AssertEquals(output.size(), 5);
+   AssertEquals(output.get(0)->timestamp, static_cast<time_t>(1008));
+   AssertTrue(output.get(0)->value == 8.5);
+   AssertEquals(output.get(4)->timestamp, static_cast<time_t>(1000));
+   AssertTrue(output.get(4)->value == 0.5);
+
+   output.clear();
+   AggregateSeries(1000, 1009, 5, DCI_DOWNSAMPLE_MIN, &output);
+   AssertEquals(output.size(), 5);
+   AssertTrue(output.get(0)->value == 8);
+   AssertTrue(output.get(4)->value == 0);
+
+   output.clear();
+   AggregateSeries(1000, 1009, 5, DCI_DOWNSAMPLE_MAX, &output);
+   AssertEquals(output.size(), 5);
+   AssertTrue(output.get(0)->value == 9);
+   AssertTrue(output.get(4)->value == 1);
+
+   EndTest();
+}
+
+/**
+ * Test LTTB point selection
+ */
+static void TestLTTB()
+{
+   StartTest(_T("LTTB selection"));
+
+   StructArray<DataPoint> input;
+   for(int i = 0; i < 1000; i++)
+   {
+      DataPoint p;
+      p.timestamp = 1600000000 + i * 60;
+      p.value = (i == 500) ? 1000 : (i % 10);
+      input.add(p);
+   }
+
+   // Threshold above input size or below 3 - all points returned
+   StructArray<DataPoint> output;
+   SelectPointsLTTB(input, 2000, &output);
+   AssertEquals(output.size(), 1000);
+   output.clear();
+   SelectPointsLTTB(input, 2, &output);
+   AssertEquals(output.size(), 1000);
+
+   for(uint32_t threshold = 3; threshold <= 1000; threshold += 37)
+   {
+      output.clear();
+      SelectPointsLTTB(input, threshold, &output);
+      AssertEquals(output.size(), static_cast<int>(threshold));
+      AssertEquals(output.get(0)->timestamp, input.get(0)->timestamp);
+      AssertEquals(output.get(output.size() - 1)->timestamp, input.get(999)->timestamp);
+      bool spike = false;
+      for(int i = 0; i < output.size(); i++)
+      {
+         if (i > 0)
+            AssertTrue(output.get(i)->timestamp > output.get(i - 1)->timestamp);
+         if (output.get(i)->value == 1000)
+            spike = true;
+      }
+      AssertTrue(spike);   // spike is most significant point and should always be selected
+   }
+
+   EndTest();
+}
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   TestBucketIndex();
+   TestBucketAggregator();
+   TestLTTB();
+
+   return 0;
+}
@@ -508,3 +508,441 @@ void TestStringConversion()
    EndTest();
 
 }
+
+/**
+ * Reference (character by character) implementation of UTF-8 decoder
+ */
+static UCS4CHAR ReferenceCodePointFromUTF8(const BYTE*& s, size_t& len)
+{
+   BYTE b = *s++;
+   if ((b & 0x80) == 0)
+   {
+      len--;
+      return b;
+   }
+   if (((b & 0xE0) == 0xC0) && (len >= 2))
+   {
+      len -= 2;
+      return (static_cast<UCS4CHAR>(b & 0x1F) << 6) | (*s++ & 0x3F);
+   }
+   if (((b & 0xF0) == 0xE0) && (len >= 3))
+   {
+      len -= 3;
+      UCS4CHAR ch = (static_cast<UCS4CHAR>(b & 0x0F) << 12) | (static_cast<UCS4CHAR>(*s++ & 0x3F) << 6);
+      return ch | (*s++ & 0x3F);
+   }
+   if (((b & 0xF8) == 0xF0) && (len >= 4))
+   {
+      len -= 4;
+      UCS4CHAR ch = (static_cast<UCS4CHAR>(b & 0x0F) << 18) | (static_cast<UCS4CHAR>(*s++ & 0x3F) << 12);
+      ch |= static_cast<UCS4CHAR>(*s++ & 0x3F) << 6;
+      return ch | (*s++ & 0x3F);
+   }
+   len--;
+   return '?';
+}
+
+/**
+ * Reference implementation of utf8_to_ucs4
+ */
+static size_t reference_utf8_to_ucs4(const char *src, ssize_t srcLen, UCS4CHAR *dst, size_t dstLen)
+{
+   size_t len = (srcLen == -1) ? strlen(src) + 1 : srcLen;
+   const BYTE *s = reinterpret_cast<const BYTE*>(src);
+   size_t dcount = 0;
+   while((len > 0) && (dcount < dstLen))
+      dst[dcount++] = ReferenceCodePointFromUTF8(s, len);
+   if ((srcLen == -1) && (dcount == dstLen) && (dstLen > 0))
+      dst[dcount - 1] = 0;
+   return dcount;
+}
+
+/**
+ * Reference implementation of utf8_to_ucs2
+ */
+static size_t reference_utf8_to_ucs2(const char *src, ssize_t srcLen, UCS2CHAR *dst, size_t dstLen)
+{
+   size_t len = (srcLen == -1) ? strlen(src) + 1 : srcLen;
+   const BYTE *s = reinterpret_cast<const BYTE*>(src);
+   size_t dcount = 0;
+   while((len > 0) && (dcount < dstLen))
+   {
+      UCS4CHAR ch = ReferenceCodePointFromUTF8(s, len);
+      if (ch <= 0xFFFF)
+      {
+         dst[dcount++] = static_cast<UCS2CHAR>(ch);
+      }
+      else if (ch <= 0x10FFFF)
+      {
+         if (dcount > dstLen - 2)
+            break;
+         ch -= 0x10000;
+         dst[dcount++] = static_cast<UCS2CHAR>((ch >> 10) | 0xD800);
+         dst[dcount++] = static_cast<UCS2CHAR>((ch & 0x3FF) | 0xDC00);
+      }
+   }
+   if ((srcLen == -1) && (dcount == dstLen) && (dstLen > 0))
+      dst[dcount - 1] = 0;
+   return dcount;
+}
+
+/**
+ * Reference implementation of utf8_ucs4len and utf8_ucs2len
+ */
+static size_t reference_utf8_len(const char *src, ssize_t srcLen, bool ucs2)
+{
+   size_t len = (srcLen == -1) ? strlen(src) + 1 : srcLen;
+   const BYTE *s = reinterpret_cast<const BYTE*>(src);
+   size_t dcount = 0;
+   while(len > 0)
+   {
+      UCS4CHAR ch = ReferenceCodePointFromUTF8(s, len);
+      dcount += (ucs2 && (ch > 0xFFFF)) ? 2 : 1;
+   }
+   return dcount;
+}
+
+/**
+ * Encode code point as UTF-8 (returns 0 if there is not enough space in buffer or code point is invalid)
+ */
+static size_t ReferenceEncodeUTF8(UCS4CHAR ch, char *d, size_t space)
+{
+   size_t n = (ch <= 0x7F) ? 1 : (ch <= 0x7FF) ? 2 : (ch <= 0xFFFF) ? 3 : (ch <= 0x10FFFF) ? 4 : 0;
+   if ((n == 0) || (n > space))
+      return 0;
+   static const BYTE prefix[] = { 0, 0, 0xC0, 0xE0, 0xF0 };
+   for(size_t i = n - 1; i > 0; i--, ch >>= 6)
+      d[i] = static_cast<char>((ch & 0x3F) | 0x80);
+   d[0] = static_cast<char>(ch | prefix[n]);
+   return n;
+}
+
+/**
+ * Reference implementation of ucs4_to_utf8
+ */
+static size_t reference_ucs4_to_utf8(const UCS4CHAR *src, ssize_t srcLen, char *dst, size_t dstLen)
+{
+   size_t len = (srcLen == -1) ? ucs4_strlen(src) + 1 : srcLen;
+   size_t dcount = 0;
+   for(size_t i = 0; (i < len) && (dcount < dstLen); i++)
+   {
+      if (src[i] > 0x10FFFF)
+         continue;
+      size_t n = ReferenceEncodeUTF8(src[i], &dst[dcount], dstLen - dcount);
+      if (n == 0)
+         break;
+      dcount += n;
+   }
+   if ((srcLen == -1) && (dcount == dstLen) && (dstLen > 0))
+      dst[dcount - 1] = 0;
+   return dcount;
+}
+
+/**
+ * Reference implementation of ucs4_utf8len
+ */
+static size_t reference_ucs4_utf8len(const UCS4CHAR *src, ssize_t srcLen)
+{
+   size_t len = (srcLen == -1) ? ucs4_strlen(src) + 1 : srcLen;
+   size_t dcount = 0;
+   for(size_t i = 0; i < len; i++)
+      dcount += (src[i] <= 0x7F) ? 1 : (src[i] <= 0x7FF) ? 2 : (src[i] <= 0xFFFF) ? 3 : (src[i] <= 0x10FFFF) ? 4 : 0;
+   return dcount;
+}
+
+/**
+ * Reference implementation of ucs4_ucs2len
+ */
+static size_t reference_ucs4_ucs2len(const UCS4CHAR *src, ssize_t srcLen)
+{
+   size_t len = (srcLen == -1) ? ucs4_strlen(src) + 1 : srcLen;
+   size_t dcount = len;
+   for(size_t i = 0; i < len; i++)
+      if (src[i] > 0xFFFF)
+         dcount++;
+   return dcount;
+}
+
+/**
+ * Reference implementation of ucs2_to_ucs4
+ */
+static size_t reference_ucs2_to_ucs4(const UCS2CHAR *src, ssize_t srcLen, UCS4CHAR *dst, size_t dstLen)
+{
+   size_t len = (srcLen == -1) ? ucs2_strlen(src) + 1 : srcLen;
+   size_t dcount = 0;
+   for(size_t i = 0; (i < len) && (dcount < dstLen); i++)
+   {
+      UCS2CHAR ch = src[i];
+      if ((ch & 0xFC00) == 0xD800)
+      {
+         if ((i + 1 < len) && ((src[i + 1] & 0xFC00) == 0xDC00))
+         {
+            dst[dcount++] = ((static_cast<UCS4CHAR>(ch & 0x03FF) << 10) | (src[i + 1] & 0x03FF)) + 0x10000;
+            i++;
+         }
+      }
+      else if ((ch & 0xFC00) != 0xDC00)
+      {
+         dst[dcount++] = ch;
+      }
+   }
+   if ((srcLen == -1) && (dcount == dstLen) && (dstLen > 0))
+      dst[dcount - 1] = 0;
+   return dcount;
+}
+
+/**
+ * Simple deterministic pseudo-random generator for test data
+ */
+static uint32_t s_seed = 0x12345678;
+static inline uint32_t NextRandom(uint32_t range)
+{
+   s_seed = s_seed * 1103515245 + 12345;
+   return (s_seed >> 8) % range;
+}
+
+/**
+ * Generate UTF-8 test string with long ASCII runs, valid multibyte sequences and malformed input.
+ * Generated string does not contain 0 bytes. Returns string length.
+ */
+static size_t GenerateUTF8TestString(char *buffer, size_t size)
+{
+   size_t pos = 0;
+   while(pos < size - 8)
+   {
+      switch(NextRandom(8))
+      {
+         case 0:  // ASCII run
+         case 1:
+         case 2:
+            for(uint32_t n = NextRandom(80); (n > 0) && (pos < size - 8); n--)
+               buffer[pos++] = static_cast<char>(NextRandom(127) + 1);
+            break;
+         case 3:  // valid multibyte sequence
+            pos += ReferenceEncodeUTF8(0x80 + NextRandom(0x10FF80), &buffer[pos], 4);
+            break;
+         case 4:  // unexpected continuation byte
+            buffer[pos++] = static_cast<char>(0x80 + NextRandom(64));
+            break;
+         case 5:  // truncated sequence
+            buffer[pos++] = static_cast<char>(0xE0 + NextRandom(16));
+            buffer[pos++] = static_cast<char>(0x80 + NextRandom(64));
+            break;
+         case 6:  // invalid lead byte
+            buffer[pos++] = static_cast<char>(0xF8 + NextRandom(8));
+            break;
+         case 7:  // overlong encoding of ASCII character
+            buffer[pos++] = static_cast<char>(0xC0);
+            buffer[pos++] = static_cast<char>(0x80 + NextRandom(64));
+            break;
+      }
+   }
+   buffer[pos] = 0;
+   return pos;
+}
+
+/**
+ * Generate UCS-4 test string (including code points outside of valid range). Returns string length.
+ */
+static size_t GenerateUCS4TestString(UCS4CHAR *buffer, size_t size)
+{
+   size_t pos = 0;
+   while(pos < size - 1)
+   {
+      switch(NextRandom(6))
+      {
+         case 0:  // ASCII run
+         case 1:
+         case 2:
+            for(uint32_t n = NextRandom(80); (n > 0) && (pos < size - 1); n--)
+               buffer[pos++] = NextRandom(127) + 1;
+            break;
+         case 3:
+            buffer[pos++] = 0x80 + NextRandom(0xFF80);
+            break;
+         case 4:
+            buffer[pos++] = 0x10000 + NextRandom(0x100000);
+            break;
+         case 5:  // invalid code point
+            buffer[pos++] = 0x110000 + NextRandom(0x7FFFFFFF);
+            break;
+      }
+   }
+   buffer[pos] = 0;
+   return pos;
+}
+
+/**
+ * Generate UCS-2 test string (including unpaired surrogates). Returns string length.
+ */
+static size_t GenerateUCS2TestString(UCS2CHAR *buffer, size_t size)
+{
+   size_t pos = 0;
+   while(pos < size - 2)
+   {
+      switch(NextRandom(6))
+      {
+         case 0:  // ASCII run
+         case 1:
+         case 2:
+            for(uint32_t n = NextRandom(80); (n > 0) && (pos < size - 2); n--)
+               buffer[pos++] = static_cast<UCS2CHAR>(NextRandom(127) + 1);
+            break;
+         case 3:
+            buffer[pos++] = static_cast<UCS2CHAR>(0x80 + NextRandom(0xD780));
+            break;
+         case 4:  // surrogate pair
+            buffer[pos++] = static_cast<UCS2CHAR>(0xD800 + NextRandom(0x400));
+            buffer[pos++] = static_cast<UCS2CHAR>(0xDC00 + NextRandom(0x400));
+            break;
+         case 5:  // unpaired surrogate
+            buffer[pos++] = static_cast<UCS2CHAR>(0xD800 + NextRandom(0x800));
+            break;
+      }
+   }
+   buffer[pos] = 0;
+   return pos;
+}
+
+#define CONFORMANCE_BUFFER_SIZE  2048
+
+/**
+ * Test vectorized conversion functions against reference implementation
+ */
+static void TestStringConversionConformance(const TCHAR *name)
+{
+   char utf8[CONFORMANCE_BUFFER_SIZE], utf8out[CONFORMANCE_BUFFER_SIZE], utf8ref[CONFORMANCE_BUFFER_SIZE];
+   UCS2CHAR ucs2[CONFORMANCE_BUFFER_SIZE], ucs2out[CONFORMANCE_BUFFER_SIZE], ucs2ref[CONFORMANCE_BUFFER_SIZE];
+   UCS4CHAR ucs4[CONFORMANCE_BUFFER_SIZE], ucs4out[CONFORMANCE_BUFFER_SIZE], ucs4ref[CONFORMANCE_BUFFER_SIZE];
+
+   StartTest(_T("UTF-8 conversion conformance"), name);
+   for(int i = 0; i < 500; i++)
+   {
+      size_t len = GenerateUTF8TestString(utf8, NextRandom(CONFORMANCE_BUFFER_SIZE - 16) + 16);
+      ssize_t srcLen = (i % 2 == 0) ? -1 : static_cast<ssize_t>(len - NextRandom(static_cast<uint32_t>(len)));
+      size_t dstLen = (i % 3 == 0) ? NextRandom(static_cast<uint32_t>(len) + 2) + 1 : CONFORMANCE_BUFFER_SIZE;
+
+      memset(ucs4out, 0x7F, sizeof(ucs4out));
+      memset(ucs4ref, 0x7F, sizeof(ucs4ref));
+      AssertEquals(utf8_to_ucs4(utf8, srcLen, ucs4out, dstLen), reference_utf8_to_ucs4(utf8, srcLen, ucs4ref, dstLen));
+      AssertTrue(!memcmp(ucs4out, ucs4ref, sizeof(ucs4out)));
+
+      memset(ucs2out, 0x7F, sizeof(ucs2out));
+      memset(ucs2ref, 0x7F, sizeof(ucs2ref));
+      AssertEquals(utf8_to_ucs2(utf8, srcLen, ucs2out, dstLen), reference_utf8_to_ucs2(utf8, srcLen, ucs2ref, dstLen));
+      AssertTrue(!memcmp(ucs2out, ucs2ref, sizeof(ucs2out)));
+
+      AssertEquals(utf8_ucs4len(utf8, srcLen), reference_utf8_len(utf8, srcLen, false));
+      AssertEquals(utf8_ucs2len(utf8, srcLen), reference_utf8_len(utf8, srcLen, true));
+   }
+   EndTest();
+
+   StartTest(_T("UCS-4 conversion conformance"), name);
+   for(int i = 0; i < 500; i++)
+   {
+      size_t len = GenerateUCS4TestString(ucs4, NextRandom(CONFORMANCE_BUFFER_SIZE / 4 - 16) + 16);
+      ssize_t srcLen = (i % 2 == 0) ? -1 : static_cast<ssize_t>(len - NextRandom(static_cast<uint32_t>(len)));
+      size_t dstLen = (i % 3 == 0) ? NextRandom(static_cast<uint32_t>(len) * 4 + 2) + 1 : CONFORMANCE_BUFFER_SIZE;
+
+      memset(utf8out, 0x7F, sizeof(utf8out));
+      memset(utf8ref, 0x7F, sizeof(utf8ref));
+      AssertEquals(ucs4_to_utf8(ucs4, srcLen, utf8out, dstLen), reference_ucs4_to_utf8(ucs4, srcLen, utf8ref, dstLen));
+      AssertTrue(!memcmp(utf8out, utf8ref, sizeof(utf8out)));
+
+      AssertEquals(ucs4_utf8len(ucs4, srcLen), reference_ucs4_utf8len(ucs4, srcLen));
+      AssertEquals(ucs4_ucs2len(ucs4, srcLen), reference_ucs4_ucs2len(ucs4, srcLen));
+   }
+   EndTest();
+
+   StartTest(_T("UCS-2 conversion conformance"), name);
+   for(int i = 0; i < 500; i++)
+   {
+      size_t len = GenerateUCS2TestString(ucs2, NextRandom(CONFORMANCE_BUFFER_SIZE - 16) + 16);
+      ssize_t srcLen = (i % 2 == 0) ? -1 : static_cast<ssize_t>(len - NextRandom(static_cast<uint32_t>(len)));
+      size_t dstLen = (i % 3 == 0) ? NextRandom(static_cast<uint32_t>(len) + 2) + 1 : CONFORMANCE_BUFFER_SIZE;
+
+      memset(ucs4out, 0x7F, sizeof(ucs4out));
+      memset(ucs4ref, 0x7F, sizeof(ucs4ref));
+      AssertEquals(ucs2_to_ucs4(ucs2, srcLen, ucs4out, dstLen), reference_ucs2_to_ucs4(ucs2, srcLen, ucs4ref, dstLen));
+      AssertTrue(!memcmp(ucs4out, ucs4ref, sizeof(ucs4out)));
+
+      memcpy(ucs2out, ucs2, sizeof(ucs2));
+      memcpy(ucs2ref, ucs2, sizeof(ucs2));
+      int swapLen = (i % 2 == 0) ? -1 : static_cast<int>(srcLen);
+      bswap_array_16(reinterpret_cast<UINT16*>(ucs2out), swapLen);
+      for(size_t j = 0; (swapLen < 0) ? (ucs2ref[j] != 0) : (j < static_cast<size_t>(swapLen)); j++)
+         ucs2ref[j] = bswap_16(ucs2ref[j]);
+      AssertTrue(!memcmp(ucs2out, ucs2ref, sizeof(ucs2out)));
+   }
+   EndTest();
+}
+
+#define BENCHMARK_STRING_SIZE    65536
+
+/**
+ * Measure throughput of conversion functions on long ASCII strings
+ */
+static void TestStringConversionThroughput(const TCHAR *name)
+{
+   char *utf8 = MemAllocArrayNoInit<char>(BENCHMARK_STRING_SIZE);
+   UCS2CHAR *ucs2 = MemAllocArrayNoInit<UCS2CHAR>(BENCHMARK_STRING_SIZE);
+   UCS4CHAR *ucs4 = MemAllocArrayNoInit<UCS4CHAR>(BENCHMARK_STRING_SIZE);
+   for(int i = 0; i < BENCHMARK_STRING_SIZE - 1; i++)
+      utf8[i] = mbText[i % (sizeof(mbText) - 1)];
+   utf8[BENCHMARK_STRING_SIZE - 1] = 0;
+
+   StartTest(_T("UTF-8 to UCS-4 throughput (64K ASCII x 1000)"), name);
+   INT64 start = GetCurrentTimeMs();
+   for(int i = 0; i < 1000; i++)
+      utf8_to_ucs4(utf8, -1, ucs4, BENCHMARK_STRING_SIZE);
+   EndTest(GetCurrentTimeMs() - start);
+
+   StartTest(_T("UCS-4 to UTF-8 throughput (64K ASCII x 1000)"), name);
+   start = GetCurrentTimeMs();
+   for(int i = 0; i < 1000; i++)
+      ucs4_to_utf8(ucs4, -1, utf8, BENCHMARK_STRING_SIZE);
+   EndTest(GetCurrentTimeMs() - start);
+
+   StartTest(_T("UTF-8 length (64K ASCII x 1000)"), name);
+   start = GetCurrentTimeMs();
+   size_t total = 0;
+   for(int i = 0; i < 1000; i++)
+      total += utf8_ucs4len(utf8, BENCHMARK_STRING_SIZE - 1);
+   EndTest(GetCurrentTimeMs() - start);
+   AssertEquals(total, static_cast<size_t>(BENCHMARK_STRING_SIZE - 1) * 1000);
+
+   StartTest(_T("UCS-2 to UCS-4 throughput (64K ASCII x 1000)"), name);
+   utf8_to_ucs2(utf8, -1, ucs2, BENCHMARK_STRING_SIZE);
+   start = GetCurrentTimeMs();
+   for(int i = 0; i < 1000; i++)
+      ucs2_to_ucs4(ucs2, BENCHMARK_STRING_SIZE, ucs4, BENCHMARK_STRING_SIZE);
+   EndTest(GetCurrentTimeMs() - start);
+
+   StartTest(_T("bswap_array_16 throughput (64K x 1000)"), name);
+   start = GetCurrentTimeMs();
+   for(int i = 0; i < 1000; i++)
+      bswap_array_16(reinterpret_cast<UINT16*>(ucs2), BENCHMARK_STRING_SIZE);
+   EndTest(GetCurrentTimeMs() - start);
+
+   MemFree(utf8);
+   MemFree(ucs2);
+   MemFree(ucs4);
+}
+
+/**
+ * Test vectorized string conversion with all available instruction sets
+ */
+void TestVectorizedStringConversion()
+{
+   static const TCHAR *levelNames[] = { _T("scalar"), _T("SSE2"), _T("AVX2") };
+   for(int level = 0; level <= 2; level++)
+   {
+      if (SetUnicodeConversionSIMDLevel(level) != level)
+         break;   // not supported by this CPU or build
+      TestStringConversionConformance(levelNames[level]);
+#if !WITH_ADDRESS_SANITIZER
+      TestStringConversionThroughput(levelNames[level]);
+#endif
+   }
+   SetUnicodeConversionSIMDLevel(-1);
+}
@@ -142,4 +142,122 @@ void TestMessageClass()
    }
    EndTest(GetCurrentTimeMs() - start);
 #endif
+
+   StartTest(_T("NXCP message with large number of fields"));
+
+   NXCPMessage lmsg(CMD_REQUEST_COMPLETED, 1);
+   for(uint32_t i = 0; i < 6000; i++)
+   {
+      uint32_t fieldId = VID_VARLIST_BASE + i;
+      switch(i % 4)
+      {
+         case 0:
+            lmsg.setField(fieldId, i);
+            break;
+         case 1:
+            lmsg.setField(fieldId, static_cast<UINT64>(i) << 32);
+            break;
+         case 2:
+            _sntprintf(buffer, 64, _T("value %u"), i);
+            lmsg.setField(fieldId, buffer);
+            break;
+         case 3:
+            lmsg.setField(fieldId, reinterpret_cast<const BYTE*>(&i), sizeof(i));
+            break;
+      }
+   }
+
+   // Replace some fields with values of different type and size
+   lmsg.setField(VID_VARLIST_BASE + 2, _T("replaced value with longer text"));
+   lmsg.setField(VID_VARLIST_BASE + 5000, static_cast<UINT16>(5000));
+   AssertTrue(!_tcscmp(lmsg.getFieldAsString(VID_VARLIST_BASE + 2, buffer, 64), _T("replaced value with longer text")));
+   AssertEquals(lmsg.getFieldAsUInt16(VID_VARLIST_BASE + 5000), 5000);
+   AssertFalse(lmsg.isFieldExist(VID_VARLIST_BASE + 6000));
+
+   binMsg = lmsg.serialize(false);
+   AssertNotNull(binMsg);
+   AssertEquals(ntohl(binMsg->numFields), 6000);
+   AssertEquals(ntohl(binMsg->size) % 8, 0);
+
+   dmsg = NXCPMessage::deserialize(binMsg);
+   AssertNotNull(dmsg);
+   AssertEquals(dmsg->getCode(), CMD_REQUEST_COMPLETED);
+   for(uint32_t i = 0; i < 6000; i++)
+   {
+      uint32_t fieldId = VID_VARLIST_BASE + i;
+      if (i == 2)
+      {
+         AssertTrue(!_tcscmp(dmsg->getFieldAsString(fieldId, buffer, 64), _T("replaced value with longer text")));
+         continue;
+      }
+      if (i == 5000)
+      {
+         AssertEquals(dmsg->getFieldAsUInt16(fieldId), 5000);
+         continue;
+      }
+      switch(i % 4)
+      {
+         case 0:
+            AssertEquals(dmsg->getFieldAsUInt32(fieldId), i);
+            break;
+         case 1:
+            AssertEquals(dmsg->getFieldAsUInt64(fieldId), static_cast<UINT64>(i) << 32);
+            break;
+         case 2:
+            {
+               TCHAR expected[64];
+               _sntprintf(expected, 64, _T("value %u"), i);
+               AssertTrue(!_tcscmp(dmsg->getFieldAsString(fieldId, buffer, 64), expected));
+            }
+            break;
+         case 3:
+            {
+               uint32_t value = 0;
+               AssertEquals(dmsg->getFieldAsBinary(fieldId, reinterpret_cast<BYTE*>(&value), sizeof(value)), sizeof(value));
+               AssertEquals(value, i);
+            }
+            break;
+      }
+   }
+
+   // Serialized form of deserialized message should be identical to original
+   NXCP_MESSAGE *binMsg2 = dmsg->serialize(false);
+   AssertNotNull(binMsg2);
+   AssertEquals(ntohl(binMsg2->size), ntohl(binMsg->size));
+   AssertTrue(!memcmp(binMsg, binMsg2, ntohl(binMsg->size)));
+   MemFree(binMsg2);
+
+   NXCPMessage cmsg(dmsg);
+   binMsg2 = cmsg.serialize(false);
+   AssertNotNull(binMsg2);
+   AssertTrue(!memcmp(binMsg, binMsg2, ntohl(binMsg->size)));
+   MemFree(binMsg2);
+
+   delete dmsg;
+   MemFree(binMsg);
+
+   EndTest();
+
+#if !WITH_ADDRESS_SANITIZER
+   StartTest(_T("NXCP message build/serialize/parse performance"));
+   start = GetCurrentTimeMs();
+   for(int i = 0; i < 20000; i++)
+   {
+      NXCPMessage pmsg(CMD_REQUEST_COMPLETED, i);
+      for(uint32_t j = 0; j < 50; j++)
+      {
+         if (j % 2 == 0)
+            pmsg.setField(VID_VARLIST_BASE + j, j);
+         else
+            pmsg.setField(VID_VARLIST_BASE + j, _T("performance test value"));
+      }
+      NXCP_MESSAGE *rawMsg = pmsg.serialize(false);
+      NXCPMessage *rmsg = NXCPMessage::deserialize(rawMsg);
+      AssertNotNull(rmsg);
+      AssertEquals(rmsg->getFieldAsUInt32(VID_VARLIST_BASE + 48), 48);
+      delete rmsg;
+      MemFree(rawMsg);
+   }
+   EndTest(GetCurrentTimeMs() - start);
+#endif
 }
@@ -26,6 +26,7 @@ void TestThreadCountAndMaxWaitTime();
 void TestProcessExecutor(const char *procname);
 void TestProcessExecutorWorker();
 void TestStringConversion();
+void TestVectorizedStringConversion();
 void TestSubProcess(const char *procname);
 NXCPMessage *TestSubProcessRequestHandler(UINT16 command, const void *data, size_t dataSize);
 
@@ -1712,10 +1713,92 @@ static void TestDebugTags()
    EndTest(GetCurrentTimeMs() - startTime);
 #endif
 
+   StartTest(_T("Debug tags: cached level lookup"));
+   TCHAR buffer[64];
+   _tcscpy(buffer, _T("cache.test.first"));
+   nxlog_set_debug_level_tag(_T("cache.test.first"), 6);
+   AssertEquals(nxlog_get_debug_level_tag(buffer), 6);
+   _tcscpy(buffer, _T("cache.test.second"));
+   AssertEquals(nxlog_get_debug_level_tag(buffer), nxlog_get_debug_level());
+   nxlog_set_debug_level_tag(_T("cache.test.second"), 3);
+   AssertEquals(nxlog_get_debug_level_tag(buffer), 3);
+   nxlog_set_debug_level_tag(_T("cache.test.second"), -1);
+   AssertEquals(nxlog_get_debug_level_tag(buffer), nxlog_get_debug_level());
+   EndTest();
+
    StartTest(_T("Debug tags: reset"));
    nxlog_reset_debug_level_tags();
    AssertEquals(nxlog_get_debug_level_tag(_T("test.tag1.subtag1")), nxlog_get_debug_level());
    EndTest();
+
+#if !WITH_ADDRESS_SANITIZER
+   StartTest(_T("nxlog_debug_tag() performance (disabled tag)"));
+   nxlog_set_debug_level_tag(_T("test.enabled"), 5);
+   startTime = GetCurrentTimeMs();
+   for(int i = 0; i < 1000000; i++)
+   {
+      nxlog_debug_tag(_T("test.disabled"), 6, _T("Disabled debug message %d"), i);
+      nxlog_debug_tag(_T("test.disabled"), 3, _T("Disabled debug message %d"), i);
+   }
+   EndTest(GetCurrentTimeMs() - startTime);
+   nxlog_reset_debug_level_tags();
+#endif
+}
+
+/**
+ * Number of messages written by each log writer test thread
+ */
+#define LOG_WRITER_MESSAGES   5000
+
+/**
+ * Log writer test thread
+ */
+static void LogWriterThread(int id)
+{
+   for(int i = 0; i < LOG_WRITER_MESSAGES; i++)
+      nxlog_write_tag(NXLOG_INFO, _T("test.writer"), _T("Writer %d message %d"), id, i);
+}
+
+/**
+ * Test background log writer
+ */
+static void TestLogWriter()
+{
+   StartTest(_T("Background log writer"));
+   const TCHAR *logFile = _T("test-libnetxms.log");
+   _tremove(logFile);
+   AssertTrue(nxlog_open(logFile, NXLOG_BACKGROUND_WRITER));
+
+   THREAD threads[8];
+   for(int i = 0; i < 8; i++)
+      threads[i] = ThreadCreateEx(LogWriterThread, i);
+   for(int i = 0; i < 8; i++)
+      ThreadJoin(threads[i]);
+   nxlog_close();
+
+   FILE *f = _tfopen(logFile, _T("r"));
+   AssertNotNull(f);
+   int lastMessage[8];
+   for(int i = 0; i < 8; i++)
+      lastMessage[i] = -1;
+   int count = 0;
+   char line[256];
+   while(fgets(line, 256, f) != NULL)
+   {
+      const char *p = strstr(line, "Writer ");
+      if (p == NULL)
+         continue;
+      int id, n;
+      AssertEquals(sscanf(p, "Writer %d message %d", &id, &n), 2);
+      AssertTrue((id >= 0) && (id < 8));
+      AssertEquals(n, lastMessage[id] + 1);
+      lastMessage[id] = n;
+      count++;
+   }
+   fclose(f);
+   _tremove(logFile);
+   AssertEquals(count, 8 * LOG_WRITER_MESSAGES);
+   EndTest();
 }
 
 /**
@@ -1765,6 +1848,7 @@ int main(int argc, char *argv[])
    TestObjectMemoryPool();
    TestString();
    TestStringConversion();
+   TestVectorizedStringConversion();
    TestStringList();
    TestStringMap();
    TestStringSet();
@@ -1794,6 +1878,7 @@ int main(int argc, char *argv[])
    TestRingBuffer();
    TestDebugLevel();
    TestDebugTags();
+   TestLogWriter();
    TestProcessExecutor(argv[0]);
    TestSubProcess(argv[0]);
    TestThreadPool();
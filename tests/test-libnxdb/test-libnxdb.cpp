@@ -123,6 +123,92 @@ static void CommonTests(const TCHAR *prefix, const TCHAR *driver, const TCHAR *s
    AssertEquals(count, 200);
    EndTest();
 
+   /*** statement cache ***/
+   StartTest(prefix, _T("statement cache hit"));
+   DBSetStatementCacheSize(2);
+   hStmt = DBPrepareCached(session, _T("SELECT value1 FROM nx_test WHERE id=?"));
+   AssertNotNull(hStmt);
+   DBFreeStatement(hStmt);
+   DB_STATEMENT hStmtCached = DBPrepareCached(session, _T("SELECT value1 FROM nx_test WHERE id=?"));
+   AssertTrue(hStmtCached == hStmt);
+   DBBind(hStmtCached, 1, DB_SQLTYPE_INTEGER, (INT32)10);
+   hResult = DBSelectPrepared(hStmtCached);
+   AssertNotNull(hResult);
+   AssertEquals(DBGetNumRows(hResult), 1);
+   DBFreeResult(hResult);
+   hStmt = DBPrepareCached(session, _T("SELECT value1 FROM nx_test WHERE id=?"));  // cached statement is in use
+   AssertNotNull(hStmt);
+   AssertTrue(hStmt != hStmtCached);
+   DBFreeStatement(hStmt);
+   DBFreeStatement(hStmtCached);
+   uint32_t hits, misses;
+   int cacheSize;
+   DBGetStatementCacheStats(session, &hits, &misses, &cacheSize);
+   AssertEquals(hits, 1);
+   AssertEquals(misses, 2);
+   AssertEquals(cacheSize, 1);
+   EndTest();
+
+   StartTest(prefix, _T("statement cache eviction"));
+   hStmt = DBPrepareCached(session, _T("SELECT value1 FROM nx_test WHERE id>?"));
+   AssertNotNull(hStmt);
+   DBFreeStatement(hStmt);
+   hStmt = DBPrepareCached(session, _T("SELECT value2_new FROM nx_test WHERE id=?"));
+   AssertNotNull(hStmt);
+   DBFreeStatement(hStmt);
+   DBGetStatementCacheStats(session, &hits, &misses, &cacheSize);
+   AssertEquals(cacheSize, 2);
+   hStmt = DBPrepareCached(session, _T("SELECT value1 FROM nx_test WHERE id=?"));  // least recently used, should be evicted
+   AssertNotNull(hStmt);
+   DBFreeStatement(hStmt);
+   DBGetStatementCacheStats(session, &hits, &misses, &cacheSize);
+   AssertEquals(hits, 1);
+   AssertEquals(misses, 5);
+   AssertEquals(cacheSize, 2);
+   hStmt = DBPrepare(session, _T("SELECT value1 FROM nx_test WHERE id<?"), true);  // not cached without explicit request
+   AssertNotNull(hStmt);
+   DBFreeStatement(hStmt);
+   DBGetStatementCacheStats(session, &hits, &misses, &cacheSize);
+   AssertEquals(misses, 5);
+   EndTest();
+
+   // Reconnect and disconnect release statement cache in the same way (reconnect cannot be triggered on demand)
+   StartTest(prefix, _T("statement cache release"));
+   DB_HANDLE session2 = DBConnect(drv, server, dbName, login, password, NULL, buffer);
+   AssertNotNull(session2);
+   if (DBIsTableExist(session2, _T("nx_cache_test")) == DBIsTableExist_Found)
+      DBQuery(session2, _T("DROP TABLE nx_cache_test"));
+   AssertTrueEx(DBQueryEx(session2, _T("CREATE TABLE nx_cache_test (id integer not null, PRIMARY KEY(id))"), buffer), buffer);
+   hStmtCached = DBPrepareCached(session2, _T("SELECT id FROM nx_cache_test WHERE id=?"));
+   AssertNotNull(hStmtCached);
+   hStmt = DBPrepareCached(session2, _T("SELECT id FROM nx_cache_test WHERE id>?"));
+   AssertNotNull(hStmt);
+   DBFreeStatement(hStmt);
+   DBGetStatementCacheStats(session2, NULL, NULL, &cacheSize);
+   AssertEquals(cacheSize, 2);
+   DBDisconnect(session2);
+   DBFreeStatement(hStmtCached);  // statement given out before disconnect should be destroyed normally
+   if (DBIsTableExist(session, _T("nx_cache_test")) == DBIsTableExist_Found)
+      DBQuery(session, _T("DROP TABLE nx_cache_test"));
+   DBSetStatementCacheSize(32);
+   EndTest();
+
+   /*** cache table ***/
+   StartTest(prefix, _T("cache table with integer key"));
+   DB_HANDLE cacheDB = DBOpenInMemoryDatabase();
+   AssertNotNull(cacheDB);
+   static const TCHAR *intColumns[] = { _T("id"), NULL };
+   AssertTrue(DBCacheTable(cacheDB, session, _T("nx_test"), _T("id"), _T("*"), intColumns));
+   hResult = DBSelectEx(cacheDB, _T("SELECT id FROM nx_test WHERE id IN (9,10,99,100,999,1000) ORDER BY id"), buffer);
+   AssertNotNullEx(hResult, buffer);
+   AssertEquals(DBGetNumRows(hResult), 6);
+   static const INT32 expectedIds[] = { 9, 10, 99, 100, 999, 1000 };
+   for(int i = 0; i < 6; i++)
+      AssertEquals(DBGetFieldLong(hResult, i, 0), expectedIds[i]);
+   DBFreeResult(hResult);
+   DBCloseInMemoryDatabase(cacheDB);
+   EndTest();
+
    /*** drop test table ***/
    StartTest(prefix, _T("drop test table"));
    AssertTrue(DBQuery(session, _T("DROP TABLE nx_test")));
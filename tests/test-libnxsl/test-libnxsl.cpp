@@ -8,6 +8,14 @@ static TCHAR *s_testScriptDirectory = nullptr;
 static const TCHAR *s_prog1 = _T("a = 1;\nb = 2;\nreturn a + b;");
 static const TCHAR *s_prog2 = _T("a = 1;\nb = {;\nreturn a + b;");
 
+/**
+ * Benchmark scripts (each one stresses specific compile time optimization)
+ */
+static const TCHAR *s_benchCompareJump = _T("n = 0;\nfor(i = 0; i < 1000000; i++)\n   if (i % 4 == 0)\n      n++;\nreturn n;");
+static const TCHAR *s_benchNamedConstants = _T("const LIMIT = 1000000, STEP = 2, INCREMENT = 3;\nn = 0;\nfor(i = 0; i < LIMIT; i += STEP)\n   n += INCREMENT;\nreturn n;");
+static const TCHAR *s_benchConstantFolding = _T("n = 0;\nfor(i = 0; i < 500000; i++)\n   n += 60 * 60 * 24 - 86400 + (2 + 3) * 2 - 8;\nreturn n;");
+static const TCHAR *s_benchRegexp = _T("n = 0;\nfor(i = 0; i < 200000; i++)\n   if ((\"eth\" . (i % 48)) ~= \"^eth([0-9]+)$\")\n      n++;\nreturn n;");
+
 /**
  * Test NXSL compiler
  */
@@ -43,6 +51,111 @@ static void TestCompiler()
    EndTest();
 }
 
+/**
+ * Scripts for regular expression tests
+ */
+static const TCHAR *s_regexpConst = _T("n = 0;\nfor(i = 0; i < 100; i++)\n   if ((\"eth\" . i) ~= \"^eth([0-9]+)$\")\n      n++;\nreturn n;");
+static const TCHAR *s_regexpInvalidConst = _T("s = \"abc\";\nreturn s ~= \"^(abc\";");
+static const TCHAR *s_regexpCacheHit = _T("p = \"^cache-hit-([0-9]+)$\";\nn = 0;\nfor(i = 0; i < 10; i++)\n   if ((\"cache-hit-\" . i) ~= p)\n      n++;\nreturn n;");
+static const TCHAR *s_regexpCacheFlags = _T("p = \"^CaseTest$\";\nn = 0;\nif (\"casetest\" imatch p) n += 1;\nif (\"casetest\" match p) n += 2;\nif (\"CaseTest\" match p) n += 4;\nreturn n;");
+static const TCHAR *s_regexpCacheFill = _T("n = 0;\nfor(i = 0; i < 300; i++)\n   if ((\"evict-\" . i) ~= (\"^evict-\" . i . \"$\"))\n      n++;\nreturn n;");
+static const TCHAR *s_regexpCacheOldest = _T("p = \"^evict-0$\";\nreturn (\"evict-0\" ~= p) ? 1 : 0;");
+static const TCHAR *s_regexpCacheNewest = _T("p = \"^evict-299$\";\nreturn (\"evict-299\" ~= p) ? 1 : 0;");
+
+/**
+ * Run script and check that it returns expected integer value
+ */
+static void RunRegexpScript(const TCHAR *source, INT32 expectedResult)
+{
+   TCHAR errorMessage[256];
+   NXSL_VM *vm = NXSLCompileAndCreateVM(source, errorMessage, 256, new NXSL_Environment());
+   AssertNotNull(vm);
+   AssertTrueEx(vm->run(), vm->getErrorText());
+   AssertNotNull(vm->getResult());
+   AssertEquals(vm->getResult()->getValueAsInt32(), expectedResult);
+   delete vm;
+}
+
+/**
+ * Test constant regular expressions and regular expression cache
+ */
+static void TestRegexp()
+{
+   uint32_t hits, misses, hitsBefore, missesBefore;
+   int size;
+
+   StartTest(_T("Constant regular expression"));
+   NXSLGetRegexpCacheStats(&hitsBefore, &missesBefore, nullptr);
+   RunRegexpScript(s_regexpConst, 100);
+   NXSLGetRegexpCacheStats(&hits, &misses, nullptr);
+   AssertEquals(hits, hitsBefore);   // pattern compiled by compiler, cache should not be used
+   AssertEquals(misses, missesBefore);
+   EndTest();
+
+   StartTest(_T("Invalid constant regular expression"));
+   TCHAR errorMessage[256];
+   NXSL_VM *vm = NXSLCompileAndCreateVM(s_regexpInvalidConst, errorMessage, 256, new NXSL_Environment());
+   AssertNotNull(vm);
+   AssertFalse(vm->run());
+   AssertEquals(vm->getErrorCode(), NXSL_ERR_REGEXP_ERROR);
+   delete vm;
+   EndTest();
+
+   StartTest(_T("Regular expression cache hit"));
+   NXSLGetRegexpCacheStats(&hitsBefore, &missesBefore, nullptr);
+   RunRegexpScript(s_regexpCacheHit, 10);
+   NXSLGetRegexpCacheStats(&hits, &misses, nullptr);
+   AssertEquals(misses - missesBefore, 1u);
+   AssertEquals(hits - hitsBefore, 9u);
+   EndTest();
+
+   StartTest(_T("Regular expression cache flags"));
+   NXSLGetRegexpCacheStats(&hitsBefore, &missesBefore, nullptr);
+   RunRegexpScript(s_regexpCacheFlags, 5);
+   NXSLGetRegexpCacheStats(&hits, &misses, nullptr);
+   AssertEquals(misses - missesBefore, 2u);   // separate entries for case sensitive and case insensitive match
+   AssertEquals(hits - hitsBefore, 1u);
+   EndTest();
+
+   StartTest(_T("Regular expression cache eviction"));
+   NXSLGetRegexpCacheStats(&hitsBefore, &missesBefore, nullptr);
+   RunRegexpScript(s_regexpCacheFill, 300);
+   NXSLGetRegexpCacheStats(&hits, &misses, &size);
+   AssertEquals(misses - missesBefore, 300u);
+   AssertEquals(size, 256);
+   RunRegexpScript(s_regexpCacheNewest, 1);
+   NXSLGetRegexpCacheStats(&hitsBefore, &missesBefore, nullptr);
+   AssertEquals(hitsBefore - hits, 1u);
+   AssertEquals(missesBefore, misses);
+   RunRegexpScript(s_regexpCacheOldest, 1);
+   NXSLGetRegexpCacheStats(&hits, &misses, &size);
+   AssertEquals(hits, hitsBefore);
+   AssertEquals(misses - missesBefore, 1u);   // least recently used pattern should be evicted
+   AssertEquals(size, 256);
+   EndTest();
+}
+
+/**
+ * Run benchmark script
+ */
+static void RunBenchmark(const TCHAR *name, const TCHAR *source, INT32 expectedResult)
+{
+   StartTest(_T("NXSL performance"), name);
+
+   TCHAR errorMessage[256];
+   NXSL_VM *vm = NXSLCompileAndCreateVM(source, errorMessage, 256, new NXSL_Environment());
+   AssertNotNull(vm);
+
+   INT64 start = GetCurrentTimeMs();
+   AssertTrue(vm->run());
+   INT64 elapsed = GetCurrentTimeMs() - start;
+   AssertNotNull(vm->getResult());
+   AssertEquals(vm->getResult()->getValueAsInt32(), expectedResult);
+
+   delete vm;
+   EndTest(elapsed);
+}
+
 /**
  * Run test NXSL script
  */
@@ -110,6 +223,7 @@ int main(int argc, char *argv[])
    }
 
    TestCompiler();
+   TestRegexp();
    RunTestScript(_T("addr.nxsl"));
    RunTestScript(_T("arrays.nxsl"));
    RunTestScript(_T("base64.nxsl"));
@@ -119,12 +233,18 @@ int main(int argc, char *argv[])
    RunTestScript(_T("json.nxsl"));
    RunTestScript(_T("like.nxsl"));
    RunTestScript(_T("math.nxsl"));
+   RunTestScript(_T("optimizer.nxsl"));
    RunTestScript(_T("regexp.nxsl"));
    RunTestScript(_T("strings.nxsl"));
    RunTestScript(_T("try-catch.nxsl"));
    RunTestScript(_T("types.nxsl"));
    RunTestScript(_T("with.nxsl"));
 
+   RunBenchmark(_T("compare and jump"), s_benchCompareJump, 250000);
+   RunBenchmark(_T("named constants"), s_benchNamedConstants, 1500000);
+   RunBenchmark(_T("constant folding"), s_benchConstantFolding, 1000000);
+   RunBenchmark(_T("regular expressions"), s_benchRegexp, 200000);
+
 #ifdef UNICODE
    MemFree(s_testScriptDirectory);
 #endif
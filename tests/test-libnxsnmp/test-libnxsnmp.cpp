@@ -142,6 +142,467 @@ static void TestVariableClass()
    EndTest();
 }
 
+/**
+ * Create synthetic MIB tree. Children are added in descending OID order to check sorting in indexed format.
+ */
+static SNMP_MIBObject *CreateTestMIBTree(uint32_t vendors, uint32_t objects)
+{
+   SNMP_MIBObject *root = new SNMP_MIBObject();
+   SNMP_MIBObject *parent = root;
+   static const uint32_t prefix[] = { 1, 3, 6, 1, 4, 1 };
+   static const TCHAR *prefixNames[] = { _T("iso"), _T("org"), _T("dod"), _T("internet"), _T("private"), _T("enterprises") };
+   for(int i = 0; i < 6; i++)
+   {
+      SNMP_MIBObject *object = new SNMP_MIBObject(prefix[i], prefixNames[i]);
+      parent->addChild(object);
+      parent = object;
+   }
+
+   TCHAR name[64], description[128];
+   for(uint32_t v = vendors; v > 0; v--)
+   {
+      _sntprintf(name, 64, _T("vendor%u"), v);
+      SNMP_MIBObject *vendor = new SNMP_MIBObject(v * 3, name, MIB_TYPE_MODID, MIB_STATUS_CURRENT, MIB_ACCESS_NOACCESS, nullptr, nullptr);
+      parent->addChild(vendor);
+      for(uint32_t o = objects; o > 0; o--)
+      {
+         _sntprintf(name, 64, _T("vendor%uObject%u"), v, o);
+         _sntprintf(description, 128, _T("Description of object %u for vendor %u"), o, v);
+         vendor->addChild(new SNMP_MIBObject(o * 70000, name, MIB_TYPE_INTEGER, MIB_STATUS_CURRENT, MIB_ACCESS_READONLY,
+                  description, (o % 2 == 0) ? _T("DisplayString") : nullptr));
+      }
+   }
+   return root;
+}
+
+/**
+ * Compare two MIB trees (optionally checking that children of second tree are sorted by OID)
+ */
+static bool CompareMIBTrees(SNMP_MIBObject *t1, SNMP_MIBObject *t2, bool sorted)
+{
+   if ((t1->getObjectId() != t2->getObjectId()) || _tcscmp(CHECK_NULL_EX(t1->getName()), CHECK_NULL_EX(t2->getName())) ||
+       _tcscmp(CHECK_NULL_EX(t1->getDescription()), CHECK_NULL_EX(t2->getDescription())) ||
+       _tcscmp(CHECK_NULL_EX(t1->getTextualConvention()), CHECK_NULL_EX(t2->getTextualConvention())) ||
+       ((t1->getType() & 0xFF) != (t2->getType() & 0xFF)) || ((t1->getStatus() & 0xFF) != (t2->getStatus() & 0xFF)) ||
+       ((t1->getAccess() & 0xFF) != (t2->getAccess() & 0xFF)))
+      return false;
+   int count = 0;
+   for(SNMP_MIBObject *c1 = t1->getFirstChild(); c1 != nullptr; c1 = c1->getNext(), count++)
+   {
+      SNMP_MIBObject *c2 = t2->findChildByID(c1->getObjectId());
+      if ((c2 == nullptr) || !CompareMIBTrees(c1, c2, sorted))
+         return false;
+   }
+   for(SNMP_MIBObject *c2 = t2->getFirstChild(); c2 != nullptr; c2 = c2->getNext())
+   {
+      if (sorted && (c2->getNext() != nullptr) && (c2->getNext()->getObjectId() <= c2->getObjectId()))
+         return false;
+      count--;
+   }
+   return count == 0;
+}
+
+/**
+ * Write copy of indexed MIB file with one field of given node replaced (fields are 32 bit
+ * values in network byte order at given offset within node record) and try to open it
+ */
+static uint32_t OpenCorruptedMIBIndex(const TCHAR *source, const TCHAR *target, uint32_t node, uint32_t fieldOffset, uint32_t value)
+{
+   size_t size;
+   BYTE *data = LoadFile(source, &size);
+   if (data == nullptr)
+      return SNMP_ERR_FILE_IO;
+
+   // Nodes offset is second field of index header, which follows file header; node record is 36 bytes long
+   uint32_t nodesOffset = ntohl(*reinterpret_cast<uint32_t*>(data + data[6] + 4));
+   *reinterpret_cast<uint32_t*>(data + nodesOffset + node * 36 + fieldOffset) = htonl(value);
+
+   FILE *f = _tfopen(target, _T("wb"));
+   if (f != nullptr)
+   {
+      fwrite(data, size, 1, f);
+      fclose(f);
+   }
+   MemFree(data);
+
+   uint32_t rc;
+   SNMP_MIBIndex *index = SNMP_MIBIndex::open(target, &rc);
+   delete index;
+   _tremove(target);
+   return rc;
+}
+
+/**
+ * Find MIB objects by OID and name in loaded MIB tree with given number of vendors and objects per vendor
+ */
+static bool FindMIBObjects(SNMP_MIBObject *root, uint32_t vendors, uint32_t objects, int oidCount, int nameCount)
+{
+   uint32_t oid[] = { 1, 3, 6, 1, 4, 1, 0, 0 };
+   for(int i = 0; i < oidCount; i++)
+   {
+      uint32_t v = i % vendors + 1;
+      uint32_t o = (i * 7) % objects + 1;
+      oid[6] = v * 3;
+      oid[7] = o * 70000;
+      SNMP_MIBObject *object = root->findByOID(oid, 8);
+      if ((object == nullptr) || (object->getObjectId() != o * 70000))
+         return false;
+   }
+   TCHAR name[64];
+   for(int i = 0; i < nameCount; i++)
+   {
+      uint32_t v = vendors - i % vendors;
+      uint32_t o = objects - (i * 3) % objects;
+      _sntprintf(name, 64, _T("vendor%uObject%u"), v, o);
+      SNMP_MIBObject *object = root->findByName(name);
+      if ((object == nullptr) || (object->getObjectId() != o * 70000) || (object->getParent()->getObjectId() != v * 3))
+         return false;
+   }
+   return true;
+}
+
+/**
+ * Test compiled MIB file formats
+ */
+static void TestMIBFile()
+{
+   const TCHAR *legacyFile = _T("test-libnxsnmp-legacy.mib");
+   const TCHAR *indexedFile = _T("test-libnxsnmp-indexed.mib");
+   SNMP_MIBObject *tree = CreateTestMIBTree(50, 40);
+
+   StartTest(_T("SNMPSaveMIBTree - legacy format"));
+   AssertEquals(SNMPSaveMIBTree(legacyFile, tree, SMT_COMPRESS_DATA), SNMP_ERR_SUCCESS);
+   EndTest();
+
+   StartTest(_T("SNMPSaveMIBTree - indexed format"));
+   AssertEquals(SNMPSaveMIBTree(indexedFile, tree, SMT_COMPRESS_DATA | SMT_INDEXED_FORMAT), SNMP_ERR_SUCCESS);
+   EndTest();
+
+   StartTest(_T("SNMPLoadMIBTree - legacy format"));
+   SNMP_MIBObject *loaded = nullptr;
+   AssertEquals(SNMPLoadMIBTree(legacyFile, &loaded), SNMP_ERR_SUCCESS);
+   AssertNotNull(loaded);
+   AssertTrue(CompareMIBTrees(tree, loaded, false));
+   AssertTrue(FindMIBObjects(loaded, 50, 40, 100, 100));
+   AssertNull(loaded->findByName(_T("vendor51")));
+   delete loaded;
+   EndTest();
+
+   StartTest(_T("SNMPLoadMIBTree - indexed format"));
+   loaded = nullptr;
+   AssertEquals(SNMPLoadMIBTree(indexedFile, &loaded), SNMP_ERR_SUCCESS);
+   AssertNotNull(loaded);
+   AssertTrue(FindMIBObjects(loaded, 50, 40, 100, 100));   // lookups on partially loaded tree
+   AssertNull(loaded->findByName(_T("vendor51")));
+   static const uint32_t partialOid[] = { 1, 3, 6, 1, 4, 1, 21, 140001, 5 };
+   AssertNull(loaded->findByOID(partialOid, 9));
+   AssertEquals(loaded->findByOID(partialOid, 9, false)->getObjectId(), 21);
+   AssertTrue(CompareMIBTrees(tree, loaded, true));
+   delete loaded;
+   EndTest();
+
+   StartTest(_T("SNMP_MIBIndex::createTree"));
+   SNMP_MIBIndex *index = SNMP_MIBIndex::open(indexedFile);
+   AssertNotNull(index);
+   loaded = index->createTree();
+   delete index;
+   AssertTrue(CompareMIBTrees(tree, loaded, true));
+   delete loaded;
+   EndTest();
+
+   StartTest(_T("SNMP_MIBIndex::open"));
+   uint32_t rc;
+   AssertNull(SNMP_MIBIndex::open(legacyFile, &rc));
+   AssertEquals(rc, SNMP_ERR_BAD_FILE_HEADER);
+   index = SNMP_MIBIndex::open(indexedFile, &rc);
+   AssertNotNull(index);
+   AssertEquals(rc, SNMP_ERR_SUCCESS);
+   AssertEquals(index->size(), 7 + 50 + 50 * 40);
+   EndTest();
+
+   // Node 6 is "enterprises", nodes 7..56 are vendors, and nodes 57..96 are children of first vendor
+   StartTest(_T("SNMP_MIBIndex::open - corrupted file"));
+   const TCHAR *corruptedFile = _T("test-libnxsnmp-corrupted.mib");
+   AssertEquals(OpenCorruptedMIBIndex(indexedFile, corruptedFile, 8, 4, 5), SNMP_ERR_BAD_FILE_DATA);   // wrong parent
+   AssertEquals(OpenCorruptedMIBIndex(indexedFile, corruptedFile, 6, 12, 51), SNMP_ERR_BAD_FILE_DATA);  // node claimed by two parents
+   AssertEquals(OpenCorruptedMIBIndex(indexedFile, corruptedFile, 56, 12, 0), SNMP_ERR_BAD_FILE_DATA);  // unclaimed nodes
+   AssertEquals(OpenCorruptedMIBIndex(indexedFile, corruptedFile, 58, 0, 1), SNMP_ERR_BAD_FILE_DATA);   // children not sorted
+   AssertEquals(OpenCorruptedMIBIndex(indexedFile, corruptedFile, 3, 0, 7), SNMP_ERR_SUCCESS);          // valid change
+   EndTest();
+
+   StartTest(_T("SNMP_MIBIndex::findByOID"));
+   static const uint32_t oid[] = { 1, 3, 6, 1, 4, 1, 21, 140000 };
+   uint32_t node = index->findByOID(oid, 8);
+   AssertTrue(node != MIB_INVALID_NODE);
+   AssertTrue(index->getName(node).equals(_T("vendor7Object2")));
+   AssertTrue(index->getDescription(node).equals(_T("Description of object 2 for vendor 7")));
+   AssertTrue(index->getTextualConvention(node).equals(_T("DisplayString")));
+   AssertEquals(index->getType(node), MIB_TYPE_INTEGER);
+   AssertEquals(index->getAccess(node), MIB_ACCESS_READONLY);
+   AssertEquals(index->getObjectId(index->getParent(node)), 21);
+   static const uint32_t oid2[] = { 1, 3, 6, 1, 4, 1, 21, 140001, 5 };
+   AssertEquals(index->findByOID(oid2, 9), MIB_INVALID_NODE);
+   size_t matched;
+   AssertEquals(index->getObjectId(index->findByOID(oid2, 9, &matched)), 21);
+   AssertEquals(matched, 7);
+   EndTest();
+
+   StartTest(_T("SNMP_MIBIndex::findByName"));
+   node = index->findByName(_T("vendor50Object40"));
+   AssertTrue(node != MIB_INVALID_NODE);
+   AssertEquals(index->getObjectId(node), 40 * 70000);
+   AssertEquals(index->getObjectId(index->getParent(node)), 150);
+   AssertEquals(index->findByName(_T("vendor51")), MIB_INVALID_NODE);
+   AssertEquals(index->findChildByID(index->getParent(node), 40 * 70000), node);
+   AssertEquals(index->getChildCount(index->getParent(node)), 40);
+   EndTest();
+
+   delete index;
+   delete tree;
+
+#if !WITH_ADDRESS_SANITIZER
+   tree = CreateTestMIBTree(1000, 200);
+   SNMPSaveMIBTree(legacyFile, tree, SMT_COMPRESS_DATA);
+   SNMPSaveMIBTree(indexedFile, tree, SMT_INDEXED_FORMAT);
+   delete tree;
+
+   StartTest(_T("MIB load and lookup performance"), _T("legacy format"));
+   INT64 start = GetCurrentTimeMs();
+   AssertEquals(SNMPLoadMIBTree(legacyFile, &loaded), SNMP_ERR_SUCCESS);
+   AssertTrue(FindMIBObjects(loaded, 1000, 200, 10000, 20));
+   delete loaded;
+   EndTest(GetCurrentTimeMs() - start);
+
+   StartTest(_T("MIB load and lookup performance"), _T("indexed format"));
+   start = GetCurrentTimeMs();
+   AssertEquals(SNMPLoadMIBTree(indexedFile, &loaded), SNMP_ERR_SUCCESS);
+   AssertTrue(FindMIBObjects(loaded, 1000, 200, 10000, 20));
+   delete loaded;
+   EndTest(GetCurrentTimeMs() - start);
+#endif
+
+   _tremove(legacyFile);
+   _tremove(indexedFile);
+}
+
+/**
+ * Compare two PDUs
+ */
+static bool ComparePDUs(SNMP_PDU *p1, SNMP_PDU *p2)
+{
+   if ((p1->getCommand() != p2->getCommand()) || (p1->getVersion() != p2->getVersion()) ||
+       (p1->getRequestId() != p2->getRequestId()) || (p1->getNumVariables() != p2->getNumVariables()))
+      return false;
+   for(int i = 0; i < p1->getNumVariables(); i++)
+   {
+      SNMP_Variable *v1 = p1->getVariable(i);
+      SNMP_Variable *v2 = p2->getVariable(i);
+      if ((v1->getName().compare(v2->getName()) != OID_EQUAL) || (v1->getType() != v2->getType()) ||
+          (v1->getValueLength() != v2->getValueLength()) || memcmp(v1->getValue(), v2->getValue(), v1->getValueLength()))
+         return false;
+   }
+   return true;
+}
+
+/**
+ * Create response PDU with variables of all supported types
+ */
+static SNMP_PDU *CreateTestResponsePDU(SNMP_Version version)
+{
+   SNMP_PDU *pdu = new SNMP_PDU(SNMP_RESPONSE, 0x7FFF0102, version);
+
+   static const struct
+   {
+      uint32_t type;
+      const TCHAR *value;
+   } values[] =
+   {
+      { ASN_INTEGER, _T("-5") },
+      { ASN_INTEGER, _T("2147483647") },
+      { ASN_COUNTER32, _T("4000000000") },
+      { ASN_GAUGE32, _T("128") },
+      { ASN_TIMETICKS, _T("12345678") },
+      { ASN_COUNTER64, _T("18446744073709551615") },
+      { ASN_IP_ADDR, _T("10.1.2.3") },
+      { ASN_OBJECT_ID, _T(".1.3.6.1.4.1.2620.1.6.7.1.1.0") },
+      { ASN_OBJECT_ID, _T(".1.3.6.1.4.1.2620.1.6.7.1.1.2.3.4.5.6.7.8.9.10.11.12.13.14.15.16.17.18.19.20.21.22.23.24.25.26.27.28.29.30") },
+      { ASN_OCTET_STRING, _T("short string") },
+      { ASN_OCTET_STRING, _T("long string that does not fit into internal buffer of SNMP_Variable object and should be allocated on heap") },
+      { ASN_NULL, nullptr }
+   };
+   for(int i = 0; i < (int)(sizeof(values) / sizeof(values[0])); i++)
+   {
+      SNMP_ObjectId name(s_system, sizeof(s_system) / sizeof(UINT32));
+      name.extend(i + 1);
+      if (i % 2 != 0)
+      {
+         // Long names do not fit into internal buffer of SNMP_ObjectId
+         for(int j = 0; j < 20; j++)
+            name.extend(j * 1000);
+      }
+      name.extend(0);
+      SNMP_Variable *v = new SNMP_Variable(name);
+      if (values[i].value != nullptr)
+         v->setValueFromString(values[i].type, values[i].value);
+      pdu->bindVariable(v);
+   }
+   return pdu;
+}
+
+/**
+ * Encode PDU, parse result and check that parsed PDU is the same and encodes into same byte sequence
+ */
+static void TestPDURoundTrip(SNMP_PDU *pdu, SNMP_SecurityContext *context)
+{
+   BYTE *encoded;
+   size_t size = pdu->encode(&encoded, context);
+   AssertTrue(size > 0);
+
+   SNMP_PDU *parsed = new SNMP_PDU();
+   AssertTrue(parsed->parse(encoded, size, context, false));
+   AssertTrue(ComparePDUs(pdu, parsed));
+
+   BYTE *reencoded;
+   AssertEquals(parsed->encode(&reencoded, context), size);
+   AssertTrue(memcmp(encoded, reencoded, size) == 0);
+
+   SNMP_PDU *copy = new SNMP_PDU(parsed);
+   AssertTrue(ComparePDUs(pdu, copy));
+   delete copy;
+
+   MemFree(reencoded);
+   MemFree(encoded);
+   delete parsed;
+}
+
+/**
+ * Test PDU encoding and decoding
+ */
+static void TestPDU()
+{
+   SNMP_SecurityContext community("public");
+
+   StartTest(_T("SNMP_PDU::encode - SNMPv2c GET request"));
+   static const BYTE expected[] =
+   {
+      0x30, 0x29, 0x02, 0x01, 0x01, 0x04, 0x06, 0x70, 0x75, 0x62, 0x6C, 0x69, 0x63, 0xA0, 0x1C, 0x02,
+      0x04, 0x12, 0x34, 0x56, 0x78, 0x02, 0x01, 0x00, 0x02, 0x01, 0x00, 0x30, 0x0E, 0x30, 0x0C, 0x06,
+      0x08, 0x2B, 0x06, 0x01, 0x02, 0x01, 0x01, 0x01, 0x00, 0x05, 0x00
+   };
+   SNMP_PDU *pdu = new SNMP_PDU(SNMP_GET_REQUEST, 0x12345678, SNMP_VERSION_2C);
+   pdu->bindVariable(new SNMP_Variable(s_oidSysDescription));
+   BYTE *encoded;
+   AssertEquals(pdu->encode(&encoded, &community), sizeof(expected));
+   AssertTrue(memcmp(encoded, expected, sizeof(expected)) == 0);
+   MemFree(encoded);
+   delete pdu;
+   EndTest();
+
+   StartTest(_T("SNMP_PDU::parse - SNMPv1 trap"));
+   static const BYTE trap[] =
+   {
+      0x30, 0x3A, 0x02, 0x01, 0x00, 0x04, 0x06, 0x70, 0x75, 0x62, 0x6C, 0x69, 0x63, 0xA4, 0x2D, 0x06,
+      0x07, 0x2B, 0x06, 0x01, 0x04, 0x01, 0x94, 0x3C, 0x40, 0x04, 0x0A, 0x00, 0x00, 0x01, 0x02, 0x01,
+      0x06, 0x02, 0x01, 0x11, 0x43, 0x02, 0x30, 0x39, 0x30, 0x12, 0x30, 0x10, 0x06, 0x08, 0x2B, 0x06,
+      0x01, 0x02, 0x01, 0x01, 0x01, 0x00, 0x04, 0x04, 0x74, 0x65, 0x73, 0x74
+   };
+   pdu = new SNMP_PDU();
+   AssertTrue(pdu->parse(trap, sizeof(trap), &community, false));
+   AssertEquals(pdu->getCommand(), SNMP_TRAP);
+   AssertEquals(pdu->getTrapType(), 6);
+   AssertEquals(pdu->getSpecificTrapType(), 17);
+   AssertTrue(!_tcscmp(pdu->getTrapId()->toString(), _T(".1.3.6.1.4.1.2620.0.17")));
+   AssertEquals(pdu->getNumVariables(), 1);
+   AssertEquals(pdu->getVariable(0)->getName().compare(s_oidSysDescription), OID_EQUAL);
+   AssertEquals(pdu->getVariable(0)->getValueLength(), 4);
+   AssertTrue(!memcmp(pdu->getVariable(0)->getValue(), "test", 4));
+   delete pdu;
+   EndTest();
+
+   StartTest(_T("SNMP_PDU encode/parse round trip - SNMPv1"));
+   pdu = CreateTestResponsePDU(SNMP_VERSION_1);
+   TestPDURoundTrip(pdu, &community);
+   delete pdu;
+   EndTest();
+
+   StartTest(_T("SNMP_PDU encode/parse round trip - SNMPv2c"));
+   pdu = CreateTestResponsePDU(SNMP_VERSION_2C);
+   TestPDURoundTrip(pdu, &community);
+   delete pdu;
+   EndTest();
+
+   StartTest(_T("SNMP_PDU encode/parse round trip - SNMPv3 auth"));
+   SNMP_SecurityContext usm("user", "password", SNMP_AUTH_SHA1);
+   static const BYTE engineId[] = { 0x80, 0x00, 0x1F, 0x88, 0x80, 0x01, 0x02, 0x03, 0x04 };
+   usm.setAuthoritativeEngine(SNMP_Engine(engineId, sizeof(engineId), 3, 1000));
+   pdu = CreateTestResponsePDU(SNMP_VERSION_3);
+   TestPDURoundTrip(pdu, &usm);
+   delete pdu;
+   EndTest();
+
+   StartTest(_T("SNMP_PDU::detachVariable"));
+   pdu = CreateTestResponsePDU(SNMP_VERSION_2C);
+   size_t size = pdu->encode(&encoded, &community);
+   SNMP_PDU *parsed = new SNMP_PDU();
+   AssertTrue(parsed->parse(encoded, size, &community, false));
+   SNMP_Variable *v = parsed->detachVariable(10);
+   AssertNotNull(v);
+   AssertEquals(parsed->getNumVariables(), pdu->getNumVariables() - 1);
+   delete parsed;
+   AssertEquals(v->getName().compare(pdu->getVariable(10)->getName()), OID_EQUAL);
+   AssertEquals(v->getValueLength(), pdu->getVariable(10)->getValueLength());
+   AssertTrue(!memcmp(v->getValue(), pdu->getVariable(10)->getValue(), v->getValueLength()));
+   delete v;
+   MemFree(encoded);
+   delete pdu;
+   EndTest();
+
+   StartTest(_T("SNMP_PDU::parse - malformed packets"));
+   pdu = CreateTestResponsePDU(SNMP_VERSION_2C);
+   size = pdu->encode(&encoded, &community);
+   delete pdu;
+   BYTE *packet = MemAllocArrayNoInit<BYTE>(size);
+   uint32_t seed = 12345;
+   for(int i = 0; i < 20000; i++)
+   {
+      memcpy(packet, encoded, size);
+      int changes = i % 4 + 1;
+      for(int j = 0; j < changes; j++)
+      {
+         seed = seed * 1103515245 + 12345;
+         packet[(seed >> 8) % size] = static_cast<BYTE>(seed >> 24);
+      }
+      seed = seed * 1103515245 + 12345;
+      size_t length = (i % 3 == 0) ? (seed >> 8) % size : size;
+
+      // Copy to exact sized buffer so that any read beyond packet end can be detected by sanitizer
+      BYTE *data = MemCopyBlock(packet, length);
+      pdu = new SNMP_PDU();
+      pdu->parse(data, length, &community, false);
+      delete pdu;
+      MemFree(data);
+   }
+   MemFree(packet);
+   MemFree(encoded);
+   EndTest();
+
+#if !WITH_ADDRESS_SANITIZER
+   StartTest(_T("SNMP_PDU encode and parse performance"));
+   pdu = CreateTestResponsePDU(SNMP_VERSION_2C);
+   INT64 start = GetCurrentTimeMs();
+   for(int i = 0; i < 100000; i++)
+   {
+      size = pdu->encode(&encoded, &community);
+      parsed = new SNMP_PDU();
+      AssertTrue(parsed->parse(encoded, size, &community, false));
+      delete parsed;
+      MemFree(encoded);
+   }
+   delete pdu;
+   EndTest(GetCurrentTimeMs() - start);
+#endif
+}
+
 /**
  * main()
  */
@@ -152,5 +613,7 @@ int main(int argc, char *argv[])
    TestOidConversion();
    TestOidClass();
    TestVariableClass();
+   TestMIBFile();
+   TestPDU();
    return 0;
 }
@@ -0,0 +1,278 @@
+#include <nms_common.h>
+#include <nms_util.h>
+#include <nxdbapi.h>
+#include <testtools.h>
+#include "nxagentd.h"
+
+NETXMS_EXECUTABLE_HEADER(test-offlinelog)
+
+#ifdef _WIN32
+#define TEST_DIRECTORY  _T("C:\\test-offlinelog")
+#define SQLITE_DB       _T("C:\\test-offlinelog.sqlite")
+#else
+#define TEST_DIRECTORY  _T("/tmp/test-offlinelog")
+#define SQLITE_DB       _T("/tmp/test-offlinelog.sqlite")
+#endif
+
+#define SEGMENT_SIZE    (1024 * 1024)
+#define BATCH_SIZE      1000
+
+/**
+ * Build record similar to one produced by agent for collected DCI value
+ */
+static void BuildRecord(ByteStream *record, uint32_t id)
+{
+   TCHAR value[64];
+   _sntprintf(value, 64, _T("%u.%03u"), id % 1000, id % 997);
+
+   record->write(static_cast<UINT64>(0x0102030405060708));
+   record->write(static_cast<UINT32>(id % 50 + 1));
+   record->write(static_cast<UINT16>(1));
+   record->write(static_cast<UINT16>(0));
+   record->write(static_cast<UINT32>(0));
+   record->write(static_cast<INT64>(1600000000 + id));
+   record->writeString(_T("00000000-0000-0000-0000-000000000000"));
+   record->writeString(value);
+}
+
+/**
+ * Check that record read back from log matches original
+ */
+static bool CheckRecord(ByteStream *record, uint32_t id)
+{
+   ByteStream expected(128);
+   BuildRecord(&expected, id);
+   return (record->size() == expected.size()) && !memcmp(record->buffer(), expected.buffer(), expected.size());
+}
+
+/**
+ * Remove log directory left from previous run
+ */
+static void CleanupLogDirectory()
+{
+   OfflineDataLog *log = new OfflineDataLog(TEST_DIRECTORY, SEGMENT_SIZE, false);
+   log->open();
+   log->destroy();
+   log->decRefCount();
+}
+
+/**
+ * Functional tests
+ */
+static void TestOfflineDataLog(bool compress)
+{
+   const TCHAR *prefix = compress ? _T("Offline log (LZ4)") : _T("Offline log");
+   CleanupLogDirectory();
+
+   StartTest(prefix, _T("append"));
+   OfflineDataLog *log = new OfflineDataLog(TEST_DIRECTORY, 64 * 1024, compress);
+   AssertTrue(log->open());
+   for(uint32_t i = 0; i < 5000; i++)
+   {
+      ByteStream record(128);
+      BuildRecord(&record, i);
+      AssertTrue(log->append(record.buffer(), record.size(), 1600000000 + i));
+   }
+   AssertFalse(log->append(nullptr, 0, 1600005000));   // empty records are not allowed
+   AssertEquals(log->getRecordCount(), 5000);
+   AssertEquals(static_cast<int64_t>(log->getOldestTimestamp()), static_cast<int64_t>(1600000000));
+   EndTest();
+
+   StartTest(prefix, _T("read and commit"));
+   ObjectArray<ByteStream> records(BATCH_SIZE, BATCH_SIZE, Ownership::True);
+   AssertEquals(log->read(&records, 1500), 1500);
+   for(int i = 0; i < records.size(); i++)
+      AssertTrue(CheckRecord(records.get(i), i));
+   log->commit(1000);   // last 500 records should be returned again
+   AssertEquals(log->getRecordCount(), 4000);
+   EndTest();
+
+   StartTest(prefix, _T("reopen"));
+   log->flush();
+   log->decRefCount();
+   log = new OfflineDataLog(TEST_DIRECTORY, 64 * 1024, compress);
+   AssertTrue(log->open());
+   AssertEquals(log->getRecordCount(), 4000);
+   records.clear();
+   AssertEquals(log->read(&records, 5000), 4000);
+   for(int i = 0; i < 4000; i++)
+      AssertTrue(CheckRecord(records.get(i), i + 1000));
+   log->commit(records.size());
+   AssertEquals(log->getRecordCount(), 0);
+   records.clear();
+   AssertEquals(log->read(&records, 10), 0);
+   EndTest();
+
+   log->destroy();
+   log->decRefCount();
+}
+
+/**
+ * Benchmark offline data log: write given number of records and then read them back in batches
+ */
+static void BenchmarkOfflineDataLog(const TCHAR *name, bool compress, uint32_t count)
+{
+   StartTest(_T("Offline storage performance"), name);
+   CleanupLogDirectory();
+
+   int64_t start = GetCurrentTimeMs();
+
+   OfflineDataLog *log = new OfflineDataLog(TEST_DIRECTORY, SEGMENT_SIZE, compress);
+   AssertTrue(log->open());
+   for(uint32_t i = 0; i < count; i++)
+   {
+      ByteStream record(128);
+      BuildRecord(&record, i);
+      AssertTrue(log->append(record.buffer(), record.size(), 1600000000 + i));
+      if (i % BATCH_SIZE == BATCH_SIZE - 1)
+         log->flush();
+   }
+   log->flush();
+
+   ObjectArray<ByteStream> records(BATCH_SIZE, BATCH_SIZE, Ownership::True);
+   uint32_t total = 0;
+   while(true)
+   {
+      records.clear();
+      int n = log->read(&records, BATCH_SIZE);
+      if (n == 0)
+         break;
+      log->commit(n);
+      total += n;
+   }
+   AssertEquals(total, count);
+
+   int64_t elapsed = GetCurrentTimeMs() - start;
+   log->destroy();
+   log->decRefCount();
+   EndTest(elapsed);
+}
+
+/**
+ * Benchmark SQLite queue table (storage used by agent before offline data log was introduced):
+ * insert given number of records in transactions and then read and delete them in batches
+ */
+static void BenchmarkSQLiteQueue(DB_DRIVER driver, uint32_t count)
+{
+   StartTest(_T("Offline storage performance"), _T("SQLite queue"));
+
+   _tremove(SQLITE_DB);
+
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   DB_HANDLE hdb = DBConnect(driver, nullptr, SQLITE_DB, nullptr, nullptr, nullptr, errorText);
+   AssertNotNullEx(hdb, errorText);
+   AssertTrueEx(DBQueryEx(hdb,
+            _T("CREATE TABLE dc_queue (")
+            _T("  server_id number(20) not null,")
+            _T("  dci_id integer not null,")
+            _T("  dci_type integer not null,")
+            _T("  dci_origin integer not null,")
+            _T("  status_code integer not null,")
+            _T("  snmp_target_guid varchar(36) not null,")
+            _T("  timestamp integer not null,")
+            _T("  value varchar not null,")
+            _T("  PRIMARY KEY(server_id,dci_id,timestamp))"), errorText), errorText);
+   AssertTrueEx(DBQueryEx(hdb, _T("CREATE INDEX idx_dc_queue_timestamp ON dc_queue(timestamp)"), errorText), errorText);
+
+   int64_t start = GetCurrentTimeMs();
+
+   DB_STATEMENT hStmt = DBPrepare(hdb, _T("INSERT INTO dc_queue (server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value) VALUES (?,?,?,?,?,?,?,?)"), true);
+   AssertNotNull(hStmt);
+   DBBegin(hdb);
+   for(uint32_t i = 0; i < count; i++)
+   {
+      TCHAR value[64];
+      _sntprintf(value, 64, _T("%u.%03u"), i % 1000, i % 997);
+      DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, static_cast<uint64_t>(0x0102030405060708));
+      DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, i % 50 + 1);
+      DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, 1);
+      DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, 0);
+      DBBind(hStmt, 5, DB_SQLTYPE_INTEGER, 0);
+      DBBind(hStmt, 6, DB_SQLTYPE_VARCHAR, _T("00000000-0000-0000-0000-000000000000"), DB_BIND_STATIC);
+      DBBind(hStmt, 7, DB_SQLTYPE_INTEGER, 1600000000 + i);
+      DBBind(hStmt, 8, DB_SQLTYPE_VARCHAR, value, DB_BIND_STATIC);
+      AssertTrue(DBExecute(hStmt));
+      if (i % BATCH_SIZE == BATCH_SIZE - 1)
+      {
+         DBCommit(hdb);
+         DBBegin(hdb);
+      }
+   }
+   DBCommit(hdb);
+   DBFreeStatement(hStmt);
+
+   hStmt = DBPrepare(hdb, _T("DELETE FROM dc_queue WHERE server_id=? AND dci_id=? AND timestamp=?"), true);
+   AssertNotNull(hStmt);
+   TCHAR query[1024];
+   _sntprintf(query, 1024, _T("SELECT server_id,dci_id,dci_type,dci_origin,status_code,snmp_target_guid,timestamp,value FROM dc_queue INDEXED BY idx_dc_queue_timestamp ORDER BY timestamp LIMIT %d"), BATCH_SIZE);
+   uint32_t total = 0;
+   while(true)
+   {
+      DB_RESULT hResult = DBSelect(hdb, query);
+      AssertNotNull(hResult);
+      int n = DBGetNumRows(hResult);
+      if (n == 0)
+      {
+         DBFreeResult(hResult);
+         break;
+      }
+      DBBegin(hdb);
+      for(int i = 0; i < n; i++)
+      {
+         DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, DBGetFieldUInt64(hResult, i, 0));
+         DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, DBGetFieldULong(hResult, i, 1));
+         DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, DBGetFieldULong(hResult, i, 6));
+         AssertTrue(DBExecute(hStmt));
+      }
+      DBCommit(hdb);
+      DBFreeResult(hResult);
+      total += n;
+   }
+   DBFreeStatement(hStmt);
+   AssertEquals(total, count);
+
+   int64_t elapsed = GetCurrentTimeMs() - start;
+   DBDisconnect(hdb);
+   _tremove(SQLITE_DB);
+   EndTest(elapsed);
+}
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   bool skipSQLite = false;
+   uint32_t count = 100000;
+   for(int i = 1; i < argc; i++)
+   {
+      if (!strcmp(argv[i], "--skip-sqlite"))
+         skipSQLite = true;
+      else if (!strcmp(argv[i], "--records") && (i < argc - 1))
+         count = strtoul(argv[++i], nullptr, 10);
+   }
+
+   TestOfflineDataLog(false);
+   TestOfflineDataLog(true);
+
+   BenchmarkOfflineDataLog(_T("segment log"), false, count);
+   BenchmarkOfflineDataLog(_T("segment log (LZ4)"), true, count);
+
+   if (!skipSQLite)
+   {
+      DBInit();
+      DB_DRIVER driver = DBLoadDriver(_T("sqlite.ddr"), _T(""), false, nullptr, nullptr);
+      if (driver != nullptr)
+      {
+         BenchmarkSQLiteQueue(driver, count);
+         DBUnloadDriver(driver);
+      }
+      else
+      {
+         _tprintf(_T("Cannot load SQLite driver, SQLite benchmark skipped\n"));
+      }
+   }
+   return 0;
+}